@@ -0,0 +1,256 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string_view>
+
+#include <libhal/functional.hpp>
+#include <libhal/steady_clock.hpp>
+#include <libhal/units.hpp>
+
+namespace hal::benchmark {
+/**
+ * @brief Timing of one benchmark
+ *
+ */
+struct result
+{
+  /// Name of the benchmark
+  std::string_view name;
+  /// Number of times the benchmark's body was run
+  u64 iterations = 0;
+  /// Time it took to run the body every iteration, in nanoseconds
+  u64 elapsed_ns = 0;
+  /// Cycles it took to run the body every iteration, 0 without a counter
+  u64 elapsed_cycles = 0;
+
+  /**
+   * @brief Get the average time of one iteration
+   *
+   * @return float - nanoseconds per iteration
+   */
+  [[nodiscard]] constexpr float ns_per_op() const
+  {
+    if (iterations == 0) {
+      return 0.0f;
+    }
+    return static_cast<float>(elapsed_ns) / static_cast<float>(iterations);
+  }
+
+  /**
+   * @brief Get the average cycles of one iteration
+   *
+   * @return float - cycles per iteration
+   */
+  [[nodiscard]] constexpr float cycles_per_op() const
+  {
+    if (iterations == 0) {
+      return 0.0f;
+    }
+    return static_cast<float>(elapsed_cycles) / static_cast<float>(iterations);
+  }
+};
+
+/// Returns a time in nanoseconds since an arbitrary, fixed point
+using clock = hal::function_ref<u64()>;
+/// Receives the result of each benchmark as it finishes
+using reporter = hal::function_ref<void(result const&)>;
+/// Returns the value of a free running cycle counter
+using cycle_counter = u64 (*)();
+
+/**
+ * @brief Read the host processor's cycle counter
+ *
+ * Reads the time stamp counter on x86 and the virtual counter on AArch64,
+ * which counts at a fixed frequency rather than at the core clock. On targets,
+ * pass a function reading a core cycle counter, such as the DWT CYCCNT
+ * register of a Cortex-M, instead.
+ *
+ * @return u64 - cycle count, 0 on other processors
+ */
+inline u64 host_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  u32 low = 0;
+  u32 high = 0;
+  asm volatile("rdtsc" : "=a"(low), "=d"(high));
+  return (static_cast<u64>(high) << 32) | low;
+#elif defined(__aarch64__)
+  u64 count = 0;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(count));
+  return count;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Prevent the compiler from optimizing away a value
+ *
+ * @param p_value - value to treat as used
+ */
+template<class T>
+void do_not_optimize(T const& p_value)
+{
+  asm volatile("" : : "r,m"(p_value) : "memory");
+}
+
+/**
+ * @brief Hide the origin of a pointer from the optimizer
+ *
+ * Calls through the returned pointer cannot be devirtualized or inlined based
+ * on what the compiler knows about the object, as is the case in real
+ * applications where drivers are passed to code in other translation units.
+ *
+ * @param p_pointer - pointer to hide
+ * @return T* - the same pointer
+ */
+template<class T>
+T* opaque(T* p_pointer)
+{
+  asm volatile("" : "+r"(p_pointer));
+  return p_pointer;
+}
+
+/**
+ * @brief Nanosecond clock backed by a hal::steady_clock, for use on targets
+ *
+ * Pass this object as the harness's clock.
+ */
+class steady_clock_nanoseconds
+{
+public:
+  /**
+   * @brief Construct a clock
+   *
+   * @param p_clock - steady clock to read. Must outlive this object.
+   */
+  explicit steady_clock_nanoseconds(hal::steady_clock& p_clock)
+    : m_clock(&p_clock)
+    , m_frequency(static_cast<u64>(p_clock.frequency()))
+  {
+  }
+
+  /**
+   * @brief Get the uptime of the steady clock
+   *
+   * @return u64 - uptime in nanoseconds
+   */
+  u64 operator()()
+  {
+    auto const ticks = m_clock->uptime();
+    auto const seconds = ticks / m_frequency;
+    auto const remainder = ticks % m_frequency;
+    return seconds * 1'000'000'000 + remainder * 1'000'000'000 / m_frequency;
+  }
+
+private:
+  hal::steady_clock* m_clock;
+  u64 m_frequency;
+};
+
+/**
+ * @brief Runs benchmarks and reports their timing
+ *
+ * The same benchmarks run on the host, with a clock backed by
+ * std::chrono::steady_clock and `host_cycles()`, and on targets, with a
+ * `steady_clock_nanoseconds` clock, a core cycle counter and a reporter that
+ * writes to a serial port.
+ */
+class harness
+{
+public:
+  /**
+   * @brief Construct a harness
+   *
+   * @param p_clock - clock to time benchmarks with. Must outlive this object.
+   * @param p_reporter - receives each result. Must outlive this object.
+   * @param p_cycles - cycle counter to count the cycles of benchmarks with, or
+   * nullptr to only measure time
+   */
+  harness(clock p_clock, reporter p_reporter, cycle_counter p_cycles = nullptr)
+    : m_clock(p_clock)
+    , m_reporter(p_reporter)
+    , m_cycles(p_cycles)
+  {
+  }
+
+  /**
+   * @brief Time a benchmark and report the result
+   *
+   * The body is run once before timing starts, to warm up caches and any lazy
+   * initialization, then p_iterations times in a timed loop.
+   *
+   * @param p_name - name of the benchmark, reported with its result
+   * @param p_iterations - number of timed runs of the body
+   * @param p_body - function to benchmark
+   */
+  template<class Body>
+  void run(std::string_view p_name, u64 p_iterations, Body&& p_body)
+  {
+    p_body();
+    auto const start = m_clock();
+    auto const start_cycles = cycles();
+    for (u64 i = 0; i < p_iterations; i++) {
+      p_body();
+    }
+    auto const elapsed_cycles = cycles() - start_cycles;
+    auto const elapsed = m_clock() - start;
+    m_reporter(result{ .name = p_name,
+                       .iterations = p_iterations,
+                       .elapsed_ns = elapsed,
+                       .elapsed_cycles = elapsed_cycles });
+  }
+
+private:
+  u64 cycles()
+  {
+    return m_cycles ? m_cycles() : 0;
+  }
+
+  clock m_clock;
+  reporter m_reporter;
+  cycle_counter m_cycles;
+};
+
+/**
+ * @brief Time throwing and catching each hal::exception type
+ *
+ * @param p_harness - harness to run the benchmarks with
+ */
+void exception_benchmarks(harness& p_harness);
+
+/**
+ * @brief Time circular_buffer, allocated_buffer, strong_ptr, scatter_span and
+ * callback operations
+ *
+ * @param p_harness - harness to run the benchmarks with
+ */
+void container_benchmarks(harness& p_harness);
+
+/**
+ * @brief Time the sample conversion kernels and attitude filters
+ *
+ * @param p_harness - harness to run the benchmarks with
+ */
+void signal_benchmarks(harness& p_harness);
+
+/**
+ * @brief Time calls through the driver interfaces to zero latency mock drivers
+ *
+ * @param p_harness - harness to run the benchmarks with
+ */
+void interface_benchmarks(harness& p_harness);
+}  // namespace hal::benchmark
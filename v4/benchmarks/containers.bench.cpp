@@ -0,0 +1,245 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <atomic>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <thread>
+
+#include <libhal/allocated_buffer.hpp>
+#include <libhal/circular_buffer.hpp>
+#include <libhal/event_trace.hpp>
+#include <libhal/functional.hpp>
+#include <libhal/pointers.hpp>
+#include <libhal/scatter_span.hpp>
+
+#include "benchmark.hpp"
+
+namespace hal::benchmark {
+namespace {
+constexpr u64 iterations = 1'000'000;
+
+/// Push into a buffer whose capacity wraps with modulo or with a bit mask
+template<class Buffer>
+void circular_buffer_push(harness& p_harness,
+                          std::string_view p_name,
+                          Buffer& p_buffer)
+{
+  u32 value = 0;
+  p_harness.run(p_name, iterations, [&]() {
+    p_buffer.push(value++);
+    do_not_optimize(p_buffer[p_buffer.write_index()]);
+  });
+}
+
+/// Steady clock returning a counter, standing in for a timer register
+class counter_clock final : public steady_clock
+{
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_ticks++;
+  }
+
+  u64 m_ticks = 0;
+};
+
+/// Repeats work on another thread, and core when one is free, until destroyed
+class contender
+{
+public:
+  template<typename Work>
+  explicit contender(Work p_work)
+    : m_thread([this, p_work]() {
+      while (not m_stop.load(std::memory_order_relaxed)) {
+        p_work();
+      }
+    })
+  {
+  }
+
+  contender(contender const&) = delete;
+  contender& operator=(contender const&) = delete;
+  contender(contender&&) = delete;
+  contender& operator=(contender&&) = delete;
+
+  ~contender()
+  {
+    m_stop.store(true, std::memory_order_relaxed);
+    m_thread.join();
+  }
+
+private:
+  std::atomic<bool> m_stop = false;
+  std::thread m_thread;
+};
+}  // namespace
+
+void container_benchmarks(harness& p_harness)
+{
+  std::pmr::polymorphic_allocator<> allocator;
+
+  // Capacities differ, as the power of two buffer rounds 100 up to 128
+  circular_buffer<u32> any_buffer(allocator, 100);
+  circular_buffer_pow2<u32> pow2_buffer(allocator, 100);
+  circular_buffer_push(p_harness, "circular_buffer/push/modulo", any_buffer);
+  circular_buffer_push(p_harness, "circular_buffer/push/pow2", pow2_buffer);
+
+  std::array<u32, 16> block{};
+  p_harness.run("circular_buffer/push_range/16", iterations, [&]() {
+    any_buffer.push_range(block);
+    do_not_optimize(any_buffer[0]);
+  });
+
+  p_harness.run("allocated_buffer/construct/64", iterations, [&]() {
+    allocated_buffer<u32> buffer(allocator, 64);
+    do_not_optimize(buffer.data());
+  });
+
+  auto shared = make_strong_ptr<u32>(allocator, 5U);
+  p_harness.run("strong_ptr/copy_release", iterations, [&]() {
+    auto copy = shared;
+    do_not_optimize(copy);
+  });
+  p_harness.run("strong_ptr/make_release", iterations / 10, [&]() {
+    auto made = make_strong_ptr<u32>(allocator, 5U);
+    do_not_optimize(made);
+  });
+
+  // Destroying the object, then the control block held by a weak_ptr
+  p_harness.run("strong_ptr/make_release/weak", iterations / 10, [&]() {
+    auto made = make_strong_ptr<u32>(allocator, 5U);
+    weak_ptr<u32> const observer = made;
+    made = shared;
+    do_not_optimize(observer);
+  });
+
+  weak_ptr<u32> const weak = shared;
+  p_harness.run("weak_ptr/lock", iterations, [&]() {
+    auto locked = weak.lock();
+    do_not_optimize(locked);
+  });
+
+  // The same reference counts while another core copies and locks them, as
+  // when a sensor object is shared between the cores of a dual core MCU
+  {
+    contender const other_core([&shared, &weak]() {
+      auto copy = shared;
+      auto locked = weak.lock();
+      do_not_optimize(copy);
+      do_not_optimize(locked);
+    });
+    p_harness.run("strong_ptr/copy_release/contended", iterations, [&]() {
+      auto copy = shared;
+      do_not_optimize(copy);
+    });
+    p_harness.run("weak_ptr/lock/contended", iterations, [&]() {
+      auto locked = weak.lock();
+      do_not_optimize(locked);
+    });
+  }
+
+  // Table of optional drivers, every other one present, read through the
+  // engaged check and access of each optional type
+  std::array<optional_ptr<u32>, 16> drivers{};
+  std::array<std::optional<strong_ptr<u32>>, 16> std_drivers{};
+  for (usize i = 0; i < drivers.size(); i += 2) {
+    drivers[i] = shared;
+    std_drivers[i] = shared;
+  }
+  p_harness.run("optional_ptr/table_scan/16", iterations, [&]() {
+    u32 sum = 0;
+    for (auto const& driver : *opaque(&drivers)) {
+      if (driver) {
+        sum += *driver;
+      }
+    }
+    do_not_optimize(sum);
+  });
+  p_harness.run("std::optional<strong_ptr>/table_scan/16", iterations, [&]() {
+    u32 sum = 0;
+    for (auto const& driver : *opaque(&std_drivers)) {
+      if (driver) {
+        sum += **driver;
+      }
+    }
+    do_not_optimize(sum);
+  });
+
+  std::array<hal::byte, 64> data{};
+  std::array<hal::byte, 64> same{};
+  auto const lhs = make_scatter_bytes(std::span(data).first(8),
+                                      std::span(data).subspan(8, 40),
+                                      std::span(data).subspan(48));
+  auto const rhs = make_scatter_bytes(std::span(same).first(32),
+                                      std::span(same).subspan(32));
+  p_harness.run("scatter_span/equal/64", iterations, [&]() {
+    do_not_optimize(scatter_span<hal::byte const>(lhs) ==
+                    scatter_span<hal::byte const>(rhs));
+  });
+
+  std::array<hal::byte, 64> bounce{};
+  p_harness.run("scatter_copy/gather/64", iterations, [&]() {
+    do_not_optimize(scatter_copy(scatter_span<hal::byte const>(lhs),
+                                 std::span<hal::byte>(bounce)));
+  });
+
+  int offset = 3;
+  int scale = 2;
+  int bias = 1;
+  int argument = 0;
+  hal::callback<int(int)> callback = [&offset](int p_value) {
+    return p_value + offset;
+  };
+  hal::callback_n<int(int), 3> callback_3 =
+    [&offset, &scale, &bias](int p_value) {
+      return (p_value * scale) + offset + bias;
+    };
+  auto lambda = [&offset](int p_value) { return p_value + offset; };
+  hal::function_ref<int(int)> reference = lambda;
+  p_harness.run("callback/invoke", iterations, [&]() {
+    do_not_optimize(callback(argument++));
+  });
+  p_harness.run("callback_n/3/invoke", iterations, [&]() {
+    do_not_optimize(callback_3(argument++));
+  });
+  p_harness.run("function_ref/invoke", iterations, [&]() {
+    do_not_optimize(reference(argument++));
+  });
+
+  // Cost of one traced event, then one event through the ring and encoder
+  counter_clock ticks;
+  event_trace<256> trace(ticks);
+  std::array<hal::byte, 256 * trace_event_size> staging{};
+  u32 recorded = 0;
+  p_harness.run("event_trace/record", iterations, [&]() {
+    do_not_optimize(trace.record(1, 2));
+    if (++recorded % 256 == 0) {
+      trace.drain(staging);
+    }
+  });
+  auto const one_event = std::span(staging).first(trace_event_size);
+  p_harness.run("event_trace/record_drain", iterations, [&]() {
+    trace.record(1, 2);
+    do_not_optimize(trace.drain(one_event).data());
+  });
+}
+}  // namespace hal::benchmark
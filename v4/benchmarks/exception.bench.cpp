@@ -0,0 +1,120 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal/error.hpp>
+#include <libhal/exception_trace.hpp>
+
+#include "benchmark.hpp"
+
+namespace hal::benchmark {
+namespace {
+constexpr u64 iterations = 10'000;
+
+/// Steady clock that never advances, so tracing cost excludes a clock read
+class frozen_clock : public hal::steady_clock
+{
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return 0;
+  }
+};
+
+/// Constructs a new exception each call, as a driver does before throwing
+template<class Make>
+void throw_catch(harness& p_harness, std::string_view p_name, Make p_make)
+{
+  using thrown_t = decltype(p_make());
+  p_harness.run(p_name, iterations, [&p_make]() {
+    try {
+      hal::safe_throw(p_make());
+    } catch (thrown_t const& p_error) {
+      do_not_optimize(p_error.error_code());
+    }
+  });
+}
+}  // namespace
+
+void exception_benchmarks(harness& p_harness)
+{
+  static int driver = 0;
+  static void const* const instance = &driver;
+
+  throw_catch(p_harness, "throw/no_such_device", []() {
+    return no_such_device(8, instance);
+  });
+  throw_catch(p_harness, "throw/io_error", []() {
+    return io_error(instance);
+  });
+  throw_catch(p_harness, "throw/resource_unavailable_try_again", []() {
+    return resource_unavailable_try_again(instance);
+  });
+  throw_catch(p_harness, "throw/device_or_resource_busy", []() {
+    return device_or_resource_busy(instance);
+  });
+  throw_catch(p_harness, "throw/timed_out", []() {
+    return timed_out(instance);
+  });
+  throw_catch(p_harness, "throw/operation_not_supported", []() {
+    return operation_not_supported(instance);
+  });
+  throw_catch(p_harness, "throw/operation_not_permitted", []() {
+    return operation_not_permitted(instance);
+  });
+  throw_catch(p_harness, "throw/argument_out_of_domain", []() {
+    return argument_out_of_domain(instance);
+  });
+  throw_catch(p_harness, "throw/message_size", []() {
+    return message_size(8, instance);
+  });
+  throw_catch(p_harness, "throw/not_connected", []() {
+    return not_connected(instance);
+  });
+  throw_catch(p_harness, "throw/unknown", []() {
+    return unknown(instance);
+  });
+  throw_catch(p_harness, "throw/bad_weak_ptr", []() {
+    return bad_weak_ptr(&driver);
+  });
+  throw_catch(p_harness, "throw/out_of_range", []() {
+    return out_of_range(instance, { .m_index = 4, .m_capacity = 4 });
+  });
+  throw_catch(p_harness, "throw/bad_optional_ptr_access", []() {
+    return bad_optional_ptr_access(instance);
+  });
+
+  // Same throw as above with every exception recorded, to measure the cost of
+  // the instrumentation hook and the trace's ring.
+  frozen_clock frozen;
+  exception_trace<64> trace(frozen);
+  trace.install();
+  throw_catch(p_harness, "throw/timed_out/traced", []() {
+    return timed_out(instance);
+  });
+  trace.uninstall();
+
+  p_harness.run("catch_error_code/success", iterations, []() {
+    do_not_optimize(hal::catch_error_code([]() {}));
+  });
+  p_harness.run("catch_error_code/timed_out", iterations, []() {
+    do_not_optimize(hal::catch_error_code(
+      []() { hal::safe_throw(timed_out(instance)); }));
+  });
+}
+}  // namespace hal::benchmark
@@ -0,0 +1,266 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+
+#include <libhal/can.hpp>
+#include <libhal/i2c.hpp>
+#include <libhal/scatter_span.hpp>
+#include <libhal/serial.hpp>
+#include <libhal/spi.hpp>
+#include <libhal/usb.hpp>
+
+#include "benchmark.hpp"
+
+namespace hal::benchmark {
+namespace {
+constexpr u64 iterations = 1'000'000;
+
+// Mock drivers complete every call immediately, so each benchmark measures the
+// software overhead of the interface: the virtual call, the default
+// implementations and the argument handling.
+
+class mock_i2c final : public hal::i2c
+{
+public:
+  usize m_bytes = 0;
+
+  void direct_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in)
+  {
+    driver_transaction(p_address, p_data_out, p_data_in);
+  }
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    driver_transaction(p_address, p_data_out, p_data_in);
+  }
+
+  void driver_transaction(hal::byte,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in) override
+  {
+    m_bytes += p_data_out.size() + p_data_in.size();
+  }
+};
+
+class mock_spi_channel final : public hal::spi_channel
+{
+public:
+  usize m_bytes = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return 1'000'000;
+  }
+
+  void driver_chip_select(bool) override
+  {
+  }
+
+  void driver_transfer(std::span<hal::byte const> p_data_out,
+                       std::span<hal::byte> p_data_in,
+                       hal::byte) override
+  {
+    m_bytes += p_data_out.size() + p_data_in.size();
+  }
+};
+
+class mock_serial final : public hal::v5::serial
+{
+public:
+  usize m_bytes = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_write(std::span<hal::byte const> p_data) override
+  {
+    m_bytes += p_data.size();
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return m_receive;
+  }
+
+  std::size_t driver_cursor() override
+  {
+    return 0;
+  }
+
+  std::array<hal::byte, 16> m_receive{};
+};
+
+class mock_can_transceiver final : public hal::can_transceiver
+{
+public:
+  usize m_sent = 0;
+
+private:
+  u32 driver_baud_rate() override
+  {
+    return 1'000'000;
+  }
+
+  void driver_send(can_message const&) override
+  {
+    m_sent++;
+  }
+
+  std::span<can_message const> driver_receive_buffer() override
+  {
+    return m_receive;
+  }
+
+  std::size_t driver_receive_cursor() override
+  {
+    return 0;
+  }
+
+  std::array<can_message, 4> m_receive{};
+};
+
+class mock_in_endpoint final : public hal::v5::usb::in_endpoint
+{
+public:
+  usize m_bytes = 0;
+
+private:
+  [[nodiscard]] hal::v5::usb::endpoint_info driver_info() const override
+  {
+    return { .size = 64, .number = 0x81, .stalled = false };
+  }
+
+  void driver_stall(bool) override
+  {
+  }
+
+  void driver_reset() override
+  {
+  }
+
+  void driver_write(scatter_span<hal::byte const> p_data) override
+  {
+    for (auto const& segment : p_data) {
+      m_bytes += segment.size();
+    }
+  }
+};
+}  // namespace
+
+void interface_benchmarks(harness& p_harness)
+{
+  std::array<hal::byte, 2> const command{ 0x20, 0x01 };
+  std::array<hal::byte, 6> payload{};
+  std::array<hal::byte, 8> response{};
+  auto const pieces = make_scatter_bytes(command, payload, response);
+  auto const write_pieces = scatter_span<hal::byte const>(pieces);
+
+  mock_i2c i2c_driver;
+  auto* const i2c = opaque<hal::i2c>(&i2c_driver);
+  p_harness.run("i2c/transaction/virtual", iterations, [&]() {
+    i2c->transaction(0x42, command, response);
+  });
+  p_harness.run("i2c/transaction/direct", iterations, [&]() {
+    i2c_driver.direct_transaction(0x42, command, response);
+  });
+  p_harness.run("i2c/try_transaction/default", iterations, [&]() {
+    do_not_optimize(i2c->try_transaction(0x42, command, response));
+  });
+  p_harness.run("i2c/transaction/scatter_3", iterations, [&]() {
+    i2c->transaction(0x42, write_pieces, scatter_span<hal::byte>{});
+  });
+  do_not_optimize(i2c_driver.m_bytes);
+
+  mock_spi_channel spi_driver;
+  auto* const spi = opaque<hal::spi_channel>(&spi_driver);
+  p_harness.run("spi_channel/transfer/virtual", iterations, [&]() {
+    spi->transfer(command, response);
+  });
+  p_harness.run("spi_channel/transfer/scatter_3", iterations, [&]() {
+    spi->transfer(write_pieces, scatter_span<hal::byte>{});
+  });
+  do_not_optimize(spi_driver.m_bytes);
+
+  mock_serial serial_driver;
+  auto* const serial = opaque<hal::v5::serial>(&serial_driver);
+  p_harness.run("serial/write/virtual", iterations, [&]() {
+    serial->write(payload);
+  });
+  p_harness.run("serial/write/scatter_3", iterations, [&]() {
+    serial->write(write_pieces);
+  });
+  do_not_optimize(serial_driver.m_bytes);
+
+  mock_can_transceiver can_driver;
+  auto* const can = opaque<hal::can_transceiver>(&can_driver);
+  std::array<can_message, 8> messages{};
+  p_harness.run("can_transceiver/send/virtual", iterations, [&]() {
+    can->send(messages[0]);
+  });
+  p_harness.run("can_transceiver/send/batch_8", iterations, [&]() {
+    do_not_optimize(can->send(messages));
+  });
+  do_not_optimize(can_driver.m_sent);
+
+  mock_in_endpoint endpoint_driver;
+  auto* const endpoint = opaque<hal::v5::usb::in_endpoint>(&endpoint_driver);
+  p_harness.run("usb_in_endpoint/write/scatter_3", iterations, [&]() {
+    endpoint->write(write_pieces);
+  });
+  do_not_optimize(endpoint_driver.m_bytes);
+
+  hal::i2c::settings const fast{ .clock_rate = 400.0_kHz };
+  hal::spi_channel::settings const spi_settings{};
+  hal::v5::serial::settings const serial_settings{};
+  p_harness.run("i2c/settings/compare", iterations, [&]() {
+    auto const* other = opaque(&fast);
+    do_not_optimize(*other == hal::i2c::settings{});
+  });
+  p_harness.run("spi_channel/settings/compare", iterations, [&]() {
+    auto const* other = opaque(&spi_settings);
+    do_not_optimize(*other == hal::spi_channel::settings{});
+  });
+  p_harness.run("serial/settings/compare", iterations, [&]() {
+    auto const* other = opaque(&serial_settings);
+    do_not_optimize(*other == hal::v5::serial::settings{});
+  });
+
+  p_harness.run("scatter_span/iterate_3", iterations, [&]() {
+    usize total = 0;
+    for (auto const& segment : *opaque(&write_pieces)) {
+      total += segment.size();
+    }
+    do_not_optimize(total);
+  });
+}
+}  // namespace hal::benchmark
@@ -0,0 +1,70 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <string_view>
+
+#include "benchmark.hpp"
+
+/// Runs every benchmark on the host
+///
+/// Prints one CSV row per benchmark, or a JSON array with `--json`, so
+/// results can be compared between builds for regression tracking.
+int main(int p_argc, char const* const* p_argv)
+{
+  using namespace hal::benchmark;
+
+  bool const json = p_argc > 1 && std::string_view(p_argv[1]) == "--json";
+  bool first = true;
+
+  auto now = []() -> hal::u64 {
+    auto const time = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<hal::u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+  };
+  auto print = [json, &first](result const& p_result) {
+    auto const name_size = static_cast<int>(p_result.name.size());
+    if (json) {
+      std::printf("%s\n  { \"name\": \"%.*s\", \"iterations\": %" PRIu64
+                  ", \"ns_per_op\": %.2f, \"cycles_per_op\": %.2f }",
+                  first ? "" : ",",
+                  name_size,
+                  p_result.name.data(),
+                  p_result.iterations,
+                  static_cast<double>(p_result.ns_per_op()),
+                  static_cast<double>(p_result.cycles_per_op()));
+    } else {
+      std::printf("%.*s,%" PRIu64 ",%.2f,%.2f\n",
+                  name_size,
+                  p_result.name.data(),
+                  p_result.iterations,
+                  static_cast<double>(p_result.ns_per_op()),
+                  static_cast<double>(p_result.cycles_per_op()));
+    }
+    first = false;
+  };
+
+  harness bench(now, print, host_cycles);
+  std::printf(json ? "[" : "name,iterations,ns_per_op,cycles_per_op\n");
+  exception_benchmarks(bench);
+  container_benchmarks(bench);
+  signal_benchmarks(bench);
+  interface_benchmarks(bench);
+  if (json) {
+    std::printf("\n]\n");
+  }
+  return 0;
+}
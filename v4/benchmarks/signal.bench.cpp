@@ -0,0 +1,194 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include <libhal/attitude_filter.hpp>
+#include <libhal/cobs.hpp>
+#include <libhal/crc.hpp>
+#include <libhal/sample_conversion.hpp>
+#include <libhal/stream_dac_conversion.hpp>
+
+#include "benchmark.hpp"
+
+namespace hal::benchmark {
+namespace {
+constexpr u64 iterations = 100'000;
+constexpr usize block_size = 256;
+
+/// Per byte COBS decoder, the baseline the block decoder is compared against
+usize decode_bytewise(std::span<hal::byte const> p_stream,
+                      std::span<hal::byte> p_frame)
+{
+  usize size = 0;
+  usize remaining = 0;
+  bool implied_zero = false;
+  usize frames = 0;
+  for (auto const data : p_stream) {
+    if (data == 0) {
+      frames++;
+      size = 0;
+      remaining = 0;
+      implied_zero = false;
+    } else if (remaining == 0) {
+      if (implied_zero) {
+        p_frame[size++] = 0;
+      }
+      remaining = data - 1u;
+      implied_zero = data != 0xFF;
+    } else {
+      p_frame[size++] = data;
+      remaining--;
+    }
+  }
+  return frames;
+}
+
+/// Per sample dac justification, the baseline for the word at a time kernel
+void right_justify_loop(std::span<u16 const> p_source,
+                        std::span<u16> p_destination,
+                        u8 p_unused_bits,
+                        u16 p_flags)
+{
+  for (usize i = 0; i < p_source.size(); i++) {
+    p_destination[i] =
+      static_cast<u16>((p_source[i] >> p_unused_bits) | p_flags);
+  }
+}
+
+/// Per sample widening, the baseline for the word at a time kernel
+void expand_loop(std::span<u8 const> p_source, std::span<u16> p_destination)
+{
+  for (usize i = 0; i < p_source.size(); i++) {
+    p_destination[i] = static_cast<u16>(p_source[i] * 0x0101);
+  }
+}
+}  // namespace
+
+void signal_benchmarks(harness& p_harness)
+{
+  std::array<u16, block_size> samples{};
+  for (usize i = 0; i < samples.size(); i++) {
+    samples[i] = static_cast<u16>(i * 257);
+  }
+  std::array<i16, block_size> q15{};
+  std::array<i32, block_size> q31{};
+  std::array<float, block_size> floats{};
+
+  // Fixed point kernels against the float kernel over the same block
+  p_harness.run("adc16_to_q15/256", iterations, [&]() {
+    do_not_optimize(adc16_to_q15(samples, q15).data());
+  });
+  p_harness.run("adc16_to_q31/256", iterations, [&]() {
+    do_not_optimize(adc16_to_q31(samples, q31).data());
+  });
+  p_harness.run("adc16_to_float/256", iterations, [&]() {
+    do_not_optimize(adc16_to_float(samples, floats).data());
+  });
+
+  accelerometer::read_t const acceleration{ .x = 0.1f, .y = 0.2f, .z = 1.0f };
+  gyroscope::read_t const angular_velocity{ .x = 3.0f, .y = -2.0f, .z = 1.0f };
+  magnetometer::read_t const magnetic_field{ .x = 0.3f, .y = 0.0f, .z = 0.4f };
+
+  mahony_filter mahony({ .sample_rate = 1.0_kHz, .integral_gain = 0.1f });
+  p_harness.run("mahony_filter/update/6_axis", iterations, [&]() {
+    mahony.update(acceleration, angular_velocity);
+    do_not_optimize(mahony.orientation());
+  });
+  p_harness.run("mahony_filter/update/9_axis", iterations, [&]() {
+    mahony.update(acceleration, angular_velocity, magnetic_field);
+    do_not_optimize(mahony.orientation());
+  });
+
+  madgwick_filter madgwick({ .sample_rate = 1.0_kHz });
+  p_harness.run("madgwick_filter/update/6_axis", iterations, [&]() {
+    madgwick.update(acceleration, angular_velocity);
+    do_not_optimize(madgwick.orientation());
+  });
+
+  // Integrity checks over one block, contiguous and split into 3 segments
+  std::array<hal::byte, block_size> frame{};
+  for (usize i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<hal::byte>(i * 7);
+  }
+  std::span<hal::byte const> const bytes(frame);
+  auto const segments =
+    make_scatter_bytes(bytes.first(16), bytes.subspan(16, 224), bytes.last(16));
+  p_harness.run("crc32/table/256", iterations, [&]() {
+    do_not_optimize(crc32(*opaque(&bytes)));
+  });
+  p_harness.run("crc32/slice8/256", iterations, [&]() {
+    do_not_optimize(crc32_slice8(*opaque(&bytes)));
+  });
+  p_harness.run("crc32/slice8/scatter_3", iterations, [&]() {
+    do_not_optimize(crc32_slice8(scatter_span<hal::byte const>(segments)));
+  });
+  p_harness.run("crc16_ccitt/table/256", iterations, [&]() {
+    do_not_optimize(crc16_ccitt(*opaque(&bytes)));
+  });
+
+  // COBS framing of one block with a zero every 64 bytes
+  std::array<hal::byte, block_size> message{};
+  for (usize i = 0; i < message.size(); i++) {
+    message[i] = static_cast<hal::byte>(i % 64 == 63 ? 0 : i + 1);
+  }
+  p_harness.run("cobs_frame/encode/256", iterations, [&]() {
+    cobs_frame<16> encoded(std::span<hal::byte const>(*opaque(&message)));
+    do_not_optimize(encoded.segments().data());
+  });
+  std::array<hal::byte, block_size + 8> stream{};
+  scatter_copy(cobs_frame<16>(std::span<hal::byte const>(message)).segments(),
+               std::span<hal::byte>(stream));
+  std::array<hal::byte, block_size> decoded{};
+  cobs_deframer deframer(decoded);
+  p_harness.run("cobs_deframer/feed/256", iterations, [&]() {
+    usize frames = 0;
+    deframer.feed(std::span<hal::byte const>(*opaque(&stream)),
+                  [&frames](std::span<hal::byte const>) { frames++; });
+    do_not_optimize(frames);
+  });
+  p_harness.run("cobs/bytewise_decode/256", iterations, [&]() {
+    do_not_optimize(decode_bytewise(*opaque(&stream), decoded));
+  });
+
+  // Stream dac preparation of one block: 16-bit samples into a 12-bit right
+  // justified dac with control bits, and PCM8 widened into the same dac
+  std::array<u16, block_size> dac_block{};
+  p_harness.run("right_justify/copy/256", iterations, [&]() {
+    right_justify<u16>(*opaque(&samples), dac_block, 4, 0x3000);
+    do_not_optimize(dac_block.data());
+  });
+  p_harness.run("right_justify/per_sample/256", iterations, [&]() {
+    right_justify_loop(*opaque(&samples), dac_block, 4, 0x3000);
+    do_not_optimize(dac_block.data());
+  });
+  std::array<u8, block_size> pcm8{};
+  for (usize i = 0; i < pcm8.size(); i++) {
+    pcm8[i] = static_cast<u8>(i * 7);
+  }
+  p_harness.run("expand/u8_to_u16/256", iterations, [&]() {
+    expand<u8, u16>(*opaque(&pcm8), dac_block);
+    do_not_optimize(dac_block.data());
+  });
+  p_harness.run("expand/per_sample/256", iterations, [&]() {
+    expand_loop(*opaque(&pcm8), dac_block);
+    do_not_optimize(dac_block.data());
+  });
+  p_harness.run("stream_dac_feeder/u8_to_u12/256", iterations, [&]() {
+    stream_dac_feeder<u8, u16> feeder(*opaque(&pcm8),
+                                      { .unused_bits = 4, .flags = 0x3000 });
+    do_not_optimize(feeder.fill(dac_block));
+  });
+}
+}  // namespace hal::benchmark
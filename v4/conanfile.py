@@ -33,7 +33,8 @@ class libhal_conan(ConanFile):
                    "peripherals and devices using modern C++")
     topics = ("peripherals", "hardware", "abstraction", "devices", "hal")
     settings = "compiler", "build_type", "os", "arch"
-    exports_sources = "include/*", "tests/*", "CMakeLists.txt", "LICENSE"
+    exports_sources = (
+        "include/*", "tests/*", "benchmarks/*", "CMakeLists.txt", "LICENSE")
     package_type = "header-library"
     no_copy_source = True
 
@@ -0,0 +1,101 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <optional>
+#include <span>
+
+#include "error.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Multi-channel Analog to Digital Converter (ADC) scan interface
+ *
+ * Use this interface for ADC peripherals that can convert a sequence of
+ * channels with a single trigger, usually moving the results to memory with
+ * DMA. Sampling 8 channels then costs one virtual call and one hardware scan
+ * sequence, instead of 8 calls to `hal::adc16::read()` with a conversion
+ * trigger each.
+ *
+ * Samples follow the same scaling rules as `hal::adc16` and `hal::adc24`: the
+ * driver upscales samples from ADCs of lower resolution to the full width of
+ * `sample_t`.
+ *
+ * @tparam sample_t - type of each sample, u16 for ADCs of 16-bits and below and
+ * u32 for ADCs of 17 to 24-bits
+ */
+template<std::unsigned_integral sample_t>
+class adc_scan
+{
+public:
+  /**
+   * @brief Convert a list of channels, one or more times
+   *
+   * Samples are interleaved: `p_samples[i * p_channels.size() + c]` holds
+   * the sample of `p_channels[c]` from the i-th scan. Filling a span of
+   * `n * p_channels.size()` samples runs the scan sequence `n` times.
+   *
+   * Blocks until every sample has been written. Drivers using DMA should wait
+   * on an `hal::io_waiter` while the scans are running.
+   *
+   * @param p_channels - driver specific channel numbers to convert, in order.
+   * A channel may appear more than once.
+   * @param p_samples - buffer to write the samples to. Its size must be a
+   * multiple of the number of channels.
+   * @param p_scan_rate - rate at which to start each scan sequence when
+   * running more than one scan. `std::nullopt` starts the next scan as soon
+   * as the previous one finishes.
+   * @throws hal::argument_out_of_domain - if p_channels is empty, the size of
+   * p_samples is not a multiple of the number of channels, a channel does not
+   * exist, or the scan rate cannot be achieved by the driver.
+   */
+  void scan(std::span<u8 const> p_channels,
+            std::span<sample_t> p_samples,
+            std::optional<hertz> p_scan_rate = std::nullopt)
+  {
+    if (p_channels.empty() || p_samples.size() % p_channels.size() != 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    driver_scan(p_channels, p_samples, p_scan_rate);
+  }
+
+  virtual ~adc_scan() = default;
+
+private:
+  virtual void driver_scan(std::span<u8 const> p_channels,
+                           std::span<sample_t> p_samples,
+                           std::optional<hertz> p_scan_rate) = 0;
+};
+
+/**
+ * @brief Shorthand for adc_scan<u16>, for ADCs of 16-bits and below
+ *
+ */
+using adc16_scan = adc_scan<u16>;
+
+/**
+ * @brief Shorthand for adc_scan<u32>, for ADCs of 17 to 24-bits
+ *
+ */
+using adc24_scan = adc_scan<u32>;
+}  // namespace hal::v5
+
+namespace hal {
+using v5::adc16_scan;
+using v5::adc24_scan;
+using v5::adc_scan;
+}  // namespace hal
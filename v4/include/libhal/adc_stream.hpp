@@ -0,0 +1,169 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <optional>
+#include <span>
+
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Continuous Analog to Digital Converter (ADC) streaming interface
+ *
+ * Use this interface for ADC peripherals that can sample continuously at a
+ * fixed rate, with DMA or another mechanism writing each sample into a
+ * circular buffer in memory without CPU intervention. This mirrors the
+ * receive side of `hal::zero_copy_serial`: the application supplies the
+ * circular buffer to the driver at construction, `receive_buffer()` exposes
+ * it, and `receive_cursor()` reports where the next sample will be written.
+ * Samples are processed in place, so there is no per-sample CPU work or
+ * copying at rates where `hal::adc16::read()` cannot keep up.
+ *
+ * Samples follow the same scaling rules as `hal::adc16` and `hal::adc24`: the
+ * driver upscales samples from ADCs of lower resolution to the full width of
+ * `sample_t`.
+ *
+ * Example usage:
+ *
+ * ```
+ * adc.configure({ .sample_rate = 200.0_kHz });
+ * auto last = adc.receive_cursor();
+ *
+ * while (true) {
+ *   auto const buffer = adc.receive_buffer();
+ *   auto const cursor = adc.receive_cursor();
+ *   for (auto i = last; i != cursor; i = (i + 1) % buffer.size()) {
+ *     filter.feed(buffer[i]);
+ *   }
+ *   last = cursor;
+ * }
+ * ```
+ *
+ * @tparam sample_t - type of each sample, u16 for ADCs of 16-bits and below and
+ * u32 for ADCs of 17 to 24-bits
+ */
+template<std::unsigned_integral sample_t>
+class adc_stream
+{
+public:
+  /**
+   * @brief Generic settings for a streaming ADC
+   *
+   */
+  struct settings
+  {
+    /// Rate at which samples are written into the receive buffer
+    hertz sample_rate = 10.0_kHz;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator<=>(settings const&) const = default;
+  };
+
+  /**
+   * @brief Configure the sample rate and start sampling
+   *
+   * Sampling continues until the driver is destroyed or reconfigured. The
+   * cursor is not reset by reconfiguring.
+   *
+   * @param p_settings - settings to apply to the ADC
+   * @throws hal::operation_not_supported - if the sample rate cannot be
+   * achieved.
+   */
+  void configure(settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Returns the circular receive buffer of samples
+   *
+   * The buffer is supplied by the application when the driver is constructed
+   * and is written to continuously by the driver.
+   *
+   * @return std::span<sample_t const> - the receive buffer
+   */
+  [[nodiscard]] std::span<sample_t const> receive_buffer()
+  {
+    return driver_receive_buffer();
+  }
+
+  /**
+   * @brief Returns the position where the next sample will be written
+   *
+   * Samples before the cursor, back to the data last consumed by the
+   * application, are complete and can be read in place. The cursor wraps
+   * around to 0 at the end of the receive buffer.
+   *
+   * @return usize - position of the write cursor within the receive buffer
+   */
+  [[nodiscard]] usize receive_cursor()
+  {
+    return driver_cursor();
+  }
+
+  /**
+   * @brief Returns the total number of samples written since sampling started
+   *
+   * The count wraps at the maximum of `usize`. The difference between two
+   * counts reveals whether more than a buffer's worth of samples arrived
+   * between two reads, meaning the driver has lapped the reader and samples
+   * were lost.
+   *
+   * Support for this is optional. Drivers that do not count samples return
+   * `std::nullopt`.
+   *
+   * @return std::optional<usize> - running count of samples or std::nullopt
+   * if the driver does not count samples.
+   */
+  [[nodiscard]] std::optional<usize> receive_count()
+  {
+    return driver_receive_count();
+  }
+
+  virtual ~adc_stream() = default;
+
+private:
+  virtual void driver_configure(settings const& p_settings) = 0;
+  virtual std::span<sample_t const> driver_receive_buffer() = 0;
+  virtual usize driver_cursor() = 0;
+  virtual std::optional<usize> driver_receive_count()
+  {
+    return std::nullopt;
+  }
+};
+
+/**
+ * @brief Shorthand for adc_stream<u16>, for ADCs of 16-bits and below
+ *
+ */
+using adc16_stream = adc_stream<u16>;
+
+/**
+ * @brief Shorthand for adc_stream<u32>, for ADCs of 17 to 24-bits
+ *
+ */
+using adc24_stream = adc_stream<u32>;
+}  // namespace hal::v5
+
+namespace hal {
+using v5::adc16_stream;
+using v5::adc24_stream;
+using v5::adc_stream;
+}  // namespace hal
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <iterator>
 #include <memory_resource>
 #include <type_traits>
@@ -22,6 +24,24 @@
 #include "units.hpp"
 
 namespace hal::v5 {
+/**
+ * @brief Tag type selecting the construction of an allocated_buffer whose
+ * elements are left uninitialized
+ *
+ */
+struct for_overwrite_t
+{
+  explicit for_overwrite_t() = default;
+};
+
+/**
+ * @brief Tag selecting the construction of an allocated_buffer whose elements
+ * are left uninitialized
+ *
+ * Like `std::make_unique_for_overwrite`, this skips initializing memory that
+ * will be overwritten anyway, such as a large DMA receive buffer.
+ */
+inline constexpr for_overwrite_t for_overwrite{};
 
 /**
  * @brief A dynamically allocated buffer with runtime size.
@@ -103,7 +123,9 @@ public:
   /**
    * @brief Create a allocated_buffer with specified size
    *
-   * All elements are default-constructed.
+   * All elements are default-constructed, which leaves trivial types such as
+   * integers uninitialized. To zero them, pass `T{}` to the constructor taking
+   * an initial value.
    * If p_size is 0, an array of size 1 will be allocated.
    *
    * @param p_allocator The allocator to use for memory allocation
@@ -129,6 +151,39 @@ public:
     }
   }
 
+  /**
+   * @brief Create a allocated_buffer with specified size and uninitialized
+   * elements
+   *
+   * The elements' values are indeterminate until they are written, which makes
+   * construction O(1). Intended for large buffers, like DMA receive buffers,
+   * that the hardware overwrites before they are read.
+   * If p_size is 0, an array of size 1 will be allocated.
+   *
+   * @param p_allocator The allocator to use for memory allocation
+   * @param p_size The number of elements in the array
+   * @param p_alignment Alignment of the first element in bytes, for example a
+   * cache line or DMA boundary. Values below `alignof(T)` are raised to it.
+   * @throws std::bad_alloc if memory allocation fails
+   * @throws hal::argument_out_of_domain if p_alignment is not a power of 2
+   */
+  allocated_buffer(std::pmr::polymorphic_allocator<> p_allocator,
+                   size_type p_size,
+                   for_overwrite_t,
+                   usize p_alignment = alignof(T))
+    requires(std::is_trivially_default_constructible_v<T>)
+    : m_size(std::max<size_type>(1, p_size))
+    , m_alignment(std::max<usize>(alignof(T), p_alignment))
+    , m_allocator(p_allocator)
+  {
+    if (not std::has_single_bit(p_alignment)) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    // Trivial types begin their lifetime with the storage
+    m_data = static_cast<pointer>(
+      m_allocator.allocate_bytes(sizeof(T) * m_size, m_alignment));
+  }
+
   /**
    * @brief Create a allocated_buffer with specified size and initial value
    *
@@ -503,13 +558,14 @@ private:
       }
 
       // Deallocate memory
-      m_allocator.deallocate_bytes(m_data, sizeof(T) * m_size, alignof(T));
+      m_allocator.deallocate_bytes(m_data, sizeof(T) * m_size, m_alignment);
       m_data = nullptr;
     }
   }
 
-  size_type m_size = 0;      ///< Number of elements
-  pointer m_data = nullptr;  ///< Pointer to allocated memory
+  size_type m_size = 0;            ///< Number of elements
+  usize m_alignment = alignof(T);  ///< Alignment of the allocation
+  pointer m_data = nullptr;        ///< Pointer to allocated memory
   std::pmr::polymorphic_allocator<> m_allocator;  ///< Allocator
 };
 
@@ -586,9 +642,32 @@ template<typename T>
 {
   return allocated_buffer<T>(p_allocator, p_size, p_value);
 }
+
+/**
+ * @brief Creates a allocated_buffer with the given size and uninitialized
+ * elements
+ *
+ * @tparam T The trivially default constructible type of elements
+ * @param p_allocator The allocator to use
+ * @param p_size The size of the allocated_buffer
+ * @param p_alignment Alignment of the first element in bytes
+ * @return A new allocated_buffer of the specified size whose elements have
+ * indeterminate values
+ */
+template<typename T>
+[[nodiscard]] allocated_buffer<T> make_allocated_buffer_for_overwrite(
+  std::pmr::polymorphic_allocator<> p_allocator,
+  typename allocated_buffer<T>::size_type p_size,
+  usize p_alignment = alignof(T))
+{
+  return allocated_buffer<T>(p_allocator, p_size, for_overwrite, p_alignment);
+}
 }  // namespace hal::v5
 
 namespace hal {
 using v5::allocated_buffer;
+using v5::for_overwrite;
+using v5::for_overwrite_t;
 using v5::make_allocated_buffer;
+using v5::make_allocated_buffer_for_overwrite;
 }  // namespace hal
@@ -0,0 +1,508 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <numbers>
+#include <span>
+
+#include "accelerometer.hpp"
+#include "error.hpp"
+#include "gyroscope.hpp"
+#include "magnetometer.hpp"
+#include "units.hpp"
+
+/**
+ * @file attitude_filter.hpp
+ * @brief Attitude estimation filters for accelerometer, gyroscope and
+ * magnetometer samples
+ *
+ * The filters integrate gyroscope samples into an orientation and correct the
+ * drift of the integration with the direction of gravity, measured by the
+ * accelerometer, and optionally of the earth's magnetic field, measured by the
+ * magnetometer. Each update costs a few dozen floating point operations and no
+ * trigonometric functions, so the filters easily run at 2kHz on MCUs with an
+ * FPU.
+ *
+ * Each sample's update depends on the orientation computed from the previous
+ * one, so samples cannot be processed in parallel across SIMD lanes. The span
+ * overloads instead remove the per-sample call overhead, and pair well with
+ * `read_batch()` of the motion sensor interfaces.
+ */
+
+namespace hal::v5 {
+/**
+ * @brief Orientation represented as a unit quaternion
+ *
+ * The quaternion rotates vectors from the sensor's reference frame into the
+ * earth's reference frame.
+ */
+struct quaternion
+{
+  /// Scalar part
+  float w = 1.0f;
+  /// X component of the vector part
+  float x = 0.0f;
+  /// Y component of the vector part
+  float y = 0.0f;
+  /// Z component of the vector part
+  float z = 0.0f;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(quaternion const&) const = default;
+};
+
+namespace detail {
+/// Scale the vector to a length of 1, returns false if its length is 0
+inline bool normalize(float& p_x, float& p_y, float& p_z)
+{
+  auto const norm = (p_x * p_x) + (p_y * p_y) + (p_z * p_z);
+  if (norm == 0.0f) {
+    return false;
+  }
+  auto const inverse = 1.0f / std::sqrt(norm);
+  p_x *= inverse;
+  p_y *= inverse;
+  p_z *= inverse;
+  return true;
+}
+
+/// Scale the quaternion to a length of 1, returns false if its length is 0
+inline bool normalize(quaternion& p_q)
+{
+  auto const norm = (p_q.w * p_q.w) + (p_q.x * p_q.x) + (p_q.y * p_q.y) +
+                    (p_q.z * p_q.z);
+  if (norm == 0.0f) {
+    return false;
+  }
+  auto const inverse = 1.0f / std::sqrt(norm);
+  p_q.w *= inverse;
+  p_q.x *= inverse;
+  p_q.y *= inverse;
+  p_q.z *= inverse;
+  return true;
+}
+
+/// Multiply by this to convert rpm to radians per second
+constexpr float rpm_to_radians = 2.0f * std::numbers::pi_v<float> / 60.0f;
+
+/// Throw argument_out_of_domain if any span is not of size p_size
+template<class... Spans>
+void require_same_size(void const* p_instance, usize p_size, Spans... p_spans)
+{
+  if (((p_spans.size() != p_size) || ...)) {
+    hal::safe_throw(hal::argument_out_of_domain(p_instance));
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Mahony attitude filter
+ *
+ * Corrects the gyroscope integration with a proportional-integral feedback of
+ * the error between the measured and the estimated directions of gravity and,
+ * when magnetometer samples are supplied, of the magnetic field. With an
+ * integral gain of 0, this is a complementary filter: the proportional gain
+ * sets the crossover between trusting the gyroscope for fast motion and the
+ * accelerometer for the long term attitude. The integral term additionally
+ * learns and cancels constant gyroscope bias.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::mahony_filter filter({ .sample_rate = 2.0_kHz });
+ * auto const count = accelerometer.read_batch(accel_samples).size();
+ * gyroscope.read_batch(gyro_samples);
+ * auto const attitude = filter.update(accel_samples.first(count),
+ *                                     gyro_samples.first(count));
+ * ```
+ */
+class mahony_filter
+{
+public:
+  /**
+   * @brief Settings of the filter
+   *
+   */
+  struct settings
+  {
+    /// Rate at which samples are passed to `update()`
+    hertz sample_rate = 1.0_kHz;
+    /// Proportional feedback gain, higher values trust the gyroscope less
+    float proportional_gain = 1.0f;
+    /// Integral feedback gain, 0 disables gyroscope bias estimation
+    float integral_gain = 0.0f;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator<=>(settings const&) const = default;
+  };
+
+  /**
+   * @brief Construct a filter with an orientation of identity
+   *
+   * @param p_settings - settings of the filter
+   * @throws hal::argument_out_of_domain - if the sample rate is not positive
+   */
+  explicit mahony_filter(settings const& p_settings)
+    : m_settings(p_settings)
+  {
+    if (not(p_settings.sample_rate > 0.0f)) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_period = 1.0f / p_settings.sample_rate;
+  }
+
+  /**
+   * @brief Update the orientation with one 6-axis sample
+   *
+   * An acceleration of 0 on every axis skips the correction, leaving only the
+   * gyroscope integration.
+   *
+   * @param p_acceleration - accelerometer sample
+   * @param p_angular_velocity - gyroscope sample
+   */
+  void update(accelerometer::read_t const& p_acceleration,
+              gyroscope::read_t const& p_angular_velocity)
+  {
+    update(p_acceleration,
+           p_angular_velocity,
+           magnetometer::read_t{ .x = 0.0f, .y = 0.0f, .z = 0.0f });
+  }
+
+  /**
+   * @brief Update the orientation with one 9-axis sample
+   *
+   * A magnetic field of 0 on every axis falls back to the 6-axis update.
+   *
+   * @param p_acceleration - accelerometer sample
+   * @param p_angular_velocity - gyroscope sample
+   * @param p_magnetic_field - magnetometer sample
+   */
+  void update(accelerometer::read_t const& p_acceleration,
+              gyroscope::read_t const& p_angular_velocity,
+              magnetometer::read_t const& p_magnetic_field)
+  {
+    auto const& q = m_orientation;
+    auto gx = p_angular_velocity.x * detail::rpm_to_radians;
+    auto gy = p_angular_velocity.y * detail::rpm_to_radians;
+    auto gz = p_angular_velocity.z * detail::rpm_to_radians;
+    auto ax = p_acceleration.x;
+    auto ay = p_acceleration.y;
+    auto az = p_acceleration.z;
+
+    if (detail::normalize(ax, ay, az)) {
+      // Estimated direction of gravity, halved
+      auto const vx = (q.x * q.z) - (q.w * q.y);
+      auto const vy = (q.w * q.x) + (q.y * q.z);
+      auto const vz = (q.w * q.w) - 0.5f + (q.z * q.z);
+      auto ex = (ay * vz) - (az * vy);
+      auto ey = (az * vx) - (ax * vz);
+      auto ez = (ax * vy) - (ay * vx);
+
+      auto mx = p_magnetic_field.x;
+      auto my = p_magnetic_field.y;
+      auto mz = p_magnetic_field.z;
+      if (detail::normalize(mx, my, mz)) {
+        // Direction of the magnetic field in the earth's reference frame
+        auto const hx = 2.0f * ((mx * (0.5f - (q.y * q.y) - (q.z * q.z))) +
+                                (my * ((q.x * q.y) - (q.w * q.z))) +
+                                (mz * ((q.x * q.z) + (q.w * q.y))));
+        auto const hy = 2.0f * ((mx * ((q.x * q.y) + (q.w * q.z))) +
+                                (my * (0.5f - (q.x * q.x) - (q.z * q.z))) +
+                                (mz * ((q.y * q.z) - (q.w * q.x))));
+        auto const bx = std::sqrt((hx * hx) + (hy * hy));
+        auto const bz = 2.0f * ((mx * ((q.x * q.z) - (q.w * q.y))) +
+                                (my * ((q.y * q.z) + (q.w * q.x))) +
+                                (mz * (0.5f - (q.x * q.x) - (q.y * q.y))));
+        // Estimated direction of the magnetic field, halved
+        auto const wx = (bx * (0.5f - (q.y * q.y) - (q.z * q.z))) +
+                        (bz * ((q.x * q.z) - (q.w * q.y)));
+        auto const wy = (bx * ((q.x * q.y) - (q.w * q.z))) +
+                        (bz * ((q.w * q.x) + (q.y * q.z)));
+        auto const wz = (bx * ((q.w * q.y) + (q.x * q.z))) +
+                        (bz * (0.5f - (q.x * q.x) - (q.y * q.y)));
+        ex += (my * wz) - (mz * wy);
+        ey += (mz * wx) - (mx * wz);
+        ez += (mx * wy) - (my * wx);
+      }
+
+      if (m_settings.integral_gain > 0.0f) {
+        auto const integral = 2.0f * m_settings.integral_gain * m_period;
+        m_integral_x += integral * ex;
+        m_integral_y += integral * ey;
+        m_integral_z += integral * ez;
+        gx += m_integral_x;
+        gy += m_integral_y;
+        gz += m_integral_z;
+      }
+      auto const proportional = 2.0f * m_settings.proportional_gain;
+      gx += proportional * ex;
+      gy += proportional * ey;
+      gz += proportional * ez;
+    }
+
+    integrate(gx, gy, gz);
+  }
+
+  /**
+   * @brief Update the orientation with a batch of 6-axis samples
+   *
+   * @param p_acceleration - accelerometer samples, oldest first
+   * @param p_angular_velocity - gyroscope samples, oldest first
+   * @return quaternion - orientation after the last sample
+   * @throws hal::argument_out_of_domain - if the spans differ in size
+   */
+  quaternion update(std::span<accelerometer::read_t const> p_acceleration,
+                    std::span<gyroscope::read_t const> p_angular_velocity)
+  {
+    detail::require_same_size(this, p_acceleration.size(), p_angular_velocity);
+    for (usize i = 0; i < p_acceleration.size(); i++) {
+      update(p_acceleration[i], p_angular_velocity[i]);
+    }
+    return m_orientation;
+  }
+
+  /**
+   * @brief Update the orientation with a batch of 9-axis samples
+   *
+   * @param p_acceleration - accelerometer samples, oldest first
+   * @param p_angular_velocity - gyroscope samples, oldest first
+   * @param p_magnetic_field - magnetometer samples, oldest first
+   * @return quaternion - orientation after the last sample
+   * @throws hal::argument_out_of_domain - if the spans differ in size
+   */
+  quaternion update(std::span<accelerometer::read_t const> p_acceleration,
+                    std::span<gyroscope::read_t const> p_angular_velocity,
+                    std::span<magnetometer::read_t const> p_magnetic_field)
+  {
+    detail::require_same_size(
+      this, p_acceleration.size(), p_angular_velocity, p_magnetic_field);
+    for (usize i = 0; i < p_acceleration.size(); i++) {
+      update(p_acceleration[i], p_angular_velocity[i], p_magnetic_field[i]);
+    }
+    return m_orientation;
+  }
+
+  /**
+   * @brief Get the estimated orientation
+   *
+   * @return quaternion - orientation after the latest update
+   */
+  [[nodiscard]] quaternion orientation() const
+  {
+    return m_orientation;
+  }
+
+  /**
+   * @brief Restart the filter from an orientation
+   *
+   * Also clears the estimated gyroscope bias.
+   *
+   * @param p_orientation - unit quaternion to restart from
+   */
+  void reset(quaternion const& p_orientation = {})
+  {
+    m_orientation = p_orientation;
+    m_integral_x = 0.0f;
+    m_integral_y = 0.0f;
+    m_integral_z = 0.0f;
+  }
+
+private:
+  void integrate(float p_gx, float p_gy, float p_gz)
+  {
+    auto& q = m_orientation;
+    auto const half_period = 0.5f * m_period;
+    p_gx *= half_period;
+    p_gy *= half_period;
+    p_gz *= half_period;
+    auto const previous = q;
+    q.w += (-previous.x * p_gx) - (previous.y * p_gy) - (previous.z * p_gz);
+    q.x += (previous.w * p_gx) + (previous.y * p_gz) - (previous.z * p_gy);
+    q.y += (previous.w * p_gy) - (previous.x * p_gz) + (previous.z * p_gx);
+    q.z += (previous.w * p_gz) + (previous.x * p_gy) - (previous.y * p_gx);
+    detail::normalize(q);
+  }
+
+  settings m_settings;
+  quaternion m_orientation{};
+  float m_period = 0.0f;
+  float m_integral_x = 0.0f;
+  float m_integral_y = 0.0f;
+  float m_integral_z = 0.0f;
+};
+
+/**
+ * @brief Madgwick attitude filter
+ *
+ * Corrects the gyroscope integration with a gradient descent step towards the
+ * orientation whose estimated direction of gravity matches the accelerometer.
+ * The gain sets the step size, trading convergence speed against noise from
+ * the accelerometer.
+ *
+ * Only 6-axis samples are supported. Use `hal::mahony_filter` to include
+ * magnetometer samples.
+ */
+class madgwick_filter
+{
+public:
+  /**
+   * @brief Settings of the filter
+   *
+   */
+  struct settings
+  {
+    /// Rate at which samples are passed to `update()`
+    hertz sample_rate = 1.0_kHz;
+    /// Gradient descent gain
+    float gain = 0.1f;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator<=>(settings const&) const = default;
+  };
+
+  /**
+   * @brief Construct a filter with an orientation of identity
+   *
+   * @param p_settings - settings of the filter
+   * @throws hal::argument_out_of_domain - if the sample rate is not positive
+   */
+  explicit madgwick_filter(settings const& p_settings)
+    : m_gain(p_settings.gain)
+  {
+    if (not(p_settings.sample_rate > 0.0f)) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_period = 1.0f / p_settings.sample_rate;
+  }
+
+  /**
+   * @brief Update the orientation with one 6-axis sample
+   *
+   * An acceleration of 0 on every axis skips the correction, leaving only the
+   * gyroscope integration.
+   *
+   * @param p_acceleration - accelerometer sample
+   * @param p_angular_velocity - gyroscope sample
+   */
+  void update(accelerometer::read_t const& p_acceleration,
+              gyroscope::read_t const& p_angular_velocity)
+  {
+    auto& q = m_orientation;
+    auto const gx = p_angular_velocity.x * detail::rpm_to_radians;
+    auto const gy = p_angular_velocity.y * detail::rpm_to_radians;
+    auto const gz = p_angular_velocity.z * detail::rpm_to_radians;
+
+    // Rate of change of the quaternion from the gyroscope
+    auto dw = 0.5f * ((-q.x * gx) - (q.y * gy) - (q.z * gz));
+    auto dx = 0.5f * ((q.w * gx) + (q.y * gz) - (q.z * gy));
+    auto dy = 0.5f * ((q.w * gy) - (q.x * gz) + (q.z * gx));
+    auto dz = 0.5f * ((q.w * gz) + (q.x * gy) - (q.y * gx));
+
+    auto ax = p_acceleration.x;
+    auto ay = p_acceleration.y;
+    auto az = p_acceleration.z;
+    if (detail::normalize(ax, ay, az)) {
+      auto const ww = q.w * q.w;
+      auto const xx = q.x * q.x;
+      auto const yy = q.y * q.y;
+      auto const zz = q.z * q.z;
+      // Gradient of the error between estimated and measured gravity
+      quaternion step{
+        .w = (4.0f * q.w * yy) + (2.0f * q.y * ax) + (4.0f * q.w * xx) -
+             (2.0f * q.x * ay),
+        .x = (4.0f * q.x * zz) - (2.0f * q.z * ax) + (4.0f * ww * q.x) -
+             (2.0f * q.w * ay) - (4.0f * q.x) + (8.0f * q.x * xx) +
+             (8.0f * q.x * yy) + (4.0f * q.x * az),
+        .y = (4.0f * ww * q.y) + (2.0f * q.w * ax) + (4.0f * q.y * zz) -
+             (2.0f * q.z * ay) - (4.0f * q.y) + (8.0f * q.y * xx) +
+             (8.0f * q.y * yy) + (4.0f * q.y * az),
+        .z = (4.0f * xx * q.z) - (2.0f * q.x * ax) + (4.0f * yy * q.z) -
+             (2.0f * q.y * ay),
+      };
+      if (detail::normalize(step)) {
+        dw -= m_gain * step.w;
+        dx -= m_gain * step.x;
+        dy -= m_gain * step.y;
+        dz -= m_gain * step.z;
+      }
+    }
+
+    q.w += dw * m_period;
+    q.x += dx * m_period;
+    q.y += dy * m_period;
+    q.z += dz * m_period;
+    detail::normalize(q);
+  }
+
+  /**
+   * @brief Update the orientation with a batch of 6-axis samples
+   *
+   * @param p_acceleration - accelerometer samples, oldest first
+   * @param p_angular_velocity - gyroscope samples, oldest first
+   * @return quaternion - orientation after the last sample
+   * @throws hal::argument_out_of_domain - if the spans differ in size
+   */
+  quaternion update(std::span<accelerometer::read_t const> p_acceleration,
+                    std::span<gyroscope::read_t const> p_angular_velocity)
+  {
+    detail::require_same_size(this, p_acceleration.size(), p_angular_velocity);
+    for (usize i = 0; i < p_acceleration.size(); i++) {
+      update(p_acceleration[i], p_angular_velocity[i]);
+    }
+    return m_orientation;
+  }
+
+  /**
+   * @brief Get the estimated orientation
+   *
+   * @return quaternion - orientation after the latest update
+   */
+  [[nodiscard]] quaternion orientation() const
+  {
+    return m_orientation;
+  }
+
+  /**
+   * @brief Restart the filter from an orientation
+   *
+   * @param p_orientation - unit quaternion to restart from
+   */
+  void reset(quaternion const& p_orientation = {})
+  {
+    m_orientation = p_orientation;
+  }
+
+private:
+  quaternion m_orientation{};
+  float m_gain;
+  float m_period = 0.0f;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::madgwick_filter;
+using v5::mahony_filter;
+using v5::quaternion;
+}  // namespace hal
@@ -0,0 +1,232 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <span>
+
+#include "i2c_transaction_queue.hpp"
+#include "serial.hpp"
+#include "units.hpp"
+#include "zero_copy_serial.hpp"
+
+namespace hal::v5 {
+namespace detail {
+/**
+ * @brief Resumes a suspended coroutine once an asynchronous operation completes
+ *
+ * The operation is started from `await_suspend()`. Whichever of
+ * `await_suspend()` and the completion callback runs second decides what
+ * happens next: if the operation completed before the coroutine suspended,
+ * the coroutine continues without suspending, otherwise the completion
+ * callback resumes it.
+ */
+class completion_awaiter
+{
+public:
+  completion_awaiter() = default;
+  completion_awaiter(completion_awaiter const&) = delete;
+  completion_awaiter& operator=(completion_awaiter const&) = delete;
+  completion_awaiter(completion_awaiter&&) = delete;
+  completion_awaiter& operator=(completion_awaiter&&) = delete;
+  ~completion_awaiter() = default;
+
+  [[nodiscard]] bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+protected:
+  /**
+   * @brief Finish suspending after the operation has been started
+   *
+   * @return true - the coroutine stays suspended until complete() is called
+   * @return false - the operation already completed
+   */
+  bool suspend(std::coroutine_handle<> p_handle)
+  {
+    m_handle = p_handle;
+    return not m_arrived.exchange(true, std::memory_order_acq_rel);
+  }
+
+  /**
+   * @brief Called from the completion callback of the operation
+   *
+   */
+  void complete() noexcept
+  {
+    if (m_arrived.exchange(true, std::memory_order_acq_rel)) {
+      m_handle.resume();
+    }
+  }
+
+private:
+  std::coroutine_handle<> m_handle{};
+  std::atomic<bool> m_arrived = false;
+};
+
+/**
+ * @brief Awaiter for `hal::v5::async_write()`
+ *
+ * @tparam Serial - serial interface with a `write_async()` API
+ */
+template<class Serial>
+class serial_write_awaiter : public completion_awaiter
+{
+public:
+  serial_write_awaiter(Serial& p_serial, std::span<hal::byte const> p_data)
+    : m_serial(&p_serial)
+    , m_data(p_data)
+  {
+  }
+
+  bool await_suspend(std::coroutine_handle<> p_handle)
+  {
+    m_serial->write_async(m_data, [this]() { complete(); });
+    return suspend(p_handle);
+  }
+
+  void await_resume() const noexcept
+  {
+  }
+
+private:
+  Serial* m_serial;
+  std::span<hal::byte const> m_data;
+};
+
+/**
+ * @brief Awaiter for `hal::v5::async_submit()`
+ *
+ */
+class i2c_batch_awaiter : public completion_awaiter
+{
+public:
+  using batch_result = i2c_transaction_queue::batch_result;
+
+  i2c_batch_awaiter(i2c_transaction_queue& p_queue,
+                    std::span<i2c_transaction_queue::transaction const> p_batch)
+    : m_queue(&p_queue)
+    , m_batch(p_batch)
+  {
+  }
+
+  bool await_suspend(std::coroutine_handle<> p_handle)
+  {
+    m_queue->submit(m_batch,
+                    [this](i2c_transaction_queue::on_complete_tag,
+                           batch_result p_result) {
+                      m_result = p_result;
+                      complete();
+                    });
+    return suspend(p_handle);
+  }
+
+  [[nodiscard]] batch_result await_resume() const noexcept
+  {
+    return m_result;
+  }
+
+private:
+  i2c_transaction_queue* m_queue;
+  std::span<i2c_transaction_queue::transaction const> m_batch;
+  batch_result m_result{};
+};
+}  // namespace detail
+
+/**
+ * @brief Write data over serial from a coroutine without blocking
+ *
+ * Starts `hal::serial::write_async()` and suspends the awaiting coroutine
+ * until the last byte has been handed to the hardware, so a single core can
+ * run other coroutines while the DMA transfer is in flight. The coroutine type
+ * is not constrained; any coroutine that can `co_await` a standard awaiter
+ * can use this.
+ *
+ * The coroutine is resumed from the serial driver's completion callback, which
+ * may run in interrupt context. Coroutines that must continue in the
+ * application context should hand themselves back to their scheduler right
+ * after `co_await` returns.
+ *
+ * Example usage:
+ *
+ * ```
+ * my_task report(hal::serial& p_serial) {
+ *   co_await hal::async_write(p_serial, message);
+ * }
+ * ```
+ *
+ * @param p_serial - serial port to write to. Must outlive the write.
+ * @param p_data - data to write. Must outlive the write.
+ * @return awaiter that completes when the write has completed
+ */
+[[nodiscard]] inline detail::serial_write_awaiter<serial> async_write(
+  serial& p_serial,
+  std::span<hal::byte const> p_data)
+{
+  return { p_serial, p_data };
+}
+
+/**
+ * @brief Write data over a zero copy serial port from a coroutine without
+ * blocking
+ *
+ * See `hal::v5::async_write(serial&, std::span<hal::byte const>)`.
+ *
+ * @param p_serial - serial port to write to. Must outlive the write.
+ * @param p_data - data to write. Must outlive the write.
+ * @return awaiter that completes when the write has completed
+ */
+[[nodiscard]] inline detail::serial_write_awaiter<zero_copy_serial>
+async_write(zero_copy_serial& p_serial, std::span<hal::byte const> p_data)
+{
+  return { p_serial, p_data };
+}
+
+/**
+ * @brief Run a batch of i2c transactions from a coroutine without blocking
+ *
+ * Submits the batch to the queue and suspends the awaiting coroutine until the
+ * batch completes or fails. See `hal::v5::async_write()` for the context the
+ * coroutine is resumed in.
+ *
+ * Example usage:
+ *
+ * ```
+ * my_task sample(hal::i2c_transaction_queue& p_queue) {
+ *   auto const result = co_await hal::async_submit(p_queue, batch);
+ * }
+ * ```
+ *
+ * @param p_queue - queue to run the batch on. Must outlive the batch.
+ * @param p_batch - transactions to run. The span and its buffers must outlive
+ * the batch.
+ * @return awaiter that completes with the batch_result of the batch
+ * @throws hal::device_or_resource_busy - when awaited, if a batch is already in
+ * flight
+ */
+[[nodiscard]] inline detail::i2c_batch_awaiter async_submit(
+  i2c_transaction_queue& p_queue,
+  std::span<i2c_transaction_queue::transaction const> p_batch)
+{
+  return { p_queue, p_batch };
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::async_submit;
+using v5::async_write;
+}  // namespace hal
@@ -0,0 +1,168 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bit>
+#include <memory_resource>
+#include <new>
+#include <span>
+
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Usage report for a boot_arena
+ *
+ */
+struct boot_arena_usage
+{
+  /// Size of the region backing the arena in bytes
+  usize capacity = 0;
+  /// Bytes handed out, including padding inserted for alignment
+  usize used = 0;
+  /// Bytes lost to padding for alignment
+  usize padding = 0;
+  /// Bytes passed to deallocate, which are never reused
+  usize deallocated = 0;
+  /// Number of successful allocations
+  usize allocations = 0;
+  /// Number of allocations that failed because the arena was exhausted
+  usize failures = 0;
+
+  /**
+   * @brief Bytes still available for allocation, ignoring alignment
+   *
+   * @return usize - bytes remaining in the region
+   */
+  [[nodiscard]] constexpr usize remaining() const
+  {
+    return capacity - used;
+  }
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(boot_arena_usage const&) const = default;
+};
+
+/**
+ * @brief Monotonic memory resource for constructing drivers at boot
+ *
+ * Allocates by bumping a cursor through a caller provided region, typically a
+ * section reserved by the linker script, so every driver constructed at boot
+ * through `hal::make_strong_ptr`, `hal::allocated_buffer` or
+ * `hal::circular_buffer` is packed contiguously in the order it was created.
+ * Each allocation costs an alignment and a compare. Deallocation is a no-op;
+ * memory is only reclaimed all at once with `release()`.
+ *
+ * Unlike `std::pmr::monotonic_buffer_resource`, the arena never falls back to
+ * an upstream resource, so running out of the region fails loudly and
+ * `usage()` reports exactly how much of the region the board needs.
+ *
+ * This resource is not thread safe.
+ *
+ * Example usage:
+ *
+ * ```
+ * extern "C" hal::byte __boot_arena_start[];
+ * extern "C" hal::byte __boot_arena_end[];
+ *
+ * hal::boot_arena arena({ __boot_arena_start, __boot_arena_end });
+ * auto i2c = hal::make_strong_ptr<my_i2c>(&arena, ...);
+ * ```
+ */
+class boot_arena : public std::pmr::memory_resource
+{
+public:
+  /**
+   * @brief Construct an arena over a region of memory
+   *
+   * @param p_region - memory to allocate from. Must outlive this object and
+   * every object allocated from it.
+   */
+  explicit boot_arena(std::span<hal::byte> p_region)
+    : m_region(p_region)
+  {
+    m_usage.capacity = p_region.size();
+  }
+
+  boot_arena(boot_arena const&) = delete;
+  boot_arena& operator=(boot_arena const&) = delete;
+  boot_arena(boot_arena&&) = delete;
+  boot_arena& operator=(boot_arena&&) = delete;
+  ~boot_arena() override = default;
+
+  /**
+   * @brief Get the usage report of the arena
+   *
+   * @return boot_arena_usage - current usage of the arena
+   */
+  [[nodiscard]] boot_arena_usage usage() const
+  {
+    return m_usage;
+  }
+
+  /**
+   * @brief Reclaim every allocation at once
+   *
+   * Every object allocated from the arena must have been destroyed, or must
+   * never be used again, before calling this.
+   */
+  void release()
+  {
+    m_usage = { .capacity = m_region.size() };
+  }
+
+private:
+  void* do_allocate(usize p_bytes, usize p_alignment) override
+  {
+    auto const base = std::bit_cast<uptr>(m_region.data());
+    auto const cursor = base + m_usage.used;
+    auto const aligned = (cursor + p_alignment - 1) & ~(p_alignment - 1);
+    auto const padding = aligned - cursor;
+
+    if (padding > m_usage.remaining() ||
+        p_bytes > m_usage.remaining() - padding) {
+      m_usage.failures++;
+      throw std::bad_alloc();
+    }
+
+    m_usage.used += padding + p_bytes;
+    m_usage.padding += padding;
+    m_usage.allocations++;
+    return m_region.data() + (aligned - base);
+  }
+
+  void do_deallocate(void*, usize p_bytes, usize) override
+  {
+    m_usage.deallocated += p_bytes;
+  }
+
+  [[nodiscard]] bool do_is_equal(
+    std::pmr::memory_resource const& p_other) const noexcept override
+  {
+    return this == &p_other;
+  }
+
+  std::span<hal::byte> m_region;
+  boot_arena_usage m_usage{};
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::boot_arena;
+using v5::boot_arena_usage;
+}  // namespace hal
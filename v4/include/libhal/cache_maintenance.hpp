@@ -0,0 +1,241 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+
+#include "error.hpp"
+#include "scatter_span.hpp"
+#include "units.hpp"
+
+/**
+ * @file cache_maintenance.hpp
+ * @brief Data cache maintenance for DMA buffers
+ *
+ * On cores with a data cache, such as the Cortex-M7 and Cortex-A, memory
+ * written by DMA is not seen by the CPU until the cache lines holding it are
+ * invalidated, and memory written by the CPU is not seen by DMA until those
+ * lines are cleaned. Maintaining a whole receive buffer after every transfer
+ * wastes most of the time saved by keeping it cached, so the helpers in this
+ * file only maintain the lines covering the bytes that were actually
+ * transferred.
+ *
+ * Invalidating a line discards anything the CPU wrote to it, so a receive
+ * buffer must not share a cache line with other data. `cache_aligned_buffer`
+ * guarantees that by aligning its storage to a cache line and padding it to a
+ * whole number of lines.
+ */
+
+namespace hal::v5 {
+/**
+ * @brief Hardware abstract interface for data cache maintenance
+ *
+ * Implemented by processor support libraries, usually with the
+ * clean/invalidate by address operations of the core. Ranges may start and end
+ * anywhere: implementations operate on every cache line that overlaps the
+ * range. Cores without a data cache can use `hal::no_cache_maintenance`.
+ */
+class cache_maintenance
+{
+public:
+  /**
+   * @brief Get the size of a data cache line
+   *
+   * @return usize - size in bytes, a power of two
+   */
+  [[nodiscard]] usize line_size()
+  {
+    return driver_line_size();
+  }
+
+  /**
+   * @brief Write dirty cache lines covering a range back to memory
+   *
+   * Call before DMA reads memory written by the CPU.
+   *
+   * @param p_range - memory to write back
+   */
+  void clean(std::span<hal::byte const> p_range)
+  {
+    driver_clean(p_range);
+  }
+
+  /**
+   * @brief Discard the cache lines covering a range
+   *
+   * Call after DMA has written memory and before the CPU reads it. Any data
+   * the CPU wrote to those lines that was not cleaned is lost.
+   *
+   * @param p_range - memory written by DMA
+   */
+  void invalidate(std::span<hal::byte const> p_range)
+  {
+    driver_invalidate(p_range);
+  }
+
+  virtual ~cache_maintenance() = default;
+
+private:
+  virtual usize driver_line_size() = 0;
+  virtual void driver_clean(std::span<hal::byte const> p_range) = 0;
+  virtual void driver_invalidate(std::span<hal::byte const> p_range) = 0;
+};
+
+/**
+ * @brief Cache maintenance for cores without a data cache, which does nothing
+ *
+ */
+class no_cache_maintenance final : public cache_maintenance
+{
+private:
+  usize driver_line_size() override
+  {
+    return 1;
+  }
+
+  void driver_clean(std::span<hal::byte const>) override
+  {
+  }
+
+  void driver_invalidate(std::span<hal::byte const>) override
+  {
+  }
+};
+
+/**
+ * @brief Default alignment of DMA buffers
+ *
+ * The data cache line size of Cortex-M7 cores. Aligning DMA buffers to a cache
+ * line keeps cache maintenance of one buffer from affecting its neighbours.
+ */
+inline constexpr usize dma_alignment = 32;
+
+/**
+ * @brief Storage for DMA that never shares a cache line with other data
+ *
+ * The storage is aligned to LineSize and its size is rounded up to a multiple
+ * of LineSize, so maintaining any part of it, rounded out to whole lines, only
+ * affects the buffer itself. Use it for the receive buffers of
+ * `hal::zero_copy_serial`, `hal::can_transceiver` and other drivers filled by
+ * DMA.
+ *
+ * @tparam T - type of the elements, such as `hal::byte` or `hal::can_message`
+ * @tparam Count - minimum number of elements the buffer holds
+ * @tparam LineSize - cache line size to align and pad to, at least the line
+ * size of the target's data cache
+ */
+template<typename T, usize Count, usize LineSize = dma_alignment>
+struct cache_aligned_buffer
+{
+  static_assert(std::has_single_bit(LineSize),
+                "Cache line size must be a power of two");
+
+  /// Number of elements, Count rounded up to fill whole cache lines
+  static constexpr usize size = [] {
+    auto const step = LineSize / std::gcd(sizeof(T), LineSize);
+    return (Count + step - 1) / step * step;
+  }();
+
+  /// Storage of the buffer
+  alignas(LineSize) std::array<T, size> storage{};
+};
+
+/**
+ * @brief Invalidate the cache lines holding newly received data
+ *
+ * Call with the segments returned by `hal::zero_copy_serial_reader::read()`,
+ * or any other ranges of a receive buffer written by DMA, before reading them.
+ * Only the cache lines overlapping those segments are invalidated, not the
+ * whole buffer. Lines are invalidated whole, which is safe because the receive
+ * buffer must be aligned and padded to cache lines, as `cache_aligned_buffer`
+ * is. A line that was only partly received is invalidated again by the next
+ * call, along with the rest of its data.
+ *
+ * Example usage:
+ *
+ * ```
+ * auto const received = reader.read();
+ * hal::invalidate_received(cache, uart.receive_buffer(), received);
+ * for (auto const segment : received) { parser.feed(segment); }
+ * ```
+ *
+ * @tparam T - type of the elements of the receive buffer
+ * @param p_cache - cache to maintain
+ * @param p_buffer - the whole receive buffer
+ * @param p_received - segments of p_buffer written by DMA
+ * @throws hal::argument_out_of_domain - if p_buffer is not aligned and padded
+ * to the cache's line size, or a segment lies outside of p_buffer
+ */
+template<typename T>
+void invalidate_received(cache_maintenance& p_cache,
+                         std::span<T const> p_buffer,
+                         scatter_span<T const> p_received)
+{
+  auto const buffer = std::span(
+    reinterpret_cast<hal::byte const*>(p_buffer.data()), p_buffer.size_bytes());
+  auto const line_size = p_cache.line_size();
+  auto const address = reinterpret_cast<std::uintptr_t>(buffer.data());
+  if (address % line_size != 0 || buffer.size() % line_size != 0) {
+    hal::safe_throw(hal::argument_out_of_domain(&p_cache));
+  }
+
+  for (auto const& segment : p_received) {
+    if (segment.empty()) {
+      continue;
+    }
+    if (segment.data() < p_buffer.data() ||
+        segment.data() + segment.size() > p_buffer.data() + p_buffer.size()) {
+      hal::safe_throw(hal::argument_out_of_domain(&p_cache));
+    }
+    auto const offset = static_cast<usize>(segment.data() - p_buffer.data());
+    auto const first = offset * sizeof(T) / line_size * line_size;
+    auto const last = ((offset + segment.size()) * sizeof(T) + line_size - 1) /
+                      line_size * line_size;
+    p_cache.invalidate(buffer.subspan(first, last - first));
+  }
+}
+
+/**
+ * @brief Clean the cache lines holding data about to be transmitted by DMA
+ *
+ * Cleaning only writes lines back to memory, so the data does not need to be
+ * in a cache aligned buffer.
+ *
+ * @param p_cache - cache to maintain
+ * @param p_data - segments about to be read by DMA
+ */
+inline void clean_for_transmit(cache_maintenance& p_cache,
+                               scatter_span<hal::byte const> p_data)
+{
+  for (auto const& segment : p_data) {
+    if (not segment.empty()) {
+      p_cache.clean(segment);
+    }
+  }
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::cache_aligned_buffer;
+using v5::cache_maintenance;
+using v5::clean_for_transmit;
+using v5::dma_alignment;
+using v5::invalidate_received;
+using v5::no_cache_maintenance;
+}  // namespace hal
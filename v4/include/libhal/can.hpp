@@ -15,9 +15,14 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <span>
+#include <type_traits>
 
+#include "error.hpp"
 #include "functional.hpp"
 #include "units.hpp"
 
@@ -276,6 +281,39 @@ struct can_message
    */
   std::array<hal::byte, 8> payload{};
 
+  /**
+   * @brief Get the message as two words with unused bytes cleared
+   *
+   * The first word holds the ID, flags and length and the second holds the
+   * payload. Payload bytes beyond `length` and the reserved byte are set to 0,
+   * so two messages are equal exactly when their keys are equal. This makes
+   * the key suitable for hashing, for use in lookup tables and for fast change
+   * detection.
+   *
+   * @return std::array<u64, 2> - canonical representation of the message
+   */
+  [[nodiscard]] constexpr std::array<u64, 2> packed_key() const
+  {
+    // Bytes of each word in memory order, independent of endianness
+    constexpr auto byte_mask = [](usize p_byte_count) -> u64 {
+      if (p_byte_count >= sizeof(u64)) {
+        return ~u64{ 0 };
+      }
+      if constexpr (std::endian::native == std::endian::little) {
+        return (u64{ 1 } << (p_byte_count * 8U)) - 1U;
+      } else {
+        return ~(~u64{ 0 } >> (p_byte_count * 8U));
+      }
+    };
+    // Every byte of the header word except reserved0
+    constexpr auto header_mask = byte_mask(offsetof(can_message, reserved0));
+
+    auto words = std::bit_cast<std::array<u64, 2>>(*this);
+    words[0] &= header_mask;
+    words[1] &= byte_mask(length);
+    return words;
+  }
+
   /**
    * @brief Compares a can message to itself to verify if they are the same
    *
@@ -284,36 +322,49 @@ struct can_message
    * between messages do not match, then the can messages are still considered
    * equal.
    *
+   * The comparison is performed on the two words returned by `packed_key()`
+   * rather than field by field.
+   *
    * @param p_other - the other can_message to compare against
    * @return true - the two can messages are identical
    * @return false - the two can messages are not identical
    */
   constexpr bool operator==(can_message const& p_other) const
   {
-    if (length != p_other.length) {
-      return false;
-    }
-    if (id != p_other.id) {
-      return false;
-    }
-    if (remote_request != p_other.remote_request) {
-      return false;
-    }
-    if (extended != p_other.extended) {
-      return false;
-    }
-    for (std::size_t i = 0; i < length; i++) {
-      if (payload[i] != p_other.payload[i]) {
-        return false;
-      }
-    }
-
-    return true;
+    return packed_key() == p_other.packed_key();
   }
 };
 
 constexpr auto can_message_size = sizeof(can_message);
 static_assert(can_message_size == 16, "sizeof(hal::can_message) != 16 Bytes");
+static_assert(std::is_trivially_copyable_v<can_message> &&
+                std::is_standard_layout_v<can_message>,
+              "hal::can_message must be a trivially copyable standard layout");
+static_assert(offsetof(can_message, payload) == sizeof(u64),
+              "hal::can_message payload must occupy the second 8 bytes");
+
+/**
+ * @brief Hash function object for can_message
+ *
+ * Consistent with `can_message::operator==`, payload bytes beyond the length
+ * do not affect the hash. Allows can_message to be used as a key in unordered
+ * containers.
+ */
+struct can_message_hash
+{
+  [[nodiscard]] constexpr usize operator()(
+    can_message const& p_message) const noexcept
+  {
+    // Multiply-xorshift mix of both words, constants from splitmix64
+    auto const key = p_message.packed_key();
+    u64 hash = key[0] * 0x9E37'79B9'7F4A'7C15U;
+    hash ^= key[1] + 0xBF58'476D'1CE4'E5B9U + (hash << 6U) + (hash >> 2U);
+    hash ^= hash >> 31U;
+    hash *= 0x94D0'49BB'1331'11EBU;
+    hash ^= hash >> 29U;
+    return static_cast<usize>(hash);
+  }
+};
 
 /**
  * @brief Controller Area Network (CAN bus) hardware abstraction interface with
@@ -369,6 +420,38 @@ public:
     driver_send(p_message);
   }
 
+  /**
+   * @brief Send a batch of can messages over the can network
+   *
+   * Messages are sent in order. Drivers may fill every available hardware
+   * mailbox or transmit FIFO slot in a single operation rather than handling
+   * each message individually. If the hardware cannot accept every message
+   * right away, the driver returns the number of messages it accepted and the
+   * caller is expected to call this again with the remaining messages.
+   *
+   * The default implementation calls `send()` for each message, blocking as
+   * `send()` does, and always returns `p_messages.size()`.
+   *
+   * ```C++
+   * std::span<hal::can_message const> remaining = messages;
+   * while (not remaining.empty()) {
+   *   remaining = remaining.subspan(can.send(remaining));
+   * }
+   * ```
+   *
+   * @param p_messages - messages to be sent over the can network
+   * @return usize - number of messages, from the start of p_messages, that
+   *         were queued for transmission. Drivers must queue at least one
+   *         message if p_messages is not empty, blocking until they can.
+   * @throws hal::operation_not_permitted - or a derivative of this class, if
+   *         the can device has entered the "bus-off" state. Messages before the
+   *         one that failed may have been transmitted.
+   */
+  usize send(std::span<can_message const> p_messages)
+  {
+    return driver_send_batch(p_messages);
+  }
+
   /**
    * @brief Returns this CAN driver's message receive buffer
    *
@@ -437,6 +520,13 @@ private:
   virtual void driver_send(can_message const& p_message) = 0;
   virtual std::span<can_message const> driver_receive_buffer() = 0;
   virtual std::size_t driver_receive_cursor() = 0;
+  virtual usize driver_send_batch(std::span<can_message const> p_messages)
+  {
+    for (auto const& message : p_messages) {
+      driver_send(message);
+    }
+    return p_messages.size();
+  }
 };
 
 /**
@@ -489,10 +579,114 @@ public:
     driver_on_receive(p_callback);
   }
 
+  /**
+   * @brief Set a callback larger than `hal::callback` to occur when a new
+   * message has been received
+   *
+   * Drivers store a `hal::callback`, so this registers a callback that
+   * forwards to p_callback by reference. The callable stays inline in
+   * p_callback, without heap allocation. Pass std::nullopt to
+   * `on_receive(optional_receive_handler)` to disable the callback.
+   *
+   * @tparam Capacity - storage capacity of p_callback in bytes, such as that
+   * of a `hal::callback_n`
+   * @param p_callback - callback to be called on message reception. Must
+   * outlive its registration.
+   */
+  template<size_t Capacity>
+    requires(Capacity > sizeof(void*) * hal::callback_words)
+  void on_receive(hal::inplace_function<receive_handler, Capacity>& p_callback)
+  {
+    driver_on_receive(hal::callback<receive_handler>(
+      [&p_callback](on_receive_tag p_tag, can_message const& p_message) {
+        p_callback(p_tag, p_message);
+      }));
+  }
+
+  /// Bytes each driver reserves to store the receive callback
+  static constexpr size_t callback_storage =
+    sizeof(hal::callback<receive_handler>);
+
+  /**
+   * @brief Batch receive handler signature
+   *
+   * The span holds the received messages in order of reception and is only
+   * valid for the duration of the call.
+   */
+  using batch_receive_handler = void(std::span<can_message const>);
+
+  /**
+   * @brief Optional batch receive handler
+   *
+   * Either contains a batch receive handler OR is std::nullopt which means
+   * "disable" batched message reception.
+   *
+   */
+  using optional_batch_receive_handler =
+    std::optional<hal::callback<batch_receive_handler>>;
+
+  /**
+   * @brief Conditions under which a batch of received messages is delivered
+   *
+   * A batch is delivered as soon as any enabled condition is met. Each
+   * delivery is one callback from interrupt context, so larger batches trade
+   * the latency of the first message in the batch for fewer callbacks per
+   * message during bus bursts. `max_frames = 1` behaves like `on_receive()`.
+   */
+  struct batch_settings
+  {
+    /// Deliver once this many messages are pending. Drivers clamp this to the
+    /// number of messages they can hold.
+    u16 max_frames = 8;
+    /// Deliver once the oldest pending message has waited this long. Drivers
+    /// without a timer check this when messages arrive, so a quiet bus can
+    /// hold messages longer unless `deliver_on_drain` is set.
+    hal::time_duration max_latency = std::chrono::milliseconds(1);
+    /// Deliver whenever the hardware receive FIFO has been emptied. Keeps the
+    /// latency of a lone message to a single interrupt, while messages that
+    /// arrive back to back are still delivered together. Disable to only
+    /// deliver on the thresholds above, for the fewest callbacks.
+    bool deliver_on_drain = true;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    constexpr bool operator==(batch_settings const&) const = default;
+  };
+
+  /**
+   * @brief Set a callback to occur when a batch of messages has been received
+   *
+   * Instead of one callback per message, the driver gathers received messages
+   * and passes them to p_callback together, as described by p_settings. This
+   * amortizes the cost of the callback over the batch when the bus is busy.
+   *
+   * Support for this is optional. Drivers that do not support it throw, in
+   * which case `on_receive()` remains available. Setting a batch handler
+   * replaces the handler set with `on_receive()` and vice versa.
+   *
+   * @param p_callback - callback to be called with each batch of received
+   * messages. Set to std::nullopt to disable the callback.
+   * @param p_settings - when to deliver a batch
+   * @throws hal::operation_not_supported - if the driver cannot deliver
+   * messages in batches
+   */
+  void on_receive_batch(optional_batch_receive_handler p_callback,
+                        batch_settings const& p_settings)
+  {
+    driver_on_receive_batch(p_callback, p_settings);
+  }
+
   virtual ~can_interrupt() = default;
 
 private:
   virtual void driver_on_receive(optional_receive_handler p_callback) = 0;
+  virtual void driver_on_receive_batch(optional_batch_receive_handler,
+                                       batch_settings const&)
+  {
+    hal::safe_throw(hal::operation_not_supported(this));
+  }
 };
 
 /**
@@ -635,6 +829,105 @@ private:
   virtual void driver_bus_on() = 0;
 };
 
+/**
+ * @brief CAN Bus load and health statistics hardware abstraction interface
+ *
+ * Reports how busy and healthy a CAN bus is from the point of view of this
+ * node. Used to determine how close the bus is to saturation and to find the
+ * source of latency spikes in the field.
+ *
+ * Implementations of this interface are sharable across multiple applications
+ * and device drivers, although `reset()` affects every user.
+ */
+class can_bus_statistics
+{
+public:
+  /**
+   * @brief Snapshot of the bus statistics
+   *
+   * Counters accumulate from construction of the driver or the last call to
+   * `reset()`. Counters saturate at their maximum value rather than wrapping.
+   */
+  struct statistics
+  {
+    /// Number of frames successfully transmitted
+    u64 frames_sent = 0;
+    /// Number of frames received, after hardware filtering
+    u64 frames_received = 0;
+    /// Current value of the controller's transmit error counter (TEC)
+    u16 transmit_error_counter = 0;
+    /// Current value of the controller's receive error counter (REC)
+    u16 receive_error_counter = 0;
+    /// Number of bus errors (bit, stuff, form, CRC or ACK errors) detected
+    u32 bus_errors = 0;
+    /// Number of times a transmission lost arbitration to another node
+    u32 arbitration_lost = 0;
+    /// Number of frames dropped because the hardware receive FIFO was full
+    /// before the driver could move them into the receive buffer
+    u32 receive_overruns = 0;
+    /// Number of transmit mailboxes or FIFO slots currently occupied
+    u8 transmit_mailboxes_used = 0;
+    /// Highest number of transmit mailboxes or FIFO slots occupied at once
+    u8 transmit_mailboxes_high_water = 0;
+    /// Total number of transmit mailboxes or FIFO slots
+    u8 transmit_mailboxes = 0;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    constexpr bool operator==(statistics const&) const = default;
+  };
+
+  /**
+   * @brief Get a snapshot of the bus statistics
+   *
+   * @return statistics - current bus statistics
+   */
+  [[nodiscard]] statistics read()
+  {
+    return driver_read();
+  }
+
+  /**
+   * @brief Reset the accumulating counters and the high water mark
+   *
+   * The error counters and mailbox usage reflect the current state of the
+   * controller and are not affected.
+   */
+  void reset()
+  {
+    driver_reset();
+  }
+
+  /**
+   * @brief Get the receive timestamps for the receive buffer
+   *
+   * When supported, each element of the returned span holds the uptime, in
+   * ticks of the `hal::steady_clock` given to the driver, at which the message
+   * at the same index of `hal::can_transceiver::receive_buffer()` was
+   * received. Use this to measure the latency between a frame arriving and it
+   * being processed.
+   *
+   * @return std::span<u64 const> - receive timestamps with the same size as the
+   * receive buffer, or an empty span if the driver does not record them.
+   */
+  [[nodiscard]] std::span<u64 const> receive_timestamps()
+  {
+    return driver_receive_timestamps();
+  }
+
+  virtual ~can_bus_statistics() = default;
+
+private:
+  virtual statistics driver_read() = 0;
+  virtual void driver_reset() = 0;
+  virtual std::span<u64 const> driver_receive_timestamps()
+  {
+    return {};
+  }
+};
+
 /**
  * @brief CAN message ID filter hardware abstraction interface
  *
@@ -955,14 +1248,20 @@ private:
 // v5 namespace added for API backwards compatibility
 namespace hal::v5 {
 using hal::can_bus_manager;
+using hal::can_bus_statistics;
 using hal::can_extended_identifier_filter;
 using hal::can_extended_mask_filter;
 using hal::can_extended_range_filter;
 using hal::can_identifier_filter;
 using hal::can_mask_filter;
 using hal::can_message;
+using hal::can_message_hash;
 using can_message_interrupt = hal::can_interrupt;
 using hal::can_message_size;
 using hal::can_range_filter;
 using hal::can_transceiver;
 }  // namespace hal::v5
+
+template<>
+struct std::hash<hal::can_message> : hal::can_message_hash
+{};
@@ -0,0 +1,473 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <span>
+
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Maximum number of payload bytes in a CAN FD frame
+ */
+inline constexpr usize can_fd_max_length = 64;
+
+/**
+ * @brief A CAN FD message
+ *
+ * Can represent both CAN FD frames and classic CAN frames, distinguished by
+ * `fd_format`. This type is used to send messages and as a decoded copy of a
+ * received message. Received messages are stored in the receive buffer in the
+ * compact `can_fd_slot` layout instead, see `hal::can_fd_transceiver`.
+ */
+struct can_fd_message
+{
+  /**
+   * @brief Memory containing a standard or extended CAN ID
+   *
+   * Bits 29 to 31 are reserved and should only be set to 0s.
+   */
+  u32 id = 0;
+
+  /**
+   * @brief Determines if this message ID is an extended ID or not
+   *
+   * When set to `true`, will treat all 29 bits of the ID of the message.
+   * When set to `false`, then this is a standard can message and only the first
+   * 11 bits will be used for the message ID.
+   */
+  bool extended = false;
+
+  /**
+   * @brief Determines if this message is a remote request
+   *
+   * Only classic CAN frames can be remote requests. This field must be `false`
+   * when `fd_format` is `true`.
+   */
+  bool remote_request = false;
+
+  /**
+   * @brief Determines if this is a CAN FD frame or a classic CAN frame
+   *
+   * Classic CAN frames carry at most 8 bytes and are always sent at the
+   * nominal baud rate.
+   */
+  bool fd_format = true;
+
+  /**
+   * @brief Send the data phase of a CAN FD frame at the data baud rate
+   *
+   * Ignored for classic CAN frames.
+   */
+  bool bit_rate_switch = true;
+
+  /**
+   * @brief Set by the sender when it is in the error passive state
+   *
+   * Only meaningful for received CAN FD frames. Drivers ignore this field when
+   * sending.
+   */
+  bool error_state_indicator = false;
+
+  /**
+   * @brief The number of valid elements in the payload
+   *
+   * CAN FD frames can only carry 0 to 8, 12, 16, 20, 24, 32, 48 or 64 bytes.
+   * Drivers pad the payload with zeros up to the next valid length. Classic
+   * CAN frames carry between 0 and 8 bytes.
+   */
+  u8 length = 0;
+
+  /**
+   * @brief Message data contents
+   */
+  std::array<hal::byte, can_fd_max_length> payload{};
+
+  /**
+   * @brief Compares two CAN FD messages
+   *
+   * NOTE: This comparison only checks the valid payload bytes in the payload
+   * based on the length.
+   *
+   * @param p_other - the other can_fd_message to compare against
+   * @return true - the two messages are identical
+   * @return false - the two messages are not identical
+   */
+  constexpr bool operator==(can_fd_message const& p_other) const
+  {
+    if (length != p_other.length || id != p_other.id ||
+        extended != p_other.extended ||
+        remote_request != p_other.remote_request ||
+        fd_format != p_other.fd_format ||
+        bit_rate_switch != p_other.bit_rate_switch ||
+        error_state_indicator != p_other.error_state_indicator) {
+      return false;
+    }
+    auto const valid = std::min<usize>(length, can_fd_max_length);
+    return std::equal(payload.begin(),
+                      payload.begin() + valid,
+                      p_other.payload.begin());
+  }
+};
+
+/**
+ * @brief Header of a message stored in a CAN FD receive buffer
+ *
+ * CAN FD receive buffers do not hold an array of `can_fd_message`, which would
+ * spend 64 bytes of payload on every frame. Instead each message occupies a
+ * slot made of this 8 byte header followed by `length` payload bytes, padded
+ * with zeros to a multiple of `can_fd_slot_alignment`. A classic 8 byte frame
+ * takes 16 bytes and a full 64 byte CAN FD frame takes 72 bytes.
+ *
+ * Slots never wrap around the end of the receive buffer. When the next slot
+ * does not fit before the end, the driver writes a header with the `padding`
+ * flag set at the current position and continues at the start of the buffer.
+ *
+ * Use `hal::can_fd_reader` to iterate over received slots and
+ * `hal::write_can_fd_slot` in drivers to store them.
+ */
+struct can_fd_slot_header
+{
+  /// Flag bit set if the message ID is an extended ID
+  static constexpr u8 extended_flag = 1U << 0U;
+  /// Flag bit set if the message is a remote request
+  static constexpr u8 remote_request_flag = 1U << 1U;
+  /// Flag bit set if the message is a CAN FD frame
+  static constexpr u8 fd_format_flag = 1U << 2U;
+  /// Flag bit set if the data phase was sent at the data baud rate
+  static constexpr u8 bit_rate_switch_flag = 1U << 3U;
+  /// Flag bit set if the sender was error passive
+  static constexpr u8 error_state_indicator_flag = 1U << 4U;
+  /// Flag bit set if this slot marks the unused end of the buffer
+  static constexpr u8 padding_flag = 1U << 7U;
+
+  /// Standard or extended CAN ID
+  u32 id = 0;
+  /// Combination of the flag bits above
+  u8 flags = 0;
+  /// Number of payload bytes following the header
+  u8 length = 0;
+  /// Reserved, always 0
+  u16 reserved0 = 0;
+};
+
+static_assert(sizeof(can_fd_slot_header) == 8,
+              "sizeof(hal::can_fd_slot_header) != 8 Bytes");
+
+/**
+ * @brief Alignment and size granularity of slots in a CAN FD receive buffer
+ *
+ * Receive buffers must be a multiple of this size in length.
+ */
+inline constexpr usize can_fd_slot_alignment = sizeof(can_fd_slot_header);
+
+/**
+ * @brief Number of bytes a message occupies in a CAN FD receive buffer
+ *
+ * @param p_length - number of payload bytes in the message
+ * @return constexpr usize - size of the header plus the padded payload
+ */
+[[nodiscard]] constexpr usize can_fd_slot_size(usize p_length)
+{
+  auto const length = std::min(p_length, can_fd_max_length);
+  auto const padded = (length + can_fd_slot_alignment - 1) &
+                      ~(can_fd_slot_alignment - 1);
+  return sizeof(can_fd_slot_header) + padded;
+}
+
+/**
+ * @brief A message stored in a CAN FD receive buffer
+ *
+ * The payload points directly into the receive buffer and is only valid until
+ * the driver overwrites the slot.
+ */
+struct can_fd_slot
+{
+  can_fd_slot_header header{};
+  std::span<hal::byte const> payload{};
+
+  /**
+   * @brief Copy this slot into a can_fd_message
+   *
+   * @return can_fd_message - decoded copy of the message in this slot
+   */
+  [[nodiscard]] can_fd_message message() const
+  {
+    constexpr auto has = [](u8 p_flags, u8 p_flag) {
+      return (p_flags & p_flag) != 0;
+    };
+    can_fd_message result{
+      .id = header.id,
+      .extended = has(header.flags, can_fd_slot_header::extended_flag),
+      .remote_request =
+        has(header.flags, can_fd_slot_header::remote_request_flag),
+      .fd_format = has(header.flags, can_fd_slot_header::fd_format_flag),
+      .bit_rate_switch =
+        has(header.flags, can_fd_slot_header::bit_rate_switch_flag),
+      .error_state_indicator =
+        has(header.flags, can_fd_slot_header::error_state_indicator_flag),
+      .length = static_cast<u8>(payload.size()),
+    };
+    std::ranges::copy(payload, result.payload.begin());
+    return result;
+  }
+};
+
+/**
+ * @brief Store a message in a CAN FD receive buffer
+ *
+ * Intended for use by drivers implementing `hal::can_fd_transceiver` within
+ * their receive interrupt. Writes a padding slot and wraps to the start of the
+ * buffer if the message does not fit before the end.
+ *
+ * @param p_buffer - receive buffer. Must be a multiple of
+ * `can_fd_slot_alignment` in length and hold at least one maximum size slot.
+ * @param p_cursor - position to write the slot at, the current receive cursor
+ * @param p_message - message to store. Payloads longer than
+ * `can_fd_max_length` are truncated.
+ * @return usize - the new receive cursor, the position after the slot
+ */
+inline usize write_can_fd_slot(std::span<hal::byte> p_buffer,
+                               usize p_cursor,
+                               can_fd_message const& p_message)
+{
+  auto const length = std::min<usize>(p_message.length, can_fd_max_length);
+  auto const size = can_fd_slot_size(length);
+
+  if (p_cursor + size > p_buffer.size()) {
+    can_fd_slot_header const padding{
+      .flags = can_fd_slot_header::padding_flag,
+    };
+    std::memcpy(&p_buffer[p_cursor], &padding, sizeof(padding));
+    p_cursor = 0;
+  }
+
+  u8 flags = 0;
+  if (p_message.extended) {
+    flags |= can_fd_slot_header::extended_flag;
+  }
+  if (p_message.remote_request) {
+    flags |= can_fd_slot_header::remote_request_flag;
+  }
+  if (p_message.fd_format) {
+    flags |= can_fd_slot_header::fd_format_flag;
+  }
+  if (p_message.bit_rate_switch) {
+    flags |= can_fd_slot_header::bit_rate_switch_flag;
+  }
+  if (p_message.error_state_indicator) {
+    flags |= can_fd_slot_header::error_state_indicator_flag;
+  }
+
+  can_fd_slot_header const header{
+    .id = p_message.id,
+    .flags = flags,
+    .length = static_cast<u8>(length),
+  };
+
+  auto const slot = p_buffer.subspan(p_cursor, size);
+  std::memcpy(slot.data(), &header, sizeof(header));
+  auto const payload = slot.subspan(sizeof(header));
+  auto const end =
+    std::copy_n(p_message.payload.begin(), length, payload.begin());
+  std::fill(end, payload.end(), hal::byte{ 0 });
+
+  auto const next = p_cursor + size;
+  return next == p_buffer.size() ? 0 : next;
+}
+
+/**
+ * @brief CAN FD hardware abstraction interface with message buffering
+ *
+ * The CAN FD counterpart of `hal::can_transceiver`. Received messages are
+ * stored in a circular byte buffer as variable length `can_fd_slot`s, so a
+ * buffer holds far more small frames than an array of 64 byte messages would.
+ * See `hal::can_fd_slot_header` for the layout.
+ *
+ * All implementations MUST allow the user to supply their own receive buffer
+ * of arbitrary size, as long as it is a multiple of `can_fd_slot_alignment`
+ * and can hold at least one maximum size slot.
+ */
+class can_fd_transceiver
+{
+public:
+  /**
+   * @return u32 - the nominal (arbitration phase) baud rate in hertz
+   */
+  u32 baud_rate()
+  {
+    return driver_baud_rate();
+  }
+
+  /**
+   * @return u32 - the data phase baud rate in hertz, used for the payload of
+   * CAN FD frames with `bit_rate_switch` set.
+   */
+  u32 data_baud_rate()
+  {
+    return driver_data_baud_rate();
+  }
+
+  /**
+   * @brief Send a message over the can network
+   *
+   * @param p_message - a message to be sent over the can network
+   * @throws hal::operation_not_permitted - or a derivative of this class, if
+   *         the can device has entered the "bus-off" state.
+   * @throws hal::argument_out_of_domain - if the length is not a valid length
+   *         for the frame format.
+   */
+  void send(can_fd_message const& p_message)
+  {
+    driver_send(p_message);
+  }
+
+  /**
+   * @brief Returns this driver's message receive buffer
+   *
+   * The buffer holds a sequence of `can_fd_slot`s. Use `hal::can_fd_reader`
+   * rather than decoding it by hand.
+   *
+   * @return std::span<hal::byte const> - constant span to the receive buffer.
+   *         Assume the lifetime of the buffer is the same as the class's
+   *         lifetime.
+   */
+  std::span<hal::byte const> receive_buffer()
+  {
+    return driver_receive_buffer();
+  }
+
+  /**
+   * @brief Returns the byte position where the next slot will be written
+   *
+   * Always a multiple of `can_fd_slot_alignment` and less than
+   * `receive_buffer().size()`.
+   *
+   * @return usize - position of the write cursor for the circular buffer
+   */
+  usize receive_cursor()
+  {
+    return driver_receive_cursor();
+  }
+
+  virtual ~can_fd_transceiver() = default;
+
+private:
+  virtual u32 driver_baud_rate() = 0;
+  virtual u32 driver_data_baud_rate() = 0;
+  virtual void driver_send(can_fd_message const& p_message) = 0;
+  virtual std::span<hal::byte const> driver_receive_buffer() = 0;
+  virtual usize driver_receive_cursor() = 0;
+};
+
+/**
+ * @brief Iterates over the messages received by a can_fd_transceiver
+ *
+ * Each call to `read()` returns the next message received since the reader
+ * was constructed, without copying the payload out of the receive buffer.
+ * Like the classic receive buffer, the reader cannot detect when the driver
+ * has lapped it, so messages must be read before the buffer fills.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::can_fd_reader reader(transceiver);
+ *
+ * while (auto const slot = reader.read()) {
+ *   if (slot->header.id == 0x120) {
+ *     parse_status(slot->payload);
+ *   }
+ * }
+ * ```
+ */
+class can_fd_reader
+{
+public:
+  /**
+   * @brief Construct a reader starting at the transceiver's current cursor
+   *
+   * Messages received before construction are not returned by `read()`.
+   *
+   * @param p_transceiver - transceiver to read from. Must outlive this object.
+   */
+  explicit can_fd_reader(can_fd_transceiver& p_transceiver)
+    : m_transceiver(&p_transceiver)
+    , m_cursor(p_transceiver.receive_cursor())
+  {
+  }
+
+  /**
+   * @brief Get the next received message
+   *
+   * @return std::optional<can_fd_slot> - the oldest unread message or
+   * std::nullopt if every received message has been read.
+   */
+  [[nodiscard]] std::optional<can_fd_slot> read()
+  {
+    auto const buffer = m_transceiver->receive_buffer();
+    auto const cursor = m_transceiver->receive_cursor();
+
+    while (m_cursor != cursor) {
+      can_fd_slot_header header;
+      std::memcpy(&header, &buffer[m_cursor], sizeof(header));
+
+      if ((header.flags & can_fd_slot_header::padding_flag) != 0) {
+        m_cursor = 0;
+        continue;
+      }
+
+      auto const position = m_cursor;
+      auto const length = std::min<usize>(header.length, can_fd_max_length);
+      auto const next = m_cursor + can_fd_slot_size(length);
+      m_cursor = next == buffer.size() ? 0 : next;
+
+      return can_fd_slot{
+        .header = header,
+        .payload = buffer.subspan(position + sizeof(header), length),
+      };
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Skip over all received messages
+   */
+  void skip()
+  {
+    m_cursor = m_transceiver->receive_cursor();
+  }
+
+private:
+  can_fd_transceiver* m_transceiver;
+  usize m_cursor = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::can_fd_max_length;
+using v5::can_fd_message;
+using v5::can_fd_reader;
+using v5::can_fd_slot;
+using v5::can_fd_slot_alignment;
+using v5::can_fd_slot_header;
+using v5::can_fd_slot_size;
+using v5::can_fd_transceiver;
+using v5::write_can_fd_slot;
+}  // namespace hal
@@ -0,0 +1,323 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "can.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Outcome of configuring a set of CAN filters for a set of IDs
+ *
+ * Filter coverage is reported in number of distinct IDs. Assuming traffic is
+ * spread evenly across the accepted IDs, `false_accept_rate()` is the fraction
+ * of messages passing the hardware filters that software must reject.
+ */
+struct can_filter_plan
+{
+  /// Number of distinct IDs that were requested
+  usize requested = 0;
+  /// Number of distinct IDs accepted by the configured filters
+  u64 accepted = 0;
+  /**
+   * @brief Number of requested IDs that no filter accepts
+   *
+   * Only non-zero when no mask or range filters were provided and there are
+   * more IDs than identifier filters. The caller must decide how to receive
+   * these IDs, for example by accepting all messages.
+   */
+  usize uncovered = 0;
+
+  /**
+   * @brief Fraction of accepted IDs that were not requested
+   *
+   * @return float - value from 0.0, where only requested IDs are accepted, to
+   * almost 1.0, where nearly every accepted ID must be rejected in software.
+   */
+  [[nodiscard]] float false_accept_rate() const
+  {
+    if (accepted == 0) {
+      return 0.0f;
+    }
+    auto const covered = static_cast<u64>(requested - uncovered);
+    return static_cast<float>(accepted - covered) /
+           static_cast<float>(accepted);
+  }
+};
+
+namespace detail {
+template<typename Id>
+struct can_filter_group
+{
+  Id low;
+  Id high;
+  usize count;
+  /// Bits that are not the same across every ID in the group
+  Id varying;
+};
+
+template<typename Id,
+         Id FullMask,
+         class IdentifierFilter,
+         class MaskFilter,
+         class RangeFilter>
+can_filter_plan configure_can_filters(
+  std::pmr::polymorphic_allocator<byte> p_allocator,
+  std::span<Id const> p_ids,
+  std::span<IdentifierFilter* const> p_identifier_filters,
+  std::span<MaskFilter* const> p_mask_filters,
+  std::span<RangeFilter* const> p_range_filters)
+{
+  using group = can_filter_group<Id>;
+  constexpr u64 unavailable = std::numeric_limits<u64>::max();
+
+  auto const identifiers = p_identifier_filters.size();
+  auto const masks = p_mask_filters.size();
+  auto const ranges = p_range_filters.size();
+  auto const banks = identifiers + masks + ranges;
+
+  std::pmr::vector<Id> ids(p_ids.begin(), p_ids.end(), p_allocator);
+  for (auto& id : ids) {
+    id &= FullMask;
+  }
+  std::ranges::sort(ids);
+  auto const duplicates = std::ranges::unique(ids);
+  ids.erase(duplicates.begin(), duplicates.end());
+
+  std::pmr::vector<group> groups(p_allocator);
+  groups.reserve(ids.size());
+  for (auto const id : ids) {
+    groups.push_back({ .low = id, .high = id, .count = 1, .varying = 0 });
+  }
+
+  auto const range_cost = [ranges](group const& p_group) -> u64 {
+    if (ranges == 0) {
+      return unavailable;
+    }
+    return u64{ p_group.high } - p_group.low + 1 - p_group.count;
+  };
+  auto const mask_cost = [masks](group const& p_group) -> u64 {
+    if (masks == 0) {
+      return unavailable;
+    }
+    return (u64{ 1 } << std::popcount(p_group.varying)) - p_group.count;
+  };
+  auto const cost = [&](group const& p_group) -> u64 {
+    if (p_group.count == 1) {
+      return 0;
+    }
+    return std::min(range_cost(p_group), mask_cost(p_group));
+  };
+  auto const merge = [](group const& p_first, group const& p_second) {
+    return group{
+      .low = p_first.low,
+      .high = p_second.high,
+      .count = p_first.count + p_second.count,
+      .varying = static_cast<Id>(p_first.varying | p_second.varying |
+                                 (p_first.low ^ p_second.low)),
+    };
+  };
+
+  // Greedily merge the neighboring groups that add the fewest falsely
+  // accepted IDs until every group has a filter that can hold it.
+  while (masks + ranges > 0) {
+    auto const multi = static_cast<usize>(std::ranges::count_if(
+      groups, [](group const& p_group) { return p_group.count > 1; }));
+    if (groups.size() <= banks && multi <= masks + ranges) {
+      break;
+    }
+
+    usize best = 0;
+    auto best_delta = std::numeric_limits<i64>::max();
+    for (usize i = 0; i + 1 < groups.size(); i++) {
+      auto const merged = cost(merge(groups[i], groups[i + 1]));
+      auto const delta = static_cast<i64>(merged) -
+                         static_cast<i64>(cost(groups[i])) -
+                         static_cast<i64>(cost(groups[i + 1]));
+      if (delta < best_delta) {
+        best_delta = delta;
+        best = i;
+      }
+    }
+
+    groups[best] = merge(groups[best], groups[best + 1]);
+    groups.erase(groups.begin() + static_cast<std::ptrdiff_t>(best) + 1);
+  }
+
+  // Order multi-ID groups first, those favoring range filters leading
+  auto const preference = [&](group const& p_group) {
+    auto const by_range = range_cost(p_group);
+    auto const by_mask = mask_cost(p_group);
+    if (by_range == unavailable || by_mask == unavailable) {
+      return by_range == unavailable ? 1.0 : -1.0;
+    }
+    return static_cast<double>(by_range) - static_cast<double>(by_mask);
+  };
+  std::ranges::stable_sort(groups, [&](group const& p_a, group const& p_b) {
+    if ((p_a.count > 1) != (p_b.count > 1)) {
+      return p_a.count > 1;
+    }
+    return p_a.count > 1 && preference(p_a) < preference(p_b);
+  });
+
+  can_filter_plan plan{ .requested = ids.size() };
+  usize next_identifier = 0;
+  usize next_mask = 0;
+  usize next_range = 0;
+
+  auto const multi = static_cast<usize>(std::ranges::count_if(
+    groups, [](group const& p_group) { return p_group.count > 1; }));
+  auto const required_ranges = multi > masks ? multi - masks : 0;
+
+  for (auto const& entry : groups) {
+    if (entry.count > 1) {
+      bool const use_range =
+        next_range < ranges &&
+        (next_range < required_ranges ||
+         range_cost(entry) <= mask_cost(entry));
+      if (use_range) {
+        p_range_filters[next_range++]->allow(
+          typename RangeFilter::pair{ .id_1 = entry.low, .id_2 = entry.high });
+        plan.accepted += range_cost(entry) + entry.count;
+      } else {
+        p_mask_filters[next_mask++]->allow(typename MaskFilter::pair{
+          .id = entry.low,
+          .mask = static_cast<Id>(FullMask & ~entry.varying),
+        });
+        plan.accepted += mask_cost(entry) + entry.count;
+      }
+      continue;
+    }
+
+    if (next_identifier < identifiers) {
+      p_identifier_filters[next_identifier++]->allow(entry.low);
+    } else if (next_mask < masks) {
+      p_mask_filters[next_mask++]->allow(
+        typename MaskFilter::pair{ .id = entry.low, .mask = FullMask });
+    } else if (next_range < ranges) {
+      p_range_filters[next_range++]->allow(
+        typename RangeFilter::pair{ .id_1 = entry.low, .id_2 = entry.low });
+    } else {
+      plan.uncovered++;
+      continue;
+    }
+    plan.accepted++;
+  }
+
+  for (; next_identifier < identifiers; next_identifier++) {
+    p_identifier_filters[next_identifier]->allow(std::nullopt);
+  }
+  for (; next_mask < masks; next_mask++) {
+    p_mask_filters[next_mask]->allow(std::nullopt);
+  }
+  for (; next_range < ranges; next_range++) {
+    p_range_filters[next_range]->allow(std::nullopt);
+  }
+
+  return plan;
+}
+}  // namespace detail
+
+/**
+ * @brief Configure CAN filters to accept a set of standard IDs
+ *
+ * Computes the combination of identifier, mask and range filters that accepts
+ * every requested ID while accepting as few other IDs as possible, then
+ * programs each filter with `allow()`. Filters that are not needed are
+ * disabled with `allow(std::nullopt)`.
+ *
+ * Requested IDs are sorted and neighboring IDs are merged into groups until
+ * every group fits a filter. Single IDs use identifier filters first. Groups of
+ * IDs use the range or mask filter that accepts fewer unrequested IDs. The
+ * merging is greedy, so the result is a close approximation of, rather than a
+ * guaranteed, optimal plan.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::can_mask_filter*, 2> masks{ &mask0, &mask1 };
+ * std::array<hal::can_range_filter*, 1> ranges{ &range0 };
+ * auto const plan = hal::configure_can_filters(
+ *   allocator, node_ids, {}, masks, ranges);
+ * if (plan.uncovered > 0) {
+ *   bus_manager.filter_mode(hal::can_bus_manager::accept::all);
+ * }
+ * ```
+ *
+ * @param p_allocator - allocator for scratch memory used while planning
+ * @param p_ids - standard IDs to accept. Duplicates are ignored and bits above
+ * the 11-bit ID are cleared.
+ * @param p_identifier_filters - identifier filters available for the plan
+ * @param p_mask_filters - mask filters available for the plan
+ * @param p_range_filters - range filters available for the plan
+ * @return can_filter_plan - coverage of the configured filters
+ * @throws std::bad_alloc - if scratch memory could not be allocated
+ */
+inline can_filter_plan configure_can_filters(
+  std::pmr::polymorphic_allocator<byte> p_allocator,
+  std::span<u16 const> p_ids,
+  std::span<can_identifier_filter* const> p_identifier_filters,
+  std::span<can_mask_filter* const> p_mask_filters,
+  std::span<can_range_filter* const> p_range_filters)
+{
+  return detail::configure_can_filters<u16, 0x7FF>(p_allocator,
+                                                   p_ids,
+                                                   p_identifier_filters,
+                                                   p_mask_filters,
+                                                   p_range_filters);
+}
+
+/**
+ * @brief Configure CAN filters to accept a set of extended IDs
+ *
+ * Same as the standard ID overload, but for 29-bit extended IDs and the
+ * extended filter interfaces.
+ *
+ * @param p_allocator - allocator for scratch memory used while planning
+ * @param p_ids - extended IDs to accept. Duplicates are ignored and bits above
+ * the 29-bit ID are cleared.
+ * @param p_identifier_filters - identifier filters available for the plan
+ * @param p_mask_filters - mask filters available for the plan
+ * @param p_range_filters - range filters available for the plan
+ * @return can_filter_plan - coverage of the configured filters
+ * @throws std::bad_alloc - if scratch memory could not be allocated
+ */
+inline can_filter_plan configure_can_filters(
+  std::pmr::polymorphic_allocator<byte> p_allocator,
+  std::span<u32 const> p_ids,
+  std::span<can_extended_identifier_filter* const> p_identifier_filters,
+  std::span<can_extended_mask_filter* const> p_mask_filters,
+  std::span<can_extended_range_filter* const> p_range_filters)
+{
+  return detail::configure_can_filters<u32, 0x1FFF'FFFF>(p_allocator,
+                                                         p_ids,
+                                                         p_identifier_filters,
+                                                         p_mask_filters,
+                                                         p_range_filters);
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::can_filter_plan;
+using v5::configure_can_filters;
+}  // namespace hal
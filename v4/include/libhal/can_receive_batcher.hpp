@@ -0,0 +1,208 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include "can.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Gathers received can messages into batches for
+ * `can_interrupt::on_receive_batch()`
+ *
+ * Intended for drivers implementing `driver_on_receive_batch()`, so every
+ * driver applies `can_interrupt::batch_settings` the same way. The driver's
+ * receive interrupt calls `received()` for each message it pulls from the
+ * hardware FIFO and `drained()` once the FIFO is empty. Drivers with a spare
+ * timer can arm it for `deadline()` and call `poll()` when it expires, so the
+ * latency threshold holds on a quiet bus. Batches are delivered from within
+ * these calls.
+ *
+ * Times are any monotonic uptime, such as the uptime of a `hal::steady_clock`
+ * converted to a duration, as long as every call uses the same one.
+ *
+ * Example usage within a driver:
+ *
+ * ```
+ * void driver_on_receive_batch(optional_batch_receive_handler p_callback,
+ *                              batch_settings const& p_settings) override
+ * {
+ *   m_batcher.configure(p_callback, p_settings);
+ * }
+ *
+ * void receive_interrupt()
+ * {
+ *   auto const now = uptime();
+ *   while (fifo_not_empty()) {
+ *     m_batcher.received(read_fifo(), now);
+ *   }
+ *   m_batcher.drained(now);
+ * }
+ * ```
+ *
+ * @tparam Capacity - maximum number of messages in a batch
+ */
+template<usize Capacity>
+class can_receive_batcher
+{
+public:
+  static_assert(Capacity > 0,
+                "can_receive_batcher must have a capacity of at least 1");
+
+  using handler = can_interrupt::optional_batch_receive_handler;
+  using settings = can_interrupt::batch_settings;
+
+  /**
+   * @brief Set the batch handler and when to deliver batches
+   *
+   * Pending messages are delivered to the previous handler first, so none are
+   * lost when the settings change.
+   *
+   * @param p_handler - handler to deliver batches to. std::nullopt discards
+   * received messages.
+   * @param p_settings - delivery conditions. `max_frames` is clamped between
+   * 1 and `Capacity`.
+   */
+  void configure(handler p_handler, settings const& p_settings)
+  {
+    flush();
+    m_handler = p_handler;
+    m_settings = p_settings;
+    constexpr auto max_frames =
+      std::min<usize>(Capacity, std::numeric_limits<u16>::max());
+    m_settings.max_frames = static_cast<u16>(
+      std::clamp<usize>(m_settings.max_frames, 1, max_frames));
+  }
+
+  /**
+   * @brief Record a received message
+   *
+   * Delivers the batch if this message reaches the frame count threshold or
+   * if the oldest pending message has waited out the latency threshold.
+   *
+   * @param p_message - message read from the hardware
+   * @param p_now - current uptime
+   */
+  void received(can_message const& p_message, hal::time_duration p_now)
+  {
+    if (not m_handler) {
+      return;
+    }
+    if (m_count == 0) {
+      m_oldest = p_now;
+    }
+    m_messages[m_count++] = p_message;
+    if (m_count >= m_settings.max_frames) {
+      flush();
+      return;
+    }
+    poll(p_now);
+  }
+
+  /**
+   * @brief Signal that the hardware receive FIFO has been emptied
+   *
+   * Delivers pending messages if `deliver_on_drain` is set, otherwise only
+   * checks the latency threshold.
+   *
+   * @param p_now - current uptime
+   */
+  void drained(hal::time_duration p_now)
+  {
+    if (m_settings.deliver_on_drain) {
+      flush();
+      return;
+    }
+    poll(p_now);
+  }
+
+  /**
+   * @brief Deliver pending messages if the oldest has waited out the latency
+   * threshold
+   *
+   * @param p_now - current uptime
+   */
+  void poll(hal::time_duration p_now)
+  {
+    if (m_count != 0 && p_now - m_oldest >= m_settings.max_latency) {
+      flush();
+    }
+  }
+
+  /**
+   * @brief Deliver pending messages, regardless of the thresholds
+   *
+   */
+  void flush()
+  {
+    if (m_count == 0) {
+      return;
+    }
+    auto const count = m_count;
+    // Cleared first so the handler may reconfigure this batcher
+    m_count = 0;
+    if (m_handler) {
+      (*m_handler)(std::span<can_message const>(m_messages).first(count));
+    }
+  }
+
+  /**
+   * @brief Get the uptime at which pending messages must be delivered
+   *
+   * @return std::optional<hal::time_duration> - uptime at which the latency
+   * threshold expires, or std::nullopt if no messages are pending
+   */
+  [[nodiscard]] std::optional<hal::time_duration> deadline() const
+  {
+    if (m_count == 0) {
+      return std::nullopt;
+    }
+    return m_oldest + m_settings.max_latency;
+  }
+
+  /**
+   * @return usize - number of messages waiting to be delivered
+   */
+  [[nodiscard]] usize pending() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @return settings const& - delivery conditions, after clamping
+   */
+  [[nodiscard]] settings const& configuration() const
+  {
+    return m_settings;
+  }
+
+private:
+  std::array<can_message, Capacity> m_messages{};
+  handler m_handler{};
+  settings m_settings{};
+  hal::time_duration m_oldest{};
+  usize m_count = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::can_receive_batcher;
+}  // namespace hal
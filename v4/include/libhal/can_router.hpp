@@ -0,0 +1,212 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <optional>
+#include <span>
+
+#include "can.hpp"
+#include "error.hpp"
+#include "functional.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Dispatches messages from a can_transceiver's receive buffer to
+ * handlers registered per message ID
+ *
+ * Rather than each subsystem scanning the whole receive buffer for its own
+ * IDs, a single can_router reads the transceiver's receive cursor once per
+ * `poll()` and hands each new message to the handler registered for its ID.
+ *
+ * Handlers are stored in a fixed size open addressing hash table that is kept
+ * at most half full, so looking up the handler for a message takes a constant
+ * number of probes on average regardless of how many routes are registered.
+ * No memory is allocated.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::can_router<8> router(transceiver);
+ * router.route(0x120, [&](hal::can_message const& p_message) {
+ *   motor_status.update(p_message);
+ * });
+ * router.route(0x18DAF110, handle_diagnostics, true);
+ *
+ * while (true) {
+ *   router.poll();
+ * }
+ * ```
+ *
+ * @tparam Capacity - maximum number of routes that can be registered
+ */
+template<usize Capacity>
+class can_router
+{
+public:
+  static_assert(Capacity > 0, "can_router must have a capacity of at least 1");
+
+  /// Handler signature for routed messages
+  using handler = hal::callback<void(can_message const&)>;
+
+  /**
+   * @brief Construct a router for a can transceiver
+   *
+   * Messages received before construction are not dispatched.
+   *
+   * @param p_transceiver - transceiver with the receive buffer to dispatch
+   * messages from. Must outlive this object.
+   */
+  explicit can_router(can_transceiver& p_transceiver)
+    : m_transceiver(&p_transceiver)
+    , m_cursor(p_transceiver.receive_cursor())
+  {
+  }
+
+  /**
+   * @brief Register a handler for a message ID
+   *
+   * If a handler is already registered for this ID, it is replaced.
+   *
+   * @param p_id - message ID to route
+   * @param p_handler - handler to call with each message with this ID
+   * @param p_extended - true if p_id is a 29-bit extended ID
+   * @throws hal::out_of_range - if `Capacity` routes have already been
+   * registered and p_id is not one of them.
+   */
+  void route(u32 p_id, handler p_handler, bool p_extended = false)
+  {
+    auto const key = make_key(p_id, p_extended);
+    auto index = find(key);
+
+    if (not m_table[index].target) {
+      if (m_size >= Capacity) {
+        hal::safe_throw(hal::out_of_range(
+          this, { .m_index = m_size, .m_capacity = Capacity }));
+      }
+      m_table[index].key = key;
+      m_size++;
+    }
+
+    m_table[index].target = p_handler;
+  }
+
+  /**
+   * @brief Set the handler for messages without a registered route
+   *
+   * @param p_handler - handler to call with unrouted messages. Set to
+   * std::nullopt to drop unrouted messages.
+   */
+  void unrouted(std::optional<handler> p_handler)
+  {
+    m_unrouted = p_handler;
+  }
+
+  /**
+   * @brief Dispatch every message received since the last call
+   *
+   * Handlers are called in the order the messages were received. If more
+   * messages arrived than the receive buffer can hold, the oldest messages have
+   * been overwritten and cannot be dispatched.
+   *
+   * @return usize - number of messages that were dispatched to a route
+   */
+  usize poll()
+  {
+    auto const buffer = m_transceiver->receive_buffer();
+    auto const cursor = m_transceiver->receive_cursor();
+    usize routed = 0;
+
+    for (auto i = m_cursor; i != cursor; i = next(i, buffer.size())) {
+      auto const& message = buffer[i];
+      auto const& route = m_table[find(make_key(message.id, message.extended))];
+      if (route.target) {
+        (*route.target)(message);
+        routed++;
+      } else if (m_unrouted) {
+        (*m_unrouted)(message);
+      }
+    }
+
+    m_cursor = cursor;
+    return routed;
+  }
+
+  /**
+   * @brief Get the number of registered routes
+   *
+   * @return usize - number of registered routes
+   */
+  [[nodiscard]] usize size() const
+  {
+    return m_size;
+  }
+
+private:
+  /// Table size, at least double the capacity to keep probe chains short
+  static constexpr usize table_size = std::bit_ceil(Capacity * 2);
+  static constexpr u32 table_bits = std::countr_zero(table_size);
+
+  struct entry
+  {
+    u32 key = 0;
+    std::optional<handler> target{};
+  };
+
+  /// Bits 29 to 31 of an ID are reserved, so bit 31 marks extended IDs
+  [[nodiscard]] static constexpr u32 make_key(u32 p_id, bool p_extended)
+  {
+    return p_id | (static_cast<u32>(p_extended) << 31U);
+  }
+
+  [[nodiscard]] static constexpr usize next(usize p_index, usize p_size)
+  {
+    auto const result = p_index + 1;
+    return result == p_size ? 0 : result;
+  }
+
+  /**
+   * @brief Find the slot holding a key, or the empty slot it would occupy
+   *
+   * Uses Fibonacci hashing to spread sequential IDs across the table, then
+   * linear probing. The table is never more than half full so an empty slot
+   * always terminates the search.
+   */
+  [[nodiscard]] usize find(u32 p_key) const
+  {
+    constexpr u32 golden_ratio = 0x9E37'79B9;
+    auto const hash = (p_key * golden_ratio) >> (32 - table_bits);
+    auto index = static_cast<usize>(hash);
+
+    while (m_table[index].target && m_table[index].key != p_key) {
+      index = (index + 1) & (table_size - 1);
+    }
+
+    return index;
+  }
+
+  can_transceiver* m_transceiver;
+  usize m_cursor = 0;
+  usize m_size = 0;
+  std::optional<handler> m_unrouted{};
+  std::array<entry, table_size> m_table{};
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::can_router;
+}  // namespace hal
@@ -14,7 +14,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
 #include <memory_resource>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -22,6 +27,29 @@
 
 namespace hal::v5 {
 
+/**
+ * @brief Selects how a circular_buffer's capacity is chosen and wrapped
+ *
+ */
+enum class circular_buffer_capacity : u8
+{
+  /// Any capacity is allowed. Indices wrap using modulo, which on processors
+  /// without a hardware divider becomes a library call.
+  any,
+  /// Capacity is rounded up to the next power of two. Indices wrap using a
+  /// bit mask, which is a single instruction on every processor.
+  power_of_two,
+};
+
+/**
+ * @brief Tag type used to construct a circular_buffer with lazily constructed
+ * elements
+ *
+ * See the circular_buffer constructor that accepts this tag for details.
+ */
+struct lazy_construct_tag
+{};
+
 /**
  * @brief A circular buffer with runtime size.
  *
@@ -52,15 +80,24 @@ namespace hal::v5 {
  * }
  * ```
  *
+ * Buffers constructed with `hal::lazy_construct_tag` skip the construction of
+ * their elements at startup. Each slot is constructed when it is first written
+ * and `size()` reports the number of slots holding an element. This mode does
+ * not require T to be default constructible and supports move only types.
+ *
+ * For targets without a hardware divider, such as the Cortex-M0+, use
+ * `circular_buffer_pow2<T>` which rounds the capacity up to a power of two and
+ * replaces every modulo with a bit mask.
+ *
  * @tparam T The type of elements in the buffer
+ * @tparam Capacity The capacity policy of the buffer, see
+ * `circular_buffer_capacity`.
  */
-template<typename T>
+template<typename T,
+         circular_buffer_capacity Capacity = circular_buffer_capacity::any>
 class circular_buffer
 {
 public:
-  static_assert(std::is_default_constructible_v<T>,
-                "circular_buffer requires T to be default constructible");
-
   // Standard container type definitions
   using value_type = T;
   using size_type = usize;
@@ -107,8 +144,10 @@ public:
    */
   explicit circular_buffer(std::pmr::polymorphic_allocator<byte> p_allocator,
                            size_type p_capacity)
+    requires(std::is_default_constructible_v<T>)
     : m_allocator(p_allocator)
-    , m_capacity(std::max<size_type>(1, p_capacity))
+    , m_capacity(adjust_capacity(p_capacity))
+    , m_size(m_capacity)
   {
     // Allocate memory for the array using allocate_object
     m_data = m_allocator.allocate_object<T>(m_capacity);
@@ -133,7 +172,8 @@ public:
                   size_type p_capacity,
                   T const& p_value)
     : m_allocator(p_allocator)
-    , m_capacity(std::max<size_type>(1, p_capacity))
+    , m_capacity(adjust_capacity(p_capacity))
+    , m_size(m_capacity)
   {
     // Allocate memory for the array using allocate_object
     m_data = m_allocator.allocate_object<T>(m_capacity);
@@ -153,8 +193,10 @@ public:
    */
   circular_buffer(std::pmr::polymorphic_allocator<byte> p_allocator,
                   std::initializer_list<T> p_init)
+    requires(std::is_default_constructible_v<T>)
     : m_allocator(p_allocator)
-    , m_capacity(std::max<size_type>(1, p_init.size()))
+    , m_capacity(adjust_capacity(p_init.size()))
+    , m_size(m_capacity)
   {
     // Allocate memory for the array using allocate_object
     m_data = m_allocator.allocate_object<T>(m_capacity);
@@ -165,7 +207,11 @@ public:
       for (auto const& item : p_init) {
         new (&m_data[i++]) T(item);
       }
-      m_write_index = p_init.size();
+      // Fill any slots added by rounding the capacity up to a power of two
+      for (; i < m_capacity; ++i) {
+        new (&m_data[i]) T();
+      }
+      m_write_index = wrap(p_init.size());
     } else {
       // Initialize the single element with default construction
       if constexpr (not std::is_trivially_default_constructible_v<T>) {
@@ -174,17 +220,46 @@ public:
     }
   }
 
+  /**
+   * @brief Create a circular_buffer with specified capacity without
+   * constructing any elements
+   *
+   * Memory for all elements is allocated, but each slot is only constructed
+   * the first time it is written by `push()`, `emplace()` or `push_range()`.
+   * This avoids a construction pass over large buffers at startup and allows T
+   * to be a type that is not default constructible.
+   *
+   * The buffer starts with a `size()` of 0 which grows with each write until it
+   * reaches `capacity()`. Accessing a slot that has not been written yet, via
+   * `operator[]` or `data()`, is undefined behavior.
+   *
+   * If p_capacity is 0, a buffer of capacity 1 will be allocated.
+   *
+   * @param p_allocator The allocator to use for memory allocation
+   * @param p_capacity The capacity of the buffer
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  circular_buffer(std::pmr::polymorphic_allocator<byte> p_allocator,
+                  size_type p_capacity,
+                  lazy_construct_tag)
+    : m_allocator(p_allocator)
+    , m_capacity(adjust_capacity(p_capacity))
+    , m_size(0)
+  {
+    m_data = m_allocator.allocate_object<T>(m_capacity);
+  }
+
   /**
    * @brief Destructor
    *
-   * Destroys all elements and deallocates memory.
+   * Destroys all constructed elements and deallocates memory.
    */
   ~circular_buffer()
   {
     if (m_data) {
       // Call destructor for each element if not trivially destructible
       if constexpr (!std::is_trivially_destructible_v<T>) {
-        for (size_type i = 0; i < m_capacity; ++i) {
+        for (size_type i = 0; i < m_size; ++i) {
           m_data[i].~T();
         }
       }
@@ -204,10 +279,15 @@ public:
   void push(T const& p_value)
   {
     // Replace the element at the current write index
-    m_data[m_write_index] = p_value;
+    if (m_write_index < m_size) {
+      m_data[m_write_index] = p_value;
+    } else {
+      new (&m_data[m_write_index]) T(p_value);
+      m_size++;
+    }
 
     // Advance the write index, wrapping around if necessary
-    m_write_index = (m_write_index + 1) % m_capacity;
+    m_write_index = wrap(m_write_index + 1);
   }
 
   /**
@@ -220,10 +300,15 @@ public:
   void push(T&& p_value)
   {
     // Replace the element at the current write index
-    m_data[m_write_index] = std::move(p_value);
+    if (m_write_index < m_size) {
+      m_data[m_write_index] = std::move(p_value);
+    } else {
+      new (&m_data[m_write_index]) T(std::move(p_value));
+      m_size++;
+    }
 
     // Advance the write index, wrapping around if necessary
-    m_write_index = (m_write_index + 1) % m_capacity;
+    m_write_index = wrap(m_write_index + 1);
   }
 
   /**
@@ -240,7 +325,11 @@ public:
   reference emplace(Args&&... args)
   {
     // Destroy the object at the current write index
-    m_data[m_write_index].~T();
+    if (m_write_index < m_size) {
+      m_data[m_write_index].~T();
+    } else {
+      m_size++;
+    }
 
     // Construct a new object in its place
     new (&m_data[m_write_index]) T(std::forward<Args>(args)...);
@@ -249,11 +338,102 @@ public:
     reference result = m_data[m_write_index];
 
     // Advance the write index, wrapping around if necessary
-    m_write_index = (m_write_index + 1) % m_capacity;
+    m_write_index = wrap(m_write_index + 1);
 
     return result;
   }
 
+  /**
+   * @brief Push a contiguous range of elements into the circular buffer
+   *
+   * The result is identical to calling `push()` on each element of p_values in
+   * order, but the elements are copied in at most two segments, one up to the
+   * end of the underlying array and one from its start. If p_values holds more
+   * elements than the buffer's capacity, only the last `capacity()` elements
+   * are copied, as the earlier elements would have been overwritten anyway.
+   *
+   * p_values must not refer to memory within this buffer.
+   *
+   * @param p_values The values to copy into the buffer, oldest first
+   */
+  void push_range(std::span<T const> p_values)
+  {
+    if (p_values.size() > m_capacity) {
+      // Only the final `m_capacity` elements survive, skip the rest but keep
+      // the write index where an element-by-element push would have put it.
+      auto const skipped = p_values.size() - m_capacity;
+      m_write_index = wrap(m_write_index + skipped);
+      p_values = p_values.last(m_capacity);
+    }
+
+    auto const til_end = m_capacity - m_write_index;
+    auto const first_length = std::min(til_end, p_values.size());
+    auto const first = p_values.first(first_length);
+    auto const second = p_values.subspan(first_length);
+
+    // The segment at the start of the array is written first so that the
+    // constructed slots always form a prefix of the array
+    write_segment(0, second);
+    write_segment(m_write_index, first);
+
+    if (second.empty()) {
+      m_write_index += first_length;
+      if (m_write_index == m_capacity) {
+        m_write_index = 0;
+      }
+    } else {
+      m_write_index = second.size();
+    }
+  }
+
+  /**
+   * @brief Get the contents of the buffer as contiguous spans, oldest to newest
+   *
+   * The contents of a circular buffer are split into at most two contiguous
+   * regions of the underlying array. The first span starts with the oldest
+   * element, at the write index, and runs to the end of the array. The second
+   * span starts at the beginning of the array and ends just before the write
+   * index. If the write index is 0, then the second span is empty.
+   *
+   * For a lazily constructed buffer that has not been filled yet, only the
+   * constructed elements are returned, all within the first span.
+   *
+   * The returned array can be passed directly to APIs that accept a
+   * `hal::scatter_span<T>`, such as a DMA transmit, without copying the
+   * elements out of the buffer.
+   *
+   * The spans are invalidated by any operation that changes the write index.
+   *
+   * @return std::array<std::span<T>, 2> - the oldest and newest segments of the
+   * buffer
+   */
+  [[nodiscard]] std::array<std::span<T>, 2> contiguous_spans() noexcept
+  {
+    if (m_size < m_capacity) {
+      return { std::span<T>(m_data, m_size), std::span<T>() };
+    }
+    return { std::span<T>(m_data + m_write_index, m_capacity - m_write_index),
+             std::span<T>(m_data, m_write_index) };
+  }
+
+  /**
+   * @brief Get the contents of the buffer as contiguous spans, oldest to newest
+   * (const version)
+   *
+   * @return std::array<std::span<T const>, 2> - the oldest and newest segments
+   * of the buffer
+   */
+  [[nodiscard]] std::array<std::span<T const>, 2> contiguous_spans()
+    const noexcept
+  {
+    if (m_size < m_capacity) {
+      return { std::span<T const>(m_data, m_size), std::span<T const>() };
+    }
+    return { std::span<T const>(m_data + m_write_index,
+                                m_capacity - m_write_index),
+             std::span<T const>(m_data, m_write_index) };
+  }
+
   /**
    * @brief Access element at the specified relative index with circular
    * wrapping
@@ -268,7 +448,7 @@ public:
    */
   [[nodiscard]] reference operator[](size_type p_index)
   {
-    size_type const actual_index = p_index % m_capacity;
+    size_type const actual_index = wrap(p_index);
     return m_data[actual_index];
   }
 
@@ -282,7 +462,7 @@ public:
    */
   [[nodiscard]] const_reference operator[](size_type p_index) const
   {
-    size_type const actual_index = p_index % m_capacity;
+    size_type const actual_index = wrap(p_index);
     return m_data[actual_index];
   }
 
@@ -319,6 +499,19 @@ public:
     return m_capacity;
   }
 
+  /**
+   * @brief Returns the number of elements held by the circular_buffer
+   *
+   * This is always equal to `capacity()` unless the buffer was constructed
+   * with `hal::lazy_construct_tag` and has not been completely filled yet.
+   *
+   * @return The number of constructed elements in the buffer
+   */
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return m_size;
+  }
+
   /**
    * @brief Returns the size of the circular_buffer in bytes
    *
@@ -342,9 +535,64 @@ public:
   }
 
 private:
+  /**
+   * @brief Compute the capacity to allocate for a requested capacity
+   *
+   * @param p_capacity - requested capacity
+   * @return size_type - at least 1, and rounded up to a power of two when
+   * using `circular_buffer_capacity::power_of_two`.
+   */
+  [[nodiscard]] static constexpr size_type adjust_capacity(
+    size_type p_capacity) noexcept
+  {
+    auto const capacity = std::max<size_type>(1, p_capacity);
+    if constexpr (Capacity == circular_buffer_capacity::power_of_two) {
+      return std::bit_ceil(capacity);
+    } else {
+      return capacity;
+    }
+  }
+
+  /**
+   * @brief Copy values into the array starting at an index
+   *
+   * Slots that have already been constructed are assigned to, the remaining
+   * slots are copy constructed. p_start must be at most m_size so that the
+   * constructed slots remain a prefix of the array.
+   *
+   * @param p_start - index of the first slot to write
+   * @param p_values - values to write
+   */
+  void write_segment(size_type p_start, std::span<T const> p_values)
+  {
+    auto const assigned =
+      std::min(p_values.size(), m_size - std::min(m_size, p_start));
+    std::ranges::copy(p_values.first(assigned), m_data + p_start);
+    std::ranges::uninitialized_copy(
+      p_values.subspan(assigned),
+      std::span<T>(m_data + p_start + assigned, p_values.size() - assigned));
+    m_size = std::max(m_size, p_start + p_values.size());
+  }
+
+  /**
+   * @brief Wrap an index into the bounds of the buffer
+   *
+   * @param p_index - index to wrap
+   * @return size_type - index within [0, m_capacity)
+   */
+  [[nodiscard]] constexpr size_type wrap(size_type p_index) const noexcept
+  {
+    if constexpr (Capacity == circular_buffer_capacity::power_of_two) {
+      return p_index & (m_capacity - 1);
+    } else {
+      return p_index % m_capacity;
+    }
+  }
+
   std::pmr::polymorphic_allocator<byte> m_allocator;  ///< Allocator
   pointer m_data = nullptr;     ///< Pointer to allocated memory
   size_type m_capacity = 0;     ///< Capacity of the buffer
+  size_type m_size = 0;         ///< Number of constructed elements
   size_type m_write_index = 0;  ///< Current write position
 };
 
@@ -353,17 +601,19 @@ private:
  * value-constructed elements
  *
  * @tparam T The type of elements in the circular_buffer
+ * @tparam Capacity The capacity policy of the circular_buffer
  * @param p_allocator The allocator to use
  * @param p_capacity The capacity of the circular_buffer
  * @return A new circular_buffer of the specified capacity with
  * value-constructed elements
  */
-template<typename T>
-[[nodiscard]] circular_buffer<T> make_circular_buffer(
+template<typename T,
+         circular_buffer_capacity Capacity = circular_buffer_capacity::any>
+[[nodiscard]] circular_buffer<T, Capacity> make_circular_buffer(
   std::pmr::polymorphic_allocator<byte> p_allocator,
-  typename circular_buffer<T>::size_type p_capacity)
+  typename circular_buffer<T, Capacity>::size_type p_capacity)
 {
-  return circular_buffer<T>(p_allocator, p_capacity);
+  return circular_buffer<T, Capacity>(p_allocator, p_capacity);
 }
 
 /**
@@ -371,24 +621,41 @@ template<typename T>
  * copies of the provided value
  *
  * @tparam T The type of elements in the circular_buffer
+ * @tparam Capacity The capacity policy of the circular_buffer
  * @param p_allocator The allocator to use
  * @param p_capacity The capacity of the circular_buffer
  * @param p_value The value to fill the circular_buffer with
  * @return A new circular_buffer of the specified capacity filled with the given
  * value
  */
-template<typename T>
-[[nodiscard]] circular_buffer<T> make_circular_buffer(
+template<typename T,
+         circular_buffer_capacity Capacity = circular_buffer_capacity::any>
+[[nodiscard]] circular_buffer<T, Capacity> make_circular_buffer(
   std::pmr::polymorphic_allocator<byte> p_allocator,
-  typename circular_buffer<T>::size_type p_capacity,
+  typename circular_buffer<T, Capacity>::size_type p_capacity,
   T const& p_value)
 {
-  return circular_buffer<T>(p_allocator, p_capacity, p_value);
+  return circular_buffer<T, Capacity>(p_allocator, p_capacity, p_value);
 }
+
+/**
+ * @brief A circular buffer with a power of two capacity
+ *
+ * Requested capacities are rounded up to the next power of two so that every
+ * index wraps with a bit mask rather than a modulo operation.
+ *
+ * @tparam T The type of elements in the buffer
+ */
+template<typename T>
+using circular_buffer_pow2 =
+  circular_buffer<T, circular_buffer_capacity::power_of_two>;
 }  // namespace hal::v5
 
 // Bring hal::v5 symbols into hal namespace
 namespace hal {
 using hal::v5::circular_buffer;
+using hal::v5::circular_buffer_capacity;
+using hal::v5::circular_buffer_pow2;
+using hal::v5::lazy_construct_tag;
 using hal::v5::make_circular_buffer;
 }  // namespace hal
@@ -0,0 +1,358 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+
+#include "error.hpp"
+#include "functional.hpp"
+#include "scatter_span.hpp"
+#include "units.hpp"
+
+/**
+ * @file cobs.hpp
+ * @brief Consistent Overhead Byte Stuffing (COBS) framing
+ *
+ * COBS removes every zero from a frame, so a single zero byte can delimit
+ * frames on a byte stream such as a UART. Each encoded frame is a sequence of
+ * blocks: a code byte N followed by N - 1 data bytes, where every block but
+ * the last, and any block with a code of 0xFF, ends with a zero that was
+ * removed. The frame is followed by a zero delimiter.
+ */
+
+namespace hal::v5 {
+namespace detail {
+/// Find the first zero byte with the C library's memchr, which is vectorized
+/// on hosts and searches a machine word at a time in embedded C libraries
+inline usize find_zero(std::span<hal::byte const> p_data)
+{
+  if (p_data.empty()) {
+    return 0;
+  }
+  auto const* zero = static_cast<hal::byte const*>(
+    std::memchr(p_data.data(), 0, p_data.size()));
+  return zero == nullptr ? p_data.size()
+                         : static_cast<usize>(zero - p_data.data());
+}
+}  // namespace detail
+
+/**
+ * @brief Decode a stream of COBS frames as it is received
+ *
+ * Data is fed in chunks of any size, such as the segments returned by
+ * `hal::zero_copy_serial_reader::read()`, straight out of a serial port's
+ * receive buffer. Rather than stepping a state machine per byte, the deframer
+ * copies each block's data bytes into the frame buffer in one run, searching
+ * the run for an unexpected delimiter with `std::memchr`. Each complete
+ * frame is passed to a handler, decoded and contiguous.
+ *
+ * A frame that is malformed, because a delimiter arrived in the middle of a
+ * block, or that does not fit in the frame buffer, is dropped and counted as
+ * an error. Decoding resumes with the next frame. Delimiters with no frame
+ * between them are ignored, so senders may start each frame with a delimiter
+ * to resynchronize the receiver.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::byte, 256> frame_buffer{};
+ * hal::cobs_deframer deframer(frame_buffer);
+ * hal::zero_copy_serial_reader reader(uart);
+ *
+ * while (true) {
+ *   deframer.feed(reader.read(), [](std::span<hal::byte const> p_frame) {
+ *     handle_command(p_frame);
+ *   });
+ * }
+ * ```
+ */
+class cobs_deframer
+{
+public:
+  /// Called with each decoded frame, valid only for the duration of the call
+  using frame_handler = void(std::span<hal::byte const> p_frame);
+
+  /**
+   * @brief Construct a deframer
+   *
+   * @param p_frame_buffer - buffer to decode frames into, which limits the
+   * size of the frames that can be received. Must outlive this object.
+   */
+  explicit cobs_deframer(std::span<hal::byte> p_frame_buffer)
+    : m_buffer(p_frame_buffer)
+  {
+  }
+
+  /**
+   * @brief Decode the next chunk of the stream
+   *
+   * @param p_data - next bytes of the stream
+   * @param p_handler - called for each frame completed by p_data, in order
+   */
+  void feed(std::span<hal::byte const> p_data,
+            hal::function_ref<frame_handler> p_handler)
+  {
+    while (not p_data.empty()) {
+      if (m_discarding) {
+        auto const delimiter = detail::find_zero(p_data);
+        if (delimiter == p_data.size()) {
+          return;
+        }
+        p_data = p_data.subspan(delimiter + 1);
+        restart();
+        continue;
+      }
+
+      if (m_remaining == 0) {
+        auto const code = p_data[0];
+        p_data = p_data.subspan(1);
+        if (code == 0) {
+          if (m_started) {
+            p_handler(m_buffer.first(m_size));
+          }
+          restart();
+          continue;
+        }
+        if (m_started && m_implied_zero) {
+          if (m_size == m_buffer.size()) {
+            drop();
+            continue;
+          }
+          m_buffer[m_size++] = 0;
+        }
+        m_started = true;
+        m_remaining = code - 1;
+        m_implied_zero = code != 0xFF;
+        continue;
+      }
+
+      auto const run = p_data.first(std::min(m_remaining, p_data.size()));
+      auto const delimiter = detail::find_zero(run);
+      if (delimiter != run.size()) {
+        m_errors++;
+        p_data = p_data.subspan(delimiter + 1);
+        restart();
+        continue;
+      }
+      if (m_buffer.size() - m_size < run.size()) {
+        drop();
+        continue;
+      }
+      std::ranges::copy(run, m_buffer.begin() + m_size);
+      m_size += run.size();
+      m_remaining -= run.size();
+      p_data = p_data.subspan(run.size());
+    }
+  }
+
+  /**
+   * @brief Decode the next chunk of the stream, held in several segments
+   *
+   * @param p_data - next bytes of the stream, in order
+   * @param p_handler - called for each frame completed by p_data, in order
+   */
+  void feed(scatter_span<hal::byte const> p_data,
+            hal::function_ref<frame_handler> p_handler)
+  {
+    for (auto const& segment : p_data) {
+      feed(segment, p_handler);
+    }
+  }
+
+  /**
+   * @brief Get the number of frames dropped
+   *
+   * @return u32 - frames that were malformed or too large for the frame
+   * buffer, since construction or the last reset
+   */
+  [[nodiscard]] u32 errors() const
+  {
+    return m_errors;
+  }
+
+  /**
+   * @brief Discard any partially received frame and the error count
+   *
+   * Call after data was lost, such as when
+   * `hal::zero_copy_serial_reader::dropped()` is not 0. Bytes up to the next
+   * delimiter are then decoded as the start of a frame and are likely to be
+   * dropped as malformed.
+   */
+  void reset()
+  {
+    restart();
+    m_errors = 0;
+  }
+
+private:
+  void restart()
+  {
+    m_size = 0;
+    m_remaining = 0;
+    m_started = false;
+    m_implied_zero = false;
+    m_discarding = false;
+  }
+
+  void drop()
+  {
+    m_errors++;
+    restart();
+    m_discarding = true;
+  }
+
+  std::span<hal::byte> m_buffer;
+  usize m_size = 0;
+  usize m_remaining = 0;
+  u32 m_errors = 0;
+  bool m_started = false;
+  bool m_implied_zero = false;
+  bool m_discarding = false;
+};
+
+/**
+ * @brief COBS encoding of a frame as a scatter span, for scatter writes
+ *
+ * Encodes without copying the payload: the segments alternate between code
+ * bytes held by this object and runs of the payload, and end with the
+ * delimiter. Write them with a scatter-gather write such as
+ * `hal::zero_copy_serial::write(scatter_span<hal::byte const>)`.
+ *
+ * Each zero in the payload, each 254 bytes without a zero and each boundary
+ * between payload segments adds a segment, so size MaxSegments for the
+ * largest frame expected. The payload must outlive this object.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::cobs_frame<16> frame(hal::make_scatter_bytes(header, payload, crc));
+ * uart.write(frame.segments());
+ * ```
+ *
+ * @tparam MaxSegments - capacity for code bytes, runs and the delimiter
+ */
+template<usize MaxSegments = 16>
+class cobs_frame
+{
+public:
+  static_assert(MaxSegments >= 2, "A frame needs a code byte and delimiter");
+
+  /**
+   * @brief Encode a payload held in several segments
+   *
+   * @param p_payload - data to encode. Must outlive this object.
+   * @throws hal::argument_out_of_domain - if encoding the payload needs more
+   * than MaxSegments segments
+   */
+  explicit cobs_frame(scatter_span<hal::byte const> p_payload)
+  {
+    bool full = false;
+    begin_block();
+
+    for (auto segment : p_payload) {
+      while (not segment.empty()) {
+        if (full) {
+          begin_block();
+          full = false;
+        }
+        auto& code = m_codes[m_code_count - 1];
+        auto const take = std::min<usize>(segment.size(), 0xFF - code);
+        auto const zero = detail::find_zero(segment.first(take));
+        if (zero != 0) {
+          push(segment.first(zero));
+          code = static_cast<hal::byte>(code + zero);
+        }
+        if (zero != take) {
+          segment = segment.subspan(zero + 1);
+          begin_block();
+        } else {
+          segment = segment.subspan(take);
+          full = code == 0xFF;
+        }
+      }
+    }
+
+    push(std::span(&delimiter, 1));
+  }
+
+  /**
+   * @brief Encode a contiguous payload
+   *
+   * @param p_payload - data to encode. Must outlive this object.
+   * @throws hal::argument_out_of_domain - if encoding the payload needs more
+   * than MaxSegments segments
+   */
+  explicit cobs_frame(std::span<hal::byte const> p_payload)
+    : cobs_frame(scatter_span<hal::byte const>(std::array{ p_payload }))
+  {
+  }
+
+  cobs_frame(cobs_frame const&) = delete;
+  cobs_frame& operator=(cobs_frame const&) = delete;
+  cobs_frame(cobs_frame&&) = delete;
+  cobs_frame& operator=(cobs_frame&&) = delete;
+  ~cobs_frame() = default;
+
+  /**
+   * @brief Get the encoded frame, including its trailing delimiter
+   *
+   * @return scatter_span<hal::byte const> - segments of the encoded frame
+   */
+  [[nodiscard]] scatter_span<hal::byte const> segments() const
+  {
+    return scatter_span<hal::byte const>(m_segments).first(m_segment_count);
+  }
+
+  /**
+   * @brief Get the number of bytes of the encoded frame
+   *
+   * @return usize - encoded size, including the delimiter
+   */
+  [[nodiscard]] usize size() const
+  {
+    return scatter_size(segments());
+  }
+
+private:
+  static constexpr hal::byte delimiter = 0;
+
+  void begin_block()
+  {
+    push(std::span(m_codes.data() + m_code_count, 1));
+    m_codes[m_code_count++] = 1;
+  }
+
+  void push(std::span<hal::byte const> p_segment)
+  {
+    if (m_segment_count == MaxSegments) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_segments[m_segment_count++] = p_segment;
+  }
+
+  std::array<std::span<hal::byte const>, MaxSegments> m_segments{};
+  std::array<hal::byte, MaxSegments> m_codes{};
+  usize m_segment_count = 0;
+  usize m_code_count = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::cobs_deframer;
+using v5::cobs_frame;
+}  // namespace hal
@@ -0,0 +1,381 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+
+#include "motor.hpp"
+#include "rotation_sensor.hpp"
+#include "steady_clock.hpp"
+#include "timed_interrupt.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/// Fixed point number with 16 integer bits and 16 fractional bits
+using q16 = i32;
+
+/**
+ * @brief Convert a float to Q16.16 fixed point
+ *
+ * @param p_value - value from -32768.0f to 32767.99998f
+ * @return constexpr q16 - value rounded to the nearest Q16.16 number
+ */
+[[nodiscard]] constexpr q16 to_q16(float p_value)
+{
+  auto const scaled = p_value * 65536.0f;
+  return static_cast<q16>(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+}
+
+/**
+ * @brief Convert a Q16.16 fixed point number to float
+ *
+ * @param p_value - Q16.16 number
+ * @return constexpr float - the value as a float
+ */
+[[nodiscard]] constexpr float from_q16(q16 p_value)
+{
+  return static_cast<float>(p_value) / 65536.0f;
+}
+
+/**
+ * @brief PID controller in Q16.16 fixed point
+ *
+ * Computes `kp * error + integral(ki * error) - kd * d(measurement) +
+ * kf * setpoint` using only integer arithmetic, so its cost is the same on
+ * MCUs with and without an FPU and its output is bit exact across targets.
+ *
+ * The gains are per update: the integral gain is multiplied by the error once
+ * per call and the derivative gain by the change of the measurement since the
+ * previous call. Scale the gains by the update period to tune in units of
+ * seconds.
+ *
+ * The integral term is clamped to the output limits (anti-windup), so the
+ * controller recovers from saturation immediately instead of unwinding an
+ * accumulated integral. The derivative acts on the measurement rather than the
+ * error, so setpoint steps do not kick the output.
+ */
+class q16_pid
+{
+public:
+  /**
+   * @brief Gains and limits of the controller, all in Q16.16
+   *
+   */
+  struct settings
+  {
+    /// Proportional gain
+    q16 kp = 0;
+    /// Integral gain, per update
+    q16 ki = 0;
+    /// Derivative gain, per update
+    q16 kd = 0;
+    /// Feedforward gain applied to the setpoint
+    q16 kf = 0;
+    /// Lowest output
+    q16 output_min = to_q16(-1.0f);
+    /// Highest output
+    q16 output_max = to_q16(1.0f);
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator<=>(settings const&) const = default;
+  };
+
+  /**
+   * @brief Construct a controller
+   *
+   * @param p_settings - gains and limits of the controller
+   */
+  constexpr explicit q16_pid(settings const& p_settings)
+    : m_settings(p_settings)
+  {
+  }
+
+  /**
+   * @brief Compute the next output of the controller
+   *
+   * @param p_setpoint - desired value
+   * @param p_measurement - measured value
+   * @return constexpr q16 - output, within the output limits
+   */
+  constexpr q16 update(q16 p_setpoint, q16 p_measurement)
+  {
+    auto const error = i64{ p_setpoint } - p_measurement;
+    auto const minimum = i64{ m_settings.output_min };
+    auto const maximum = i64{ m_settings.output_max };
+
+    auto const integral = m_integral + ((m_settings.ki * error) >> 16);
+    m_integral = std::clamp(integral, minimum, maximum);
+
+    auto derivative = i64{ 0 };
+    if (m_primed) {
+      derivative = (m_settings.kd * (i64{ p_measurement } - m_last)) >> 16;
+    }
+    m_last = p_measurement;
+    m_primed = true;
+
+    auto const proportional = (m_settings.kp * error) >> 16;
+    auto const feedforward = (i64{ m_settings.kf } * p_setpoint) >> 16;
+    auto const output = proportional + m_integral - derivative + feedforward;
+    return static_cast<q16>(std::clamp(output, minimum, maximum));
+  }
+
+  /**
+   * @brief Clear the integral and derivative history
+   *
+   */
+  constexpr void reset()
+  {
+    m_integral = 0;
+    m_last = 0;
+    m_primed = false;
+  }
+
+  /**
+   * @brief Get the gains and limits of the controller
+   *
+   * @return settings const& - settings of the controller
+   */
+  [[nodiscard]] constexpr settings const& configuration() const
+  {
+    return m_settings;
+  }
+
+private:
+  settings m_settings;
+  i64 m_integral = 0;
+  q16 m_last = 0;
+  bool m_primed = false;
+};
+
+/**
+ * @brief Sensor types accepted by control_loop
+ *
+ * Satisfied by `hal::rotation_sensor` and any type with the same `read()`.
+ */
+template<class T>
+concept control_loop_sensor = requires(T& p_sensor) {
+  { p_sensor.read().angle } -> std::convertible_to<float>;
+};
+
+/**
+ * @brief Actuator types accepted by control_loop
+ *
+ * Satisfied by `hal::motor` and any type with the same `power()`.
+ */
+template<class T>
+concept control_loop_actuator = requires(T& p_motor) { p_motor.power(0.0f); };
+
+/**
+ * @brief Timing counters of a control_loop, in ticks of its steady_clock
+ *
+ */
+struct control_loop_statistics
+{
+  /// Number of iterations run
+  u64 iterations = 0;
+  /// Time the latest iteration took to read, compute and apply the output
+  u64 last_duration = 0;
+  /// Longest time an iteration took
+  u64 max_duration = 0;
+  /// Largest difference between the expected and the measured period
+  u64 max_jitter = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(control_loop_statistics const&) const = default;
+};
+
+/**
+ * @brief Closed loop position controller for a motor and rotation sensor
+ *
+ * Runs a `q16_pid` from a `hal::timed_interrupt` at a fixed period: each
+ * iteration reads the sensor's angle in degrees, computes the controller's
+ * output and applies it as the motor's power. The duration of each iteration
+ * and the deviation of each period from the expected period are measured with
+ * a steady clock.
+ *
+ * The sensor and motor types are template parameters, deduced from the
+ * constructor arguments. When given the interface types, each iteration makes
+ * a virtual call to each. When given concrete, `final`, driver types, the
+ * compiler resolves and can inline those calls, specializing the loop to the
+ * hardware.
+ *
+ * Angles are converted to Q16.16, so the setpoint and measured angle must stay
+ * within +/-32767 degrees.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::control_loop loop(encoder, motor, timer, clock, 1ms,
+ *                        { .kp = hal::to_q16(0.01f) });
+ * loop.setpoint(90.0f);
+ * loop.start();
+ * ```
+ *
+ * @tparam Sensor - rotation sensor type
+ * @tparam Motor - motor type
+ */
+template<control_loop_sensor Sensor = hal::rotation_sensor,
+         control_loop_actuator Motor = hal::motor>
+class control_loop
+{
+public:
+  /**
+   * @brief Construct a control loop
+   *
+   * Every reference must outlive this object.
+   *
+   * @param p_sensor - sensor measuring the angle to control
+   * @param p_motor - motor driving the angle
+   * @param p_interrupt - timed interrupt to run the loop from
+   * @param p_clock - clock measuring the loop's timing
+   * @param p_period - time between iterations
+   * @param p_settings - gains and limits of the controller
+   */
+  control_loop(Sensor& p_sensor,
+               Motor& p_motor,
+               hal::timed_interrupt& p_interrupt,
+               hal::steady_clock& p_clock,
+               hal::time_duration p_period,
+               q16_pid::settings const& p_settings)
+    : m_sensor(&p_sensor)
+    , m_motor(&p_motor)
+    , m_interrupt(&p_interrupt)
+    , m_clock(&p_clock)
+    , m_period(p_period)
+    , m_pid(p_settings)
+  {
+    auto const frequency = static_cast<u64>(p_clock.frequency());
+    m_period_ticks =
+      static_cast<u64>(p_period.count()) * frequency / 1'000'000'000;
+  }
+
+  control_loop(control_loop const&) = delete;
+  control_loop& operator=(control_loop const&) = delete;
+  control_loop(control_loop&&) = delete;
+  control_loop& operator=(control_loop&&) = delete;
+
+  ~control_loop()
+  {
+    stop();
+  }
+
+  /**
+   * @brief Set the angle to hold
+   *
+   * @param p_angle - target angle in degrees
+   */
+  void setpoint(degrees p_angle)
+  {
+    m_setpoint = to_q16(p_angle);
+  }
+
+  /**
+   * @brief Start running the loop
+   *
+   * @throws hal::argument_out_of_domain - if the timed interrupt cannot be
+   * scheduled with the period
+   */
+  void start()
+  {
+    m_pid.reset();
+    m_running = true;
+    m_started = false;
+    schedule();
+  }
+
+  /**
+   * @brief Stop running the loop
+   *
+   * The motor keeps the last output applied. Set its power to stop it.
+   */
+  void stop()
+  {
+    m_running = false;
+    m_interrupt->schedule(std::nullopt, m_period);
+  }
+
+  /**
+   * @brief Get the timing counters of the loop
+   *
+   * @return control_loop_statistics - counters since construction
+   */
+  [[nodiscard]] control_loop_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+private:
+  void schedule()
+  {
+    m_interrupt->schedule([this](timed_interrupt::schedule_tag) { run(); },
+                          m_period);
+  }
+
+  void run()
+  {
+    if (not m_running) {
+      return;
+    }
+    auto const start = m_clock->uptime();
+    schedule();
+
+    if (m_started) {
+      auto const interval = start - m_previous_start;
+      auto const jitter = interval > m_period_ticks ? interval - m_period_ticks
+                                                    : m_period_ticks - interval;
+      m_statistics.max_jitter = std::max(m_statistics.max_jitter, jitter);
+    }
+    m_previous_start = start;
+    m_started = true;
+
+    auto const angle = static_cast<float>(m_sensor->read().angle);
+    m_motor->power(from_q16(m_pid.update(m_setpoint, to_q16(angle))));
+
+    auto const duration = m_clock->uptime() - start;
+    m_statistics.iterations++;
+    m_statistics.last_duration = duration;
+    m_statistics.max_duration = std::max(m_statistics.max_duration, duration);
+  }
+
+  Sensor* m_sensor;
+  Motor* m_motor;
+  hal::timed_interrupt* m_interrupt;
+  hal::steady_clock* m_clock;
+  hal::time_duration m_period;
+  q16_pid m_pid;
+  control_loop_statistics m_statistics{};
+  u64 m_period_ticks = 0;
+  u64 m_previous_start = 0;
+  q16 m_setpoint = 0;
+  bool m_running = false;
+  bool m_started = false;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::control_loop;
+using v5::control_loop_statistics;
+using v5::from_q16;
+using v5::q16;
+using v5::q16_pid;
+using v5::to_q16;
+}  // namespace hal
@@ -0,0 +1,289 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "scatter_span.hpp"
+#include "units.hpp"
+
+/**
+ * @file crc.hpp
+ * @brief CRC kernels that consume scatter spans directly
+ *
+ * Every function takes the CRC of the data before it, so a CRC can be
+ * computed one segment at a time, and the scatter span overloads do exactly
+ * that: a header, payload and trailer held in separate buffers are checked
+ * without first being copied into one buffer.
+ *
+ * Two CRCs are provided:
+ *
+ * - CRC-32 (IEEE 802.3, as used by Ethernet, zlib and PNG): reflected
+ *   polynomial 0xEDB88320, initial value and final XOR of 0xFFFFFFFF. The
+ *   check value of "123456789" is 0xCBF43926. Pass 0 as the CRC of no data,
+ *   which is the default.
+ * - CRC-16/CCITT-FALSE: polynomial 0x1021, not reflected, initial value
+ *   0xFFFF, no final XOR. The check value of "123456789" is 0x29B1. Pass 0xFFFF
+ *   as the CRC of no data, which is the default.
+ *
+ * The table driven kernels use a 256 entry table, 1 KiB for CRC-32 and
+ * 512 bytes for CRC-16. `crc32_slice8()` processes 8 bytes per step with
+ * eight tables, 8 KiB, for several times the throughput on cores with a data
+ * cache. Tables are computed at compile time and only linked in if used.
+ *
+ * Example usage:
+ *
+ * ```
+ * auto const frame = hal::make_scatter_bytes(header, payload);
+ * auto const crc = hal::crc32(frame);
+ * ```
+ */
+
+namespace hal::v5 {
+namespace detail {
+/// Reflected polynomial of CRC-32
+inline constexpr u32 crc32_polynomial = 0xEDB8'8320;
+/// Polynomial of CRC-16/CCITT
+inline constexpr u16 crc16_ccitt_polynomial = 0x1021;
+
+constexpr std::array<std::array<u32, 256>, 8> make_crc32_tables()
+{
+  std::array<std::array<u32, 256>, 8> tables{};
+  for (u32 i = 0; i < 256; i++) {
+    u32 crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ ((crc & 1) ? crc32_polynomial : 0);
+    }
+    tables[0][i] = crc;
+  }
+  for (usize slice = 1; slice < tables.size(); slice++) {
+    for (usize i = 0; i < 256; i++) {
+      auto const previous = tables[slice - 1][i];
+      tables[slice][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr std::array<u16, 256> make_crc16_ccitt_table()
+{
+  std::array<u16, 256> table{};
+  for (u32 i = 0; i < 256; i++) {
+    u32 crc = i << 8;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc << 1) ^ ((crc & 0x8000) ? crc16_ccitt_polynomial : 0);
+    }
+    table[i] = static_cast<u16>(crc);
+  }
+  return table;
+}
+
+inline constexpr auto crc32_tables = make_crc32_tables();
+inline constexpr auto crc16_ccitt_table = make_crc16_ccitt_table();
+
+/// Advance a raw (not inverted) CRC-32 register over p_data, a byte at a time
+constexpr u32 crc32_bytes(u32 p_crc, std::span<hal::byte const> p_data)
+{
+  for (auto const data : p_data) {
+    p_crc = (p_crc >> 8) ^ crc32_tables[0][(p_crc ^ data) & 0xFF];
+  }
+  return p_crc;
+}
+
+constexpr u32 load_le32(hal::byte const* p_data)
+{
+  return static_cast<u32>(p_data[0]) | (static_cast<u32>(p_data[1]) << 8) |
+         (static_cast<u32>(p_data[2]) << 16) |
+         (static_cast<u32>(p_data[3]) << 24);
+}
+}  // namespace detail
+
+/**
+ * @brief Calculate the CRC-32 of a buffer with a 256 entry table
+ *
+ * @param p_data - data to calculate the CRC of
+ * @param p_crc - CRC-32 of the data before p_data, 0 if there is none
+ * @return u32 - CRC-32 of the data before and including p_data
+ */
+[[nodiscard]] constexpr u32 crc32(std::span<hal::byte const> p_data,
+                                  u32 p_crc = 0)
+{
+  return ~detail::crc32_bytes(~p_crc, p_data);
+}
+
+/**
+ * @brief Calculate the CRC-32 of every segment of a scatter span, in order,
+ * with a 256 entry table
+ *
+ * @param p_data - data to calculate the CRC of
+ * @param p_crc - CRC-32 of the data before p_data, 0 if there is none
+ * @return u32 - CRC-32 of the data before and including p_data
+ */
+[[nodiscard]] constexpr u32 crc32(scatter_span<hal::byte const> p_data,
+                                  u32 p_crc = 0)
+{
+  u32 crc = ~p_crc;
+  for (auto const& segment : p_data) {
+    crc = detail::crc32_bytes(crc, segment);
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Calculate the CRC-32 of a buffer 8 bytes at a time
+ *
+ * Produces the same result as `crc32()`.
+ *
+ * @param p_data - data to calculate the CRC of
+ * @param p_crc - CRC-32 of the data before p_data, 0 if there is none
+ * @return u32 - CRC-32 of the data before and including p_data
+ */
+[[nodiscard]] constexpr u32 crc32_slice8(std::span<hal::byte const> p_data,
+                                         u32 p_crc = 0)
+{
+  auto const& table = detail::crc32_tables;
+  u32 crc = ~p_crc;
+
+  while (p_data.size() >= 8) {
+    auto const low = crc ^ detail::load_le32(p_data.data());
+    auto const high = detail::load_le32(p_data.data() + 4);
+    crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^
+          table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^
+          table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^
+          table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+    p_data = p_data.subspan(8);
+  }
+
+  return ~detail::crc32_bytes(crc, p_data);
+}
+
+/**
+ * @brief Calculate the CRC-32 of every segment of a scatter span, in order,
+ * 8 bytes at a time
+ *
+ * Produces the same result as `crc32()`.
+ *
+ * @param p_data - data to calculate the CRC of
+ * @param p_crc - CRC-32 of the data before p_data, 0 if there is none
+ * @return u32 - CRC-32 of the data before and including p_data
+ */
+[[nodiscard]] constexpr u32 crc32_slice8(scatter_span<hal::byte const> p_data,
+                                         u32 p_crc = 0)
+{
+  for (auto const& segment : p_data) {
+    p_crc = crc32_slice8(segment, p_crc);
+  }
+  return p_crc;
+}
+
+/**
+ * @brief Calculate the CRC-16/CCITT-FALSE of a buffer with a 256 entry table
+ *
+ * @param p_data - data to calculate the CRC of
+ * @param p_crc - CRC of the data before p_data, 0xFFFF if there is none
+ * @return u16 - CRC of the data before and including p_data
+ */
+[[nodiscard]] constexpr u16 crc16_ccitt(std::span<hal::byte const> p_data,
+                                        u16 p_crc = 0xFFFF)
+{
+  for (auto const data : p_data) {
+    auto const index = ((p_crc >> 8) ^ data) & 0xFF;
+    p_crc = static_cast<u16>((p_crc << 8) ^ detail::crc16_ccitt_table[index]);
+  }
+  return p_crc;
+}
+
+/**
+ * @brief Calculate the CRC-16/CCITT-FALSE of every segment of a scatter span,
+ * in order, with a 256 entry table
+ *
+ * @param p_data - data to calculate the CRC of
+ * @param p_crc - CRC of the data before p_data, 0xFFFF if there is none
+ * @return u16 - CRC of the data before and including p_data
+ */
+[[nodiscard]] constexpr u16 crc16_ccitt(scatter_span<hal::byte const> p_data,
+                                        u16 p_crc = 0xFFFF)
+{
+  for (auto const& segment : p_data) {
+    p_crc = crc16_ccitt(segment, p_crc);
+  }
+  return p_crc;
+}
+
+/**
+ * @brief Hardware abstract interface for a CRC-32 calculation unit
+ *
+ * Implemented by drivers of CRC peripherals, which typically calculate a CRC
+ * faster than software and without the tables, often by DMA. The unit must
+ * produce the same results as `hal::crc32()`, including continuing from the
+ * CRC passed in, so results from hardware and software can be mixed.
+ */
+class crc32_engine
+{
+public:
+  /**
+   * @brief Calculate the CRC-32 of a buffer
+   *
+   * @param p_data - data to calculate the CRC of
+   * @param p_crc - CRC-32 of the data before p_data, 0 if there is none
+   * @return u32 - CRC-32 of the data before and including p_data
+   */
+  [[nodiscard]] u32 calculate(std::span<hal::byte const> p_data, u32 p_crc = 0)
+  {
+    return driver_calculate(p_data, p_crc);
+  }
+
+  /**
+   * @brief Calculate the CRC-32 of every segment of a scatter span, in order
+   *
+   * The default implementation calculates each non-empty segment in turn.
+   * Drivers that can chain DMA descriptors should override this.
+   *
+   * @param p_data - data to calculate the CRC of
+   * @param p_crc - CRC-32 of the data before p_data, 0 if there is none
+   * @return u32 - CRC-32 of the data before and including p_data
+   */
+  [[nodiscard]] u32 calculate(scatter_span<hal::byte const> p_data,
+                              u32 p_crc = 0)
+  {
+    return driver_calculate_scatter(p_data, p_crc);
+  }
+
+  virtual ~crc32_engine() = default;
+
+private:
+  virtual u32 driver_calculate(std::span<hal::byte const> p_data,
+                               u32 p_crc) = 0;
+
+  virtual u32 driver_calculate_scatter(scatter_span<hal::byte const> p_data,
+                                       u32 p_crc)
+  {
+    for (auto const& segment : p_data) {
+      if (not segment.empty()) {
+        p_crc = driver_calculate(segment, p_crc);
+      }
+    }
+    return p_crc;
+  }
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::crc16_ccitt;
+using v5::crc32;
+using v5::crc32_engine;
+using v5::crc32_slice8;
+}  // namespace hal
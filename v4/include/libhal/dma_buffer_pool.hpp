@@ -0,0 +1,194 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <memory_resource>
+#include <span>
+
+#include "cache_maintenance.hpp"
+#include "error.hpp"
+#include "pointers.hpp"
+#include "pool_resource.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief A fixed capacity, DMA aligned buffer handed out by a
+ * `dma_buffer_pool`
+ *
+ * Storage is padded to a whole number of Alignment sized blocks, so with the
+ * default alignment a buffer never shares a cache line with its neighbours and
+ * can be maintained with `hal::invalidate_received()`.
+ *
+ * @tparam Capacity - number of bytes the buffer can hold
+ * @tparam Alignment - alignment of the buffer's storage
+ */
+template<usize Capacity, usize Alignment = dma_alignment>
+struct dma_buffer
+{
+  /// Storage of the buffer, aligned for DMA and padded to the alignment
+  alignas(Alignment) std::array<hal::byte,
+                                (Capacity + Alignment - 1) / Alignment *
+                                  Alignment> storage{};
+  /// Number of bytes at the start of storage that hold data
+  usize size = 0;
+
+  /**
+   * @brief Get the bytes that hold data
+   *
+   * @return std::span<hal::byte const> - the first `size` bytes of storage
+   */
+  [[nodiscard]] std::span<hal::byte const> data() const
+  {
+    return std::span(storage).first(size);
+  }
+
+  /**
+   * @brief Mark the first bytes of storage as holding data
+   *
+   * Called by the receiver once it has filled the buffer.
+   *
+   * @param p_size - number of bytes filled
+   * @throws hal::argument_out_of_domain - if p_size exceeds the capacity
+   */
+  void fill(usize p_size)
+  {
+    if (p_size > Capacity) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    size = p_size;
+  }
+};
+
+/**
+ * @brief Pool of DMA buffers shared between drivers by reference counting
+ *
+ * Forwarding data from one driver to another, such as from a CAN bus to a
+ * UART, usually copies it twice: out of the receiving driver's buffer and
+ * into the sending driver's. With a buffer pool the receiver fills a buffer
+ * from the pool and hands the `strong_ptr` to the sender, which transmits
+ * straight out of it. The buffer returns to the pool when the last
+ * `strong_ptr` to it is released, typically once the transmission completes.
+ *
+ * When every buffer is in use, `try_acquire()` returns an empty
+ * `optional_ptr`, which receivers use to apply backpressure, for example by
+ * leaving data in the hardware FIFO or NAKing the USB host, rather than
+ * blocking or dropping data they have already received.
+ *
+ * Buffers live within the pool object, so a pool declared `static` never
+ * touches the heap. Like `hal::pool_resource`, the pool is not thread safe:
+ * acquire and release buffers from one context, or guard the pool with a
+ * lock. The pool must outlive every buffer acquired from it.
+ *
+ * Example usage:
+ *
+ * ```
+ * static hal::dma_buffer_pool<64, 8> pool;
+ *
+ * // Receive side
+ * auto buffer = pool.try_acquire();
+ * if (not buffer) {
+ *   return;  // Pool is dry, leave the data in the peripheral for now
+ * }
+ * auto const received = can_frame_bytes(buffer.value()->storage);
+ * buffer.value()->fill(received);
+ * pending.push(buffer.value());
+ *
+ * // Send side
+ * auto const& next = pending.front();
+ * uart.write(next->data());
+ * pending.pop();  // Releases the buffer back to the pool
+ * ```
+ *
+ * @tparam BufferSize - capacity, in bytes, of each buffer
+ * @tparam Count - number of buffers in the pool
+ * @tparam Alignment - alignment of each buffer's storage
+ */
+template<usize BufferSize, usize Count, usize Alignment = dma_alignment>
+class dma_buffer_pool
+{
+public:
+  /// Type of the buffers handed out by the pool
+  using buffer = dma_buffer<BufferSize, Alignment>;
+
+  dma_buffer_pool() = default;
+  dma_buffer_pool(dma_buffer_pool const&) = delete;
+  dma_buffer_pool& operator=(dma_buffer_pool const&) = delete;
+  dma_buffer_pool(dma_buffer_pool&&) = delete;
+  dma_buffer_pool& operator=(dma_buffer_pool&&) = delete;
+  ~dma_buffer_pool() = default;
+
+  /**
+   * @brief Acquire an empty buffer if one is available
+   *
+   * @return optional_ptr<buffer> - a buffer with a size of 0, or empty if
+   * every buffer is in use
+   */
+  [[nodiscard]] optional_ptr<buffer> try_acquire()
+  {
+    if (available() == 0) {
+      return nullptr;
+    }
+    return make_strong_ptr<buffer>(&m_resource);
+  }
+
+  /**
+   * @brief Acquire an empty buffer
+   *
+   * @return strong_ptr<buffer> - a buffer with a size of 0
+   * @throws std::bad_alloc - if every buffer is in use
+   */
+  [[nodiscard]] strong_ptr<buffer> acquire()
+  {
+    return make_strong_ptr<buffer>(&m_resource);
+  }
+
+  /**
+   * @brief Get the number of buffers that can be acquired
+   *
+   * @return usize - buffers not in use
+   */
+  [[nodiscard]] usize available() const
+  {
+    return Count - m_resource.statistics().in_use;
+  }
+
+  /**
+   * @brief Get the usage counters of the pool
+   *
+   * Failures count calls to `acquire()` made while every buffer was in use.
+   *
+   * @return pool_statistics - current usage counters
+   */
+  [[nodiscard]] pool_statistics statistics() const
+  {
+    return m_resource.statistics();
+  }
+
+private:
+  using block = detail::rc<buffer>;
+
+  pool_resource<sizeof(block),
+                Count,
+                std::max(alignof(block), alignof(std::max_align_t))>
+    m_resource;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::dma_buffer;
+using v5::dma_buffer_pool;
+}  // namespace hal
@@ -0,0 +1,186 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <span>
+
+#include "interrupt_pin.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief An edge recorded by a `hal::edge_capture` driver
+ *
+ */
+struct edge_event
+{
+  /// Tick count of the capture timer when the edge occurred. Wraps at the
+  /// maximum of u32, so durations are computed with unsigned subtraction of
+  /// two timestamps.
+  u32 timestamp = 0;
+  /// Level of the pin after the edge, true for HIGH and false for LOW
+  bool level = false;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(edge_event const&) const = default;
+};
+
+/**
+ * @brief Timestamped edge capture hardware abstraction
+ *
+ * `hal::interrupt_pin` calls a handler per edge without timing information,
+ * so measuring edges requires reading a clock from the interrupt, which adds
+ * latency jitter and costs CPU time per edge. Drivers of this interface latch
+ * the time of each edge in hardware, usually with the input capture channel of
+ * a timer, and write each `edge_event` into a circular buffer in memory,
+ * usually with DMA, without CPU intervention. This mirrors the receive side of
+ * `hal::zero_copy_serial`: the application supplies the circular buffer to the
+ * driver at construction, `receive_buffer()` exposes it, and
+ * `receive_cursor()` reports where the next event will be written. Edge trains
+ * of 100kHz and above can then be processed in batches, such as computing the
+ * speed of an encoder or the rate of a flow meter.
+ *
+ * Example usage:
+ *
+ * ```
+ * capture.configure({ .trigger = hal::interrupt_pin::trigger_edge::rising });
+ * auto last = capture.receive_cursor();
+ *
+ * while (true) {
+ *   auto const buffer = capture.receive_buffer();
+ *   auto const cursor = capture.receive_cursor();
+ *   for (auto i = last; i != cursor; i = (i + 1) % buffer.size()) {
+ *     period.feed(buffer[i].timestamp);
+ *   }
+ *   last = cursor;
+ * }
+ * ```
+ */
+class edge_capture
+{
+public:
+  /**
+   * @brief Generic settings for edge capture
+   *
+   */
+  struct settings
+  {
+    /// Pull resistor for the capture pin
+    pin_resistor resistor = pin_resistor::pull_up;
+
+    /// Edges to record
+    interrupt_pin::trigger_edge trigger = interrupt_pin::trigger_edge::both;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator<=>(settings const&) const = default;
+  };
+
+  /**
+   * @brief Configure the capture pin and start recording edges
+   *
+   * Edges are recorded until the driver is destroyed or reconfigured. The
+   * cursor is not reset by reconfiguring.
+   *
+   * @param p_settings - settings to apply to the capture pin
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  void configure(settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Get the tick rate of the capture timer
+   *
+   * @return hertz - rate at which the timestamps of edge events increase.
+   * Guaranteed to be a positive value and not to change after construction.
+   */
+  [[nodiscard]] hertz frequency()
+  {
+    return driver_frequency();
+  }
+
+  /**
+   * @brief Returns the circular receive buffer of edge events
+   *
+   * The buffer is supplied by the application when the driver is constructed
+   * and is written to continuously by the driver.
+   *
+   * @return std::span<edge_event const> - the receive buffer
+   */
+  [[nodiscard]] std::span<edge_event const> receive_buffer()
+  {
+    return driver_receive_buffer();
+  }
+
+  /**
+   * @brief Returns the position where the next edge event will be written
+   *
+   * Events before the cursor, back to the data last consumed by the
+   * application, are complete and can be read in place. The cursor wraps
+   * around to 0 at the end of the receive buffer.
+   *
+   * @return usize - position of the write cursor within the receive buffer
+   */
+  [[nodiscard]] usize receive_cursor()
+  {
+    return driver_cursor();
+  }
+
+  /**
+   * @brief Returns the total number of edges recorded since configuration
+   *
+   * The count wraps at the maximum of `usize`. The difference between two
+   * counts reveals whether more than a buffer's worth of events arrived
+   * between two reads, meaning the driver has lapped the reader and events
+   * were lost.
+   *
+   * Support for this is optional. Drivers that do not count events return
+   * `std::nullopt`.
+   *
+   * @return std::optional<usize> - running count of events or std::nullopt if
+   * the driver does not count events.
+   */
+  [[nodiscard]] std::optional<usize> receive_count()
+  {
+    return driver_receive_count();
+  }
+
+  virtual ~edge_capture() = default;
+
+private:
+  virtual void driver_configure(settings const& p_settings) = 0;
+  virtual hertz driver_frequency() = 0;
+  virtual std::span<edge_event const> driver_receive_buffer() = 0;
+  virtual usize driver_cursor() = 0;
+  virtual std::optional<usize> driver_receive_count()
+  {
+    return std::nullopt;
+  }
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::edge_capture;
+using v5::edge_event;
+}  // namespace hal
@@ -86,6 +86,46 @@ private:
   u32 m_reserved3{};
 };
 
+/**
+ * @ingroup Error
+ * @brief Function called whenever a hal::exception is constructed
+ *
+ * Called with the context registered with `set_exception_hook()`, the error
+ * code and the instance address of the exception. Called from the exception's
+ * constructor, so it must not throw.
+ */
+using exception_hook = void (*)(void* p_context,
+                                std::errc p_error_code,
+                                void const* p_instance);
+
+namespace detail {
+struct exception_hook_registration
+{
+  exception_hook hook = nullptr;
+  void* context = nullptr;
+};
+
+inline exception_hook_registration exception_hook_registered{};
+}  // namespace detail
+
+/**
+ * @ingroup Error
+ * @brief Register a function to call whenever a hal::exception is constructed
+ *
+ * This is the instrumentation point for counting and timing exceptions, see
+ * `hal::exception_trace`. No hook is registered by default, in which case
+ * constructing an exception costs a single check. Register the hook before
+ * any interrupt or thread could construct an exception.
+ *
+ * @param p_hook - function to call, or nullptr to remove the registered hook
+ * @param p_context - pointer to pass to p_hook
+ */
+inline void set_exception_hook(exception_hook p_hook,
+                               void* p_context = nullptr)
+{
+  detail::exception_hook_registered = { .hook = p_hook, .context = p_context };
+}
+
 /**
  * @ingroup Error
  * @brief Base exception class for all hal related exceptions
@@ -98,6 +138,12 @@ public:
     : m_instance(p_instance)
     , m_error_code(p_error_code)
   {
+    if (not std::is_constant_evaluated()) {
+      auto const& registered = detail::exception_hook_registered;
+      if (registered.hook) {
+        registered.hook(registered.context, p_error_code, p_instance);
+      }
+    }
     static_cast<void>(m_reserved0);
     static_cast<void>(m_reserved1);
     static_cast<void>(m_reserved2);
@@ -682,4 +728,34 @@ template<class thrown_t>
                 "thrown by a libhal library.");
   throw p_thrown_object;
 }
+
+/**
+ * @ingroup Error
+ * @brief Call a function and return the error code of the hal::exception it
+ * throws, if any
+ *
+ * Used by the default implementations of the result returning APIs, such as
+ * `hal::i2c::try_transaction()`, to report the errors of drivers that only
+ * throw. Exceptions without an error code, such as `hal::unknown`, are
+ * reported as `std::errc::io_error` so they are not mistaken for success.
+ * Exceptions not derived from hal::exception propagate.
+ *
+ * @tparam Callable - type of the function to call
+ * @param p_callable - function to call with no arguments
+ * @return std::errc - `std::errc{}` if p_callable returned, otherwise the
+ * error code of the exception it threw
+ */
+template<class Callable>
+[[nodiscard]] std::errc catch_error_code(Callable&& p_callable)
+{
+  try {
+    p_callable();
+  } catch (hal::exception const& p_error) {
+    if (p_error.error_code() == std::errc{}) {
+      return std::errc::io_error;
+    }
+    return p_error.error_code();
+  }
+  return std::errc{};
+}
 }  // namespace hal
@@ -0,0 +1,334 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <span>
+
+#include "functional.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/// Number of bytes each event occupies on the wire
+inline constexpr usize trace_event_size = 8;
+
+/// Event id reserved for the events `event_trace::drain()` emits to report
+/// events that were dropped because the ring was full. The payload holds the
+/// number of events dropped, saturated at 0xFFFF.
+inline constexpr u16 trace_dropped_id = 0xFFFF;
+
+/**
+ * @brief One event as recorded on the device
+ *
+ * On the wire, each event is `trace_event_size` bytes in little endian: the
+ * timestamp, then the id, then the payload.
+ */
+struct trace_event
+{
+  /// Lower 32 bits of the steady clock's uptime when the event was recorded
+  u32 timestamp = 0;
+  /// Application defined identifier of the event
+  u16 id = 0;
+  /// Application defined data of the event
+  u16 payload = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(trace_event const&) const = default;
+};
+
+/**
+ * @brief Record compact binary events into a lock free ring and drain them
+ * to a byte stream
+ *
+ * Text logging in hot paths costs far more than the code being observed. This
+ * trace records a 16-bit event id, a 16-bit payload and a timestamp, in a few
+ * atomic operations and a read of the steady clock, so interrupt entry and
+ * exit and driver calls can be traced without changing their timing much.
+ *
+ * Events may be recorded from any number of threads and interrupts of the
+ * core that owns the trace. Use one trace per core on multicore devices, so
+ * the cores never contend for the same ring. When the ring is full, new events
+ * are dropped rather than overwriting events that may be being drained, and
+ * the next drain reports how many were lost with a `trace_dropped_id` event.
+ *
+ * A single context, usually a background loop, drains the events into a byte
+ * buffer which is then transmitted with any byte stream. The stream is decoded
+ * on the host with `trace_decoder`.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::event_trace<256> trace(clock);
+ *
+ * void uart_isr() {
+ *   trace.record(event::uart_isr_enter);
+ *   // ...
+ *   trace.record(event::uart_isr_exit, received);
+ * }
+ *
+ * // Background loop
+ * std::array<hal::byte, 64 * hal::trace_event_size> staging{};
+ * while (true) {
+ *   auto const data = trace.drain(staging);
+ *   serial.write(data);  // hal::zero_copy_serial
+ *   // or: stream.write(hal::make_scatter_bytes(data));  // usb::bulk_stream
+ * }
+ * ```
+ *
+ * @tparam Capacity - number of events the ring holds, must be a power of two
+ */
+template<usize Capacity>
+class event_trace
+{
+public:
+  static_assert(std::has_single_bit(Capacity),
+                "Capacity must be a power of two");
+  static_assert(std::atomic<u32>::is_always_lock_free,
+                "event_trace requires lock free atomic indices");
+
+  /**
+   * @brief Construct an empty trace
+   *
+   * @param p_clock - clock to timestamp events with. Must outlive this object.
+   */
+  explicit event_trace(hal::steady_clock& p_clock)
+    : m_clock(&p_clock)
+  {
+  }
+
+  event_trace(event_trace const&) = delete;
+  event_trace& operator=(event_trace const&) = delete;
+  event_trace(event_trace&&) = delete;
+  event_trace& operator=(event_trace&&) = delete;
+  ~event_trace() = default;
+
+  /**
+   * @brief Record an event
+   *
+   * Lock free and safe to call from interrupts.
+   *
+   * @param p_id - identifier of the event. `trace_dropped_id` is reserved.
+   * @param p_payload - data to record with the event
+   * @return true - if the event was recorded
+   * @return false - if the ring was full and the event was dropped
+   */
+  bool record(u16 p_id, u16 p_payload = 0)
+  {
+    auto const timestamp = static_cast<u32>(m_clock->uptime());
+    auto head = m_head.load(std::memory_order_relaxed);
+    do {
+      if (head - m_tail.load(std::memory_order_acquire) >= Capacity) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (not m_head.compare_exchange_weak(
+      head, head + 1, std::memory_order_relaxed));
+
+    auto& claimed = m_slots[head & (Capacity - 1)];
+    claimed.event = {
+      .timestamp = timestamp,
+      .id = p_id,
+      .payload = p_payload,
+    };
+    claimed.sequence.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Move recorded events into a buffer in their wire format
+   *
+   * Encodes as many whole events as fit into the buffer, oldest first,
+   * preceded by a `trace_dropped_id` event if events were dropped since the
+   * last drain. Stops early at an event that is still being recorded, which is
+   * drained by the next call. Must only be called from one context at a time.
+   *
+   * @param p_buffer - buffer to encode events into
+   * @return std::span<hal::byte const> - the filled portion of p_buffer, a
+   * multiple of `trace_event_size` bytes
+   */
+  std::span<hal::byte const> drain(std::span<hal::byte> p_buffer)
+  {
+    usize filled = 0;
+    auto const room = [&]() {
+      return p_buffer.size() - filled >= trace_event_size;
+    };
+
+    auto const dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_dropped_reported && room()) {
+      auto const lost = std::min<u32>(dropped - m_dropped_reported, 0xFFFF);
+      encode(p_buffer.subspan(filled),
+             {
+               .timestamp = static_cast<u32>(m_clock->uptime()),
+               .id = trace_dropped_id,
+               .payload = static_cast<u16>(lost),
+             });
+      filled += trace_event_size;
+      m_dropped_reported += lost;
+    }
+
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    while (room()) {
+      auto const& next = m_slots[tail & (Capacity - 1)];
+      if (next.sequence.load(std::memory_order_acquire) != tail + 1) {
+        break;
+      }
+      encode(p_buffer.subspan(filled), next.event);
+      filled += trace_event_size;
+      tail++;
+      m_tail.store(tail, std::memory_order_release);
+    }
+    return p_buffer.first(filled);
+  }
+
+  /**
+   * @brief Get the number of events dropped because the ring was full
+   *
+   * The count wraps at the maximum of a u32.
+   *
+   * @return u32 - events dropped since construction
+   */
+  [[nodiscard]] u32 dropped() const
+  {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct slot
+  {
+    std::atomic<u32> sequence = 0;
+    trace_event event{};
+  };
+
+  static void encode(std::span<hal::byte> p_destination,
+                     trace_event const& p_event)
+  {
+    p_destination[0] = static_cast<hal::byte>(p_event.timestamp);
+    p_destination[1] = static_cast<hal::byte>(p_event.timestamp >> 8);
+    p_destination[2] = static_cast<hal::byte>(p_event.timestamp >> 16);
+    p_destination[3] = static_cast<hal::byte>(p_event.timestamp >> 24);
+    p_destination[4] = static_cast<hal::byte>(p_event.id);
+    p_destination[5] = static_cast<hal::byte>(p_event.id >> 8);
+    p_destination[6] = static_cast<hal::byte>(p_event.payload);
+    p_destination[7] = static_cast<hal::byte>(p_event.payload >> 8);
+  }
+
+  hal::steady_clock* m_clock;
+  std::array<slot, Capacity> m_slots{};
+  std::atomic<u32> m_head = 0;
+  std::atomic<u32> m_tail = 0;
+  std::atomic<u32> m_dropped = 0;
+  u32 m_dropped_reported = 0;
+};
+
+/**
+ * @brief One event as decoded on the host
+ *
+ */
+struct decoded_trace_event
+{
+  /// Ticks of the device's steady clock, extended to 64 bits starting from
+  /// the 32-bit timestamp of the first decoded event
+  u64 timestamp = 0;
+  /// Application defined identifier of the event
+  u16 id = 0;
+  /// Application defined data of the event
+  u16 payload = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(decoded_trace_event const&) const = default;
+};
+
+/**
+ * @brief Decode the byte stream drained from an `event_trace`
+ *
+ * Meant for host tools reading the stream from a serial port or USB device.
+ * Data can be fed in chunks of any size, as events split across chunks are
+ * reassembled. The stream must start on an event boundary, which is the case
+ * for the output of `event_trace::drain()`.
+ *
+ * Timestamps are extended to 64 bits by accumulating the signed difference
+ * between consecutive 32-bit timestamps, so events recorded out of order by
+ * preempting interrupts keep their true order, as long as consecutive events
+ * are less than 2^31 ticks apart.
+ */
+class trace_decoder
+{
+public:
+  /// Called for each decoded event
+  using handler = void(decoded_trace_event const& p_event);
+
+  /**
+   * @brief Decode a chunk of the stream
+   *
+   * @param p_data - next bytes of the stream
+   * @param p_handler - called for each event completed by p_data, in order
+   */
+  void feed(std::span<hal::byte const> p_data,
+            hal::function_ref<handler> p_handler)
+  {
+    for (auto const data : p_data) {
+      m_partial[m_partial_size++] = data;
+      if (m_partial_size < trace_event_size) {
+        continue;
+      }
+      m_partial_size = 0;
+
+      auto const timestamp = static_cast<u32>(
+        m_partial[0] | (m_partial[1] << 8) | (m_partial[2] << 16) |
+        (static_cast<u32>(m_partial[3]) << 24));
+      if (not m_started) {
+        m_started = true;
+        m_timestamp = timestamp;
+      } else {
+        auto const delta = static_cast<i32>(timestamp - m_last);
+        m_timestamp += static_cast<u64>(static_cast<i64>(delta));
+      }
+      m_last = timestamp;
+
+      p_handler({
+        .timestamp = m_timestamp,
+        .id = static_cast<u16>(m_partial[4] | (m_partial[5] << 8)),
+        .payload = static_cast<u16>(m_partial[6] | (m_partial[7] << 8)),
+      });
+    }
+  }
+
+private:
+  std::array<hal::byte, trace_event_size> m_partial{};
+  usize m_partial_size = 0;
+  u64 m_timestamp = 0;
+  u32 m_last = 0;
+  bool m_started = false;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::decoded_trace_event;
+using v5::event_trace;
+using v5::trace_decoder;
+using v5::trace_dropped_id;
+using v5::trace_event;
+using v5::trace_event_size;
+}  // namespace hal
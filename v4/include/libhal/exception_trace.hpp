@@ -0,0 +1,209 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <span>
+#include <system_error>
+
+#include "error.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief One constructed hal::exception
+ *
+ */
+struct exception_record
+{
+  /// Error code of the exception
+  std::errc error_code{};
+  /// Instance address of the exception
+  void const* instance = nullptr;
+  /// Uptime of the trace's steady clock when the exception was constructed
+  u64 timestamp = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(exception_record const&) const = default;
+};
+
+/**
+ * @brief Record every hal::exception constructed into a ring buffer
+ *
+ * Registers an exception hook (see `hal::set_exception_hook()`) that records
+ * the error code, instance address and a timestamp of each exception, so hot
+ * error paths can be found on a running system and converted to non-throwing
+ * APIs. Once the ring is full, each new record overwrites the oldest.
+ *
+ * Recording is lock free: each record claims a slot with a single atomic
+ * increment, so exceptions constructed from interrupts and threads never
+ * block or lose their slot. A reader that copies records while exceptions
+ * are being constructed may copy a record that is being overwritten.
+ *
+ * Only one trace can be installed at a time, as there is a single exception
+ * hook.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::exception_trace<32> trace(clock);
+ * trace.install();
+ * // ... run the application ...
+ * for (auto const& record : trace.records()) {
+ *   log(record.error_code, record.instance, record.timestamp);
+ * }
+ * ```
+ *
+ * @tparam Capacity - number of records kept, must be a power of two
+ */
+template<usize Capacity>
+class exception_trace
+{
+public:
+  static_assert(std::has_single_bit(Capacity),
+                "Capacity must be a power of two");
+  static_assert(std::atomic<u32>::is_always_lock_free,
+                "exception_trace requires a lock free atomic counter");
+
+  /**
+   * @brief Construct a trace, without installing it
+   *
+   * @param p_clock - clock to timestamp records with. Must outlive this
+   * object.
+   */
+  explicit exception_trace(hal::steady_clock& p_clock)
+    : m_clock(&p_clock)
+  {
+  }
+
+  exception_trace(exception_trace const&) = delete;
+  exception_trace& operator=(exception_trace const&) = delete;
+  exception_trace(exception_trace&&) = delete;
+  exception_trace& operator=(exception_trace&&) = delete;
+
+  ~exception_trace()
+  {
+    if (installed()) {
+      uninstall();
+    }
+  }
+
+  /**
+   * @brief Start recording exceptions, replacing any registered hook
+   *
+   */
+  void install()
+  {
+    hal::set_exception_hook(&exception_trace::hook, this);
+  }
+
+  /**
+   * @brief Stop recording exceptions by removing the registered hook
+   *
+   */
+  void uninstall()
+  {
+    hal::set_exception_hook(nullptr);
+  }
+
+  /**
+   * @brief Determine if this trace is the registered exception hook
+   *
+   * @return true - if exceptions are recorded into this trace
+   */
+  [[nodiscard]] bool installed() const
+  {
+    return hal::detail::exception_hook_registered.context == this;
+  }
+
+  /**
+   * @brief Record an exception
+   *
+   * Called by the hook for every exception constructed while installed.
+   *
+   * @param p_error_code - error code of the exception
+   * @param p_instance - instance address of the exception
+   */
+  void record(std::errc p_error_code, void const* p_instance)
+  {
+    auto const index = m_recorded.fetch_add(1, std::memory_order_relaxed);
+    m_records[index & (Capacity - 1)] = {
+      .error_code = p_error_code,
+      .instance = p_instance,
+      .timestamp = m_clock->uptime(),
+    };
+  }
+
+  /**
+   * @brief Get the number of exceptions recorded
+   *
+   * Counts every record, including those overwritten. The count wraps at the
+   * maximum of a u32.
+   *
+   * @return u32 - exceptions recorded since construction
+   */
+  [[nodiscard]] u32 recorded() const
+  {
+    return m_recorded.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the ring of records
+   *
+   * Records are in slot order: once more than `Capacity` exceptions have been
+   * recorded, the oldest is at index `recorded() % Capacity`. Slots that were
+   * never written contain a default constructed record.
+   *
+   * @return std::span<exception_record const, Capacity> - every slot
+   */
+  [[nodiscard]] std::span<exception_record const, Capacity> records() const
+  {
+    return m_records;
+  }
+
+  /**
+   * @brief Discard every record
+   *
+   */
+  void clear()
+  {
+    m_records.fill({});
+    m_recorded.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  static void hook(void* p_context,
+                   std::errc p_error_code,
+                   void const* p_instance)
+  {
+    static_cast<exception_trace*>(p_context)->record(p_error_code, p_instance);
+  }
+
+  hal::steady_clock* m_clock;
+  std::array<exception_record, Capacity> m_records{};
+  std::atomic<u32> m_recorded = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::exception_record;
+using v5::exception_trace;
+}  // namespace hal
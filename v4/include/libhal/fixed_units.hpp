@@ -0,0 +1,370 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <ratio>
+
+#include "units.hpp"
+
+/**
+ * @file fixed_units.hpp
+ * @brief Strongly typed, integer represented units
+ *
+ * The units of units.hpp, such as `hal::volts` and `hal::celsius`, are `float`
+ * aliases, which cost a soft-float call per operation on MCUs without an FPU
+ * and let volts be added to amps. `hal::quantity` stores a value as an integer
+ * count of a fixed scale, for example `hal::millivolts` is an `i32` count of
+ * 1/1000 volts, and only allows operations between quantities of the same
+ * dimension. Conversions between scales are the ratio of the two scales, which
+ * is reduced at compile time to a single integer multiply and divide.
+ *
+ * Like `std::chrono::duration`, conversions that cannot lose precision, such
+ * as millivolts to microvolts, are implicit, and the others need
+ * `hal::quantity_cast()`, which truncates toward zero. `to_float()` and
+ * `from_float()` convert to and from the float units at the boundary with
+ * float based interfaces.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::millivolts const reference{ 3300 };
+ * // 12-bit ADC reading to millivolts without any float math
+ * hal::millivolts const reading = hal::mul_div(reference, raw, 4095);
+ * hal::microvolts const precise = reading;  // Implicit, lossless
+ * auto const volts = hal::to_float(reading);  // hal::volts for v4 APIs
+ * ```
+ */
+
+namespace hal::v5 {
+/**
+ * @brief Tag types naming the dimension of a quantity
+ *
+ * Quantities of different dimensions cannot be mixed. The base unit of each
+ * dimension is the unit of the float alias of the same name in units.hpp.
+ */
+namespace dimension {
+/// Base unit of volts, as `hal::volts`
+struct voltage
+{};
+/// Base unit of amperes, as `hal::ampere`
+struct current
+{};
+/// Base unit of degrees Celsius, as `hal::celsius`
+struct temperature
+{};
+/// Base unit of hertz, as `hal::hertz`
+struct frequency
+{};
+/// Base unit of revolutions per minute, as `hal::rpm`
+struct angular_velocity
+{};
+/// Base unit of meters, as `hal::meters`
+struct length
+{};
+/// Base unit of degrees, as `hal::degrees`
+struct angle
+{};
+/// Base unit of standard gravity, as `hal::g_force`
+struct acceleration
+{};
+}  // namespace dimension
+
+namespace detail {
+template<typename T>
+struct is_ratio : std::false_type
+{};
+
+template<std::intmax_t Num, std::intmax_t Den>
+struct is_ratio<std::ratio<Num, Den>> : std::true_type
+{};
+}  // namespace detail
+
+/**
+ * @brief An integer count of a fixed scale of a unit
+ *
+ * @tparam Rep - signed or unsigned integer type holding the count
+ * @tparam Dimension - tag type from `hal::dimension`
+ * @tparam Scale - `std::ratio` of the base unit that one count represents,
+ * such as `std::milli` for millivolts
+ */
+template<std::integral Rep, typename Dimension, typename Scale = std::ratio<1>>
+class quantity
+{
+public:
+  static_assert(detail::is_ratio<Scale>::value, "Scale must be a std::ratio");
+  static_assert(Scale::num > 0, "Scale must be positive");
+
+  /// Type of the count
+  using rep = Rep;
+  /// Dimension tag of the quantity
+  using dimension_type = Dimension;
+  /// Fraction of the base unit that one count represents
+  using scale = typename Scale::type;
+
+  /**
+   * @brief Construct a quantity of 0
+   *
+   */
+  constexpr quantity() = default;
+
+  /**
+   * @brief Construct a quantity from a count
+   *
+   * @param p_count - number of `scale` sized steps
+   */
+  constexpr explicit quantity(Rep p_count)
+    : m_count(p_count)
+  {
+  }
+
+  /**
+   * @brief Convert, without loss, from a coarser scale of the same dimension
+   *
+   * Only available when the source scale is a whole multiple of this scale,
+   * such as millivolts to microvolts. Use `hal::quantity_cast()` otherwise.
+   *
+   * @param p_other - quantity to convert
+   */
+  template<std::integral OtherRep, typename OtherScale>
+    requires(std::ratio_divide<OtherScale, Scale>::den == 1)
+  constexpr quantity(quantity<OtherRep, Dimension, OtherScale> p_other)
+    : m_count(static_cast<Rep>(static_cast<std::intmax_t>(p_other.count()) *
+                               std::ratio_divide<OtherScale, Scale>::num))
+  {
+  }
+
+  /**
+   * @brief Get the count
+   *
+   * @return constexpr Rep - number of `scale` sized steps
+   */
+  [[nodiscard]] constexpr Rep count() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @brief Enables default comparison and ordering
+   *
+   */
+  constexpr auto operator<=>(quantity const&) const = default;
+
+  constexpr quantity& operator+=(quantity p_other)
+  {
+    m_count = static_cast<Rep>(m_count + p_other.m_count);
+    return *this;
+  }
+
+  constexpr quantity& operator-=(quantity p_other)
+  {
+    m_count = static_cast<Rep>(m_count - p_other.m_count);
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr quantity operator+(quantity p_lhs,
+                                                    quantity p_rhs)
+  {
+    return p_lhs += p_rhs;
+  }
+
+  [[nodiscard]] friend constexpr quantity operator-(quantity p_lhs,
+                                                    quantity p_rhs)
+  {
+    return p_lhs -= p_rhs;
+  }
+
+  [[nodiscard]] constexpr quantity operator-() const
+  {
+    return quantity(static_cast<Rep>(-m_count));
+  }
+
+  /**
+   * @brief Scale a quantity by an integer
+   *
+   * The product must fit in Rep. Use `hal::mul_div()` to scale by a
+   * fraction.
+   */
+  template<std::integral Factor>
+  [[nodiscard]] friend constexpr quantity operator*(quantity p_lhs,
+                                                    Factor p_rhs)
+  {
+    auto const product = static_cast<std::intmax_t>(p_lhs.m_count) *
+                         static_cast<std::intmax_t>(p_rhs);
+    return quantity(static_cast<Rep>(product));
+  }
+
+  template<std::integral Factor>
+  [[nodiscard]] friend constexpr quantity operator*(Factor p_lhs,
+                                                    quantity p_rhs)
+  {
+    return p_rhs * p_lhs;
+  }
+
+  template<std::integral Divisor>
+  [[nodiscard]] friend constexpr quantity operator/(quantity p_lhs,
+                                                    Divisor p_rhs)
+  {
+    return quantity(static_cast<Rep>(p_lhs.m_count / p_rhs));
+  }
+
+  /**
+   * @brief Get the ratio of two quantities of the same type
+   *
+   * @return constexpr Rep - p_lhs / p_rhs, truncated toward zero
+   */
+  [[nodiscard]] friend constexpr Rep operator/(quantity p_lhs, quantity p_rhs)
+  {
+    return static_cast<Rep>(p_lhs.m_count / p_rhs.m_count);
+  }
+
+private:
+  Rep m_count = 0;
+};
+
+/// Voltage in millivolts
+using millivolts = quantity<i32, dimension::voltage, std::milli>;
+/// Voltage in microvolts
+using microvolts = quantity<i32, dimension::voltage, std::micro>;
+/// Current in milliamperes
+using milliamperes = quantity<i32, dimension::current, std::milli>;
+/// Current in microamperes
+using microamperes = quantity<i32, dimension::current, std::micro>;
+/// Temperature in thousandths of a degree Celsius
+using millicelsius = quantity<i32, dimension::temperature, std::milli>;
+/// Frequency in hertz
+using hertz_count = quantity<u32, dimension::frequency>;
+/// Frequency in kilohertz
+using kilohertz = quantity<u32, dimension::frequency, std::kilo>;
+/// Angular velocity in thousandths of a revolution per minute
+using millirpm = quantity<i32, dimension::angular_velocity, std::milli>;
+/// Length in millimeters
+using millimeters = quantity<i32, dimension::length, std::milli>;
+/// Length in micrometers
+using micrometers = quantity<i32, dimension::length, std::micro>;
+/// Angle in thousandths of a degree
+using millidegrees = quantity<i32, dimension::angle, std::milli>;
+/// Acceleration in thousandths of standard gravity
+using milli_g = quantity<i32, dimension::acceleration, std::milli>;
+
+/**
+ * @brief Convert a quantity to another scale or representation of the same
+ * dimension
+ *
+ * The conversion factor is reduced at compile time and applied in
+ * `std::intmax_t`, truncating toward zero.
+ *
+ * @tparam To - quantity type to convert to
+ * @param p_from - quantity to convert
+ * @return constexpr To - converted quantity
+ */
+template<typename To, std::integral Rep, typename Dimension, typename Scale>
+  requires std::same_as<typename To::dimension_type, Dimension>
+[[nodiscard]] constexpr To quantity_cast(
+  quantity<Rep, Dimension, Scale> p_from)
+{
+  using factor = std::ratio_divide<Scale, typename To::scale>;
+  auto const count = static_cast<std::intmax_t>(p_from.count());
+  if constexpr (factor::den == 1) {
+    return To(static_cast<typename To::rep>(count * factor::num));
+  } else if constexpr (factor::num == 1) {
+    return To(static_cast<typename To::rep>(count / factor::den));
+  } else {
+    return To(
+      static_cast<typename To::rep>(count * factor::num / factor::den));
+  }
+}
+
+/**
+ * @brief Scale a quantity by a fraction
+ *
+ * The product is computed in `std::intmax_t` before dividing, so it does not
+ * overflow Rep when the result fits in Rep.
+ *
+ * @param p_quantity - quantity to scale
+ * @param p_numerator - numerator of the fraction
+ * @param p_denominator - denominator of the fraction, not 0
+ * @return constexpr quantity - p_quantity * p_numerator / p_denominator,
+ * truncated toward zero
+ */
+template<std::integral Rep, typename Dimension, typename Scale>
+[[nodiscard]] constexpr quantity<Rep, Dimension, Scale> mul_div(
+  quantity<Rep, Dimension, Scale> p_quantity,
+  std::intmax_t p_numerator,
+  std::intmax_t p_denominator)
+{
+  auto const count = static_cast<std::intmax_t>(p_quantity.count());
+  return quantity<Rep, Dimension, Scale>(
+    static_cast<Rep>(count * p_numerator / p_denominator));
+}
+
+/**
+ * @brief Convert a quantity to the float unit of its dimension
+ *
+ * For use at the boundary with float based interfaces: `hal::millivolts`
+ * converts to `hal::volts`, `hal::millicelsius` to `hal::celsius` and so on.
+ *
+ * @param p_quantity - quantity to convert
+ * @return constexpr float - value in the base unit of the dimension
+ */
+template<std::integral Rep, typename Dimension, typename Scale>
+[[nodiscard]] constexpr float to_float(
+  quantity<Rep, Dimension, Scale> p_quantity)
+{
+  return static_cast<float>(p_quantity.count()) *
+         static_cast<float>(Scale::num) / static_cast<float>(Scale::den);
+}
+
+/**
+ * @brief Convert a value of a float unit to a quantity, rounding to nearest
+ *
+ * @tparam To - quantity type to convert to
+ * @param p_value - value in the base unit of To's dimension, such as
+ * `hal::volts` for `hal::millivolts`
+ * @return constexpr To - the nearest quantity
+ */
+template<typename To>
+[[nodiscard]] constexpr To from_float(float p_value)
+{
+  using scale = typename To::scale;
+  auto const counts = p_value * (static_cast<float>(scale::den) /
+                                 static_cast<float>(scale::num));
+  auto const rounded = counts < 0.0f ? counts - 0.5f : counts + 0.5f;
+  return To(static_cast<typename To::rep>(rounded));
+}
+}  // namespace hal::v5
+
+namespace hal {
+namespace dimension = v5::dimension;
+using v5::from_float;
+using v5::hertz_count;
+using v5::kilohertz;
+using v5::micrometers;
+using v5::microamperes;
+using v5::microvolts;
+using v5::milli_g;
+using v5::milliamperes;
+using v5::millicelsius;
+using v5::millidegrees;
+using v5::millimeters;
+using v5::millirpm;
+using v5::millivolts;
+using v5::mul_div;
+using v5::quantity;
+using v5::quantity_cast;
+using v5::to_float;
+}  // namespace hal
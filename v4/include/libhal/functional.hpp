@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <tl/function_ref.hpp>
 
 #include "third_party/inplace_function.hpp"
@@ -54,6 +56,28 @@ using function_ref = tl::function_ref<F>;
 template<typename F, size_t Capacity>
 using inplace_function = stdext::inplace_function<F, Capacity>;
 
+/**
+ * @ingroup Functional
+ * @brief Number of pointers a standard libhal callback can hold
+ *
+ */
+inline constexpr size_t callback_words = 2;
+
+/**
+ * @ingroup Functional
+ * @brief Definition of an owning callback object with a capacity in pointers
+ *
+ * Use this when a callable object captures more than `callback_words`
+ * pointers worth of data, so it can be stored inline rather than through a
+ * pointer to state held elsewhere. The interrupt APIs accept callbacks larger
+ * than `hal::callback` by reference, see `hal::interrupt_pin::on_trigger()`.
+ *
+ * @tparam F - function type or call signature
+ * @tparam Words - storage capacity of the function in pointers
+ */
+template<typename F, size_t Words>
+using callback_n = inplace_function<F, sizeof(void*) * Words>;
+
 /**
  * @ingroup Functional
  * @brief Definition of a standard libhal owning callback object
@@ -65,5 +89,51 @@ using inplace_function = stdext::inplace_function<F, Capacity>;
  * @tparam F - function type or call signature
  */
 template<typename F>
-using callback = inplace_function<F, sizeof(void*) * 2>;
+using callback = callback_n<F, callback_words>;
+
+/**
+ * @ingroup Functional
+ * @brief Number of pointers needed to store a callable object in a callback
+ *
+ * @tparam Callable - type of the callable object such as a lambda
+ */
+template<typename Callable>
+inline constexpr size_t callback_words_of =
+  (sizeof(Callable) + sizeof(void*) - 1) / sizeof(void*);
+
+namespace detail {
+template<size_t NeededWords, size_t AvailableWords>
+constexpr void check_callback_words()
+{
+  // The template arguments of this function, shown in the compiler's error
+  // message, are the pointers the callable captures and the pointers the
+  // callback can hold.
+  static_assert(NeededWords <= AvailableWords,
+                "Callable captures more than the callback can hold, use a "
+                "hal::callback_n with at least NeededWords words");
+}
+}  // namespace detail
+
+/**
+ * @ingroup Functional
+ * @brief Construct a callback, diagnosing callables that do not fit
+ *
+ * Behaves like constructing `callback_n<F, Words>` directly, except that a
+ * callable that is too large fails with an error naming the number of
+ * pointers it captures and the number available.
+ *
+ * @tparam F - function type or call signature
+ * @tparam Words - storage capacity of the callback in pointers
+ * @tparam Callable - type of the callable object
+ * @param p_callable - callable object to store
+ * @return callback_n<F, Words> - callback holding p_callable
+ */
+template<typename F, size_t Words = callback_words, typename Callable>
+constexpr callback_n<F, Words> make_callback(Callable&& p_callable)
+{
+  detail::check_callback_words<
+    callback_words_of<std::remove_cvref_t<Callable>>,
+    Words>();
+  return callback_n<F, Words>(static_cast<Callable&&>(p_callable));
+}
 }  // namespace hal
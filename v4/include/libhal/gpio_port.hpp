@@ -0,0 +1,249 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+
+#include "input_pin.hpp"
+#include "output_pin.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Digital output port hardware abstraction.
+ *
+ * Use this to drive many pins at once, such as the data lines of a parallel
+ * bus or the rows of an LED matrix. Where `hal::output_pin::level(bool)`
+ * changes one pin per call, this interface changes every pin selected by a
+ * mask in a single call, and drivers backed by a GPIO port do so with a single
+ * register write (for example, a set/reset register such as the STM32 BSRR).
+ * This removes the skew between pins and the cost of a call per pin.
+ *
+ * Bit `n` of the masks and values corresponds to pin `n` of the port, where
+ * the order of the pins is defined by the implementation.
+ *
+ */
+class output_port
+{
+public:
+  /**
+   * @brief Configure every pin of the port to match the settings supplied
+   *
+   * @param p_settings - settings to apply to the pins of the port
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  void configure(output_pin::settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Set the state of the pins selected by a mask
+   *
+   * Pins whose bit is set in `p_mask` are set to the level of the matching bit
+   * of `p_value`, HIGH for 1 and LOW for 0. Pins whose bit is clear in
+   * `p_mask` are left unchanged. Bits beyond the pins of the port are ignored.
+   *
+   * @param p_mask - pins to update
+   * @param p_value - levels of the pins to update
+   */
+  void level(u32 p_mask, u32 p_value)
+  {
+    driver_level(p_mask, p_value);
+  }
+
+  /**
+   * @brief Read the state of every pin of the port
+   *
+   * Implementations must read the pin states from hardware and will not simply
+   * cache the results from the execution of `level(u32, u32)`.
+   *
+   * @return u32 - levels of the pins, HIGH for 1 and LOW for 0. Bits beyond the
+   * pins of the port are 0.
+   */
+  [[nodiscard]] u32 level()
+  {
+    return driver_level();
+  }
+
+  virtual ~output_port() = default;
+
+private:
+  virtual void driver_configure(output_pin::settings const& p_settings) = 0;
+  virtual void driver_level(u32 p_mask, u32 p_value) = 0;
+  virtual u32 driver_level() = 0;
+};
+
+/**
+ * @brief Digital input port hardware abstraction.
+ *
+ * Use this to sample many pins at once. Drivers backed by a GPIO port read
+ * every pin with a single register read, so all pins are sampled at the same
+ * instant.
+ *
+ * Bit `n` of the result corresponds to pin `n` of the port, where the order of
+ * the pins is defined by the implementation.
+ *
+ */
+class input_port
+{
+public:
+  /**
+   * @brief Configure every pin of the port to match the settings supplied
+   *
+   * @param p_settings - settings to apply to the pins of the port
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  void configure(input_pin::settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Read the state of every pin of the port
+   *
+   * @return u32 - levels of the pins, HIGH for 1 and LOW for 0. Bits beyond the
+   * pins of the port are 0.
+   */
+  [[nodiscard]] u32 level()
+  {
+    return driver_level();
+  }
+
+  virtual ~input_port() = default;
+
+private:
+  virtual void driver_configure(input_pin::settings const& p_settings) = 0;
+  virtual u32 driver_level() = 0;
+};
+
+/**
+ * @brief Group individual output pins into an output port
+ *
+ * Allows code written against `hal::output_port` to run on pins that are not
+ * part of the same GPIO port, such as pins spread across ports or I/O
+ * expanders. Pin `n` of the port is `p_pins[n]`. Each pin is still updated by
+ * its own call, so the pins do not change at the same instant.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::output_pin_group data(std::array<hal::output_pin*, 4>{ &d0, &d1, &d2,
+ *                                                             &d3 });
+ * data.level(0b1111, 0b1010);
+ * ```
+ *
+ * @tparam PinCount - number of pins in the group, at most 32
+ */
+template<usize PinCount>
+class output_pin_group : public output_port
+{
+public:
+  static_assert(PinCount > 0 && PinCount <= 32,
+                "output_pin_group must hold from 1 to 32 pins");
+
+  /**
+   * @brief Construct a port from a set of pins
+   *
+   * @param p_pins - pins of the port. Each must outlive this object.
+   */
+  explicit output_pin_group(std::array<output_pin*, PinCount> const& p_pins)
+    : m_pins(p_pins)
+  {
+  }
+
+private:
+  void driver_configure(output_pin::settings const& p_settings) override
+  {
+    for (auto* pin : m_pins) {
+      pin->configure(p_settings);
+    }
+  }
+
+  void driver_level(u32 p_mask, u32 p_value) override
+  {
+    for (usize i = 0; i < PinCount; i++) {
+      if (p_mask & (1U << i)) {
+        m_pins[i]->level(static_cast<bool>(p_value & (1U << i)));
+      }
+    }
+  }
+
+  u32 driver_level() override
+  {
+    u32 value = 0;
+    for (usize i = 0; i < PinCount; i++) {
+      value |= static_cast<u32>(m_pins[i]->level()) << i;
+    }
+    return value;
+  }
+
+  std::array<output_pin*, PinCount> m_pins;
+};
+
+/**
+ * @brief Group individual input pins into an input port
+ *
+ * Pin `n` of the port is `p_pins[n]`. Each pin is still read by its own call,
+ * so the pins are not sampled at the same instant.
+ *
+ * @tparam PinCount - number of pins in the group, at most 32
+ */
+template<usize PinCount>
+class input_pin_group : public input_port
+{
+public:
+  static_assert(PinCount > 0 && PinCount <= 32,
+                "input_pin_group must hold from 1 to 32 pins");
+
+  /**
+   * @brief Construct a port from a set of pins
+   *
+   * @param p_pins - pins of the port. Each must outlive this object.
+   */
+  explicit input_pin_group(std::array<input_pin*, PinCount> const& p_pins)
+    : m_pins(p_pins)
+  {
+  }
+
+private:
+  void driver_configure(input_pin::settings const& p_settings) override
+  {
+    for (auto* pin : m_pins) {
+      pin->configure(p_settings);
+    }
+  }
+
+  u32 driver_level() override
+  {
+    u32 value = 0;
+    for (usize i = 0; i < PinCount; i++) {
+      value |= static_cast<u32>(m_pins[i]->level()) << i;
+    }
+    return value;
+  }
+
+  std::array<input_pin*, PinCount> m_pins;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::input_pin_group;
+using v5::input_port;
+using v5::output_pin_group;
+using v5::output_port;
+}  // namespace hal
@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <span>
 
+#include "error.hpp"
 #include "functional.hpp"
+#include "scatter_span.hpp"
 #include "timeout.hpp"
 #include "units.hpp"
 
@@ -164,6 +168,90 @@ public:
     driver_transaction(p_address, p_data_out, p_data_in, p_timeout);
   }
 
+  /**
+   * @brief Bytes the default scatter transaction can stage without a caller
+   * supplied staging buffer
+   *
+   * See `transaction(hal::byte, scatter_span<hal::byte const>,
+   * scatter_span<hal::byte>, std::span<hal::byte>)`.
+   */
+  static constexpr usize scatter_staging_size = 32;
+
+  /**
+   * @brief perform an i2c transaction using multiple buffers for each phase
+   *
+   * Performs the same bus transaction as the single buffer `transaction()`:
+   * a START, the address, every segment of p_data_out written back to back,
+   * then, if p_data_in is not empty, a repeated START, the address and a read
+   * filling every segment of p_data_in in order, followed by a single STOP.
+   * Segment boundaries are not visible on the bus.
+   *
+   * This allows a register address and a payload held in separate buffers to
+   * be written, or a block of registers to be read directly into several
+   * destination fields, in one transaction without copying into a temporary
+   * buffer. Drivers with DMA can chain the segments as descriptors.
+   *
+   * Empty segments are skipped. Drivers that do not chain segments natively
+   * use a default implementation that forwards to the single buffer
+   * `transaction()` when each direction has at most one non-empty segment.
+   * Otherwise the segments are joined in a staging buffer: an internal one of
+   * `scatter_staging_size` bytes when both directions fit, otherwise
+   * p_staging.
+   *
+   * @param p_address 7-bit address of the device you want to communicate with.
+   * See the single buffer `transaction()` for 10-bit addresses.
+   * @param p_data_out segments of data to be written to the addressed device,
+   * in order. Pass an empty scatter span to skip writing.
+   * @param p_data_in segments to fill with data read from the addressed
+   * device, in order. Pass an empty scatter span to skip reading.
+   * @param p_staging - buffer the default implementation may use to join
+   * segments. Only needed for transactions of more than `scatter_staging_size`
+   * bytes, where it must hold the bytes of both directions. Drivers that chain
+   * segments natively never touch it.
+   * @throws hal::no_such_device - if no device acknowledged the address.
+   * @throws hal::io_error - if the i2c lines were put into an invalid state.
+   * @throws hal::argument_out_of_domain - if the segments must be staged and
+   * neither the internal buffer nor p_staging can hold both directions.
+   */
+  void transaction(hal::byte p_address,
+                   scatter_span<hal::byte const> p_data_out,
+                   scatter_span<hal::byte> p_data_in,
+                   std::span<hal::byte> p_staging = {})
+  {
+    driver_transaction_scatter(p_address, p_data_out, p_data_in, p_staging);
+  }
+
+  /**
+   * @brief perform an i2c transaction, returning errors instead of throwing
+   *
+   * Performs the same transaction as `transaction(hal::byte,
+   * std::span<hal::byte const>, std::span<hal::byte>)`. Use this where a
+   * failure is an expected outcome, such as probing for a device or retrying
+   * while a device is busy and does not acknowledge its address, so each
+   * failed attempt does not throw and unwind.
+   *
+   * Drivers that override this API report errors without throwing. Otherwise,
+   * the default implementation calls `transaction()` and catches the
+   * exception, which is no faster than catching it yourself.
+   *
+   * @param p_address 7-bit address of the device you want to communicate with.
+   * See `transaction()` for 10-bit addresses.
+   * @param p_data_out data to be written to the addressed device. Set to
+   * nullptr with length zero in order to skip writing.
+   * @param p_data_in buffer to store read data from the addressed device. Set
+   * to nullptr with length 0 in order to skip reading.
+   * @return std::errc - `std::errc{}` on success, `std::errc::no_such_device`
+   * if no device acknowledged the address, `std::errc::io_error` if the i2c
+   * lines were put into an invalid state, or the error code of any other
+   * hal::exception the transaction raised.
+   */
+  [[nodiscard]] std::errc try_transaction(hal::byte p_address,
+                                          std::span<hal::byte const> p_data_out,
+                                          std::span<hal::byte> p_data_in)
+  {
+    return driver_try_transaction(p_address, p_data_out, p_data_in);
+  }
+
   virtual ~i2c() = default;
 
 private:
@@ -188,5 +276,57 @@ private:
     // NOLINTNEXTLINE
     transaction(p_address, p_data_out, p_data_in, hal::never_timeout());
   }
+
+  virtual std::errc driver_try_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in)
+  {
+    return hal::catch_error_code(
+      [&]() { transaction(p_address, p_data_out, p_data_in); });
+  }
+
+  virtual void driver_transaction_scatter(
+    hal::byte p_address,
+    scatter_span<hal::byte const> p_data_out,
+    scatter_span<hal::byte> p_data_in,
+    std::span<hal::byte> p_staging)
+  {
+    constexpr auto not_empty = [](auto const& p_segment) {
+      return not p_segment.empty();
+    };
+
+    auto const out_count = std::ranges::count_if(p_data_out, not_empty);
+    auto const in_count = std::ranges::count_if(p_data_in, not_empty);
+
+    if (out_count <= 1 && in_count <= 1) {
+      auto const out = std::ranges::find_if(p_data_out, not_empty);
+      auto const in = std::ranges::find_if(p_data_in, not_empty);
+      driver_transaction(
+        p_address,
+        out == p_data_out.end() ? std::span<hal::byte const>{} : *out,
+        in == p_data_in.end() ? std::span<hal::byte>{} : *in);
+      return;
+    }
+
+    auto const out_size = scatter_size(p_data_out);
+    auto const in_size = scatter_size(p_data_in);
+    std::array<hal::byte, scatter_staging_size> internal_staging{};
+    std::span<hal::byte> staging = internal_staging;
+
+    if (out_size + in_size > staging.size()) {
+      staging = p_staging;
+    }
+    if (out_size + in_size > staging.size()) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+
+    auto const out_staging = staging.first(out_size);
+    auto const in_staging = staging.subspan(out_size, in_size);
+
+    scatter_copy(p_data_out, out_staging);
+    driver_transaction(p_address, out_staging, in_staging);
+    scatter_copy(std::span<hal::byte const>(in_staging), p_data_in);
+  }
 };
 }  // namespace hal
@@ -0,0 +1,226 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <system_error>
+
+#include "error.hpp"
+#include "functional.hpp"
+#include "i2c.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Asynchronous I2C transaction queue hardware abstraction interface
+ *
+ * Runs a batch of i2c transactions back to back from interrupt or DMA context,
+ * without the CPU having to start each transaction. While the bus is busy, the
+ * application is free to do other work, such as processing the previous set of
+ * samples from the same sensors. Completion is signaled with an optional
+ * callback and can be waited on with `wait()`, which drivers implement with
+ * the `hal::io_waiter` they were constructed with.
+ *
+ * Each transaction in the batch is the same as a call to
+ * `hal::i2c::transaction()` and ends in a STOP.
+ *
+ * Implementations of this interface are NOT sharable across multiple device or
+ * applications drivers. Only one batch may be in flight at a time.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::i2c_transaction_queue::transaction, 2> batch{ {
+ *   { .address = 0x68, .data_out = gyro_register, .data_in = gyro_data },
+ *   { .address = 0x1E, .data_out = mag_register, .data_in = mag_data },
+ * } };
+ *
+ * queue.submit(batch);
+ * process(previous_samples);
+ * auto const result = queue.wait();
+ * ```
+ */
+class i2c_transaction_queue
+{
+public:
+  /**
+   * @brief Descriptor for a single i2c transaction within a batch
+   *
+   * See `hal::i2c::transaction()` for the meaning of each field.
+   */
+  struct transaction
+  {
+    /// 7-bit address of the device to communicate with
+    hal::byte address{};
+    /// Data to be written to the device, empty to skip writing
+    std::span<hal::byte const> data_out{};
+    /// Buffer to fill with data read from the device, empty to skip reading
+    std::span<hal::byte> data_in{};
+  };
+
+  /**
+   * @brief Outcome of a batch of transactions
+   *
+   */
+  struct batch_result
+  {
+    /// Number of transactions, from the start of the batch, that completed
+    usize completed = 0;
+    /// Error of the transaction at index `completed`, or `std::errc{}` if
+    /// every transaction completed. Carries the error code of the exception
+    /// the blocking `hal::i2c` API would have thrown, such as
+    /// `std::errc::no_such_device` or `std::errc::io_error`.
+    std::errc error{};
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    constexpr bool operator==(batch_result const&) const = default;
+  };
+
+  /**
+   * @brief Disambiguation tag object for batch completion events
+   *
+   */
+  struct on_complete_tag
+  {};
+
+  /**
+   * @brief Completion handler signature
+   *
+   */
+  using completion_handler = void(on_complete_tag, batch_result p_result);
+
+  /**
+   * @brief Optional completion handler
+   *
+   */
+  using optional_completion_handler =
+    std::optional<hal::callback<completion_handler>>;
+
+  /**
+   * @brief Start running a batch of transactions
+   *
+   * Returns as soon as the first transaction has been started. The batch span
+   * and every buffer it refers to must remain valid and unmodified, and the
+   * `data_in` buffers must not be read, until the batch completes. Processing
+   * stops at the first transaction that fails.
+   *
+   * @param p_batch - transactions to run in order
+   * @param p_on_complete - called, most likely from an interrupt context, when
+   * the batch finishes or fails. Must not throw.
+   * @throws hal::device_or_resource_busy - if a batch is already in flight
+   */
+  void submit(std::span<transaction const> p_batch,
+              optional_completion_handler p_on_complete = std::nullopt)
+  {
+    driver_submit(p_batch, p_on_complete);
+  }
+
+  /**
+   * @brief Determine if a batch is in flight
+   *
+   * @return true - a batch has been submitted and has not completed yet
+   * @return false - no batch is in flight, a new one can be submitted
+   */
+  [[nodiscard]] bool busy()
+  {
+    return driver_busy();
+  }
+
+  /**
+   * @brief Wait for the batch in flight to complete
+   *
+   * Calls the driver's `hal::io_waiter` until the batch completes. Returns
+   * immediately if no batch is in flight.
+   *
+   * @return batch_result - outcome of the most recently submitted batch
+   */
+  batch_result wait()
+  {
+    return driver_wait();
+  }
+
+  virtual ~i2c_transaction_queue() = default;
+
+private:
+  virtual void driver_submit(std::span<transaction const> p_batch,
+                             optional_completion_handler p_on_complete) = 0;
+  virtual bool driver_busy() = 0;
+  virtual batch_result driver_wait() = 0;
+};
+
+/**
+ * @brief An i2c_transaction_queue that runs batches on a blocking hal::i2c
+ *
+ * Allows code written against `hal::i2c_transaction_queue` to run on any i2c
+ * driver. Each batch runs to completion within `submit()` and the completion
+ * handler is called before `submit()` returns, so no work overlaps with the
+ * bus transfers.
+ */
+class blocking_i2c_transaction_queue : public i2c_transaction_queue
+{
+public:
+  /**
+   * @brief Construct a queue on top of an i2c driver
+   *
+   * @param p_i2c - i2c bus to run transactions on. Must outlive this object.
+   */
+  explicit blocking_i2c_transaction_queue(hal::i2c& p_i2c)
+    : m_i2c(&p_i2c)
+  {
+  }
+
+private:
+  void driver_submit(std::span<transaction const> p_batch,
+                     optional_completion_handler p_on_complete) override
+  {
+    m_result = {};
+    for (auto const& entry : p_batch) {
+      try {
+        m_i2c->transaction(entry.address, entry.data_out, entry.data_in);
+      } catch (hal::exception const& p_error) {
+        m_result.error = p_error.error_code();
+        break;
+      }
+      m_result.completed++;
+    }
+
+    if (p_on_complete) {
+      (*p_on_complete)(on_complete_tag{}, m_result);
+    }
+  }
+
+  bool driver_busy() override
+  {
+    return false;
+  }
+
+  batch_result driver_wait() override
+  {
+    return m_result;
+  }
+
+  hal::i2c* m_i2c;
+  batch_result m_result{};
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::blocking_i2c_transaction_queue;
+using v5::i2c_transaction_queue;
+}  // namespace hal
@@ -0,0 +1,181 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <span>
+
+#include "accelerometer.hpp"
+#include "error.hpp"
+#include "gyroscope.hpp"
+#include "magnetometer.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Inertial measurement unit (IMU) hardware abstraction interface
+ *
+ * Reading an IMU through separate `hal::accelerometer`, `hal::gyroscope` and
+ * `hal::magnetometer` drivers costs one bus transaction per sensor, and the
+ * three results are not sampled at the same time. Drivers of this interface
+ * read every sensor of the device in one burst, so each `read_t` holds
+ * readings taken at the same instant.
+ *
+ * `read_batch()` drains multiple samples, such as the contents of a hardware
+ * FIFO, into separate arrays per axis (struct-of-arrays form), which filter
+ * and sensor fusion kernels can process with SIMD instructions directly.
+ *
+ * 6-axis devices, which have no magnetometer, report a magnetic field of 0 on
+ * every axis.
+ */
+class imu
+{
+public:
+  /**
+   * @brief Result from reading the IMU.
+   *
+   */
+  struct read_t
+  {
+    /// Acceleration, relative to the device's reference frame
+    accelerometer::read_t acceleration;
+    /// Angular velocity, relative to the device's reference frame
+    gyroscope::read_t angular_velocity;
+    /// Magnetic field strength, relative to the device's reference frame
+    magnetometer::read_t magnetic_field;
+    /// Temperature of the device
+    celsius temperature;
+  };
+
+  /**
+   * @brief Destination arrays for a batch of samples
+   *
+   * Element `i` of every array belongs to sample `i`. Every non-empty array
+   * must have the same size, which is the number of samples to read. Sensors
+   * whose arrays are empty are skipped.
+   */
+  struct batch
+  {
+    /// Acceleration in the X axis
+    std::span<g_force> acceleration_x{};
+    /// Acceleration in the Y axis
+    std::span<g_force> acceleration_y{};
+    /// Acceleration in the Z axis
+    std::span<g_force> acceleration_z{};
+    /// Angular velocity in the X axis
+    std::span<rpm> angular_velocity_x{};
+    /// Angular velocity in the Y axis
+    std::span<rpm> angular_velocity_y{};
+    /// Angular velocity in the Z axis
+    std::span<rpm> angular_velocity_z{};
+    /// Magnetic field strength in the X axis
+    std::span<gauss> magnetic_field_x{};
+    /// Magnetic field strength in the Y axis
+    std::span<gauss> magnetic_field_y{};
+    /// Magnetic field strength in the Z axis
+    std::span<gauss> magnetic_field_z{};
+    /// Temperature of the device
+    std::span<celsius> temperature{};
+
+    /**
+     * @brief Get the number of samples the batch can hold
+     *
+     * @return usize - size of the non-empty arrays, or 0 if all are empty
+     * @throws hal::argument_out_of_domain - if the non-empty arrays do not all
+     * have the same size.
+     */
+    [[nodiscard]] usize capacity() const
+    {
+      usize result = 0;
+      for (auto const size : { acceleration_x.size(),
+                               acceleration_y.size(),
+                               acceleration_z.size(),
+                               angular_velocity_x.size(),
+                               angular_velocity_y.size(),
+                               angular_velocity_z.size(),
+                               magnetic_field_x.size(),
+                               magnetic_field_y.size(),
+                               magnetic_field_z.size(),
+                               temperature.size() }) {
+        if (size == 0) {
+          continue;
+        }
+        if (result != 0 && result != size) {
+          hal::safe_throw(hal::argument_out_of_domain(this));
+        }
+        result = size;
+      }
+      return result;
+    }
+  };
+
+  /**
+   * @brief Read the latest readings of every sensor of the device
+   *
+   * @return read_t - readings of every sensor, sampled at the same instant
+   */
+  [[nodiscard]] read_t read()
+  {
+    return driver_read();
+  }
+
+  /**
+   * @brief Read multiple samples from the device in a single transfer
+   *
+   * Samples are ordered oldest first, and the last sample is the newest.
+   * Drivers without a FIFO read the single latest sample.
+   *
+   * @param p_batch - arrays to fill with samples
+   * @return usize - number of samples written to the front of each array
+   * @throws hal::argument_out_of_domain - if the non-empty arrays of p_batch do
+   * not all have the same size.
+   */
+  [[nodiscard]] usize read_batch(batch const& p_batch)
+  {
+    if (p_batch.capacity() == 0) {
+      return 0;
+    }
+    return driver_read_batch(p_batch);
+  }
+
+  virtual ~imu() = default;
+
+private:
+  virtual read_t driver_read() = 0;
+  virtual usize driver_read_batch(batch const& p_batch)
+  {
+    auto const sample = driver_read();
+    auto const store = [](auto p_array, float p_value) {
+      if (not p_array.empty()) {
+        p_array[0] = p_value;
+      }
+    };
+    store(p_batch.acceleration_x, sample.acceleration.x);
+    store(p_batch.acceleration_y, sample.acceleration.y);
+    store(p_batch.acceleration_z, sample.acceleration.z);
+    store(p_batch.angular_velocity_x, sample.angular_velocity.x);
+    store(p_batch.angular_velocity_y, sample.angular_velocity.y);
+    store(p_batch.angular_velocity_z, sample.angular_velocity.z);
+    store(p_batch.magnetic_field_x, sample.magnetic_field.x);
+    store(p_batch.magnetic_field_y, sample.magnetic_field.y);
+    store(p_batch.magnetic_field_z, sample.magnetic_field.z);
+    store(p_batch.temperature, sample.temperature);
+    return 1;
+  }
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::imu;
+}  // namespace hal
@@ -0,0 +1,522 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include "functional.hpp"
+#include "i2c.hpp"
+#include "scatter_span.hpp"
+#include "serial.hpp"
+#include "spi.hpp"
+#include "steady_clock.hpp"
+#include "timeout.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/// Number of buckets in a latency histogram
+inline constexpr usize latency_buckets = 32;
+
+/**
+ * @brief Counters of the calls made through an instrumented driver
+ *
+ * Latencies are in ticks of the steady clock given to the instrumented
+ * driver and are bucketed by powers of two: bucket 0 counts calls that took 0
+ * ticks and bucket N counts calls that took from 2^(N-1) up to, but not
+ * including, 2^N ticks. The last bucket also counts every longer call.
+ */
+struct call_statistics
+{
+  /// Number of calls made
+  u32 calls = 0;
+  /// Number of bytes transferred by calls that succeeded
+  u32 bytes = 0;
+  /// Number of calls that threw or returned an error
+  u32 errors = 0;
+  /// Number of calls per latency bucket
+  std::array<u32, latency_buckets> latency{};
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(call_statistics const&) const = default;
+};
+
+/**
+ * @brief Lock free counters behind a `call_statistics`
+ *
+ * Every counter is an independent relaxed atomic, so calls can be recorded
+ * from interrupts and threads at the same time. A `read()` concurrent with a
+ * `record()` may see some counters of that call updated and others not yet.
+ * Counters wrap at the maximum of a u32.
+ */
+class call_recorder
+{
+public:
+  static_assert(std::atomic<u32>::is_always_lock_free,
+                "call_recorder requires lock free atomic counters");
+
+  /**
+   * @brief Get the latency bucket of a duration
+   *
+   * @param p_ticks - duration of a call
+   * @return usize - index of the bucket counting the call
+   */
+  [[nodiscard]] static constexpr usize bucket(u64 p_ticks)
+  {
+    return std::min<usize>(std::bit_width(p_ticks), latency_buckets - 1);
+  }
+
+  /**
+   * @brief Count a call
+   *
+   * @param p_ticks - how long the call took
+   * @param p_bytes - bytes the call transferred
+   * @param p_failed - true if the call threw or returned an error, in which
+   * case its bytes are not counted
+   */
+  void record(u64 p_ticks, usize p_bytes, bool p_failed)
+  {
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+    if (p_failed) {
+      m_errors.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      m_bytes.fetch_add(static_cast<u32>(p_bytes), std::memory_order_relaxed);
+    }
+    m_latency[bucket(p_ticks)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy the counters
+   *
+   * @return call_statistics - counters since construction or the last reset
+   */
+  [[nodiscard]] call_statistics read() const
+  {
+    call_statistics statistics{
+      .calls = m_calls.load(std::memory_order_relaxed),
+      .bytes = m_bytes.load(std::memory_order_relaxed),
+      .errors = m_errors.load(std::memory_order_relaxed),
+    };
+    for (usize i = 0; i < latency_buckets; i++) {
+      statistics.latency[i] = m_latency[i].load(std::memory_order_relaxed);
+    }
+    return statistics;
+  }
+
+  /**
+   * @brief Set every counter to 0
+   *
+   */
+  void reset()
+  {
+    m_calls.store(0, std::memory_order_relaxed);
+    m_bytes.store(0, std::memory_order_relaxed);
+    m_errors.store(0, std::memory_order_relaxed);
+    for (auto& count : m_latency) {
+      count.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::atomic<u32> m_calls = 0;
+  std::atomic<u32> m_bytes = 0;
+  std::atomic<u32> m_errors = 0;
+  std::array<std::atomic<u32>, latency_buckets> m_latency{};
+};
+
+namespace detail {
+/// Records a call when destroyed, as a failure unless `succeeded()` was called
+class timed_call
+{
+public:
+  timed_call(call_recorder& p_recorder, hal::steady_clock& p_clock)
+    : m_recorder(&p_recorder)
+    , m_clock(&p_clock)
+    , m_start(p_clock.uptime())
+  {
+  }
+
+  timed_call(timed_call const&) = delete;
+  timed_call& operator=(timed_call const&) = delete;
+  timed_call(timed_call&&) = delete;
+  timed_call& operator=(timed_call&&) = delete;
+
+  ~timed_call()
+  {
+    m_recorder->record(m_clock->uptime() - m_start, m_bytes, m_failed);
+  }
+
+  void succeeded(usize p_bytes)
+  {
+    m_bytes = p_bytes;
+    m_failed = false;
+  }
+
+private:
+  call_recorder* m_recorder;
+  hal::steady_clock* m_clock;
+  u64 m_start;
+  usize m_bytes = 0;
+  bool m_failed = true;
+};
+}  // namespace detail
+
+/**
+ * @brief i2c decorator that records the count, bytes and latency of every
+ * transaction of the i2c driver it wraps
+ *
+ * Pass this object wherever the wrapped driver would be passed. Every form of
+ * transaction is recorded, and configuration is forwarded without being
+ * recorded. A transaction that throws counts as an error and the exception
+ * propagates unchanged.
+ */
+class instrumented_i2c final : public hal::i2c
+{
+public:
+  /**
+   * @brief Wrap an i2c driver
+   *
+   * @param p_driver - driver to forward every call to. Must outlive this
+   * object.
+   * @param p_clock - clock to measure latencies with. Must outlive this
+   * object.
+   */
+  instrumented_i2c(hal::i2c& p_driver, hal::steady_clock& p_clock)
+    : m_driver(&p_driver)
+    , m_clock(&p_clock)
+  {
+  }
+
+  /**
+   * @brief Get the counters of the transactions made
+   *
+   * @return call_statistics - counters since construction or the last reset
+   */
+  [[nodiscard]] call_statistics statistics() const
+  {
+    return m_recorder.read();
+  }
+
+  /**
+   * @brief Set every counter to 0
+   *
+   */
+  void reset_statistics()
+  {
+    m_recorder.reset();
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  void driver_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in,
+    hal::function_ref<hal::timeout_function> p_timeout) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    m_driver->transaction(p_address, p_data_out, p_data_in, p_timeout);
+    call.succeeded(p_data_out.size() + p_data_in.size());
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    m_driver->transaction(p_address, p_data_out, p_data_in);
+    call.succeeded(p_data_out.size() + p_data_in.size());
+  }
+
+  std::errc driver_try_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    auto const error =
+      m_driver->try_transaction(p_address, p_data_out, p_data_in);
+    if (error == std::errc{}) {
+      call.succeeded(p_data_out.size() + p_data_in.size());
+    }
+    return error;
+  }
+
+  void driver_transaction_scatter(hal::byte p_address,
+                                  scatter_span<hal::byte const> p_data_out,
+                                  scatter_span<hal::byte> p_data_in,
+                                  std::span<hal::byte> p_staging) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    m_driver->transaction(p_address, p_data_out, p_data_in, p_staging);
+    call.succeeded(scatter_size(p_data_out) + scatter_size(p_data_in));
+  }
+
+  hal::i2c* m_driver;
+  hal::steady_clock* m_clock;
+  call_recorder m_recorder;
+};
+
+/**
+ * @brief spi_channel decorator that records the count, bytes and latency of
+ * every transfer of the channel it wraps
+ *
+ * Pass this object wherever the wrapped channel would be passed. Every form
+ * of transfer is recorded, where the bytes of a transfer are the larger of
+ * the bytes written and read. Configuration, clock rate and chip select are
+ * forwarded without being recorded.
+ */
+class instrumented_spi_channel final : public hal::spi_channel
+{
+public:
+  /**
+   * @brief Wrap an spi channel
+   *
+   * @param p_driver - channel to forward every call to. Must outlive this
+   * object.
+   * @param p_clock - clock to measure latencies with. Must outlive this
+   * object.
+   */
+  instrumented_spi_channel(hal::spi_channel& p_driver,
+                           hal::steady_clock& p_clock)
+    : m_driver(&p_driver)
+    , m_clock(&p_clock)
+  {
+  }
+
+  /**
+   * @brief Get the counters of the transfers made
+   *
+   * @return call_statistics - counters since construction or the last reset
+   */
+  [[nodiscard]] call_statistics statistics() const
+  {
+    return m_recorder.read();
+  }
+
+  /**
+   * @brief Set every counter to 0
+   *
+   */
+  void reset_statistics()
+  {
+    m_recorder.reset();
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return m_driver->clock_rate();
+  }
+
+  void driver_chip_select(bool p_select) override
+  {
+    m_driver->chip_select(p_select);
+  }
+
+  void driver_transfer(std::span<hal::byte const> p_data_out,
+                       std::span<hal::byte> p_data_in,
+                       hal::byte p_filler) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    m_driver->transfer(p_data_out, p_data_in, p_filler);
+    call.succeeded(std::max(p_data_out.size(), p_data_in.size()));
+  }
+
+  std::errc driver_try_transfer(std::span<hal::byte const> p_data_out,
+                                std::span<hal::byte> p_data_in,
+                                hal::byte p_filler) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    auto const error = m_driver->try_transfer(p_data_out, p_data_in, p_filler);
+    if (error == std::errc{}) {
+      call.succeeded(std::max(p_data_out.size(), p_data_in.size()));
+    }
+    return error;
+  }
+
+  void driver_transfer_scatter(scatter_span<hal::byte const> p_data_out,
+                               scatter_span<hal::byte> p_data_in,
+                               hal::byte p_filler) override
+  {
+    detail::timed_call call(m_recorder, *m_clock);
+    m_driver->transfer(p_data_out, p_data_in, p_filler);
+    call.succeeded(std::max(scatter_size(p_data_out), scatter_size(p_data_in)));
+  }
+
+  hal::spi_channel* m_driver;
+  hal::steady_clock* m_clock;
+  call_recorder m_recorder;
+};
+
+/**
+ * @brief serial decorator that records the count, bytes and latency of every
+ * write and read of the serial port it wraps
+ *
+ * Writes and reads are recorded separately. The bytes of each call are the
+ * bytes the wrapped port reports as transmitted or read. Configuration and
+ * flushes are forwarded without being recorded.
+ */
+class instrumented_serial final : public hal::serial
+{
+public:
+  /**
+   * @brief Wrap a serial port
+   *
+   * @param p_driver - serial port to forward every call to. Must outlive this
+   * object.
+   * @param p_clock - clock to measure latencies with. Must outlive this
+   * object.
+   */
+  instrumented_serial(hal::serial& p_driver, hal::steady_clock& p_clock)
+    : m_driver(&p_driver)
+    , m_clock(&p_clock)
+  {
+  }
+
+  /**
+   * @brief Get the counters of the writes made
+   *
+   * @return call_statistics - counters since construction or the last reset
+   */
+  [[nodiscard]] call_statistics write_statistics() const
+  {
+    return m_writes.read();
+  }
+
+  /**
+   * @brief Get the counters of the reads made
+   *
+   * @return call_statistics - counters since construction or the last reset
+   */
+  [[nodiscard]] call_statistics read_statistics() const
+  {
+    return m_reads.read();
+  }
+
+  /**
+   * @brief Set every counter to 0
+   *
+   */
+  void reset_statistics()
+  {
+    m_writes.reset();
+    m_reads.reset();
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  write_t driver_write(std::span<hal::byte const> p_data) override
+  {
+    detail::timed_call call(m_writes, *m_clock);
+    auto const result = m_driver->write(p_data);
+    call.succeeded(result.data.size());
+    return result;
+  }
+
+  read_t driver_read(std::span<hal::byte> p_data) override
+  {
+    detail::timed_call call(m_reads, *m_clock);
+    auto const result = m_driver->read(p_data);
+    call.succeeded(result.data.size());
+    return result;
+  }
+
+  void driver_flush() override
+  {
+    m_driver->flush();
+  }
+
+  hal::serial* m_driver;
+  hal::steady_clock* m_clock;
+  call_recorder m_writes;
+  call_recorder m_reads;
+};
+
+/**
+ * @brief Write call statistics to a serial port as one line of text
+ *
+ * The line is comma separated: the name, the call count, the byte count, the
+ * error count, then the count of every latency bucket in order, followed by a
+ * newline. For example:
+ *
+ * ```
+ * imu_i2c,120,1440,2,0,0,0,3,117,0,...,0
+ * ```
+ *
+ * @param p_serial - serial port to write the line to
+ * @param p_name - name identifying the instrumented driver
+ * @param p_statistics - counters to write
+ */
+inline void write_statistics(hal::serial& p_serial,
+                             std::string_view p_name,
+                             call_statistics const& p_statistics)
+{
+  auto const write_all = [&p_serial](std::string_view p_text) {
+    std::span data(reinterpret_cast<hal::byte const*>(p_text.data()),
+                   p_text.size());
+    while (not data.empty()) {
+      data = data.subspan(p_serial.write(data).data.size());
+    }
+  };
+  auto const write_number = [&write_all](u32 p_value) {
+    std::array<char, 12> text{ ',' };
+    auto const end =
+      std::to_chars(text.data() + 1, text.data() + text.size(), p_value).ptr;
+    write_all(std::string_view(text.data(), end));
+  };
+
+  write_all(p_name);
+  write_number(p_statistics.calls);
+  write_number(p_statistics.bytes);
+  write_number(p_statistics.errors);
+  for (auto const count : p_statistics.latency) {
+    write_number(count);
+  }
+  write_all("\n");
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::call_recorder;
+using v5::call_statistics;
+using v5::instrumented_i2c;
+using v5::instrumented_serial;
+using v5::instrumented_spi_channel;
+using v5::latency_buckets;
+using v5::write_statistics;
+}  // namespace hal
@@ -119,6 +119,30 @@ public:
     driver_on_trigger(p_callback);
   }
 
+  /**
+   * @brief Set a callback larger than `hal::callback` for when the interrupt
+   * occurs
+   *
+   * Drivers store a `hal::callback`, so this registers a callback that
+   * forwards to p_callback by reference. The callable stays inline in
+   * p_callback, without heap allocation. Any state transitions before this
+   * function is called are lost.
+   *
+   * @tparam Capacity - storage capacity of p_callback in bytes, such as that
+   * of a `hal::callback_n`
+   * @param p_callback - function to execute when the trigger condition occurs.
+   * Must outlive its registration.
+   */
+  template<size_t Capacity>
+    requires(Capacity > sizeof(void*) * hal::callback_words)
+  void on_trigger(hal::inplace_function<handler, Capacity>& p_callback)
+  {
+    driver_on_trigger([&p_callback](bool p_state) { p_callback(p_state); });
+  }
+
+  /// Bytes each driver reserves to store the trigger callback
+  static constexpr size_t callback_storage = sizeof(hal::callback<handler>);
+
   virtual ~interrupt_pin() = default;
 
 private:
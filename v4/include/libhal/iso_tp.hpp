@@ -0,0 +1,588 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
+#include <span>
+
+#include "can.hpp"
+#include "error.hpp"
+#include "scatter_span.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief ISO-TP (ISO 15765-2) transport over a can_transceiver
+ *
+ * Carries messages of up to 4095 bytes, such as UDS diagnostic requests and
+ * firmware update blocks, over classic CAN frames using normal addressing.
+ * Messages of up to 7 bytes are sent as a single frame. Longer messages are
+ * sent as a first frame followed by consecutive frames, paced by the flow
+ * control frames of the receiver.
+ *
+ * Transmission reads directly from a scatter span, so a header and a payload
+ * held in separate buffers are sent without first copying them together.
+ * When the receiver allows a separation time of zero, consecutive frames are
+ * queued a window at a time with `can_transceiver::send(span)`, letting the
+ * driver fill every transmit mailbox at once rather than one frame per
+ * `poll()`. Reception writes each frame's data straight into a buffer given
+ * by the caller, and this node's flow control frames let the sender transmit
+ * `settings::block_size` frames before waiting for the next one.
+ *
+ * One transfer may be sent and one received at the same time. Progress is
+ * made in `poll()`, which reads new frames from the transceiver's receive
+ * buffer and sends the next window of consecutive frames. Call it from the
+ * main loop at least as often as frames can arrive, so the receive buffer
+ * does not wrap around between calls. Failures, such as a peer that stops
+ * responding, are reported through `transmit_status()` and `receive_status()`
+ * rather than exceptions.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::iso_tp link(transceiver, clock, { .transmit_id = 0x7E8,
+ *                                        .receive_id = 0x7E0 });
+ * std::array<hal::byte, 512> request;
+ * link.receive(request);
+ *
+ * while (true) {
+ *   link.poll();
+ *   if (link.receive_status() == hal::iso_tp::status::complete) {
+ *     auto const response = handle(link.received());
+ *     link.send(response);
+ *     link.receive(request);
+ *   }
+ * }
+ * ```
+ */
+class iso_tp
+{
+public:
+  /// Largest message that fits the 12 bit length of a first frame
+  static constexpr usize max_message_size = 4095;
+  /// Most consecutive frames passed to `can_transceiver::send(span)` at once
+  static constexpr usize window_frames = 8;
+
+  /**
+   * @brief Addressing and flow control of an ISO-TP link
+   *
+   */
+  struct settings
+  {
+    /// ID of the data and flow control frames sent by this node
+    u32 transmit_id = 0;
+    /// ID of the data and flow control frames sent by the peer
+    u32 receive_id = 0;
+    /// Set to true if both IDs are extended 29-bit IDs
+    bool extended = false;
+    /// Consecutive frames the peer may send before waiting for another flow
+    /// control frame. 0 lets the peer send the whole message without
+    /// waiting. Smaller blocks let a slow receiver throttle the sender at the
+    /// cost of a flow control round trip per block.
+    u8 block_size = 0;
+    /// Minimum time the peer must leave between consecutive frames, encoded
+    /// as in ISO 15765-2: 0x00 to 0x7F milliseconds or 0xF1 to 0xF9 for 100
+    /// to 900 microseconds
+    u8 separation_time = 0;
+    /// Value of the unused bytes of frames shorter than 8 bytes. If
+    /// std::nullopt, frames only carry the bytes they use.
+    std::optional<hal::byte> padding = hal::byte{ 0xCC };
+    /// Time to wait for the peer's next flow control or consecutive frame
+    /// before giving up on a transfer
+    hal::time_duration timeout = std::chrono::milliseconds(1000);
+  };
+
+  /**
+   * @brief State of a transfer in one direction
+   *
+   */
+  enum class status : u8
+  {
+    /// No transfer requested
+    idle,
+    /// Transfer started and is waiting on the peer or on `poll()`
+    in_progress,
+    /// Transfer finished successfully
+    complete,
+    /// Peer did not send a flow control or consecutive frame in time
+    timed_out,
+    /// Message did not fit the receive buffer, or the peer reported that the
+    /// message does not fit its buffer
+    overflow,
+    /// Peer sent a frame out of sequence or with an invalid format
+    protocol_error,
+  };
+
+  /**
+   * @brief Construct an ISO-TP link
+   *
+   * Frames received before construction are ignored.
+   *
+   * @param p_transceiver - transceiver to send and receive frames through.
+   * Must outlive this object.
+   * @param p_clock - clock used for separation times and timeouts. Must
+   * outlive this object.
+   * @param p_settings - addressing and flow control of the link
+   */
+  iso_tp(can_transceiver& p_transceiver,
+         hal::steady_clock& p_clock,
+         settings const& p_settings)
+    : m_transceiver(&p_transceiver)
+    , m_clock(&p_clock)
+    , m_settings(p_settings)
+    , m_ticks_per_second(static_cast<u64>(p_clock.frequency()))
+    , m_timeout_ticks(static_cast<u64>(p_settings.timeout.count()) *
+                      m_ticks_per_second / 1'000'000'000)
+    , m_cursor(p_transceiver.receive_cursor())
+  {
+  }
+
+  iso_tp(iso_tp const&) = delete;
+  iso_tp& operator=(iso_tp const&) = delete;
+  iso_tp(iso_tp&&) = delete;
+  iso_tp& operator=(iso_tp&&) = delete;
+  ~iso_tp() = default;
+
+  /**
+   * @brief Start sending a message
+   *
+   * Single frame messages are sent before returning. Otherwise the first
+   * frame is sent and the rest of the message follows from `poll()` as the
+   * peer allows. The status of a previous transfer is replaced.
+   *
+   * @param p_message - message to send. The segments and their contents must
+   * stay valid until `transmit_status()` is no longer `status::in_progress`.
+   * @throws hal::device_or_resource_busy - if a transmission is in progress
+   * @throws hal::argument_out_of_domain - if the message is empty
+   * @throws hal::message_size - if the message is larger than
+   * `max_message_size`
+   */
+  void send(scatter_span<hal::byte const> p_message)
+  {
+    if (m_transmit_status == status::in_progress) {
+      hal::safe_throw(hal::device_or_resource_busy(this));
+    }
+    auto const size = scatter_size(p_message);
+    if (size == 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    if (size > max_message_size) {
+      hal::safe_throw(hal::message_size(max_message_size, this));
+    }
+
+    m_source = detail::scatter_cursor<hal::byte const>(p_message);
+    m_remaining = size;
+    m_window_size = 0;
+    m_window_sent = 0;
+
+    if (size <= single_frame_capacity) {
+      auto frame = make_frame(1 + size);
+      frame.payload[0] = static_cast<hal::byte>(size);
+      take(std::span(frame.payload).subspan(1, size));
+      m_transceiver->send(frame);
+      m_transmit_status = status::complete;
+      return;
+    }
+
+    auto frame = make_frame(8);
+    frame.payload[0] = static_cast<hal::byte>(first_frame | (size >> 8));
+    frame.payload[1] = static_cast<hal::byte>(size & 0xFF);
+    take(std::span(frame.payload).subspan(2));
+    m_transceiver->send(frame);
+    m_sequence = 1;
+    m_awaiting_flow_control = true;
+    m_transmit_deadline = m_clock->uptime() + m_timeout_ticks;
+    m_transmit_status = status::in_progress;
+  }
+
+  /**
+   * @brief Start sending a message held in a single buffer
+   *
+   * @param p_message - message to send. Must stay valid until
+   * `transmit_status()` is no longer `status::in_progress`.
+   * @throws hal::device_or_resource_busy - if a transmission is in progress
+   * @throws hal::argument_out_of_domain - if the message is empty
+   * @throws hal::message_size - if the message is larger than
+   * `max_message_size`
+   */
+  void send(std::span<hal::byte const> p_message)
+  {
+    // Stored so the scatter span given to the cursor outlives this call
+    m_single_segment = p_message;
+    send(scatter_span<hal::byte const>(&m_single_segment, 1));
+  }
+
+  /**
+   * @brief Get the status of the last message sent
+   *
+   * @return status - status of the transmission
+   */
+  [[nodiscard]] status transmit_status() const
+  {
+    return m_transmit_status;
+  }
+
+  /**
+   * @brief Start listening for a message from the peer
+   *
+   * Frames of a message are written to p_buffer as they arrive. A message
+   * being received is abandoned.
+   *
+   * @param p_buffer - buffer to receive the message into. Must stay valid
+   * until `receive_status()` is no longer `status::in_progress`.
+   */
+  void receive(std::span<hal::byte> p_buffer)
+  {
+    m_buffer = p_buffer;
+    m_expected = 0;
+    m_received = 0;
+    m_receive_status = status::in_progress;
+  }
+
+  /**
+   * @brief Get the status of the message being received
+   *
+   * `status::in_progress` covers both waiting for a message to start and
+   * receiving its frames.
+   *
+   * @return status - status of the reception
+   */
+  [[nodiscard]] status receive_status() const
+  {
+    return m_receive_status;
+  }
+
+  /**
+   * @brief Get the message received so far
+   *
+   * @return std::span<hal::byte const> - the start of the receive buffer
+   * holding the bytes received, the whole message once `receive_status()` is
+   * `status::complete`
+   */
+  [[nodiscard]] std::span<hal::byte const> received() const
+  {
+    return m_buffer.first(m_received);
+  }
+
+  /**
+   * @brief Process received frames and send the next consecutive frames
+   *
+   */
+  void poll()
+  {
+    auto const now = m_clock->uptime();
+    auto const buffer = m_transceiver->receive_buffer();
+    auto const cursor = m_transceiver->receive_cursor();
+    for (auto i = m_cursor; i != cursor; i = (i + 1) % buffer.size()) {
+      auto const& frame = buffer[i];
+      if (frame.id == m_settings.receive_id &&
+          frame.extended == m_settings.extended && not frame.remote_request &&
+          frame.length != 0 && frame.length <= 8) {
+        process(frame, now);
+      }
+    }
+    m_cursor = cursor;
+
+    if (m_transmit_status == status::in_progress) {
+      if (m_awaiting_flow_control) {
+        if (now >= m_transmit_deadline) {
+          m_transmit_status = status::timed_out;
+        }
+      } else if (now >= m_next_frame) {
+        transmit_window(now);
+      }
+    }
+
+    if (m_receive_status == status::in_progress && m_expected != 0 &&
+        now >= m_receive_deadline) {
+      m_receive_status = status::timed_out;
+    }
+  }
+
+private:
+  static constexpr usize single_frame_capacity = 7;
+  static constexpr usize consecutive_frame_capacity = 7;
+
+  static constexpr u8 single_frame = 0x00;
+  static constexpr u8 first_frame = 0x10;
+  static constexpr u8 consecutive_frame = 0x20;
+  static constexpr u8 flow_control = 0x30;
+
+  static constexpr u8 continue_to_send = 0;
+  static constexpr u8 wait = 1;
+  static constexpr u8 flow_overflow = 2;
+
+  [[nodiscard]] can_message make_frame(usize p_length) const
+  {
+    can_message frame{ .id = m_settings.transmit_id,
+                       .extended = m_settings.extended,
+                       .length = 8 };
+    if (m_settings.padding) {
+      frame.payload.fill(*m_settings.padding);
+    } else {
+      frame.length = static_cast<u8>(p_length);
+    }
+    return frame;
+  }
+
+  /// Copy the next bytes of the message being sent into p_destination
+  void take(std::span<hal::byte> p_destination)
+  {
+    m_remaining -= p_destination.size();
+    while (not p_destination.empty()) {
+      auto const run = m_source.take(
+        std::min(m_source.available(), p_destination.size()));
+      std::ranges::copy(run, p_destination.begin());
+      p_destination = p_destination.subspan(run.size());
+    }
+  }
+
+  void transmit_window(u64 p_now)
+  {
+    if (m_window_sent == m_window_size) {
+      // Pace one frame at a time when the peer needs a gap between frames
+      auto frames = m_separation_ticks == 0 ? window_frames : 1;
+      if (m_block_remaining != 0) {
+        frames = std::min<usize>(frames, m_block_remaining);
+      }
+      m_window_size = 0;
+      m_window_sent = 0;
+      while (m_window_size < frames && m_remaining != 0) {
+        auto const length =
+          1 + std::min(m_remaining, consecutive_frame_capacity);
+        auto& frame = m_window[m_window_size++];
+        frame = make_frame(length);
+        frame.payload[0] = static_cast<hal::byte>(consecutive_frame |
+                                                  m_sequence);
+        take(std::span(frame.payload).subspan(1, length - 1));
+        m_sequence = (m_sequence + 1) & 0x0F;
+      }
+      if (m_block_remaining != 0) {
+        m_block_remaining -= static_cast<u8>(m_window_size);
+        m_block_exhausted = m_block_remaining == 0;
+      }
+    }
+
+    auto const pending = std::span<can_message const>(m_window)
+                           .first(m_window_size)
+                           .subspan(m_window_sent);
+    m_window_sent += m_transceiver->send(pending);
+    m_next_frame = p_now + m_separation_ticks;
+
+    if (m_window_sent != m_window_size) {
+      return;
+    }
+    if (m_remaining == 0) {
+      m_transmit_status = status::complete;
+    } else if (m_block_exhausted) {
+      m_awaiting_flow_control = true;
+      m_transmit_deadline = p_now + m_timeout_ticks;
+    }
+  }
+
+  void process(can_message const& p_frame, u64 p_now)
+  {
+    auto const type = p_frame.payload[0] & 0xF0;
+    switch (type) {
+      case single_frame:
+        receive_single(p_frame);
+        break;
+      case first_frame:
+        receive_first(p_frame, p_now);
+        break;
+      case consecutive_frame:
+        receive_consecutive(p_frame, p_now);
+        break;
+      case flow_control:
+        receive_flow_control(p_frame, p_now);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void receive_single(can_message const& p_frame)
+  {
+    if (m_receive_status != status::in_progress) {
+      return;
+    }
+    usize const size = p_frame.payload[0] & 0x0F;
+    if (size == 0 || size > single_frame_capacity || size >= p_frame.length) {
+      m_receive_status = status::protocol_error;
+      return;
+    }
+    if (size > m_buffer.size()) {
+      m_receive_status = status::overflow;
+      return;
+    }
+    std::ranges::copy(std::span(p_frame.payload).subspan(1, size),
+                      m_buffer.begin());
+    m_expected = 0;
+    m_received = size;
+    m_receive_status = status::complete;
+  }
+
+  void receive_first(can_message const& p_frame, u64 p_now)
+  {
+    if (m_receive_status != status::in_progress) {
+      return;
+    }
+    usize const size =
+      (static_cast<usize>(p_frame.payload[0] & 0x0F) << 8) | p_frame.payload[1];
+    if (p_frame.length != 8 || size <= single_frame_capacity) {
+      m_receive_status = status::protocol_error;
+      return;
+    }
+    if (size > m_buffer.size()) {
+      send_flow_control(flow_overflow);
+      m_receive_status = status::overflow;
+      return;
+    }
+    std::ranges::copy(std::span(p_frame.payload).subspan(2),
+                      m_buffer.begin());
+    m_expected = size;
+    m_received = 6;
+    m_expected_sequence = 1;
+    m_block_received = 0;
+    m_receive_deadline = p_now + m_timeout_ticks;
+    send_flow_control(continue_to_send);
+  }
+
+  void receive_consecutive(can_message const& p_frame, u64 p_now)
+  {
+    if (m_receive_status != status::in_progress || m_expected == 0) {
+      return;
+    }
+    auto const length =
+      std::min(m_expected - m_received, consecutive_frame_capacity);
+    if ((p_frame.payload[0] & 0x0F) != m_expected_sequence ||
+        p_frame.length < 1 + length) {
+      m_receive_status = status::protocol_error;
+      return;
+    }
+    std::ranges::copy(std::span(p_frame.payload).subspan(1, length),
+                      m_buffer.subspan(m_received).begin());
+    m_received += length;
+    m_expected_sequence = (m_expected_sequence + 1) & 0x0F;
+    m_receive_deadline = p_now + m_timeout_ticks;
+
+    if (m_received == m_expected) {
+      m_receive_status = status::complete;
+      return;
+    }
+    if (m_settings.block_size != 0 &&
+        ++m_block_received == m_settings.block_size) {
+      m_block_received = 0;
+      send_flow_control(continue_to_send);
+    }
+  }
+
+  void receive_flow_control(can_message const& p_frame, u64 p_now)
+  {
+    if (m_transmit_status != status::in_progress ||
+        not m_awaiting_flow_control) {
+      return;
+    }
+    if (p_frame.length < 3) {
+      m_transmit_status = status::protocol_error;
+      return;
+    }
+    switch (p_frame.payload[0] & 0x0F) {
+      case continue_to_send:
+        m_awaiting_flow_control = false;
+        m_block_remaining = p_frame.payload[1];
+        m_block_exhausted = false;
+        m_separation_ticks = separation_ticks(p_frame.payload[2]);
+        m_next_frame = p_now;
+        break;
+      case wait:
+        m_transmit_deadline = p_now + m_timeout_ticks;
+        break;
+      case flow_overflow:
+        m_transmit_status = status::overflow;
+        break;
+      default:
+        m_transmit_status = status::protocol_error;
+        break;
+    }
+  }
+
+  void send_flow_control(u8 p_flow_status)
+  {
+    auto frame = make_frame(3);
+    frame.payload[0] = static_cast<hal::byte>(flow_control | p_flow_status);
+    frame.payload[1] = m_settings.block_size;
+    frame.payload[2] = m_settings.separation_time;
+    m_transceiver->send(frame);
+  }
+
+  /// Convert an encoded separation time into ticks of the clock
+  [[nodiscard]] u64 separation_ticks(u8 p_separation_time) const
+  {
+    u64 microseconds = 0;
+    if (p_separation_time <= 0x7F) {
+      microseconds = p_separation_time * 1'000ULL;
+    } else if (p_separation_time >= 0xF1 && p_separation_time <= 0xF9) {
+      microseconds = (p_separation_time - 0xF0) * 100ULL;
+    } else {
+      // Reserved values must be treated as the longest separation time
+      microseconds = 127'000;
+    }
+    return microseconds * m_ticks_per_second / 1'000'000;
+  }
+
+  can_transceiver* m_transceiver;
+  hal::steady_clock* m_clock;
+  settings m_settings;
+  u64 m_ticks_per_second;
+  u64 m_timeout_ticks;
+  usize m_cursor;
+
+  // Transmission
+  detail::scatter_cursor<hal::byte const> m_source{
+    scatter_span<hal::byte const>{}
+  };
+  std::span<hal::byte const> m_single_segment{};
+  std::array<can_message, window_frames> m_window{};
+  usize m_window_size = 0;
+  usize m_window_sent = 0;
+  usize m_remaining = 0;
+  u64 m_transmit_deadline = 0;
+  u64 m_next_frame = 0;
+  u64 m_separation_ticks = 0;
+  status m_transmit_status = status::idle;
+  u8 m_sequence = 0;
+  u8 m_block_remaining = 0;
+  bool m_block_exhausted = false;
+  bool m_awaiting_flow_control = false;
+
+  // Reception
+  std::span<hal::byte> m_buffer{};
+  usize m_expected = 0;
+  usize m_received = 0;
+  u64 m_receive_deadline = 0;
+  status m_receive_status = status::idle;
+  u8 m_expected_sequence = 0;
+  u8 m_block_received = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::iso_tp;
+}  // namespace hal
@@ -0,0 +1,478 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "can.hpp"
+#include "functional.hpp"
+#include "interrupt_pin.hpp"
+#include "steady_clock.hpp"
+#include "timer.hpp"
+#include "units.hpp"
+
+/**
+ * @file isr_profiler.hpp
+ * @brief Duration and latency profiling of interrupt callbacks
+ *
+ * The callbacks registered with `interrupt_pin::on_trigger()`,
+ * `can_interrupt::on_receive()`, `timer::schedule()` and the endpoint
+ * `on_receive()` APIs run in interrupt context, where they delay every
+ * interrupt of equal or lower priority for as long as they run. The wrappers
+ * in this file timestamp the entry and exit of such callbacks with a
+ * `hal::steady_clock` and accumulate the durations into a
+ * `hal::isr_profile`, one per registration, so the worst offenders can be
+ * found with `hal::worst_case()`.
+ *
+ * Profiling costs two reads of the clock per call. Use a clock with a cheap
+ * uptime and a fine tick, such as one backed by the cycle counter of the
+ * processor, so that short callbacks are resolved.
+ */
+
+namespace hal::v5 {
+/**
+ * @brief Distribution of a set of measured durations
+ *
+ * Durations are in ticks of the clock that measured them. Bucket `i` of the
+ * histogram counts durations of `[2^(i-1), 2^i)` ticks, bucket 0 counts
+ * durations of 0 ticks and the last bucket also counts all longer durations.
+ */
+struct isr_statistics
+{
+  /// Number of buckets in the histogram
+  static constexpr usize histogram_buckets = 32;
+
+  /// Number of durations measured
+  u64 count = 0;
+  /// Shortest duration, `std::numeric_limits<u64>::max()` until measured
+  u64 min = std::numeric_limits<u64>::max();
+  /// Longest duration
+  u64 max = 0;
+  /// Sum of the durations, for computing the average and the load
+  u64 total = 0;
+  /// Logarithmic histogram of the durations
+  std::array<u32, histogram_buckets> histogram{};
+
+  /**
+   * @brief Add a measured duration
+   *
+   * @param p_ticks - duration in ticks
+   */
+  constexpr void add(u64 p_ticks)
+  {
+    count++;
+    min = std::min(min, p_ticks);
+    max = std::max(max, p_ticks);
+    total += p_ticks;
+    auto const bucket =
+      std::min<usize>(std::bit_width(p_ticks), histogram_buckets - 1);
+    histogram[bucket]++;
+  }
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  bool operator==(isr_statistics const&) const = default;
+};
+
+/**
+ * @brief Profile of the callback of one registration
+ *
+ * Accumulates the time between the entry and exit of each call of the
+ * callback. Profiles are updated from interrupt context, so read them while
+ * the profiled interrupt is disabled or idle to get consistent statistics.
+ */
+class isr_profile
+{
+public:
+  /**
+   * @param p_clock - clock timestamping the calls. Must outlive this object.
+   * @param p_name - name of the registration, for reports. Must outlive this
+   * object.
+   */
+  explicit isr_profile(hal::steady_clock& p_clock,
+                       std::string_view p_name = "")
+    : m_clock(&p_clock)
+    , m_name(p_name)
+  {
+  }
+
+  isr_profile(isr_profile const&) = delete;
+  isr_profile& operator=(isr_profile const&) = delete;
+  isr_profile(isr_profile&&) = delete;
+  isr_profile& operator=(isr_profile&&) = delete;
+  ~isr_profile() = default;
+
+  /**
+   * @brief Call a function, adding the duration of the call to the profile
+   *
+   * @param p_callable - function to call with no arguments
+   */
+  template<class Callable>
+  void measure(Callable&& p_callable)
+  {
+    auto const entry = m_clock->uptime();
+    p_callable();
+    m_statistics.add(m_clock->uptime() - entry);
+  }
+
+  /**
+   * @return isr_statistics const& - durations of the calls so far
+   */
+  [[nodiscard]] isr_statistics const& statistics() const
+  {
+    return m_statistics;
+  }
+
+  /**
+   * @brief Clear the statistics
+   *
+   */
+  void reset()
+  {
+    m_statistics = {};
+  }
+
+  /**
+   * @return std::string_view - name of the registration
+   */
+  [[nodiscard]] std::string_view name() const
+  {
+    return m_name;
+  }
+
+  /**
+   * @return hal::steady_clock& - clock timestamping the calls
+   */
+  [[nodiscard]] hal::steady_clock& clock() const
+  {
+    return *m_clock;
+  }
+
+  /**
+   * @brief Convert a number of ticks of the profile's clock to time
+   *
+   * @param p_ticks - ticks to convert
+   * @return time_duration - time of p_ticks
+   */
+  [[nodiscard]] time_duration to_duration(u64 p_ticks) const
+  {
+    return std::chrono::duration_cast<time_duration>(
+      std::chrono::duration<double>(static_cast<double>(p_ticks) /
+                                    m_clock->frequency()));
+  }
+
+private:
+  hal::steady_clock* m_clock;
+  std::string_view m_name;
+  isr_statistics m_statistics{};
+};
+
+/**
+ * @brief Find the profile with the longest call
+ *
+ * The longest call of a callback is how long it can block the interrupts
+ * at or below its priority.
+ *
+ * @param p_profiles - profiles to search, null entries are skipped
+ * @return isr_profile const* - profile with the longest call, or nullptr if no
+ * profile has measured a call
+ */
+[[nodiscard]] inline isr_profile const* worst_case(
+  std::span<isr_profile const* const> p_profiles)
+{
+  isr_profile const* worst = nullptr;
+  for (auto const* profile : p_profiles) {
+    if (profile == nullptr || profile->statistics().count == 0) {
+      continue;
+    }
+    if (worst == nullptr ||
+        profile->statistics().max > worst->statistics().max) {
+      worst = profile;
+    }
+  }
+  return worst;
+}
+
+/**
+ * @brief Callback wrapper profiling each call of a callback
+ *
+ * For registration points without a profiling driver wrapper, such as
+ * `hal::usb::out_endpoint::on_receive()`:
+ *
+ * ```
+ * hal::isr_profile profile(cycle_counter, "bulk out");
+ * hal::profiled_callback<void(hal::usb::out_endpoint::on_receive_tag)>
+ *   receive(profile, handle_bulk_out);
+ * bulk_out.on_receive(receive.callback());
+ * ```
+ *
+ * @tparam Signature - signature of the callback
+ */
+template<class Signature>
+class profiled_callback;
+
+template<class R, class... Args>
+class profiled_callback<R(Args...)>
+{
+public:
+  /**
+   * @param p_profile - profile of the calls. Must outlive this object.
+   * @param p_callback - callback to profile
+   */
+  profiled_callback(isr_profile& p_profile,
+                    hal::callback<R(Args...)> p_callback)
+    : m_profile(&p_profile)
+    , m_callback(p_callback)
+  {
+  }
+
+  profiled_callback(profiled_callback const&) = delete;
+  profiled_callback& operator=(profiled_callback const&) = delete;
+  profiled_callback(profiled_callback&&) = delete;
+  profiled_callback& operator=(profiled_callback&&) = delete;
+  ~profiled_callback() = default;
+
+  /**
+   * @return hal::callback<R(Args...)> - callback to register in place of the
+   * profiled callback. Must not outlive this object.
+   */
+  [[nodiscard]] hal::callback<R(Args...)> callback()
+  {
+    return [this](Args... p_args) -> R { return call(p_args...); };
+  }
+
+private:
+  R call(Args... p_args)
+  {
+    if constexpr (std::is_void_v<R>) {
+      m_profile->measure([&]() { m_callback(p_args...); });
+    } else {
+      std::optional<R> result;
+      m_profile->measure([&]() { result = m_callback(p_args...); });
+      return *result;
+    }
+  }
+
+  isr_profile* m_profile;
+  hal::callback<R(Args...)> m_callback;
+};
+
+/**
+ * @brief interrupt_pin profiling the trigger callback of another interrupt_pin
+ *
+ */
+class profiled_interrupt_pin : public hal::interrupt_pin
+{
+public:
+  /**
+   * @param p_pin - interrupt pin to forward to. Must outlive this object.
+   * @param p_profile - profile of the trigger callback. Must outlive this
+   * object.
+   */
+  profiled_interrupt_pin(hal::interrupt_pin& p_pin, isr_profile& p_profile)
+    : m_pin(&p_pin)
+    , m_profile(&p_profile)
+  {
+  }
+
+  profiled_interrupt_pin(profiled_interrupt_pin const&) = delete;
+  profiled_interrupt_pin& operator=(profiled_interrupt_pin const&) = delete;
+  profiled_interrupt_pin(profiled_interrupt_pin&&) = delete;
+  profiled_interrupt_pin& operator=(profiled_interrupt_pin&&) = delete;
+  ~profiled_interrupt_pin() override = default;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_pin->configure(p_settings);
+  }
+
+  void driver_on_trigger(hal::callback<handler> p_callback) override
+  {
+    m_callback = p_callback;
+    m_pin->on_trigger([this](bool p_state) {
+      m_profile->measure([this, p_state]() { m_callback(p_state); });
+    });
+  }
+
+  hal::interrupt_pin* m_pin;
+  isr_profile* m_profile;
+  hal::callback<handler> m_callback{};
+};
+
+/**
+ * @brief can_interrupt profiling the receive callbacks of another
+ * can_interrupt
+ *
+ * Callbacks set with `on_receive()` and `on_receive_batch()` are profiled
+ * into the same profile.
+ */
+class profiled_can_interrupt : public hal::can_interrupt
+{
+public:
+  /**
+   * @param p_interrupt - can interrupt to forward to. Must outlive this object.
+   * @param p_profile - profile of the receive callback. Must outlive this
+   * object.
+   */
+  profiled_can_interrupt(hal::can_interrupt& p_interrupt,
+                         isr_profile& p_profile)
+    : m_interrupt(&p_interrupt)
+    , m_profile(&p_profile)
+  {
+  }
+
+  profiled_can_interrupt(profiled_can_interrupt const&) = delete;
+  profiled_can_interrupt& operator=(profiled_can_interrupt const&) = delete;
+  profiled_can_interrupt(profiled_can_interrupt&&) = delete;
+  profiled_can_interrupt& operator=(profiled_can_interrupt&&) = delete;
+  ~profiled_can_interrupt() override = default;
+
+private:
+  void driver_on_receive(optional_receive_handler p_callback) override
+  {
+    m_callback = p_callback;
+    if (not m_callback) {
+      m_interrupt->on_receive(std::nullopt);
+      return;
+    }
+    m_interrupt->on_receive(
+      [this](on_receive_tag p_tag, can_message const& p_message) {
+        m_profile->measure([&]() { (*m_callback)(p_tag, p_message); });
+      });
+  }
+
+  void driver_on_receive_batch(optional_batch_receive_handler p_callback,
+                               batch_settings const& p_settings) override
+  {
+    m_batch_callback = p_callback;
+    if (not m_batch_callback) {
+      m_interrupt->on_receive_batch(std::nullopt, p_settings);
+      return;
+    }
+    m_interrupt->on_receive_batch(
+      [this](std::span<can_message const> p_messages) {
+        m_profile->measure([&]() { (*m_batch_callback)(p_messages); });
+      },
+      p_settings);
+  }
+
+  hal::can_interrupt* m_interrupt;
+  isr_profile* m_profile;
+  optional_receive_handler m_callback{};
+  optional_batch_receive_handler m_batch_callback{};
+};
+
+/**
+ * @brief timer profiling the callbacks scheduled on another timer
+ *
+ * Besides the duration of each callback, measures its latency: the time from
+ * the scheduled expiry to the entry of the callback, which includes the time
+ * the timer interrupt was blocked by other interrupts.
+ */
+class profiled_timer : public hal::timer
+{
+public:
+  /**
+   * @param p_timer - timer to forward to. Must outlive this object.
+   * @param p_profile - profile of the callbacks. Must outlive this object.
+   */
+  profiled_timer(hal::timer& p_timer, isr_profile& p_profile)
+    : m_timer(&p_timer)
+    , m_profile(&p_profile)
+  {
+  }
+
+  profiled_timer(profiled_timer const&) = delete;
+  profiled_timer& operator=(profiled_timer const&) = delete;
+  profiled_timer(profiled_timer&&) = delete;
+  profiled_timer& operator=(profiled_timer&&) = delete;
+  ~profiled_timer() override = default;
+
+  /**
+   * @return isr_statistics const& - latencies of the callbacks, in ticks of
+   * the profile's clock
+   */
+  [[nodiscard]] isr_statistics const& latency() const
+  {
+    return m_latency;
+  }
+
+  /**
+   * @brief Clear the latency statistics
+   *
+   */
+  void reset_latency()
+  {
+    m_latency = {};
+  }
+
+private:
+  bool driver_is_running() override
+  {
+    return m_timer->is_running();
+  }
+
+  void driver_cancel() override
+  {
+    m_timer->cancel();
+  }
+
+  void driver_schedule(hal::callback<void(void)> p_callback,
+                       hal::time_duration p_delay) override
+  {
+    auto& clock = m_profile->clock();
+    auto const delay_ticks = static_cast<u64>(
+      std::chrono::duration<double>(p_delay).count() * clock.frequency());
+    m_callback = p_callback;
+    m_expiry = clock.uptime() + delay_ticks;
+    m_timer->schedule(
+      [this]() {
+        auto const entry = m_profile->clock().uptime();
+        m_latency.add(entry > m_expiry ? entry - m_expiry : 0);
+        // The callback may schedule again, replacing m_callback
+        auto callback = m_callback;
+        m_profile->measure(callback);
+      },
+      p_delay);
+  }
+
+  hal::timer* m_timer;
+  isr_profile* m_profile;
+  hal::callback<void(void)> m_callback{};
+  isr_statistics m_latency{};
+  u64 m_expiry = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::isr_profile;
+using v5::isr_statistics;
+using v5::profiled_callback;
+using v5::profiled_can_interrupt;
+using v5::profiled_interrupt_pin;
+using v5::profiled_timer;
+using v5::worst_case;
+}  // namespace hal
@@ -0,0 +1,289 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "initializers.hpp"
+#include "pointers.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Concept for any of the selector types of initializers.hpp
+ *
+ * @tparam T - `hal::port_t`, `hal::pin_t`, `hal::bus_t`, `hal::channel_t` or
+ * `hal::buffer_t`
+ */
+template<typename T>
+concept selector_param = port_param<T> || pin_param<T> || bus_param<T> ||
+                         channel_param<T> || buffer_param<T>;
+
+/**
+ * @brief A driver constructed the first time it is requested
+ *
+ * Created with `hal::lazy()` and held by a `hal::lazy_registry`.
+ *
+ * @tparam Interface - interface the driver is accessed through
+ * @tparam Key - selector that identifies the driver within its registry
+ * @tparam Factory - callable taking a `std::pmr::polymorphic_allocator<>` and
+ * returning a `strong_ptr` to the driver
+ */
+template<typename Interface, selector_param Key, typename Factory>
+class lazy_entry
+{
+public:
+  /// Interface the driver is accessed through
+  using interface_type = Interface;
+  /// Selector that identifies the driver
+  using key_type = Key;
+
+  static_assert(
+    std::convertible_to<
+      std::invoke_result_t<Factory&, std::pmr::polymorphic_allocator<>>,
+      strong_ptr<Interface>>,
+    "Factory must return a strong_ptr convertible to strong_ptr<Interface>");
+
+  /**
+   * @brief Construct an entry, without constructing the driver
+   *
+   * @param p_factory - called once, on first access, to construct the driver
+   */
+  constexpr lazy_entry(Key, Factory p_factory)
+    : m_factory(std::move(p_factory))
+  {
+  }
+
+  /**
+   * @brief Get the driver, constructing it if this is the first access
+   *
+   * @param p_allocator - allocator to pass to the factory
+   * @return strong_ptr<Interface> - the driver
+   * @throws any exception thrown by the factory, in which case the driver is
+   * not constructed and the next access calls the factory again
+   */
+  strong_ptr<Interface> get(std::pmr::polymorphic_allocator<> p_allocator)
+  {
+    if (not m_instance) {
+      m_instance = strong_ptr<Interface>(m_factory(p_allocator));
+    }
+    return m_instance.value();
+  }
+
+  /**
+   * @brief Get the driver only if it has already been constructed
+   *
+   * @return optional_ptr<Interface> - the driver, or empty if it has not been
+   * accessed
+   */
+  [[nodiscard]] optional_ptr<Interface> try_get() const
+  {
+    return m_instance;
+  }
+
+  /**
+   * @brief Drop the entry's reference to the driver
+   *
+   * @see lazy_registry::release
+   */
+  void release()
+  {
+    m_instance = nullptr;
+  }
+
+private:
+  Factory m_factory;
+  optional_ptr<Interface> m_instance{};
+};
+
+/**
+ * @brief Create a lazily constructed driver entry for a `hal::lazy_registry`
+ *
+ * @tparam Interface - interface the driver is accessed through
+ * @param p_key - selector that identifies the driver, such as `hal::port<0>`
+ * @param p_factory - callable taking a `std::pmr::polymorphic_allocator<>` and
+ * returning a `strong_ptr` to the driver
+ * @return lazy_entry - entry to pass to a `hal::lazy_registry`
+ */
+template<typename Interface, selector_param Key, typename Factory>
+[[nodiscard]] constexpr auto lazy(Key p_key, Factory p_factory)
+{
+  return lazy_entry<Interface, Key, Factory>(p_key, std::move(p_factory));
+}
+
+/**
+ * @brief Registry of drivers constructed on first access
+ *
+ * Boot code that constructs and configures every driver up front delays the
+ * first run of the control loop and powers up peripherals, such as an SD card
+ * or USB, that a product may not use for seconds or at all. A lazy registry
+ * instead holds a factory per driver and calls it the first time the driver is
+ * requested. Drivers are identified by the selectors of initializers.hpp, the
+ * same `hal::port<N>`, `hal::bus<N>` and similar values passed to their
+ * constructors. Lookup happens at compile time, so requesting a selector that
+ * is not registered fails to compile and `get()` returns the registered
+ * interface type.
+ *
+ * The registry keeps a reference to every driver it constructs. Calling
+ * `release()` drops that reference, so the driver is destroyed, and its
+ * peripheral can be powered down, once the application releases its own
+ * references. A later `get()` constructs it again.
+ *
+ * The registry is not thread safe: access it from one context at a time.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::lazy_registry drivers(
+ *   allocator,
+ *   hal::lazy<hal::v5::serial>(hal::port<0>, [](auto p_allocator) {
+ *     return hal::make_strong_ptr<mcu::uart>(p_allocator, hal::port<0>);
+ *   }),
+ *   hal::lazy<hal::i2c>(hal::bus<1>, [](auto p_allocator) {
+ *     return hal::make_strong_ptr<mcu::i2c>(p_allocator, hal::bus<1>);
+ *   }));
+ *
+ * // The UART is constructed here, the I2C bus remains untouched
+ * auto console = drivers.get(hal::port<0>);
+ * ```
+ *
+ * @tparam Entries - `hal::lazy_entry` types, each with a different key
+ */
+template<typename... Entries>
+class lazy_registry
+{
+public:
+  /**
+   * @brief Construct a registry without constructing any driver
+   *
+   * @param p_allocator - allocator passed to each factory
+   * @param p_entries - entries created with `hal::lazy()`
+   */
+  explicit lazy_registry(std::pmr::polymorphic_allocator<> p_allocator,
+                         Entries... p_entries)
+    : m_allocator(p_allocator)
+    , m_entries(std::move(p_entries)...)
+  {
+  }
+
+  lazy_registry(lazy_registry const&) = delete;
+  lazy_registry& operator=(lazy_registry const&) = delete;
+  lazy_registry(lazy_registry&&) = delete;
+  lazy_registry& operator=(lazy_registry&&) = delete;
+  ~lazy_registry() = default;
+
+  /**
+   * @brief Get a driver, constructing it if this is the first access
+   *
+   * @param p_key - selector the driver was registered with
+   * @return strong_ptr<Interface> - the driver, as its registered interface
+   * @throws any exception thrown by the driver's factory
+   */
+  template<selector_param Key>
+  auto get(Key)
+  {
+    return entry<Key>().get(m_allocator);
+  }
+
+  /**
+   * @brief Get a driver only if it has already been constructed
+   *
+   * @param p_key - selector the driver was registered with
+   * @return optional_ptr<Interface> - the driver, or empty if it has not been
+   * accessed since construction or the last release
+   */
+  template<selector_param Key>
+  [[nodiscard]] auto try_get(Key) const
+  {
+    return entry<Key>().try_get();
+  }
+
+  /**
+   * @brief Drop the registry's reference to a driver
+   *
+   * The driver is destroyed once no other `strong_ptr` refers to it.
+   *
+   * @param p_key - selector the driver was registered with
+   */
+  template<selector_param Key>
+  void release(Key)
+  {
+    entry<Key>().release();
+  }
+
+  /**
+   * @brief Get the number of drivers currently held by the registry
+   *
+   * @return usize - drivers constructed and not released
+   */
+  [[nodiscard]] usize constructed() const
+  {
+    return std::apply(
+      [](auto const&... p_entry) -> usize {
+        return (usize{ 0 } + ... + (p_entry.try_get() ? 1U : 0U));
+      },
+      m_entries);
+  }
+
+private:
+  template<typename Key>
+  static constexpr usize index_of()
+  {
+    constexpr std::array matches{
+      std::is_same_v<Key, typename Entries::key_type>...
+    };
+    usize count = 0;
+    usize index = 0;
+    for (usize i = 0; i < matches.size(); i++) {
+      if (matches[i]) {
+        count++;
+        index = i;
+      }
+    }
+    return count == 1 ? index : matches.size();
+  }
+
+  template<typename Key>
+  auto& entry()
+  {
+    static_assert(index_of<Key>() < sizeof...(Entries),
+                  "Selector is not registered exactly once in this registry");
+    return std::get<index_of<Key>()>(m_entries);
+  }
+
+  template<typename Key>
+  auto const& entry() const
+  {
+    static_assert(index_of<Key>() < sizeof...(Entries),
+                  "Selector is not registered exactly once in this registry");
+    return std::get<index_of<Key>()>(m_entries);
+  }
+
+  std::pmr::polymorphic_allocator<> m_allocator;
+  std::tuple<Entries...> m_entries;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::lazy;
+using v5::lazy_entry;
+using v5::lazy_registry;
+using v5::selector_param;
+}  // namespace hal
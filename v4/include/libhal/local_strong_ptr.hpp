@@ -0,0 +1,344 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "units.hpp"
+
+namespace hal::v5 {
+template<typename T>
+class local_strong_ptr;
+
+namespace detail {
+/**
+ * @brief Control block for single context reference counting - type erased.
+ *
+ * Same as `ref_info` but with a plain integer count and without weak
+ * references.
+ */
+struct local_ref_info
+{
+  /**
+   * @brief Destroy function for ref counted object
+   *
+   * Destroys the object and returns the total size of the object wrapped in a
+   * ref count object.
+   */
+  using destroy_fn_t = usize(void const*);
+
+  std::pmr::polymorphic_allocator<> allocator;
+  destroy_fn_t* destroy;
+  /// Initialize to 1 since creation implies a reference
+  i32 strong_count = 1;
+};
+
+/**
+ * @brief Release strong reference from a single context control block
+ *
+ * If this was the last reference, the pointed-to object will be destroyed and
+ * its memory deallocated.
+ *
+ * @param p_info Pointer to the control block
+ */
+inline void local_ptr_release(local_ref_info* p_info)
+{
+  if (--p_info->strong_count == 0) {
+    usize const object_size = p_info->destroy(p_info);
+    // Save allocator for deallocating
+    auto alloc = p_info->allocator;
+    alloc.deallocate_bytes(p_info, object_size);
+  }
+}
+
+/**
+ * @brief A wrapper that contains both the local_ref_info and the object
+ *
+ * @tparam T The type of the managed object
+ */
+template<typename T>
+struct local_rc
+{
+  local_ref_info m_info;
+  T m_object;
+
+  // Constructor that forwards arguments to the object
+  template<typename... Args>
+  local_rc(std::pmr::polymorphic_allocator<> p_alloc, Args&&... args)
+    : m_info{ .allocator = p_alloc, .destroy = &destroy_function }
+    , m_object(std::forward<Args>(args)...)
+  {
+  }
+
+  // Static function to destroy an instance and return its size
+  static usize destroy_function(void const* p_object)
+  {
+    auto const* obj = static_cast<local_rc<T> const*>(p_object);
+    obj->m_object.~T();
+    return sizeof(local_rc<T>);
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief A non-nullable strong_ptr counted with plain, non-atomic integers
+ *
+ * `hal::strong_ptr` counts references with `std::atomic`, which on cores
+ * without exclusive load/store instructions, such as the Cortex-M0, compiles to
+ * interrupt-disable sequences or library calls on every copy.
+ * `local_strong_ptr` has the same semantics as `hal::strong_ptr` but copying
+ * is a plain increment.
+ *
+ * Only use this pointer when every copy of it, and the object it manages, is
+ * used from a single execution context. Copying or destroying copies of the
+ * same pointer from both a thread and an interrupt, or from two threads, is
+ * undefined behavior. Weak references and aliasing are not supported; use
+ * `hal::strong_ptr` if they are needed.
+ *
+ * Example usage:
+ *
+ * ```C++
+ * auto ptr = hal::make_local_strong_ptr<my_i2c_driver>(allocator, arg1);
+ * ptr->configure({ .clock_rate = 250_kHz });
+ * ```
+ *
+ * @tparam T The type of the managed object
+ */
+template<typename T>
+class local_strong_ptr
+{
+public:
+  using element_type = T;
+
+  /// Delete default constructor - local_strong_ptr must always be valid
+  local_strong_ptr() = delete;
+
+  /// Delete nullptr constructor - local_strong_ptr must always be valid
+  local_strong_ptr(std::nullptr_t) = delete;
+
+  /**
+   * @brief Copy constructor
+   *
+   * Creates a new strong reference to the same object.
+   *
+   * @param p_other The local_strong_ptr to copy from
+   */
+  local_strong_ptr(local_strong_ptr const& p_other) noexcept
+    : m_ctrl(p_other.m_ctrl)
+    , m_ptr(p_other.m_ptr)
+  {
+    m_ctrl->strong_count++;
+  }
+
+  /**
+   * @brief Converting copy constructor
+   *
+   * @tparam U A type convertible to T
+   * @param p_other The local_strong_ptr to copy from
+   */
+  template<typename U>
+  local_strong_ptr(local_strong_ptr<U> const& p_other) noexcept
+    requires(std::is_convertible_v<U*, T*>)
+    : m_ctrl(p_other.m_ctrl)
+    , m_ptr(p_other.m_ptr)
+  {
+    m_ctrl->strong_count++;
+  }
+
+  /**
+   * @brief Move constructor that intentionally behaves like a copy constructor
+   * for safety
+   *
+   * See `hal::strong_ptr`'s move constructor for the rationale.
+   *
+   * @param p_other The local_strong_ptr to "move" from (actually copied)
+   */
+  local_strong_ptr(local_strong_ptr&& p_other) noexcept
+    : local_strong_ptr(std::as_const(p_other))
+  {
+  }
+
+  /**
+   * @brief Destructor
+   *
+   * Decrements the reference count and destroys the managed object
+   * if this was the last reference.
+   */
+  ~local_strong_ptr()
+  {
+    detail::local_ptr_release(m_ctrl);
+  }
+
+  /**
+   * @brief Copy assignment operator
+   *
+   * @param p_other The local_strong_ptr to copy from
+   * @return Reference to *this
+   */
+  local_strong_ptr& operator=(local_strong_ptr const& p_other) noexcept
+  {
+    // Increment first so that self assignment is safe without a branch
+    p_other.m_ctrl->strong_count++;
+    detail::local_ptr_release(m_ctrl);
+    m_ctrl = p_other.m_ctrl;
+    m_ptr = p_other.m_ptr;
+    return *this;
+  }
+
+  /**
+   * @brief Converting copy assignment operator
+   *
+   * @tparam U A type convertible to T
+   * @param p_other The local_strong_ptr to copy from
+   * @return Reference to *this
+   */
+  template<typename U>
+  local_strong_ptr& operator=(local_strong_ptr<U> const& p_other) noexcept
+    requires(std::is_convertible_v<U*, T*>)
+  {
+    p_other.m_ctrl->strong_count++;
+    detail::local_ptr_release(m_ctrl);
+    m_ctrl = p_other.m_ctrl;
+    m_ptr = p_other.m_ptr;
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator that behaves like a copy assignment for
+   * safety
+   *
+   * @param p_other The local_strong_ptr to "move" from (actually copied)
+   * @return Reference to *this
+   */
+  local_strong_ptr& operator=(local_strong_ptr&& p_other) noexcept
+  {
+    return *this = std::as_const(p_other);
+  }
+
+  /**
+   * @brief Swap the contents of this local_strong_ptr with another
+   *
+   * @param p_other The local_strong_ptr to swap with
+   */
+  void swap(local_strong_ptr& p_other) noexcept
+  {
+    std::swap(m_ctrl, p_other.m_ctrl);
+    std::swap(m_ptr, p_other.m_ptr);
+  }
+
+  /**
+   * @brief Disable dereferencing for r-values (temporaries)
+   */
+  T& operator*() && = delete;
+
+  /**
+   * @brief Disable member access for r-values (temporaries)
+   */
+  T* operator->() && = delete;
+
+  /**
+   * @brief Dereference operator to access the managed object
+   *
+   * @return Reference to the managed object
+   */
+  [[nodiscard]] T& operator*() const& noexcept
+  {
+    return *m_ptr;
+  }
+
+  /**
+   * @brief Member access operator to access the managed object
+   *
+   * @return Pointer to the managed object
+   */
+  [[nodiscard]] T* operator->() const& noexcept
+  {
+    return m_ptr;
+  }
+
+  /**
+   * @brief Get the current reference count
+   *
+   * This is primarily for testing purposes.
+   *
+   * @return The number of references to the managed object
+   */
+  [[nodiscard]] i32 use_count() const noexcept
+  {
+    return m_ctrl->strong_count;
+  }
+
+private:
+  template<class U, typename... Args>
+  friend local_strong_ptr<U> make_local_strong_ptr(
+    std::pmr::polymorphic_allocator<>,
+    Args&&...);
+
+  template<typename U>
+  friend class local_strong_ptr;
+
+  local_strong_ptr(detail::local_ref_info* p_ctrl, T* p_ptr) noexcept
+    : m_ctrl(p_ctrl)
+    , m_ptr(p_ptr)
+  {
+  }
+
+  detail::local_ref_info* m_ctrl;
+  T* m_ptr;
+};
+
+/**
+ * @brief Non-member swap for local_strong_ptr
+ *
+ * @tparam T The type of the managed object
+ * @param p_lhs First local_strong_ptr to swap
+ * @param p_rhs Second local_strong_ptr to swap
+ */
+template<typename T>
+void swap(local_strong_ptr<T>& p_lhs, local_strong_ptr<T>& p_rhs) noexcept
+{
+  p_lhs.swap(p_rhs);
+}
+
+/**
+ * @brief Factory function to create a local_strong_ptr with automatic
+ * construction detection
+ *
+ * @tparam T The type of object to create
+ * @tparam Args Types of arguments to forward to the constructor
+ * @param p_alloc Allocator to use for memory allocation
+ * @param p_args Arguments to forward to the constructor
+ * @return A local_strong_ptr managing the newly created object
+ * @throws Any exception thrown by the object's constructor
+ * @throws std::bad_alloc if memory allocation fails
+ */
+template<class T, typename... Args>
+[[nodiscard]] inline local_strong_ptr<T> make_local_strong_ptr(
+  std::pmr::polymorphic_allocator<> p_alloc,
+  Args&&... p_args)
+{
+  using rc_t = detail::local_rc<T>;
+  rc_t* obj = p_alloc.new_object<rc_t>(p_alloc, std::forward<Args>(p_args)...);
+  return local_strong_ptr<T>(&obj->m_info, &obj->m_object);
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::local_strong_ptr;
+using v5::make_local_strong_ptr;
+}  // namespace hal
@@ -0,0 +1,259 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <span>
+#include <type_traits>
+
+#include "units.hpp"
+
+/**
+ * @file lookup_table.hpp
+ * @brief Calibration curves tabulated at compile time
+ *
+ * Linearizing a thermistor with the Steinhart-Hart equation, or a shunt
+ * amplifier with a polynomial, costs a `log()` or `pow()` per sample, hundreds
+ * of cycles without an FPU. `hal::make_lookup_table()` evaluates the curve at
+ * evenly spaced points while compiling, so a `constexpr` table is placed in
+ * flash, and each sample costs an index calculation and a linear
+ * interpolation.
+ *
+ * `std::log()` and `std::exp()` are not `constexpr` in C++20, so
+ * `hal::constexpr_log()` and `hal::constexpr_exp()` are provided for writing
+ * curves that can be tabulated.
+ *
+ * Example usage:
+ *
+ * ```
+ * // 10k NTC on the low side of a divider with a 10k resistor, read by an ADC
+ * // as a fraction of the reference voltage.
+ * constexpr auto ntc = hal::make_lookup_table<129>(0.02f, 0.98f, [](double x) {
+ *   auto const resistance = 10'000.0 * x / (1.0 - x);
+ *   auto const ln_r = hal::constexpr_log(resistance);
+ *   auto const inverse_kelvin =
+ *     1.009249522e-3 + 2.378405444e-4 * ln_r + 2.019202697e-7 * ln_r * ln_r *
+ *     ln_r;
+ *   return (1.0 / inverse_kelvin) - 273.15;
+ * });
+ *
+ * hal::celsius driver_read() override
+ * {
+ *   return ntc(m_adc->read());
+ * }
+ * ```
+ */
+
+namespace hal::v5 {
+/**
+ * @brief Natural logarithm usable in constant expressions
+ *
+ * Accurate to within a few units in the last place of a double.
+ *
+ * @param p_value - positive value
+ * @return constexpr double - ln(p_value), or 0 if p_value is not positive
+ */
+[[nodiscard]] constexpr double constexpr_log(double p_value)
+{
+  constexpr double ln2 = 0.693147180559945309417232121458;
+  if (not(p_value > 0.0)) {
+    return 0.0;
+  }
+
+  // Reduce to a mantissa in [1, 2) and a power of two
+  int exponent = 0;
+  while (p_value >= 2.0) {
+    p_value /= 2.0;
+    exponent++;
+  }
+  while (p_value < 1.0) {
+    p_value *= 2.0;
+    exponent--;
+  }
+
+  // ln(m) = 2 * atanh((m - 1) / (m + 1)), which converges quickly for m < 2
+  auto const z = (p_value - 1.0) / (p_value + 1.0);
+  auto const z2 = z * z;
+  double term = z;
+  double sum = 0.0;
+  for (int n = 1; n < 60; n += 2) {
+    sum += term / n;
+    term *= z2;
+  }
+  return (2.0 * sum) + (exponent * ln2);
+}
+
+/**
+ * @brief Exponential function usable in constant expressions
+ *
+ * @param p_value - exponent
+ * @return constexpr double - e raised to p_value
+ */
+[[nodiscard]] constexpr double constexpr_exp(double p_value)
+{
+  constexpr double ln2 = 0.693147180559945309417232121458;
+
+  // Reduce to e^r * 2^k with |r| <= ln(2) / 2
+  auto const k = static_cast<long long>(p_value / ln2 +
+                                        (p_value < 0.0 ? -0.5 : 0.5));
+  auto const r = p_value - (static_cast<double>(k) * ln2);
+
+  double term = 1.0;
+  double sum = 1.0;
+  for (int n = 1; n < 30; n++) {
+    term *= r / n;
+    sum += term;
+  }
+
+  for (auto i = k; i > 0; i--) {
+    sum *= 2.0;
+  }
+  for (auto i = k; i < 0; i++) {
+    sum /= 2.0;
+  }
+  return sum;
+}
+
+/**
+ * @brief A curve sampled at evenly spaced points, interpolated linearly
+ *
+ * Created with `hal::make_lookup_table()`. Inputs outside of the table's range
+ * are clamped to its first or last point.
+ *
+ * @tparam Points - number of samples, at least 2. More points reduce the
+ * interpolation error, which shrinks with the square of the spacing, at the
+ * cost of 4 bytes of flash each.
+ */
+template<usize Points>
+class lookup_table
+{
+public:
+  static_assert(Points >= 2, "A lookup table needs at least 2 points");
+
+  /**
+   * @brief Construct a table from samples
+   *
+   * @param p_first - input of the first sample
+   * @param p_last - input of the last sample, greater than p_first
+   * @param p_samples - outputs at evenly spaced inputs from p_first to p_last
+   */
+  constexpr lookup_table(float p_first,
+                         float p_last,
+                         std::array<float, Points> p_samples)
+    : m_samples(p_samples)
+    , m_first(p_first)
+    , m_last(p_last)
+    , m_inverse_step(static_cast<float>(Points - 1) / (p_last - p_first))
+  {
+  }
+
+  /**
+   * @brief Look up and interpolate the curve
+   *
+   * @param p_input - input to evaluate the curve at
+   * @return constexpr float - the interpolated output, clamped to the outputs
+   * at the ends of the table
+   */
+  [[nodiscard]] constexpr float operator()(float p_input) const
+  {
+    if (not(p_input > m_first)) {
+      return m_samples.front();
+    }
+    auto const position = (p_input - m_first) * m_inverse_step;
+    auto const index = static_cast<usize>(position);
+    if (index >= Points - 1) {
+      return m_samples.back();
+    }
+    auto const fraction = position - static_cast<float>(index);
+    auto const low = m_samples[index];
+    return low + ((m_samples[index + 1] - low) * fraction);
+  }
+
+  /**
+   * @brief Get the input of the first sample
+   *
+   * @return constexpr float - lower end of the table's range
+   */
+  [[nodiscard]] constexpr float first() const
+  {
+    return m_first;
+  }
+
+  /**
+   * @brief Get the input of the last sample
+   *
+   * @return constexpr float - upper end of the table's range
+   */
+  [[nodiscard]] constexpr float last() const
+  {
+    return m_last;
+  }
+
+  /**
+   * @brief Get the samples
+   *
+   * @return constexpr std::span<float const, Points> - outputs at evenly
+   * spaced inputs from `first()` to `last()`
+   */
+  [[nodiscard]] constexpr std::span<float const, Points> samples() const
+  {
+    return m_samples;
+  }
+
+private:
+  std::array<float, Points> m_samples;
+  float m_first;
+  float m_last;
+  float m_inverse_step;
+};
+
+/**
+ * @brief Tabulate a calibration curve at compile time
+ *
+ * The curve is evaluated in double precision at `Points` evenly spaced inputs
+ * from p_first to p_last. Declare the result `constexpr` so the table is
+ * computed while compiling and placed in flash.
+ *
+ * @tparam Points - number of samples, at least 2
+ * @param p_first - start of the input range
+ * @param p_last - end of the input range, greater than p_first
+ * @param p_curve - constexpr callable taking a double input and returning
+ * the output
+ * @return constexpr lookup_table<Points> - the tabulated curve
+ */
+template<usize Points, typename Curve>
+  requires std::convertible_to<std::invoke_result_t<Curve&, double>, double>
+[[nodiscard]] constexpr lookup_table<Points> make_lookup_table(float p_first,
+                                                               float p_last,
+                                                               Curve p_curve)
+{
+  static_assert(Points >= 2, "A lookup table needs at least 2 points");
+  std::array<float, Points> samples{};
+  auto const span = static_cast<double>(p_last) - p_first;
+  for (usize i = 0; i < Points; i++) {
+    auto const input = p_first + (span * static_cast<double>(i) / (Points - 1));
+    samples[i] = static_cast<float>(p_curve(input));
+  }
+  return lookup_table<Points>(p_first, p_last, samples);
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::constexpr_exp;
+using v5::constexpr_log;
+using v5::lookup_table;
+using v5::make_lookup_table;
+}  // namespace hal
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <optional>
+#include <span>
+
 #include "units.hpp"
 
 namespace hal {
@@ -67,9 +70,55 @@ public:
     return driver_read();
   }
 
+  /**
+   * @brief Read multiple samples from the device in a single transfer
+   *
+   * Devices with a hardware FIFO drain as many buffered samples as fit into
+   * `p_samples` in one bus burst instead of one transaction per sample. Samples
+   * are ordered oldest first, and the last sample is the newest. If
+   * `output_data_rate()` is known, sample `i` of `n` was taken
+   * `(n - 1 - i) / output_data_rate()` seconds before the newest sample.
+   *
+   * Drivers without a FIFO return the single latest sample.
+   *
+   * @param p_samples - buffer to fill with samples
+   * @return std::span<read_t> - the filled portion of p_samples. Empty if
+   * p_samples is empty or no new samples are available.
+   */
+  [[nodiscard]] std::span<read_t> read_batch(std::span<read_t> p_samples)
+  {
+    return driver_read_batch(p_samples);
+  }
+
+  /**
+   * @brief Get the rate at which the device produces samples
+   *
+   * Support for this is optional. Drivers that do not sample at a fixed rate
+   * return `std::nullopt`.
+   *
+   * @return std::optional<hertz> - output data rate of the device or
+   * std::nullopt if it is not known.
+   */
+  [[nodiscard]] std::optional<hertz> output_data_rate()
+  {
+    return driver_output_data_rate();
+  }
+
   virtual ~magnetometer() = default;
 
 private:
   virtual read_t driver_read() = 0;
+  virtual std::span<read_t> driver_read_batch(std::span<read_t> p_samples)
+  {
+    if (p_samples.empty()) {
+      return {};
+    }
+    p_samples[0] = driver_read();
+    return p_samples.first(1);
+  }
+  virtual std::optional<hertz> driver_output_data_rate()
+  {
+    return std::nullopt;
+  }
 };
 }  // namespace hal
@@ -0,0 +1,284 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "spsc_queue.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief A lock-free, bounded, multiple producer, multiple consumer queue
+ *
+ * mpmc_queue<T> is a FIFO queue that any number of producers and consumers,
+ * such as threads on both cores of an RP2040 or a dual core STM32H7, can use
+ * at once. Each slot carries a sequence number that tells producers when it is
+ * free and consumers when it holds an element, so a push or pop costs one
+ * compare-exchange of the tail or head index and never waits on another
+ * core, unless that core claimed the slot and was preempted before finishing.
+ *
+ * Prefer `hal::spsc_queue` when there is only one producer and one consumer:
+ * it needs no read-modify-write operations. The compare-exchange used here
+ * needs exclusive load/store instructions, which the Cortex-M0+ cores of the
+ * RP2040 lack. There the toolchain's atomic library implements them, for
+ * example with the RP2040's hardware spinlocks, so the queue still works but is
+ * no longer lock free.
+ *
+ * The capacity is rounded up to a power of two of at least 2 so that indices
+ * wrap with a bit mask rather than a modulo operation. Element slots are only
+ * constructed when an element is pushed and are destroyed when popped.
+ *
+ * Example usage:
+ * ```
+ * hal::mpmc_queue<sample> queue(allocator, 32);
+ *
+ * // On either core (producers)
+ * queue.try_push(p_sample);
+ *
+ * // On either core (consumers)
+ * while (auto next = queue.try_pop()) {
+ *   process(*next);
+ * }
+ * ```
+ *
+ * @tparam T The type of elements in the queue
+ * @tparam IndexAlignment Alignment, in bytes, of the head and tail indices.
+ * Defaults to `cache_line_size` so that producers and consumers do not contend
+ * for the same cache line.
+ */
+template<typename T, usize IndexAlignment = cache_line_size>
+class mpmc_queue
+{
+public:
+  static_assert(std::has_single_bit(IndexAlignment),
+                "IndexAlignment must be a power of two");
+  static_assert(IndexAlignment >= alignof(std::atomic<usize>),
+                "IndexAlignment must be at least the alignment of the indices");
+
+  // Standard container type definitions
+  using value_type = T;
+  using size_type = usize;
+
+  mpmc_queue() = delete;
+  mpmc_queue(mpmc_queue const&) = delete;
+  mpmc_queue& operator=(mpmc_queue const&) = delete;
+  mpmc_queue(mpmc_queue&&) = delete;
+  mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+  /**
+   * @brief Create a mpmc_queue with specified capacity
+   *
+   * No elements are constructed. The capacity is rounded up to the next power
+   * of two, and to at least 2.
+   *
+   * @param p_allocator The allocator to use for memory allocation
+   * @param p_capacity The minimum number of elements the queue can hold
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  explicit mpmc_queue(std::pmr::polymorphic_allocator<byte> p_allocator,
+                      size_type p_capacity)
+    : m_allocator(p_allocator)
+    , m_capacity(std::bit_ceil(std::max<size_type>(2, p_capacity)))
+  {
+    m_cells = m_allocator.allocate_object<cell>(m_capacity);
+    for (size_type i = 0; i < m_capacity; ++i) {
+      new (&m_cells[i]) cell{};
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Destructor
+   *
+   * Destroys all unread elements and deallocates memory. No producer or
+   * consumer may be using the queue.
+   */
+  ~mpmc_queue()
+  {
+    if constexpr (not std::is_trivially_destructible_v<T>) {
+      auto const tail = m_tail.load(std::memory_order_acquire);
+      for (auto head = m_head.load(std::memory_order_relaxed); head != tail;
+           ++head) {
+        element(cell_at(head)).~T();
+      }
+    }
+    for (size_type i = 0; i < m_capacity; ++i) {
+      m_cells[i].~cell();
+    }
+    m_allocator.deallocate_object(m_cells, m_capacity);
+  }
+
+  /**
+   * @brief Attempt to push a copy of an element into the queue
+   *
+   * @param p_value The value to copy into the queue
+   * @return true - if the element was pushed
+   * @return false - if the queue is full, the element was not pushed
+   */
+  bool try_push(T const& p_value)
+  {
+    return try_emplace(p_value);
+  }
+
+  /**
+   * @brief Attempt to move an element into the queue
+   *
+   * @param p_value The value to move into the queue
+   * @return true - if the element was pushed
+   * @return false - if the queue is full, p_value is left untouched
+   */
+  bool try_push(T&& p_value)
+  {
+    return try_emplace(std::move(p_value));
+  }
+
+  /**
+   * @brief Attempt to construct an element in place at the back of the queue
+   *
+   * @tparam Args Types of the arguments to forward to the constructor
+   * @param p_args Arguments to forward to the constructor
+   * @return true - if the element was constructed in the queue
+   * @return false - if the queue is full, nothing was constructed
+   */
+  template<typename... Args>
+  bool try_emplace(Args&&... p_args)
+  {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = cell_at(tail);
+      auto const sequence = slot.sequence.load(std::memory_order_acquire);
+      auto const lag =
+        static_cast<std::make_signed_t<size_type>>(sequence - tail);
+      if (lag == 0) {
+        if (m_tail.compare_exchange_weak(
+              tail, tail + 1, std::memory_order_relaxed)) {
+          new (slot.storage.data()) T(std::forward<Args>(p_args)...);
+          slot.sequence.store(tail + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        tail = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Attempt to pop the element at the front of the queue
+   *
+   * @return std::optional<T> - the element removed from the queue or
+   * std::nullopt if the queue was empty.
+   */
+  [[nodiscard]] std::optional<T> try_pop()
+  {
+    auto head = m_head.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = cell_at(head);
+      auto const sequence = slot.sequence.load(std::memory_order_acquire);
+      auto const lag =
+        static_cast<std::make_signed_t<size_type>>(sequence - (head + 1));
+      if (lag == 0) {
+        if (m_head.compare_exchange_weak(
+              head, head + 1, std::memory_order_relaxed)) {
+          auto& value = element(slot);
+          std::optional<T> result(std::move(value));
+          value.~T();
+          slot.sequence.store(head + m_capacity, std::memory_order_release);
+          return result;
+        }
+      } else if (lag < 0) {
+        return std::nullopt;
+      } else {
+        head = m_head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of elements in the queue
+   *
+   * The value is a snapshot that other cores may have changed by the time it
+   * is used.
+   *
+   * @return size_type - number of elements in the queue
+   */
+  [[nodiscard]] size_type size() const noexcept
+  {
+    auto const head = m_head.load(std::memory_order_acquire);
+    auto const tail = m_tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  /**
+   * @brief Determine if the queue has no elements
+   *
+   * @return true - if the queue was empty
+   * @return false - if the queue held at least one element
+   */
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Returns the capacity of the mpmc_queue
+   *
+   * @return size_type - the number of elements the queue can hold
+   */
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+private:
+  struct cell
+  {
+    std::atomic<size_type> sequence = 0;
+    alignas(T) std::array<byte, sizeof(T)> storage;
+  };
+
+  [[nodiscard]] cell& cell_at(size_type p_index) noexcept
+  {
+    return m_cells[p_index & (m_capacity - 1)];
+  }
+
+  [[nodiscard]] static T& element(cell& p_cell) noexcept
+  {
+    return *std::launder(reinterpret_cast<T*>(p_cell.storage.data()));
+  }
+
+  std::pmr::polymorphic_allocator<byte> m_allocator;  ///< Allocator
+  cell* m_cells = nullptr;   ///< Pointer to allocated slots
+  size_type m_capacity = 0;  ///< Capacity of the queue, a power of two
+  /// Free running read counter, claimed by consumers
+  alignas(IndexAlignment) std::atomic<size_type> m_head = 0;
+  /// Free running write counter, claimed by producers
+  alignas(IndexAlignment) std::atomic<size_type> m_tail = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using hal::v5::mpmc_queue;
+}  // namespace hal
@@ -0,0 +1,189 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <span>
+
+#include "error.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+namespace detail {
+/**
+ * @brief Tick to nanosecond conversion factors for a clock frequency
+ *
+ * When the frequency divides one billion evenly, ticks are converted with a
+ * single integer multiply and the result is exact. Otherwise, ticks are
+ * multiplied by the nanoseconds per tick in 32.32 fixed point, which is
+ * accurate to within one nanosecond for every 2^32 nanoseconds elapsed, about
+ * 4.3 seconds, and never overflows before the nanosecond result does.
+ */
+struct tick_conversion
+{
+  /// Whole nanoseconds per tick, 0 if the frequency does not divide one
+  /// billion evenly
+  u64 exact = 0;
+  /// Nanoseconds per tick in 32.32 fixed point
+  u64 fixed = 0;
+
+  [[nodiscard]] static constexpr tick_conversion from(u64 p_frequency)
+  {
+    constexpr u64 ns_per_second = 1'000'000'000;
+    if (ns_per_second % p_frequency == 0) {
+      return { .exact = ns_per_second / p_frequency };
+    }
+    auto const whole = ns_per_second / p_frequency;
+    auto const remainder = ns_per_second % p_frequency;
+    // Round the fractional part to nearest
+    auto const fraction = ((remainder << 32U) + p_frequency / 2) / p_frequency;
+    return { .fixed = (whole << 32U) + fraction };
+  }
+
+  [[nodiscard]] constexpr u64 to_ns(u64 p_ticks) const
+  {
+    if (exact != 0) {
+      return p_ticks * exact;
+    }
+    // (ticks * fixed) >> 32 using only 32x32 to 64 bit multiplies
+    auto const ticks_high = p_ticks >> 32U;
+    auto const ticks_low = p_ticks & 0xFFFF'FFFF;
+    auto const fixed_high = fixed >> 32U;
+    auto const fixed_low = fixed & 0xFFFF'FFFF;
+    return ((ticks_high * fixed_high) << 32U) + ticks_high * fixed_low +
+           ticks_low * fixed_high + ((ticks_low * fixed_low) >> 32U);
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Steady clock adaptor that reports uptime in nanoseconds
+ *
+ * Converting ticks to time with `hal::steady_clock::frequency()` costs a
+ * virtual call and a floating point division per sample. This adaptor reads the
+ * frequency once at construction and converts ticks to nanoseconds with
+ * integer multiplies only, so timestamping a sample costs one call to
+ * `uptime()` and a few multiplies.
+ *
+ * If the clock frequency is known at compile time, pass it as the template
+ * argument, which makes the conversion factors compile time constants. Common
+ * frequencies that divide one billion evenly, such as 1 MHz, 8 MHz or 100 MHz,
+ * are converted exactly with a single multiply.
+ *
+ * Raw tick values can be captured in interrupt context with
+ * `hal::steady_clock::uptime()` and converted later in bulk with `to_ns()`.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::nanosecond_clock<1'000'000> clock(steady_clock);
+ * auto const start = clock.now_ns();
+ * ```
+ *
+ * @tparam Frequency - frequency of the steady clock in hertz, or 0 to read it
+ * from the clock at construction
+ */
+template<u32 Frequency = 0>
+class nanosecond_clock
+{
+public:
+  /**
+   * @brief Construct an adaptor over a steady clock
+   *
+   * @param p_clock - steady clock to read ticks from. Must outlive this object.
+   * @throws hal::argument_out_of_domain - if the clock frequency is below 1 Hz
+   * or does not match a non-zero `Frequency`.
+   */
+  explicit nanosecond_clock(hal::steady_clock& p_clock)
+    : m_clock(&p_clock)
+  {
+    auto const frequency = std::llround(p_clock.frequency());
+    if (frequency < 1 ||
+        (Frequency != 0 && static_cast<u64>(frequency) != Frequency)) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    if constexpr (Frequency == 0) {
+      m_conversion = detail::tick_conversion::from(frequency);
+    }
+  }
+
+  /**
+   * @brief Get the uptime of the steady clock in nanoseconds
+   *
+   * @return u64 - nanoseconds since the steady clock started
+   */
+  [[nodiscard]] u64 now_ns()
+  {
+    return to_ns(m_clock->uptime());
+  }
+
+  /**
+   * @brief Convert steady clock ticks to nanoseconds
+   *
+   * @param p_ticks - ticks returned by the steady clock's `uptime()`
+   * @return u64 - nanoseconds equivalent to p_ticks
+   */
+  [[nodiscard]] u64 to_ns(u64 p_ticks) const
+  {
+    return conversion().to_ns(p_ticks);
+  }
+
+  /**
+   * @brief Convert a span of steady clock ticks to nanoseconds in place
+   *
+   * @param p_timestamps - ticks returned by the steady clock's `uptime()`,
+   * replaced with their equivalent in nanoseconds
+   */
+  void to_ns(std::span<u64> p_timestamps) const
+  {
+    auto const factors = conversion();
+    for (auto& timestamp : p_timestamps) {
+      timestamp = factors.to_ns(timestamp);
+    }
+  }
+
+  /**
+   * @brief Get the underlying steady clock
+   *
+   * @return hal::steady_clock& - the steady clock passed at construction
+   */
+  [[nodiscard]] hal::steady_clock& clock() const
+  {
+    return *m_clock;
+  }
+
+private:
+  [[nodiscard]] constexpr detail::tick_conversion conversion() const
+  {
+    if constexpr (Frequency != 0) {
+      return compile_time_conversion;
+    } else {
+      return m_conversion;
+    }
+  }
+
+  static constexpr detail::tick_conversion compile_time_conversion =
+    Frequency != 0 ? detail::tick_conversion::from(Frequency)
+                   : detail::tick_conversion{};
+
+  hal::steady_clock* m_clock;
+  detail::tick_conversion m_conversion{};
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::nanosecond_clock;
+}  // namespace hal
@@ -0,0 +1,152 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+
+#include "io_waiter.hpp"
+#include "lock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief concept for a binary semaphore
+ *
+ * Satisfied by `std::binary_semaphore` and by thin wrappers around RTOS
+ * primitives such as FreeRTOS task notifications or binary semaphores, or
+ * Zephyr `k_sem`. `release()` must be callable from interrupt context.
+ *
+ * @tparam Semaphore - semaphore type
+ */
+template<class Semaphore>
+concept binary_semaphore_like = requires(Semaphore semaphore) {
+  { semaphore.acquire() } -> std::same_as<void>;
+  { semaphore.release() } -> std::same_as<void>;
+};
+
+/**
+ * @brief io_waiter that blocks the current task on an RTOS semaphore
+ *
+ * `wait()` acquires the semaphore, so the task waiting on I/O yields the CPU to
+ * other tasks, and `resume()` releases it from the interrupt that completes the
+ * I/O. Because a semaphore remembers a release, a `resume()` that arrives
+ * before `wait()` is never lost. Repeated calls to `resume()` before the next
+ * `wait()` release the semaphore only once, which keeps its count within the
+ * maximum of a binary semaphore.
+ *
+ * @tparam Semaphore - semaphore type satisfying `binary_semaphore_like`
+ */
+template<binary_semaphore_like Semaphore>
+class semaphore_io_waiter : public io_waiter
+{
+public:
+  /**
+   * @brief Construct a waiter over a semaphore
+   *
+   * @param p_semaphore - semaphore, initially unavailable, to block on. Must
+   * outlive this object and must not be used for anything else.
+   */
+  explicit semaphore_io_waiter(Semaphore& p_semaphore)
+    : m_semaphore(&p_semaphore)
+  {
+  }
+
+  semaphore_io_waiter(semaphore_io_waiter const&) = delete;
+  semaphore_io_waiter& operator=(semaphore_io_waiter const&) = delete;
+  semaphore_io_waiter(semaphore_io_waiter&&) = delete;
+  semaphore_io_waiter& operator=(semaphore_io_waiter&&) = delete;
+  ~semaphore_io_waiter() override = default;
+
+private:
+  void driver_wait() override
+  {
+    m_semaphore->acquire();
+    m_released.store(false, std::memory_order_release);
+  }
+
+  void driver_resume() noexcept override
+  {
+    if (not m_released.exchange(true, std::memory_order_acq_rel)) {
+      m_semaphore->release();
+    }
+  }
+
+  Semaphore* m_semaphore;
+  std::atomic<bool> m_released = false;
+};
+
+/**
+ * @brief Adapts a native timed mutex to hal::timed_lock
+ *
+ * Satisfied by `std::timed_mutex` and by thin wrappers around RTOS mutexes. Use
+ * a mutex with priority inheritance, such as a FreeRTOS mutex created with
+ * `xSemaphoreCreateMutex()` or a Zephyr `k_mutex`, so a low priority task
+ * holding the lock is raised while a higher priority task waits for it,
+ * avoiding priority inversion. Each operation is a single call to the native
+ * mutex.
+ *
+ * @tparam Mutex - mutex type satisfying `hal::timed_lockable`
+ */
+template<hal::timed_lockable Mutex>
+class timed_lock_adaptor : public hal::timed_lock
+{
+public:
+  /**
+   * @brief Construct an adaptor over a mutex
+   *
+   * @param p_mutex - mutex to lock. Must outlive this object.
+   */
+  explicit timed_lock_adaptor(Mutex& p_mutex)
+    : m_mutex(&p_mutex)
+  {
+  }
+
+  timed_lock_adaptor(timed_lock_adaptor const&) = delete;
+  timed_lock_adaptor& operator=(timed_lock_adaptor const&) = delete;
+  timed_lock_adaptor(timed_lock_adaptor&&) = delete;
+  timed_lock_adaptor& operator=(timed_lock_adaptor&&) = delete;
+  ~timed_lock_adaptor() override = default;
+
+private:
+  void os_lock() override
+  {
+    m_mutex->lock();
+  }
+
+  void os_unlock() override
+  {
+    m_mutex->unlock();
+  }
+
+  bool os_try_lock() override
+  {
+    return m_mutex->try_lock();
+  }
+
+  bool os_try_lock_for(hal::time_duration p_duration) override
+  {
+    return m_mutex->try_lock_for(p_duration);
+  }
+
+  Mutex* m_mutex;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::binary_semaphore_like;
+using v5::semaphore_io_waiter;
+using v5::timed_lock_adaptor;
+}  // namespace hal
@@ -0,0 +1,429 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+
+#include "adc.hpp"
+#include "adc_scan.hpp"
+#include "allocated_buffer.hpp"
+#include "circular_buffer.hpp"
+#include "error.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Statistics of the latest results of a `hal::oversampling_adc`
+ *
+ * @tparam sample_t - type of each result, u16 or u32
+ */
+template<std::unsigned_integral sample_t>
+struct adc_statistics
+{
+  /// Number of results the statistics are computed over, at most the size of
+  /// the statistics window
+  usize count = 0;
+  /// Mean of the results, in the same scale as the results
+  float mean = 0.0f;
+  /// Population variance of the results, in squared result counts
+  float variance = 0.0f;
+  /// Smallest of the results
+  sample_t min = 0;
+  /// Largest of the results
+  sample_t max = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(adc_statistics const&) const = default;
+};
+
+namespace detail {
+template<std::unsigned_integral sample_t>
+struct adc_interface;
+
+template<>
+struct adc_interface<u16>
+{
+  using type = hal::adc16;
+};
+
+template<>
+struct adc_interface<u32>
+{
+  using type = hal::adc24;
+};
+}  // namespace detail
+
+/**
+ * @brief ADC decorator that oversamples, decimates and tracks noise statistics
+ *
+ * Each `read()` converts `ratio` samples from the underlying ADC and decimates
+ * them into one result. With an `hal::adc_scan` source the samples are taken
+ * in a single hardware scan of the channel, so a read costs one virtual call
+ * and one DMA transfer instead of `ratio` separate conversions. Averaging
+ * reduces white noise by the square root of the ratio, so the low bits of the
+ * upscaled result, which carry no information on a 12-bit ADC read once,
+ * become meaningful: an oversampling ratio of 16 gains 2 bits of effective
+ * resolution.
+ *
+ * The decimator is a cascaded integrator-comb (CIC) filter. An order of 1 is
+ * the plain average of each batch. Higher orders cascade that average with
+ * itself, attenuating noise and interference above the output rate further at
+ * the cost of a slower step response, which spans `order` results. Its state
+ * is kept between reads, so the filter runs over the continuous sample
+ * stream. The first read of a filter of order 2 or more converts `order`
+ * batches so the first result is already settled.
+ *
+ * Every result is pushed into a `hal::circular_buffer` and the mean,
+ * variance, minimum and maximum of the latest `statistics_window` results are
+ * kept up to date with running sums, exactly in integers, so reading them
+ * does not iterate over the history. The minimum and maximum are found again
+ * over the window only when the result leaving the window held one of them,
+ * which for noisy signals averages to O(1) per result.
+ *
+ * The decorator implements `hal::adc16` for u16 samples and `hal::adc24` for
+ * u32 samples, so sensor drivers can be given it in place of the ADC.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::oversampling_adc16 filtered(
+ *   allocator, scanning_adc, 3, { .ratio = 64, .order = 2 });
+ * thermistor_driver sensor(filtered);
+ * // ...
+ * auto const noise = filtered.statistics().variance;
+ * ```
+ *
+ * @tparam sample_t - u16 for ADCs of 16-bits and below and u32 for ADCs of 17
+ * to 24-bits
+ */
+template<std::unsigned_integral sample_t>
+class oversampling_adc : public detail::adc_interface<sample_t>::type
+{
+public:
+  /// Single sample interface of the same width, `hal::adc16` or `hal::adc24`
+  using adc_type = typename detail::adc_interface<sample_t>::type;
+
+  /// Highest supported CIC filter order
+  static constexpr u8 max_order = 4;
+
+  /**
+   * @brief Oversampling settings
+   *
+   */
+  struct settings
+  {
+    /// Number of samples decimated into each result
+    u16 ratio = 16;
+    /// Order of the CIC decimation filter, from 1 to `max_order`. The gain of
+    /// the filter, `ratio` raised to `order`, must be at most 2^32 so results
+    /// cannot overflow its 64-bit accumulators: a ratio of 256 supports every
+    /// order and a ratio of 1024 up to 3.
+    u8 order = 1;
+    /// Number of results statistics are computed over and the capacity of
+    /// the history
+    usize statistics_window = 16;
+  };
+
+  /**
+   * @brief Oversample a single sample ADC
+   *
+   * Each read calls `p_adc.read()` `ratio` times.
+   *
+   * @param p_allocator - allocator for the history
+   * @param p_adc - ADC to oversample. Must outlive this object.
+   * @param p_settings - oversampling settings
+   * @throws hal::argument_out_of_domain - if the settings are out of range,
+   * see `settings`
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  oversampling_adc(std::pmr::polymorphic_allocator<> p_allocator,
+                   adc_type& p_adc,
+                   settings const& p_settings)
+    : m_adc(&p_adc)
+    , m_batch(p_allocator, 1, for_overwrite)
+    , m_history(p_allocator, p_settings.statistics_window)
+    , m_settings(validate(p_settings))
+    , m_gain(gain(p_settings))
+  {
+  }
+
+  /**
+   * @brief Oversample a channel of a scanning ADC in hardware batches
+   *
+   * Each read scans `p_channel` `ratio` times with a single call to
+   * `p_scan.scan()`.
+   *
+   * @param p_allocator - allocator for the batch and the history
+   * @param p_scan - scanning ADC to oversample. Must outlive this object.
+   * @param p_channel - driver specific channel number to convert
+   * @param p_settings - oversampling settings
+   * @throws hal::argument_out_of_domain - if the settings are out of range,
+   * see `settings`
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  oversampling_adc(std::pmr::polymorphic_allocator<> p_allocator,
+                   adc_scan<sample_t>& p_scan,
+                   u8 p_channel,
+                   settings const& p_settings)
+    : m_scan(&p_scan)
+    , m_batch(p_allocator, p_settings.ratio, for_overwrite)
+    , m_history(p_allocator, p_settings.statistics_window)
+    , m_settings(validate(p_settings))
+    , m_gain(gain(p_settings))
+    , m_channel(p_channel)
+  {
+  }
+
+  oversampling_adc(oversampling_adc const&) = delete;
+  oversampling_adc& operator=(oversampling_adc const&) = delete;
+  oversampling_adc(oversampling_adc&&) = delete;
+  oversampling_adc& operator=(oversampling_adc&&) = delete;
+  ~oversampling_adc() override = default;
+
+  /**
+   * @brief Get the statistics of the latest results
+   *
+   * @return adc_statistics<sample_t> - statistics over the results since the
+   * last reset, up to the size of the statistics window
+   */
+  [[nodiscard]] adc_statistics<sample_t> statistics() const
+  {
+    if (m_count == 0) {
+      return {};
+    }
+    auto const count = static_cast<double>(m_count);
+    auto const mean = static_cast<double>(m_sum) / count;
+    auto const variance =
+      (static_cast<double>(m_sum_of_squares) / count) - (mean * mean);
+    return {
+      .count = m_count,
+      .mean = static_cast<float>(static_cast<double>(m_offset) + mean),
+      .variance = static_cast<float>(std::max(variance, 0.0)),
+      .min = m_min,
+      .max = m_max,
+    };
+  }
+
+  /**
+   * @brief Get the history of results
+   *
+   * Indices wrap, so the history can be read in place, oldest to newest, from
+   * `write_index()` to `write_index() + capacity() - 1`.
+   *
+   * @return circular_buffer<sample_t> const& - latest results, as many as the
+   * statistics window
+   */
+  [[nodiscard]] circular_buffer<sample_t> const& history() const
+  {
+    return m_history;
+  }
+
+  /**
+   * @brief Discard the statistics, keeping the filter state
+   *
+   * Call after a change to the measured signal, such as switching a sensor's
+   * range, so the statistics only cover results taken afterwards.
+   */
+  void reset_statistics()
+  {
+    m_count = 0;
+    m_sum = 0;
+    m_sum_of_squares = 0;
+  }
+
+  /**
+   * @brief Discard the filter state and the statistics
+   *
+   * The next read settles the filter again, as the first read does.
+   */
+  void reset()
+  {
+    m_integrators = {};
+    m_combs = {};
+    m_primed = false;
+    reset_statistics();
+  }
+
+  /**
+   * @brief Get the settings
+   *
+   * @return settings const& - settings passed at construction
+   */
+  [[nodiscard]] settings const& configuration() const
+  {
+    return m_settings;
+  }
+
+private:
+  settings const& validate(settings const& p_settings)
+  {
+    if (p_settings.ratio == 0 || p_settings.order == 0 ||
+        p_settings.order > max_order || gain(p_settings) > (u64{ 1 } << 32U)) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    return p_settings;
+  }
+
+  static u64 gain(settings const& p_settings)
+  {
+    u64 result = 1;
+    for (u8 i = 0; i < p_settings.order && result <= (u64{ 1 } << 32U); i++) {
+      result *= p_settings.ratio;
+    }
+    return result;
+  }
+
+  sample_t driver_read() override
+  {
+    if (not m_primed) {
+      for (u8 i = 1; i < m_settings.order; i++) {
+        (void)decimate();
+      }
+      m_primed = true;
+    }
+    auto const result = decimate();
+    record(result);
+    return result;
+  }
+
+  /// Run one batch of samples through the integrators and the result through
+  /// the combs. Arithmetic wraps modulo 2^64, which the combs undo exactly.
+  sample_t decimate()
+  {
+    if (m_scan) {
+      std::array<u8, 1> const channel{ m_channel };
+      m_scan->scan(channel,
+                   std::span<sample_t>(m_batch.data(), m_batch.size()));
+      for (auto const sample : m_batch) {
+        integrate(sample);
+      }
+    } else {
+      for (u16 i = 0; i < m_settings.ratio; i++) {
+        integrate(m_adc->read());
+      }
+    }
+
+    auto value = m_integrators[m_settings.order - 1];
+    for (u8 i = 0; i < m_settings.order; i++) {
+      auto const delayed = m_combs[i];
+      m_combs[i] = value;
+      value -= delayed;
+    }
+    auto const rounded = (value + (m_gain / 2)) / m_gain;
+    return static_cast<sample_t>(
+      std::min<u64>(rounded, std::numeric_limits<sample_t>::max()));
+  }
+
+  void integrate(sample_t p_sample)
+  {
+    u64 value = p_sample;
+    for (u8 i = 0; i < m_settings.order; i++) {
+      m_integrators[i] += value;
+      value = m_integrators[i];
+    }
+  }
+
+  /// Sums are kept relative to the first result since the last reset so that
+  /// the sum of squares measures the noise and not the signal level
+  void record(sample_t p_result)
+  {
+    auto const capacity = m_history.capacity();
+    if (m_count == 0) {
+      m_offset = p_result;
+      m_min = p_result;
+      m_max = p_result;
+    }
+
+    bool rescan = false;
+    if (m_count == capacity) {
+      auto const evicted = m_history[m_history.write_index()];
+      auto const deviation = deviation_of(evicted);
+      m_sum -= deviation;
+      m_sum_of_squares -= static_cast<u64>(deviation * deviation);
+      rescan = evicted == m_min || evicted == m_max;
+    } else {
+      m_count++;
+    }
+
+    auto const deviation = deviation_of(p_result);
+    m_sum += deviation;
+    m_sum_of_squares += static_cast<u64>(deviation * deviation);
+    m_history.push(p_result);
+
+    if (rescan) {
+      auto const first = m_history.write_index() + capacity - m_count;
+      m_min = m_history[first];
+      m_max = m_history[first];
+      for (usize i = 1; i < m_count; i++) {
+        m_min = std::min(m_min, m_history[first + i]);
+        m_max = std::max(m_max, m_history[first + i]);
+      }
+    } else {
+      m_min = std::min(m_min, p_result);
+      m_max = std::max(m_max, p_result);
+    }
+  }
+
+  [[nodiscard]] i64 deviation_of(sample_t p_result) const
+  {
+    return static_cast<i64>(p_result) - static_cast<i64>(m_offset);
+  }
+
+  adc_type* m_adc = nullptr;
+  adc_scan<sample_t>* m_scan = nullptr;
+  allocated_buffer<sample_t> m_batch;
+  circular_buffer<sample_t> m_history;
+  settings m_settings;
+  u64 m_gain;
+  std::array<u64, max_order> m_integrators{};
+  std::array<u64, max_order> m_combs{};
+  usize m_count = 0;
+  i64 m_sum = 0;
+  u64 m_sum_of_squares = 0;
+  sample_t m_offset = 0;
+  sample_t m_min = 0;
+  sample_t m_max = 0;
+  u8 m_channel = 0;
+  bool m_primed = false;
+};
+
+/**
+ * @brief Shorthand for oversampling_adc<u16>, implementing `hal::adc16`
+ *
+ */
+using oversampling_adc16 = oversampling_adc<u16>;
+
+/**
+ * @brief Shorthand for oversampling_adc<u32>, implementing `hal::adc24`
+ *
+ */
+using oversampling_adc24 = oversampling_adc<u32>;
+}  // namespace hal::v5
+
+namespace hal {
+using v5::adc_statistics;
+using v5::oversampling_adc;
+using v5::oversampling_adc16;
+using v5::oversampling_adc24;
+}  // namespace hal
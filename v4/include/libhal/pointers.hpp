@@ -16,6 +16,7 @@
 
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <memory_resource>
 #include <type_traits>
 #include <utility>
@@ -57,7 +58,10 @@ struct ref_info
   std::pmr::polymorphic_allocator<> allocator;
   destroy_fn_t* destroy;
   std::atomic<i32> strong_count = 1;
-  std::atomic<i32> weak_count = 0;
+  /// Number of weak references, plus 1 held by the strong references as a
+  /// group, so whichever count reaches 0 last deallocates the memory, exactly
+  /// once
+  std::atomic<i32> weak_count = 1;
 };
 
 /**
@@ -71,67 +75,78 @@ inline void ptr_add_ref(ref_info* p_info)
 }
 
 /**
- * @brief Release strong reference from control block
- *
- * If this was the last strong reference, the pointed-to object will be
- * destroyed. If there are no remaining weak references, the memory
- * will also be deallocated.
+ * @brief Add weak reference to control block
  *
  * @param p_info Pointer to the control block
  */
-inline void ptr_release(ref_info* p_info)
+inline void ptr_add_weak(ref_info* p_info)
 {
-  if (p_info->strong_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-    // No more strong references, destroy the object but keep control block
-    // if there are weak references
-
-    // Call the destroy function which will:
-    // 1. Call the destructor of the object
-    // 2. Return the size of the rc for deallocation when needed
-    usize const object_size = p_info->destroy(p_info);
-
-    // If there are no weak references, deallocate memory
-    if (p_info->weak_count.load(std::memory_order_acquire) == 0) {
-      // Save allocator for deallocating
-      auto alloc = p_info->allocator;
-
-      // Deallocate memory
-      alloc.deallocate_bytes(p_info, object_size);
-    }
-  }
+  p_info->weak_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 /**
- * @brief Add weak reference to control block
+ * @brief Deallocate a control block and the storage of its object
  *
- * @param p_info Pointer to the control block
+ * @param p_info Pointer to the control block, whose object has been destroyed
  */
-inline void ptr_add_weak(ref_info* p_info)
+inline void ptr_deallocate(ref_info* p_info)
 {
-  p_info->weak_count.fetch_add(1, std::memory_order_relaxed);
+  // Get the size of the rc from the destroy function
+  auto const object_size = p_info->destroy(nullptr);
+
+  // Save allocator for deallocating
+  auto alloc = p_info->allocator;
+
+  // Deallocate memory
+  alloc.deallocate_bytes(p_info, object_size);
 }
 
 /**
  * @brief Release weak reference from control block
  *
- * If this was the last weak reference and there are no remaining
- * strong references, the memory will be deallocated.
+ * If this was the last weak reference, including the one held by the strong
+ * references as a group, the memory will be deallocated.
  *
  * @param p_info Pointer to the control block
  */
 inline void ptr_release_weak(ref_info* p_info)
 {
-  if (p_info->weak_count.fetch_sub(1, std::memory_order_acq_rel) == 0) {
-    // No more weak references, check if we can deallocate
-    if (p_info->strong_count.load(std::memory_order_acquire) == 0) {
-      // No strong references either, get the size from the destroy function
-      auto const object_size = p_info->destroy(nullptr);
-
-      // Save allocator for deallocating
-      auto alloc = p_info->allocator;
+  // Only the last release needs to synchronize with the others, so the
+  // acquire is a fence on that path rather than part of every decrement.
+  if (p_info->weak_count.fetch_sub(1, std::memory_order_release) == 1) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    ptr_deallocate(p_info);
+  }
+}
 
-      // Deallocate memory
-      alloc.deallocate_bytes(p_info, object_size);
+/**
+ * @brief Release strong reference from control block
+ *
+ * If this was the last strong reference, the pointed-to object will be
+ * destroyed. If there are no remaining weak references, the memory
+ * will also be deallocated.
+ *
+ * @param p_info Pointer to the control block
+ */
+inline void ptr_release(ref_info* p_info)
+{
+  // The release decrement publishes this owner's use of the object. Only the
+  // last owner must observe every other owner's use before destroying it, so
+  // it alone pays for an acquire fence.
+  if (p_info->strong_count.fetch_sub(1, std::memory_order_release) == 1) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Call the destroy function which will call the destructor of the object
+    // but keep the control block alive for weak references
+    (void)p_info->destroy(p_info);
+
+    // Drop the weak reference held by the strong references. Without a
+    // weak_ptr, none can be created anymore, so the common case deallocates
+    // without another read-modify-write.
+    if (p_info->weak_count.load(std::memory_order_acquire) == 1) {
+      ptr_deallocate(p_info);
+    } else {
+      ptr_release_weak(p_info);
     }
   }
 }
@@ -169,6 +184,23 @@ struct rc
     return sizeof(rc<T>);
   }
 };
+/**
+ * @brief Control block shared by every object given to make_static_strong_ptr
+ *
+ * Its initial strong reference is never released, so the count never reaches
+ * zero and the objects, which live in static storage, are never destroyed.
+ *
+ * @return ref_info& - the shared control block
+ */
+inline ref_info& static_ref_info()
+{
+  static ref_info info{
+    .allocator = std::pmr::null_memory_resource(),
+    .destroy = [](void const*) -> usize { return 0; },
+  };
+  return info;
+}
+
 // Check if a type is an array or std::array
 template<typename T>
 struct is_array_like : std::false_type
@@ -595,6 +627,9 @@ private:
   friend strong_ptr<U> make_strong_ptr(std::pmr::polymorphic_allocator<>,
                                        Args&&...);
 
+  template<class U>
+  friend strong_ptr<U> make_static_strong_ptr(U&) noexcept;
+
   template<typename U>
   friend class strong_ptr;
 
@@ -751,6 +786,9 @@ private:
   friend strong_ptr<U> make_strong_ptr(std::pmr::polymorphic_allocator<>,
                                        Args&&...);
 
+  template<class U>
+  friend strong_ptr<U> make_static_strong_ptr(U&) noexcept;
+
   /**
    * @brief Initialize the weak reference (called by make_strong_ptr)
    *
@@ -1212,8 +1250,8 @@ public:
    */
   [[nodiscard]] constexpr strong_ptr<T>& value()
   {
-    if (!is_engaged()) {
-      hal::safe_throw(hal::bad_optional_ptr_access(this));
+    if (not is_engaged()) [[unlikely]] {
+      throw_bad_access();
     }
     return m_value;
   }
@@ -1226,8 +1264,8 @@ public:
    */
   [[nodiscard]] constexpr strong_ptr<T> const& value() const
   {
-    if (!is_engaged()) {
-      hal::safe_throw(hal::bad_optional_ptr_access(this));
+    if (not is_engaged()) [[unlikely]] {
+      throw_bad_access();
     }
     return m_value;
   }
@@ -1271,8 +1309,8 @@ public:
   [[nodiscard]] constexpr operator strong_ptr<U>()
     requires(std::is_convertible_v<T*, U*> && !std::is_same_v<T, U>)
   {
-    if (!is_engaged()) {
-      hal::safe_throw(hal::bad_optional_ptr_access(this));
+    if (not is_engaged()) [[unlikely]] {
+      throw_bad_access();
     }
     // strong_ptr handles the polymorphic conversion
     return strong_ptr<U>(m_value);
@@ -1290,8 +1328,8 @@ public:
   [[nodiscard]] constexpr operator strong_ptr<U>() const
     requires(std::is_convertible_v<T*, U*> && !std::is_same_v<T, U>)
   {
-    if (!is_engaged()) {
-      hal::safe_throw(hal::bad_optional_ptr_access(this));
+    if (not is_engaged()) [[unlikely]] {
+      throw_bad_access();
     }
     // strong_ptr handles the polymorphic conversion
     return strong_ptr<U>(m_value);
@@ -1394,8 +1432,9 @@ private:
   /**
    * @brief Use the strong_ptr's memory directly through a union
    *
-   * This allows us to detect whether the optional_ptr is engaged
-   * by checking if the internal pointers are non-null.
+   * A strong_ptr always has a control block, so a null control block pointer
+   * represents the disengaged state and optional_ptr needs no flag of its
+   * own. `m_raw_ptrs[0]` overlays `strong_ptr::m_ctrl`.
    */
   union
   {
@@ -1414,7 +1453,23 @@ private:
    */
   [[nodiscard]] constexpr bool is_engaged() const noexcept
   {
-    return m_raw_ptrs[0] != nullptr || m_raw_ptrs[1] != nullptr;
+    static_assert(sizeof(optional_ptr) == sizeof(strong_ptr<T>),
+                  "optional_ptr must add no storage to strong_ptr");
+    static_assert(std::is_standard_layout_v<strong_ptr<T>> &&
+                    offsetof(strong_ptr<T>, m_ctrl) == 0,
+                  "strong_ptr's control block must be its first member");
+    return m_raw_ptrs[0] != nullptr;
+  }
+
+  /**
+   * @brief Throw for access to a disengaged optional
+   *
+   * Kept out of line and marked cold, so the accessors inline to a compare
+   * and a branch to this call, without the exception's construction.
+   */
+  [[noreturn, gnu::cold, gnu::noinline]] void throw_bad_access() const
+  {
+    hal::safe_throw(hal::bad_optional_ptr_access(this));
   }
 };
 
@@ -1431,21 +1486,21 @@ private:
 template<typename T>
 [[nodiscard]] inline optional_ptr<T> weak_ptr<T>::lock() const noexcept
 {
-  if (expired()) {
+  if (m_ctrl == nullptr) {
     return nullptr;
   }
 
-  // Try to increment the strong count
+  // Increment the strong count only while it is above 0, which takes one load
+  // and, without contention, one compare exchange. Like ptr_add_ref(), the
+  // increment needs no ordering: this weak reference keeps the control block
+  // alive, and the object was published to this thread along with it.
   auto current_count = m_ctrl->strong_count.load(std::memory_order_relaxed);
   while (current_count > 0) {
-    // TODO(kammce): Consider if this is dangerous
     if (m_ctrl->strong_count.compare_exchange_weak(current_count,
                                                    current_count + 1,
-                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed,
                                                    std::memory_order_relaxed)) {
-      // Successfully incremented
-      auto obj = strong_ptr<T>(m_ctrl, m_ptr);
-      return obj;
+      return strong_ptr<T>(m_ctrl, m_ptr);
     }
   }
 
@@ -1731,10 +1786,56 @@ template<class T, typename... Args>
 
   return result;
 }
+
+/**
+ * @brief Create a strong_ptr to an object in static storage
+ *
+ * Drivers constructed once at startup and never destroyed need neither the
+ * allocator nor the destroy function that `make_strong_ptr` stores in a
+ * control block next to every object, which costs 16 to 24 bytes per object on
+ * 32-bit systems. Every strong_ptr made by this function shares a single
+ * control block instead, whose count never reaches zero, so no memory is
+ * allocated and the object is never destroyed by a strong_ptr.
+ *
+ * The result is an ordinary strong_ptr and can be passed to any API taking
+ * one, converted to base classes, aliased, and used with weak_ptr and
+ * optional_ptr. If the type inherits from `enable_strong_from_this<T>`,
+ * `strong_from_this()` and `weak_from_this()` work after the first call.
+ *
+ * Because the control block is shared, `use_count()` on the result reports the
+ * references to every such object combined.
+ *
+ * Example usage:
+ *
+ * ```cpp
+ * static my_driver driver(args...);
+ * hal::strong_ptr<my_driver> ptr = hal::make_static_strong_ptr(driver);
+ * ```
+ *
+ * @tparam T The type of the object
+ * @param p_object Object with static storage duration. Must outlive every
+ * strong_ptr and weak_ptr made from the result.
+ * @return A strong_ptr to p_object
+ */
+template<class T>
+[[nodiscard]] inline strong_ptr<T> make_static_strong_ptr(T& p_object) noexcept
+{
+  auto* const info = &detail::static_ref_info();
+  detail::ptr_add_ref(info);
+  strong_ptr<T> result(info, &p_object);
+
+  // Initialize enable_strong_from_this if the type inherits from it
+  if constexpr (std::is_base_of_v<enable_strong_from_this<T>, T>) {
+    result->init_weak_this(result);
+  }
+
+  return result;
+}
 }  // namespace hal::v5
 
 namespace hal {
 using v5::enable_strong_from_this;
+using v5::make_static_strong_ptr;
 using v5::make_strong_ptr;
 using v5::optional_ptr;
 using v5::strong_ptr;
@@ -0,0 +1,199 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include "pointers.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Usage counters for a pool_resource
+ *
+ */
+struct pool_statistics
+{
+  /// Number of blocks currently allocated
+  usize in_use = 0;
+  /// Largest number of blocks that have been allocated at the same time
+  usize high_water = 0;
+  /// Number of allocations that failed because the pool was exhausted or the
+  /// request did not fit in a block
+  usize failures = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(pool_statistics const&) const = default;
+};
+
+/**
+ * @brief Memory resource handing out fixed size blocks from inline storage
+ *
+ * The storage for every block lives within the object, so a pool declared
+ * `static` never touches the heap. Allocation and deallocation are O(1), and
+ * because every block has the same size, the pool cannot fragment. Freed
+ * blocks are kept on an intrusive free list and reused most-recently-freed
+ * first.
+ *
+ * The pool is intended for objects created and destroyed at runtime, such as
+ * the control blocks allocated by `hal::make_strong_ptr`. Use
+ * `hal::strong_ptr_pool` to size the blocks for a specific type.
+ *
+ * This resource is not thread safe. Allocations that do not fit in a block or
+ * need stricter alignment than the pool's fail rather than being passed to an
+ * upstream resource.
+ *
+ * Example usage:
+ *
+ * ```
+ * static hal::strong_ptr_pool<my_driver, 8> driver_pool;
+ * auto driver = hal::make_strong_ptr<my_driver>(&driver_pool, args...);
+ * ```
+ *
+ * @tparam BlockSize - minimum size, in bytes, of each block. Rounded up to a
+ * multiple of the alignment.
+ * @tparam Count - number of blocks in the pool
+ * @tparam Alignment - alignment of every block, at least
+ * `alignof(std::max_align_t)`. Raise it for blocks that hold over-aligned
+ * types, such as DMA buffers aligned to a cache line.
+ */
+template<usize BlockSize,
+         usize Count,
+         usize Alignment = alignof(std::max_align_t)>
+class pool_resource : public std::pmr::memory_resource
+{
+public:
+  static_assert(BlockSize > 0, "pool_resource block size must not be zero");
+  static_assert(Count > 0, "pool_resource must hold at least one block");
+  static_assert(std::has_single_bit(Alignment),
+                "pool_resource alignment must be a power of two");
+  static_assert(Alignment >= alignof(std::max_align_t),
+                "pool_resource alignment must be at least max_align_t's");
+
+  /// Alignment of every block handed out by the pool
+  static constexpr usize block_alignment = Alignment;
+  /// Size of every block handed out by the pool
+  static constexpr usize block_size =
+    (BlockSize + block_alignment - 1) / block_alignment * block_alignment;
+  /// Number of blocks in the pool
+  static constexpr usize block_count = Count;
+
+  pool_resource() = default;
+  pool_resource(pool_resource const&) = delete;
+  pool_resource& operator=(pool_resource const&) = delete;
+  pool_resource(pool_resource&&) = delete;
+  pool_resource& operator=(pool_resource&&) = delete;
+  ~pool_resource() override = default;
+
+  /**
+   * @brief Get the usage counters of the pool
+   *
+   * @return pool_statistics - current usage counters
+   */
+  [[nodiscard]] pool_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+  /**
+   * @brief Reset the high water mark to the number of blocks in use
+   *
+   */
+  void reset_high_water()
+  {
+    m_statistics.high_water = m_statistics.in_use;
+  }
+
+private:
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  static_assert(sizeof(free_block) <= block_size);
+
+  void* do_allocate(usize p_bytes, usize p_alignment) override
+  {
+    if (p_bytes > block_size || p_alignment > block_alignment) {
+      m_statistics.failures++;
+      throw std::bad_alloc();
+    }
+
+    void* block = nullptr;
+    if (m_free != nullptr) {
+      block = m_free;
+      m_free = m_free->next;
+    } else if (m_untouched < Count) {
+      block = &m_storage[m_untouched * block_size];
+      m_untouched++;
+    } else {
+      m_statistics.failures++;
+      throw std::bad_alloc();
+    }
+
+    m_statistics.in_use++;
+    if (m_statistics.in_use > m_statistics.high_water) {
+      m_statistics.high_water = m_statistics.in_use;
+    }
+    return block;
+  }
+
+  void do_deallocate(void* p_block, usize, usize) override
+  {
+    m_free = ::new (p_block) free_block{ m_free };
+    m_statistics.in_use--;
+  }
+
+  [[nodiscard]] bool do_is_equal(
+    std::pmr::memory_resource const& p_other) const noexcept override
+  {
+    return this == &p_other;
+  }
+
+  alignas(block_alignment) hal::byte m_storage[block_size * Count]{};
+  free_block* m_free = nullptr;
+  /// Blocks at and above this index have never been handed out
+  usize m_untouched = 0;
+  pool_statistics m_statistics{};
+};
+
+/**
+ * @brief A pool_resource whose blocks fit one `hal::make_strong_ptr<T>`
+ *
+ * The block size and alignment are selected at compile time from the control
+ * block and object allocated together by `hal::make_strong_ptr<T>`.
+ *
+ * @tparam T - type of object managed by the strong_ptr
+ * @tparam Count - number of objects the pool can hold at once
+ */
+template<typename T, usize Count>
+using strong_ptr_pool =
+  pool_resource<sizeof(detail::rc<T>),
+                Count,
+                std::max(alignof(detail::rc<T>), alignof(std::max_align_t))>;
+}  // namespace hal::v5
+
+namespace hal {
+using v5::pool_resource;
+using v5::pool_statistics;
+using v5::strong_ptr_pool;
+}  // namespace hal
@@ -15,7 +15,9 @@
 #pragma once
 
 #include <algorithm>
+#include <span>
 
+#include "error.hpp"
 #include "units.hpp"
 
 namespace hal {
@@ -93,8 +95,9 @@ private:
 /**
  * @brief Pulse Width Modulation (PWM) manager hardware abstraction.
  *
- * This interface allows control over a single or group of pwm channels.
- * Currently this interface only provides support for frequency control.
+ * This interface allows control over a single or group of pwm channels. It
+ * provides frequency control and, for hardware that supports it, updating the
+ * duty cycle of every channel in the group at once.
  */
 class pwm_group_manager
 {
@@ -137,8 +140,42 @@ public:
     driver_frequency(p_frequency);
   }
 
+  /**
+   * @brief Update the duty cycles of the channels in the group atomically
+   *
+   * `p_duty_cycles[i]` is the duty cycle of the i-th channel of the group, in
+   * the order documented by the implementation, using the same scale as
+   * `hal::pwm16_channel::duty_cycle()`. Channels beyond the end of the span
+   * keep their duty cycle.
+   *
+   * Every value is written to the hardware's shadow (preload) registers and
+   * all of them take effect together at the next period boundary. No period
+   * is ever generated with a mix of old and new duty cycles, and the cost is a
+   * single call, where updating each `hal::pwm16_channel` separately could be
+   * latched by the hardware halfway through. This makes the API suitable for
+   * updating the phases of a motor from a high rate control loop.
+   *
+   * Support for this is optional, as not every pwm peripheral can commit
+   * multiple channels at the same time.
+   *
+   * @param p_duty_cycles - duty cycles, from 0 to 65535, of the channels in
+   * the group
+   * @throws hal::argument_out_of_domain - if the span holds more duty cycles
+   * than the group has channels
+   * @throws hal::operation_not_supported - if the driver cannot update its
+   * channels atomically
+   */
+  void duty_cycles(std::span<u16 const> p_duty_cycles)
+  {
+    driver_duty_cycles(p_duty_cycles);
+  }
+
 private:
   virtual void driver_frequency(u32 p_frequency) = 0;
+  virtual void driver_duty_cycles(std::span<u16 const>)
+  {
+    hal::safe_throw(hal::operation_not_supported(this));
+  }
 };
 
 /**
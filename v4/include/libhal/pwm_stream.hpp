@@ -0,0 +1,172 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <span>
+
+#include "functional.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Hardware abstraction for pwm outputs driven by a sequence of duty
+ * cycles
+ *
+ * `hal::pwm16_channel::duty_cycle()` requires a call from the CPU for every
+ * change of the output, which cannot keep up with waveforms that change every
+ * period, such as WS2812 LED data at 800kHz. Drivers of this interface use DMA,
+ * or a similar mechanism, to load the next duty cycle into the pwm compare
+ * register at each period boundary without CPU intervention, in the same way
+ * that `hal::stream_dac` feeds samples to a dac.
+ *
+ * Duty cycles use the same scale as `hal::pwm16_channel::duty_cycle()`: 0 is
+ * always low and 65535 is always high. Drivers scale them to the resolution of
+ * the timer. When no sequence is playing, the output is held low (0% duty
+ * cycle), which serves as the reset/latch period for WS2812 style LEDs.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::u16, 24 * led_count> bits{};
+ * encode_ws2812(colors, bits, zero_duty, one_duty);
+ * pwm.write({ .frequency = 800.0_kHz, .duty_cycles = bits });
+ * ```
+ */
+class pwm_stream
+{
+public:
+  struct sequence
+  {
+    /**
+     * Frequency of the pwm signal. Each duty cycle in the sequence is output
+     * for exactly one period, making this the rate at which duty cycles are
+     * consumed.
+     */
+    hal::hertz frequency;
+    /**
+     * Span of duty cycles, in order, to output at each period.
+     *
+     * If this is empty (empty() == true), then the write command simply
+     * returns without updating anything.
+     */
+    std::span<u16 const> duty_cycles;
+  };
+
+  /**
+   * @brief Disambiguation tag object for refill events
+   *
+   */
+  struct on_refill_tag
+  {};
+
+  /**
+   * @brief Refill handler signature
+   *
+   * The block passed to the handler has finished playing and will be played
+   * again once the other block finishes. The handler is most likely called
+   * from an interrupt context and must not throw.
+   */
+  using refill_handler = void(on_refill_tag, std::span<u16> p_block);
+
+  /**
+   * @brief Output a sequence of duty cycles, one per period
+   *
+   * This API is a blocking call. Implementations MUST follow the io_concurrency
+   * model and accept an io_waiter object. When the transfer starts, the
+   * io_waiter::wait() function should be called. When the last period has
+   * been output, io_waiter::resume() should be called. The output is low once
+   * this returns.
+   *
+   * This api has a strong exception guarantee, in that, it will throw an
+   * exception before it changes the output.
+   *
+   * @param p_sequence - duty cycles to output and the frequency to output them
+   * at
+   * @throws hal::argument_out_of_domain - when the frequency is not possible
+   * for the pwm peripheral.
+   * @throws hal::device_or_resource_busy - when continuous playback is running
+   */
+  void write(sequence const& p_sequence)
+  {
+    driver_write(p_sequence);
+  }
+
+  /**
+   * @brief Start continuous playback of a buffer of duty cycles
+   *
+   * The buffer is used as two halves in the same way as
+   * `hal::continuous_stream_dac`: the first half is played, then the second,
+   * then the first again, until `stop()` is called. After each half finishes,
+   * the refill handler is called with it and must refill it before the other
+   * half finishes. Both halves must be filled before calling this API. If
+   * playback is already running, it is stopped first.
+   *
+   * This api has a strong exception guarantee, in that, it will throw an
+   * exception before it changes the output.
+   *
+   * @param p_frequency - frequency of the pwm signal, which is the rate at
+   * which duty cycles are consumed
+   * @param p_buffer - buffer of duty cycles to play. Must have an even,
+   * non-zero, number of elements and must remain valid until `stop()` is called
+   * or this object is destroyed.
+   * @param p_refill - called with each block after it finishes playing
+   * @throws hal::argument_out_of_domain - when the frequency is not possible
+   * for the pwm peripheral or the buffer size is not accepted by the driver.
+   */
+  void start(hal::hertz p_frequency,
+             std::span<u16> p_buffer,
+             hal::callback<refill_handler> p_refill)
+  {
+    driver_start(p_frequency, p_buffer, p_refill);
+  }
+
+  /**
+   * @brief Stop continuous playback
+   *
+   * After this returns, the refill handler will not be called again, the
+   * buffer passed to `start()` is no longer used, and the output is low.
+   * Calling this API if playback is not running does nothing.
+   */
+  void stop()
+  {
+    driver_stop();
+  }
+
+  /**
+   * @brief Determine if continuous playback is running
+   *
+   * @return true - playback was started and has not been stopped
+   * @return false - the output is idle
+   */
+  [[nodiscard]] bool playing()
+  {
+    return driver_playing();
+  }
+
+  virtual ~pwm_stream() = default;
+
+private:
+  virtual void driver_write(sequence const& p_sequence) = 0;
+  virtual void driver_start(hal::hertz p_frequency,
+                            std::span<u16> p_buffer,
+                            hal::callback<refill_handler> p_refill) = 0;
+  virtual void driver_stop() = 0;
+  virtual bool driver_playing() = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::pwm_stream;
+}  // namespace hal
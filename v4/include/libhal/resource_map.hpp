@@ -0,0 +1,350 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <optional>
+#include <span>
+
+#include "initializers.hpp"
+#include "units.hpp"
+
+/**
+ * @file resource_map.hpp
+ * @brief Compile time checked map of the hardware resources drivers claim
+ *
+ * Pins, DMA channels and timer channels can only be used by one driver at a
+ * time. Listing every driver's claims in one `hal::make_resource_map()` call
+ * checks, while compiling, that no resource is claimed twice and sorts the
+ * claims into a table. Looking up the owner or the dense index of a resource
+ * is then a constant expression, so drivers and board code need no runtime
+ * conflict checks or maps.
+ *
+ * Example usage:
+ *
+ * ```
+ * enum class owner : u8 { console, sensors, motor };
+ *
+ * constexpr auto board = hal::make_resource_map<owner>(
+ *   hal::claim(owner::console, hal::pin_resource(hal::port<0>, hal::pin<2>)),
+ *   hal::claim(owner::console, hal::pin_resource(hal::port<0>, hal::pin<3>)),
+ *   hal::claim(owner::sensors, hal::dma_resource(hal::bus<1>,
+ *                                                hal::channel<4>)),
+ *   hal::claim(owner::motor, hal::timer_resource(hal::bus<2>,
+ *                                                hal::channel<1>)));
+ *
+ * static_assert(board.owner(hal::pin_resource(hal::port<0>, hal::pin<3>)) ==
+ *               owner::console);
+ *
+ * // Per resource state, indexed without a runtime search
+ * std::array<pin_state, board.size()> states{};
+ * auto& tx = states[board.index(hal::pin_resource(hal::port<0>,
+ *                                                 hal::pin<2>))];
+ * ```
+ *
+ * Adding a fifth claim of `hal::pin_resource(hal::port<0>, hal::pin<2>)` to
+ * the map above fails to compile with a call to `resource_conflict()`.
+ */
+
+namespace hal::v5 {
+/**
+ * @brief Kinds of hardware resource that drivers claim exclusively
+ *
+ */
+enum class resource_kind : u8
+{
+  /// A pin, identified by its port and pin number
+  pin,
+  /// A DMA channel, identified by its controller and channel number
+  dma_channel,
+  /// A timer channel, identified by its timer and channel number
+  timer_channel,
+  /// A whole peripheral, identified by its port or bus number
+  peripheral,
+};
+
+/**
+ * @brief A hardware resource that only one driver may use at a time
+ *
+ */
+struct resource
+{
+  /// Kind of resource
+  resource_kind kind;
+  /// Port, controller, timer or bus the resource belongs to
+  u64 group;
+  /// Pin or channel within the group, 0 for whole peripherals
+  u64 index;
+
+  /**
+   * @brief Enables default comparison and ordering
+   *
+   */
+  constexpr auto operator<=>(resource const&) const = default;
+};
+
+/**
+ * @brief A pin resource
+ *
+ * @param p_port - port of the pin
+ * @param p_pin - pin number within the port
+ * @return constexpr resource - the pin
+ */
+[[nodiscard]] constexpr resource pin_resource(port_param auto p_port,
+                                              pin_param auto p_pin)
+{
+  return { .kind = resource_kind::pin, .group = p_port(), .index = p_pin() };
+}
+
+/**
+ * @brief A DMA channel resource
+ *
+ * @param p_controller - DMA controller number
+ * @param p_channel - channel, or stream, number within the controller
+ * @return constexpr resource - the DMA channel
+ */
+[[nodiscard]] constexpr resource dma_resource(bus_param auto p_controller,
+                                              channel_param auto p_channel)
+{
+  return { .kind = resource_kind::dma_channel,
+           .group = p_controller(),
+           .index = p_channel() };
+}
+
+/**
+ * @brief A timer channel resource
+ *
+ * @param p_timer - timer number
+ * @param p_channel - capture/compare channel number within the timer
+ * @return constexpr resource - the timer channel
+ */
+[[nodiscard]] constexpr resource timer_resource(bus_param auto p_timer,
+                                                channel_param auto p_channel)
+{
+  return { .kind = resource_kind::timer_channel,
+           .group = p_timer(),
+           .index = p_channel() };
+}
+
+/**
+ * @brief A whole peripheral resource, such as a UART or an I2C bus
+ *
+ * @param p_peripheral - port or bus selector of the peripheral
+ * @return constexpr resource - the peripheral
+ */
+[[nodiscard]] constexpr resource peripheral_resource(auto p_peripheral)
+  requires(port_param<decltype(p_peripheral)> ||
+           bus_param<decltype(p_peripheral)>)
+{
+  return { .kind = resource_kind::peripheral,
+           .group = p_peripheral(),
+           .index = 0 };
+}
+
+/**
+ * @brief A resource claimed by a driver
+ *
+ * @tparam Owner - type identifying drivers, typically an enum
+ */
+template<typename Owner>
+struct resource_claim
+{
+  /// Driver that uses the resource
+  Owner owner;
+  /// Resource used
+  resource value;
+};
+
+/**
+ * @brief Claim a resource for a driver
+ *
+ * @param p_owner - driver that uses the resource
+ * @param p_resource - resource used
+ * @return constexpr resource_claim<Owner> - the claim
+ */
+template<typename Owner>
+[[nodiscard]] constexpr resource_claim<Owner> claim(Owner p_owner,
+                                                    resource p_resource)
+{
+  return { .owner = p_owner, .value = p_resource };
+}
+
+/**
+ * @brief Determine if any resource is claimed more than once
+ *
+ * @param p_claims - claims to check
+ * @return true - if two claims name the same resource
+ * @return false - if every resource is claimed at most once
+ */
+template<typename Owner>
+[[nodiscard]] constexpr bool has_conflicts(
+  std::span<resource_claim<Owner> const> p_claims)
+{
+  for (usize i = 0; i < p_claims.size(); i++) {
+    for (usize j = i + 1; j < p_claims.size(); j++) {
+      if (p_claims[i].value == p_claims[j].value) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+namespace detail {
+/// Not constexpr, so calling it while building a resource map at compile time
+/// names the error in the compiler's diagnostic
+inline void resource_conflict()
+{
+}
+}  // namespace detail
+
+/**
+ * @brief Sorted, conflict free table of resource claims
+ *
+ * Built at compile time by `hal::make_resource_map()`.
+ *
+ * @tparam Owner - type identifying drivers
+ * @tparam Count - number of claims
+ */
+template<typename Owner, usize Count>
+class resource_map
+{
+public:
+  /**
+   * @brief Build a map from claims, sorting them by resource
+   *
+   * Prefer `hal::make_resource_map()`, which also rejects conflicts.
+   *
+   * @param p_claims - claims, each of a different resource
+   */
+  constexpr explicit resource_map(
+    std::array<resource_claim<Owner>, Count> p_claims)
+    : m_claims(p_claims)
+  {
+    std::ranges::sort(m_claims, {}, &resource_claim<Owner>::value);
+  }
+
+  /**
+   * @brief Get the number of claimed resources
+   *
+   * @return constexpr usize - number of claims
+   */
+  [[nodiscard]] static constexpr usize size()
+  {
+    return Count;
+  }
+
+  /**
+   * @brief Determine if a resource is claimed
+   *
+   * @param p_resource - resource to look up
+   * @return true - if a driver claimed the resource
+   */
+  [[nodiscard]] constexpr bool contains(resource p_resource) const
+  {
+    return find(p_resource) != Count;
+  }
+
+  /**
+   * @brief Get the driver that claimed a resource
+   *
+   * @param p_resource - resource to look up
+   * @return constexpr std::optional<Owner> - owner of the resource, or
+   * std::nullopt if no driver claimed it
+   */
+  [[nodiscard]] constexpr std::optional<Owner> owner(resource p_resource) const
+  {
+    auto const position = find(p_resource);
+    if (position == Count) {
+      return std::nullopt;
+    }
+    return m_claims[position].owner;
+  }
+
+  /**
+   * @brief Get the dense index of a claimed resource
+   *
+   * Indices run from 0 to `size() - 1` in resource order, so they can index
+   * arrays of per resource state. Claimed resources of the same kind and group
+   * have consecutive indices.
+   *
+   * @param p_resource - claimed resource
+   * @return constexpr usize - index of the resource, or `size()` if it is not
+   * claimed
+   */
+  [[nodiscard]] constexpr usize index(resource p_resource) const
+  {
+    return find(p_resource);
+  }
+
+  /**
+   * @brief Get the claims in resource order
+   *
+   * @return std::span<resource_claim<Owner> const, Count> - sorted claims
+   */
+  [[nodiscard]] constexpr std::span<resource_claim<Owner> const, Count>
+  claims() const
+  {
+    return m_claims;
+  }
+
+private:
+  [[nodiscard]] constexpr usize find(resource p_resource) const
+  {
+    auto const found = std::ranges::lower_bound(
+      m_claims, p_resource, {}, &resource_claim<Owner>::value);
+    if (found == m_claims.end() || found->value != p_resource) {
+      return Count;
+    }
+    return static_cast<usize>(found - m_claims.begin());
+  }
+
+  std::array<resource_claim<Owner>, Count> m_claims;
+};
+
+/**
+ * @brief Build a resource map, failing to compile if a resource is claimed
+ * twice
+ *
+ * @tparam Owner - type identifying drivers, typically an enum
+ * @param p_claims - every claim of the board, created with `hal::claim()`
+ * @return consteval resource_map - sorted claims
+ */
+template<typename Owner, typename... Claims>
+[[nodiscard]] consteval auto make_resource_map(Claims... p_claims)
+{
+  std::array<resource_claim<Owner>, sizeof...(Claims)> claims{ p_claims... };
+  if (has_conflicts(std::span<resource_claim<Owner> const>(claims))) {
+    detail::resource_conflict();
+  }
+  return resource_map<Owner, sizeof...(Claims)>(claims);
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::claim;
+using v5::dma_resource;
+using v5::has_conflicts;
+using v5::make_resource_map;
+using v5::peripheral_resource;
+using v5::pin_resource;
+using v5::resource;
+using v5::resource_claim;
+using v5::resource_kind;
+using v5::resource_map;
+using v5::timer_resource;
+}  // namespace hal
@@ -0,0 +1,226 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+
+#include "error.hpp"
+#include "units.hpp"
+
+/**
+ * @file sample_conversion.hpp
+ * @brief Span conversions between integer ADC/DAC samples, Q15/Q31 fixed point
+ * and float
+ *
+ * The float based `hal::adc` and `hal::dac` interfaces cost a soft-float
+ * conversion per sample on MCUs without an FPU. These kernels let applications
+ * read `hal::adc16`/`hal::adc24` samples, process them as Q15 or Q31 fixed
+ * point, and only convert to float, if at all, at the last step.
+ *
+ * Each kernel is a single branch-free loop over the span, which compilers
+ * vectorize with the SIMD extensions of the target (ARM Helium/NEON, SSE/AVX on
+ * hosts) when auto-vectorization is enabled, such as with `-O3`. The input and
+ * output may not overlap.
+ *
+ * ADC samples map 0 to 0.0 and full scale to the largest positive fixed point
+ * value, using the same bit duplication as the ADC interfaces, so full scale
+ * stays full scale. DAC conversions clamp negative fixed point values to 0.
+ */
+
+namespace hal::v5 {
+namespace detail {
+template<class Input, class Output, class Function>
+std::span<Output> convert_samples(std::span<Input const> p_input,
+                                  std::span<Output> p_output,
+                                  Function p_function)
+{
+  if (p_output.size() < p_input.size()) {
+    hal::safe_throw(hal::argument_out_of_domain(p_output.data()));
+  }
+  auto const* input = p_input.data();
+  auto* output = p_output.data();
+  for (usize i = 0; i < p_input.size(); i++) {
+    output[i] = p_function(input[i]);
+  }
+  return p_output.first(p_input.size());
+}
+}  // namespace detail
+
+/**
+ * @brief Convert `hal::adc16` samples to Q15 fixed point
+ *
+ * 0 becomes 0 (0.0) and 0xFFFF becomes 0x7FFF (~1.0).
+ *
+ * @param p_samples - samples to convert
+ * @param p_output - destination, at least as large as p_samples
+ * @return std::span<i16> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_samples
+ */
+inline std::span<i16> adc16_to_q15(std::span<u16 const> p_samples,
+                                   std::span<i16> p_output)
+{
+  return detail::convert_samples(
+    p_samples, p_output, [](u16 p_sample) -> i16 { return p_sample >> 1; });
+}
+
+/**
+ * @brief Convert `hal::adc16` samples to Q31 fixed point
+ *
+ * 0 becomes 0 (0.0) and 0xFFFF becomes 0x7FFF'FFFF (~1.0).
+ *
+ * @param p_samples - samples to convert
+ * @param p_output - destination, at least as large as p_samples
+ * @return std::span<i32> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_samples
+ */
+inline std::span<i32> adc16_to_q31(std::span<u16 const> p_samples,
+                                   std::span<i32> p_output)
+{
+  return detail::convert_samples(
+    p_samples, p_output, [](u16 p_sample) -> i32 {
+      u32 const sample = p_sample;
+      return static_cast<i32>((sample << 15) | (sample >> 1));
+    });
+}
+
+/**
+ * @brief Convert `hal::adc24` samples to Q31 fixed point
+ *
+ * 0 becomes 0 (0.0) and 0xFF'FFFF becomes 0x7FFF'FFFF (~1.0). Bits above the
+ * 24th are ignored.
+ *
+ * @param p_samples - samples to convert
+ * @param p_output - destination, at least as large as p_samples
+ * @return std::span<i32> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_samples
+ */
+inline std::span<i32> adc24_to_q31(std::span<u32 const> p_samples,
+                                   std::span<i32> p_output)
+{
+  return detail::convert_samples(
+    p_samples, p_output, [](u32 p_sample) -> i32 {
+      u32 const sample = p_sample & 0xFF'FFFF;
+      return static_cast<i32>((sample << 7) | (sample >> 17));
+    });
+}
+
+/**
+ * @brief Convert `hal::adc16` samples to floats from 0.0f to 1.0f
+ *
+ * Produces the same values as a `hal::adc` driver built on the sample source.
+ *
+ * @param p_samples - samples to convert
+ * @param p_output - destination, at least as large as p_samples
+ * @return std::span<float> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_samples
+ */
+inline std::span<float> adc16_to_float(std::span<u16 const> p_samples,
+                                       std::span<float> p_output)
+{
+  return detail::convert_samples(
+    p_samples, p_output, [](u16 p_sample) -> float {
+      constexpr float scale = 1.0f / 0xFFFF;
+      return static_cast<float>(p_sample) * scale;
+    });
+}
+
+/**
+ * @brief Convert `hal::adc24` samples to floats from 0.0f to 1.0f
+ *
+ * @param p_samples - samples to convert
+ * @param p_output - destination, at least as large as p_samples
+ * @return std::span<float> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_samples
+ */
+inline std::span<float> adc24_to_float(std::span<u32 const> p_samples,
+                                       std::span<float> p_output)
+{
+  return detail::convert_samples(
+    p_samples, p_output, [](u32 p_sample) -> float {
+      constexpr float scale = 1.0f / 0xFF'FFFF;
+      return static_cast<float>(p_sample & 0xFF'FFFF) * scale;
+    });
+}
+
+/**
+ * @brief Convert Q15 fixed point values to `hal::dac16` samples
+ *
+ * Negative values become 0 and 0x7FFF (~1.0) becomes 0xFFFF.
+ *
+ * @param p_values - values to convert
+ * @param p_output - destination, at least as large as p_values
+ * @return std::span<u16> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_values
+ */
+inline std::span<u16> q15_to_dac16(std::span<i16 const> p_values,
+                                   std::span<u16> p_output)
+{
+  return detail::convert_samples(p_values, p_output, [](i16 p_value) -> u16 {
+    auto const value = static_cast<u32>(std::max<i32>(p_value, 0));
+    return static_cast<u16>((value << 1) | (value >> 14));
+  });
+}
+
+/**
+ * @brief Convert Q31 fixed point values to `hal::dac16` samples
+ *
+ * Negative values become 0 and 0x7FFF'FFFF (~1.0) becomes 0xFFFF.
+ *
+ * @param p_values - values to convert
+ * @param p_output - destination, at least as large as p_values
+ * @return std::span<u16> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_values
+ */
+inline std::span<u16> q31_to_dac16(std::span<i32 const> p_values,
+                                   std::span<u16> p_output)
+{
+  return detail::convert_samples(p_values, p_output, [](i32 p_value) -> u16 {
+    return static_cast<u16>(std::max<i32>(p_value, 0) >> 15);
+  });
+}
+
+/**
+ * @brief Convert floats from 0.0f to 1.0f to `hal::dac16` samples
+ *
+ * Values are clamped to the range 0.0f to 1.0f and rounded to the nearest
+ * sample.
+ *
+ * @param p_values - values to convert
+ * @param p_output - destination, at least as large as p_values
+ * @return std::span<u16> - the converted portion of p_output
+ * @throws hal::argument_out_of_domain - if p_output is smaller than p_values
+ */
+inline std::span<u16> float_to_dac16(std::span<float const> p_values,
+                                     std::span<u16> p_output)
+{
+  return detail::convert_samples(
+    p_values, p_output, [](float p_value) -> u16 {
+      auto const value = std::clamp(p_value, 0.0f, 1.0f);
+      return static_cast<u16>((value * 0xFFFF) + 0.5f);
+    });
+}
+}  // namespace hal::v5
+
+namespace hal {
+using v5::adc16_to_float;
+using v5::adc16_to_q15;
+using v5::adc16_to_q31;
+using v5::adc24_to_float;
+using v5::adc24_to_q31;
+using v5::float_to_dac16;
+using v5::q15_to_dac16;
+using v5::q31_to_dac16;
+}  // namespace hal
@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <span>
+#include <type_traits>
 
 #include "units.hpp"
 
@@ -103,10 +106,75 @@ constexpr auto make_scatter_array(Args&&... args)
     std::forward<Args>(args))... };
 }
 
+namespace detail {
+/// Compare two runs of elements, with memcmp where equal object
+/// representations mean equal values and the call is not constant evaluated
+template<typename T>
+constexpr bool equal_run(T* p_lhs, T* p_rhs, usize p_count)
+{
+  if constexpr (std::has_unique_object_representations_v<T>) {
+    if (not std::is_constant_evaluated()) {
+      return std::memcmp(p_lhs, p_rhs, p_count * sizeof(T)) == 0;
+    }
+  }
+  return std::equal(p_lhs, p_lhs + p_count, p_rhs);
+}
+
+/// Walks the non-empty segments of a scatter span one run at a time
+template<typename T>
+class scatter_cursor
+{
+public:
+  constexpr explicit scatter_cursor(scatter_span<T> p_segments)
+    : m_segments(p_segments)
+  {
+    skip_empty();
+  }
+
+  /// Returns true once every element has been taken
+  [[nodiscard]] constexpr bool done() const
+  {
+    return m_current.empty();
+  }
+
+  /// Returns the number of elements left in the current segment
+  [[nodiscard]] constexpr usize available() const
+  {
+    return m_current.size();
+  }
+
+  /// Takes the next p_count elements, which must not exceed `available()`
+  constexpr std::span<T> take(usize p_count)
+  {
+    auto const run = m_current.first(p_count);
+    m_current = m_current.subspan(p_count);
+    skip_empty();
+    return run;
+  }
+
+private:
+  constexpr void skip_empty()
+  {
+    while (m_current.empty() && m_next < m_segments.size()) {
+      m_current = m_segments[m_next++];
+    }
+  }
+
+  scatter_span<T> m_segments;
+  usize m_next = 0;
+  std::span<T> m_current{};
+};
+}  // namespace detail
+
 /**
  * @brief Compare two scatter spans of type T are equal regardless of their
  * underlying topologies and sizes.
  *
+ * The scatter spans are equal if the concatenation of their segments holds the
+ * same elements. Empty segments are skipped, and the elements are compared one
+ * overlapping run of a pair of segments at a time, using `std::memcmp` for
+ * types whose values are equal exactly when their bytes are.
+ *
  * @tparam T - The element type of the sub‑spans.
  * @param lhs - The scatter_span on the left hand side of the expression to be
  * compared against the right hand side's scatter_span.
@@ -120,58 +188,17 @@ template<typename T>
 constexpr bool operator==(scatter_span<T> const& lhs,
                           scatter_span<T> const& rhs)
 {
-  if (lhs.size() < 1 || rhs.size() < 1) {
-    return false;
-  }
-
-  std::pair<size_t, size_t> lhs_pos = { 0, 0 };
-  std::pair<size_t, size_t> rhs_pos = { 0, 0 };
-
-  std::span<T const> l = lhs[lhs_pos.first];
-  std::span<T const> r = rhs[rhs_pos.first];
-
-  bool lhs_finished = false;
-  bool rhs_finished = false;
-
-  while (true) {
+  detail::scatter_cursor<T> l(lhs);
+  detail::scatter_cursor<T> r(rhs);
 
-    if (l[lhs_pos.second] != r[rhs_pos.second]) {
+  while (not l.done() && not r.done()) {
+    auto const run = std::min(l.available(), r.available());
+    if (not detail::equal_run(l.take(run).data(), r.take(run).data(), run)) {
       return false;
     }
-
-    if (lhs_pos.second >= l.size() - 1) {
-      lhs_pos.first++;
-      lhs_pos.second = 0;
-      if (lhs_pos.first > lhs.size() - 1) {
-        lhs_finished = true;
-      } else {
-        l = lhs[lhs_pos.first];
-      }
-
-    } else {
-      lhs_pos.second++;
-    }
-
-    if (rhs_pos.second >= r.size() - 1) {
-      rhs_pos.first++;
-      rhs_pos.second = 0;
-      if (rhs_pos.first > rhs.size() - 1) {
-        rhs_finished = true;
-      } else {
-        r = rhs[rhs_pos.first];
-      }
-    } else {
-      rhs_pos.second++;
-    }
-
-    if (lhs_finished || rhs_finished) {
-      if (lhs_finished && rhs_finished) {
-        return true;
-      } else {
-        return false;
-      }
-    }
   }
+
+  return l.done() && r.done();
 }
 
 /**
@@ -194,6 +221,86 @@ constexpr bool operator!=(scatter_span<T> const& lhs,
   return !(lhs == rhs);
 }
 
+/**
+ * @brief Get the total number of elements in a scatter span
+ *
+ * @tparam T - The element type of the sub‑spans.
+ * @param p_segments - scatter span to count the elements of
+ * @return usize - sum of the sizes of every segment
+ */
+template<typename T>
+constexpr usize scatter_size(scatter_span<T> p_segments)
+{
+  usize total = 0;
+  for (auto const& segment : p_segments) {
+    total += segment.size();
+  }
+  return total;
+}
+
+/**
+ * @brief Copy the elements of one scatter span into another
+ *
+ * Copies elements in order until either scatter span runs out, with one copy
+ * per overlapping run of a pair of non-empty segments, so gathering several
+ * segments into a contiguous buffer, such as a DMA bounce buffer, takes one
+ * copy per segment.
+ *
+ * @tparam T - The element type of the sub‑spans.
+ * @param p_source - elements to copy
+ * @param p_destination - segments to copy the elements into
+ * @return usize - number of elements copied, the smaller of the two scatter
+ * sizes
+ */
+template<typename T>
+constexpr usize scatter_copy(scatter_span<T const> p_source,
+                             scatter_span<T> p_destination)
+{
+  detail::scatter_cursor<T const> from(p_source);
+  detail::scatter_cursor<T> to(p_destination);
+  usize copied = 0;
+
+  while (not from.done() && not to.done()) {
+    auto const run = std::min(from.available(), to.available());
+    std::ranges::copy(from.take(run), to.take(run).begin());
+    copied += run;
+  }
+
+  return copied;
+}
+
+/**
+ * @brief Gather the elements of a scatter span into a contiguous buffer
+ *
+ * @tparam T - The element type of the sub‑spans.
+ * @param p_source - elements to copy
+ * @param p_destination - buffer to copy the elements into
+ * @return usize - number of elements copied
+ */
+template<typename T>
+constexpr usize scatter_copy(scatter_span<T const> p_source,
+                             std::span<T> p_destination)
+{
+  std::array<std::span<T>, 1> const destination{ p_destination };
+  return scatter_copy(p_source, scatter_span<T>(destination));
+}
+
+/**
+ * @brief Scatter the elements of a contiguous buffer into a scatter span
+ *
+ * @tparam T - The element type of the sub‑spans.
+ * @param p_source - elements to copy
+ * @param p_destination - segments to copy the elements into
+ * @return usize - number of elements copied
+ */
+template<typename T>
+constexpr usize scatter_copy(std::span<T const> p_source,
+                             scatter_span<T> p_destination)
+{
+  std::array<std::span<T const>, 1> const source{ p_source };
+  return scatter_copy(scatter_span<T const>(source), p_destination);
+}
+
 /**
  * @brief Convenience overload that creates a scatter array for
  * `hal::byte` (i.e. raw bytes).
@@ -281,6 +388,8 @@ namespace hal {
 using v5::make_scatter_array;
 using v5::make_scatter_bytes;
 using v5::make_writable_scatter_bytes;
+using v5::scatter_copy;
+using v5::scatter_size;
 using v5::scatter_span;
 using v5::spanable;
 using v5::spanable_bytes;
@@ -0,0 +1,342 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <memory_resource>
+#include <optional>
+
+#include "circular_buffer.hpp"
+#include "error.hpp"
+#include "functional.hpp"
+#include "timer.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Downsample a stream of samples by averaging groups of samples
+ *
+ * Every `factor` samples pushed produce one output sample, the mean of the
+ * group, which also low pass filters the signal before downsampling. Each push
+ * is O(1) and no memory is allocated.
+ *
+ * @tparam T - floating point sample type
+ */
+template<std::floating_point T = float>
+class decimator
+{
+public:
+  /**
+   * @brief Construct a decimator
+   *
+   * @param p_factor - number of input samples per output sample
+   * @throws hal::argument_out_of_domain - if p_factor is 0
+   */
+  explicit decimator(usize p_factor)
+    : m_factor(p_factor)
+  {
+    if (p_factor == 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+  }
+
+  /**
+   * @brief Add a sample
+   *
+   * @param p_sample - sample to add
+   * @return std::optional<T> - mean of the group if this sample completed it,
+   * std::nullopt otherwise
+   */
+  std::optional<T> push(T p_sample)
+  {
+    m_sum += p_sample;
+    m_count++;
+    if (m_count < m_factor) {
+      return std::nullopt;
+    }
+    auto const mean = m_sum / static_cast<T>(m_factor);
+    m_sum = T{};
+    m_count = 0;
+    return mean;
+  }
+
+  /**
+   * @brief Get the number of input samples per output sample
+   *
+   * @return usize - decimation factor
+   */
+  [[nodiscard]] usize factor() const
+  {
+    return m_factor;
+  }
+
+private:
+  usize m_factor;
+  usize m_count = 0;
+  T m_sum{};
+};
+
+/**
+ * @brief Moving average over the latest samples of a stream
+ *
+ * Keeps a running sum of the samples in the window, so each push is O(1)
+ * regardless of the window size and `value()` never iterates over the window.
+ * Until the window is full, the average is over the samples pushed so far.
+ *
+ * The running sum accumulates rounding error over very long streams. Call
+ * `reset()` periodically if the average must stay exact over millions of
+ * samples.
+ *
+ * @tparam T - floating point sample type
+ */
+template<std::floating_point T = float>
+class moving_average
+{
+public:
+  /**
+   * @brief Construct a moving average
+   *
+   * @param p_allocator - allocator for the window's storage
+   * @param p_window - number of samples to average over. A window of 0 is
+   * treated as 1.
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  moving_average(std::pmr::polymorphic_allocator<byte> p_allocator,
+                 usize p_window)
+    : m_window(p_allocator, p_window)
+  {
+  }
+
+  /**
+   * @brief Add a sample, replacing the oldest sample of a full window
+   *
+   * @param p_sample - sample to add
+   * @return T - average after adding the sample
+   */
+  T push(T p_sample)
+  {
+    m_sum += p_sample - m_window[m_window.write_index()];
+    m_window.push(p_sample);
+    m_count = std::min(m_count + 1, m_window.capacity());
+    return value();
+  }
+
+  /**
+   * @brief Get the current average
+   *
+   * @return T - average of the samples in the window, 0 if none were pushed
+   */
+  [[nodiscard]] T value() const
+  {
+    if (m_count == 0) {
+      return T{};
+    }
+    return m_sum / static_cast<T>(m_count);
+  }
+
+  /**
+   * @brief Get the number of samples averaged over when the window is full
+   *
+   * @return usize - window size
+   */
+  [[nodiscard]] usize window() const
+  {
+    return m_window.capacity();
+  }
+
+  /**
+   * @brief Discard every sample in the window
+   *
+   */
+  void reset()
+  {
+    for (usize i = 0; i < m_window.capacity(); i++) {
+      m_window[i] = T{};
+    }
+    m_sum = T{};
+    m_count = 0;
+  }
+
+private:
+  circular_buffer<T> m_window;
+  usize m_count = 0;
+  T m_sum{};
+};
+
+/**
+ * @brief Sample a sensor periodically into a circular buffer
+ *
+ * Reads a sensor from a `hal::timer` callback every period, decimates the
+ * samples and pushes each decimated sample into a circular buffer supplied by
+ * the application, where it can be processed in place. A moving average of the
+ * decimated samples is kept up to date, so consumers can read a filtered value
+ * at any time without recomputing over the window.
+ *
+ * The timer is rescheduled at the start of each callback, so the period is
+ * accurate to the latency of the timer's interrupt.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::circular_buffer<float> history(allocator, 64);
+ * hal::periodic_sampler<float> sampler(
+ *   allocator, timer, [&encoder]() { return encoder.read().angle; }, history,
+ *   { .period = 100us, .decimation = 10, .average_window = 8 });
+ * sampler.start();
+ * // ...
+ * auto const angle = sampler.average();
+ * ```
+ *
+ * @tparam T - floating point sample type
+ */
+template<std::floating_point T = float>
+class periodic_sampler
+{
+public:
+  /// Function that reads one sample from the sensor
+  using reader = hal::callback<T()>;
+
+  /**
+   * @brief Settings of the sampler
+   *
+   */
+  struct settings
+  {
+    /// Time between reads of the sensor
+    hal::time_duration period{};
+    /// Number of reads averaged into each sample pushed into the buffer
+    usize decimation = 1;
+    /// Number of decimated samples that `average()` is computed over
+    usize average_window = 1;
+  };
+
+  /**
+   * @brief Construct a sampler
+   *
+   * @param p_allocator - allocator for the moving average's window
+   * @param p_timer - timer to schedule reads with. Must outlive this object.
+   * @param p_reader - function that reads the sensor, called from the timer's
+   * callback
+   * @param p_output - buffer to push decimated samples into. Must outlive this
+   * object.
+   * @param p_settings - period and filter settings
+   * @throws hal::argument_out_of_domain - if the decimation factor is 0
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  periodic_sampler(std::pmr::polymorphic_allocator<byte> p_allocator,
+                   hal::timer& p_timer,
+                   reader p_reader,
+                   circular_buffer<T>& p_output,
+                   settings const& p_settings)
+    : m_timer(&p_timer)
+    , m_reader(p_reader)
+    , m_output(&p_output)
+    , m_decimator(p_settings.decimation)
+    , m_average(p_allocator, p_settings.average_window)
+    , m_period(p_settings.period)
+  {
+  }
+
+  periodic_sampler(periodic_sampler const&) = delete;
+  periodic_sampler& operator=(periodic_sampler const&) = delete;
+  periodic_sampler(periodic_sampler&&) = delete;
+  periodic_sampler& operator=(periodic_sampler&&) = delete;
+
+  ~periodic_sampler()
+  {
+    stop();
+  }
+
+  /**
+   * @brief Start reading the sensor every period
+   *
+   * @throws hal::argument_out_of_domain - if the timer cannot be scheduled
+   * with the period
+   */
+  void start()
+  {
+    m_running = true;
+    schedule();
+  }
+
+  /**
+   * @brief Stop reading the sensor
+   *
+   */
+  void stop()
+  {
+    m_running = false;
+    m_timer->cancel();
+  }
+
+  /**
+   * @brief Get the moving average of the latest decimated samples
+   *
+   * @return T - filtered value, 0 if no sample has been produced yet
+   */
+  [[nodiscard]] T average() const
+  {
+    return m_average.value();
+  }
+
+  /**
+   * @brief Get the number of decimated samples pushed into the buffer
+   *
+   * The count wraps at the maximum of `usize`.
+   *
+   * @return usize - number of samples since construction
+   */
+  [[nodiscard]] usize count() const
+  {
+    return m_count;
+  }
+
+private:
+  void schedule()
+  {
+    m_timer->schedule([this]() { tick(); }, m_period);
+  }
+
+  void tick()
+  {
+    if (not m_running) {
+      return;
+    }
+    schedule();
+    auto const sample = m_decimator.push(m_reader());
+    if (sample) {
+      m_output->push(*sample);
+      m_average.push(*sample);
+      m_count++;
+    }
+  }
+
+  hal::timer* m_timer;
+  reader m_reader;
+  circular_buffer<T>* m_output;
+  decimator<T> m_decimator;
+  moving_average<T> m_average;
+  hal::time_duration m_period;
+  usize m_count = 0;
+  bool m_running = false;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::decimator;
+using v5::moving_average;
+using v5::periodic_sampler;
+}  // namespace hal
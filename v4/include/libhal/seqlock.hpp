@@ -0,0 +1,151 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Latest value of data written by an interrupt and read by threads
+ *
+ * Drivers that update sensor readings or servo status from an interrupt, such
+ * as an `hal::accelerometer::read_t` filled by a data ready interrupt, need
+ * readers to get a copy that is not half old and half new. Disabling
+ * interrupts around the copy works but delays every interrupt by the length of
+ * the copy. With a seqlock the writer never waits and never has interrupts
+ * masked: readers detect a copy that raced with the writer and retry.
+ *
+ * The value is double buffered. The writer fills the slot that does not hold
+ * the latest value, then publishes it, so a reader copying the latest value
+ * only has to retry when the writer completes a second write and starts
+ * reusing the reader's slot before the copy finishes. Each slot has a sequence
+ * counter that is odd while the slot is being written.
+ *
+ * Only atomic loads and stores are used, never read-modify-write operations,
+ * so the seqlock works on processors without exclusive load/store
+ * instructions such as the Cortex-M0.
+ *
+ * There must be a single writer, or writers must not preempt each other. Any
+ * number of readers, in any context of lower priority than the writer or on
+ * another core, may read at once.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::seqlock<hal::accelerometer::read_t> latest;
+ *
+ * void data_ready_isr() { latest.write(read_registers()); }
+ *
+ * void control_thread() {
+ *   auto const acceleration = latest.read();
+ * }
+ * ```
+ *
+ * @tparam T - type of the value, which must be trivially copyable
+ */
+template<typename T>
+class seqlock
+{
+public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "seqlock values are copied while they may be written, so they "
+                "must be trivially copyable");
+
+  /**
+   * @brief Construct a seqlock holding a value initialized T
+   *
+   */
+  seqlock() = default;
+
+  /**
+   * @brief Construct a seqlock holding an initial value
+   *
+   * @param p_initial - value returned by `read()` until the first `write()`
+   */
+  explicit seqlock(T const& p_initial)
+  {
+    m_slots[0].value = p_initial;
+  }
+
+  seqlock(seqlock const&) = delete;
+  seqlock& operator=(seqlock const&) = delete;
+  seqlock(seqlock&&) = delete;
+  seqlock& operator=(seqlock&&) = delete;
+  ~seqlock() = default;
+
+  /**
+   * @brief Replace the value
+   *
+   * Never blocks, so it is safe to call from an interrupt service routine.
+   *
+   * @param p_value - new value
+   */
+  void write(T const& p_value)
+  {
+    auto const index = m_latest.load(std::memory_order_relaxed) ^ 1U;
+    auto& slot = m_slots[index];
+    auto const sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = p_value;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    m_latest.store(index, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copy the latest value
+   *
+   * Retries until it copies a value no write modified during the copy, which
+   * takes a single attempt unless the writer completes two writes while a
+   * value is being copied.
+   *
+   * @return T - the value passed to the most recent `write()`
+   */
+  [[nodiscard]] T read() const
+  {
+    while (true) {
+      auto const& slot = m_slots[m_latest.load(std::memory_order_acquire)];
+      auto const before = slot.sequence.load(std::memory_order_acquire);
+      if (before % 2 != 0) {
+        continue;
+      }
+      T copy = slot.value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == before) {
+        return copy;
+      }
+    }
+  }
+
+private:
+  struct slot_t
+  {
+    std::atomic<u32> sequence = 0;
+    T value{};
+  };
+
+  std::array<slot_t, 2> m_slots{};
+  std::atomic<u32> m_latest = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::seqlock;
+}  // namespace hal
@@ -15,8 +15,11 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
 #include <span>
 
+#include "functional.hpp"
+#include "scatter_span.hpp"
 #include "units.hpp"
 
 namespace hal {
@@ -307,6 +310,71 @@ public:
     driver_write(p_data);
   }
 
+  /**
+   * @brief Write several non-contiguous blocks of data to the transmitter line
+   * of the serial port
+   *
+   * The blocks are transmitted back to back in order, as if they were a single
+   * contiguous buffer. This allows a header, payload and checksum held in
+   * separate buffers to be sent without copying them into a staging buffer.
+   *
+   * The default implementation calls `write()` for each block. Drivers that
+   * can chain DMA descriptors, or otherwise transmit multiple buffers in a
+   * single transfer, should override this for better performance.
+   *
+   * @param p_data - scatter span of bytes to be transmitted over the serial
+   * port
+   */
+  void write(scatter_span<hal::byte const> p_data)
+  {
+    driver_write_scatter(p_data);
+  }
+
+  /**
+   * @brief Start transmitting data without waiting for it to be accepted
+   *
+   * Begins transmitting p_data, usually via DMA, and returns immediately. Once
+   * every byte of p_data has been handed to the hardware, p_on_complete is
+   * called. Drivers may call p_on_complete from within an interrupt context,
+   * so it must be kept short and must not throw.
+   *
+   * Buffer lifetime contract: p_data is NOT copied. The memory it refers to
+   * must remain valid and unmodified until p_on_complete has been called or
+   * `write_in_flight()` returns 0.
+   *
+   * If a previous asynchronous transmission is still in flight, this call
+   * blocks until it has completed before starting the new one. Calls to the
+   * blocking `write()` APIs also wait for any in flight transmission to
+   * complete first, so the order of bytes on the line always matches the
+   * order of the calls.
+   *
+   * The default implementation performs a blocking `write()` and then calls
+   * p_on_complete before returning. Drivers with DMA transmit support should
+   * override this.
+   *
+   * @param p_data - data to be transmitted over the serial port. Must outlive
+   * the transmission.
+   * @param p_on_complete - called once p_data has been transmitted
+   */
+  void write_async(std::span<hal::byte const> p_data,
+                   hal::callback<void()> p_on_complete)
+  {
+    driver_write_async(p_data, p_on_complete);
+  }
+
+  /**
+   * @brief Get the number of bytes that have yet to be transmitted by an
+   * asynchronous write
+   *
+   * @return usize - number of bytes of the current asynchronous write that
+   * have not been handed to the hardware yet. Returns 0 when no asynchronous
+   * write is in flight.
+   */
+  [[nodiscard]] usize write_in_flight()
+  {
+    return driver_write_in_flight();
+  }
+
   /**
    * @brief Returns this serial driver's receive buffer
    *
@@ -364,6 +432,27 @@ public:
     return driver_cursor();
   }
 
+  /**
+   * @brief Returns the total number of bytes received by the serial port
+   *
+   * The count starts at an arbitrary value and increases by one for every byte
+   * written into the receive buffer, wrapping around at the maximum value of
+   * `usize`. Unlike `receive_cursor()`, which wraps at the size of the receive
+   * buffer, the difference between two counts reveals whether more than a
+   * buffer's worth of data arrived between two reads, meaning that the
+   * producer has lapped the reader and data was lost.
+   *
+   * Support for this is optional. Drivers that do not track the number of
+   * received bytes return `std::nullopt`.
+   *
+   * @return std::optional<usize> - running count of received bytes or
+   * std::nullopt if the driver does not count received bytes.
+   */
+  [[nodiscard]] std::optional<usize> receive_count()
+  {
+    return driver_receive_count();
+  }
+
   virtual ~serial() = default;
 
 private:
@@ -371,5 +460,137 @@ private:
   virtual void driver_write(std::span<hal::byte const> p_data) = 0;
   virtual std::span<hal::byte const> driver_receive_buffer() = 0;
   virtual std::size_t driver_cursor() = 0;
+  virtual void driver_write_scatter(scatter_span<hal::byte const> p_data)
+  {
+    for (auto const& data : p_data) {
+      driver_write(data);
+    }
+  }
+  virtual std::optional<usize> driver_receive_count()
+  {
+    return std::nullopt;
+  }
+  virtual void driver_write_async(std::span<hal::byte const> p_data,
+                                  hal::callback<void()> p_on_complete)
+  {
+    driver_write(p_data);
+    p_on_complete();
+  }
+  virtual usize driver_write_in_flight()
+  {
+    return 0;
+  }
+};
+
+/**
+ * @brief Serial receive notification hardware abstraction interface
+ *
+ * Optional companion interface for serial drivers with a circular receive
+ * buffer, such as `hal::v5::serial` and `hal::zero_copy_serial`. Rather than
+ * polling `receive_cursor()` or taking an interrupt per byte, applications can
+ * be notified once a block of bytes has arrived or once the line has gone idle
+ * after a burst of data, which usually marks the end of a frame.
+ *
+ * Implementations of this interface are NOT sharable across multiple device or
+ * applications drivers. If shared, only the last handler set will be the one
+ * that will execute on notification.
+ */
+class serial_receive_interrupt
+{
+public:
+  /**
+   * @brief Disambiguation tag object for receive events
+   *
+   */
+  struct on_receive_tag
+  {};
+
+  /**
+   * @brief The condition that caused a receive notification
+   *
+   */
+  enum class receive_event : u8
+  {
+    /// At least `settings::watermark` bytes arrived since the last
+    /// notification
+    watermark,
+    /// The receive line was idle for at least one frame time after receiving
+    /// data
+    idle,
+  };
+
+  /// Settings for receive notifications
+  struct settings
+  {
+    /// Number of received bytes that triggers a watermark notification. Set to
+    /// 0 to disable watermark notifications.
+    usize watermark = 0;
+
+    /// Notify when the line goes idle after receiving data
+    bool idle_line = true;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator<=>(settings const&) const = default;
+  };
+
+  /**
+   * @brief Receive handler signature
+   *
+   */
+  using receive_handler = void(on_receive_tag, receive_event);
+
+  /**
+   * @brief Optional receive handler
+   *
+   * Either contains a receive handler OR is std::nullopt which means "disable"
+   * receive notifications.
+   *
+   */
+  using optional_receive_handler =
+    std::optional<hal::callback<receive_handler>>;
+
+  /**
+   * @brief Configure the conditions that trigger receive notifications
+   *
+   * Implementing drivers must verify if the settings can be applied to hardware
+   * before modifying the hardware.
+   *
+   * @param p_settings - settings to apply
+   * @throws hal::operation_not_supported - if the watermark cannot be achieved,
+   * for example, if it exceeds the receive buffer size or if the hardware
+   * cannot detect an idle line.
+   */
+  void configure(settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Set a callback to occur when a receive event occurs
+   *
+   * The callback will most likely be executed in an interrupt context. Keep it
+   * short, such as resuming a task or setting a flag, and read the data from
+   * the receive buffer outside of the interrupt.
+   *
+   * @param p_callback - callback to be called on a receive event. Set to
+   * std::nullopt to disable the callback.
+   */
+  void on_receive(optional_receive_handler p_callback)
+  {
+    driver_on_receive(p_callback);
+  }
+
+  virtual ~serial_receive_interrupt() = default;
+
+private:
+  virtual void driver_configure(settings const& p_settings) = 0;
+  virtual void driver_on_receive(optional_receive_handler p_callback) = 0;
 };
 }  // namespace hal::v5
+
+namespace hal {
+using v5::serial_receive_interrupt;
+}  // namespace hal
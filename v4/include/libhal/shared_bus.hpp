@@ -0,0 +1,500 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <span>
+
+#include "error.hpp"
+#include "functional.hpp"
+#include "i2c.hpp"
+#include "lock.hpp"
+#include "scatter_span.hpp"
+#include "spi.hpp"
+#include "timeout.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Bus usage counters for a device sharing a bus
+ *
+ * Every counter is only modified by the device handle that owns it, and
+ * therefore should only be read from the thread using that handle.
+ */
+struct shared_bus_statistics
+{
+  /// Number of times the device acquired the bus
+  u32 acquisitions = 0;
+  /// Number of acquisitions where the bus was held by another device and the
+  /// device had to wait. Only counted if the lock is a `hal::pollable_lock`.
+  u32 contentions = 0;
+  /// Number of acquisitions where the bus had to be reconfigured because the
+  /// previous user of the bus had different settings
+  u32 reconfigurations = 0;
+  /// Number of acquisitions that timed out. Only counted if the lock is a
+  /// `hal::timed_lock` with a timeout.
+  u32 timeouts = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(shared_bus_statistics const&) const = default;
+};
+
+namespace detail {
+/**
+ * @brief Lock shared by every device on a bus, with contention accounting
+ *
+ */
+class shared_bus_lock
+{
+public:
+  explicit shared_bus_lock(hal::basic_lock& p_lock)
+    : m_lock(&p_lock)
+  {
+  }
+
+  explicit shared_bus_lock(hal::pollable_lock& p_lock)
+    : m_lock(&p_lock)
+    , m_pollable(&p_lock)
+  {
+  }
+
+  shared_bus_lock(hal::timed_lock& p_lock, hal::time_duration p_timeout)
+    : m_lock(&p_lock)
+    , m_pollable(&p_lock)
+    , m_timed(&p_lock)
+    , m_timeout(p_timeout)
+  {
+  }
+
+  void acquire(void const* p_instance, shared_bus_statistics& p_statistics)
+  {
+    if (m_pollable && m_pollable->try_lock()) {
+      p_statistics.acquisitions++;
+      return;
+    }
+
+    if (m_pollable) {
+      p_statistics.contentions++;
+    }
+
+    if (m_timed) {
+      if (not m_timed->try_lock_for(m_timeout)) {
+        p_statistics.timeouts++;
+        hal::safe_throw(hal::timed_out(p_instance));
+      }
+    } else {
+      m_lock->lock();
+    }
+
+    p_statistics.acquisitions++;
+  }
+
+  void release()
+  {
+    m_lock->unlock();
+  }
+
+private:
+  hal::basic_lock* m_lock;
+  hal::pollable_lock* m_pollable = nullptr;
+  hal::timed_lock* m_timed = nullptr;
+  hal::time_duration m_timeout{};
+};
+
+/**
+ * @brief Releases a shared bus lock when leaving scope
+ *
+ */
+class shared_bus_guard
+{
+public:
+  shared_bus_guard(shared_bus_lock& p_lock,
+                   void const* p_instance,
+                   shared_bus_statistics& p_statistics)
+    : m_lock(&p_lock)
+  {
+    m_lock->acquire(p_instance, p_statistics);
+  }
+
+  shared_bus_guard(shared_bus_guard const&) = delete;
+  shared_bus_guard& operator=(shared_bus_guard const&) = delete;
+
+  ~shared_bus_guard()
+  {
+    m_lock->release();
+  }
+
+private:
+  shared_bus_lock* m_lock;
+};
+}  // namespace detail
+
+/**
+ * @brief Shares one i2c bus between drivers running in different threads
+ *
+ * Create one `shared_i2c` for the bus and one `shared_i2c::device` handle for
+ * each driver. Each handle is a `hal::i2c` that acquires the bus lock for the
+ * duration of every transaction. Each handle remembers the settings passed to
+ * its own `configure()`, and the bus is only reconfigured when a transaction
+ * is performed by a handle whose settings differ from those the bus was last
+ * configured with. Repeated calls to `configure()` with the same settings are
+ * therefore free.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::shared_i2c bus(i2c, mutex);
+ * hal::shared_i2c::device imu_bus(bus);
+ * hal::shared_i2c::device eeprom_bus(bus);
+ *
+ * imu_bus.configure({ .clock_rate = 400.0_kHz });
+ * eeprom_bus.configure({ .clock_rate = 100.0_kHz });
+ * ```
+ */
+class shared_i2c
+{
+public:
+  /**
+   * @brief Per-driver handle to a shared i2c bus
+   *
+   */
+  class device : public hal::i2c
+  {
+  public:
+    /**
+     * @brief Create a handle to a shared i2c bus
+     *
+     * The handle starts with the default `hal::i2c::settings`.
+     *
+     * @param p_bus - shared bus. Must outlive this object.
+     */
+    explicit device(shared_i2c& p_bus)
+      : m_bus(&p_bus)
+    {
+    }
+
+    /**
+     * @brief Get this handle's bus usage counters
+     *
+     * @return shared_bus_statistics - usage counters for this handle
+     */
+    [[nodiscard]] shared_bus_statistics statistics() const
+    {
+      return m_statistics;
+    }
+
+  private:
+    void driver_configure(settings const& p_settings) override
+    {
+      m_settings = p_settings;
+    }
+
+    void driver_transaction(
+      hal::byte p_address,
+      std::span<hal::byte const> p_data_out,
+      std::span<hal::byte> p_data_in,
+      hal::function_ref<hal::timeout_function> p_timeout) override
+    {
+      detail::shared_bus_guard guard(m_bus->m_lock, this, m_statistics);
+      apply_settings();
+      m_bus->m_i2c->transaction(p_address, p_data_out, p_data_in, p_timeout);
+    }
+
+    void driver_transaction(hal::byte p_address,
+                            std::span<hal::byte const> p_data_out,
+                            std::span<hal::byte> p_data_in) override
+    {
+      detail::shared_bus_guard guard(m_bus->m_lock, this, m_statistics);
+      apply_settings();
+      m_bus->m_i2c->transaction(p_address, p_data_out, p_data_in);
+    }
+
+    void driver_transaction_scatter(
+      hal::byte p_address,
+      scatter_span<hal::byte const> p_data_out,
+      scatter_span<hal::byte> p_data_in,
+      std::span<hal::byte> p_staging) override
+    {
+      detail::shared_bus_guard guard(m_bus->m_lock, this, m_statistics);
+      apply_settings();
+      m_bus->m_i2c->transaction(p_address, p_data_out, p_data_in, p_staging);
+    }
+
+    void apply_settings()
+    {
+      if (m_bus->m_active != m_settings) {
+        m_bus->m_active.reset();
+        m_bus->m_i2c->configure(m_settings);
+        m_bus->m_active = m_settings;
+        m_statistics.reconfigurations++;
+      }
+    }
+
+    shared_i2c* m_bus;
+    settings m_settings{};
+    shared_bus_statistics m_statistics{};
+  };
+
+  /**
+   * @brief Share an i2c bus using a basic lock
+   *
+   * @param p_i2c - i2c bus to share. Must outlive this object.
+   * @param p_lock - lock guarding the bus. Must outlive this object.
+   */
+  shared_i2c(hal::i2c& p_i2c, hal::basic_lock& p_lock)
+    : m_i2c(&p_i2c)
+    , m_lock(p_lock)
+  {
+  }
+
+  /**
+   * @brief Share an i2c bus using a pollable lock, counting contention
+   *
+   * @param p_i2c - i2c bus to share. Must outlive this object.
+   * @param p_lock - lock guarding the bus. Must outlive this object.
+   */
+  shared_i2c(hal::i2c& p_i2c, hal::pollable_lock& p_lock)
+    : m_i2c(&p_i2c)
+    , m_lock(p_lock)
+  {
+  }
+
+  /**
+   * @brief Share an i2c bus using a timed lock
+   *
+   * @param p_i2c - i2c bus to share. Must outlive this object.
+   * @param p_lock - lock guarding the bus. Must outlive this object.
+   * @param p_timeout - maximum time to wait for the bus. Transactions throw
+   * `hal::timed_out` if the bus could not be acquired in time.
+   */
+  shared_i2c(hal::i2c& p_i2c,
+             hal::timed_lock& p_lock,
+             hal::time_duration p_timeout)
+    : m_i2c(&p_i2c)
+    , m_lock(p_lock, p_timeout)
+  {
+  }
+
+  shared_i2c(shared_i2c const&) = delete;
+  shared_i2c& operator=(shared_i2c const&) = delete;
+  shared_i2c(shared_i2c&&) = delete;
+  shared_i2c& operator=(shared_i2c&&) = delete;
+
+private:
+  hal::i2c* m_i2c;
+  detail::shared_bus_lock m_lock;
+  std::optional<hal::i2c::settings> m_active{};
+};
+
+/**
+ * @brief Shares one spi channel between drivers running in different threads
+ *
+ * The spi counterpart of `hal::shared_i2c`. Each `shared_spi_channel::device`
+ * handle is a `hal::spi_channel` that holds the shared lock from
+ * `chip_select(true)` until `chip_select(false)`, or for the duration of a
+ * `transfer()` made without selecting first. The underlying channel is only
+ * reconfigured when a handle with different settings acquires it.
+ */
+class shared_spi_channel
+{
+public:
+  /**
+   * @brief Per-driver handle to a shared spi channel
+   *
+   */
+  class device : public hal::spi_channel
+  {
+  public:
+    /**
+     * @brief Create a handle to a shared spi channel
+     *
+     * The handle starts with the default `hal::spi_channel::settings`.
+     *
+     * @param p_channel - shared channel. Must outlive this object.
+     */
+    explicit device(shared_spi_channel& p_channel)
+      : m_channel(&p_channel)
+    {
+    }
+
+    device(device const&) = delete;
+    device& operator=(device const&) = delete;
+
+    ~device() override
+    {
+      driver_chip_select(false);
+    }
+
+    /**
+     * @brief Get this handle's bus usage counters
+     *
+     * @return shared_bus_statistics - usage counters for this handle
+     */
+    [[nodiscard]] shared_bus_statistics statistics() const
+    {
+      return m_statistics;
+    }
+
+  private:
+    void driver_configure(settings const& p_settings) override
+    {
+      m_settings = p_settings;
+      if (m_selected) {
+        apply_settings();
+      }
+    }
+
+    u32 driver_clock_rate() override
+    {
+      if (m_selected) {
+        return m_channel->m_spi->clock_rate();
+      }
+      detail::shared_bus_guard guard(m_channel->m_lock, this, m_statistics);
+      apply_settings();
+      return m_channel->m_spi->clock_rate();
+    }
+
+    void driver_chip_select(bool p_select) override
+    {
+      if (p_select == m_selected) {
+        return;
+      }
+
+      if (p_select) {
+        m_channel->m_lock.acquire(this, m_statistics);
+        try {
+          apply_settings();
+          m_channel->m_spi->chip_select(true);
+        } catch (...) {
+          m_channel->m_lock.release();
+          throw;
+        }
+        m_selected = true;
+      } else {
+        m_channel->m_spi->chip_select(false);
+        m_channel->m_lock.release();
+        m_selected = false;
+      }
+    }
+
+    void driver_transfer(std::span<byte const> p_data_out,
+                         std::span<byte> p_data_in,
+                         byte p_filler) override
+    {
+      if (m_selected) {
+        m_channel->m_spi->transfer(p_data_out, p_data_in, p_filler);
+        return;
+      }
+      detail::shared_bus_guard guard(m_channel->m_lock, this, m_statistics);
+      apply_settings();
+      m_channel->m_spi->transfer(p_data_out, p_data_in, p_filler);
+    }
+
+    void driver_transfer_scatter(scatter_span<byte const> p_data_out,
+                                 scatter_span<byte> p_data_in,
+                                 byte p_filler) override
+    {
+      if (m_selected) {
+        m_channel->m_spi->transfer(p_data_out, p_data_in, p_filler);
+        return;
+      }
+      // Select for the whole transfer so chip select is held across segments
+      driver_chip_select(true);
+      try {
+        m_channel->m_spi->transfer(p_data_out, p_data_in, p_filler);
+      } catch (...) {
+        driver_chip_select(false);
+        throw;
+      }
+      driver_chip_select(false);
+    }
+
+    void apply_settings()
+    {
+      if (m_channel->m_active != m_settings) {
+        m_channel->m_active.reset();
+        m_channel->m_spi->configure(m_settings);
+        m_channel->m_active = m_settings;
+        m_statistics.reconfigurations++;
+      }
+    }
+
+    shared_spi_channel* m_channel;
+    settings m_settings{};
+    shared_bus_statistics m_statistics{};
+    bool m_selected = false;
+  };
+
+  /**
+   * @brief Share an spi channel using a basic lock
+   *
+   * @param p_spi - spi channel to share. Must outlive this object.
+   * @param p_lock - lock guarding the channel. Must outlive this object.
+   */
+  shared_spi_channel(hal::spi_channel& p_spi, hal::basic_lock& p_lock)
+    : m_spi(&p_spi)
+    , m_lock(p_lock)
+  {
+  }
+
+  /**
+   * @brief Share an spi channel using a pollable lock, counting contention
+   *
+   * @param p_spi - spi channel to share. Must outlive this object.
+   * @param p_lock - lock guarding the channel. Must outlive this object.
+   */
+  shared_spi_channel(hal::spi_channel& p_spi, hal::pollable_lock& p_lock)
+    : m_spi(&p_spi)
+    , m_lock(p_lock)
+  {
+  }
+
+  /**
+   * @brief Share an spi channel using a timed lock
+   *
+   * @param p_spi - spi channel to share. Must outlive this object.
+   * @param p_lock - lock guarding the channel. Must outlive this object.
+   * @param p_timeout - maximum time to wait for the channel. Selecting the
+   * channel or transferring throws `hal::timed_out` if the channel could not
+   * be acquired in time.
+   */
+  shared_spi_channel(hal::spi_channel& p_spi,
+                     hal::timed_lock& p_lock,
+                     hal::time_duration p_timeout)
+    : m_spi(&p_spi)
+    , m_lock(p_lock, p_timeout)
+  {
+  }
+
+  shared_spi_channel(shared_spi_channel const&) = delete;
+  shared_spi_channel& operator=(shared_spi_channel const&) = delete;
+  shared_spi_channel(shared_spi_channel&&) = delete;
+  shared_spi_channel& operator=(shared_spi_channel&&) = delete;
+
+private:
+  hal::spi_channel* m_spi;
+  detail::shared_bus_lock m_lock;
+  std::optional<hal::spi_channel::settings> m_active{};
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::shared_bus_statistics;
+using v5::shared_i2c;
+using v5::shared_spi_channel;
+}  // namespace hal
@@ -0,0 +1,863 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "can.hpp"
+#include "error.hpp"
+#include "functional.hpp"
+#include "i2c.hpp"
+#include "serial.hpp"
+#include "steady_clock.hpp"
+#include "timer.hpp"
+#include "units.hpp"
+#include "zero_copy_serial.hpp"
+
+/**
+ * @file simulation.hpp
+ * @brief Host simulation backend for the hal interfaces
+ *
+ * Drivers in this file implement the hal interfaces on top of a discrete event
+ * time base, `hal::sim::event_loop`, instead of hardware. Simulated time only
+ * moves when the loop runs the next event, so idle time costs nothing and
+ * firmware stacks run many simulated seconds per second of wall clock time,
+ * with repeatable timing from run to run.
+ *
+ * Bus transfers take the time the bus would take at its configured rate:
+ * messages on a `hal::sim::can_bus` are serialized and arrive at every other
+ * node once the frame has been transmitted, bytes written to a
+ * `hal::sim::serial_port` arrive at its peer after their frame time, and
+ * `hal::sim::i2c_bus` transactions advance time by their duration on the
+ * bus.
+ *
+ * Nothing in this file is global or shared between loops, so independent
+ * simulations, one event loop each, run in parallel on separate threads. The
+ * objects of one simulation must only be used from one thread.
+ */
+
+namespace hal::v5::sim {
+/**
+ * @brief Discrete event time base of a simulation
+ *
+ * Events run in order of their time, and events scheduled for the same time
+ * run in the order they were scheduled. Events may schedule and cancel other
+ * events, and may run the loop themselves to model a blocking operation.
+ */
+class event_loop
+{
+public:
+  /// Identifies a scheduled event for `cancel()`
+  using event_id = u64;
+
+  /**
+   * @brief Construct an event loop at time 0
+   *
+   * @param p_allocator - allocator for the queue of scheduled events
+   */
+  explicit event_loop(std::pmr::polymorphic_allocator<byte> p_allocator)
+    : m_events(p_allocator)
+  {
+  }
+
+  event_loop(event_loop const&) = delete;
+  event_loop& operator=(event_loop const&) = delete;
+  event_loop(event_loop&&) = delete;
+  event_loop& operator=(event_loop&&) = delete;
+  ~event_loop() = default;
+
+  /**
+   * @return time_duration - current simulated time
+   */
+  [[nodiscard]] time_duration now() const
+  {
+    return m_now;
+  }
+
+  /**
+   * @brief Schedule an event at a point in simulated time
+   *
+   * @param p_time - time to run the event at. Times in the past run the
+   * event at the current time.
+   * @param p_event - event to run
+   * @return event_id - identifier of the event
+   */
+  event_id schedule_at(time_duration p_time, hal::callback<void()> p_event)
+  {
+    auto const id = m_next_id++;
+    m_events.push_back({ .time = std::max(p_time, m_now),
+                         .id = id,
+                         .event = p_event,
+                         .cancelled = false });
+    std::ranges::push_heap(m_events, later);
+    m_pending++;
+    return id;
+  }
+
+  /**
+   * @brief Schedule an event after a delay from the current time
+   *
+   * @param p_delay - delay before the event runs
+   * @param p_event - event to run
+   * @return event_id - identifier of the event
+   */
+  event_id schedule_after(time_duration p_delay, hal::callback<void()> p_event)
+  {
+    return schedule_at(m_now + p_delay, p_event);
+  }
+
+  /**
+   * @brief Cancel a scheduled event
+   *
+   * @param p_id - identifier returned when the event was scheduled
+   * @return true - if the event was pending and will no longer run
+   */
+  bool cancel(event_id p_id)
+  {
+    for (auto& scheduled : m_events) {
+      if (scheduled.id == p_id && not scheduled.cancelled) {
+        scheduled.cancelled = true;
+        m_pending--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Run the next event, advancing time to it
+   *
+   * @return true - if an event was run, false if none is pending
+   */
+  bool step()
+  {
+    while (not m_events.empty()) {
+      std::ranges::pop_heap(m_events, later);
+      auto next = m_events.back();
+      m_events.pop_back();
+      if (next.cancelled) {
+        continue;
+      }
+      m_pending--;
+      m_now = next.time;
+      m_executed++;
+      next.event();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Run every event up to a point in time, then advance time to it
+   *
+   * @param p_end - time to stop at
+   * @return usize - number of events run
+   */
+  usize run_until(time_duration p_end)
+  {
+    usize count = 0;
+    while (not m_events.empty()) {
+      if (m_events.front().cancelled) {
+        std::ranges::pop_heap(m_events, later);
+        m_events.pop_back();
+        continue;
+      }
+      if (m_events.front().time > p_end) {
+        break;
+      }
+      step();
+      count++;
+    }
+    // A nested run of the loop may already have passed p_end
+    m_now = std::max(m_now, p_end);
+    return count;
+  }
+
+  /**
+   * @brief Run every event within a duration from now, then advance time by it
+   *
+   * @param p_duration - simulated time to run for
+   * @return usize - number of events run
+   */
+  usize run_for(time_duration p_duration)
+  {
+    return run_until(m_now + p_duration);
+  }
+
+  /**
+   * @return usize - number of events scheduled and not yet run or cancelled
+   */
+  [[nodiscard]] usize pending() const
+  {
+    return m_pending;
+  }
+
+  /**
+   * @return u64 - number of events run since construction
+   */
+  [[nodiscard]] u64 executed() const
+  {
+    return m_executed;
+  }
+
+private:
+  struct scheduled_event
+  {
+    time_duration time;
+    event_id id;
+    hal::callback<void()> event;
+    bool cancelled;
+  };
+
+  static constexpr auto later = [](scheduled_event const& p_left,
+                                   scheduled_event const& p_right) {
+    if (p_left.time != p_right.time) {
+      return p_left.time > p_right.time;
+    }
+    return p_left.id > p_right.id;
+  };
+
+  std::pmr::vector<scheduled_event> m_events;
+  time_duration m_now{ 0 };
+  event_id m_next_id = 0;
+  usize m_pending = 0;
+  u64 m_executed = 0;
+};
+
+/**
+ * @brief steady_clock counting nanoseconds of simulated time
+ *
+ */
+class steady_clock : public hal::steady_clock
+{
+public:
+  /**
+   * @param p_loop - time base of the clock. Must outlive this object.
+   */
+  explicit steady_clock(event_loop& p_loop)
+    : m_loop(&p_loop)
+  {
+  }
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1'000'000'000.0f;
+  }
+
+  u64 driver_uptime() override
+  {
+    return static_cast<u64>(m_loop->now().count());
+  }
+
+  event_loop* m_loop;
+};
+
+/**
+ * @brief timer running its callback as an event of the simulation
+ *
+ */
+class timer : public hal::timer
+{
+public:
+  /**
+   * @param p_loop - time base of the timer. Must outlive this object.
+   */
+  explicit timer(event_loop& p_loop)
+    : m_loop(&p_loop)
+  {
+  }
+
+  timer(timer const&) = delete;
+  timer& operator=(timer const&) = delete;
+  timer(timer&&) = delete;
+  timer& operator=(timer&&) = delete;
+  ~timer() override
+  {
+    driver_cancel();
+  }
+
+private:
+  bool driver_is_running() override
+  {
+    return m_event.has_value();
+  }
+
+  void driver_cancel() override
+  {
+    if (m_event) {
+      m_loop->cancel(*m_event);
+      m_event.reset();
+    }
+  }
+
+  void driver_schedule(hal::callback<void(void)> p_callback,
+                       hal::time_duration p_delay) override
+  {
+    driver_cancel();
+    m_callback = p_callback;
+    m_event = m_loop->schedule_after(p_delay, [this]() {
+      m_event.reset();
+      // The callback may schedule the timer again, replacing m_callback
+      auto callback = m_callback;
+      callback();
+    });
+  }
+
+  event_loop* m_loop;
+  hal::callback<void(void)> m_callback{};
+  std::optional<event_loop::event_id> m_event{};
+};
+
+class can_node;
+
+/**
+ * @brief CAN bus connecting `hal::sim::can_node`s
+ *
+ * Messages are transmitted one at a time, in the order they were sent. Each
+ * message occupies the bus for the duration of its frame at the bus's baud
+ * rate, without bit stuffing, and is delivered to every other node on the bus
+ * when its frame ends. Messages in flight when the bus is destroyed are
+ * dropped.
+ */
+class can_bus
+{
+public:
+  /**
+   * @param p_loop - time base of the bus. Must outlive this object.
+   * @param p_allocator - allocator for the list of nodes and the messages in
+   * flight
+   * @param p_baud_rate - bit rate of the bus
+   */
+  can_bus(event_loop& p_loop,
+          std::pmr::polymorphic_allocator<byte> p_allocator,
+          u32 p_baud_rate)
+    : m_loop(&p_loop)
+    , m_nodes(p_allocator)
+    , m_in_flight(p_allocator)
+    , m_baud_rate(p_baud_rate)
+  {
+    if (p_baud_rate == 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+  }
+
+  can_bus(can_bus const&) = delete;
+  can_bus& operator=(can_bus const&) = delete;
+  can_bus(can_bus&&) = delete;
+  can_bus& operator=(can_bus&&) = delete;
+  ~can_bus()
+  {
+    // Frames in flight must not be delivered to a destroyed bus
+    for (auto const& in_flight : m_in_flight) {
+      m_loop->cancel(in_flight.event);
+    }
+  }
+
+  /**
+   * @return u32 - bit rate of the bus
+   */
+  [[nodiscard]] u32 baud_rate() const
+  {
+    return m_baud_rate;
+  }
+
+  /**
+   * @brief Get the number of bits of a frame on the bus
+   *
+   * @param p_message - message to measure
+   * @return u32 - frame bits including the interframe space, without bit
+   * stuffing
+   */
+  [[nodiscard]] static constexpr u32 frame_bits(can_message const& p_message)
+  {
+    // SOF, arbitration, control, CRC, ACK, EOF and interframe space
+    u32 const overhead = p_message.extended ? 67 : 47;
+    u32 const data = p_message.remote_request ? 0 : p_message.length;
+    return overhead + 8 * std::min<u32>(data, 8);
+  }
+
+  /**
+   * @return u64 - number of messages delivered since construction
+   */
+  [[nodiscard]] u64 frames() const
+  {
+    return m_frames;
+  }
+
+  /**
+   * @return time_duration - total time the bus spent transmitting frames, for
+   * computing bus load
+   */
+  [[nodiscard]] time_duration busy_time() const
+  {
+    return m_busy_time;
+  }
+
+private:
+  friend class can_node;
+
+  void transmit(can_node* p_sender, can_message const& p_message)
+  {
+    auto const duration = std::chrono::duration_cast<time_duration>(
+      std::chrono::duration<double>(static_cast<double>(frame_bits(p_message)) /
+                                    m_baud_rate));
+    auto const start = std::max(m_loop->now(), m_free_at);
+    m_free_at = start + duration;
+    m_busy_time += duration;
+    auto const event = m_loop->schedule_at(m_free_at, [this]() { deliver(); });
+    m_in_flight.push_back(
+      { .sender = p_sender, .message = p_message, .event = event });
+  }
+
+  void deliver();
+
+  struct frame
+  {
+    can_node* sender;
+    can_message message;
+    event_loop::event_id event;
+  };
+
+  event_loop* m_loop;
+  std::pmr::vector<can_node*> m_nodes;
+  std::pmr::deque<frame> m_in_flight;
+  time_duration m_free_at{ 0 };
+  time_duration m_busy_time{ 0 };
+  u64 m_frames = 0;
+  u32 m_baud_rate;
+};
+
+/**
+ * @brief Node on a `hal::sim::can_bus`
+ *
+ * Received messages are written to a circular receive buffer and passed to
+ * the receive handler, if one is set. Messages are received without
+ * filtering.
+ */
+class can_node
+  : public hal::can_transceiver
+  , public hal::can_interrupt
+{
+public:
+  /**
+   * @brief Connect a node to a bus
+   *
+   * @param p_bus - bus to connect to. Must outlive this object.
+   * @param p_allocator - allocator for the receive buffer
+   * @param p_receive_capacity - number of messages in the receive buffer
+   * @throws hal::argument_out_of_domain - if p_receive_capacity is 0
+   */
+  can_node(can_bus& p_bus,
+           std::pmr::polymorphic_allocator<byte> p_allocator,
+           usize p_receive_capacity)
+    : m_bus(&p_bus)
+    , m_receive(p_receive_capacity, p_allocator)
+  {
+    if (p_receive_capacity == 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_bus->m_nodes.push_back(this);
+  }
+
+  can_node(can_node const&) = delete;
+  can_node& operator=(can_node const&) = delete;
+  can_node(can_node&&) = delete;
+  can_node& operator=(can_node&&) = delete;
+  ~can_node() override
+  {
+    std::erase(m_bus->m_nodes, this);
+    for (auto& in_flight : m_bus->m_in_flight) {
+      if (in_flight.sender == this) {
+        in_flight.sender = nullptr;
+      }
+    }
+  }
+
+  /**
+   * @return u64 - number of messages received since construction
+   */
+  [[nodiscard]] u64 received() const
+  {
+    return m_received;
+  }
+
+private:
+  friend class can_bus;
+
+  void receive(can_message const& p_message)
+  {
+    m_receive[m_cursor] = p_message;
+    m_cursor = (m_cursor + 1) % m_receive.size();
+    m_received++;
+    if (m_handler) {
+      (*m_handler)(on_receive_tag{}, p_message);
+    }
+  }
+
+  u32 driver_baud_rate() override
+  {
+    return m_bus->baud_rate();
+  }
+
+  void driver_send(can_message const& p_message) override
+  {
+    m_bus->transmit(this, p_message);
+  }
+
+  std::span<can_message const> driver_receive_buffer() override
+  {
+    return m_receive;
+  }
+
+  std::size_t driver_receive_cursor() override
+  {
+    return m_cursor;
+  }
+
+  void driver_on_receive(optional_receive_handler p_callback) override
+  {
+    m_handler = p_callback;
+  }
+
+  can_bus* m_bus;
+  std::pmr::vector<can_message> m_receive;
+  optional_receive_handler m_handler{};
+  usize m_cursor = 0;
+  u64 m_received = 0;
+};
+
+inline void can_bus::deliver()
+{
+  auto const delivered = m_in_flight.front();
+  m_in_flight.pop_front();
+  m_frames++;
+  // Handlers may connect nodes, which can reallocate the list of nodes
+  for (usize i = 0; i < m_nodes.size(); i++) {
+    if (m_nodes[i] != delivered.sender) {
+      m_nodes[i]->receive(delivered.message);
+    }
+  }
+}
+
+/**
+ * @brief Serial port connected to a peer port, or to itself for loopback
+ *
+ * Bytes written to the port arrive in the receive buffer of its peer once
+ * their frames have been transmitted at the configured baud rate. Writes are
+ * transmitted one after the other and never block: written bytes are copied
+ * and `write()` returns immediately, and `write_async()` completes when the
+ * last byte has been transmitted. Bytes arriving while the port is not
+ * connected are dropped, as are the writes in flight when the port is
+ * destroyed.
+ */
+class serial_port : public hal::zero_copy_serial
+{
+public:
+  /**
+   * @brief Construct an unconnected serial port
+   *
+   * @param p_loop - time base of the port. Must outlive this object.
+   * @param p_allocator - allocator for the receive buffer and the bytes in
+   * flight
+   * @param p_receive_capacity - size of the circular receive buffer
+   * @throws hal::argument_out_of_domain - if p_receive_capacity is 0
+   */
+  serial_port(event_loop& p_loop,
+              std::pmr::polymorphic_allocator<byte> p_allocator,
+              usize p_receive_capacity)
+    : m_loop(&p_loop)
+    , m_receive(p_receive_capacity, p_allocator)
+    , m_transmit(p_allocator)
+    , m_writes(p_allocator)
+  {
+    if (p_receive_capacity == 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+  }
+
+  serial_port(serial_port const&) = delete;
+  serial_port& operator=(serial_port const&) = delete;
+  serial_port(serial_port&&) = delete;
+  serial_port& operator=(serial_port&&) = delete;
+  ~serial_port() override
+  {
+    // Writes in flight must not complete on a destroyed port
+    for (auto const& write : m_writes) {
+      m_loop->cancel(write.event);
+    }
+    disconnect();
+  }
+
+  /**
+   * @brief Connect this port to a peer port, in both directions
+   *
+   * Any previous connection of either port is removed.
+   *
+   * @param p_peer - port to connect to. Pass this port for loopback.
+   */
+  void connect(serial_port& p_peer)
+  {
+    disconnect();
+    p_peer.disconnect();
+    m_peer = &p_peer;
+    p_peer.m_peer = this;
+  }
+
+  /**
+   * @brief Remove the connection to the peer port
+   *
+   */
+  void disconnect()
+  {
+    if (m_peer != nullptr) {
+      m_peer->m_peer = nullptr;
+      m_peer = nullptr;
+    }
+  }
+
+  /**
+   * @return time_duration - time to transmit one byte at the current settings
+   */
+  [[nodiscard]] time_duration byte_time() const
+  {
+    using parity_t = decltype(m_settings.parity);
+    using stop_bits_t = decltype(m_settings.stop);
+    auto const bits = 1 + 8 + (m_settings.parity != parity_t::none ? 1 : 0) +
+                      (m_settings.stop == stop_bits_t::two ? 2 : 1);
+    return std::chrono::duration_cast<time_duration>(
+      std::chrono::duration<double>(bits / double{ m_settings.baud_rate }));
+  }
+
+private:
+  struct pending_write
+  {
+    usize size;
+    hal::callback<void()> on_complete;
+    event_loop::event_id event;
+  };
+
+  void driver_configure(hal::serial::settings const& p_settings) override
+  {
+    if (p_settings.baud_rate <= 0.0f) {
+      hal::safe_throw(hal::operation_not_supported(this));
+    }
+    m_settings = p_settings;
+  }
+
+  void driver_write(std::span<hal::byte const> p_data) override
+  {
+    driver_write_async(p_data, []() {});
+  }
+
+  void driver_write_async(std::span<hal::byte const> p_data,
+                          hal::callback<void()> p_on_complete) override
+  {
+    auto const start = std::max(m_loop->now(), m_free_at);
+    m_free_at = start + byte_time() * static_cast<i64>(p_data.size());
+    auto const event =
+      m_loop->schedule_at(m_free_at, [this]() { complete_write(); });
+    m_transmit.insert(m_transmit.end(), p_data.begin(), p_data.end());
+    m_writes.push_back(
+      { .size = p_data.size(), .on_complete = p_on_complete, .event = event });
+  }
+
+  usize driver_write_in_flight() override
+  {
+    return m_transmit.size();
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return m_receive;
+  }
+
+  std::size_t driver_cursor() override
+  {
+    return m_cursor;
+  }
+
+  std::optional<usize> driver_receive_count() override
+  {
+    return m_received;
+  }
+
+  void complete_write()
+  {
+    auto const completed = m_writes.front();
+    m_writes.pop_front();
+    auto const end = m_transmit.begin() + static_cast<i64>(completed.size);
+    if (m_peer != nullptr) {
+      for (auto data = m_transmit.begin(); data != end; data++) {
+        m_peer->receive(*data);
+      }
+    }
+    m_transmit.erase(m_transmit.begin(), end);
+    completed.on_complete();
+  }
+
+  void receive(byte p_data)
+  {
+    m_receive[m_cursor] = p_data;
+    m_cursor = (m_cursor + 1) % m_receive.size();
+    m_received++;
+  }
+
+  event_loop* m_loop;
+  serial_port* m_peer = nullptr;
+  std::pmr::vector<byte> m_receive;
+  std::pmr::deque<byte> m_transmit;
+  std::pmr::deque<pending_write> m_writes;
+  hal::serial::settings m_settings{};
+  time_duration m_free_at{ 0 };
+  usize m_cursor = 0;
+  usize m_received = 0;
+};
+
+/**
+ * @brief Model of a device on a `hal::sim::i2c_bus`
+ *
+ */
+struct i2c_device
+{
+  /**
+   * @brief Respond to a transaction addressed to this device
+   *
+   * @param p_data_out - bytes written to the device
+   * @param p_data_in - bytes to fill with the device's response
+   */
+  virtual void transaction(std::span<hal::byte const> p_data_out,
+                           std::span<hal::byte> p_data_in) = 0;
+
+  virtual ~i2c_device() = default;
+};
+
+/**
+ * @brief I2C bus of simulated devices
+ *
+ * Transactions block, running the simulation for the time the transaction
+ * would take on the bus at the configured clock rate, 9 clocks per byte plus
+ * the start and stop conditions, so that other simulated activity progresses
+ * while the caller waits. Transactions to an address without a device throw
+ * `hal::no_such_device`, as a real bus does when the address is not
+ * acknowledged.
+ */
+class i2c_bus : public hal::i2c
+{
+public:
+  /**
+   * @param p_loop - time base of the bus. Must outlive this object.
+   */
+  explicit i2c_bus(event_loop& p_loop)
+    : m_loop(&p_loop)
+  {
+  }
+
+  /**
+   * @brief Add a device to the bus
+   *
+   * @param p_address - address of the device
+   * @param p_device - device model. Must outlive its presence on the bus.
+   * @throws hal::device_or_resource_busy - if a device already has p_address
+   */
+  void attach(hal::byte p_address, i2c_device& p_device)
+  {
+    if (m_devices[p_address] != nullptr) {
+      hal::safe_throw(hal::device_or_resource_busy(this));
+    }
+    m_devices[p_address] = &p_device;
+  }
+
+  /**
+   * @brief Remove the device at an address from the bus
+   *
+   * @param p_address - address of the device to remove
+   */
+  void detach(hal::byte p_address)
+  {
+    m_devices[p_address] = nullptr;
+  }
+
+  /**
+   * @return u64 - number of transactions performed since construction
+   */
+  [[nodiscard]] u64 transactions() const
+  {
+    return m_transactions;
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    if (p_settings.clock_rate <= 0.0f) {
+      hal::safe_throw(hal::operation_not_supported(this));
+    }
+    m_clock_rate = p_settings.clock_rate;
+  }
+
+  void driver_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in,
+    hal::function_ref<hal::timeout_function>) override
+  {
+    if (p_data_out.empty() && p_data_in.empty()) {
+      return;
+    }
+
+    // Start, stop and 9 clocks for the address and each byte, with a repeated
+    // start and second address for a write then read
+    auto const phases =
+      (p_data_out.empty() ? 0 : 1) + (p_data_in.empty() ? 0 : 1);
+    auto const bits = 2 + 9 * (phases + p_data_out.size() + p_data_in.size());
+    auto const duration = std::chrono::duration_cast<time_duration>(
+      std::chrono::duration<double>(static_cast<double>(bits) / m_clock_rate));
+
+    auto* const device = m_devices[p_address];
+    if (device == nullptr) {
+      // The address is not acknowledged after its 9 clocks
+      m_loop->run_for(std::chrono::duration_cast<time_duration>(
+        std::chrono::duration<double>(11.0 / m_clock_rate)));
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+    m_transactions++;
+    device->transaction(p_data_out, p_data_in);
+    m_loop->run_for(duration);
+  }
+
+  event_loop* m_loop;
+  std::array<i2c_device*, 256> m_devices{};
+  hertz m_clock_rate = 100'000.0f;
+  u64 m_transactions = 0;
+};
+}  // namespace hal::v5::sim
+
+namespace hal::sim {
+using v5::sim::can_bus;
+using v5::sim::can_node;
+using v5::sim::event_loop;
+using v5::sim::i2c_bus;
+using v5::sim::i2c_device;
+using v5::sim::serial_port;
+using v5::sim::steady_clock;
+using v5::sim::timer;
+}  // namespace hal::sim
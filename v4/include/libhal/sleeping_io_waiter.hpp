@@ -0,0 +1,179 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+
+#include "functional.hpp"
+#include "io_waiter.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Counters for a sleeping_io_waiter
+ *
+ * Tick counts are in ticks of the steady clock given to the waiter and are 0
+ * if no clock was given.
+ */
+struct sleeping_io_waiter_statistics
+{
+  /// Calls to `wait()`
+  u32 waits = 0;
+  /// Calls to `wait()` that returned without sleeping because `resume()` had
+  /// already been called
+  u32 early_resumes = 0;
+  /// Calls to `resume()`
+  u32 resumes = 0;
+  /// Total ticks spent within `wait()`
+  u64 wait_ticks = 0;
+  /// Total ticks from a call to `resume()` to the return of the sleeping
+  /// `wait()` it woke
+  u64 resume_latency_ticks = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(sleeping_io_waiter_statistics const&) const =
+    default;
+};
+
+/**
+ * @brief io_waiter that sleeps the core until an interrupt resumes it
+ *
+ * Drivers waiting on I/O call `wait()` in a loop until their ready flag is
+ * set. With `polling_io_waiter()` that loop spins at full power. This waiter
+ * instead calls a platform supplied sleep function, such as the `wfe`
+ * instruction on ARM Cortex-M, so the core stops until the interrupt that
+ * completes the I/O calls `resume()`.
+ *
+ * If `resume()` is called before `wait()`, for example because the transfer
+ * completed before the driver started waiting, the next `wait()` returns
+ * without sleeping. The sleep function must return if any interrupt occurs
+ * after it is called, even one that fired just before the core went to sleep.
+ * `wfe` does this by design, as the interrupt sets the event register. With
+ * `wfi`, interrupts must be masked while checking and sleeping, which the
+ * sleep function cannot do, so prefer `wfe`.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::sleeping_io_waiter waiter([]() { asm volatile("wfe"); }, &clock);
+ * my_dma_spi spi(waiter);
+ * ```
+ */
+class sleeping_io_waiter : public io_waiter
+{
+public:
+  /// Signature of the platform's sleep function
+  using sleep_function = hal::callback<void()>;
+
+  /**
+   * @brief Construct a waiter
+   *
+   * @param p_sleep - function that sleeps the core until the next interrupt or
+   * event
+   * @param p_clock - steady clock to measure wait time and resume latency
+   * with, or nullptr to skip measurements. Must outlive this object and be
+   * safe to read from interrupt context.
+   */
+  explicit sleeping_io_waiter(sleep_function p_sleep,
+                              hal::steady_clock* p_clock = nullptr)
+    : m_sleep(p_sleep)
+    , m_clock(p_clock)
+  {
+  }
+
+  sleeping_io_waiter(sleeping_io_waiter const&) = delete;
+  sleeping_io_waiter& operator=(sleeping_io_waiter const&) = delete;
+  sleeping_io_waiter(sleeping_io_waiter&&) = delete;
+  sleeping_io_waiter& operator=(sleeping_io_waiter&&) = delete;
+  ~sleeping_io_waiter() override = default;
+
+  /**
+   * @brief Get the counters of the waiter
+   *
+   * @return sleeping_io_waiter_statistics - counters since construction or
+   * the last call to `reset_statistics()`
+   */
+  [[nodiscard]] sleeping_io_waiter_statistics statistics() const
+  {
+    auto result = m_statistics;
+    result.resumes = m_resumes.load(std::memory_order_relaxed);
+    return result;
+  }
+
+  /**
+   * @brief Clear the counters
+   *
+   */
+  void reset_statistics()
+  {
+    m_statistics = {};
+    m_resumes.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  void driver_wait() override
+  {
+    m_statistics.waits++;
+    auto const start = uptime();
+
+    bool woken = false;
+    if (m_resumed.exchange(false, std::memory_order_acquire)) {
+      m_statistics.early_resumes++;
+    } else {
+      m_sleep();
+      // The core may also wake for interrupts unrelated to this waiter
+      woken = m_resumed.exchange(false, std::memory_order_acquire);
+    }
+
+    auto const end = uptime();
+    m_statistics.wait_ticks += end - start;
+    if (woken) {
+      // Differences of the low 32 bits avoid 64-bit atomics, which are not
+      // lock free on 32-bit cores
+      auto const resumed_at = m_resumed_at.load(std::memory_order_relaxed);
+      m_statistics.resume_latency_ticks +=
+        static_cast<u32>(static_cast<u32>(end) - resumed_at);
+    }
+  }
+
+  void driver_resume() noexcept override
+  {
+    m_resumed_at.store(static_cast<u32>(uptime()), std::memory_order_relaxed);
+    m_resumes.fetch_add(1, std::memory_order_relaxed);
+    m_resumed.store(true, std::memory_order_release);
+  }
+
+  [[nodiscard]] u64 uptime() const noexcept
+  {
+    return m_clock != nullptr ? m_clock->uptime() : 0;
+  }
+
+  sleep_function m_sleep;
+  hal::steady_clock* m_clock;
+  sleeping_io_waiter_statistics m_statistics{};
+  std::atomic<u32> m_resumes = 0;
+  std::atomic<u32> m_resumed_at = 0;
+  std::atomic<bool> m_resumed = false;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::sleeping_io_waiter;
+using v5::sleeping_io_waiter_statistics;
+}  // namespace hal
@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <span>
 
+#include "error.hpp"
+#include "scatter_span.hpp"
 #include "units.hpp"
 
 namespace hal {
@@ -281,7 +284,8 @@ public:
    */
   void chip_select(bool p_select)
   {
-    return driver_chip_select(p_select);
+    driver_chip_select(p_select);
+    m_selected = p_select;
   }
 
   /**
@@ -326,6 +330,68 @@ public:
     return driver_transfer(p_data_out, p_data_in, p_filler);
   }
 
+  /**
+   * @brief Full duplex transfer of multiple segments with one chip select
+   *
+   * Performs the same transfer as `transfer()` on the concatenation of every
+   * segment of p_data_out and every segment of p_data_in: byte N of the
+   * combined output is written while byte N of the combined input is read.
+   * Chip select stays asserted across all of the segments, so a command and a
+   * payload, or a command followed by a data phase, in separate buffers need
+   * neither a staging copy nor CPU intervention between them. Drivers with DMA
+   * can build a single descriptor chain from the segments.
+   *
+   * If `chip_select(true)` was called before this API, the channel remains
+   * selected afterward. Otherwise the channel acquires the bus and asserts
+   * chip select for the duration of the transfer, as `transfer()` does.
+   *
+   * The default implementation, for drivers that do not override it, performs
+   * one `transfer()` call per piece of the transfer where the segment
+   * boundaries line up. If the channel was not selected, it calls
+   * `chip_select(true)` before the first piece and `chip_select(false)` after
+   * the last, so chip select is held across every piece.
+   *
+   * @param p_data_out - segments of data to write to the bus, in order. Once
+   * exhausted, p_filler is written for the remaining bytes read.
+   * @param p_data_in - segments to fill with data read off of the bus, in
+   * order. Once filled, the rest of the received bytes are dropped.
+   * @param p_filler - filler data placed on the bus in place of actual write
+   * data when p_data_out has been exhausted.
+   */
+  void transfer(scatter_span<byte const> p_data_out,
+                scatter_span<byte> p_data_in,
+                byte p_filler = default_filler)
+  {
+    return driver_transfer_scatter(p_data_out, p_data_in, p_filler);
+  }
+
+  /**
+   * @brief Full duplex transfer, returning errors instead of throwing
+   *
+   * Performs the same transfer as `transfer(std::span<byte const>,
+   * std::span<byte>, byte)`. Use this in polling loops where a failure, such
+   * as a bus that is busy or a DMA transfer that timed out, is an expected
+   * outcome, so each failed attempt does not throw and unwind.
+   *
+   * Drivers that override this API report errors without throwing. Otherwise,
+   * the default implementation calls `transfer()` and catches the exception,
+   * which is no faster than catching it yourself.
+   *
+   * @param p_data_out - data to write to the bus. Once exhausted, p_filler is
+   * written for the remaining bytes read.
+   * @param p_data_in - buffer to fill with data read off of the bus.
+   * @param p_filler - filler data placed on the bus in place of actual write
+   * data when p_data_out has been exhausted.
+   * @return std::errc - `std::errc{}` on success, otherwise the error code of
+   * the hal::exception the transfer raised.
+   */
+  [[nodiscard]] std::errc try_transfer(std::span<byte const> p_data_out,
+                                       std::span<byte> p_data_in = {},
+                                       byte p_filler = default_filler)
+  {
+    return driver_try_transfer(p_data_out, p_data_in, p_filler);
+  }
+
   /**
    * @brief API to satisfy the `lock()` API of C++'s BasicLockable trait.
    *
@@ -355,6 +421,67 @@ private:
   virtual void driver_transfer(std::span<byte const> p_data_out,
                                std::span<byte> p_data_in,
                                byte p_filler) = 0;
+  virtual std::errc driver_try_transfer(std::span<byte const> p_data_out,
+                                        std::span<byte> p_data_in,
+                                        byte p_filler)
+  {
+    return hal::catch_error_code(
+      [&]() { transfer(p_data_out, p_data_in, p_filler); });
+  }
+
+  virtual void driver_transfer_scatter(scatter_span<byte const> p_data_out,
+                                       scatter_span<byte> p_data_in,
+                                       byte p_filler)
+  {
+    if (m_selected) {
+      transfer_pieces(p_data_out, p_data_in, p_filler);
+      return;
+    }
+    // Select for the whole transfer so chip select is held across pieces
+    chip_select(true);
+    try {
+      transfer_pieces(p_data_out, p_data_in, p_filler);
+    } catch (...) {
+      chip_select(false);
+      throw;
+    }
+    chip_select(false);
+  }
+
+  void transfer_pieces(scatter_span<byte const> p_data_out,
+                       scatter_span<byte> p_data_in,
+                       byte p_filler)
+  {
+    auto out_segment = p_data_out.begin();
+    auto in_segment = p_data_in.begin();
+    std::span<byte const> out{};
+    std::span<byte> in{};
+
+    while (true) {
+      while (out.empty() && out_segment != p_data_out.end()) {
+        out = *out_segment++;
+      }
+      while (in.empty() && in_segment != p_data_in.end()) {
+        in = *in_segment++;
+      }
+      if (out.empty() && in.empty()) {
+        return;
+      }
+
+      auto length = std::max(out.size(), in.size());
+      if (not out.empty() && not in.empty()) {
+        length = std::min(out.size(), in.size());
+      }
+      auto const out_length = std::min(length, out.size());
+      auto const in_length = std::min(length, in.size());
+
+      driver_transfer(out.first(out_length), in.first(in_length), p_filler);
+      out = out.subspan(out_length);
+      in = in.subspan(in_length);
+    }
+  }
+
+  bool m_selected = false;
 };
 
 /**
@@ -0,0 +1,273 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "scatter_span.hpp"
+#include "spi.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief A single chip select frame within a batch of spi transactions
+ *
+ */
+struct spi_transaction
+{
+  /// Device to communicate with. Must not be null.
+  hal::spi_channel* channel = nullptr;
+  /// Settings the device requires for this transaction
+  hal::spi_channel::settings settings{};
+  /// Segments to write to the device, see `hal::spi_channel::transfer()`
+  scatter_span<hal::byte const> data_out{};
+  /// Segments to fill with data read from the device
+  scatter_span<hal::byte> data_in{};
+  /// Byte written once every segment of `data_out` has been exhausted
+  hal::byte filler = hal::spi_channel::default_filler;
+  /// Keep chip select asserted after this transaction, so the next transaction
+  /// continues the same frame. Ignored if the next transaction targets a
+  /// different channel or requires different settings, or at the end of the
+  /// batch.
+  bool hold_chip_select = false;
+};
+
+/**
+ * @brief Bus usage report for a batch of spi transactions
+ *
+ */
+struct spi_batch_report
+{
+  /// Number of transactions performed
+  usize transactions = 0;
+  /// Number of times a channel had to be reconfigured
+  usize reconfigurations = 0;
+  /// Number of times a chip select was asserted
+  usize chip_selects = 0;
+  /// Number of bytes clocked across the bus
+  u64 bytes = 0;
+  /// Estimated time spent clocking data, based on each channel's clock rate
+  hal::time_duration busy{};
+  /// Measured time to run the whole batch
+  hal::time_duration elapsed{};
+
+  /**
+   * @brief Fraction of the batch's runtime spent clocking data
+   *
+   * Everything else is spent selecting, configuring and software overhead.
+   *
+   * @return float - bus utilization from 0.0 to 1.0
+   */
+  [[nodiscard]] float utilization() const
+  {
+    if (elapsed.count() <= 0) {
+      return 0.0f;
+    }
+    auto const ratio = static_cast<float>(busy.count()) /
+                       static_cast<float>(elapsed.count());
+    return std::min(ratio, 1.0f);
+  }
+};
+
+/**
+ * @brief Runs batches of transactions across devices sharing an spi bus
+ *
+ * Drivers usually call `hal::spi_channel::configure()` before every transfer
+ * in case another driver changed the settings. When a set of transactions is
+ * run through a batch, the settings last passed to each channel are cached and
+ * `configure()` is only called when a transaction's settings differ from
+ * them. Transactions to the same channel can be chained under a single chip
+ * select with `hold_chip_select`.
+ *
+ * The cache assumes that the batch is the only code configuring its channels.
+ * If a channel is configured elsewhere, call `invalidate()`.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::spi_batch<3> batch(clock);
+ * std::array<hal::spi_transaction, 2> const refresh{ {
+ *   { .channel = &imu, .settings = imu_settings, .data_out = imu_read,
+ *     .data_in = imu_data },
+ *   { .channel = &display, .settings = display_settings,
+ *     .data_out = framebuffer },
+ * } };
+ * auto const report = batch.run(refresh);
+ * ```
+ *
+ * @tparam Devices - number of channels whose settings are cached. If more
+ * channels are used, the least recently added ones are evicted.
+ */
+template<usize Devices>
+class spi_batch
+{
+public:
+  static_assert(Devices > 0, "spi_batch must cache at least one device");
+
+  /**
+   * @brief Construct a batch runner
+   *
+   * @param p_clock - clock used to measure the runtime of each batch. Must
+   * outlive this object.
+   */
+  explicit spi_batch(hal::steady_clock& p_clock)
+    : m_clock(&p_clock)
+  {
+  }
+
+  /**
+   * @brief Perform a batch of transactions in order
+   *
+   * Chip select is always released when this function returns or throws.
+   *
+   * @param p_transactions - transactions to perform
+   * @return spi_batch_report - bus usage for this batch
+   * @throws hal::operation_not_supported - if a channel cannot accommodate a
+   * transaction's settings.
+   */
+  spi_batch_report run(std::span<spi_transaction const> p_transactions)
+  {
+    spi_batch_report report{};
+    hal::spi_channel* selected = nullptr;
+    auto const start = m_clock->uptime();
+
+    try {
+      for (auto const& transaction : p_transactions) {
+        auto* const channel = transaction.channel;
+        auto* entry = find(channel);
+        bool const matches =
+          entry != nullptr && entry->settings == transaction.settings;
+
+        if (selected != nullptr && (selected != channel || not matches)) {
+          selected->chip_select(false);
+          selected = nullptr;
+        }
+
+        if (not matches) {
+          channel->configure(transaction.settings);
+          entry = &store(channel, transaction.settings);
+          report.reconfigurations++;
+        }
+
+        if (selected == nullptr) {
+          channel->chip_select(true);
+          selected = channel;
+          report.chip_selects++;
+        }
+
+        channel->transfer(
+          transaction.data_out, transaction.data_in, transaction.filler);
+
+        auto const bytes = std::max(total_size(transaction.data_out),
+                                    total_size(transaction.data_in));
+        report.bytes += bytes;
+        if (entry->clock_rate != 0) {
+          report.busy +=
+            hal::time_duration(bytes * 8'000'000'000ULL / entry->clock_rate);
+        }
+        report.transactions++;
+
+        if (not transaction.hold_chip_select) {
+          channel->chip_select(false);
+          selected = nullptr;
+        }
+      }
+    } catch (...) {
+      if (selected != nullptr) {
+        selected->chip_select(false);
+      }
+      throw;
+    }
+
+    if (selected != nullptr) {
+      selected->chip_select(false);
+    }
+
+    auto const ticks = m_clock->uptime() - start;
+    auto const nanoseconds_per_tick = 1e9f / m_clock->frequency();
+    report.elapsed = hal::time_duration(
+      static_cast<i64>(static_cast<float>(ticks) * nanoseconds_per_tick));
+
+    return report;
+  }
+
+  /**
+   * @brief Forget the cached settings of every channel
+   *
+   * The next transaction to each channel will configure it.
+   */
+  void invalidate()
+  {
+    m_cache = {};
+    m_next = 0;
+  }
+
+private:
+  struct cache_entry
+  {
+    hal::spi_channel* channel = nullptr;
+    hal::spi_channel::settings settings{};
+    u32 clock_rate = 0;
+  };
+
+  static u64 total_size(auto p_segments)
+  {
+    u64 size = 0;
+    for (auto const& segment : p_segments) {
+      size += segment.size();
+    }
+    return size;
+  }
+
+  cache_entry* find(hal::spi_channel* p_channel)
+  {
+    for (auto& entry : m_cache) {
+      if (entry.channel == p_channel) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  cache_entry& store(hal::spi_channel* p_channel,
+                     hal::spi_channel::settings const& p_settings)
+  {
+    auto* entry = find(p_channel);
+    if (entry == nullptr) {
+      entry = &m_cache[m_next];
+      m_next = (m_next + 1) % Devices;
+    }
+    *entry = {
+      .channel = p_channel,
+      .settings = p_settings,
+      .clock_rate = p_channel->clock_rate(),
+    };
+    return *entry;
+  }
+
+  std::array<cache_entry, Devices> m_cache{};
+  usize m_next = 0;
+  hal::steady_clock* m_clock;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::spi_batch;
+using v5::spi_batch_report;
+using v5::spi_transaction;
+}  // namespace hal
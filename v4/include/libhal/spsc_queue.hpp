@@ -0,0 +1,355 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Size of a cache line in bytes on common multicore hosts
+ *
+ * Used as the default alignment for data that is written by one core and read
+ * by another, in order to keep each core's writes on their own cache line and
+ * avoid false sharing.
+ */
+inline constexpr usize cache_line_size = 64;
+
+/**
+ * @brief A wait-free single producer, single consumer queue
+ *
+ * spsc_queue<T> is a bounded FIFO queue designed for handing data from exactly
+ * one producer to exactly one consumer that may be running in different
+ * contexts, such as an interrupt service routine and a thread, or two cores.
+ * Unlike `hal::circular_buffer`, the queue has a read index, never overwrites
+ * unread elements and every operation is non-blocking.
+ *
+ * The head (read) and tail (write) indices are atomics. The producer publishes
+ * elements with a release store of the tail and the consumer observes them
+ * with an acquire load, and vice versa for the head. Only atomic loads and
+ * stores are used, never read-modify-write operations, so the queue remains
+ * wait-free on processors without exclusive load/store instructions such as
+ * the Cortex-M0.
+ *
+ * The capacity is rounded up to a power of two so that indices wrap with a bit
+ * mask rather than a modulo operation. Element slots are only constructed when
+ * an element is pushed and are destroyed when popped, so T does not need to
+ * be default constructible.
+ *
+ * Example usage:
+ * ```
+ * hal::spsc_queue<hal::can_message> queue(allocator, 32);
+ *
+ * // Within the interrupt handler (producer)
+ * queue.try_push(p_message);
+ *
+ * // Within the application thread (consumer)
+ * while (auto message = queue.try_pop()) {
+ *   process(*message);
+ * }
+ * ```
+ *
+ * @tparam T The type of elements in the queue
+ * @tparam IndexAlignment Alignment, in bytes, of the head and tail indices.
+ * Defaults to `cache_line_size` so that the producer and consumer do not
+ * contend for the same cache line on multicore hosts. On single core
+ * microcontrollers without a data cache this can be reduced to
+ * `alignof(usize)` to save RAM.
+ */
+template<typename T, usize IndexAlignment = cache_line_size>
+class spsc_queue
+{
+public:
+  static_assert(std::has_single_bit(IndexAlignment),
+                "IndexAlignment must be a power of two");
+  static_assert(IndexAlignment >= alignof(std::atomic<usize>),
+                "IndexAlignment must be at least the alignment of the indices");
+  static_assert(std::atomic<usize>::is_always_lock_free,
+                "spsc_queue requires lock free atomic indices");
+
+  // Standard container type definitions
+  using value_type = T;
+  using size_type = usize;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using pointer = value_type*;
+  using const_pointer = value_type const*;
+
+  /**
+   * @brief Default constructor is deleted - capacity must be provided
+   */
+  spsc_queue() = delete;
+
+  /**
+   * @brief Move constructor is deleted - spsc_queue should not be moved
+   */
+  spsc_queue(spsc_queue&&) = delete;
+
+  /**
+   * @brief Move assignment is deleted - spsc_queue should not be moved
+   */
+  spsc_queue& operator=(spsc_queue&&) = delete;
+
+  /**
+   * @brief Copy constructor is deleted - spsc_queue should not be copied
+   */
+  spsc_queue(spsc_queue const& p_other) = delete;
+
+  /**
+   * @brief Copy assignment is deleted - spsc_queue should not be copied
+   */
+  spsc_queue& operator=(spsc_queue const&) = delete;
+
+  /**
+   * @brief Create a spsc_queue with specified capacity
+   *
+   * No elements are constructed. The capacity is rounded up to the next power
+   * of two. If p_capacity is 0, a queue of capacity 1 will be allocated.
+   *
+   * @param p_allocator The allocator to use for memory allocation
+   * @param p_capacity The minimum number of elements the queue can hold
+   * @throws std::bad_alloc if memory allocation fails
+   */
+  explicit spsc_queue(std::pmr::polymorphic_allocator<byte> p_allocator,
+                      size_type p_capacity)
+    : m_allocator(p_allocator)
+    , m_capacity(std::bit_ceil(std::max<size_type>(1, p_capacity)))
+  {
+    m_data = m_allocator.allocate_object<T>(m_capacity);
+  }
+
+  /**
+   * @brief Destructor
+   *
+   * Destroys all unread elements and deallocates memory.
+   */
+  ~spsc_queue()
+  {
+    if constexpr (not std::is_trivially_destructible_v<T>) {
+      auto const tail = m_tail.load(std::memory_order_acquire);
+      for (auto head = m_head.load(std::memory_order_relaxed); head != tail;
+           ++head) {
+        slot(head).~T();
+      }
+    }
+    m_allocator.deallocate_object(m_data, m_capacity);
+  }
+
+  /**
+   * @brief Attempt to push a copy of an element into the queue
+   *
+   * Must only be called by the producer.
+   *
+   * @param p_value The value to copy into the queue
+   * @return true - if the element was pushed
+   * @return false - if the queue is full, the element was not pushed
+   */
+  bool try_push(T const& p_value)
+  {
+    return try_emplace(p_value);
+  }
+
+  /**
+   * @brief Attempt to move an element into the queue
+   *
+   * Must only be called by the producer.
+   *
+   * @param p_value The value to move into the queue
+   * @return true - if the element was pushed
+   * @return false - if the queue is full, p_value is left untouched
+   */
+  bool try_push(T&& p_value)
+  {
+    return try_emplace(std::move(p_value));
+  }
+
+  /**
+   * @brief Attempt to construct an element in place at the back of the queue
+   *
+   * Must only be called by the producer.
+   *
+   * @tparam Args Types of the arguments to forward to the constructor
+   * @param p_args Arguments to forward to the constructor
+   * @return true - if the element was constructed in the queue
+   * @return false - if the queue is full, nothing was constructed
+   */
+  template<typename... Args>
+  bool try_emplace(Args&&... p_args)
+  {
+    auto const tail = m_tail.load(std::memory_order_relaxed);
+    auto const head = m_head.load(std::memory_order_acquire);
+
+    if (tail - head == m_capacity) {
+      return false;
+    }
+
+    new (&slot(tail)) T(std::forward<Args>(p_args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Push as many elements from a span as will fit in the queue
+   *
+   * Elements are copied in order and published to the consumer with a single
+   * store of the tail index, so the consumer observes either none or all of
+   * them. Must only be called by the producer.
+   *
+   * @param p_values The values to copy into the queue
+   * @return size_type - the number of elements pushed, which is less than
+   * `p_values.size()` if the queue filled up.
+   */
+  size_type push_n(std::span<T const> p_values)
+  {
+    auto const tail = m_tail.load(std::memory_order_relaxed);
+    auto const head = m_head.load(std::memory_order_acquire);
+    auto const free_slots = m_capacity - (tail - head);
+    auto const count = std::min(free_slots, p_values.size());
+
+    for (size_type i = 0; i < count; ++i) {
+      new (&slot(tail + i)) T(p_values[i]);
+    }
+
+    m_tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * @brief Attempt to pop the element at the front of the queue
+   *
+   * Must only be called by the consumer.
+   *
+   * @return std::optional<T> - the element removed from the queue or
+   * std::nullopt if the queue was empty.
+   */
+  [[nodiscard]] std::optional<T> try_pop()
+  {
+    auto const head = m_head.load(std::memory_order_relaxed);
+    auto const tail = m_tail.load(std::memory_order_acquire);
+
+    if (head == tail) {
+      return std::nullopt;
+    }
+
+    auto& element = slot(head);
+    std::optional<T> result(std::move(element));
+    element.~T();
+    m_head.store(head + 1, std::memory_order_release);
+    return result;
+  }
+
+  /**
+   * @brief Pop up to `p_destination.size()` elements from the queue
+   *
+   * Elements are moved out in order and their slots are returned to the
+   * producer with a single store of the head index. Must only be called by the
+   * consumer.
+   *
+   * @param p_destination The span to move elements into
+   * @return size_type - the number of elements popped, which is less than
+   * `p_destination.size()` if the queue ran out of elements.
+   */
+  size_type pop_n(std::span<T> p_destination)
+  {
+    auto const head = m_head.load(std::memory_order_relaxed);
+    auto const tail = m_tail.load(std::memory_order_acquire);
+    auto const count = std::min(tail - head, p_destination.size());
+
+    for (size_type i = 0; i < count; ++i) {
+      auto& element = slot(head + i);
+      p_destination[i] = std::move(element);
+      element.~T();
+    }
+
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * @brief Get the number of elements in the queue
+   *
+   * The value is a snapshot. When called by the consumer, more elements may
+   * have arrived by the time it is used, so it is a lower bound. When called
+   * by the producer, elements may have been removed, so it is an upper bound.
+   *
+   * @return size_type - number of elements in the queue
+   */
+  [[nodiscard]] size_type size() const noexcept
+  {
+    auto const head = m_head.load(std::memory_order_acquire);
+    auto const tail = m_tail.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  /**
+   * @brief Determine if the queue has no elements
+   *
+   * @return true - if the queue was empty
+   * @return false - if the queue held at least one element
+   */
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Determine if the queue has no free slots
+   *
+   * @return true - if the queue was full
+   * @return false - if the queue had room for at least one element
+   */
+  [[nodiscard]] bool full() const noexcept
+  {
+    return size() == m_capacity;
+  }
+
+  /**
+   * @brief Returns the capacity of the spsc_queue
+   *
+   * @return size_type - the number of elements the queue can hold
+   */
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+private:
+  [[nodiscard]] T& slot(size_type p_index) noexcept
+  {
+    return m_data[p_index & (m_capacity - 1)];
+  }
+
+  std::pmr::polymorphic_allocator<byte> m_allocator;  ///< Allocator
+  pointer m_data = nullptr;  ///< Pointer to allocated memory
+  size_type m_capacity = 0;  ///< Capacity of the queue, a power of two
+  /// Free running read counter, written only by the consumer
+  alignas(IndexAlignment) std::atomic<size_type> m_head = 0;
+  /// Free running write counter, written only by the producer
+  alignas(IndexAlignment) std::atomic<size_type> m_tail = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using hal::v5::cache_line_size;
+using hal::v5::spsc_queue;
+}  // namespace hal
@@ -0,0 +1,339 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <span>
+
+#include "adc.hpp"
+#include "functional.hpp"
+#include "i2c.hpp"
+#include "input_pin.hpp"
+#include "output_pin.hpp"
+#include "spi.hpp"
+#include "timeout.hpp"
+#include "units.hpp"
+
+/**
+ * @file static_interfaces.hpp
+ * @brief Compile time counterparts of the hardware interfaces
+ *
+ * Each concept in this file describes the public API of one of the virtual
+ * interfaces, so code that is templated on a concept accepts any type with
+ * that API: the interface itself, a driver implementing the interface, or a
+ * driver that does not derive from anything at all. When the template is
+ * instantiated with a concrete type, each call binds directly to that type's
+ * functions, which the compiler can inline. For drivers that implement the
+ * virtual interface, mark the driver class `final` so the compiler can also
+ * resolve the `driver_*` call behind each public function.
+ *
+ * This matters in tight loops such as bit-banging a protocol or acquiring
+ * samples, where a virtual call per operation prevents the loop from compiling
+ * down to direct register accesses.
+ *
+ * The adaptors in this file go the other way: they wrap a driver that only
+ * satisfies a concept in the matching virtual interface, so it can be passed
+ * to code that takes the interface by reference.
+ *
+ * Example usage:
+ *
+ * ```
+ * template<hal::static_output_pin Pin>
+ * void pulse(Pin& p_pin, int p_count)
+ * {
+ *   for (int i = 0; i < p_count; i++) {
+ *     p_pin.level(true);
+ *     p_pin.level(false);
+ *   }
+ * }
+ *
+ * pulse(register_pin, 8);  // direct calls, register_pin's type is known
+ * hal::static_output_pin_adaptor erased(register_pin);
+ * device_driver driver(erased);  // device_driver takes hal::output_pin&
+ * ```
+ */
+
+namespace hal::v5 {
+/**
+ * @brief A type with the public API of `hal::output_pin`
+ *
+ */
+template<class T>
+concept static_output_pin =
+  requires(T& p_pin, output_pin::settings const& p_settings, bool p_high) {
+    p_pin.configure(p_settings);
+    p_pin.level(p_high);
+    { p_pin.level() } -> std::convertible_to<bool>;
+  };
+
+/**
+ * @brief A type with the public API of `hal::input_pin`
+ *
+ */
+template<class T>
+concept static_input_pin =
+  requires(T& p_pin, input_pin::settings const& p_settings) {
+    p_pin.configure(p_settings);
+    { p_pin.level() } -> std::convertible_to<bool>;
+  };
+
+/**
+ * @brief A type with the public API of `hal::adc16`
+ *
+ */
+template<class T>
+concept static_adc16 = requires(T& p_adc) {
+  { p_adc.read() } -> std::convertible_to<u16>;
+};
+
+/**
+ * @brief A type with the blocking transaction API of `hal::i2c`
+ *
+ * The deprecated timeout and the scatter transactions are not required.
+ */
+template<class T>
+concept static_i2c = requires(T& p_i2c,
+                              i2c::settings const& p_settings,
+                              hal::byte p_address,
+                              std::span<hal::byte const> p_data_out,
+                              std::span<hal::byte> p_data_in) {
+  p_i2c.configure(p_settings);
+  p_i2c.transaction(p_address, p_data_out, p_data_in);
+};
+
+/**
+ * @brief A type with the public API of `hal::spi_channel`
+ *
+ * The scatter transfer is not required.
+ */
+template<class T>
+concept static_spi_channel = requires(T& p_spi,
+                                      spi_channel::settings const& p_settings,
+                                      bool p_select,
+                                      std::span<hal::byte const> p_data_out,
+                                      std::span<hal::byte> p_data_in,
+                                      hal::byte p_filler) {
+  p_spi.configure(p_settings);
+  { p_spi.clock_rate() } -> std::convertible_to<u32>;
+  p_spi.chip_select(p_select);
+  p_spi.transfer(p_data_out, p_data_in, p_filler);
+};
+
+/**
+ * @brief Implement `hal::output_pin` with a static output pin driver
+ *
+ * @tparam T - driver type. Must outlive this object.
+ */
+template<static_output_pin T>
+class static_output_pin_adaptor final : public hal::output_pin
+{
+public:
+  /**
+   * @brief Wrap a driver in the virtual interface
+   *
+   * @param p_driver - driver to forward every call to
+   */
+  explicit static_output_pin_adaptor(T& p_driver)
+    : m_driver(&p_driver)
+  {
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  void driver_level(bool p_high) override
+  {
+    m_driver->level(p_high);
+  }
+
+  bool driver_level() override
+  {
+    return m_driver->level();
+  }
+
+  T* m_driver;
+};
+
+/**
+ * @brief Implement `hal::input_pin` with a static input pin driver
+ *
+ * @tparam T - driver type. Must outlive this object.
+ */
+template<static_input_pin T>
+class static_input_pin_adaptor final : public hal::input_pin
+{
+public:
+  /**
+   * @brief Wrap a driver in the virtual interface
+   *
+   * @param p_driver - driver to forward every call to
+   */
+  explicit static_input_pin_adaptor(T& p_driver)
+    : m_driver(&p_driver)
+  {
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  bool driver_level() override
+  {
+    return m_driver->level();
+  }
+
+  T* m_driver;
+};
+
+/**
+ * @brief Implement `hal::adc16` with a static adc driver
+ *
+ * @tparam T - driver type. Must outlive this object.
+ */
+template<static_adc16 T>
+class static_adc16_adaptor final : public hal::adc16
+{
+public:
+  /**
+   * @brief Wrap a driver in the virtual interface
+   *
+   * @param p_driver - driver to forward every call to
+   */
+  explicit static_adc16_adaptor(T& p_driver)
+    : m_driver(&p_driver)
+  {
+  }
+
+private:
+  u16 driver_read() override
+  {
+    return m_driver->read();
+  }
+
+  T* m_driver;
+};
+
+/**
+ * @brief Implement `hal::i2c` with a static i2c driver
+ *
+ * The timeout of the deprecated timeout transaction is dropped, as is
+ * required of every i2c implementation. Scatter transactions use the
+ * interface's default implementation.
+ *
+ * @tparam T - driver type. Must outlive this object.
+ */
+template<static_i2c T>
+class static_i2c_adaptor final : public hal::i2c
+{
+public:
+  /**
+   * @brief Wrap a driver in the virtual interface
+   *
+   * @param p_driver - driver to forward every call to
+   */
+  explicit static_i2c_adaptor(T& p_driver)
+    : m_driver(&p_driver)
+  {
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    m_driver->transaction(p_address, p_data_out, p_data_in);
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in) override
+  {
+    m_driver->transaction(p_address, p_data_out, p_data_in);
+  }
+
+  T* m_driver;
+};
+
+/**
+ * @brief Implement `hal::spi_channel` with a static spi channel driver
+ *
+ * Scatter transfers use the interface's default implementation.
+ *
+ * @tparam T - driver type. Must outlive this object.
+ */
+template<static_spi_channel T>
+class static_spi_channel_adaptor final : public hal::spi_channel
+{
+public:
+  /**
+   * @brief Wrap a driver in the virtual interface
+   *
+   * @param p_driver - driver to forward every call to
+   */
+  explicit static_spi_channel_adaptor(T& p_driver)
+    : m_driver(&p_driver)
+  {
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_driver->configure(p_settings);
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return m_driver->clock_rate();
+  }
+
+  void driver_chip_select(bool p_select) override
+  {
+    m_driver->chip_select(p_select);
+  }
+
+  void driver_transfer(std::span<hal::byte const> p_data_out,
+                       std::span<hal::byte> p_data_in,
+                       hal::byte p_filler) override
+  {
+    m_driver->transfer(p_data_out, p_data_in, p_filler);
+  }
+
+  T* m_driver;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::static_adc16;
+using v5::static_adc16_adaptor;
+using v5::static_i2c;
+using v5::static_i2c_adaptor;
+using v5::static_input_pin;
+using v5::static_input_pin_adaptor;
+using v5::static_output_pin;
+using v5::static_output_pin_adaptor;
+using v5::static_spi_channel;
+using v5::static_spi_channel_adaptor;
+}  // namespace hal
@@ -3,6 +3,8 @@
 #include <concepts>
 #include <span>
 
+#include "error.hpp"
+#include "functional.hpp"
 #include "units.hpp"
 
 namespace hal {
@@ -150,4 +152,238 @@ namespace hal::v5 {
 using hal::stream_dac;
 using hal::stream_dac_u16;
 using hal::stream_dac_u8;
+
+/**
+ * @brief Hardware abstraction for a dac that plays a continuous stream
+ *
+ * Where `hal::stream_dac::write()` blocks until a span has been played and
+ * leaves a gap between calls, this interface plays a caller provided buffer
+ * in a loop, using it as two halves: a "ping" and a "pong" block. While the
+ * hardware, usually a circular DMA channel, plays one block, the application
+ * fills the other. When the hardware finishes a block it moves on to the other
+ * one without CPU intervention and calls the refill handler with the block it
+ * just finished, which must be refilled before the hardware finishes the
+ * current block.
+ *
+ * At 44.1kHz with a 1024 sample buffer, each block lasts ~11.6ms, which is the
+ * time the application has to produce the next 512 samples. Choose the buffer
+ * size to cover the longest time the CPU may be busy with other work.
+ *
+ * See `hal::stream_dac` for the requirements on sample justification.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::u16, 1024> buffer{};
+ * render(buffer);
+ * dac.start(44.1_kHz, buffer, [](auto, std::span<hal::u16> p_block) {
+ *   render(p_block);
+ * });
+ * ```
+ *
+ * @tparam data_t - container size for the sample data. For such things as PCM8
+ * and PCM16, this would be std::uint8_t and std::uint16_t respectively.
+ */
+template<std::unsigned_integral data_t>
+class continuous_stream_dac
+{
+public:
+  /**
+   * @brief Disambiguation tag object for refill events
+   *
+   */
+  struct on_refill_tag
+  {};
+
+  /**
+   * @brief Refill handler signature
+   *
+   * The block passed to the handler has finished playing and will be played
+   * again once the other block finishes. The handler is most likely called
+   * from an interrupt context and must not throw.
+   */
+  using refill_handler = void(on_refill_tag, std::span<data_t> p_block);
+
+  /**
+   * @brief Start continuous playback of a buffer
+   *
+   * The first half of the buffer is played first, followed by the second half,
+   * and then the first half again, until `stop()` is called. Both halves must
+   * be filled with samples before calling this API. If playback is already
+   * running, it is stopped first.
+   *
+   * This api has a strong exception guarantee, in that, it will throw an
+   * exception before it transmits any data to the dac.
+   *
+   * @param p_sample_rate - rate at which samples are written to the dac
+   * @param p_buffer - buffer to play. Must have an even, non-zero, number of
+   * samples and must remain valid until `stop()` is called or this object is
+   * destroyed.
+   * @param p_refill - called with each block after it finishes playing
+   * @throws hal::argument_out_of_domain - when the sample rate is not possible
+   * for the DAC or the buffer size is not accepted by the DAC. See
+   * `hal::stream_dac::write()` for details on sample rate limits.
+   */
+  void start(hal::hertz p_sample_rate,
+             std::span<data_t> p_buffer,
+             hal::callback<refill_handler> p_refill)
+  {
+    driver_start(p_sample_rate, p_buffer, p_refill);
+  }
+
+  /**
+   * @brief Stop playback
+   *
+   * After this returns, the refill handler will not be called again and the
+   * buffer passed to `start()` is no longer used. Calling this API if playback
+   * is not running does nothing.
+   */
+  void stop()
+  {
+    driver_stop();
+  }
+
+  /**
+   * @brief Determine if playback is running
+   *
+   * @return true - playback was started and has not been stopped
+   * @return false - the dac is idle
+   */
+  [[nodiscard]] bool playing()
+  {
+    return driver_playing();
+  }
+
+  virtual ~continuous_stream_dac() = default;
+
+private:
+  virtual void driver_start(hal::hertz p_sample_rate,
+                            std::span<data_t> p_buffer,
+                            hal::callback<refill_handler> p_refill) = 0;
+  virtual void driver_stop() = 0;
+  virtual bool driver_playing() = 0;
+};
+
+/**
+ * @brief Shorthand for continuous_stream_dac<std::uint8_t>
+ *
+ */
+using continuous_stream_dac_u8 = continuous_stream_dac<std::uint8_t>;
+
+/**
+ * @brief Shorthand for continuous_stream_dac<std::uint16_t>
+ *
+ */
+using continuous_stream_dac_u16 = continuous_stream_dac<std::uint16_t>;
+
+/**
+ * @brief Hardware abstraction for a dac with synchronized output channels
+ *
+ * Two `hal::stream_dac` objects driven by separate blocking calls start at
+ * different times and run from separate sample clocks, so stereo or
+ * multichannel output played through them drifts apart. This interface takes
+ * a single stream of interleaved frames, each frame holding one sample per
+ * channel:
+ *
+ * ```text
+ *   data: | L0 | R0 | L1 | R1 | L2 | R2 | ...
+ *           rame 0/ rame 1/ rame 2/
+ * ```
+ *
+ * The driver feeds the stream through one DMA channel to every output, so all
+ * channels update from the same sample clock. Use `hal::interleave()` to build
+ * the stream from separate channel buffers.
+ *
+ * See `hal::stream_dac` for the requirements on sample justification.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::u16, 2 * 256> frames{};
+ * auto const channels = hal::make_scatter_array<hal::u16 const>(left, right);
+ * hal::interleave<hal::u16>(channels, frames);
+ * dac.write({ .sample_rate = 48.0_kHz, .channels = 2, .data = frames });
+ * ```
+ *
+ * @tparam data_t - container size for the sample data. For such things as PCM8
+ * and PCM16, this would be std::uint8_t and std::uint16_t respectively.
+ */
+template<std::unsigned_integral data_t>
+class multichannel_stream_dac
+{
+public:
+  struct samples
+  {
+    /// Number of frames written to the outputs per second
+    hal::hertz sample_rate;
+    /// Number of interleaved channels in each frame. Channel 0 is written to
+    /// the first output of the dac, channel 1 to the second, and so on.
+    u8 channels;
+    /// Interleaved frames of samples. If this is empty, then the write command
+    /// simply returns without updating anything.
+    std::span<data_t const> data;
+  };
+
+  /**
+   * @brief Get the number of outputs of the dac
+   *
+   * @return u8 - largest channel count accepted by `write()`
+   */
+  [[nodiscard]] u8 max_channels()
+  {
+    return driver_max_channels();
+  }
+
+  /**
+   * @brief Stream interleaved frames of unsigned PCM data to the dac outputs
+   *
+   * This API is a blocking call with the same io_waiter requirements as
+   * `hal::stream_dac::write()`. When the call returns, every channel has
+   * played the same number of samples.
+   *
+   * This api has a strong exception guarantee, in that, it will throw an
+   * exception before it transmits any data to the dac.
+   *
+   * @param p_samples - interleaved frames to be written to the dac outputs
+   * @throws hal::argument_out_of_domain - when the channel count is zero or
+   * above `max_channels()`, when the data does not hold a whole number of
+   * frames, or when the sample rate is not possible for the DAC. See
+   * `hal::stream_dac::write()` for details on sample rate limits.
+   */
+  void write(samples const& p_samples)
+  {
+    if (p_samples.channels == 0 || p_samples.channels > max_channels() ||
+        p_samples.data.size() % p_samples.channels != 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    driver_write(p_samples);
+  }
+
+  virtual ~multichannel_stream_dac() = default;
+
+private:
+  virtual u8 driver_max_channels() = 0;
+  virtual void driver_write(samples const& p_samples) = 0;
+};
+
+/**
+ * @brief Shorthand for multichannel_stream_dac<std::uint8_t>
+ *
+ */
+using multichannel_stream_dac_u8 = multichannel_stream_dac<std::uint8_t>;
+
+/**
+ * @brief Shorthand for multichannel_stream_dac<std::uint16_t>
+ *
+ */
+using multichannel_stream_dac_u16 = multichannel_stream_dac<std::uint16_t>;
 }  // namespace hal::v5
+
+namespace hal {
+using v5::continuous_stream_dac;
+using v5::continuous_stream_dac_u16;
+using v5::continuous_stream_dac_u8;
+using v5::multichannel_stream_dac;
+using v5::multichannel_stream_dac_u16;
+using v5::multichannel_stream_dac_u8;
+}  // namespace hal
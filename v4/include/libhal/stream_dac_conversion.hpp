@@ -0,0 +1,513 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "error.hpp"
+#include "scatter_span.hpp"
+#include "units.hpp"
+
+/**
+ * @file stream_dac_conversion.hpp
+ * @brief Sample preparation kernels for the stream dac interfaces
+ *
+ * `hal::stream_dac` expects samples left justified in the container type.
+ * These kernels prepare samples for dacs that differ: right justified dacs,
+ * dacs that need control bits set in the unused bits of every sample, and
+ * dacs wider than the sample data. They run in place, or from a source buffer
+ * into a DMA buffer, and `hal::stream_dac_feeder` converts a source buffer
+ * block by block into the ping-pong blocks of a `hal::continuous_stream_dac`.
+ *
+ * Justification and widening of 8 and 16-bit samples process a whole machine
+ * word of samples per operation, shifting and masking every sample in the
+ * word at once, so they run several times faster than a loop over each sample
+ * even when the compiler does not vectorize, such as at `-O2` or `-Os` on
+ * targets without SIMD extensions. The remaining kernels are branch free
+ * loops, which compilers vectorize when auto-vectorization is enabled, such as
+ * with `-O3`.
+ */
+
+namespace hal::v5 {
+namespace detail {
+/// Register sized group of samples processed by a single operation
+using sample_word = usize;
+
+template<std::unsigned_integral data_t>
+inline constexpr usize word_lanes = sizeof(sample_word) / sizeof(data_t);
+
+/// Returns a word holding p_value in every lane
+template<std::unsigned_integral data_t>
+constexpr sample_word repeat_lanes(data_t p_value)
+{
+  sample_word result = p_value;
+  for (usize i = 1; i < word_lanes<data_t>; i++) {
+    result = (result << std::numeric_limits<data_t>::digits) | p_value;
+  }
+  return result;
+}
+
+template<std::unsigned_integral data_t>
+constexpr void check_unused_bits(u8 p_unused_bits)
+{
+  if (p_unused_bits >= std::numeric_limits<data_t>::digits) {
+    hal::safe_throw(hal::argument_out_of_domain(nullptr));
+  }
+}
+
+template<std::unsigned_integral data_t>
+constexpr void check_flags(u8 p_unused_bits, data_t p_flags)
+{
+  check_unused_bits<data_t>(p_unused_bits);
+  auto const data_bits =
+    static_cast<data_t>(std::numeric_limits<data_t>::max() >> p_unused_bits);
+  if ((p_flags & data_bits) != 0) {
+    hal::safe_throw(hal::argument_out_of_domain(nullptr));
+  }
+}
+
+/// Shift p_count samples right, setting p_flags, a word at a time. p_input
+/// and p_output may be the same buffer.
+template<std::unsigned_integral data_t>
+constexpr void shift_right(data_t const* p_input,
+                           data_t* p_output,
+                           usize p_count,
+                           u8 p_shift,
+                           data_t p_flags)
+{
+  if constexpr (word_lanes<data_t> > 1) {
+    if (not std::is_constant_evaluated()) {
+      // Bits shifted across lanes land in the unused high bits of the lane
+      // below, which the mask clears before the flags are set
+      auto const mask = repeat_lanes(
+        static_cast<data_t>(std::numeric_limits<data_t>::max() >> p_shift));
+      auto const flags = repeat_lanes(p_flags);
+      for (; p_count >= word_lanes<data_t>; p_count -= word_lanes<data_t>) {
+        sample_word word{};
+        std::memcpy(&word, p_input, sizeof(word));
+        word = ((word >> p_shift) & mask) | flags;
+        std::memcpy(p_output, &word, sizeof(word));
+        p_input += word_lanes<data_t>;
+        p_output += word_lanes<data_t>;
+      }
+    }
+  }
+  for (usize i = 0; i < p_count; i++) {
+    p_output[i] = static_cast<data_t>((p_input[i] >> p_shift) | p_flags);
+  }
+}
+
+/// Shift p_count samples left a word at a time. p_input and p_output may be
+/// the same buffer.
+template<std::unsigned_integral data_t>
+constexpr void shift_left(data_t const* p_input,
+                          data_t* p_output,
+                          usize p_count,
+                          u8 p_shift)
+{
+  if constexpr (word_lanes<data_t> > 1) {
+    if (not std::is_constant_evaluated()) {
+      auto const mask = repeat_lanes(
+        static_cast<data_t>(std::numeric_limits<data_t>::max() << p_shift));
+      for (; p_count >= word_lanes<data_t>; p_count -= word_lanes<data_t>) {
+        sample_word word{};
+        std::memcpy(&word, p_input, sizeof(word));
+        word = (word << p_shift) & mask;
+        std::memcpy(p_output, &word, sizeof(word));
+        p_input += word_lanes<data_t>;
+        p_output += word_lanes<data_t>;
+      }
+    }
+  }
+  for (usize i = 0; i < p_count; i++) {
+    p_output[i] = static_cast<data_t>(p_input[i] << p_shift);
+  }
+}
+
+/// Returns the multiplier that repeats a source_t value across a data_t
+template<std::unsigned_integral source_t, std::unsigned_integral data_t>
+constexpr data_t replication_factor()
+{
+  data_t factor = 0;
+  for (usize i = 0; i < sizeof(data_t) / sizeof(source_t); i++) {
+    factor = static_cast<data_t>(
+      (factor << std::numeric_limits<source_t>::digits) | 1U);
+  }
+  return factor;
+}
+
+/// Widen p_count samples to full scale. p_output must not overlap p_input.
+template<std::unsigned_integral source_t, std::unsigned_integral data_t>
+constexpr void widen(source_t const* p_input, data_t* p_output, usize p_count)
+{
+  constexpr auto factor = replication_factor<source_t, data_t>();
+  if constexpr (std::is_same_v<source_t, u8> && std::is_same_v<data_t, u16> &&
+                std::endian::native == std::endian::little) {
+    if (not std::is_constant_evaluated()) {
+      // Spread the bytes of half a word into the 16-bit lanes of a word,
+      // then repeat each byte into the upper half of its lane with a multiply
+      constexpr auto lanes = word_lanes<u16>;
+      constexpr auto spread = [](sample_word p_half) {
+        if constexpr (lanes == 4) {
+          p_half = (p_half | (p_half << 16U)) & 0x0000'FFFF'0000'FFFFULL;
+        }
+        p_half = (p_half | (p_half << 8U)) & repeat_lanes<u16>(0x00FF);
+        return p_half * 0x0101U;
+      };
+      constexpr auto half_bits = std::numeric_limits<sample_word>::digits / 2;
+      constexpr auto low_half = ~sample_word{ 0 } >> half_bits;
+      for (; p_count >= 2 * lanes; p_count -= 2 * lanes) {
+        sample_word bytes{};
+        std::memcpy(&bytes, p_input, sizeof(bytes));
+        std::array<sample_word, 2> const words{ spread(bytes & low_half),
+                                                spread(bytes >> half_bits) };
+        std::memcpy(p_output, words.data(), sizeof(words));
+        p_input += 2 * lanes;
+        p_output += 2 * lanes;
+      }
+    }
+  }
+  for (usize i = 0; i < p_count; i++) {
+    p_output[i] = static_cast<data_t>(p_input[i] * factor);
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Interleave separate channel buffers into frames
+ *
+ * Frame `i` of the output holds sample `i` of channel 0, then sample `i` of
+ * channel 1, and so on, as expected by `hal::multichannel_stream_dac`.
+ *
+ * @tparam data_t - sample container type
+ * @param p_channels - one span of samples per channel
+ * @param p_frames - buffer to write the interleaved frames into
+ * @return usize - number of frames written, limited by the shortest channel
+ * and by the number of whole frames that fit in p_frames
+ */
+template<std::unsigned_integral data_t>
+constexpr usize interleave(
+  scatter_span<std::type_identity_t<data_t> const> p_channels,
+  std::span<data_t> p_frames)
+{
+  auto const channels = p_channels.size();
+  if (channels == 0) {
+    return 0;
+  }
+  auto frames = p_frames.size() / channels;
+  for (auto const& channel : p_channels) {
+    frames = std::min(frames, channel.size());
+  }
+
+  if (channels == 2) {
+    // A constant stride lets the compiler vectorize the common stereo case
+    auto const left = p_channels[0];
+    auto const right = p_channels[1];
+    for (usize i = 0; i < frames; i++) {
+      p_frames[2 * i] = left[i];
+      p_frames[2 * i + 1] = right[i];
+    }
+    return frames;
+  }
+
+  for (usize c = 0; c < channels; c++) {
+    auto const channel = p_channels[c];
+    for (usize i = 0; i < frames; i++) {
+      p_frames[i * channels + c] = channel[i];
+    }
+  }
+  return frames;
+}
+
+/**
+ * @brief Shift samples in place for a right justified dac
+ *
+ * Converts full scale samples to fit a dac that uses the low bits of its
+ * register, for example 16-bit samples into a 12-bit right justified dac with
+ * 4 unused bits. The low bits of each sample, which the dac cannot resolve,
+ * are dropped.
+ *
+ * @tparam data_t - sample container type
+ * @param p_samples - samples to convert
+ * @param p_unused_bits - number of unused high bits of the dac register
+ * @param p_flags - value of the unused high bits of every sample, for dacs
+ * that take control bits, such as a channel select or gain bit, along with
+ * each sample. Pass the current value of those bits of the register to
+ * preserve them.
+ * @throws hal::argument_out_of_domain - if p_unused_bits is not less than the
+ * number of bits of data_t, or if p_flags has bits set outside of the unused
+ * bits
+ */
+template<std::unsigned_integral data_t>
+constexpr void right_justify(std::span<data_t> p_samples,
+                             u8 p_unused_bits,
+                             std::type_identity_t<data_t> p_flags = 0)
+{
+  detail::check_flags<data_t>(p_unused_bits, p_flags);
+  detail::shift_right(p_samples.data(),
+                      p_samples.data(),
+                      p_samples.size(),
+                      p_unused_bits,
+                      static_cast<data_t>(p_flags));
+}
+
+/**
+ * @brief Copy samples into a buffer, shifted for a right justified dac
+ *
+ * Use this to fill a DMA buffer, such as a block of a
+ * `hal::continuous_stream_dac`, without modifying the source samples.
+ *
+ * @tparam data_t - sample container type
+ * @param p_source - full scale samples
+ * @param p_destination - buffer to write the converted samples into
+ * @param p_unused_bits - number of unused high bits of the dac register
+ * @param p_flags - value of the unused high bits of every sample
+ * @return usize - number of samples converted, the smaller of the two sizes
+ * @throws hal::argument_out_of_domain - if p_unused_bits is not less than the
+ * number of bits of data_t, or if p_flags has bits set outside of the unused
+ * bits
+ */
+template<std::unsigned_integral data_t>
+constexpr usize right_justify(
+  std::span<std::type_identity_t<data_t> const> p_source,
+  std::span<data_t> p_destination,
+  u8 p_unused_bits,
+  std::type_identity_t<data_t> p_flags = 0)
+{
+  detail::check_flags<data_t>(p_unused_bits, p_flags);
+  auto const count = std::min(p_source.size(), p_destination.size());
+  detail::shift_right(p_source.data(),
+                      p_destination.data(),
+                      count,
+                      p_unused_bits,
+                      static_cast<data_t>(p_flags));
+  return count;
+}
+
+/**
+ * @brief Shift right justified samples in place to full scale
+ *
+ * The inverse of `right_justify()`, for sample data produced for a right
+ * justified dac that must be played through a left justified one. Any flag
+ * bits are shifted out.
+ *
+ * @tparam data_t - sample container type
+ * @param p_samples - samples to convert
+ * @param p_unused_bits - number of unused high bits of the samples
+ * @throws hal::argument_out_of_domain - if p_unused_bits is not less than the
+ * number of bits of data_t
+ */
+template<std::unsigned_integral data_t>
+constexpr void left_justify(std::span<data_t> p_samples, u8 p_unused_bits)
+{
+  detail::check_unused_bits<data_t>(p_unused_bits);
+  detail::shift_left(
+    p_samples.data(), p_samples.data(), p_samples.size(), p_unused_bits);
+}
+
+/**
+ * @brief Copy right justified samples into a buffer, shifted to full scale
+ *
+ * @tparam data_t - sample container type
+ * @param p_source - right justified samples
+ * @param p_destination - buffer to write the converted samples into
+ * @param p_unused_bits - number of unused high bits of the samples
+ * @return usize - number of samples converted, the smaller of the two sizes
+ * @throws hal::argument_out_of_domain - if p_unused_bits is not less than the
+ * number of bits of data_t
+ */
+template<std::unsigned_integral data_t>
+constexpr usize left_justify(
+  std::span<std::type_identity_t<data_t> const> p_source,
+  std::span<data_t> p_destination,
+  u8 p_unused_bits)
+{
+  detail::check_unused_bits<data_t>(p_unused_bits);
+  auto const count = std::min(p_source.size(), p_destination.size());
+  detail::shift_left(
+    p_source.data(), p_destination.data(), count, p_unused_bits);
+  return count;
+}
+
+/**
+ * @brief Widen samples to a larger container at full scale
+ *
+ * Each sample is repeated across the wider container, so 0 stays 0 and full
+ * scale stays full scale: 8-bit 0xFF becomes 16-bit 0xFFFF and 0x80 becomes
+ * 0x8080. Use this to play PCM8 data through a 12 or 16-bit dac.
+ *
+ * @tparam source_t - container type of p_source
+ * @tparam data_t - container type of p_destination, larger than source_t
+ * @param p_source - samples to widen
+ * @param p_destination - buffer to write the widened samples into. Must not
+ * overlap p_source.
+ * @return usize - number of samples converted, the smaller of the two sizes
+ */
+template<std::unsigned_integral source_t, std::unsigned_integral data_t>
+  requires(sizeof(source_t) < sizeof(data_t))
+constexpr usize expand(std::span<source_t const> p_source,
+                       std::span<data_t> p_destination)
+{
+  auto const count = std::min(p_source.size(), p_destination.size());
+  detail::widen(p_source.data(), p_destination.data(), count);
+  return count;
+}
+
+/**
+ * @brief Converts a buffer of samples into dac blocks, one block at a time
+ *
+ * Intended for the refill handler of a `hal::continuous_stream_dac`: each
+ * call to `fill()` writes the next samples of the source straight into the
+ * block that just finished playing, widened to the dac's container type,
+ * right justified and with the dac's flag bits set, so the source can stay in
+ * its original format, for example PCM8 in flash, with no intermediate
+ * buffer. Once the source runs out, blocks are filled with a fixed idle value.
+ *
+ * Example usage:
+ *
+ * ```
+ * // PCM8 clip played through a 12-bit right justified dac
+ * hal::stream_dac_feeder<hal::u8, hal::u16> feeder(clip, { .unused_bits = 4 });
+ * std::array<hal::u16, 512> buffer{};
+ * feeder.fill(buffer);
+ * dac.start(16.0_kHz, buffer, [&](auto, std::span<hal::u16> p_block) {
+ *   feeder.fill(p_block);
+ * });
+ * ```
+ *
+ * @tparam source_t - container type of the source samples
+ * @tparam data_t - container type of the dac samples, at least as large as
+ * source_t
+ */
+template<std::unsigned_integral source_t,
+         std::unsigned_integral data_t = source_t>
+class stream_dac_feeder
+{
+public:
+  static_assert(sizeof(source_t) <= sizeof(data_t),
+                "Samples can only be widened");
+
+  /**
+   * @brief Layout of the dac register
+   *
+   */
+  struct settings
+  {
+    /// Number of unused high bits of the dac register. 0 for left justified
+    /// dacs.
+    u8 unused_bits = 0;
+    /// Value of the unused high bits of every sample
+    data_t flags = 0;
+    /// Register value written once the source runs out, such as mid-scale
+    /// for audio along with any flag bits
+    data_t idle = 0;
+  };
+
+  /**
+   * @brief Construct a feeder for a source buffer
+   *
+   * @param p_source - samples to convert. Must stay valid until the feeder is
+   * restarted or destroyed.
+   * @param p_settings - layout of the dac register
+   * @throws hal::argument_out_of_domain - if unused_bits is not less than the
+   * number of bits of data_t, or if flags has bits set outside of the unused
+   * bits
+   */
+  stream_dac_feeder(std::span<source_t const> p_source,
+                    settings const& p_settings)
+    : m_source(p_source)
+    , m_settings(p_settings)
+  {
+    detail::check_flags<data_t>(p_settings.unused_bits, p_settings.flags);
+  }
+
+  /**
+   * @brief Convert the next samples of the source into a block
+   *
+   * Samples past the end of the source are set to the idle value.
+   *
+   * @param p_block - block to fill completely
+   * @return usize - number of source samples converted into the block
+   */
+  usize fill(std::span<data_t> p_block)
+  {
+    auto const count = std::min(p_block.size(), m_source.size());
+    auto const converted = p_block.first(count);
+    if constexpr (std::is_same_v<source_t, data_t>) {
+      detail::shift_right(m_source.data(),
+                          converted.data(),
+                          count,
+                          m_settings.unused_bits,
+                          m_settings.flags);
+    } else {
+      detail::widen(m_source.data(), converted.data(), count);
+      detail::shift_right(converted.data(),
+                          converted.data(),
+                          count,
+                          m_settings.unused_bits,
+                          m_settings.flags);
+    }
+    std::ranges::fill(p_block.subspan(count), m_settings.idle);
+    m_source = m_source.subspan(count);
+    return count;
+  }
+
+  /**
+   * @brief Continue with a new source buffer
+   *
+   * @param p_source - samples to convert. Must stay valid until the feeder is
+   * restarted or destroyed.
+   */
+  void restart(std::span<source_t const> p_source)
+  {
+    m_source = p_source;
+  }
+
+  /**
+   * @return usize - number of source samples not yet converted
+   */
+  [[nodiscard]] usize remaining() const
+  {
+    return m_source.size();
+  }
+
+  /**
+   * @return true - if every source sample has been converted
+   */
+  [[nodiscard]] bool done() const
+  {
+    return m_source.empty();
+  }
+
+private:
+  std::span<source_t const> m_source;
+  settings m_settings;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::expand;
+using v5::interleave;
+using v5::left_justify;
+using v5::right_justify;
+using v5::stream_dac_feeder;
+}  // namespace hal
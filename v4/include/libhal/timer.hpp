@@ -85,6 +85,35 @@ public:
     driver_schedule(p_callback, p_delay);
   }
 
+  /**
+   * @brief Schedule a callback larger than `hal::callback` be executed after
+   * the delay time
+   *
+   * Drivers store a `hal::callback`, so this schedules a callback that
+   * forwards to p_callback by reference. The callable stays inline in
+   * p_callback, without heap allocation. Otherwise behaves like
+   * `schedule(hal::callback<void(void)>, hal::time_duration)`.
+   *
+   * @tparam Capacity - storage capacity of p_callback in bytes, such as that
+   * of a `hal::callback_n`
+   * @param p_callback - callback function to be called when the timer expires.
+   * Must outlive the scheduled event.
+   * @param p_delay - the amount of time until the timer expires
+   * @throws hal::argument_out_of_domain - if p_interval is greater than what
+   * can be cannot be achieved.
+   */
+  template<size_t Capacity>
+    requires(Capacity > sizeof(void*) * hal::callback_words)
+  void schedule(hal::inplace_function<void(void), Capacity>& p_callback,
+                hal::time_duration p_delay)
+  {
+    driver_schedule([&p_callback]() { p_callback(); }, p_delay);
+  }
+
+  /// Bytes each driver reserves to store the scheduled callback
+  static constexpr size_t callback_storage =
+    sizeof(hal::callback<void(void)>);
+
   virtual ~timer() = default;
 
 private:
@@ -0,0 +1,450 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+
+#include "error.hpp"
+#include "functional.hpp"
+#include "nanosecond_clock.hpp"
+#include "steady_clock.hpp"
+#include "timer.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+template<usize Levels>
+class timer_wheel;
+
+namespace detail {
+/**
+ * @brief Node of the circular doubly linked lists of a timer_wheel's slots
+ *
+ */
+struct wheel_link
+{
+  void unlink()
+  {
+    m_previous->m_next = m_next;
+    m_next->m_previous = m_previous;
+    m_next = nullptr;
+    m_previous = nullptr;
+  }
+
+  void link_before(wheel_link& p_position)
+  {
+    m_next = &p_position;
+    m_previous = p_position.m_previous;
+    m_previous->m_next = this;
+    p_position.m_previous = this;
+  }
+
+  void make_empty()
+  {
+    m_next = this;
+    m_previous = this;
+  }
+
+  [[nodiscard]] bool empty() const
+  {
+    return m_next == this;
+  }
+
+  wheel_link* m_next = nullptr;
+  wheel_link* m_previous = nullptr;
+};
+}  // namespace detail
+
+/**
+ * @brief A deadline that can be scheduled on a timer_wheel
+ *
+ * Owned by the application, typically as a member of the driver or task that
+ * needs the timeout, so the wheel never allocates. A timeout can be scheduled
+ * on one wheel at a time and must not be destroyed or moved while it is
+ * scheduled.
+ */
+class wheel_timeout : private detail::wheel_link
+{
+public:
+  /// Handler called when the deadline expires
+  using handler = hal::callback<void()>;
+
+  /**
+   * @brief Construct a timeout
+   *
+   * @param p_handler - handler to call when the deadline expires
+   */
+  explicit wheel_timeout(handler p_handler)
+    : m_handler(p_handler)
+  {
+  }
+
+  wheel_timeout(wheel_timeout const&) = delete;
+  wheel_timeout& operator=(wheel_timeout const&) = delete;
+  wheel_timeout(wheel_timeout&&) = delete;
+  wheel_timeout& operator=(wheel_timeout&&) = delete;
+  ~wheel_timeout() = default;
+
+  /**
+   * @brief Determine if the timeout is waiting to expire
+   *
+   * @return true - if the timeout is scheduled and has not expired or been
+   * canceled
+   */
+  [[nodiscard]] bool scheduled() const
+  {
+    return m_next != nullptr;
+  }
+
+private:
+  template<usize Levels>
+  friend class timer_wheel;
+
+  handler m_handler;
+  u64 m_expiry = 0;
+  u8 m_level = 0;
+  u8 m_slot = 0;
+};
+
+/**
+ * @brief Hierarchical timer wheel multiplexing many timeouts onto one timer
+ *
+ * Timeouts are kept in `Levels` wheels of 64 slots, where level `n` holds
+ * deadlines `64^n` to `64^(n+1)` wheel ticks away. Scheduling and canceling a
+ * timeout links or unlinks it from a slot in constant time. A bitmap of
+ * occupied slots per level finds the next deadline with one count trailing
+ * zeros per level, and only that deadline is programmed into the hardware
+ * timer. Deadlines further than a level away are moved down a level when the
+ * wheel reaches their slot.
+ *
+ * The hardware timer callback runs in interrupt context, so it only marks the
+ * wheel as due. Handlers are called from `poll()`, in the application context,
+ * where they may schedule or cancel any timeout, including their own.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::timer_wheel wheel(timer, steady_clock, 1ms);
+ * hal::wheel_timeout retry([&]() { send_again(); });
+ * wheel.schedule(retry, 250ms);
+ *
+ * while (true) {
+ *   wheel.poll();
+ * }
+ * ```
+ *
+ * @tparam Levels - number of levels in the wheel. The furthest deadline that
+ * can be scheduled is `64^Levels - 1` wheel ticks away.
+ */
+template<usize Levels = 4>
+class timer_wheel
+{
+public:
+  static_assert(Levels > 0 && Levels * 6 < 64,
+                "timer_wheel must have between 1 and 10 levels");
+
+  /// Number of slots in each level
+  static constexpr usize slots = 64;
+
+  /**
+   * @brief Construct a timer wheel
+   *
+   * @param p_timer - hardware timer to schedule the next deadline with. Must
+   * outlive this object and must not be used for anything else.
+   * @param p_clock - steady clock to measure time with. Must outlive this
+   * object.
+   * @param p_resolution - duration of a wheel tick. Deadlines are rounded up to
+   * a whole number of ticks.
+   * @throws hal::argument_out_of_domain - if p_resolution is not positive or
+   * the steady clock frequency is below 1 Hz.
+   */
+  timer_wheel(hal::timer& p_timer,
+              hal::steady_clock& p_clock,
+              hal::time_duration p_resolution)
+    : m_timer(&p_timer)
+    , m_clock(p_clock)
+    , m_resolution(p_resolution)
+  {
+    if (p_resolution.count() <= 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    for (auto& level : m_slots) {
+      for (auto& slot : level) {
+        slot.make_empty();
+      }
+    }
+    m_now = current_tick();
+  }
+
+  timer_wheel(timer_wheel const&) = delete;
+  timer_wheel& operator=(timer_wheel const&) = delete;
+  timer_wheel(timer_wheel&&) = delete;
+  timer_wheel& operator=(timer_wheel&&) = delete;
+
+  ~timer_wheel()
+  {
+    m_timer->cancel();
+  }
+
+  /**
+   * @brief Schedule a timeout to expire after a delay
+   *
+   * If the timeout is already scheduled, it is rescheduled.
+   *
+   * @param p_timeout - timeout to schedule. Must outlive its time on the wheel.
+   * @param p_delay - time until the timeout expires, rounded up to at least one
+   * wheel tick
+   * @throws hal::argument_out_of_domain - if p_delay is further away than the
+   * wheel can hold.
+   */
+  void schedule(wheel_timeout& p_timeout, hal::time_duration p_delay)
+  {
+    cancel(p_timeout);
+
+    auto const now = current_tick();
+    if (empty()) {
+      m_now = now;
+    }
+
+    auto const delay = std::max<i64>(p_delay.count(), 1);
+    auto const ticks =
+      (static_cast<u64>(delay) + resolution_ns() - 1) / resolution_ns();
+    auto const expiry = now + ticks;
+
+    if (std::bit_width(expiry ^ m_now) > Levels * slot_bits) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+
+    p_timeout.m_expiry = expiry;
+    insert(p_timeout);
+
+    auto const next = next_event();
+    if (next < m_programmed) {
+      program(next, now);
+    }
+  }
+
+  /**
+   * @brief Cancel a scheduled timeout
+   *
+   * Does nothing if the timeout is not scheduled. The hardware timer is left
+   * running and simply finds nothing to do if this was the next deadline.
+   *
+   * @param p_timeout - timeout to cancel
+   */
+  void cancel(wheel_timeout& p_timeout)
+  {
+    if (not p_timeout.scheduled()) {
+      return;
+    }
+    auto& slot = m_slots[p_timeout.m_level][p_timeout.m_slot];
+    p_timeout.unlink();
+    if (slot.empty()) {
+      m_occupied[p_timeout.m_level] &= ~(u64{ 1 } << p_timeout.m_slot);
+    }
+  }
+
+  /**
+   * @brief Call the handlers of every timeout that has expired
+   *
+   * Does nothing unless the hardware timer has fired since the last call. Must
+   * not be called from interrupt context.
+   *
+   * @return usize - number of handlers called
+   */
+  usize poll()
+  {
+    if (not m_due.exchange(false, std::memory_order_acquire)) {
+      return 0;
+    }
+    m_programmed = never;
+
+    auto const now = current_tick();
+    usize called = 0;
+
+    while (true) {
+      auto const event = next_event();
+      if (event > now) {
+        break;
+      }
+      m_now = event;
+      cascade();
+      called += expire();
+    }
+    m_now = now;
+
+    auto const next = next_event();
+    if (next != never) {
+      program(next, now);
+    }
+    return called;
+  }
+
+  /**
+   * @brief Determine if any timeouts are scheduled
+   *
+   * @return true - if no timeouts are scheduled
+   */
+  [[nodiscard]] bool empty() const
+  {
+    for (auto const occupied : m_occupied) {
+      if (occupied != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  static constexpr u32 slot_bits = 6;
+  static constexpr u64 slot_mask = slots - 1;
+  static constexpr u64 never = std::numeric_limits<u64>::max();
+
+  [[nodiscard]] u64 resolution_ns() const
+  {
+    return static_cast<u64>(m_resolution.count());
+  }
+
+  [[nodiscard]] u64 current_tick()
+  {
+    return m_clock.now_ns() / resolution_ns();
+  }
+
+  /**
+   * @brief Link a timeout into the slot for its expiry
+   *
+   * The level is the highest group of 6 bits in which the expiry differs from
+   * the current tick, so every timeout in level `n` becomes due within the
+   * current turn of level `n + 1`.
+   */
+  void insert(wheel_timeout& p_timeout)
+  {
+    auto const differing = std::bit_width(p_timeout.m_expiry ^ m_now);
+    auto const level = differing == 0 ? 0 : (differing - 1) / slot_bits;
+    auto const slot = (p_timeout.m_expiry >> (level * slot_bits)) & slot_mask;
+
+    p_timeout.m_level = static_cast<u8>(level);
+    p_timeout.m_slot = static_cast<u8>(slot);
+    p_timeout.link_before(m_slots[level][slot]);
+    m_occupied[level] |= u64{ 1 } << slot;
+  }
+
+  /**
+   * @brief Find the tick of the next expiry or cascade
+   *
+   * Occupied slots are always ahead of the current tick within their level.
+   */
+  [[nodiscard]] u64 next_event() const
+  {
+    u64 result = never;
+    for (usize level = 0; level < Levels; level++) {
+      if (m_occupied[level] == 0) {
+        continue;
+      }
+      auto const shift = level * slot_bits;
+      auto const slot = static_cast<u64>(std::countr_zero(m_occupied[level]));
+      auto const turn = m_now >> (shift + slot_bits) << (shift + slot_bits);
+      result = std::min(result, turn | (slot << shift));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Move the timeouts of higher level slots reached by the current tick
+   * down a level
+   *
+   */
+  void cascade()
+  {
+    for (usize level = Levels - 1; level > 0; level--) {
+      auto const shift = level * slot_bits;
+      if ((m_now & ((u64{ 1 } << shift) - 1)) != 0) {
+        continue;
+      }
+      auto const slot = (m_now >> shift) & slot_mask;
+      if ((m_occupied[level] & (u64{ 1 } << slot)) == 0) {
+        continue;
+      }
+      m_occupied[level] &= ~(u64{ 1 } << slot);
+      auto& head = m_slots[level][slot];
+      while (not head.empty()) {
+        auto& timeout = to_timeout(*head.m_next);
+        timeout.unlink();
+        insert(timeout);
+      }
+    }
+  }
+
+  usize expire()
+  {
+    auto const slot = m_now & slot_mask;
+    if ((m_occupied[0] & (u64{ 1 } << slot)) == 0) {
+      return 0;
+    }
+    m_occupied[0] &= ~(u64{ 1 } << slot);
+
+    // Move the slot's timeouts to a local list, so handlers can reschedule or
+    // cancel any timeout while the list is walked.
+    detail::wheel_link expired;
+    expired.make_empty();
+    auto& head = m_slots[0][slot];
+    while (not head.empty()) {
+      auto* const timeout = head.m_next;
+      timeout->unlink();
+      timeout->link_before(expired);
+    }
+
+    usize called = 0;
+    while (not expired.empty()) {
+      auto& timeout = to_timeout(*expired.m_next);
+      timeout.unlink();
+      timeout.m_handler();
+      called++;
+    }
+    return called;
+  }
+
+  [[nodiscard]] static wheel_timeout& to_timeout(detail::wheel_link& p_link)
+  {
+    return static_cast<wheel_timeout&>(p_link);
+  }
+
+  void program(u64 p_event, u64 p_now)
+  {
+    auto const ticks = p_event > p_now ? p_event - p_now : 1;
+    m_programmed = p_event;
+    m_timer->schedule(
+      [this]() { m_due.store(true, std::memory_order_release); },
+      hal::time_duration(static_cast<i64>(ticks * resolution_ns())));
+  }
+
+  hal::timer* m_timer;
+  nanosecond_clock<> m_clock;
+  hal::time_duration m_resolution;
+  std::array<std::array<detail::wheel_link, slots>, Levels> m_slots{};
+  std::array<u64, Levels> m_occupied{};
+  u64 m_now = 0;
+  u64 m_programmed = never;
+  std::atomic<bool> m_due = false;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::timer_wheel;
+using v5::wheel_timeout;
+}  // namespace hal
@@ -0,0 +1,320 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+
+#include "error.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Allocation counters of a tag of a tracking_resource
+ *
+ */
+struct allocation_statistics
+{
+  /// Name of the tag, empty for the totals of a resource
+  std::string_view tag{};
+  /// Bytes currently allocated
+  usize bytes_in_use = 0;
+  /// Largest number of bytes that have been allocated at the same time
+  usize peak_bytes = 0;
+  /// Number of successful allocations
+  usize allocations = 0;
+  /// Number of deallocations
+  usize deallocations = 0;
+  /// Number of allocations that the upstream resource failed
+  usize failures = 0;
+
+  /**
+   * @brief Get the number of allocations not yet deallocated
+   *
+   * @return usize - live allocations
+   */
+  [[nodiscard]] constexpr usize live() const
+  {
+    return allocations - deallocations;
+  }
+
+  /**
+   * @brief Determine if memory remains allocated
+   *
+   * Call once every object allocated with the tag should have been destroyed,
+   * for example after a test or at the end of a mode of operation.
+   *
+   * @return true - if an allocation has not been deallocated
+   */
+  [[nodiscard]] constexpr bool leaked() const
+  {
+    return live() != 0 || bytes_in_use != 0;
+  }
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(allocation_statistics const&) const = default;
+};
+
+/**
+ * @brief Copy of the statistics of every tag of a tracking_resource
+ *
+ * @tparam MaxTags - number of tags the resource can hold
+ */
+template<usize MaxTags>
+struct allocation_snapshot
+{
+  /// Sum of every tag, with the peak of their combined use
+  allocation_statistics total{};
+  /// Statistics of each tag, in the order the tags were created
+  std::array<allocation_statistics, MaxTags> tags{};
+  /// Number of tags created
+  usize tag_count = 0;
+
+  /**
+   * @brief Get the statistics of the tags that were created
+   *
+   * @return std::span<allocation_statistics const> - one entry per tag
+   */
+  [[nodiscard]] constexpr std::span<allocation_statistics const> used() const
+  {
+    return std::span(tags).first(tag_count);
+  }
+};
+
+/**
+ * @brief Memory resource decorator that accounts allocations by tag
+ *
+ * `hal::circular_buffer`, `hal::allocated_buffer`, `hal::make_strong_ptr` and
+ * the other allocator aware containers take a `std::pmr::polymorphic_allocator`
+ * without recording who uses how much memory. A tracking resource hands out
+ * one memory resource per tag, typically per driver or subsystem, that
+ * forwards to an upstream resource and counts the bytes and allocations made
+ * through it. `snapshot()` then reports the current and peak use of every
+ * tag, and of all of them together, so heap and arena reservations can be
+ * sized from measurements, and `leaked()` reports tags with memory still
+ * allocated.
+ *
+ * The counters live in the object, so a tracking resource declared `static`
+ * allocates nothing itself. Tags are claimed on first use and are never
+ * released.
+ *
+ * This resource is not thread safe.
+ *
+ * Example usage:
+ *
+ * ```
+ * static hal::tracking_resource<8> memory(arena);
+ *
+ * hal::circular_buffer<hal::can_message> rx(&memory.tag("can"), 64);
+ * auto console = hal::make_strong_ptr<my_uart>(&memory.tag("uart"), ...);
+ * // ...
+ * for (auto const& stats : memory.snapshot().used()) {
+ *   hal::print<64>(*serial, "%.*s: %u bytes peak\n",
+ *                  static_cast<int>(stats.tag.size()), stats.tag.data(),
+ *                  static_cast<unsigned>(stats.peak_bytes));
+ * }
+ * ```
+ *
+ * @tparam MaxTags - maximum number of tags
+ */
+template<usize MaxTags>
+class tracking_resource
+{
+public:
+  static_assert(MaxTags > 0, "A tracking resource needs at least one tag");
+
+  /**
+   * @brief Memory resource of a single tag
+   *
+   * Obtained with `tracking_resource::tag()`.
+   */
+  class tag_resource : public std::pmr::memory_resource
+  {
+  public:
+    tag_resource() = default;
+    tag_resource(tag_resource const&) = delete;
+    tag_resource& operator=(tag_resource const&) = delete;
+    tag_resource(tag_resource&&) = delete;
+    tag_resource& operator=(tag_resource&&) = delete;
+    ~tag_resource() override = default;
+
+    /**
+     * @brief Get the counters of this tag
+     *
+     * @return allocation_statistics const& - counters of the tag
+     */
+    [[nodiscard]] allocation_statistics const& statistics() const
+    {
+      return m_statistics;
+    }
+
+  private:
+    friend class tracking_resource;
+
+    void* do_allocate(usize p_bytes, usize p_alignment) override
+    {
+      void* memory = nullptr;
+      try {
+        memory = m_owner->m_upstream->allocate(p_bytes, p_alignment);
+      } catch (...) {
+        m_statistics.failures++;
+        m_owner->m_total.failures++;
+        throw;
+      }
+      record_allocation(m_statistics, p_bytes);
+      record_allocation(m_owner->m_total, p_bytes);
+      return memory;
+    }
+
+    void do_deallocate(void* p_address,
+                       usize p_bytes,
+                       usize p_alignment) override
+    {
+      m_owner->m_upstream->deallocate(p_address, p_bytes, p_alignment);
+      record_deallocation(m_statistics, p_bytes);
+      record_deallocation(m_owner->m_total, p_bytes);
+    }
+
+    [[nodiscard]] bool do_is_equal(
+      std::pmr::memory_resource const& p_other) const noexcept override
+    {
+      return this == &p_other;
+    }
+
+    static void record_allocation(allocation_statistics& p_statistics,
+                                  usize p_bytes)
+    {
+      p_statistics.allocations++;
+      p_statistics.bytes_in_use += p_bytes;
+      p_statistics.peak_bytes =
+        std::max(p_statistics.peak_bytes, p_statistics.bytes_in_use);
+    }
+
+    static void record_deallocation(allocation_statistics& p_statistics,
+                                    usize p_bytes)
+    {
+      p_statistics.deallocations++;
+      p_statistics.bytes_in_use -= std::min(p_bytes, p_statistics.bytes_in_use);
+    }
+
+    tracking_resource* m_owner = nullptr;
+    allocation_statistics m_statistics{};
+  };
+
+  /**
+   * @brief Construct a tracking resource without any tags
+   *
+   * @param p_upstream - resource every tag allocates from. Must outlive this
+   * object and every object allocated through its tags.
+   */
+  explicit tracking_resource(std::pmr::memory_resource& p_upstream)
+    : m_upstream(&p_upstream)
+  {
+    for (auto& tag : m_tags) {
+      tag.m_owner = this;
+    }
+  }
+
+  tracking_resource(tracking_resource const&) = delete;
+  tracking_resource& operator=(tracking_resource const&) = delete;
+  tracking_resource(tracking_resource&&) = delete;
+  tracking_resource& operator=(tracking_resource&&) = delete;
+  ~tracking_resource() = default;
+
+  /**
+   * @brief Get the memory resource of a tag, creating the tag on first use
+   *
+   * Lookup compares p_name against every existing tag, so call this once per
+   * call site, when constructing a container or driver, rather than for
+   * every allocation.
+   *
+   * @param p_name - name of the tag, such as the driver using the memory.
+   * Must outlive this object, for example a string literal.
+   * @return tag_resource& - resource recording into the tag's counters
+   * @throws hal::out_of_range - if p_name is new and `MaxTags` tags already
+   * exist
+   */
+  [[nodiscard]] tag_resource& tag(std::string_view p_name)
+  {
+    for (usize i = 0; i < m_tag_count; i++) {
+      if (m_tags[i].m_statistics.tag == p_name) {
+        return m_tags[i];
+      }
+    }
+    if (m_tag_count == MaxTags) {
+      hal::safe_throw(hal::out_of_range(
+        this, { .m_index = m_tag_count, .m_capacity = MaxTags }));
+    }
+    auto& created = m_tags[m_tag_count++];
+    created.m_statistics.tag = p_name;
+    return created;
+  }
+
+  /**
+   * @brief Copy the counters of every tag
+   *
+   * @return allocation_snapshot<MaxTags> - counters at the time of the call
+   */
+  [[nodiscard]] allocation_snapshot<MaxTags> snapshot() const
+  {
+    allocation_snapshot<MaxTags> result{ .total = m_total,
+                                         .tag_count = m_tag_count };
+    for (usize i = 0; i < m_tag_count; i++) {
+      result.tags[i] = m_tags[i].m_statistics;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Get the counters of every tag combined
+   *
+   * @return allocation_statistics const& - totals, with the peak of the
+   * combined use of the tags
+   */
+  [[nodiscard]] allocation_statistics const& total() const
+  {
+    return m_total;
+  }
+
+  /**
+   * @brief Determine if any tag has memory still allocated
+   *
+   * @return true - if an allocation made through any tag has not been
+   * deallocated
+   */
+  [[nodiscard]] bool leaked() const
+  {
+    return m_total.leaked();
+  }
+
+private:
+  std::pmr::memory_resource* m_upstream;
+  std::array<tag_resource, MaxTags> m_tags{};
+  allocation_statistics m_total{};
+  usize m_tag_count = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::allocation_snapshot;
+using v5::allocation_statistics;
+using v5::tracking_resource;
+}  // namespace hal
@@ -0,0 +1,723 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <span>
+#include <system_error>
+
+#include "adc.hpp"
+#include "can.hpp"
+#include "error.hpp"
+#include "functional.hpp"
+#include "i2c.hpp"
+#include "simulation.hpp"
+#include "steady_clock.hpp"
+#include "units.hpp"
+
+/**
+ * @file traffic_log.hpp
+ * @brief Capture and replay of driver traffic
+ *
+ * A `hal::traffic_recorder` encodes i2c transactions, CAN messages, serial
+ * bytes and ADC samples, each stamped with the tick of a steady clock, into a
+ * compact binary log streamed to a sink, such as a serial port or a USB
+ * endpoint. On the host, `hal::traffic_reader` decodes the log,
+ * `hal::replay_i2c` serves the recorded transactions back to drivers in order,
+ * and `hal::traffic_player` runs the records on a `hal::sim::event_loop` at
+ * their recorded times, so field traffic can be reproduced and benchmarked
+ * against.
+ *
+ * The log starts with a header of the magic bytes `halt`, a version byte and
+ * the clock frequency in hertz as an unsigned LEB128 number. Every record then
+ * starts with its kind byte and the ticks since the previous record, followed
+ * by its fields. Numbers are unsigned LEB128 and data bytes are copied as is,
+ * so a typical record costs a few bytes beyond its data.
+ *
+ * | kind   | fields                                                       |
+ * | ------ | ------------------------------------------------------------ |
+ * | i2c    | address byte, errc, write length, written, read length, read |
+ * | can    | id, flags byte, length byte, payload                         |
+ * | serial | channel, length, bytes                                       |
+ * | adc    | channel, sample                                              |
+ */
+
+namespace hal::v5 {
+/// Kind of a record in a traffic log
+enum class traffic_kind : u8
+{
+  i2c = 1,
+  can = 2,
+  serial = 3,
+  adc = 4,
+};
+
+/**
+ * @brief Decoded record of a traffic log
+ *
+ * Spans point into the log and are valid as long as the log's memory is.
+ */
+struct traffic_record
+{
+  /// Time of the record since the start of the capture
+  time_duration time{};
+  /// Kind of traffic recorded
+  traffic_kind kind{};
+  /// i2c address, serial channel or adc channel of the record
+  u32 channel = 0;
+  /// i2c: result of the transaction
+  std::errc status{};
+  /// i2c: bytes written. serial: bytes transferred.
+  std::span<hal::byte const> data_out{};
+  /// i2c: bytes read, empty if the transaction failed
+  std::span<hal::byte const> data_in{};
+  /// can: message transferred
+  can_message message{};
+  /// adc: raw sample
+  u32 sample = 0;
+};
+
+/**
+ * @brief Encodes driver traffic into a binary log
+ *
+ * Each record is passed to the sink as one or more spans as soon as it is
+ * encoded. The fields of a record are staged in a small buffer and the data
+ * bytes are passed from the caller's memory, so the recorder allocates
+ * nothing and copies data only once, in the sink.
+ *
+ * The recorder is not reentrant: records must not be made from an interrupt
+ * while another record is being made.
+ */
+class traffic_recorder
+{
+public:
+  /// Receives the bytes of the log in order
+  using sink = hal::callback<void(std::span<hal::byte const>)>;
+
+  /// Version of the log format written
+  static constexpr u8 version = 1;
+
+  /// Magic bytes starting every log
+  static constexpr std::array<hal::byte, 4> magic{ 'h', 'a', 'l', 't' };
+
+  /**
+   * @brief Start a capture, writing the log header to the sink
+   *
+   * @param p_clock - clock stamping the records. Must outlive this object.
+   * @param p_sink - destination of the log
+   */
+  traffic_recorder(hal::steady_clock& p_clock, sink p_sink)
+    : m_clock(&p_clock)
+    , m_sink(p_sink)
+    , m_last_tick(p_clock.uptime())
+  {
+    std::ranges::copy(magic, m_staging.begin());
+    m_length = magic.size();
+    put(version);
+    put_number(static_cast<u64>(p_clock.frequency()));
+    flush();
+  }
+
+  traffic_recorder(traffic_recorder const&) = delete;
+  traffic_recorder& operator=(traffic_recorder const&) = delete;
+  traffic_recorder(traffic_recorder&&) = delete;
+  traffic_recorder& operator=(traffic_recorder&&) = delete;
+  ~traffic_recorder() = default;
+
+  /**
+   * @brief Record an i2c transaction
+   *
+   * @param p_address - address of the transaction
+   * @param p_data_out - bytes written
+   * @param p_data_in - bytes read. Ignored if p_status is an error.
+   * @param p_status - result of the transaction
+   */
+  void record_i2c(hal::byte p_address,
+                  std::span<hal::byte const> p_data_out,
+                  std::span<hal::byte const> p_data_in,
+                  std::errc p_status = {})
+  {
+    if (p_status != std::errc{}) {
+      p_data_in = {};
+    }
+    start(traffic_kind::i2c);
+    put(p_address);
+    put_number(static_cast<u64>(p_status));
+    put_data(p_data_out);
+    put_data(p_data_in);
+    finish();
+  }
+
+  /**
+   * @brief Record a CAN message
+   *
+   * @param p_message - message sent or received
+   */
+  void record_can(can_message const& p_message)
+  {
+    auto const length = std::min<u8>(p_message.length, 8);
+    start(traffic_kind::can);
+    put_number(p_message.id);
+    put(static_cast<hal::byte>((p_message.extended ? 1 : 0) |
+                               (p_message.remote_request ? 2 : 0)));
+    put(length);
+    if (not p_message.remote_request) {
+      for (auto const data : std::span(p_message.payload).first(length)) {
+        put(data);
+      }
+    }
+    finish();
+  }
+
+  /**
+   * @brief Record bytes sent or received over a serial port
+   *
+   * @param p_channel - identifies the port and direction, as chosen by the
+   * application
+   * @param p_data - bytes transferred
+   */
+  void record_serial(u32 p_channel, std::span<hal::byte const> p_data)
+  {
+    start(traffic_kind::serial);
+    put_number(p_channel);
+    put_data(p_data);
+    finish();
+  }
+
+  /**
+   * @brief Record an ADC sample
+   *
+   * @param p_channel - identifies the ADC, as chosen by the application
+   * @param p_sample - raw sample
+   */
+  void record_adc(u32 p_channel, u32 p_sample)
+  {
+    start(traffic_kind::adc);
+    put_number(p_channel);
+    put_number(p_sample);
+    finish();
+  }
+
+  /**
+   * @return u64 - number of records made
+   */
+  [[nodiscard]] u64 records() const
+  {
+    return m_records;
+  }
+
+  /**
+   * @return u64 - number of log bytes passed to the sink, including the
+   * header
+   */
+  [[nodiscard]] u64 bytes() const
+  {
+    return m_bytes;
+  }
+
+private:
+  void start(traffic_kind p_kind)
+  {
+    auto const tick = m_clock->uptime();
+    put(static_cast<hal::byte>(p_kind));
+    put_number(tick - m_last_tick);
+    m_last_tick = tick;
+  }
+
+  void finish()
+  {
+    flush();
+    m_records++;
+  }
+
+  void put(hal::byte p_byte)
+  {
+    m_staging[m_length++] = p_byte;
+  }
+
+  void put_number(u64 p_value)
+  {
+    while (p_value >= 0x80) {
+      put(static_cast<hal::byte>(p_value | 0x80));
+      p_value >>= 7;
+    }
+    put(static_cast<hal::byte>(p_value));
+  }
+
+  void put_data(std::span<hal::byte const> p_data)
+  {
+    put_number(p_data.size());
+    // Leaves room for the length of a following data field
+    if (p_data.size() + max_number_size <= m_staging.size() - m_length) {
+      std::ranges::copy(p_data, m_staging.begin() + m_length);
+      m_length += p_data.size();
+      return;
+    }
+    flush();
+    m_sink(p_data);
+    m_bytes += p_data.size();
+  }
+
+  void flush()
+  {
+    if (m_length != 0) {
+      m_sink(std::span(m_staging).first(m_length));
+      m_bytes += m_length;
+      m_length = 0;
+    }
+  }
+
+  /// Bytes of the longest LEB128 encoded u64
+  static constexpr usize max_number_size = 10;
+
+  hal::steady_clock* m_clock;
+  sink m_sink;
+  u64 m_last_tick;
+  u64 m_records = 0;
+  u64 m_bytes = 0;
+  usize m_length = 0;
+  // Fits the fields of any record with room for short data
+  std::array<hal::byte, 64> m_staging{};
+};
+
+/**
+ * @brief Decodes the records of a traffic log
+ *
+ */
+class traffic_reader
+{
+public:
+  /**
+   * @brief Read the header of a log
+   *
+   * @param p_log - complete log. Must outlive the records read from it.
+   * @throws hal::argument_out_of_domain - if p_log does not start with a log
+   * header of a supported version
+   */
+  explicit traffic_reader(std::span<hal::byte const> p_log)
+    : m_log(p_log)
+  {
+    if (m_log.size() < traffic_recorder::magic.size() + 1 ||
+        not std::ranges::equal(m_log.first(traffic_recorder::magic.size()),
+                               traffic_recorder::magic) ||
+        m_log[traffic_recorder::magic.size()] != traffic_recorder::version) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_position = traffic_recorder::magic.size() + 1;
+    m_frequency = get_number();
+    if (m_frequency == 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+  }
+
+  /**
+   * @return u64 - frequency of the clock that stamped the records
+   */
+  [[nodiscard]] u64 frequency() const
+  {
+    return m_frequency;
+  }
+
+  /**
+   * @brief Decode the next record
+   *
+   * @return std::optional<traffic_record> - the record, or std::nullopt at the
+   * end of the log
+   * @throws hal::argument_out_of_domain - if the log is truncated or corrupt
+   */
+  std::optional<traffic_record> next()
+  {
+    if (m_position == m_log.size()) {
+      return std::nullopt;
+    }
+
+    traffic_record record{};
+    record.kind = static_cast<traffic_kind>(get());
+    m_ticks += get_number();
+    record.time = to_duration(m_ticks);
+
+    switch (record.kind) {
+      case traffic_kind::i2c:
+        record.channel = get();
+        record.status = static_cast<std::errc>(get_number());
+        record.data_out = get_data();
+        record.data_in = get_data();
+        break;
+      case traffic_kind::can: {
+        record.message.id = static_cast<u32>(get_number());
+        auto const flags = get();
+        record.message.extended = (flags & 1) != 0;
+        record.message.remote_request = (flags & 2) != 0;
+        record.message.length = get();
+        if (record.message.length > 8) {
+          hal::safe_throw(hal::argument_out_of_domain(this));
+        }
+        if (not record.message.remote_request) {
+          for (auto& data :
+               std::span(record.message.payload).first(record.message.length)) {
+            data = get();
+          }
+        }
+        break;
+      }
+      case traffic_kind::serial:
+        record.channel = static_cast<u32>(get_number());
+        record.data_out = get_data();
+        break;
+      case traffic_kind::adc:
+        record.channel = static_cast<u32>(get_number());
+        record.sample = static_cast<u32>(get_number());
+        break;
+      default:
+        hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    return record;
+  }
+
+private:
+  [[nodiscard]] time_duration to_duration(u64 p_ticks) const
+  {
+    constexpr u64 nanoseconds_per_second = 1'000'000'000;
+    auto const seconds = p_ticks / m_frequency;
+    auto const remainder = p_ticks % m_frequency;
+    return time_duration(static_cast<time_duration::rep>(
+      seconds * nanoseconds_per_second +
+      remainder * nanoseconds_per_second / m_frequency));
+  }
+
+  hal::byte get()
+  {
+    if (m_position == m_log.size()) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    return m_log[m_position++];
+  }
+
+  u64 get_number()
+  {
+    u64 result = 0;
+    for (u32 shift = 0; shift < 64; shift += 7) {
+      auto const data = get();
+      result |= static_cast<u64>(data & 0x7F) << shift;
+      if ((data & 0x80) == 0) {
+        return result;
+      }
+    }
+    hal::safe_throw(hal::argument_out_of_domain(this));
+  }
+
+  std::span<hal::byte const> get_data()
+  {
+    auto const length = get_number();
+    if (length > m_log.size() - m_position) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    auto const data = m_log.subspan(m_position, length);
+    m_position += length;
+    return data;
+  }
+
+  std::span<hal::byte const> m_log;
+  usize m_position = 0;
+  u64 m_frequency = 0;
+  u64 m_ticks = 0;
+};
+
+/**
+ * @brief i2c that records every transaction of another i2c
+ *
+ * Transactions are forwarded to the wrapped i2c, then recorded with their
+ * result. Errors are recorded then rethrown.
+ */
+class recording_i2c : public hal::i2c
+{
+public:
+  /**
+   * @param p_i2c - i2c to forward to. Must outlive this object.
+   * @param p_recorder - recorder of the transactions. Must outlive this
+   * object.
+   */
+  recording_i2c(hal::i2c& p_i2c, traffic_recorder& p_recorder)
+    : m_i2c(&p_i2c)
+    , m_recorder(&p_recorder)
+  {
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_i2c->configure(p_settings);
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in) override
+  {
+    try {
+      m_i2c->transaction(p_address, p_data_out, p_data_in);
+    } catch (hal::exception const& p_error) {
+      m_recorder->record_i2c(
+        p_address, p_data_out, p_data_in, p_error.error_code());
+      throw;
+    }
+    m_recorder->record_i2c(p_address, p_data_out, p_data_in);
+  }
+
+  void driver_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in,
+    hal::function_ref<hal::timeout_function> p_timeout) override
+  {
+    try {
+      m_i2c->transaction(p_address, p_data_out, p_data_in, p_timeout);
+    } catch (hal::exception const& p_error) {
+      m_recorder->record_i2c(
+        p_address, p_data_out, p_data_in, p_error.error_code());
+      throw;
+    }
+    m_recorder->record_i2c(p_address, p_data_out, p_data_in);
+  }
+
+  hal::i2c* m_i2c;
+  traffic_recorder* m_recorder;
+};
+
+/**
+ * @brief adc16 that records every sample of another adc16
+ *
+ */
+class recording_adc16 : public hal::adc16
+{
+public:
+  /**
+   * @param p_adc - adc to forward to. Must outlive this object.
+   * @param p_recorder - recorder of the samples. Must outlive this object.
+   * @param p_channel - channel the samples are recorded under
+   */
+  recording_adc16(hal::adc16& p_adc,
+                  traffic_recorder& p_recorder,
+                  u32 p_channel)
+    : m_adc(&p_adc)
+    , m_recorder(&p_recorder)
+    , m_channel(p_channel)
+  {
+  }
+
+private:
+  u16 driver_read() override
+  {
+    auto const sample = m_adc->read();
+    m_recorder->record_adc(m_channel, sample);
+    return sample;
+  }
+
+  hal::adc16* m_adc;
+  traffic_recorder* m_recorder;
+  u32 m_channel;
+};
+
+/**
+ * @brief i2c serving the i2c transactions of a traffic log in order
+ *
+ * Each transaction takes the next i2c record of the log, fills the read bytes
+ * from it and throws the recorded error, if any. Records of other kinds are
+ * skipped.
+ */
+class replay_i2c : public hal::i2c
+{
+public:
+  /**
+   * @param p_log - complete log. Must outlive this object.
+   * @throws hal::argument_out_of_domain - if p_log has no valid header
+   */
+  explicit replay_i2c(std::span<hal::byte const> p_log)
+    : m_reader(p_log)
+  {
+  }
+
+  /**
+   * @return u64 - number of transactions served
+   */
+  [[nodiscard]] u64 transactions() const
+  {
+    return m_transactions;
+  }
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in) override
+  {
+    auto record = m_reader.next();
+    while (record && record->kind != traffic_kind::i2c) {
+      record = m_reader.next();
+    }
+    if (not record) {
+      hal::safe_throw(hal::out_of_range(
+        this, { .m_index = m_transactions, .m_capacity = m_transactions }));
+    }
+    // The driver under test must make the transactions that were recorded
+    if (record->channel != p_address ||
+        record->data_out.size() != p_data_out.size() ||
+        (record->status == std::errc{} &&
+         record->data_in.size() != p_data_in.size())) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_transactions++;
+
+    if (record->status == std::errc{}) {
+      std::ranges::copy(record->data_in, p_data_in.begin());
+      return;
+    }
+    switch (record->status) {
+      case std::errc::no_such_device:
+        hal::safe_throw(hal::no_such_device(p_address, this));
+      case std::errc::timed_out:
+        hal::safe_throw(hal::timed_out(this));
+      case std::errc::resource_unavailable_try_again:
+        hal::safe_throw(hal::resource_unavailable_try_again(this));
+      default:
+        hal::safe_throw(hal::io_error(this));
+    }
+  }
+
+  void driver_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in,
+    hal::function_ref<hal::timeout_function>) override
+  {
+    driver_transaction(p_address, p_data_out, p_data_in);
+  }
+
+  traffic_reader m_reader;
+  u64 m_transactions = 0;
+};
+
+/**
+ * @brief Runs the records of a traffic log on a simulation at their times
+ *
+ * Records are passed to a handler from events of the event loop, at the time
+ * they were recorded at relative to the start of playback. The handler routes
+ * them to the simulation, for example by sending CAN messages from a
+ * `hal::sim::can_node` or writing serial bytes from a
+ * `hal::sim::serial_port`. Only the next record is scheduled at any time, so
+ * logs of any length play without allocating.
+ */
+class traffic_player
+{
+public:
+  /// Receives each record at its time
+  using handler = hal::callback<void(traffic_record const&)>;
+
+  /**
+   * @param p_loop - time base to play on. Must outlive this object.
+   * @param p_log - complete log. Must outlive this object.
+   * @throws hal::argument_out_of_domain - if p_log has no valid header
+   */
+  traffic_player(sim::event_loop& p_loop, std::span<hal::byte const> p_log)
+    : m_loop(&p_loop)
+    , m_reader(p_log)
+  {
+  }
+
+  traffic_player(traffic_player const&) = delete;
+  traffic_player& operator=(traffic_player const&) = delete;
+  traffic_player(traffic_player&&) = delete;
+  traffic_player& operator=(traffic_player&&) = delete;
+  ~traffic_player()
+  {
+    if (m_event) {
+      m_loop->cancel(*m_event);
+    }
+  }
+
+  /**
+   * @brief Start playing the log from the current time of the loop
+   *
+   * Has no effect if already playing.
+   *
+   * @param p_handler - handler of the records
+   */
+  void play(handler p_handler)
+  {
+    if (m_event || m_finished) {
+      return;
+    }
+    m_handler = p_handler;
+    m_start = m_loop->now();
+    schedule_next();
+  }
+
+  /**
+   * @return u64 - number of records played
+   */
+  [[nodiscard]] u64 played() const
+  {
+    return m_played;
+  }
+
+  /**
+   * @return true - if every record of the log has been played
+   */
+  [[nodiscard]] bool finished() const
+  {
+    return m_finished;
+  }
+
+private:
+  void schedule_next()
+  {
+    m_next = m_reader.next();
+    if (not m_next) {
+      m_event.reset();
+      m_finished = true;
+      return;
+    }
+    m_event = m_loop->schedule_at(m_start + m_next->time, [this]() {
+      m_played++;
+      m_handler(*m_next);
+      schedule_next();
+    });
+  }
+
+  sim::event_loop* m_loop;
+  traffic_reader m_reader;
+  handler m_handler{};
+  std::optional<traffic_record> m_next{};
+  std::optional<sim::event_loop::event_id> m_event{};
+  time_duration m_start{};
+  u64 m_played = 0;
+  bool m_finished = false;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::recording_adc16;
+using v5::recording_i2c;
+using v5::replay_i2c;
+using v5::traffic_kind;
+using v5::traffic_player;
+using v5::traffic_reader;
+using v5::traffic_record;
+using v5::traffic_recorder;
+}  // namespace hal
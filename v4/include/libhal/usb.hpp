@@ -360,10 +360,60 @@ public:
     return driver_read(p_buffer);
   }
 
+  /**
+   * @brief Give the endpoint memory to receive packets into ahead of time
+   *
+   * Allows the hardware, usually with DMA, to keep accepting packets from the
+   * HOST without waiting for calls to `read()`. Packets are written back to
+   * back from the start of p_region, continuing across its segments in order,
+   * and the `on_receive` callback is called after each packet. Once fewer than
+   * `info().size` bytes of p_region are left, the endpoint stops and NAKs the
+   * HOST until it is given a new region. `received()` reports how many bytes
+   * have been written so far.
+   *
+   * Calling this replaces the previous region and resets `received()` to 0.
+   * It must only be called before the first packet arrives or once the
+   * endpoint has stopped, so no packet is in flight. Passing an empty scatter
+   * span stops receiving ahead of time.
+   *
+   * Support for this is optional. The default implementation returns false,
+   * in which case data must be fetched with `read()`.
+   *
+   * @param p_region - segments of memory to receive packets into. Must remain
+   * valid until replaced.
+   * @return true - the endpoint will receive packets into p_region
+   * @return false - the endpoint does not support receiving ahead of time
+   */
+  bool receive_into(scatter_span<byte> p_region)
+  {
+    return driver_receive_into(p_region);
+  }
+
+  /**
+   * @brief Get the number of bytes written into the region given to
+   * `receive_into()`
+   *
+   * May be called from the `on_receive` callback.
+   *
+   * @return usize - bytes received into the current region
+   */
+  [[nodiscard]] usize received()
+  {
+    return driver_received();
+  }
+
 private:
   virtual void driver_on_receive(
     callback<void(on_receive_tag)> const& p_callback) = 0;
   virtual usize driver_read(scatter_span<byte> p_buffer) = 0;
+  virtual bool driver_receive_into(scatter_span<byte>)
+  {
+    return false;
+  }
+  virtual usize driver_received()
+  {
+    return 0;
+  }
 };
 
 /**
@@ -0,0 +1,314 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <span>
+
+#include "error.hpp"
+#include "scatter_span.hpp"
+#include "units.hpp"
+#include "usb.hpp"
+
+namespace hal::v5::usb {
+/**
+ * @brief Streams data over a pair of bulk endpoints through a receive ring
+ *
+ * Presents a USB CDC or vendor pipe the way `hal::v5::serial` presents a UART:
+ * data from the HOST is collected into a circular receive buffer supplied by
+ * the application, exposed with `receive_buffer()`, `receive_cursor()` and
+ * `receive_count()`, and read without copying using `read()` or a
+ * `hal::zero_copy_serial_reader`.
+ *
+ * The receive buffer must hold at least two packets. If the OUT endpoint
+ * supports `receive_into()`, the free space of the ring is handed to the
+ * endpoint, so the hardware keeps receiving packets directly into the ring
+ * while the application is busy, and `poll()` only accounts for the bytes that
+ * arrived and hands newly released space back to the endpoint. Otherwise the
+ * `on_receive` callback only marks data as pending, and `poll()` moves it from
+ * the endpoint directly into the free space of the ring, up to two segments at
+ * a time where the free space wraps. Either way, when the ring is full the
+ * endpoint NAKs the HOST until space is available, so data is never dropped.
+ *
+ * Space is returned to the ring by `read()` and `poll()`: each call releases
+ * the data returned by the previous call to `read()`. A
+ * `hal::zero_copy_serial_reader` can also be used with the stream, but does
+ * not release space, so `read()` must still be called once the reader has
+ * consumed the data.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::byte, 512> receive_buffer{};
+ * hal::usb::bulk_stream stream(bulk_in, bulk_out, receive_buffer);
+ *
+ * while (true) {
+ *   stream.poll();
+ *   for (auto const segment : stream.read()) {
+ *     parser.feed(segment);
+ *   }
+ *   stream.write(make_scatter_bytes(response));
+ * }
+ * ```
+ */
+class bulk_stream
+{
+public:
+  /**
+   * @brief Construct a stream over a pair of bulk endpoints
+   *
+   * Registers an `on_receive` callback with the OUT endpoint and, if the
+   * endpoint supports it, hands it the receive buffer with `receive_into()`.
+   *
+   * @param p_in - endpoint to write data to the HOST with. Must outlive this
+   * object.
+   * @param p_out - endpoint to receive data from the HOST with. Must outlive
+   * this object.
+   * @param p_receive_buffer - circular buffer for received data. Must outlive
+   * this object.
+   * @throws hal::argument_out_of_domain - if the receive buffer cannot hold
+   * two packets of the OUT endpoint.
+   */
+  bulk_stream(bulk_in_endpoint& p_in,
+              bulk_out_endpoint& p_out,
+              std::span<hal::byte> p_receive_buffer)
+    : m_in(&p_in)
+    , m_out(&p_out)
+    , m_buffer(p_receive_buffer)
+    , m_packet_size(p_out.info().size)
+  {
+    if (p_receive_buffer.size() < 2 * m_packet_size) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_out->on_receive([this](out_endpoint::on_receive_tag) {
+      m_pending.store(true, std::memory_order_release);
+    });
+    m_queued = queue_region();
+  }
+
+  bulk_stream(bulk_stream const&) = delete;
+  bulk_stream& operator=(bulk_stream const&) = delete;
+  bulk_stream(bulk_stream&&) = delete;
+  bulk_stream& operator=(bulk_stream&&) = delete;
+  ~bulk_stream()
+  {
+    if (m_queued) {
+      m_out->receive_into({});
+    }
+  }
+
+  /**
+   * @brief Add data received by the OUT endpoint to the receive buffer
+   *
+   * Moves pending data from the endpoint into the free space of the receive
+   * buffer, or, if the endpoint receives into the buffer itself, accounts for
+   * the packets it received and hands it any space released since.
+   *
+   * Releases the data returned by the last call to `read()`, so the segments it
+   * returned must no longer be used. Must not be called from the `on_receive`
+   * callback or any other interrupt context.
+   *
+   * @return usize - number of bytes added to the receive buffer
+   */
+  usize poll()
+  {
+    release();
+
+    if (m_queued) {
+      return poll_region();
+    }
+
+    usize moved = 0;
+    while (m_pending.exchange(false, std::memory_order_acquire)) {
+      auto const free = m_buffer.size() - m_filled;
+      if (free == 0) {
+        // Leave the data in the endpoint and try again on the next poll
+        m_pending.store(true, std::memory_order_relaxed);
+        break;
+      }
+
+      auto const til_end = m_buffer.size() - m_cursor;
+      std::array<std::span<hal::byte>, 2> const segments{
+        m_buffer.subspan(m_cursor, std::min(free, til_end)),
+        m_buffer.first(free - std::min(free, til_end)),
+      };
+      auto const count = m_out->read(segments);
+      advance(count);
+      moved += count;
+
+      if (count == free) {
+        // The endpoint may still hold data that did not fit
+        m_pending.store(true, std::memory_order_relaxed);
+        break;
+      }
+    }
+    return moved;
+  }
+
+  /**
+   * @brief Get the data received since the last call to `read()`
+   *
+   * Releases the data returned by the previous call, so the segments it
+   * returned must no longer be used.
+   *
+   * @return scatter_span<hal::byte const> - up to two segments of received
+   * data, oldest first. Empty segments are omitted.
+   */
+  [[nodiscard]] scatter_span<hal::byte const> read()
+  {
+    release();
+    m_released = m_filled;
+
+    auto const size = m_buffer.size();
+    auto const start = (m_cursor + size - m_filled) % size;
+    auto const til_end = size - start;
+
+    if (m_filled == 0) {
+      return {};
+    }
+
+    if (m_filled <= til_end) {
+      m_segments[0] = m_buffer.subspan(start, m_filled);
+      return scatter_span<hal::byte const>(m_segments).first(1);
+    }
+
+    m_segments[0] = m_buffer.subspan(start);
+    m_segments[1] = m_buffer.first(m_filled - til_end);
+    return m_segments;
+  }
+
+  /**
+   * @brief Write data to the HOST
+   *
+   * Writes the data to the IN endpoint and finishes the transfer. Finishing
+   * sends the last, short, packet of the data, or a zero length packet only if
+   * the data ends exactly on a packet boundary. Writing no data sends nothing.
+   *
+   * @param p_data - data to send to the HOST
+   */
+  void write(scatter_span<hal::byte const> p_data)
+  {
+    auto const empty = [](auto const& p_segment) { return p_segment.empty(); };
+    if (std::ranges::all_of(p_data, empty)) {
+      return;
+    }
+    m_in->write(p_data);
+    m_in->write({});
+  }
+
+  /**
+   * @brief Returns the circular receive buffer
+   *
+   * @return std::span<hal::byte const> - the receive buffer
+   */
+  [[nodiscard]] std::span<hal::byte const> receive_buffer() const
+  {
+    return m_buffer;
+  }
+
+  /**
+   * @brief Returns the position where the next received byte will be written
+   *
+   * See `hal::zero_copy_serial::receive_cursor()`.
+   *
+   * @return usize - position of the write cursor within the receive buffer
+   */
+  [[nodiscard]] usize receive_cursor() const
+  {
+    return m_cursor;
+  }
+
+  /**
+   * @brief Returns the total number of bytes received
+   *
+   * See `hal::zero_copy_serial::receive_count()`.
+   *
+   * @return std::optional<usize> - running count of received bytes
+   */
+  [[nodiscard]] std::optional<usize> receive_count() const
+  {
+    return m_count;
+  }
+
+private:
+  void release()
+  {
+    m_filled -= m_released;
+    m_released = 0;
+  }
+
+  void advance(usize p_count)
+  {
+    m_cursor = (m_cursor + p_count) % m_buffer.size();
+    m_filled += p_count;
+    m_count += p_count;
+  }
+
+  /// Hand the free space of the ring, starting at the cursor, to the endpoint
+  bool queue_region()
+  {
+    auto const free = m_buffer.size() - m_filled;
+    auto const til_end = std::min(free, m_buffer.size() - m_cursor);
+    m_region = {
+      m_buffer.subspan(m_cursor, til_end),
+      m_buffer.first(free - til_end),
+    };
+    m_region_size = free;
+    m_region_taken = 0;
+    return m_out->receive_into(m_region);
+  }
+
+  usize poll_region()
+  {
+    auto const written = m_out->received();
+    auto const count = written - m_region_taken;
+    m_region_taken = written;
+    advance(count);
+
+    if (m_region_size - written < m_packet_size) {
+      // The endpoint has stopped, so it is safe to hand it the released space
+      queue_region();
+    }
+    return count;
+  }
+
+  bulk_in_endpoint* m_in;
+  bulk_out_endpoint* m_out;
+  std::span<hal::byte> m_buffer;
+  usize m_packet_size;
+  std::array<std::span<hal::byte const>, 2> m_segments{};
+  /// Free space of the ring handed to the endpoint with receive_into()
+  std::array<std::span<hal::byte>, 2> m_region{};
+  usize m_region_size = 0;
+  /// Bytes of the region already added to the ring
+  usize m_region_taken = 0;
+  /// Position where the next received byte will be written
+  usize m_cursor = 0;
+  /// Number of bytes in the buffer that have not been released
+  usize m_filled = 0;
+  /// Number of bytes returned by the last call to read()
+  usize m_released = 0;
+  usize m_count = 0;
+  std::atomic<bool> m_pending = false;
+  bool m_queued = false;
+};
+}  // namespace hal::v5::usb
+
+namespace hal::usb {
+using v5::usb::bulk_stream;
+}  // namespace hal::usb
@@ -0,0 +1,208 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "error.hpp"
+#include "scatter_span.hpp"
+#include "units.hpp"
+#include "usb.hpp"
+
+namespace hal::v5::usb {
+/**
+ * @brief Writes the data stage of a control transfer in whole packets
+ *
+ * Interfaces respond to requests through an `interface::endpoint_writer`,
+ * often with many small writes, such as one per descriptor field. Forwarding
+ * each of them to `control_endpoint::write()` costs a driver call per write.
+ * This writer gathers small writes into a single packet buffer and writes to
+ * the endpoint once per max packet size.
+ *
+ * Runs of whole packets are passed to the endpoint straight from the caller's
+ * memory. A large response held in memory mapped flash, such as a firmware
+ * image or a vendor specific table, is therefore copied once, from flash into
+ * the endpoint's memory, and never into RAM. Only the bytes before the first
+ * whole packet and after the last whole packet are held in the packet buffer.
+ *
+ * Responses are cut to the wLength of the request, so the host is never sent
+ * more than it asked for. `finish()` ends the data stage: with the short
+ * packet of the remaining bytes, with a zero length packet if the response is
+ * shorter than wLength and ends on a packet boundary, or with nothing more if
+ * exactly wLength bytes were sent.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::usb::control_writer response(control_endpoint, setup.length());
+ * bool const handled = interface.handle_request(setup, response.writer());
+ * response.finish();
+ * ```
+ *
+ * @tparam MaxPacketSize - largest max packet size of the control endpoint
+ * that this writer supports
+ */
+template<usize MaxPacketSize = 64>
+class control_writer
+{
+public:
+  /**
+   * @brief Construct a writer for the data stage of a request
+   *
+   * @param p_endpoint - control endpoint to write to. Must outlive this
+   * object.
+   * @param p_requested_length - wLength of the request being responded to
+   * @throws hal::argument_out_of_domain - if the endpoint's max packet size is
+   * 0 or above `MaxPacketSize`
+   */
+  control_writer(control_endpoint& p_endpoint, u16 p_requested_length)
+    : m_endpoint(&p_endpoint)
+    , m_packet_size(p_endpoint.info().size)
+    , m_remaining(p_requested_length)
+  {
+    if (m_packet_size == 0 || m_packet_size > MaxPacketSize) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+  }
+
+  control_writer(control_writer const&) = delete;
+  control_writer& operator=(control_writer const&) = delete;
+  control_writer(control_writer&&) = delete;
+  control_writer& operator=(control_writer&&) = delete;
+  ~control_writer() = default;
+
+  /**
+   * @brief Append data to the response
+   *
+   * Bytes beyond wLength are dropped.
+   *
+   * @param p_data - data to append. Only needs to stay valid for the duration
+   * of the call.
+   */
+  void write(scatter_span<hal::byte const> p_data)
+  {
+    for (auto segment : p_data) {
+      auto const accepted = std::min<usize>(segment.size(), m_remaining);
+      m_truncated = m_truncated || accepted != segment.size();
+      segment = segment.first(accepted);
+      m_remaining -= accepted;
+      m_written += accepted;
+
+      if (m_fill != 0) {
+        auto const top_up = std::min(segment.size(), m_packet_size - m_fill);
+        std::ranges::copy(segment.first(top_up),
+                          std::span(m_packet).subspan(m_fill).begin());
+        m_fill += top_up;
+        segment = segment.subspan(top_up);
+        if (m_fill != m_packet_size) {
+          continue;
+        }
+        send(std::span(m_packet).first(m_fill));
+        m_fill = 0;
+      }
+
+      auto const whole = segment.size() - segment.size() % m_packet_size;
+      if (whole != 0) {
+        send(segment.first(whole));
+      }
+      auto const rest = segment.subspan(whole);
+      std::ranges::copy(rest, m_packet.begin());
+      m_fill = rest.size();
+    }
+  }
+
+  /**
+   * @brief Get a callable appending to this writer
+   *
+   * @return interface::endpoint_writer - writer to pass to the methods of a
+   * `hal::usb::interface`. Must not outlive this object.
+   */
+  [[nodiscard]] interface::endpoint_writer writer()
+  {
+    return [this](scatter_span<hal::byte const> p_data) { write(p_data); };
+  }
+
+  /**
+   * @brief End the data stage of the transfer
+   *
+   * Has no effect if already called.
+   */
+  void finish()
+  {
+    if (m_finished) {
+      return;
+    }
+    m_finished = true;
+    auto const partial = m_fill != 0;
+    if (partial) {
+      send(std::span(m_packet).first(m_fill));
+      m_fill = 0;
+    }
+    // An empty write sends the short packet, or a zero length packet when
+    // the response ended on a packet boundary before reaching wLength.
+    if (partial || m_remaining != 0) {
+      m_endpoint->write({});
+      m_endpoint_writes++;
+    }
+  }
+
+  /**
+   * @return usize - number of response bytes accepted, at most wLength
+   */
+  [[nodiscard]] usize size() const
+  {
+    return m_written;
+  }
+
+  /**
+   * @return true - if bytes were dropped for exceeding wLength
+   */
+  [[nodiscard]] bool truncated() const
+  {
+    return m_truncated;
+  }
+
+  /**
+   * @return usize - number of calls made to `control_endpoint::write()`
+   */
+  [[nodiscard]] usize endpoint_writes() const
+  {
+    return m_endpoint_writes;
+  }
+
+private:
+  void send(std::span<hal::byte const> p_data)
+  {
+    m_endpoint->write(scatter_span<hal::byte const>(&p_data, 1));
+    m_endpoint_writes++;
+  }
+
+  control_endpoint* m_endpoint;
+  usize m_packet_size;
+  usize m_remaining;
+  usize m_written = 0;
+  usize m_fill = 0;
+  usize m_endpoint_writes = 0;
+  bool m_truncated = false;
+  bool m_finished = false;
+  std::array<hal::byte, MaxPacketSize> m_packet{};
+};
+}  // namespace hal::v5::usb
+
+namespace hal::usb {
+using v5::usb::control_writer;
+}  // namespace hal::usb
@@ -0,0 +1,573 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+
+#include "error.hpp"
+#include "scatter_span.hpp"
+#include "units.hpp"
+#include "usb.hpp"
+
+namespace hal::v5::usb {
+/**
+ * @brief Descriptor type codes from the USB specification
+ *
+ */
+enum class descriptor_type : hal::byte
+{
+  device = 0x01,
+  configuration = 0x02,
+  string = 0x03,
+  interface = 0x04,
+  endpoint = 0x05,
+  interface_association = 0x0B,
+};
+
+/**
+ * @brief Endpoint transfer types, bits [0-1] of bmAttributes
+ *
+ */
+enum class transfer_type : hal::byte
+{
+  control = 0,
+  isochronous = 1,
+  bulk = 2,
+  interrupt = 3,
+};
+
+/**
+ * @brief Fields of a configuration descriptor header
+ *
+ * bNumInterfaces and wTotalLength are computed by the builder.
+ */
+struct configuration_definition
+{
+  /// bConfigurationValue used by SET_CONFIGURATION to select this
+  /// configuration
+  u8 value = 1;
+  /// bmAttributes, bit 7 must be set, bit 6 for self powered, bit 5 for remote
+  /// wakeup
+  u8 attributes = 0x80;
+  /// Maximum current drawn from the bus in milliamps, from 0 to 510
+  u16 max_power_ma = 100;
+  /// Name of the configuration, empty for no string
+  std::u16string_view name{};
+};
+
+/**
+ * @brief Fields of an interface association descriptor
+ *
+ */
+struct interface_association_definition
+{
+  /// Number of consecutive interfaces, starting with the next interface
+  /// added to the builder, that belong to this function
+  u8 interface_count = 1;
+  u8 function_class = 0;
+  u8 function_subclass = 0;
+  u8 function_protocol = 0;
+  /// Name of the function, empty for no string
+  std::u16string_view name{};
+};
+
+/**
+ * @brief Fields of an interface descriptor
+ *
+ * bInterfaceNumber and bNumEndpoints are computed by the builder.
+ */
+struct interface_definition
+{
+  /// Alternate settings other than 0 share the number of the previous
+  /// interface
+  u8 alternate_setting = 0;
+  u8 interface_class = 0;
+  u8 interface_subclass = 0;
+  u8 interface_protocol = 0;
+  /// Name of the interface, empty for no string
+  std::u16string_view name{};
+};
+
+/**
+ * @brief Fields of an endpoint descriptor
+ *
+ */
+struct endpoint_definition
+{
+  /// Endpoint address and max packet size, usually taken from the endpoint's
+  /// `info()`
+  endpoint_info info{};
+  transfer_type type = transfer_type::bulk;
+  /// Polling interval for interrupt and isochronous endpoints
+  u8 interval = 0;
+};
+
+/**
+ * @brief Location of a descriptor field that is offset at runtime
+ *
+ */
+struct descriptor_patch
+{
+  /// Offset of the field within the descriptor bytes
+  u16 offset = 0;
+  /// `true` for a string index, `false` for an interface number
+  bool string = false;
+};
+
+/**
+ * @brief Compile time builder for a stream of USB descriptors
+ *
+ * Assembles configuration, interface association, interface, endpoint and
+ * class specific descriptors into a byte array, along with the UTF-16LE
+ * string descriptors they refer to. Used within a constant expression and
+ * passed to `hal::usb::make_static_descriptors()`, the descriptors are
+ * computed by the compiler and can be placed in flash, so enumeration streams
+ * them directly instead of assembling them at runtime.
+ *
+ * Interface numbers and string indices are assigned starting at 0 and 1
+ * respectively and are offset at runtime by the `descriptor_start` given to
+ * `hal::usb::interface::write_descriptors()`.
+ *
+ * Exceeding any of the capacities is a compile error when used within a
+ * constant expression.
+ *
+ * @tparam Capacity - maximum number of descriptor bytes
+ * @tparam StringCapacity - maximum number of string descriptor bytes
+ * @tparam MaxStrings - maximum number of strings
+ * @tparam MaxPatches - maximum number of interface number and string index
+ * fields
+ */
+template<usize Capacity,
+         usize StringCapacity = 128,
+         usize MaxStrings = 8,
+         usize MaxPatches = 16>
+class descriptor_builder
+{
+public:
+  /**
+   * @brief Add a configuration descriptor header
+   *
+   * Must be the first descriptor added.
+   *
+   * @param p_definition - configuration fields
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& configuration(
+    configuration_definition const& p_definition)
+  {
+    if (m_size != 0) {
+      hal::safe_throw(hal::operation_not_permitted(this));
+    }
+    m_configuration = true;
+    // wTotalLength and bNumInterfaces are written by finish()
+    append({ 9,
+             type(descriptor_type::configuration),
+             0,
+             0,
+             0,
+             p_definition.value });
+    append_string_index(p_definition.name);
+    append({ p_definition.attributes,
+             static_cast<hal::byte>(p_definition.max_power_ma / 2) });
+    return *this;
+  }
+
+  /**
+   * @brief Add an interface association descriptor
+   *
+   * @param p_definition - interface association fields
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& interface_association(
+    interface_association_definition const& p_definition)
+  {
+    append({ 8, type(descriptor_type::interface_association) });
+    append_interface_number(m_interface_count);
+    append({ p_definition.interface_count,
+             p_definition.function_class,
+             p_definition.function_subclass,
+             p_definition.function_protocol });
+    append_string_index(p_definition.name);
+    return *this;
+  }
+
+  /**
+   * @brief Add an interface descriptor
+   *
+   * Endpoints added after this are counted in the interface's bNumEndpoints.
+   *
+   * @param p_definition - interface fields
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& interface(
+    interface_definition const& p_definition)
+  {
+    if (p_definition.alternate_setting == 0) {
+      m_interface_count++;
+    }
+    if (m_interface_count == 0) {
+      hal::safe_throw(hal::operation_not_permitted(this));
+    }
+    append({ 9, type(descriptor_type::interface) });
+    append_interface_number(m_interface_count - 1);
+    append({ p_definition.alternate_setting });
+    m_endpoint_count_offset = m_size;
+    append({ 0,
+             p_definition.interface_class,
+             p_definition.interface_subclass,
+             p_definition.interface_protocol });
+    append_string_index(p_definition.name);
+    return *this;
+  }
+
+  /**
+   * @brief Add an endpoint descriptor to the last interface
+   *
+   * @param p_definition - endpoint fields
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& endpoint(
+    endpoint_definition const& p_definition)
+  {
+    if (m_endpoint_count_offset == 0) {
+      hal::safe_throw(hal::operation_not_permitted(this));
+    }
+    m_data[m_endpoint_count_offset]++;
+    auto const max_packet = setup_packet::to_le_u16(p_definition.info.size);
+    append({ 7,
+             type(descriptor_type::endpoint),
+             p_definition.info.number,
+             static_cast<hal::byte>(p_definition.type),
+             max_packet[0],
+             max_packet[1],
+             p_definition.interval });
+    return *this;
+  }
+
+  /**
+   * @brief Add class specific descriptor bytes as they are
+   *
+   * @param p_bytes - complete descriptors, including their length and type
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& raw(std::span<hal::byte const> p_bytes)
+  {
+    for (auto const byte : p_bytes) {
+      append({ byte });
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Add an interface number field to a class specific descriptor
+   *
+   * For class specific descriptors that refer to other interfaces, such as the
+   * CDC union functional descriptor. Add the rest of the descriptor with
+   * `raw()`.
+   *
+   * @param p_relative - interface number, relative to the first interface in
+   * the builder
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& interface_number(u8 p_relative)
+  {
+    append_interface_number(p_relative);
+    return *this;
+  }
+
+  /**
+   * @brief Complete the descriptors
+   *
+   * Fills in the configuration header, if one was added. Called by
+   * `hal::usb::make_static_descriptors()`.
+   *
+   * @return descriptor_builder& - this builder
+   */
+  constexpr descriptor_builder& finish()
+  {
+    if (m_configuration) {
+      auto const total = setup_packet::to_le_u16(static_cast<u16>(m_size));
+      m_data[2] = total[0];
+      m_data[3] = total[1];
+      m_data[4] = m_interface_count;
+    }
+    return *this;
+  }
+
+  constexpr std::array<hal::byte, Capacity> const& data() const
+  {
+    return m_data;
+  }
+
+  constexpr usize size() const
+  {
+    return m_size;
+  }
+
+  constexpr std::array<hal::byte, StringCapacity> const& string_data() const
+  {
+    return m_strings;
+  }
+
+  constexpr usize string_size() const
+  {
+    return m_string_size;
+  }
+
+  constexpr std::array<u16, MaxStrings> const& string_offsets() const
+  {
+    return m_string_offsets;
+  }
+
+  constexpr u8 string_count() const
+  {
+    return m_string_count;
+  }
+
+  constexpr std::array<descriptor_patch, MaxPatches> const& patches() const
+  {
+    return m_patches;
+  }
+
+  constexpr usize patch_count() const
+  {
+    return m_patch_count;
+  }
+
+  constexpr u8 interface_count() const
+  {
+    return m_interface_count;
+  }
+
+private:
+  static constexpr hal::byte type(descriptor_type p_type)
+  {
+    return static_cast<hal::byte>(p_type);
+  }
+
+  constexpr void append(std::initializer_list<hal::byte> p_bytes)
+  {
+    if (m_size + p_bytes.size() > Capacity) {
+      hal::safe_throw(hal::out_of_range(
+        this, { .m_index = m_size + p_bytes.size(), .m_capacity = Capacity }));
+    }
+    for (auto const byte : p_bytes) {
+      m_data[m_size++] = byte;
+    }
+  }
+
+  constexpr void add_patch(bool p_string)
+  {
+    if (m_patch_count == MaxPatches) {
+      hal::safe_throw(hal::out_of_range(
+        this, { .m_index = m_patch_count, .m_capacity = MaxPatches }));
+    }
+    m_patches[m_patch_count++] = { .offset = static_cast<u16>(m_size),
+                                   .string = p_string };
+  }
+
+  constexpr void append_interface_number(u8 p_relative)
+  {
+    add_patch(false);
+    append({ p_relative });
+  }
+
+  constexpr void append_string_index(std::u16string_view p_string)
+  {
+    if (p_string.empty()) {
+      append({ 0 });
+      return;
+    }
+
+    usize const length = 2 + p_string.size() * 2;
+    if (m_string_count == MaxStrings || length > 0xFF ||
+        m_string_size + length > StringCapacity) {
+      hal::safe_throw(hal::out_of_range(
+        this,
+        { .m_index = m_string_size + length, .m_capacity = StringCapacity }));
+    }
+
+    m_string_offsets[m_string_count++] = static_cast<u16>(m_string_size);
+    m_strings[m_string_size++] = static_cast<hal::byte>(length);
+    m_strings[m_string_size++] = type(descriptor_type::string);
+    for (char16_t const character : p_string) {
+      // UTF-16LE
+      m_strings[m_string_size++] = static_cast<hal::byte>(character & 0xFF);
+      m_strings[m_string_size++] = static_cast<hal::byte>(character >> 8);
+    }
+
+    add_patch(true);
+    append({ m_string_count });
+  }
+
+  std::array<hal::byte, Capacity> m_data{};
+  std::array<hal::byte, StringCapacity> m_strings{};
+  std::array<u16, MaxStrings> m_string_offsets{};
+  std::array<descriptor_patch, MaxPatches> m_patches{};
+  usize m_size = 0;
+  usize m_string_size = 0;
+  usize m_patch_count = 0;
+  /// Offset of bNumEndpoints of the last interface, 0 if there is none
+  usize m_endpoint_count_offset = 0;
+  u8 m_string_count = 0;
+  u8 m_interface_count = 0;
+  bool m_configuration = false;
+};
+
+/**
+ * @brief Descriptors assembled at compile time, sized to fit exactly
+ *
+ * Created by `hal::usb::make_static_descriptors()`. Declare the result
+ * `static constexpr` so it is placed in flash.
+ *
+ * @tparam Size - number of descriptor bytes
+ * @tparam StringSize - number of string descriptor bytes
+ * @tparam Strings - number of strings
+ * @tparam Patches - number of interface number and string index fields
+ */
+template<usize Size, usize StringSize, usize Strings, usize Patches>
+struct static_descriptors
+{
+  /// Descriptor bytes with interface numbers starting at 0 and string
+  /// indices starting at 1
+  std::array<hal::byte, Size> data{};
+  /// String descriptors, one after the other, in UTF-16LE
+  std::array<hal::byte, StringSize> string_data{};
+  /// Offset of each string descriptor within `string_data`
+  std::array<u16, Strings> string_offsets{};
+  /// Fields that are offset by `descriptor_start` when written
+  std::array<descriptor_patch, Patches> patches{};
+  /// Number of interfaces, not counting alternate settings
+  u8 interface_count = 0;
+
+  /**
+   * @brief Write the descriptors over an endpoint writer
+   *
+   * Only the interface number and string index fields are copied, every other
+   * byte is written directly from the array.
+   *
+   * @param p_start - starting interface number and string index. Fields that
+   * are `std::nullopt` are treated as 0 and 1 respectively.
+   * @param p_callback - writer to stream the descriptors to
+   * @return interface::descriptor_count - number of interfaces and strings
+   */
+  interface::descriptor_count write(
+    interface::descriptor_start p_start,
+    interface::endpoint_writer const& p_callback) const
+  {
+    auto const interface_base = p_start.interface.value_or(0);
+    auto const string_base = static_cast<u8>(p_start.string.value_or(1) - 1);
+
+    usize position = 0;
+    for (auto const& patch : patches) {
+      auto const offset = patch.string ? string_base : interface_base;
+      std::array<hal::byte, 1> const field{ static_cast<hal::byte>(
+        data[patch.offset] + offset) };
+      p_callback(make_scatter_bytes(
+        std::span(data).subspan(position, patch.offset - position), field));
+      position = patch.offset + 1;
+    }
+    p_callback(make_scatter_bytes(std::span(data).subspan(position)));
+
+    return { .interface = interface_count, .string = Strings };
+  }
+
+  /**
+   * @brief Write one of the string descriptors
+   *
+   * @param p_index - string index requested by the HOST, from the low byte of a
+   * GET_DESCRIPTOR request's wValue
+   * @param p_string_start - string index that was passed to `write()`
+   * @param p_callback - writer to stream the descriptor to
+   * @return true - the string belongs to these descriptors and was written
+   * @return false - the string does not belong to these descriptors
+   */
+  bool write_string(u8 p_index,
+                    u8 p_string_start,
+                    interface::endpoint_writer const& p_callback) const
+  {
+    if (p_index < p_string_start) {
+      return false;
+    }
+    auto const string = static_cast<usize>(p_index - p_string_start);
+    if (string >= Strings) {
+      return false;
+    }
+    auto const offset = string_offsets[string];
+    auto const length = string_data[offset];
+    auto const descriptor = std::span(string_data).subspan(offset, length);
+    p_callback(make_scatter_bytes(descriptor));
+    return true;
+  }
+};
+
+/**
+ * @brief Build descriptors at compile time
+ *
+ * Example usage:
+ *
+ * ```
+ * static constexpr auto descriptors = hal::usb::make_static_descriptors<[] {
+ *   hal::usb::descriptor_builder<64> builder;
+ *   builder.interface({ .interface_class = 0xFF, .name = u"Vendor Pipe" })
+ *     .endpoint({ .info = { .size = 64, .number = 0x81 } })
+ *     .endpoint({ .info = { .size = 64, .number = 0x01 } });
+ *   return builder;
+ * }>();
+ * ```
+ *
+ * @tparam Build - callable returning a populated descriptor_builder
+ * @return auto - a static_descriptors sized to fit the built descriptors
+ */
+template<auto Build>
+consteval auto make_static_descriptors()
+{
+  constexpr auto builder = Build().finish();
+
+  static_descriptors<builder.size(),
+                     builder.string_size(),
+                     builder.string_count(),
+                     builder.patch_count()>
+    result{};
+  std::copy_n(builder.data().begin(), builder.size(), result.data.begin());
+  std::copy_n(builder.string_data().begin(),
+              builder.string_size(),
+              result.string_data.begin());
+  std::copy_n(builder.string_offsets().begin(),
+              builder.string_count(),
+              result.string_offsets.begin());
+  std::copy_n(
+    builder.patches().begin(), builder.patch_count(), result.patches.begin());
+  result.interface_count = builder.interface_count();
+  return result;
+}
+}  // namespace hal::v5::usb
+
+namespace hal::usb {
+using v5::usb::configuration_definition;
+using v5::usb::descriptor_builder;
+using v5::usb::descriptor_patch;
+using v5::usb::descriptor_type;
+using v5::usb::endpoint_definition;
+using v5::usb::interface_association_definition;
+using v5::usb::interface_definition;
+using v5::usb::make_static_descriptors;
+using v5::usb::static_descriptors;
+using v5::usb::transfer_type;
+}  // namespace hal::usb
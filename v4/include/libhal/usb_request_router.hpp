@@ -0,0 +1,231 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "error.hpp"
+#include "units.hpp"
+#include "usb.hpp"
+
+namespace hal::v5::usb {
+/**
+ * @brief Request counters for a request_router
+ *
+ */
+struct request_router_statistics
+{
+  /// Requests passed to the interface that owns them
+  usize routed = 0;
+  /// Requests whose interface, endpoint or string has no owner, or that were
+  /// not directed at an interface or an endpoint
+  usize unrouted = 0;
+  /// Requests the owning interface returned false for
+  usize unhandled = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(request_router_statistics const&) const = default;
+};
+
+/**
+ * @brief Composite interface that dispatches requests through lookup tables
+ *
+ * Presents several `hal::usb::interface` objects as a single interface. When
+ * the descriptors are written, the router records which interface owns each
+ * interface number and string index. Requests with an interface recipient are
+ * then dispatched using the interface number in the low byte of wIndex, and
+ * requests with an endpoint recipient using the endpoint address in the low
+ * byte of wIndex, so the cost of routing a control request does not grow with
+ * the number of interfaces. Endpoint owners are registered with
+ * `route_endpoint()`.
+ *
+ * No memory is allocated.
+ *
+ * Example usage:
+ *
+ * ```
+ * std::array<hal::usb::interface*, 3> interfaces{ &cdc, &hid, &vendor };
+ * hal::usb::request_router router(interfaces);
+ * router.route_endpoint(hid_in.info().number, hid);
+ * router.route_endpoint(vendor_out.info().number, vendor);
+ * // Hand the router to the enumerator as the device's only interface
+ * ```
+ *
+ * @tparam MaxInterfaces - maximum number of interface numbers
+ * @tparam MaxStrings - maximum number of string indices
+ */
+template<usize MaxInterfaces = 8, usize MaxStrings = 16>
+class request_router : public interface
+{
+public:
+  /// Number of endpoint addresses, 16 endpoint numbers in each direction
+  static constexpr usize endpoint_table_size = 32;
+
+  /**
+   * @brief Construct a router over a set of interfaces
+   *
+   * @param p_interfaces - interfaces to route requests to, in the order their
+   * descriptors are written. The span and every interface within it must
+   * outlive this object.
+   */
+  explicit request_router(std::span<interface* const> p_interfaces)
+    : m_interfaces(p_interfaces)
+  {
+  }
+
+  /**
+   * @brief Register the interface that owns an endpoint
+   *
+   * @param p_address - endpoint address, with bit 7 set for IN endpoints, as
+   * found in `endpoint_info::number`
+   * @param p_owner - interface that handles requests for the endpoint. Must
+   * outlive this object.
+   */
+  void route_endpoint(u8 p_address, interface& p_owner)
+  {
+    m_endpoints[endpoint_slot(p_address)] = &p_owner;
+  }
+
+  /**
+   * @brief Get the request counters
+   *
+   * @return request_router_statistics - counters since construction or the
+   * last call to `reset_statistics()`
+   */
+  [[nodiscard]] request_router_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+  /**
+   * @brief Clear the request counters
+   *
+   */
+  void reset_statistics()
+  {
+    m_statistics = {};
+  }
+
+private:
+  [[nodiscard]] static constexpr usize endpoint_slot(u8 p_address)
+  {
+    return (p_address & 0x0F) | ((p_address & 0x80) >> 3);
+  }
+
+  descriptor_count driver_write_descriptors(
+    descriptor_start p_start,
+    endpoint_writer const& p_callback) override
+  {
+    m_first_interface = p_start.interface.value_or(0);
+    m_first_string = p_start.string.value_or(1);
+    m_interface_owners = {};
+    m_string_owners = {};
+
+    descriptor_count total{ .interface = 0, .string = 0 };
+    for (auto* const member : m_interfaces) {
+      auto const count = member->write_descriptors(
+        { .interface = static_cast<u8>(m_first_interface + total.interface),
+          .string = static_cast<u8>(m_first_string + total.string) },
+        p_callback);
+
+      if (total.interface + count.interface > MaxInterfaces) {
+        hal::safe_throw(hal::out_of_range(
+          this,
+          { .m_index = usize{ total.interface } + count.interface,
+            .m_capacity = MaxInterfaces }));
+      }
+      if (total.string + count.string > MaxStrings) {
+        hal::safe_throw(hal::out_of_range(
+          this,
+          { .m_index = usize{ total.string } + count.string,
+            .m_capacity = MaxStrings }));
+      }
+
+      for (u8 i = 0; i < count.interface; i++) {
+        m_interface_owners[total.interface++] = member;
+      }
+      for (u8 i = 0; i < count.string; i++) {
+        m_string_owners[total.string++] = member;
+      }
+    }
+
+    return total;
+  }
+
+  bool driver_write_string_descriptor(
+    u8 p_index,
+    endpoint_writer const& p_callback) override
+  {
+    auto const slot = static_cast<usize>(p_index - m_first_string);
+    if (p_index < m_first_string || slot >= MaxStrings ||
+        m_string_owners[slot] == nullptr) {
+      return false;
+    }
+    return m_string_owners[slot]->write_string_descriptor(p_index, p_callback);
+  }
+
+  bool driver_handle_request(setup_packet const& p_setup,
+                             endpoint_writer const& p_callback) override
+  {
+    interface* owner = nullptr;
+    auto const index = static_cast<u8>(p_setup.index() & 0xFF);
+
+    switch (p_setup.get_recipient()) {
+      case setup_packet::request_recipient::interface: {
+        auto const slot = static_cast<usize>(index - m_first_interface);
+        if (index >= m_first_interface && slot < MaxInterfaces) {
+          owner = m_interface_owners[slot];
+        }
+        break;
+      }
+      case setup_packet::request_recipient::endpoint:
+        owner = m_endpoints[endpoint_slot(index)];
+        break;
+      default:
+        break;
+    }
+
+    if (owner == nullptr) {
+      m_statistics.unrouted++;
+      return false;
+    }
+
+    if (not owner->handle_request(p_setup, p_callback)) {
+      m_statistics.unhandled++;
+      return false;
+    }
+
+    m_statistics.routed++;
+    return true;
+  }
+
+  std::span<interface* const> m_interfaces;
+  std::array<interface*, MaxInterfaces> m_interface_owners{};
+  std::array<interface*, MaxStrings> m_string_owners{};
+  std::array<interface*, endpoint_table_size> m_endpoints{};
+  request_router_statistics m_statistics{};
+  u8 m_first_interface = 0;
+  u8 m_first_string = 1;
+};
+}  // namespace hal::v5::usb
+
+namespace hal::usb {
+using v5::usb::request_router;
+using v5::usb::request_router_statistics;
+}  // namespace hal::usb
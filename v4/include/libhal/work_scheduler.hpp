@@ -0,0 +1,256 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+#include "error.hpp"
+#include "functional.hpp"
+#include "io_waiter.hpp"
+#include "timeout.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+namespace detail {
+/**
+ * @brief io_waiter handed to each worker of a work_scheduler
+ *
+ * `wait()` parks the worker instead of blocking and `resume()` unparks it and
+ * wakes the scheduler.
+ */
+class work_waiter : public io_waiter
+{
+public:
+  void idle(io_waiter& p_idle)
+  {
+    m_idle = &p_idle;
+  }
+
+  [[nodiscard]] bool parked() const
+  {
+    return m_parked.load(std::memory_order_acquire);
+  }
+
+  void unpark()
+  {
+    m_parked.store(false, std::memory_order_release);
+  }
+
+private:
+  void driver_wait() override
+  {
+    m_parked.store(true, std::memory_order_release);
+  }
+
+  void driver_resume() noexcept override
+  {
+    m_parked.store(false, std::memory_order_release);
+    m_idle->resume();
+  }
+
+  io_waiter* m_idle = &hal::polling_io_waiter();
+  std::atomic<bool> m_parked = false;
+};
+}  // namespace detail
+
+/**
+ * @brief Counters for workers retired by a work_scheduler
+ *
+ */
+struct work_scheduler_statistics
+{
+  /// Workers that returned work_state::finished
+  usize finished = 0;
+  /// Workers that returned work_state::failed
+  usize failed = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(work_scheduler_statistics const&) const = default;
+};
+
+/**
+ * @brief Cooperative round robin scheduler for work functions
+ *
+ * Runs up to `Capacity` workers, each a `hal::work_function` that performs a
+ * small step of work per call, from a single main loop without an RTOS.
+ * Workers are called in turn, and a worker is retired as soon as it returns
+ * `work_state::finished` or `work_state::failed`.
+ *
+ * Each worker is given its own `hal::io_waiter` when spawned, which can be
+ * passed to the drivers it uses. Calling `wait()` on it parks the worker: the
+ * worker should return `work_state::in_progress` right after, and is not
+ * called again until `resume()` is called on the same waiter, typically from
+ * the interrupt that completes its I/O. When every worker is parked, the
+ * scheduler waits on the idle waiter given at construction, which can put the
+ * core to sleep, instead of busy waiting, and each `resume()` also resumes the
+ * idle waiter.
+ *
+ * No memory is allocated.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::work_scheduler<8> scheduler(sleep_waiter);
+ * scheduler.spawn([&]() { return imu_task.step(); });
+ * auto& waiter = scheduler.spawn([&]() { return logger_task.step(); });
+ * logger_task.use_waiter(waiter);
+ * scheduler.run();
+ * ```
+ *
+ * @tparam Capacity - maximum number of workers
+ */
+template<usize Capacity>
+class work_scheduler
+{
+public:
+  static_assert(Capacity > 0,
+                "work_scheduler must have a capacity of at least 1");
+
+  /// Type of the workers run by the scheduler
+  using work = hal::callback<work_function>;
+
+  /**
+   * @brief Construct a scheduler
+   *
+   * @param p_idle - waiter to wait on when every worker is parked. Must outlive
+   * this object.
+   */
+  explicit work_scheduler(io_waiter& p_idle = hal::polling_io_waiter())
+    : m_idle(&p_idle)
+  {
+    for (auto& entry : m_slots) {
+      entry.waiter.idle(p_idle);
+    }
+  }
+
+  work_scheduler(work_scheduler const&) = delete;
+  work_scheduler& operator=(work_scheduler const&) = delete;
+  work_scheduler(work_scheduler&&) = delete;
+  work_scheduler& operator=(work_scheduler&&) = delete;
+  ~work_scheduler() = default;
+
+  /**
+   * @brief Add a worker to the run queue
+   *
+   * @param p_work - worker to run until it finishes or fails
+   * @return io_waiter& - waiter that parks and resumes this worker. Valid
+   * until the worker is retired.
+   * @throws hal::out_of_range - if `Capacity` workers are already running.
+   */
+  io_waiter& spawn(work p_work)
+  {
+    for (auto& entry : m_slots) {
+      if (not entry.task) {
+        entry.task = p_work;
+        entry.waiter.unpark();
+        m_size++;
+        return entry.waiter;
+      }
+    }
+    hal::safe_throw(
+      hal::out_of_range(this, { .m_index = m_size, .m_capacity = Capacity }));
+  }
+
+  /**
+   * @brief Call each worker that is not parked once
+   *
+   * @return usize - number of workers called
+   */
+  usize run_once()
+  {
+    usize called = 0;
+    for (auto& entry : m_slots) {
+      if (not entry.task || entry.waiter.parked()) {
+        continue;
+      }
+
+      auto const state = (*entry.task)();
+      called++;
+
+      if (state == work_state::finished) {
+        m_statistics.finished++;
+        retire(entry);
+      } else if (state == work_state::failed) {
+        m_statistics.failed++;
+        retire(entry);
+      }
+    }
+    return called;
+  }
+
+  /**
+   * @brief Run workers until every worker has been retired
+   *
+   * Waits on the idle waiter whenever every remaining worker is parked.
+   */
+  void run()
+  {
+    while (m_size != 0) {
+      if (run_once() == 0) {
+        m_idle->wait();
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of workers that have not been retired
+   *
+   * @return usize - number of workers in the run queue
+   */
+  [[nodiscard]] usize size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Get the counters for retired workers
+   *
+   * @return work_scheduler_statistics - counters since construction
+   */
+  [[nodiscard]] work_scheduler_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+private:
+  struct slot
+  {
+    std::optional<work> task{};
+    detail::work_waiter waiter{};
+  };
+
+  void retire(slot& p_slot)
+  {
+    p_slot.task.reset();
+    p_slot.waiter.unpark();
+    m_size--;
+  }
+
+  io_waiter* m_idle;
+  std::array<slot, Capacity> m_slots{};
+  work_scheduler_statistics m_statistics{};
+  usize m_size = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::work_scheduler;
+using v5::work_scheduler_statistics;
+}  // namespace hal
@@ -0,0 +1,250 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+
+#include "error.hpp"
+#include "functional.hpp"
+#include "mpmc_queue.hpp"
+#include "spsc_queue.hpp"
+#include "timeout.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Counters for the workers run by one core of a
+ * work_stealing_executor
+ *
+ */
+struct work_stealing_statistics
+{
+  /// Calls made to workers
+  usize calls = 0;
+  /// Workers taken from another core's queue
+  usize stolen = 0;
+  /// Workers that returned work_state::finished
+  usize finished = 0;
+  /// Workers that returned work_state::failed
+  usize failed = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(work_stealing_statistics const&) const = default;
+};
+
+/**
+ * @brief Spread work functions across the cores of a multicore MCU
+ *
+ * Like `hal::work_scheduler`, workers are `hal::work_function`s that perform a
+ * small step of work per call and are retired once they return
+ * `work_state::finished` or `work_state::failed`. Each core has its own
+ * `hal::mpmc_queue` of workers, on its own cache lines. A core calls the
+ * worker at the front of its queue and puts it back at the end while it is
+ * still in progress. When its queue is empty, the core steals a worker from
+ * another core's queue, so work spawned on one core spreads to idle cores
+ * without any central run queue that every core contends for.
+ *
+ * Each core runs `run(core)` or calls `run_once(core)` from its own main
+ * loop, passing its own index. Workers and interrupts on any core may spawn
+ * workers onto any core. A worker may run on a different core for each call,
+ * so any state it shares with other workers must be safe to access from
+ * either core.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::work_stealing_executor<2> executor(allocator, 16);
+ * executor.spawn(0, [&]() { return imu_task.step(); });
+ * executor.spawn(0, [&]() { return telemetry_task.step(); });
+ *
+ * // core 0                  // core 1
+ * executor.run(0);           executor.run(1);
+ * ```
+ *
+ * @tparam Cores - number of cores running workers
+ */
+template<usize Cores>
+class work_stealing_executor
+{
+public:
+  static_assert(Cores > 0,
+                "work_stealing_executor must have at least 1 core");
+
+  /// Type of the workers run by the executor
+  using work = hal::callback<work_function>;
+
+  /**
+   * @brief Construct an executor
+   *
+   * @param p_allocator - allocator for each core's queue
+   * @param p_capacity - maximum number of workers across all cores
+   * @throws std::bad_alloc - if the queues cannot be allocated
+   */
+  explicit work_stealing_executor(
+    std::pmr::polymorphic_allocator<byte> p_allocator,
+    usize p_capacity)
+    : m_capacity(p_capacity)
+  {
+    for (auto& core : m_cores) {
+      core.queue.emplace(p_allocator, p_capacity);
+    }
+  }
+
+  work_stealing_executor(work_stealing_executor const&) = delete;
+  work_stealing_executor& operator=(work_stealing_executor const&) = delete;
+  work_stealing_executor(work_stealing_executor&&) = delete;
+  work_stealing_executor& operator=(work_stealing_executor&&) = delete;
+  ~work_stealing_executor() = default;
+
+  /**
+   * @brief Add a worker to a core's queue
+   *
+   * Safe to call from any core, from a worker or an interrupt.
+   *
+   * @param p_core - core to queue the worker on, which other cores may steal
+   * it from
+   * @param p_work - worker to run until it finishes or fails
+   * @throws hal::out_of_range - if p_core is not below Cores, or if the
+   * capacity's worth of workers are already running
+   */
+  void spawn(usize p_core, work p_work)
+  {
+    if (p_core >= Cores) {
+      hal::safe_throw(
+        hal::out_of_range(this, { .m_index = p_core, .m_capacity = Cores }));
+    }
+    auto const pending = m_pending.fetch_add(1, std::memory_order_acq_rel);
+    if (pending >= m_capacity) {
+      m_pending.fetch_sub(1, std::memory_order_acq_rel);
+      hal::safe_throw(hal::out_of_range(
+        this, { .m_index = pending, .m_capacity = m_capacity }));
+    }
+    // Cannot fail: every queue holds at least the capacity's worth of workers
+    (void)m_cores[p_core].queue->try_push(std::move(p_work));
+  }
+
+  /**
+   * @brief Call one worker, stealing one if this core's queue is empty
+   *
+   * Must only be called by core p_core.
+   *
+   * @param p_core - index of the calling core, below Cores
+   * @return true - if a worker was called
+   * @return false - if no core had a worker waiting to be called
+   */
+  bool run_once(usize p_core)
+  {
+    auto& self = m_cores[p_core];
+    auto task = self.queue->try_pop();
+    if (not task) {
+      task = steal(p_core);
+      if (not task) {
+        return false;
+      }
+      self.statistics.stolen++;
+    }
+
+    auto const state = (*task)();
+    self.statistics.calls++;
+
+    if (state == work_state::in_progress) {
+      // Cannot fail: every queue holds at least the capacity's worth of
+      // workers
+      (void)self.queue->try_push(std::move(*task));
+      return true;
+    }
+
+    if (state == work_state::finished) {
+      self.statistics.finished++;
+    } else {
+      self.statistics.failed++;
+    }
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+  }
+
+  /**
+   * @brief Run workers until every worker on every core has been retired
+   *
+   * Must only be called by core p_core. Spins while other cores hold the only
+   * remaining workers.
+   *
+   * @param p_core - index of the calling core, below Cores
+   */
+  void run(usize p_core)
+  {
+    while (pending() != 0) {
+      run_once(p_core);
+    }
+  }
+
+  /**
+   * @brief Get the number of workers that have not been retired
+   *
+   * @return usize - workers queued or being called, across all cores
+   */
+  [[nodiscard]] usize pending() const
+  {
+    return m_pending.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the counters of one core
+   *
+   * Call from core p_core, or once every core has stopped running workers.
+   *
+   * @param p_core - index of the core, below Cores
+   * @return work_stealing_statistics - counters since construction
+   */
+  [[nodiscard]] work_stealing_statistics statistics(usize p_core) const
+  {
+    return m_cores[p_core].statistics;
+  }
+
+private:
+  struct alignas(cache_line_size) core_t
+  {
+    std::optional<mpmc_queue<work>> queue{};
+    work_stealing_statistics statistics{};
+  };
+
+  std::optional<work> steal(usize p_core)
+  {
+    for (usize offset = 1; offset < Cores; offset++) {
+      auto& victim = m_cores[(p_core + offset) % Cores];
+      if (auto task = victim.queue->try_pop()) {
+        return task;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::array<core_t, Cores> m_cores{};
+  usize m_capacity;
+  alignas(cache_line_size) std::atomic<usize> m_pending = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::work_stealing_executor;
+using v5::work_stealing_statistics;
+}  // namespace hal
@@ -23,12 +23,78 @@
  */
 
 #include <cstddef>
+#include <optional>
 #include <span>
 
+#include "functional.hpp"
+#include "scatter_span.hpp"
 #include "serial.hpp"
 #include "units.hpp"
 
 namespace hal {
+/**
+ * @brief Fields that differ between two serial settings
+ *
+ * Returned by `hal::settings_changes()` for drivers implementing
+ * `zero_copy_serial::update_settings()`.
+ */
+struct serial_settings_changes
+{
+  /// The baud rate differs
+  bool baud_rate = false;
+  /// The number of stop bits differs
+  bool stop = false;
+  /// The parity differs
+  bool parity = false;
+
+  /**
+   * @brief Determine if the frame format changed
+   *
+   * Most UARTs must be disabled to change the frame format, while the baud
+   * rate divider can be rewritten between frames.
+   *
+   * @return true - if the stop bits or parity differ
+   */
+  [[nodiscard]] constexpr bool frame_format() const
+  {
+    return stop || parity;
+  }
+
+  /**
+   * @brief Determine if any field changed
+   *
+   * @return true - if the settings differ
+   */
+  [[nodiscard]] constexpr bool any() const
+  {
+    return baud_rate || frame_format();
+  }
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(serial_settings_changes const&) const = default;
+};
+
+/**
+ * @brief Compare serial settings field by field
+ *
+ * @param p_current - settings currently applied to the hardware
+ * @param p_new - settings to apply
+ * @return constexpr serial_settings_changes - fields that differ
+ */
+[[nodiscard]] constexpr serial_settings_changes settings_changes(
+  hal::serial::settings const& p_current,
+  hal::serial::settings const& p_new)
+{
+  return {
+    .baud_rate = p_current.baud_rate != p_new.baud_rate,
+    .stop = p_current.stop != p_new.stop,
+    .parity = p_current.parity != p_new.parity,
+  };
+}
+
 /**
  * @deprecated Use `v5::serial` instead, this file will be deleted in libhal 5
  * @brief Hardware abstract interface for the serial communication protocol
@@ -76,6 +142,35 @@ public:
     driver_configure(p_settings);
   }
 
+  /**
+   * @brief Change the settings of a port that is in use, touching only the
+   * fields that differ from the current settings
+   *
+   * `configure()` is a full application of the settings, which on many
+   * drivers disables the peripheral and restarts the receive DMA, dropping
+   * bytes in flight and resetting the receive cursor. Protocols that switch
+   * baud rates mid-session, such as bootloaders negotiating a faster link,
+   * should use this instead.
+   *
+   * Drivers that override this compare p_settings against the settings they
+   * last applied, for example with `hal::settings_changes()`, and only
+   * reprogram what changed. An unchanged setting is a no-op. When only the
+   * baud rate changes and the hardware allows it, the divider is rewritten
+   * without disabling the receiver, and the receive buffer, cursor and count
+   * are left untouched. As with `configure()`, the settings are verified
+   * before modifying the hardware, so a failure leaves the port unchanged.
+   *
+   * The default implementation calls `configure()`.
+   *
+   * @param p_settings - settings to apply to serial driver
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  void update_settings(hal::serial::settings const& p_settings)
+  {
+    driver_update_settings(p_settings);
+  }
+
   /**
    * @brief Write data to the transmitter line of the serial port
    *
@@ -86,6 +181,71 @@ public:
     driver_write(p_data);
   }
 
+  /**
+   * @brief Write several non-contiguous blocks of data to the transmitter line
+   * of the serial port
+   *
+   * The blocks are transmitted back to back in order, as if they were a single
+   * contiguous buffer. This allows a header, payload and checksum held in
+   * separate buffers to be sent without copying them into a staging buffer.
+   *
+   * The default implementation calls `write()` for each block. Drivers that
+   * can chain DMA descriptors, or otherwise transmit multiple buffers in a
+   * single transfer, should override this for better performance.
+   *
+   * @param p_data - scatter span of bytes to be transmitted over the serial
+   * port
+   */
+  void write(scatter_span<hal::byte const> p_data)
+  {
+    driver_write_scatter(p_data);
+  }
+
+  /**
+   * @brief Start transmitting data without waiting for it to be accepted
+   *
+   * Begins transmitting p_data, usually via DMA, and returns immediately. Once
+   * every byte of p_data has been handed to the hardware, p_on_complete is
+   * called. Drivers may call p_on_complete from within an interrupt context,
+   * so it must be kept short and must not throw.
+   *
+   * Buffer lifetime contract: p_data is NOT copied. The memory it refers to
+   * must remain valid and unmodified until p_on_complete has been called or
+   * `write_in_flight()` returns 0.
+   *
+   * If a previous asynchronous transmission is still in flight, this call
+   * blocks until it has completed before starting the new one. Calls to the
+   * blocking `write()` APIs also wait for any in flight transmission to
+   * complete first, so the order of bytes on the line always matches the
+   * order of the calls.
+   *
+   * The default implementation performs a blocking `write()` and then calls
+   * p_on_complete before returning. Drivers with DMA transmit support should
+   * override this.
+   *
+   * @param p_data - data to be transmitted over the serial port. Must outlive
+   * the transmission.
+   * @param p_on_complete - called once p_data has been transmitted
+   */
+  void write_async(std::span<hal::byte const> p_data,
+                   hal::callback<void()> p_on_complete)
+  {
+    driver_write_async(p_data, p_on_complete);
+  }
+
+  /**
+   * @brief Get the number of bytes that have yet to be transmitted by an
+   * asynchronous write
+   *
+   * @return usize - number of bytes of the current asynchronous write that
+   * have not been handed to the hardware yet. Returns 0 when no asynchronous
+   * write is in flight.
+   */
+  [[nodiscard]] usize write_in_flight()
+  {
+    return driver_write_in_flight();
+  }
+
   /**
    * @brief Returns this serial driver's receive buffer
    *
@@ -143,6 +303,27 @@ public:
     return driver_cursor();
   }
 
+  /**
+   * @brief Returns the total number of bytes received by the serial port
+   *
+   * The count starts at an arbitrary value and increases by one for every byte
+   * written into the receive buffer, wrapping around at the maximum value of
+   * `usize`. Unlike `receive_cursor()`, which wraps at the size of the receive
+   * buffer, the difference between two counts reveals whether more than a
+   * buffer's worth of data arrived between two reads, meaning that the
+   * producer has lapped the reader and data was lost.
+   *
+   * Support for this is optional. Drivers that do not track the number of
+   * received bytes return `std::nullopt`.
+   *
+   * @return std::optional<usize> - running count of received bytes or
+   * std::nullopt if the driver does not count received bytes.
+   */
+  [[nodiscard]] std::optional<usize> receive_count()
+  {
+    return driver_receive_count();
+  }
+
   virtual ~zero_copy_serial() = default;
 
 private:
@@ -150,5 +331,29 @@ private:
   virtual void driver_write(std::span<hal::byte const> p_data) = 0;
   virtual std::span<hal::byte const> driver_receive_buffer() = 0;
   virtual std::size_t driver_cursor() = 0;
+  virtual void driver_write_scatter(scatter_span<hal::byte const> p_data)
+  {
+    for (auto const& data : p_data) {
+      driver_write(data);
+    }
+  }
+  virtual std::optional<usize> driver_receive_count()
+  {
+    return std::nullopt;
+  }
+  virtual void driver_write_async(std::span<hal::byte const> p_data,
+                                  hal::callback<void()> p_on_complete)
+  {
+    driver_write(p_data);
+    p_on_complete();
+  }
+  virtual usize driver_write_in_flight()
+  {
+    return 0;
+  }
+  virtual void driver_update_settings(hal::serial::settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
 };
 }  // namespace hal
@@ -0,0 +1,179 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <optional>
+#include <span>
+
+#include "scatter_span.hpp"
+#include "units.hpp"
+
+namespace hal::v5 {
+/**
+ * @brief Concept for serial drivers that expose a circular receive buffer
+ *
+ * Satisfied by `hal::zero_copy_serial` and `hal::v5::serial`.
+ *
+ * @tparam Serial - serial driver type
+ */
+template<class Serial>
+concept zero_copy_receiver = requires(Serial& p_serial) {
+  {
+    p_serial.receive_buffer()
+  } -> std::convertible_to<std::span<hal::byte const>>;
+  { p_serial.receive_cursor() } -> std::convertible_to<usize>;
+  { p_serial.receive_count() } -> std::same_as<std::optional<usize>>;
+};
+
+/**
+ * @brief Tracks a read position within a serial port's circular receive buffer
+ *
+ * Each call to `read()` returns the bytes that arrived since the previous call
+ * as a scatter span of at most two segments, split where the data wraps
+ * around the end of the receive buffer. No data is copied, the segments point
+ * directly into the driver's receive buffer.
+ *
+ * If the driver supports `receive_count()`, the reader also detects when more
+ * data arrived than the receive buffer can hold, meaning the producer has
+ * lapped the reader. In that case `read()` returns the entire receive buffer,
+ * oldest byte first, and `dropped()` reports how many bytes were lost. Without
+ * `receive_count()`, a lap cannot be distinguished from a smaller amount of
+ * data and `dropped()` will always be 0.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::zero_copy_serial_reader reader(uart);
+ *
+ * while (true) {
+ *   auto const new_data = reader.read();
+ *   if (reader.dropped() > 0) {
+ *     parser.reset();
+ *   }
+ *   for (auto const segment : new_data) {
+ *     parser.feed(segment);
+ *   }
+ * }
+ * ```
+ *
+ * @tparam Serial - serial driver type
+ */
+template<zero_copy_receiver Serial>
+class zero_copy_serial_reader
+{
+public:
+  /**
+   * @brief Construct a reader starting at the serial port's current cursor
+   *
+   * Data received before construction is not returned by `read()`.
+   *
+   * @param p_serial - serial port to read from. Must outlive this object.
+   */
+  explicit zero_copy_serial_reader(Serial& p_serial)
+    : m_serial(&p_serial)
+    , m_cursor(p_serial.receive_cursor())
+    , m_count(p_serial.receive_count())
+  {
+  }
+
+  /**
+   * @brief Get the bytes received since the last call to `read()`
+   *
+   * The returned scatter span, and the segments within it, are only valid
+   * until the next call to `read()`. The segments point into the receive
+   * buffer and will be overwritten by the driver as more data arrives. Data
+   * must be consumed before the driver laps it.
+   *
+   * @return scatter_span<hal::byte const> - up to two segments of newly
+   * received data, oldest first. Empty segments are omitted.
+   */
+  [[nodiscard]] scatter_span<hal::byte const> read()
+  {
+    auto const buffer = m_serial->receive_buffer();
+    auto const size = buffer.size();
+    auto const cursor = m_serial->receive_cursor();
+    auto const count = m_serial->receive_count();
+
+    usize received = (cursor + size - m_cursor) % size;
+    m_dropped = 0;
+
+    if (count && m_count) {
+      usize const counted = *count - *m_count;
+      if (counted >= size) {
+        m_dropped = counted - size;
+        received = size;
+      }
+    }
+
+    auto const start = (cursor + size - received) % size;
+    auto const til_end = size - start;
+
+    m_cursor = cursor;
+    m_count = count;
+
+    if (received == 0) {
+      return {};
+    }
+
+    if (received <= til_end) {
+      m_segments[0] = buffer.subspan(start, received);
+      return scatter_span<hal::byte const>(m_segments).first(1);
+    }
+
+    m_segments[0] = buffer.subspan(start);
+    m_segments[1] = buffer.first(received - til_end);
+    return m_segments;
+  }
+
+  /**
+   * @brief Number of bytes lost before the most recent call to `read()`
+   *
+   * @return usize - number of bytes overwritten by the driver before they
+   * could be read. Always 0 if the driver does not support
+   * `receive_count()`.
+   */
+  [[nodiscard]] usize dropped() const
+  {
+    return m_dropped;
+  }
+
+  /**
+   * @brief Skip over all received data
+   *
+   * Moves the read position to the serial port's current cursor without
+   * returning the data in between.
+   */
+  void skip()
+  {
+    m_cursor = m_serial->receive_cursor();
+    m_count = m_serial->receive_count();
+    m_dropped = 0;
+  }
+
+private:
+  Serial* m_serial;
+  std::array<std::span<hal::byte const>, 2> m_segments{};
+  usize m_cursor = 0;
+  std::optional<usize> m_count{};
+  usize m_dropped = 0;
+};
+}  // namespace hal::v5
+
+namespace hal {
+using v5::zero_copy_receiver;
+using v5::zero_copy_serial_reader;
+}  // namespace hal
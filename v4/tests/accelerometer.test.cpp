@@ -12,4 +12,93 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <array>
+
 #include <libhal/accelerometer.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_accelerometer : public hal::accelerometer
+{
+public:
+  int m_reads = 0;
+
+private:
+  read_t driver_read() override
+  {
+    m_reads++;
+    return { .x = 0.5f, .y = -0.5f, .z = 1.0f };
+  }
+};
+
+class test_fifo_accelerometer : public hal::accelerometer
+{
+public:
+  std::array<read_t, 3> m_fifo{ read_t{ .x = 1.0f, .y = 0.0f, .z = 0.0f },
+                                read_t{ .x = 2.0f, .y = 0.0f, .z = 0.0f },
+                                read_t{ .x = 3.0f, .y = 0.0f, .z = 0.0f } };
+  int m_bursts = 0;
+
+private:
+  read_t driver_read() override
+  {
+    return m_fifo.back();
+  }
+
+  std::span<read_t> driver_read_batch(std::span<read_t> p_samples) override
+  {
+    m_bursts++;
+    auto const count = std::min(p_samples.size(), m_fifo.size());
+    std::copy_n(m_fifo.begin(), count, p_samples.begin());
+    return p_samples.first(count);
+  }
+
+  std::optional<hertz> driver_output_data_rate() override
+  {
+    return 1.0_kHz;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"accelerometer_test"> accelerometer_test = []() {
+  using namespace boost::ut;
+
+  "::read_batch() defaults to the latest sample"_test = []() {
+    // Setup
+    test_accelerometer test;
+    std::array<accelerometer::read_t, 4> samples{};
+
+    // Exercise
+    auto const batch = test.read_batch(samples);
+    auto const empty = test.read_batch({});
+
+    // Verify
+    expect(that % 1 == batch.size());
+    expect(that % samples.data() == batch.data());
+    expect(that % 0.5f == batch[0].x);
+    expect(that % 1.0f == batch[0].z);
+    expect(empty.empty());
+    expect(that % 1 == test.m_reads);
+    expect(not test.output_data_rate().has_value());
+  };
+
+  "::read_batch() drains the fifo in one burst"_test = []() {
+    // Setup
+    test_fifo_accelerometer test;
+    std::array<accelerometer::read_t, 8> samples{};
+
+    // Exercise
+    auto const batch = test.read_batch(samples);
+
+    // Verify
+    expect(that % 3 == batch.size());
+    expect(that % 1.0f == batch[0].x);
+    expect(that % 3.0f == batch[2].x);
+    expect(that % 1 == test.m_bursts);
+    expect(that % 1.0_kHz == test.output_data_rate().value());
+  };
+};
+}  // namespace hal
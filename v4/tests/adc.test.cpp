@@ -14,6 +14,10 @@
 
 #include <libhal/adc.hpp>
 
+#include <array>
+
+#include <libhal/adc_scan.hpp>
+#include <libhal/adc_stream.hpp>
 #include <libhal/error.hpp>
 
 #include <boost/ut.hpp>
@@ -101,4 +105,144 @@ boost::ut::suite<"hal::adc24"> adc24_test = []() {
     expect(that % test_adc24::returned_position == sample);
   };
 };
+
+class test_adc16_scan : public hal::adc16_scan
+{
+public:
+  std::span<u8 const> m_channels{};
+  std::optional<hertz> m_scan_rate{};
+  int m_scans = 0;
+
+private:
+  void driver_scan(std::span<u8 const> p_channels,
+                   std::span<u16> p_samples,
+                   std::optional<hertz> p_scan_rate) override
+  {
+    m_channels = p_channels;
+    m_scan_rate = p_scan_rate;
+    m_scans++;
+    for (usize i = 0; i < p_samples.size(); i++) {
+      // Sample value encodes the scan and the channel it came from
+      auto const scan = i / p_channels.size();
+      auto const channel = p_channels[i % p_channels.size()];
+      p_samples[i] = static_cast<u16>((scan << 8U) | channel);
+    }
+  }
+};
+
+boost::ut::suite<"hal::adc16_scan"> adc16_scan_test = []() {
+  using namespace boost::ut;
+  "::scan() fills interleaved samples in one call"_test = []() {
+    // Setup
+    test_adc16_scan test;
+    std::array<u8, 3> const channels{ 4, 0, 7 };
+    std::array<u16, 6> samples{};
+
+    // Exercise
+    test.scan(channels, samples, 10.0_kHz);
+
+    // Verify
+    expect(that % 1 == test.m_scans);
+    expect(that % channels.data() == test.m_channels.data());
+    expect(test.m_scan_rate == 10.0_kHz);
+    expect(std::array<u16, 6>{ 0x004, 0x000, 0x007, 0x104, 0x100, 0x107 } ==
+           samples);
+  };
+
+  "::scan() rejects buffers that do not fit the channel list"_test = []() {
+    // Setup
+    test_adc16_scan test;
+    std::array<u8, 2> const channels{ 1, 2 };
+    std::array<u16, 3> samples{};
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.scan(channels, samples); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.scan({}, samples); }));
+    expect(that % 0 == test.m_scans);
+  };
+};
+
+class test_adc16_stream : public hal::adc16_stream
+{
+public:
+  /// Simulates the DMA engine writing samples into the receive buffer
+  void produce(u16 p_sample)
+  {
+    m_buffer[m_cursor] = p_sample;
+    m_cursor = (m_cursor + 1) % m_buffer.size();
+    m_count++;
+  }
+
+  std::array<u16, 4> m_buffer{};
+  std::optional<settings> m_settings{};
+  usize m_cursor = 0;
+  usize m_count = 0;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  std::span<u16 const> driver_receive_buffer() override
+  {
+    return m_buffer;
+  }
+
+  usize driver_cursor() override
+  {
+    return m_cursor;
+  }
+
+  std::optional<usize> driver_receive_count() override
+  {
+    return m_count;
+  }
+};
+
+boost::ut::suite<"hal::adc16_stream"> adc16_stream_test = []() {
+  using namespace boost::ut;
+  "::receive_buffer() exposes samples in place"_test = []() {
+    // Setup
+    test_adc16_stream test;
+    test.configure({ .sample_rate = 200.0_kHz });
+
+    // Exercise
+    test.produce(10);
+    test.produce(20);
+    test.produce(30);
+    test.produce(40);
+    test.produce(50);
+
+    // Verify
+    expect(test.m_settings->sample_rate == 200.0_kHz);
+    expect(that % test.m_buffer.data() == test.receive_buffer().data());
+    expect(that % 1 == test.receive_cursor());
+    expect(that % 50 == test.receive_buffer()[0]);
+    expect(that % 5 == test.receive_count().value());
+  };
+
+  "::receive_count() is optional"_test = []() {
+    // Setup
+    class uncounted : public hal::adc24_stream
+    {
+      void driver_configure(settings const&) override
+      {
+      }
+      std::span<u32 const> driver_receive_buffer() override
+      {
+        return {};
+      }
+      usize driver_cursor() override
+      {
+        return 0;
+      }
+    } test;
+
+    // Exercise & Verify
+    expect(not test.receive_count().has_value());
+  };
+};
 }  // namespace hal
@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <bit>
 #include <memory_resource>
 
 #include <libhal/allocated_buffer.hpp>
+#include <libhal/boot_arena.hpp>
 
 #include "helpers.hpp"
 #include "libhal/error.hpp"
@@ -290,5 +293,46 @@ boost::ut::suite<"allocated_buffer_test"> allocated_buffer_test = []() {
       expect(that % static_cast<int>(i * 10) == buf[i]);
     }
   };
+
+  "zeroes trivial types when given a zero value"_test = [&] {
+    // Setup
+    alignas(8) std::array<hal::byte, 64> region{};
+    region.fill(0xAA);
+    boot_arena arena(region);
+
+    // Exercise
+    allocated_buffer<u32> buf(&arena, 4, 0);
+
+    // Verify
+    for (auto const value : buf) {
+      expect(that % 0 == value);
+    }
+  };
+
+  "for_overwrite leaves elements uninitialized"_test = [&] {
+    // Setup
+    alignas(64) std::array<hal::byte, 128> region{};
+    region.fill(0xAA);
+    boot_arena arena(region);
+    (void)arena.allocate(1, 1);
+
+    // Exercise
+    allocated_buffer<u8> buf(&arena, 8, for_overwrite, 32);
+    auto const made = make_allocated_buffer_for_overwrite<u16>(&arena, 4);
+
+    // Verify
+    expect(that % 0 == std::bit_cast<uptr>(buf.data()) % 32);
+    expect(that % 8 == buf.size());
+    expect(that % 0xAA == buf[0]);
+    expect(that % 4 == made.size());
+    expect(that % 0xAAAA == made[3]);
+  };
+
+  "for_overwrite rejects invalid alignments"_test = [&] {
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      allocated_buffer<u8> buf(test_allocator, 8, for_overwrite, 24);
+    }));
+  };
 };
 }  // namespace hal
@@ -0,0 +1,153 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <libhal/attitude_filter.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+/// Dot product of the measured gravity and the filter's estimate of it
+float gravity_alignment(quaternion const& p_q,
+                        accelerometer::read_t const& p_acceleration)
+{
+  auto const norm = std::sqrt((p_acceleration.x * p_acceleration.x) +
+                              (p_acceleration.y * p_acceleration.y) +
+                              (p_acceleration.z * p_acceleration.z));
+  auto const vx = 2.0f * ((p_q.x * p_q.z) - (p_q.w * p_q.y));
+  auto const vy = 2.0f * ((p_q.w * p_q.x) + (p_q.y * p_q.z));
+  auto const vz = (p_q.w * p_q.w) - (p_q.x * p_q.x) - (p_q.y * p_q.y) +
+                  (p_q.z * p_q.z);
+  return ((vx * p_acceleration.x) + (vy * p_acceleration.y) +
+          (vz * p_acceleration.z)) /
+         norm;
+}
+
+bool near(float p_expected, float p_actual)
+{
+  return std::abs(p_expected - p_actual) < 1e-3f;
+}
+
+constexpr accelerometer::read_t level{ .x = 0.0f, .y = 0.0f, .z = 1.0f };
+constexpr accelerometer::read_t on_side{ .x = 0.0f, .y = 1.0f, .z = 0.0f };
+constexpr accelerometer::read_t free_fall{ .x = 0.0f, .y = 0.0f, .z = 0.0f };
+constexpr gyroscope::read_t still{ .x = 0.0f, .y = 0.0f, .z = 0.0f };
+}  // namespace
+
+boost::ut::suite<"attitude_filter_test"> attitude_filter_test = []() {
+  using namespace boost::ut;
+
+  "mahony_filter stays level when still"_test = []() {
+    // Setup
+    mahony_filter filter({ .sample_rate = 1.0_kHz, .integral_gain = 0.1f });
+    std::vector<accelerometer::read_t> const accel(100, level);
+    std::vector<gyroscope::read_t> const gyro(100, still);
+    std::vector<magnetometer::read_t> const mag(
+      100, magnetometer::read_t{ .x = 0.5f, .y = 0.0f, .z = 0.0f });
+
+    // Exercise
+    auto const six_axis = filter.update(accel, gyro);
+    auto const nine_axis = filter.update(accel, gyro, mag);
+
+    // Verify
+    expect(quaternion{} == six_axis);
+    expect(quaternion{} == nine_axis);
+  };
+
+  "mahony_filter integrates the gyroscope"_test = []() {
+    // Setup
+    mahony_filter filter({ .sample_rate = 1.0_kHz });
+    // 15rpm is 90 degrees per second
+    std::vector<accelerometer::read_t> const accel(1000, free_fall);
+    std::vector<gyroscope::read_t> const gyro(
+      1000, gyroscope::read_t{ .x = 0.0f, .y = 0.0f, .z = 15.0f });
+
+    // Exercise
+    auto const q = filter.update(accel, gyro);
+
+    // Verify
+    expect(near(std::sqrt(0.5f), q.w)) << q.w;
+    expect(near(0.0f, q.x)) << q.x;
+    expect(near(0.0f, q.y)) << q.y;
+    expect(near(std::sqrt(0.5f), q.z)) << q.z;
+  };
+
+  "mahony_filter converges to gravity"_test = []() {
+    // Setup
+    mahony_filter filter({ .sample_rate = 1.0_kHz });
+
+    // Exercise
+    for (int i = 0; i < 5000; i++) {
+      filter.update(on_side, still);
+    }
+
+    // Verify
+    expect(gravity_alignment(filter.orientation(), on_side) > 0.999f);
+    filter.reset();
+    expect(quaternion{} == filter.orientation());
+  };
+
+  "madgwick_filter converges to gravity"_test = []() {
+    // Setup
+    madgwick_filter filter({ .sample_rate = 1.0_kHz, .gain = 0.5f });
+    std::vector<accelerometer::read_t> const accel(10000, on_side);
+    std::vector<gyroscope::read_t> const gyro(10000, still);
+
+    // Exercise
+    auto const q = filter.update(accel, gyro);
+
+    // Verify
+    expect(gravity_alignment(q, on_side) > 0.999f);
+  };
+
+  "madgwick_filter integrates the gyroscope"_test = []() {
+    // Setup
+    madgwick_filter filter({ .sample_rate = 1.0_kHz });
+
+    // Exercise
+    for (int i = 0; i < 1000; i++) {
+      filter.update(free_fall, { .x = 15.0f, .y = 0.0f, .z = 0.0f });
+    }
+    auto const q = filter.orientation();
+
+    // Verify
+    expect(near(std::sqrt(0.5f), q.w)) << q.w;
+    expect(near(std::sqrt(0.5f), q.x)) << q.x;
+  };
+
+  "filters reject invalid input"_test = []() {
+    // Setup
+    mahony_filter mahony({});
+    madgwick_filter madgwick({});
+    std::array<accelerometer::read_t, 2> const accel{ level, level };
+    std::array<gyroscope::read_t, 1> const gyro{ still };
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>(
+      []() { mahony_filter filter({ .sample_rate = 0.0f }); }));
+    expect(throws<hal::argument_out_of_domain>(
+      []() { madgwick_filter filter({ .sample_rate = -1.0f }); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { mahony.update(accel, gyro); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { madgwick.update(accel, gyro); }));
+  };
+};
+}  // namespace hal
@@ -0,0 +1,190 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+#include <libhal/awaitable_io.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+/// Minimal eagerly started coroutine type
+struct test_task
+{
+  struct promise_type
+  {
+    test_task get_return_object()
+    {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept
+    {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept
+    {
+      return {};
+    }
+    void return_void()
+    {
+    }
+    void unhandled_exception()
+    {
+      std::terminate();
+    }
+  };
+};
+
+class async_serial : public hal::v5::serial
+{
+public:
+  std::span<hal::byte const> m_data{};
+  std::optional<hal::callback<void()>> m_on_complete{};
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_write(std::span<hal::byte const>) override
+  {
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return {};
+  }
+
+  usize driver_cursor() override
+  {
+    return 0;
+  }
+
+  void driver_write_async(std::span<hal::byte const> p_data,
+                          hal::callback<void()> p_on_complete) override
+  {
+    m_data = p_data;
+    m_on_complete = p_on_complete;
+  }
+};
+
+class async_queue : public hal::i2c_transaction_queue
+{
+public:
+  optional_completion_handler m_handler{};
+
+  void complete(batch_result p_result)
+  {
+    (*m_handler)(on_complete_tag{}, p_result);
+  }
+
+private:
+  void driver_submit(std::span<transaction const>,
+                     optional_completion_handler p_on_complete) override
+  {
+    m_handler = p_on_complete;
+  }
+
+  bool driver_busy() override
+  {
+    return false;
+  }
+
+  batch_result driver_wait() override
+  {
+    return {};
+  }
+};
+
+test_task write_twice(hal::v5::serial& p_serial,
+                      std::span<hal::byte const> p_data,
+                      int& p_progress)
+{
+  co_await async_write(p_serial, p_data);
+  p_progress++;
+  co_await async_write(p_serial, p_data);
+  p_progress++;
+}
+
+test_task read_sensor(i2c_transaction_queue& p_queue,
+                      i2c_transaction_queue::batch_result& p_result)
+{
+  std::array<i2c_transaction_queue::transaction, 1> const batch{ {
+    { .address = 0x42 },
+  } };
+  p_result = co_await async_submit(p_queue, batch);
+}
+}  // namespace
+
+boost::ut::suite<"awaitable_io_test"> awaitable_io_test = []() {
+  using namespace boost::ut;
+
+  "async_write suspends until the write completes"_test = []() {
+    // Setup
+    async_serial serial;
+    std::array<hal::byte, 3> const data{ 1, 2, 3 };
+    int progress = 0;
+
+    // Exercise & Verify
+    write_twice(serial, data, progress);
+    expect(that % 0 == progress);
+    expect(that % data.data() == serial.m_data.data());
+
+    (*serial.m_on_complete)();
+    expect(that % 1 == progress);
+
+    (*serial.m_on_complete)();
+    expect(that % 2 == progress);
+  };
+
+  "async_write does not suspend if the write completes at once"_test = []() {
+    // Setup
+    class blocking_serial : public async_serial
+    {
+      void driver_write_async(std::span<hal::byte const>,
+                              hal::callback<void()> p_on_complete) override
+      {
+        p_on_complete();
+      }
+    } serial;
+    std::array<hal::byte, 1> const data{ 1 };
+    int progress = 0;
+
+    // Exercise
+    write_twice(serial, data, progress);
+
+    // Verify
+    expect(that % 2 == progress);
+  };
+
+  "async_submit resumes with the batch result"_test = []() {
+    // Setup
+    async_queue queue;
+    i2c_transaction_queue::batch_result result{};
+
+    // Exercise
+    read_sensor(queue, result);
+    expect(i2c_transaction_queue::batch_result{} == result);
+    queue.complete({ .completed = 0, .error = std::errc::io_error });
+
+    // Verify
+    expect(i2c_transaction_queue::batch_result{
+             .completed = 0, .error = std::errc::io_error } == result);
+  };
+};
+}  // namespace hal
@@ -0,0 +1,97 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <bit>
+#include <new>
+
+#include <libhal/allocated_buffer.hpp>
+#include <libhal/boot_arena.hpp>
+#include <libhal/pointers.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+boost::ut::suite<"boot_arena_test"> boot_arena_test = []() {
+  using namespace boost::ut;
+
+  "boot_arena bump allocates with alignment"_test = []() {
+    // Setup
+    alignas(8) std::array<hal::byte, 64> region{};
+    boot_arena arena(region);
+
+    // Exercise
+    auto* first = arena.allocate(1, 1);
+    auto* second = arena.allocate(4, 4);
+    auto* third = arena.allocate(8, 8);
+
+    // Verify
+    expect(that % static_cast<void*>(region.data()) == first);
+    expect(that % static_cast<void*>(region.data() + 4) == second);
+    expect(that % static_cast<void*>(region.data() + 8) == third);
+    expect(boot_arena_usage{ .capacity = 64,
+                             .used = 16,
+                             .padding = 3,
+                             .allocations = 3 } == arena.usage());
+    expect(that % 48 == arena.usage().remaining());
+  };
+
+  "boot_arena::deallocate() does not reclaim memory"_test = []() {
+    // Setup
+    alignas(8) std::array<hal::byte, 32> region{};
+    boot_arena arena(region);
+
+    // Exercise
+    auto* first = arena.allocate(16, 8);
+    arena.deallocate(first, 16, 8);
+    auto* second = arena.allocate(16, 8);
+
+    // Verify
+    expect(that % first != second);
+    expect(that % 16 == arena.usage().deallocated);
+    expect(that % 32 == arena.usage().used);
+  };
+
+  "boot_arena throws when exhausted and release() reclaims"_test = []() {
+    // Setup
+    alignas(8) std::array<hal::byte, 16> region{};
+    boot_arena arena(region);
+    (void)arena.allocate(12, 1);
+
+    // Exercise & Verify
+    expect(throws<std::bad_alloc>([&]() { (void)arena.allocate(4, 8); }));
+    expect(that % 1 == arena.usage().failures);
+    arena.release();
+    expect(that % static_cast<void*>(region.data()) == arena.allocate(16, 8));
+    expect(that % 0 == arena.usage().remaining());
+  };
+
+  "boot_arena packs drivers contiguously"_test = []() {
+    // Setup
+    alignas(std::max_align_t) std::array<hal::byte, 512> region{};
+    boot_arena arena(region);
+
+    // Exercise
+    auto const first = make_strong_ptr<u32>(&arena, 1U);
+    auto const buffer = allocated_buffer<u8>(&arena, 8);
+    auto const second = make_strong_ptr<u32>(&arena, 2U);
+
+    // Verify
+    expect(that % 2 == *second);
+    expect(that % 3 == arena.usage().allocations);
+    expect(std::bit_cast<uptr>(&*first) < std::bit_cast<uptr>(&*second));
+    expect(that % 0 == arena.usage().deallocated);
+  };
+};
+}  // namespace hal
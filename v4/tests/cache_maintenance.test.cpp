@@ -0,0 +1,183 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <libhal/cache_maintenance.hpp>
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+static_assert(cache_aligned_buffer<hal::byte, 1>::size == 32);
+static_assert(cache_aligned_buffer<hal::byte, 64>::size == 64);
+static_assert(cache_aligned_buffer<hal::byte, 65, 64>::size == 128);
+static_assert(cache_aligned_buffer<std::array<hal::byte, 12>, 3>::size == 8);
+static_assert(alignof(cache_aligned_buffer<hal::byte, 1, 64>) == 64);
+static_assert(sizeof(cache_aligned_buffer<hal::byte, 1, 64>) == 64);
+
+/// Cache that records the ranges it maintains, as offsets into a buffer
+class fake_cache : public hal::cache_maintenance
+{
+public:
+  using range = std::pair<usize, usize>;
+
+  explicit fake_cache(std::span<hal::byte const> p_buffer)
+    : m_buffer(p_buffer)
+  {
+  }
+
+  std::vector<range> m_cleaned{};
+  std::vector<range> m_invalidated{};
+
+private:
+  usize driver_line_size() override
+  {
+    return 32;
+  }
+
+  void driver_clean(std::span<hal::byte const> p_range) override
+  {
+    m_cleaned.push_back(offsets(p_range));
+  }
+
+  void driver_invalidate(std::span<hal::byte const> p_range) override
+  {
+    m_invalidated.push_back(offsets(p_range));
+  }
+
+  range offsets(std::span<hal::byte const> p_range)
+  {
+    auto const begin = static_cast<usize>(p_range.data() - m_buffer.data());
+    return { begin, begin + p_range.size() };
+  }
+
+  std::span<hal::byte const> m_buffer;
+};
+}  // namespace
+
+boost::ut::suite<"cache_maintenance_test"> cache_maintenance_test = []() {
+  using namespace boost::ut;
+  using range = fake_cache::range;
+
+  "invalidate_received only invalidates lines holding new data"_test = []() {
+    // Setup
+    cache_aligned_buffer<hal::byte, 128> ring;
+    auto const buffer = std::span<hal::byte const>(ring.storage);
+    fake_cache cache(buffer);
+    // Received data wrapped around the end of the ring
+    std::array const received{ buffer.subspan(100), buffer.first(5) };
+
+    // Exercise
+    invalidate_received(
+      cache, buffer, scatter_span<hal::byte const>(received));
+
+    // Verify
+    expect(std::vector{ range{ 96, 128 }, range{ 0, 32 } } ==
+           cache.m_invalidated);
+    expect(cache.m_cleaned.empty());
+  };
+
+  "invalidate_received skips empty segments"_test = []() {
+    // Setup
+    cache_aligned_buffer<hal::byte, 64> ring;
+    auto const buffer = std::span<hal::byte const>(ring.storage);
+    fake_cache cache(buffer);
+    std::array const received{ buffer.subspan(33, 2), buffer.first(0) };
+
+    // Exercise
+    invalidate_received(
+      cache, buffer, scatter_span<hal::byte const>(received));
+
+    // Verify
+    expect(std::vector{ range{ 32, 64 } } == cache.m_invalidated);
+  };
+
+  "invalidate_received handles multi byte elements"_test = []() {
+    // Setup
+    using element = std::array<hal::byte, 12>;
+    cache_aligned_buffer<element, 8> ring;
+    auto const buffer = std::span<element const>(ring.storage);
+    fake_cache cache(std::span(
+      reinterpret_cast<hal::byte const*>(buffer.data()), buffer.size_bytes()));
+    // Elements 2 and 3 occupy bytes 24 to 48
+    std::array const received{ buffer.subspan(2, 2) };
+
+    // Exercise
+    invalidate_received(cache, buffer, scatter_span<element const>(received));
+
+    // Verify
+    expect(std::vector{ range{ 0, 64 } } == cache.m_invalidated);
+  };
+
+  "invalidate_received rejects buffers sharing cache lines"_test = []() {
+    // Setup
+    cache_aligned_buffer<hal::byte, 64> ring;
+    auto const buffer = std::span<hal::byte const>(ring.storage);
+    fake_cache cache(buffer);
+    std::array const received{ buffer.subspan(8, 4) };
+    std::array const outside{ buffer.subspan(40, 4) };
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      invalidate_received(
+        cache, buffer.subspan(8), scatter_span<hal::byte const>(received));
+    }));
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      invalidate_received(
+        cache, buffer.first(40), scatter_span<hal::byte const>(received));
+    }));
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      invalidate_received(
+        cache, buffer.first(32), scatter_span<hal::byte const>(outside));
+    }));
+    expect(cache.m_invalidated.empty());
+  };
+
+  "clean_for_transmit cleans each segment as is"_test = []() {
+    // Setup
+    std::array<hal::byte, 64> data{};
+    auto const buffer = std::span<hal::byte const>(data);
+    fake_cache cache(buffer);
+
+    // Exercise
+    clean_for_transmit(cache,
+                       make_scatter_bytes(buffer.subspan(3, 10),
+                                          buffer.first(0),
+                                          buffer.subspan(50, 4)));
+
+    // Verify
+    expect(std::vector{ range{ 3, 13 }, range{ 50, 54 } } == cache.m_cleaned);
+    expect(cache.m_invalidated.empty());
+  };
+
+  "no_cache_maintenance accepts any buffer"_test = []() {
+    // Setup
+    std::array<hal::byte, 7> data{};
+    auto const buffer = std::span<hal::byte const>(data);
+    std::array const received{ buffer.subspan(1, 3) };
+    no_cache_maintenance cache;
+
+    // Exercise & Verify
+    expect(that % 1 == cache.line_size());
+    invalidate_received(
+      cache, buffer, scatter_span<hal::byte const>(received));
+  };
+};
+}  // namespace hal
@@ -14,6 +14,8 @@
 
 #include <libhal/can.hpp>
 
+#include <unordered_set>
+
 #include <libhal/error.hpp>
 #include <libhal/functional.hpp>
 
@@ -144,6 +146,7 @@ struct test_can_transceiver : public hal::can_transceiver
 {
 public:
   can_message sent_message{};
+  std::size_t sent_count = 0;
   std::size_t cursor = 0;
   std::span<can_message> working_receive_buffer;
 
@@ -161,6 +164,7 @@ private:
   void driver_send(can_message const& p_message) override
   {
     sent_message = p_message;
+    sent_count++;
   }
 
   std::span<can_message const> driver_receive_buffer() override
@@ -202,6 +206,33 @@ boost::ut::suite<"can_transceiver"> can_transceiver_test = []() {
     expect(expected_can_message == test.sent_message);
   };
 
+  "::send(span)"_test = [&]() {
+    // Setup
+    test_can_transceiver test(receive_buffer);
+    auto const messages = std::to_array<can_message>({
+      { .id = 0x111, .length = 1, .payload = { 0x01 } },
+      { .id = 0x222, .length = 2, .payload = { 0x02, 0x03 } },
+      expected_can_message,
+    });
+
+    // Exercise
+    auto const queued = test.send(messages);
+
+    // Verify
+    expect(that % messages.size() == queued);
+    expect(that % messages.size() == test.sent_count)
+      << "Default implementation should send each message";
+    expect(expected_can_message == test.sent_message)
+      << "Messages should be sent in order";
+
+    // Exercise
+    auto const queued_none = test.send(std::span<can_message const>{});
+
+    // Verify
+    expect(that % 0 == queued_none);
+    expect(that % messages.size() == test.sent_count);
+  };
+
   "::receive_buffer()"_test = [&]() {
     // Setup
     test_can_transceiver test(receive_buffer);
@@ -231,12 +262,22 @@ struct test_can_interrupt : public hal::can_interrupt
 {
 public:
   hal::can_interrupt::optional_receive_handler handler;
+  hal::can_interrupt::optional_batch_receive_handler batch_handler;
+  hal::can_interrupt::batch_settings received_settings{};
 
 private:
   void driver_on_receive(optional_receive_handler p_callback) override
   {
     handler = p_callback;
   }
+
+  void driver_on_receive_batch(
+    optional_batch_receive_handler p_callback,
+    hal::can_interrupt::batch_settings const& p_settings) override
+  {
+    batch_handler = p_callback;
+    received_settings = p_settings;
+  }
 };
 }  // namespace
 
@@ -264,6 +305,47 @@ boost::ut::suite<"can_interrupt"> can_interrupt_test = []() {
                          expected_can_message);
     expect(that % 1 == call_count);
   };
+
+  "::on_receive_batch()"_test = [&]() {
+    // Setup
+    test_can_interrupt test;
+    usize received = 0;
+    hal::can_interrupt::batch_settings const settings{
+      .max_frames = 16,
+      .max_latency = std::chrono::microseconds(200),
+      .deliver_on_drain = false,
+    };
+
+    // Exercise
+    test.on_receive_batch(
+      [&received](std::span<can_message const> p_messages) {
+        received += p_messages.size();
+      },
+      settings);
+
+    // Verify
+    expect(that % test.batch_handler.has_value());
+    expect(settings == test.received_settings);
+    std::array const batch{ expected_can_message, expected_can_message };
+    test.batch_handler.value()(batch);
+    expect(that % 2 == received);
+  };
+
+  "::on_receive_batch() not supported by default"_test = [&]() {
+    // Setup
+    struct per_message_only : public hal::can_interrupt
+    {
+    private:
+      void driver_on_receive(optional_receive_handler) override
+      {
+      }
+    };
+    per_message_only test;
+
+    // Exercise + Verify
+    expect(throws<hal::operation_not_supported>(
+      [&]() { test.on_receive_batch(std::nullopt, {}); }));
+  };
 };
 
 namespace {
@@ -548,4 +630,158 @@ boost::ut::suite<"can_identifier_filter"> can_identifier_filter_test = []() {
     expect(expected_pair == test.id.value());
   };
 };
+
+namespace {
+struct test_can_bus_statistics : public hal::can_bus_statistics
+{
+public:
+  statistics current{};
+  std::array<u64, 4> timestamps{ 10, 20, 30, 40 };
+
+private:
+  statistics driver_read() override
+  {
+    return current;
+  }
+  void driver_reset() override
+  {
+    current.frames_sent = 0;
+    current.frames_received = 0;
+    current.bus_errors = 0;
+    current.arbitration_lost = 0;
+    current.receive_overruns = 0;
+    current.transmit_mailboxes_high_water = current.transmit_mailboxes_used;
+  }
+  std::span<u64 const> driver_receive_timestamps() override
+  {
+    return timestamps;
+  }
+};
+
+struct test_can_bus_statistics_no_timestamps : public hal::can_bus_statistics
+{
+private:
+  statistics driver_read() override
+  {
+    return {};
+  }
+  void driver_reset() override
+  {
+  }
+};
+}  // namespace
+
+boost::ut::suite<"can_bus_statistics"> can_bus_statistics_test = []() {
+  using namespace boost::ut;
+
+  "::read() & ::reset()"_test = []() {
+    // Setup
+    constexpr hal::can_bus_statistics::statistics expected{
+      .frames_sent = 1000,
+      .frames_received = 2000,
+      .transmit_error_counter = 8,
+      .receive_error_counter = 1,
+      .bus_errors = 3,
+      .arbitration_lost = 12,
+      .receive_overruns = 2,
+      .transmit_mailboxes_used = 1,
+      .transmit_mailboxes_high_water = 3,
+      .transmit_mailboxes = 3,
+    };
+    test_can_bus_statistics test;
+    test.current = expected;
+
+    // Exercise
+    auto const before = test.read();
+    test.reset();
+    auto const after = test.read();
+
+    // Verify
+    expect(expected == before);
+    expect(that % 0 == after.frames_sent);
+    expect(that % 0 == after.arbitration_lost);
+    expect(that % 8 == after.transmit_error_counter);
+    expect(that % 1 == after.transmit_mailboxes_high_water);
+  };
+
+  "::receive_timestamps()"_test = []() {
+    // Setup
+    test_can_bus_statistics test;
+    test_can_bus_statistics_no_timestamps no_timestamps;
+
+    // Exercise
+    auto const timestamps = test.receive_timestamps();
+    auto const unsupported = no_timestamps.receive_timestamps();
+
+    // Verify
+    expect(that % 4 == timestamps.size());
+    expect(that % 30 == timestamps[2]);
+    expect(that % unsupported.empty());
+  };
+};
+
+boost::ut::suite<"can_message"> can_message_test = []() {
+  using namespace boost::ut;
+
+  "can_message::operator==() ignores bytes past length"_test = []() {
+    // Setup
+    auto stale = expected_can_message;
+    stale.payload[3] = 0xAA;
+    stale.payload[7] = 0xBB;
+
+    // Exercise & Verify
+    static_assert(expected_can_message == expected_can_message);
+    expect(expected_can_message == stale);
+    expect(expected_can_message.packed_key() == stale.packed_key());
+  };
+
+  "can_message::operator==() detects each field"_test = []() {
+    // Setup
+    auto id = expected_can_message;
+    auto extended = expected_can_message;
+    auto remote_request = expected_can_message;
+    auto length = expected_can_message;
+    auto payload = expected_can_message;
+    auto last_byte = expected_can_message;
+    id.id = 23;
+    extended.extended = true;
+    remote_request.remote_request = true;
+    length.length = 2;
+    payload.payload[2] = 0xEF;
+    last_byte.length = 8;
+    auto last_byte_changed = last_byte;
+    last_byte_changed.payload[7] = 0x01;
+
+    // Exercise & Verify
+    expect(expected_can_message != id);
+    expect(expected_can_message != extended);
+    expect(expected_can_message != remote_request);
+    expect(expected_can_message != length);
+    expect(expected_can_message != payload);
+    expect(last_byte != last_byte_changed);
+  };
+
+  "can_message_hash"_test = []() {
+    // Setup
+    auto stale = expected_can_message;
+    stale.payload[5] = 0xAA;
+    auto other = expected_can_message;
+    other.id = 23;
+    std::unordered_set<can_message> seen;
+
+    // Exercise
+    seen.insert(expected_can_message);
+    auto const duplicate = seen.insert(stale).second;
+    auto const unique = seen.insert(other).second;
+
+    // Verify
+    expect(can_message_hash{}(expected_can_message) ==
+           can_message_hash{}(stale));
+    expect(can_message_hash{}(expected_can_message) !=
+           can_message_hash{}(other));
+    expect(not duplicate);
+    expect(unique);
+    expect(that % 2 == seen.size());
+  };
+};
 }  // namespace hal
@@ -0,0 +1,185 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+
+#include <libhal/can_fd.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_can_fd_transceiver : public hal::can_fd_transceiver
+{
+public:
+  alignas(can_fd_slot_alignment) std::array<hal::byte, 96> m_buffer{};
+  usize m_cursor = 0;
+  can_fd_message m_sent{};
+
+  void receive(can_fd_message const& p_message)
+  {
+    m_cursor = write_can_fd_slot(m_buffer, m_cursor, p_message);
+  }
+
+private:
+  u32 driver_baud_rate() override
+  {
+    return 1'000'000;
+  }
+
+  u32 driver_data_baud_rate() override
+  {
+    return 5'000'000;
+  }
+
+  void driver_send(can_fd_message const& p_message) override
+  {
+    m_sent = p_message;
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return m_buffer;
+  }
+
+  usize driver_receive_cursor() override
+  {
+    return m_cursor;
+  }
+};
+
+can_fd_message make_message(u32 p_id, u8 p_length)
+{
+  can_fd_message message{ .id = p_id, .length = p_length };
+  for (usize i = 0; i < p_length; i++) {
+    message.payload[i] = static_cast<hal::byte>(i + 1);
+  }
+  return message;
+}
+}  // namespace
+
+boost::ut::suite<"can_fd_test"> can_fd_test = []() {
+  using namespace boost::ut;
+
+  "can_fd_slot_size()"_test = []() {
+    // Exercise & Verify
+    expect(that % 8 == can_fd_slot_size(0));
+    expect(that % 16 == can_fd_slot_size(1));
+    expect(that % 16 == can_fd_slot_size(8));
+    expect(that % 24 == can_fd_slot_size(12));
+    expect(that % 72 == can_fd_slot_size(64));
+    expect(that % 72 == can_fd_slot_size(200));
+  };
+
+  "can_fd_message::operator==() ignores bytes past length"_test = []() {
+    // Setup
+    auto first = make_message(0x100, 2);
+    auto second = make_message(0x100, 2);
+    first.payload[5] = 0xAA;
+
+    // Exercise & Verify
+    expect(first == second);
+    second.bit_rate_switch = false;
+    expect(first != second);
+  };
+
+  "can_fd_transceiver interface"_test = []() {
+    // Setup
+    test_can_fd_transceiver test;
+    auto const message = make_message(0x100, 12);
+
+    // Exercise
+    test.send(message);
+
+    // Verify
+    expect(that % 1'000'000 == test.baud_rate());
+    expect(that % 5'000'000 == test.data_baud_rate());
+    expect(message == test.m_sent);
+  };
+
+  "can_fd_reader::read() round trips messages"_test = []() {
+    // Setup
+    test_can_fd_transceiver test;
+    can_fd_reader reader(test);
+    auto classic = make_message(0x123, 8);
+    classic.fd_format = false;
+    classic.bit_rate_switch = false;
+    auto extended = make_message(0x18DA'F110, 48);
+    extended.extended = true;
+    extended.error_state_indicator = true;
+
+    // Exercise
+    test.receive(classic);
+    test.receive(extended);
+    auto const first = reader.read();
+    auto const second = reader.read();
+    auto const third = reader.read();
+
+    // Verify
+    expect(that % 72 == test.m_cursor);
+    expect(first.has_value());
+    expect(that % 8 == first->payload.size());
+    expect(classic == first->message());
+    expect(second.has_value());
+    expect(that % 48 == second->payload.size());
+    expect(extended == second->message());
+    expect(not third.has_value());
+  };
+
+  "can_fd_reader::read() skips padding at the end"_test = []() {
+    // Setup
+    test_can_fd_transceiver test;
+    can_fd_reader reader(test);
+    auto const full = make_message(0x100, 64);
+    auto const small = make_message(0x200, 20);
+
+    // Exercise
+    test.receive(full);
+    auto const first = reader.read()->message();
+    test.receive(small);
+    auto const second = reader.read();
+    auto const third = reader.read();
+
+    // Verify
+    expect(that % 32 == test.m_cursor);
+    expect(full == first);
+    expect(second.has_value());
+    expect(small == second->message());
+    expect(that % 0 == second->payload.data() - test.m_buffer.data() - 8);
+    expect(not third.has_value());
+  };
+
+  "can_fd_reader::read() only returns new messages"_test = []() {
+    // Setup
+    test_can_fd_transceiver test;
+    test.receive(make_message(0x100, 4));
+    can_fd_reader reader(test);
+
+    // Exercise
+    auto const first = reader.read();
+    test.receive(make_message(0x200, 4));
+    auto const second = reader.read();
+    test.receive(make_message(0x300, 4));
+    reader.skip();
+    auto const third = reader.read();
+
+    // Verify
+    expect(not first.has_value());
+    expect(second.has_value());
+    expect(that % 0x200 == second->header.id);
+    expect(not third.has_value());
+  };
+};
+}  // namespace hal
@@ -0,0 +1,219 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory_resource>
+#include <optional>
+#include <span>
+
+#include <libhal/can.hpp>
+#include <libhal/can_filter_planner.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+std::pmr::monotonic_buffer_resource test_buffer{ 4096 };
+std::pmr::polymorphic_allocator<byte> test_allocator{ &test_buffer };
+
+template<class Filter, typename Setting>
+struct test_filter : public Filter
+{
+public:
+  std::optional<Setting> setting;
+
+private:
+  void driver_allow(std::optional<Setting> p_setting) override
+  {
+    setting = p_setting;
+  }
+};
+
+using test_identifier_filter = test_filter<can_identifier_filter, u16>;
+using test_mask_filter = test_filter<can_mask_filter, can_mask_filter::pair>;
+using test_range_filter =
+  test_filter<can_range_filter, can_range_filter::pair>;
+using test_extended_mask_filter =
+  test_filter<can_extended_mask_filter, can_extended_mask_filter::pair>;
+
+constexpr std::span<can_identifier_filter* const> no_identifiers{};
+constexpr std::span<can_mask_filter* const> no_masks{};
+constexpr std::span<can_range_filter* const> no_ranges{};
+}  // namespace
+
+boost::ut::suite<"can_filter_planner_test"> can_filter_planner_test = []() {
+  using namespace boost::ut;
+
+  "configure_can_filters() with identifier filters"_test = []() {
+    // Setup
+    test_identifier_filter id0;
+    test_identifier_filter id1;
+    test_mask_filter mask0;
+    mask0.setting = can_mask_filter::pair{ .id = 0x1, .mask = 0x1 };
+    std::array<can_identifier_filter*, 2> identifiers{ &id0, &id1 };
+    std::array<can_mask_filter*, 1> masks{ &mask0 };
+    constexpr auto ids = std::to_array<u16>({ 0x200, 0x100 });
+
+    // Exercise
+    auto const plan =
+      configure_can_filters(test_allocator, ids, identifiers, masks, no_ranges);
+
+    // Verify
+    expect(that % 2 == plan.requested);
+    expect(that % 2 == plan.accepted);
+    expect(that % 0 == plan.uncovered);
+    expect(that % 0.0f == plan.false_accept_rate());
+    expect(that % 0x100 == id0.setting.value());
+    expect(that % 0x200 == id1.setting.value());
+    expect(not mask0.setting.has_value());
+  };
+
+  "configure_can_filters() ignores duplicates"_test = []() {
+    // Setup
+    test_identifier_filter id0;
+    test_identifier_filter id1;
+    id1.setting = 0x7FF;
+    std::array<can_identifier_filter*, 2> identifiers{ &id0, &id1 };
+    constexpr auto ids = std::to_array<u16>({ 0x010, 0x010 });
+
+    // Exercise
+    auto const plan = configure_can_filters(
+      test_allocator, ids, identifiers, no_masks, no_ranges);
+
+    // Verify
+    expect(that % 1 == plan.requested);
+    expect(that % 0x010 == id0.setting.value());
+    expect(not id1.setting.has_value());
+  };
+
+  "configure_can_filters() groups consecutive ids into a range"_test = []() {
+    // Setup
+    test_identifier_filter id0;
+    test_range_filter range0;
+    std::array<can_identifier_filter*, 1> identifiers{ &id0 };
+    std::array<can_range_filter*, 1> ranges{ &range0 };
+    constexpr auto ids =
+      std::to_array<u16>({ 0x101, 0x500, 0x100, 0x103, 0x102 });
+
+    // Exercise
+    auto const plan =
+      configure_can_filters(test_allocator, ids, identifiers, no_masks, ranges);
+
+    // Verify
+    expect(that % 5 == plan.requested);
+    expect(that % 5 == plan.accepted);
+    expect(that % 0.0f == plan.false_accept_rate());
+    expect(that % 0x500 == id0.setting.value());
+    expect(can_range_filter::pair{ .id_1 = 0x100, .id_2 = 0x103 } ==
+           range0.setting.value());
+  };
+
+  "configure_can_filters() prefers the tighter filter"_test = []() {
+    // Setup
+    test_mask_filter mask0;
+    test_range_filter range0;
+    std::array<can_mask_filter*, 1> masks{ &mask0 };
+    std::array<can_range_filter*, 1> ranges{ &range0 };
+    constexpr auto ids = std::to_array<u16>({ 0x120, 0x130, 0x300, 0x301 });
+
+    // Exercise
+    auto const plan =
+      configure_can_filters(test_allocator, ids, no_identifiers, masks, ranges);
+
+    // Verify
+    expect(that % 4 == plan.accepted);
+    expect(can_mask_filter::pair{ .id = 0x120, .mask = 0x7EF } ==
+           mask0.setting.value());
+    expect(can_range_filter::pair{ .id_1 = 0x300, .id_2 = 0x301 } ==
+           range0.setting.value());
+  };
+
+  "configure_can_filters() reports false accepts"_test = []() {
+    // Setup
+    test_range_filter range0;
+    std::array<can_range_filter*, 1> ranges{ &range0 };
+    constexpr auto ids = std::to_array<u16>({ 0x100, 0x104 });
+
+    // Exercise
+    auto const plan = configure_can_filters(
+      test_allocator, ids, no_identifiers, no_masks, ranges);
+
+    // Verify
+    expect(that % 2 == plan.requested);
+    expect(that % 5 == plan.accepted);
+    expect(that % 0 == plan.uncovered);
+    expect(that % 0.6f == plan.false_accept_rate());
+    expect(can_range_filter::pair{ .id_1 = 0x100, .id_2 = 0x104 } ==
+           range0.setting.value());
+  };
+
+  "configure_can_filters() merges the closest ids first"_test = []() {
+    // Setup
+    test_range_filter range0;
+    test_range_filter range1;
+    std::array<can_range_filter*, 2> ranges{ &range0, &range1 };
+    constexpr auto ids = std::to_array<u16>({ 0x100, 0x102, 0x400, 0x401 });
+
+    // Exercise
+    auto const plan = configure_can_filters(
+      test_allocator, ids, no_identifiers, no_masks, ranges);
+
+    // Verify
+    expect(that % 5 == plan.accepted);
+    expect(can_range_filter::pair{ .id_1 = 0x100, .id_2 = 0x102 } ==
+           range0.setting.value());
+    expect(can_range_filter::pair{ .id_1 = 0x400, .id_2 = 0x401 } ==
+           range1.setting.value());
+  };
+
+  "configure_can_filters() reports uncovered ids"_test = []() {
+    // Setup
+    test_identifier_filter id0;
+    test_identifier_filter id1;
+    std::array<can_identifier_filter*, 2> identifiers{ &id0, &id1 };
+    constexpr auto ids = std::to_array<u16>({ 0x001, 0x002, 0x003 });
+
+    // Exercise
+    auto const plan = configure_can_filters(
+      test_allocator, ids, identifiers, no_masks, no_ranges);
+
+    // Verify
+    expect(that % 3 == plan.requested);
+    expect(that % 2 == plan.accepted);
+    expect(that % 1 == plan.uncovered);
+    expect(that % 0.0f == plan.false_accept_rate());
+  };
+
+  "configure_can_filters() with extended ids"_test = []() {
+    // Setup
+    test_extended_mask_filter mask0;
+    std::array<can_extended_mask_filter*, 1> masks{ &mask0 };
+    constexpr auto ids = std::to_array<u32>({ 0x18DA'F111, 0x18DA'F110 });
+
+    // Exercise
+    auto const plan = configure_can_filters(
+      test_allocator,
+      ids,
+      std::span<can_extended_identifier_filter* const>{},
+      masks,
+      std::span<can_extended_range_filter* const>{});
+
+    // Verify
+    expect(that % 2 == plan.accepted);
+    expect(can_extended_mask_filter::pair{ .id = 0x18DA'F110,
+                                           .mask = 0x1FFF'FFFE } ==
+           mask0.setting.value());
+  };
+};
+}  // namespace hal
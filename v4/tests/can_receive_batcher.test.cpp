@@ -0,0 +1,169 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <span>
+#include <vector>
+
+#include <libhal/can_receive_batcher.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+using namespace std::chrono_literals;
+
+/// Records the ID of the first message and the size of every batch
+struct batch_recorder
+{
+  std::vector<usize> sizes;
+  std::vector<u32> first_ids;
+
+  can_interrupt::optional_batch_receive_handler handler()
+  {
+    return [this](std::span<can_message const> p_messages) {
+      sizes.push_back(p_messages.size());
+      first_ids.push_back(p_messages[0].id);
+    };
+  }
+};
+
+constexpr can_message message_with_id(u32 p_id)
+{
+  return { .id = p_id };
+}
+}  // namespace
+
+boost::ut::suite<"can_receive_batcher_test"> can_receive_batcher_test = []() {
+  using namespace boost::ut;
+
+  "delivers once the frame count is reached"_test = []() {
+    // Setup
+    batch_recorder recorder;
+    can_receive_batcher<8> test;
+    test.configure(recorder.handler(),
+                   { .max_frames = 3, .max_latency = 1s });
+
+    // Exercise
+    for (u32 id = 0; id < 7; id++) {
+      test.received(message_with_id(id), 0ms);
+    }
+
+    // Verify
+    expect(that % 2 == recorder.sizes.size());
+    expect(that % 3 == recorder.sizes[0]);
+    expect(that % 3 == recorder.sizes[1]);
+    expect(that % 3 == recorder.first_ids[1]);
+    expect(that % 1 == test.pending());
+  };
+
+  "draining the fifo delivers a partial batch"_test = []() {
+    // Setup
+    batch_recorder recorder;
+    can_receive_batcher<8> test;
+    test.configure(recorder.handler(), {});
+
+    // Exercise
+    test.received(message_with_id(1), 0ms);
+    test.received(message_with_id(2), 0ms);
+    test.drained(0ms);
+    test.drained(0ms);
+
+    // Verify
+    expect(that % 1 == recorder.sizes.size()) << "Nothing left to deliver";
+    expect(that % 2 == recorder.sizes[0]);
+    expect(that % 0 == test.pending());
+  };
+
+  "without delivery on drain, the latency threshold applies"_test = []() {
+    // Setup
+    batch_recorder recorder;
+    can_receive_batcher<8> test;
+    test.configure(
+      recorder.handler(),
+      { .max_frames = 8, .max_latency = 500us, .deliver_on_drain = false });
+
+    // Exercise
+    test.received(message_with_id(1), 100us);
+    test.drained(100us);
+    auto const deadline = test.deadline();
+    test.received(message_with_id(2), 400us);
+    test.drained(400us);
+    auto const delivered_early = recorder.sizes.size();
+    test.poll(600us);
+
+    // Verify
+    expect(that % 0 == delivered_early);
+    expect(deadline.has_value() && 600us == deadline.value());
+    expect(that % 1 == recorder.sizes.size());
+    expect(that % 2 == recorder.sizes[0]);
+    expect(not test.deadline().has_value());
+  };
+
+  "a late message delivers the batch it joins"_test = []() {
+    // Setup
+    batch_recorder recorder;
+    can_receive_batcher<8> test;
+    test.configure(
+      recorder.handler(),
+      { .max_frames = 8, .max_latency = 1ms, .deliver_on_drain = false });
+
+    // Exercise
+    test.received(message_with_id(1), 0ms);
+    test.received(message_with_id(2), 3ms);
+
+    // Verify
+    expect(that % 1 == recorder.sizes.size());
+    expect(that % 2 == recorder.sizes[0]);
+  };
+
+  "frame count is clamped to the capacity"_test = []() {
+    // Setup
+    batch_recorder recorder;
+    can_receive_batcher<4> test;
+
+    // Exercise
+    test.configure(recorder.handler(), { .max_frames = 100 });
+    auto const clamped_high = test.configuration().max_frames;
+    test.configure(recorder.handler(), { .max_frames = 0 });
+    auto const clamped_low = test.configuration().max_frames;
+
+    // Verify
+    expect(that % 4 == clamped_high);
+    expect(that % 1 == clamped_low);
+  };
+
+  "reconfiguring delivers pending messages to the previous handler"_test =
+    []() {
+      // Setup
+      batch_recorder previous;
+      batch_recorder next;
+      can_receive_batcher<8> test;
+      test.configure(previous.handler(), {});
+      test.received(message_with_id(5), 0ms);
+
+      // Exercise
+      test.configure(next.handler(), {});
+      test.configure(std::nullopt, {});
+      test.received(message_with_id(6), 0ms);
+      test.drained(0ms);
+
+      // Verify
+      expect(that % 1 == previous.sizes.size());
+      expect(that % 5 == previous.first_ids[0]);
+      expect(that % 0 == next.sizes.size());
+      expect(that % 0 == test.pending()) << "Disabled batcher keeps nothing";
+    };
+};
+}  // namespace hal
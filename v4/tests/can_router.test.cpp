@@ -0,0 +1,211 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <optional>
+#include <span>
+
+#include <libhal/can.hpp>
+#include <libhal/can_router.hpp>
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_can_transceiver : public hal::can_transceiver
+{
+public:
+  std::array<can_message, 4> m_buffer{};
+  usize m_cursor = 0;
+
+  void receive(can_message const& p_message)
+  {
+    m_buffer[m_cursor] = p_message;
+    m_cursor = (m_cursor + 1) % m_buffer.size();
+  }
+
+private:
+  u32 driver_baud_rate() override
+  {
+    return 1'000'000;
+  }
+
+  void driver_send(can_message const&) override
+  {
+  }
+
+  std::span<can_message const> driver_receive_buffer() override
+  {
+    return m_buffer;
+  }
+
+  usize driver_receive_cursor() override
+  {
+    return m_cursor;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"can_router_test"> can_router_test = []() {
+  using namespace boost::ut;
+
+  "can_router::poll() dispatches by id"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    can_router<4> router(transceiver);
+    usize first_count = 0;
+    usize second_count = 0;
+    u32 last_id = 0;
+    router.route(0x100, [&](can_message const& p_message) {
+      first_count++;
+      last_id = p_message.id;
+    });
+    router.route(0x200, [&](can_message const& p_message) {
+      second_count++;
+      last_id = p_message.id;
+    });
+
+    // Exercise
+    transceiver.receive({ .id = 0x100 });
+    transceiver.receive({ .id = 0x200 });
+    transceiver.receive({ .id = 0x100 });
+    auto const routed = router.poll();
+
+    // Verify
+    expect(that % 3 == routed);
+    expect(that % 2 == first_count);
+    expect(that % 1 == second_count);
+    expect(that % 0x100 == last_id);
+    expect(that % 2 == router.size());
+  };
+
+  "can_router::poll() only dispatches new messages"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    transceiver.receive({ .id = 0x100 });
+    can_router<4> router(transceiver);
+    usize count = 0;
+    router.route(0x100, [&](can_message const&) { count++; });
+
+    // Exercise
+    auto const first = router.poll();
+    transceiver.receive({ .id = 0x100 });
+    transceiver.receive({ .id = 0x100 });
+    transceiver.receive({ .id = 0x100 });
+    auto const second = router.poll();
+    auto const third = router.poll();
+
+    // Verify
+    expect(that % 0 == first);
+    expect(that % 3 == second);
+    expect(that % 0 == third);
+    expect(that % 3 == count);
+  };
+
+  "can_router::poll() distinguishes extended ids"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    can_router<2> router(transceiver);
+    usize standard = 0;
+    usize extended = 0;
+    router.route(0x123, [&](can_message const&) { standard++; });
+    router.route(0x123, [&](can_message const&) { extended++; }, true);
+
+    // Exercise
+    transceiver.receive({ .id = 0x123, .extended = true });
+    transceiver.receive({ .id = 0x123, .extended = true });
+    transceiver.receive({ .id = 0x123 });
+    router.poll();
+
+    // Verify
+    expect(that % 1 == standard);
+    expect(that % 2 == extended);
+  };
+
+  "can_router::unrouted()"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    can_router<2> router(transceiver);
+    usize unrouted = 0;
+    router.route(0x100, [](can_message const&) {});
+    router.unrouted([&](can_message const&) { unrouted++; });
+
+    // Exercise
+    transceiver.receive({ .id = 0x100 });
+    transceiver.receive({ .id = 0x101 });
+    transceiver.receive({ .id = 0x102 });
+    auto const routed = router.poll();
+
+    // Verify
+    expect(that % 1 == routed);
+    expect(that % 2 == unrouted);
+  };
+
+  "can_router::route() replaces handler"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    can_router<1> router(transceiver);
+    usize first = 0;
+    usize second = 0;
+    router.route(0x100, [&](can_message const&) { first++; });
+
+    // Exercise
+    router.route(0x100, [&](can_message const&) { second++; });
+    transceiver.receive({ .id = 0x100 });
+    router.poll();
+
+    // Verify
+    expect(that % 0 == first);
+    expect(that % 1 == second);
+    expect(that % 1 == router.size());
+  };
+
+  "can_router::route() throws when full"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    can_router<2> router(transceiver);
+    router.route(0x100, [](can_message const&) {});
+    router.route(0x101, [](can_message const&) {});
+
+    // Exercise & Verify
+    expect(throws<hal::out_of_range>(
+      [&]() { router.route(0x102, [](can_message const&) {}); }));
+    expect(that % 2 == router.size());
+  };
+
+  "can_router::route() many sequential ids"_test = []() {
+    // Setup
+    test_can_transceiver transceiver;
+    can_router<16> router(transceiver);
+    std::array<usize, 16> counts{};
+    for (u32 i = 0; i < counts.size(); i++) {
+      router.route(0x700 + i, [&counts, i](can_message const&) {
+        counts[i]++;
+      });
+    }
+
+    // Exercise
+    for (u32 i = 0; i < counts.size(); i++) {
+      transceiver.receive({ .id = 0x700 + i });
+      router.poll();
+    }
+
+    // Verify
+    for (auto const count : counts) {
+      expect(that % 1 == count);
+    }
+  };
+};
+}  // namespace hal
@@ -12,9 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
 #include <memory_resource>
+#include <span>
+#include <utility>
 
 #include <libhal/circular_buffer.hpp>
+#include <libhal/scatter_span.hpp>
 #include <libhal/units.hpp>
 
 #include "helpers.hpp"
@@ -58,7 +62,8 @@ boost::ut::suite<"circular_buffer_test"> circular_buffer_test = []() {
     expect(that % 2 == buffer3[1]);
     expect(that % 3 == buffer3[2]);
     expect(that % 4 == buffer3[3]);
-    expect(that % 4 == buffer3.write_index());
+    expect(that % 0 == buffer3.write_index())
+      << "A full list must wrap the write index back to the oldest element";
 
     // Test minimum capacity of 1
     auto buffer4 = make_circular_buffer<test_class>(test_allocator, 0);
@@ -239,6 +244,239 @@ boost::ut::suite<"circular_buffer_test"> circular_buffer_test = []() {
     expect(that % 1 == buffer.write_index());
   };
 
+  "push_range"_test = [&] {
+    auto buffer = make_circular_buffer<int>(test_allocator, 5);
+    auto const first = std::to_array({ 1, 2, 3 });
+    auto const second = std::to_array({ 4, 5, 6, 7 });
+
+    // Push without wrapping
+    buffer.push_range(first);
+    expect(that % 3 == buffer.write_index());
+    expect(that % 1 == buffer[0]);
+    expect(that % 2 == buffer[1]);
+    expect(that % 3 == buffer[2]);
+
+    // Push across the end of the buffer
+    buffer.push_range(second);
+    expect(that % 2 == buffer.write_index());
+    expect(that % 6 == buffer[0]);
+    expect(that % 7 == buffer[1]);
+    expect(that % 3 == buffer[2]);
+    expect(that % 4 == buffer[3]);
+    expect(that % 5 == buffer[4]);
+
+    // Push an empty range
+    buffer.push_range({});
+    expect(that % 2 == buffer.write_index());
+
+    // Push exactly to the end of the buffer
+    buffer.push_range(std::to_array({ 8, 9, 10 }));
+    expect(that % 0 == buffer.write_index());
+  };
+
+  "push_range_larger_than_capacity"_test = [&] {
+    auto buffer = make_circular_buffer<int>(test_allocator, 3);
+    auto reference_buffer = make_circular_buffer<int>(test_allocator, 3);
+    auto const values = std::to_array({ 1, 2, 3, 4, 5, 6, 7, 8 });
+
+    buffer.push(100);
+    reference_buffer.push(100);
+
+    // Exercise
+    buffer.push_range(values);
+    for (auto const value : values) {
+      reference_buffer.push(value);
+    }
+
+    // Verify
+    expect(that % reference_buffer.write_index() == buffer.write_index());
+    expect(that % reference_buffer[0] == buffer[0]);
+    expect(that % reference_buffer[1] == buffer[1]);
+    expect(that % reference_buffer[2] == buffer[2]);
+  };
+
+  "contiguous_spans"_test = [&] {
+    auto buffer = make_circular_buffer<int>(test_allocator, 4);
+    buffer.push_range(std::to_array({ 1, 2, 3, 4 }));
+
+    // Write index is at 0, so everything is in one span
+    auto [oldest, newest] = buffer.contiguous_spans();
+    expect(that % 4 == oldest.size());
+    expect(that % 0 == newest.size());
+    expect(that % 1 == oldest[0]);
+    expect(that % 4 == oldest[3]);
+
+    buffer.push(5);
+    buffer.push(6);
+
+    auto [oldest2, newest2] = buffer.contiguous_spans();
+    expect(that % 2 == oldest2.size());
+    expect(that % 2 == newest2.size());
+    expect(that % 3 == oldest2[0]);
+    expect(that % 4 == oldest2[1]);
+    expect(that % 5 == newest2[0]);
+    expect(that % 6 == newest2[1]);
+
+    // Spans can be used as a scatter span
+    auto const spans = std::as_const(buffer).contiguous_spans();
+    auto const expected = std::to_array({ 3, 4, 5, 6 });
+    auto const expected_list =
+      std::to_array<std::span<int const>>({ expected });
+    expect(scatter_span<int const>(spans) ==
+           scatter_span<int const>(expected_list));
+  };
+
+  "power_of_two_capacity"_test = [&] {
+    // Capacities are rounded up to the next power of two
+    auto buffer =
+      make_circular_buffer<int, circular_buffer_capacity::power_of_two>(
+        test_allocator, 5);
+    expect(that % 8 == buffer.capacity());
+
+    auto buffer2 = circular_buffer_pow2<int>(test_allocator, 4);
+    expect(that % 4 == buffer2.capacity());
+
+    auto buffer3 = circular_buffer_pow2<int>(test_allocator, 0);
+    expect(that % 1 == buffer3.capacity());
+
+    auto buffer4 = circular_buffer_pow2<test_class>(
+      test_allocator, { test_class(1), test_class(2), test_class(3) });
+    expect(that % 4 == buffer4.capacity());
+    expect(that % 3 == buffer4.write_index());
+    expect(that % 1 == buffer4[0].value());
+    expect(that % 3 == buffer4[2].value());
+    expect(that % 0 == buffer4[3].value())
+      << "Padding slot should be default constructed";
+  };
+
+  "power_of_two_wrapping"_test = [&] {
+    auto buffer = circular_buffer_pow2<int>(test_allocator, 4);
+    auto reference_buffer = make_circular_buffer<int>(test_allocator, 4);
+
+    for (int i = 0; i < 11; ++i) {
+      buffer.push(i);
+      reference_buffer.push(i);
+    }
+    buffer.push_range(std::to_array({ 20, 21, 22, 23, 24, 25 }));
+    reference_buffer.push_range(std::to_array({ 20, 21, 22, 23, 24, 25 }));
+    buffer.emplace(30);
+    reference_buffer.emplace(30);
+
+    expect(that % reference_buffer.write_index() == buffer.write_index());
+    for (usize i = 0; i < 9; ++i) {
+      expect(that % reference_buffer[i] == buffer[i]);
+    }
+  };
+
+  "lazy_construction"_test = [&] {
+    expect(that % 0 == test_class::s_instance_count);
+
+    {
+      circular_buffer<test_class> buffer(
+        test_allocator, 3, lazy_construct_tag{});
+      expect(that % 3 == buffer.capacity());
+      expect(that % 0 == buffer.size());
+      expect(that % 0 == test_class::s_instance_count)
+        << "No elements should be constructed up front";
+
+      test_class const twenty(20);
+      buffer.emplace(10);
+      buffer.push(twenty);
+      expect(that % 2 == buffer.size());
+      expect(that % 3 == test_class::s_instance_count);
+
+      auto [oldest, newest] = buffer.contiguous_spans();
+      expect(that % 2 == oldest.size());
+      expect(that % 0 == newest.size());
+      expect(that % 10 == oldest[0].value());
+      expect(that % 20 == oldest[1].value());
+
+      test_class const thirty(30);
+      buffer.push(thirty);
+      buffer.push(test_class(40));
+      expect(that % 3 == buffer.size());
+      expect(that % 5 == test_class::s_instance_count)
+        << "Three elements in the buffer plus two locals";
+      expect(that % 40 == buffer[0].value());
+      expect(that % 20 == buffer[1].value());
+      expect(that % 30 == buffer[2].value());
+    }
+
+    expect(that % 0 == test_class::s_instance_count)
+      << "Only constructed elements should be destroyed";
+  };
+
+  "lazy_construction_push_range"_test = [&] {
+    circular_buffer<std::string> buffer(
+      test_allocator, 4, lazy_construct_tag{});
+    auto const first = std::to_array<std::string>({ "a", "b" });
+    auto const second = std::to_array<std::string>({ "c", "d", "e" });
+
+    buffer.push_range(first);
+    expect(that % 2 == buffer.size());
+
+    buffer.push_range(second);
+    expect(that % 4 == buffer.size());
+    expect(that % 1 == buffer.write_index());
+    expect(that % std::string_view("e") == buffer[0]);
+    expect(that % std::string_view("b") == buffer[1]);
+    expect(that % std::string_view("c") == buffer[2]);
+    expect(that % std::string_view("d") == buffer[3]);
+
+    // Skipping past unconstructed slots must still construct every slot
+    circular_buffer<std::string> buffer2(
+      test_allocator, 3, lazy_construct_tag{});
+    buffer2.push("x");
+    auto const many = std::to_array<std::string>({ "1", "2", "3", "4", "5" });
+    buffer2.push_range(many);
+    expect(that % 3 == buffer2.size());
+    expect(that % 0 == buffer2.write_index());
+    expect(that % std::string_view("3") == buffer2[0]);
+    expect(that % std::string_view("4") == buffer2[1]);
+    expect(that % std::string_view("5") == buffer2[2]);
+  };
+
+  "lazy_construction_non_default_constructible"_test = [&] {
+    struct payload
+    {
+      explicit payload(int p_value)
+        : value(p_value)
+      {
+      }
+      int value;
+    };
+
+    static_assert(not std::is_default_constructible_v<payload>);
+
+    circular_buffer<payload> buffer(test_allocator, 2, lazy_construct_tag{});
+    buffer.emplace(1);
+    buffer.emplace(2);
+    buffer.emplace(3);
+
+    expect(that % 3 == buffer[0].value);
+    expect(that % 2 == buffer[1].value);
+  };
+
+  "push_into_full_initializer_list"_test = [&] {
+    auto buffer = circular_buffer<int>(test_allocator, { 1, 2, 3, 4 });
+
+    buffer.push(5);
+
+    expect(that % 4 == buffer.capacity());
+    expect(that % 4 == buffer.size()) << "Size must never exceed capacity";
+    expect(that % 1 == buffer.write_index());
+    expect(that % 5 == buffer[0]) << "Should overwrite the oldest element";
+    expect(that % 2 == buffer[1]);
+    expect(that % 3 == buffer[2]);
+    expect(that % 4 == buffer[3]);
+  };
+
+  "size"_test = [&] {
+    auto buffer = make_circular_buffer<int>(test_allocator, 4);
+    expect(that % 4 == buffer.size())
+      << "Eagerly constructed buffers are always full";
+  };
+
   "destruction"_test = [&] {
     expect(that % 0 == test_class::s_instance_count)
       << "Should start with no instances";
@@ -0,0 +1,174 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include <libhal/cobs.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+using bytes = std::vector<hal::byte>;
+
+bytes flatten(scatter_span<hal::byte const> p_segments)
+{
+  bytes flat;
+  for (auto const& segment : p_segments) {
+    flat.insert(flat.end(), segment.begin(), segment.end());
+  }
+  return flat;
+}
+
+bytes encode(std::span<hal::byte const> p_payload)
+{
+  cobs_frame<64> frame(p_payload);
+  auto flat = flatten(frame.segments());
+  boost::ut::expect(boost::ut::that % flat.size() == frame.size());
+  return flat;
+}
+
+/// Feed a stream to a deframer in chunks of p_chunk bytes
+std::vector<bytes> deframe(cobs_deframer& p_deframer,
+                           std::span<hal::byte const> p_stream,
+                           usize p_chunk)
+{
+  std::vector<bytes> frames;
+  while (not p_stream.empty()) {
+    auto const chunk = p_stream.first(std::min(p_chunk, p_stream.size()));
+    p_deframer.feed(chunk, [&frames](std::span<hal::byte const> p_frame) {
+      frames.emplace_back(p_frame.begin(), p_frame.end());
+    });
+    p_stream = p_stream.subspan(chunk.size());
+  }
+  return frames;
+}
+
+bytes counting(usize p_size)
+{
+  bytes data(p_size);
+  for (usize i = 0; i < p_size; i++) {
+    data[i] = static_cast<hal::byte>(i % 255 + 1);
+  }
+  return data;
+}
+}  // namespace
+
+boost::ut::suite<"cobs_test"> cobs_test = []() {
+  using namespace boost::ut;
+
+  "cobs_frame encodes the reference vectors"_test = []() {
+    expect(bytes{ 0x01, 0x00 } == encode({}));
+    expect(bytes{ 0x01, 0x01, 0x00 } == encode(bytes{ 0x00 }));
+    expect(bytes{ 0x03, 0x11, 0x22, 0x02, 0x33, 0x00 } ==
+           encode(bytes{ 0x11, 0x22, 0x00, 0x33 }));
+    expect(bytes{ 0x02, 0x11, 0x01, 0x01, 0x01, 0x00 } ==
+           encode(bytes{ 0x11, 0x00, 0x00, 0x00 }));
+
+    auto const full = counting(254);
+    auto expected = bytes{ 0xFF };
+    expected.insert(expected.end(), full.begin(), full.end());
+    expected.push_back(0x00);
+    expect(expected == encode(full));
+
+    auto const longer = counting(255);
+    expected.insert(expected.end() - 1, { 0x02, longer.back() });
+    expect(expected == encode(longer));
+  };
+
+  "cobs_frame encodes across payload segments"_test = []() {
+    // Setup
+    bytes const header{ 0x11, 0x00 };
+    bytes const payload{ 0x22, 0x33 };
+    auto const segments = make_scatter_bytes(header, payload);
+
+    // Exercise
+    cobs_frame frame((scatter_span<hal::byte const>(segments)));
+
+    // Verify
+    expect(bytes{ 0x02, 0x11, 0x03, 0x22, 0x33, 0x00 } ==
+           flatten(frame.segments()));
+  };
+
+  "cobs_frame throws when out of segments"_test = []() {
+    bytes const zeros(4, 0x00);
+    expect(throws<hal::argument_out_of_domain>(
+      [&zeros]() { cobs_frame<4> frame(zeros); }));
+  };
+
+  "cobs_deframer round trips frames at every chunk size"_test = []() {
+    // Setup
+    std::vector<bytes> const payloads{
+      {}, { 0x00 }, { 0x11, 0x22, 0x00, 0x33 }, counting(254), counting(255),
+      counting(600), bytes(5, 0x00),
+    };
+    bytes stream{ 0x00 };
+    for (auto const& payload : payloads) {
+      auto const encoded = encode(payload);
+      stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    std::array<hal::byte, 600> buffer{};
+
+    for (usize chunk : { 1, 3, 8, 64, 4096 }) {
+      // Exercise
+      cobs_deframer deframer(buffer);
+      auto const frames = deframe(deframer, stream, chunk);
+
+      // Verify
+      expect(payloads == frames) << "chunk size" << chunk;
+      expect(that % 0 == deframer.errors());
+    }
+  };
+
+  "cobs_deframer drops malformed and oversized frames"_test = []() {
+    // Setup
+    std::array<hal::byte, 4> buffer{};
+    cobs_deframer deframer(buffer);
+    auto const too_large = encode(counting(5));
+    bytes stream{ 0x05, 0x11, 0x00 };
+    stream.insert(stream.end(), too_large.begin(), too_large.end());
+    auto const fits = encode(bytes{ 0x01, 0x00, 0x02 });
+    stream.insert(stream.end(), fits.begin(), fits.end());
+
+    // Exercise
+    auto const frames = deframe(deframer, stream, 2);
+
+    // Verify
+    expect(std::vector<bytes>{ { 0x01, 0x00, 0x02 } } == frames);
+    expect(that % 2 == deframer.errors());
+    deframer.reset();
+    expect(that % 0 == deframer.errors());
+  };
+
+  "cobs_deframer consumes scatter spans"_test = []() {
+    // Setup
+    std::array<hal::byte, 16> buffer{};
+    cobs_deframer deframer(buffer);
+    bytes const encoded = encode(bytes{ 0x11, 0x00, 0x22 });
+    auto const split = std::span<hal::byte const>(encoded);
+    auto const segments = make_scatter_bytes(split.first(2), split.subspan(2));
+    std::vector<bytes> frames;
+
+    // Exercise
+    deframer.feed(scatter_span<hal::byte const>(segments),
+                  [&frames](std::span<hal::byte const> p_frame) {
+                    frames.emplace_back(p_frame.begin(), p_frame.end());
+                  });
+
+    // Verify
+    expect(std::vector<bytes>{ { 0x11, 0x00, 0x22 } } == frames);
+  };
+};
+}  // namespace hal
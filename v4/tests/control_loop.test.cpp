@@ -0,0 +1,163 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <optional>
+
+#include <libhal/control_loop.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 0;
+  u64 m_step = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    auto const now = m_uptime;
+    m_uptime += m_step;
+    return now;
+  }
+};
+
+class test_interrupt : public hal::timed_interrupt
+{
+public:
+  optional_handler m_handler{};
+  hal::time_duration m_delay{};
+
+  void expire()
+  {
+    auto handler = *m_handler;
+    m_handler.reset();
+    handler(schedule_tag{});
+  }
+
+private:
+  bool driver_scheduled() override
+  {
+    return m_handler.has_value();
+  }
+
+  void driver_schedule(optional_handler const& p_handler,
+                       hal::time_duration p_delay) override
+  {
+    m_handler = p_handler;
+    m_delay = p_delay;
+  }
+};
+
+/// Statically bound sensor, which the loop calls without a virtual call
+struct fake_encoder
+{
+  rotation_sensor::read_t read()
+  {
+    return { .angle = m_angle };
+  }
+  degrees m_angle = 0.0f;
+};
+
+class test_motor : public hal::motor
+{
+public:
+  float m_power = 0.0f;
+
+private:
+  void driver_power(float p_power) override
+  {
+    m_power = p_power;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"control_loop_test"> control_loop_test = []() {
+  using namespace boost::ut;
+  using namespace std::chrono_literals;
+
+  "q16 conversions round to nearest"_test = []() {
+    static_assert(to_q16(1.0f) == 0x1'0000);
+    static_assert(to_q16(-0.5f) == -0x8000);
+    static_assert(from_q16(0x2'8000) == 2.5f);
+    expect(that % 1 == to_q16(1.0f / 65536.0f));
+  };
+
+  "q16_pid clamps output and integral"_test = []() {
+    // Setup
+    q16_pid pid({ .kp = to_q16(0.5f), .ki = to_q16(0.25f) });
+
+    // Exercise
+    auto const first = pid.update(to_q16(1.0f), 0);
+    auto const saturated = pid.update(to_q16(10.0f), 0);
+    // The clamped integral recovers as soon as the error reverses
+    auto const recovered = pid.update(0, to_q16(1.0f));
+
+    // Verify
+    expect(that % to_q16(0.75f) == first);
+    expect(that % to_q16(1.0f) == saturated);
+    expect(that % to_q16(0.25f) == recovered);
+  };
+
+  "q16_pid derivative acts on the measurement"_test = []() {
+    // Setup
+    q16_pid pid({ .kd = to_q16(1.0f), .kf = to_q16(0.5f) });
+
+    // Exercise
+    auto const first = pid.update(to_q16(1.0f), 0);
+    auto const moved = pid.update(to_q16(1.0f), to_q16(0.25f));
+
+    // Verify
+    expect(that % to_q16(0.5f) == first);
+    expect(that % to_q16(0.25f) == moved);
+  };
+
+  "control_loop drives the motor from the timed interrupt"_test = []() {
+    // Setup
+    fake_encoder encoder;
+    test_motor motor;
+    test_interrupt interrupt;
+    test_clock clock;
+    control_loop<fake_encoder, hal::motor> loop(
+      encoder, motor, interrupt, clock, 1ms, { .kp = to_q16(0.01f) });
+    loop.setpoint(50.0f);
+
+    // Exercise
+    loop.start();
+    clock.m_step = 3;
+    interrupt.expire();
+    clock.m_uptime = 1010;
+    encoder.m_angle = 40.0f;
+    interrupt.expire();
+    loop.stop();
+    auto const stats = loop.statistics();
+
+    // Verify
+    expect(that % 1ms == interrupt.m_delay);
+    expect(not interrupt.m_handler.has_value());
+    expect(std::abs(0.1f - motor.m_power) < 1e-3f) << motor.m_power;
+    expect(that % 2 == stats.iterations);
+    expect(that % 3 == stats.last_duration);
+    expect(that % 3 == stats.max_duration);
+    expect(that % 10 == stats.max_jitter);
+  };
+};
+}  // namespace hal
@@ -0,0 +1,113 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include <libhal/crc.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+constexpr std::array<hal::byte, 9> check_input{ '1', '2', '3', '4', '5',
+                                                '6', '7', '8', '9' };
+
+static_assert(0xCBF4'3926 == crc32(check_input));
+static_assert(0xCBF4'3926 == crc32_slice8(check_input));
+static_assert(0x29B1 == crc16_ccitt(check_input));
+
+/// CRC unit that records the segments it is given and computes in software
+class fake_crc32_engine : public hal::crc32_engine
+{
+public:
+  std::vector<usize> m_sizes{};
+
+private:
+  u32 driver_calculate(std::span<hal::byte const> p_data, u32 p_crc) override
+  {
+    m_sizes.push_back(p_data.size());
+    return hal::crc32(p_data, p_crc);
+  }
+};
+}  // namespace
+
+boost::ut::suite<"crc_test"> crc_test = []() {
+  using namespace boost::ut;
+
+  "crc kernels match their check values"_test = []() {
+    expect(that % 0xCBF4'3926 == crc32(check_input));
+    expect(that % 0xCBF4'3926 == crc32_slice8(check_input));
+    expect(that % 0x29B1 == crc16_ccitt(check_input));
+    expect(that % 0 == crc32(std::span<hal::byte const>{}));
+    expect(that % 0xFFFF == crc16_ccitt(std::span<hal::byte const>{}));
+  };
+
+  "scatter span CRCs equal the CRC of the joined data"_test = []() {
+    // Setup
+    std::vector<hal::byte> joined(300);
+    for (usize i = 0; i < joined.size(); i++) {
+      joined[i] = static_cast<hal::byte>(i * 7 + 3);
+    }
+    std::span<hal::byte const> const data(joined);
+    auto const segments = make_scatter_bytes(data.first(3),
+                                             std::span<hal::byte const>{},
+                                             data.subspan(3, 250),
+                                             data.subspan(253));
+
+    // Exercise
+    auto const table = crc32(scatter_span<hal::byte const>(segments));
+    auto const slice8 = crc32_slice8(scatter_span<hal::byte const>(segments));
+    auto const ccitt = crc16_ccitt(scatter_span<hal::byte const>(segments));
+
+    // Verify
+    expect(that % crc32(data) == table);
+    expect(that % crc32(data) == slice8);
+    expect(that % crc16_ccitt(data) == ccitt);
+  };
+
+  "crc32_slice8 matches crc32 for every length and alignment"_test = []() {
+    // Setup
+    std::array<hal::byte, 40> buffer{};
+    for (usize i = 0; i < buffer.size(); i++) {
+      buffer[i] = static_cast<hal::byte>(0xA5 ^ (i * 31));
+    }
+    std::span<hal::byte const> const data(buffer);
+
+    // Exercise & Verify
+    for (usize offset = 0; offset < 8; offset++) {
+      for (usize length = 0; length + offset <= data.size(); length++) {
+        auto const run = data.subspan(offset, length);
+        expect(that % crc32(run) == crc32_slice8(run));
+      }
+    }
+  };
+
+  "crc32_engine calculates each non-empty segment"_test = []() {
+    // Setup
+    fake_crc32_engine engine;
+    auto const segments = make_scatter_bytes(
+      std::span(check_input).first(4),
+      std::span<hal::byte const>{},
+      std::span(check_input).subspan(4));
+
+    // Exercise
+    auto const crc = engine.calculate(scatter_span<hal::byte const>(segments));
+
+    // Verify
+    expect(that % 0xCBF4'3926 == crc);
+    expect(std::vector<usize>{ 4, 5 } == engine.m_sizes);
+  };
+};
+}  // namespace hal
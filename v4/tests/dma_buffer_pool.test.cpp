@@ -0,0 +1,96 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <libhal/dma_buffer_pool.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+boost::ut::suite<"dma_buffer_pool_test"> dma_buffer_pool_test = []() {
+  using namespace boost::ut;
+
+  "dma_buffer_pool hands out aligned, empty buffers"_test = []() {
+    // Setup
+    dma_buffer_pool<48, 2, 64> pool;
+
+    // Exercise
+    auto first = pool.acquire();
+    auto second = pool.try_acquire();
+
+    // Verify
+    expect(second.has_value());
+    auto const first_address =
+      reinterpret_cast<std::uintptr_t>(first->storage.data());
+    auto const second_address =
+      reinterpret_cast<std::uintptr_t>(second.value()->storage.data());
+    expect(that % 0 == first_address % 64);
+    expect(that % 0 == second_address % 64);
+    expect(that % 0 == first->size);
+    expect(first->data().empty());
+    expect(that % 0 == pool.available());
+  };
+
+  "dma_buffer_pool applies backpressure when dry"_test = []() {
+    // Setup
+    dma_buffer_pool<16, 1> pool;
+    auto held = pool.acquire();
+
+    // Exercise
+    auto const dry = pool.try_acquire();
+    expect(throws<std::bad_alloc>([&pool]() { (void)pool.acquire(); }));
+
+    // Verify
+    expect(not dry.has_value());
+    expect(that % 1 == pool.statistics().failures);
+    expect(that % 1 == held.use_count());
+  };
+
+  "dma_buffer_pool buffers return when the last owner releases"_test = []() {
+    // Setup
+    dma_buffer_pool<16, 2> pool;
+    std::vector<strong_ptr<dma_buffer<16>>> in_flight;
+
+    {
+      // Exercise: the receiver fills a buffer and hands it to the sender
+      auto buffer = pool.acquire();
+      std::ranges::fill(buffer->storage, 0xA5);
+      buffer->fill(5);
+      in_flight.push_back(buffer);
+    }
+    expect(that % 1 == pool.available());
+    auto const sent = std::vector<hal::byte>(in_flight.front()->data().begin(),
+                                             in_flight.front()->data().end());
+    in_flight.clear();
+
+    // Verify
+    expect(std::vector<hal::byte>(5, 0xA5) == sent);
+    expect(that % 2 == pool.available());
+    expect(that % 1 == pool.statistics().high_water);
+  };
+
+  "dma_buffer::fill rejects sizes beyond the capacity"_test = []() {
+    // Setup
+    dma_buffer<8> buffer;
+
+    // Exercise & Verify
+    expect(
+      throws<hal::argument_out_of_domain>([&buffer]() { buffer.fill(9); }));
+    expect(that % 0 == buffer.size);
+  };
+};
+}  // namespace hal
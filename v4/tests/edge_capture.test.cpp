@@ -0,0 +1,118 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <optional>
+
+#include <libhal/edge_capture.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_edge_capture : public hal::edge_capture
+{
+public:
+  /// Simulates the capture timer and DMA recording an edge
+  void edge(u32 p_timestamp, bool p_level)
+  {
+    m_buffer[m_cursor] = { .timestamp = p_timestamp, .level = p_level };
+    m_cursor = (m_cursor + 1) % m_buffer.size();
+    m_count++;
+  }
+
+  std::array<edge_event, 4> m_buffer{};
+  std::optional<settings> m_settings{};
+  usize m_cursor = 0;
+  usize m_count = 0;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  std::span<edge_event const> driver_receive_buffer() override
+  {
+    return m_buffer;
+  }
+
+  usize driver_cursor() override
+  {
+    return m_cursor;
+  }
+
+  std::optional<usize> driver_receive_count() override
+  {
+    return m_count;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"edge_capture_test"> edge_capture_test = []() {
+  using namespace boost::ut;
+
+  "edge_capture::receive_buffer() exposes edges in place"_test = []() {
+    // Setup
+    test_edge_capture test;
+    test.configure({ .trigger = interrupt_pin::trigger_edge::rising });
+
+    // Exercise
+    test.edge(0xFFFF'FFF0, true);
+    test.edge(0x0000'0010, false);
+    test.edge(0x0000'0030, true);
+    auto const buffer = test.receive_buffer();
+    auto const period = buffer[1].timestamp - buffer[0].timestamp;
+
+    // Verify
+    expect(interrupt_pin::trigger_edge::rising == test.m_settings->trigger);
+    expect(that % 1.0_MHz == test.frequency());
+    expect(that % test.m_buffer.data() == buffer.data());
+    expect(that % 3 == test.receive_cursor());
+    expect(that % 3 == test.receive_count().value());
+    expect(that % 0x20 == period);
+    expect(edge_event{ .timestamp = 0x30, .level = true } == buffer[2]);
+  };
+
+  "edge_capture::receive_count() is optional"_test = []() {
+    // Setup
+    class uncounted : public hal::edge_capture
+    {
+      void driver_configure(settings const&) override
+      {
+      }
+      hertz driver_frequency() override
+      {
+        return 1.0_MHz;
+      }
+      std::span<edge_event const> driver_receive_buffer() override
+      {
+        return {};
+      }
+      usize driver_cursor() override
+      {
+        return 0;
+      }
+    } test;
+
+    // Exercise & Verify
+    expect(not test.receive_count().has_value());
+  };
+};
+}  // namespace hal
@@ -34,6 +34,20 @@ boost::ut::suite<"error_test"> error_test = []() {
       expect(exception_thrown);
     };
 
+    "[success] hal::catch_error_code"_test = []() {
+      // Exercise
+      auto const success = hal::catch_error_code([]() {});
+      auto const timed_out = hal::catch_error_code(
+        []() { hal::safe_throw(hal::timed_out(nullptr)); });
+      auto const unknown =
+        hal::catch_error_code([]() { hal::safe_throw(hal::unknown(nullptr)); });
+
+      // Verify
+      expect(std::errc{} == success);
+      expect(std::errc::timed_out == timed_out);
+      expect(std::errc::io_error == unknown);
+    };
+
 #define TEST_COMPILE_TIME_FAILURE 0
 #if TEST_COMPILE_TIME_FAILURE
     "[failure] hal::safe_throw(non-trivial-dtor)"_test = []() {
@@ -0,0 +1,148 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include <libhal/event_trace.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class fake_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+
+std::vector<decoded_trace_event> decode(trace_decoder& p_decoder,
+                                        std::span<hal::byte const> p_data)
+{
+  std::vector<decoded_trace_event> events;
+  p_decoder.feed(p_data, [&events](decoded_trace_event const& p_event) {
+    events.push_back(p_event);
+  });
+  return events;
+}
+}  // namespace
+
+boost::ut::suite<"event_trace_test"> event_trace_test = []() {
+  using namespace boost::ut;
+
+  "drain encodes events in little endian"_test = []() {
+    // Setup
+    fake_clock clock;
+    event_trace<4> trace(clock);
+    std::array<hal::byte, 4 * trace_event_size> staging{};
+    clock.m_uptime = 0x1'0403'0201;
+
+    // Exercise
+    expect(trace.record(0x0605, 0x0807));
+    auto const data = trace.drain(staging);
+
+    // Verify
+    std::array<hal::byte, trace_event_size> const expected{
+      0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08
+    };
+    expect(std::ranges::equal(expected, data));
+    expect(trace.drain(staging).empty());
+  };
+
+  "drain stops once the buffer is full"_test = []() {
+    // Setup
+    fake_clock clock;
+    event_trace<4> trace(clock);
+    std::array<hal::byte, 2 * trace_event_size + 3> staging{};
+    trace_decoder decoder;
+
+    // Exercise
+    trace.record(1);
+    trace.record(2);
+    trace.record(3);
+    auto const first = decode(decoder, trace.drain(staging));
+    auto const second = decode(decoder, trace.drain(staging));
+
+    // Verify
+    expect(that % 2 == first.size());
+    expect(that % 1 == second.size());
+    expect(that % 3 == second[0].id);
+  };
+
+  "full ring drops events and reports them"_test = []() {
+    // Setup
+    fake_clock clock;
+    event_trace<2> trace(clock);
+    std::array<hal::byte, 8 * trace_event_size> staging{};
+    trace_decoder decoder;
+
+    // Exercise
+    expect(trace.record(1));
+    expect(trace.record(2));
+    expect(not trace.record(3));
+    expect(not trace.record(4));
+    auto const events = decode(decoder, trace.drain(staging));
+    auto const again = decode(decoder, trace.drain(staging));
+
+    // Verify
+    expect(that % 2 == trace.dropped());
+    expect(that % 3 == events.size());
+    expect(that % trace_dropped_id == events[0].id);
+    expect(that % 2 == events[0].payload);
+    expect(that % 1 == events[1].id);
+    expect(that % 2 == events[2].id);
+    expect(again.empty());
+    expect(trace.record(5));
+  };
+
+  "decoder reassembles split events and extends timestamps"_test = []() {
+    // Setup
+    fake_clock clock;
+    event_trace<8> trace(clock);
+    std::array<hal::byte, 8 * trace_event_size> staging{};
+    trace_decoder decoder;
+    clock.m_uptime = 0xFFFF'FFF0;
+    trace.record(1, 10);
+    clock.m_uptime = 0x1'0000'0010;
+    trace.record(2, 20);
+    clock.m_uptime = 0x1'0000'0008;
+    trace.record(3, 30);
+    auto const data = trace.drain(staging);
+
+    // Exercise
+    auto events = decode(decoder, data.first(5));
+    auto const rest = decode(decoder, data.subspan(5));
+    events.insert(events.end(), rest.begin(), rest.end());
+
+    // Verify
+    std::vector<decoded_trace_event> const expected{
+      { .timestamp = 0xFFFF'FFF0, .id = 1, .payload = 10 },
+      { .timestamp = 0x1'0000'0010, .id = 2, .payload = 20 },
+      { .timestamp = 0x1'0000'0008, .id = 3, .payload = 30 },
+    };
+    expect(expected == events);
+  };
+};
+}  // namespace hal
@@ -0,0 +1,118 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal/exception_trace.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 100;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime++;
+  }
+};
+
+void throw_and_catch(hal::exception const& p_exception)
+{
+  try {
+    throw p_exception;
+  } catch (hal::exception const&) {
+    return;
+  }
+}
+}  // namespace
+
+boost::ut::suite<"exception_trace_test"> exception_trace_test = []() {
+  using namespace boost::ut;
+
+  "exception_trace records exceptions while installed"_test = []() {
+    // Setup
+    test_clock clock;
+    exception_trace<4> trace(clock);
+    int const driver = 0;
+
+    // Exercise
+    throw_and_catch(hal::timed_out(nullptr));
+    trace.install();
+    auto const installed = trace.installed();
+    throw_and_catch(hal::no_such_device(0x42, &driver));
+    throw_and_catch(hal::io_error(&driver));
+    trace.uninstall();
+    throw_and_catch(hal::timed_out(nullptr));
+
+    // Verify
+    expect(installed);
+    expect(not trace.installed());
+    expect(that % 2 == trace.recorded());
+    expect(exception_record{ .error_code = std::errc::no_such_device,
+                             .instance = &driver,
+                             .timestamp = 100 } == trace.records()[0]);
+    expect(exception_record{ .error_code = std::errc::io_error,
+                             .instance = &driver,
+                             .timestamp = 101 } == trace.records()[1]);
+    expect(exception_record{} == trace.records()[2]);
+  };
+
+  "exception_trace overwrites the oldest record when full"_test = []() {
+    // Setup
+    test_clock clock;
+    exception_trace<2> trace(clock);
+    trace.install();
+
+    // Exercise
+    throw_and_catch(hal::timed_out(nullptr));
+    throw_and_catch(hal::io_error(nullptr));
+    throw_and_catch(hal::message_size(8, nullptr));
+    auto const recorded = trace.recorded();
+    auto const records = trace.records();
+    auto const first = records[0];
+    auto const second = records[1];
+    trace.clear();
+
+    // Verify
+    expect(that % 3 == recorded);
+    expect(std::errc::message_size == first.error_code);
+    expect(std::errc::io_error == second.error_code);
+    expect(that % 0 == trace.recorded());
+    expect(exception_record{} == trace.records()[0]);
+  };
+
+  "exception_trace uninstalls itself on destruction"_test = []() {
+    // Setup
+    test_clock clock;
+    {
+      exception_trace<2> trace(clock);
+      trace.install();
+    }
+
+    // Exercise
+    throw_and_catch(hal::timed_out(nullptr));
+
+    // Verify
+    expect(nullptr == hal::detail::exception_hook_registered.hook);
+  };
+};
+}  // namespace hal
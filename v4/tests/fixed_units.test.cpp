@@ -0,0 +1,109 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <concepts>
+#include <ratio>
+
+#include <libhal/fixed_units.hpp>
+#include <libhal/units.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+// Lossless conversions are implicit, lossy ones need quantity_cast
+static_assert(std::convertible_to<millivolts, microvolts>);
+static_assert(not std::convertible_to<microvolts, millivolts>);
+static_assert(std::convertible_to<kilohertz, hertz_count>);
+// Dimensions cannot be mixed
+static_assert(not std::convertible_to<millivolts, milliamperes>);
+static_assert(not std::constructible_from<millivolts, milliamperes>);
+
+static_assert(microvolts(millivolts(3)).count() == 3'000);
+static_assert(quantity_cast<millivolts>(microvolts(2'999)).count() == 2);
+static_assert(quantity_cast<millivolts>(microvolts(-2'999)).count() == -2);
+static_assert(quantity_cast<millimeters>(micrometers(12'345)).count() == 12);
+static_assert(hertz_count(kilohertz(48)).count() == 48'000);
+static_assert(millivolts(5) + millivolts(7) == millivolts(12));
+static_assert(millivolts(5) < millivolts(7));
+
+using inches = quantity<i32, dimension::length, std::ratio<254, 10'000>>;
+}  // namespace
+
+boost::ut::suite<"fixed_units_test"> fixed_units_test = []() {
+  using namespace boost::ut;
+
+  "arithmetic stays within the dimension and scale"_test = []() {
+    // Setup
+    millivolts total{ 1'000 };
+
+    // Exercise
+    total += millivolts(250);
+    total -= millivolts(50);
+    auto const doubled = total * 2;
+    auto const halved = total / 2;
+    auto const negative = -total;
+    auto const ratio = doubled / total;
+
+    // Verify
+    expect(that % 1'200 == total.count());
+    expect(that % 2'400 == doubled.count());
+    expect(that % 600 == halved.count());
+    expect(that % -1'200 == negative.count());
+    expect(that % 2 == ratio);
+  };
+
+  "mul_div scales without overflowing the representation"_test = []() {
+    // Setup
+    millivolts const reference{ 3'300 };
+    microvolts const large{ 2'000'000'000 };
+
+    // Exercise
+    auto const reading = mul_div(reference, 2'048, 4'095);
+    auto const scaled = mul_div(large, 3, 4);
+
+    // Verify
+    expect(that % 1'650 == reading.count());
+    expect(that % 1'500'000'000 == scaled.count());
+  };
+
+  "quantity_cast applies non decimal ratios"_test = []() {
+    // Setup
+    inches const two_inches{ 2 };
+
+    // Exercise
+    auto const micrometres = quantity_cast<micrometers>(two_inches);
+    auto const back = quantity_cast<inches>(micrometers(76'000));
+
+    // Verify
+    expect(that % 50'800 == micrometres.count());
+    expect(that % 2 == back.count()) << "Should truncate 2.99 inches";
+  };
+
+  "float conversions bridge to the v4 units"_test = []() {
+    // Setup
+    millicelsius const temperature{ 21'500 };
+
+    // Exercise
+    celsius const as_float = to_float(temperature);
+    auto const from_volts = from_float<millivolts>(1.2346f);
+    auto const negative = from_float<millidegrees>(-90.0006f);
+
+    // Verify
+    expect(that % 21.5f == as_float);
+    expect(that % 1'235 == from_volts.count());
+    expect(that % -90'001 == negative.count());
+  };
+};
+}  // namespace hal
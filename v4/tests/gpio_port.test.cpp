@@ -0,0 +1,111 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include <libhal/gpio_port.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_output_pin : public hal::output_pin
+{
+public:
+  settings m_settings{};
+  bool m_level = false;
+  int m_writes = 0;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  void driver_level(bool p_high) override
+  {
+    m_level = p_high;
+    m_writes++;
+  }
+
+  bool driver_level() override
+  {
+    return m_level;
+  }
+};
+
+class test_input_pin : public hal::input_pin
+{
+public:
+  settings m_settings{};
+  bool m_level = false;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  bool driver_level() override
+  {
+    return m_level;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"gpio_port_test"> gpio_port_test = []() {
+  using namespace boost::ut;
+
+  "output_pin_group::level() only writes masked pins"_test = []() {
+    // Setup
+    std::array<test_output_pin, 4> pins{};
+    output_pin_group<4> port(
+      std::array<output_pin*, 4>{ &pins[0], &pins[1], &pins[2], &pins[3] });
+    pins[3].m_level = true;
+
+    // Exercise
+    port.configure({ .resistor = pin_resistor::pull_up, .open_drain = true });
+    port.level(0b0111 | 0xF0, 0b1010 | 0xF0);
+    auto const level = port.level();
+
+    // Verify
+    expect(that % 0b1010 == level);
+    expect(that % 1 == pins[0].m_writes);
+    expect(that % 1 == pins[1].m_writes);
+    expect(that % 1 == pins[2].m_writes);
+    expect(that % 0 == pins[3].m_writes);
+    expect(pins[2].m_settings.open_drain);
+    expect(pin_resistor::pull_up == pins[2].m_settings.resistor);
+  };
+
+  "input_pin_group::level() packs every pin"_test = []() {
+    // Setup
+    std::array<test_input_pin, 3> pins{};
+    input_pin_group<3> port(
+      std::array<input_pin*, 3>{ &pins[0], &pins[1], &pins[2] });
+    pins[0].m_level = true;
+    pins[2].m_level = true;
+
+    // Exercise
+    port.configure({ .resistor = pin_resistor::pull_down });
+    auto const level = port.level();
+
+    // Verify
+    expect(that % 0b101 == level);
+    expect(pin_resistor::pull_down == pins[1].m_settings.resistor);
+  };
+};
+}  // namespace hal
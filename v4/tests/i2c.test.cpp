@@ -14,7 +14,9 @@
 
 #include <libhal/i2c.hpp>
 
+#include <array>
 #include <functional>
+#include <vector>
 
 #include <libhal/error.hpp>
 
@@ -227,4 +229,236 @@ boost::ut::suite<"i2c_test_v2"> i2c_test_v2 = []() {
     expect(that % not test.overriden_call);  // Must stay this way
   };
 };
+
+namespace {
+class test_i2c_recorder : public hal::i2c
+{
+public:
+  hal::byte m_address{};
+  std::span<hal::byte const> m_data_out{};
+  std::vector<hal::byte> m_written{};
+  usize m_read_size = 0;
+  usize m_transactions = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    driver_transaction(p_address, p_data_out, p_data_in);
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in) override
+  {
+    m_transactions++;
+    m_address = p_address;
+    m_data_out = p_data_out;
+    m_written.assign(p_data_out.begin(), p_data_out.end());
+    m_read_size = p_data_in.size();
+    for (usize i = 0; i < p_data_in.size(); i++) {
+      p_data_in[i] = static_cast<hal::byte>(0x10 + i);
+    }
+  }
+};
+}  // namespace
+
+boost::ut::suite<"i2c_scatter_test"> i2c_scatter_test = []() {
+  using namespace boost::ut;
+
+  "::transaction(scatter) forwards single segments"_test = []() {
+    // Setup
+    test_i2c_recorder test;
+    std::array<hal::byte, 2> data_in{};
+    std::array<std::span<hal::byte const>, 2> out{
+      std::span<hal::byte const>{},
+      expected_data_out,
+    };
+    std::array<std::span<hal::byte>, 1> in{ data_in };
+
+    // Exercise
+    test.transaction(expected_address, out, in);
+
+    // Verify
+    expect(that % 1 == test.m_transactions);
+    expect(that % expected_address == test.m_address);
+    expect(that % expected_data_out.data() == test.m_data_out.data());
+    expect(that % 2 == test.m_read_size);
+    expect(that % 0x10 == data_in[0]);
+    expect(that % 0x11 == data_in[1]);
+  };
+
+  "::transaction(scatter) joins segments"_test = []() {
+    // Setup
+    test_i2c_recorder test;
+    constexpr std::array<hal::byte, 1> register_address{ 0x42 };
+    constexpr std::array<hal::byte, 3> payload{ 0xA, 0xB, 0xC };
+    std::array<hal::byte, 1> status{};
+    std::array<hal::byte, 2> values{};
+    auto const out = make_scatter_bytes(register_address, payload);
+    auto const in = make_writable_scatter_bytes(status, values);
+
+    // Exercise
+    test.transaction(expected_address, out, in);
+
+    // Verify
+    expect(that % 1 == test.m_transactions);
+    expect(std::vector<hal::byte>{ 0x42, 0xA, 0xB, 0xC } == test.m_written);
+    expect(that % 3 == test.m_read_size);
+    expect(that % 0x10 == status[0]);
+    expect(that % 0x11 == values[0]);
+    expect(that % 0x12 == values[1]);
+  };
+
+  "::transaction(scatter) stages large segments in caller buffer"_test =
+    []() {
+      // Setup
+      test_i2c_recorder test;
+      constexpr std::array<hal::byte, 1> register_address{ 0x42 };
+      std::array<hal::byte, hal::i2c::scatter_staging_size> payload{};
+      payload.fill(0xAA);
+      std::array<hal::byte, 2> values{};
+      std::array<hal::byte, 2> more{};
+      std::array<hal::byte, 64> staging{};
+      auto const out = make_scatter_bytes(register_address, payload);
+      auto const in = make_writable_scatter_bytes(values, more);
+
+      // Exercise
+      test.transaction(expected_address, out, in, staging);
+
+      // Verify
+      expect(that % 1 == test.m_transactions);
+      expect(that % (payload.size() + 1) == test.m_written.size());
+      expect(that % 0x42 == test.m_written.front());
+      expect(that % 0xAA == test.m_written.back());
+      expect(that % 4 == test.m_read_size);
+      expect(that % 0x10 == values[0]);
+      expect(that % 0x13 == more[1]);
+    };
+
+  "::transaction(scatter) throws without enough staging"_test = []() {
+    // Setup
+    test_i2c_recorder test;
+    std::array<hal::byte, hal::i2c::scatter_staging_size> big{};
+    constexpr std::array<hal::byte, 1> register_address{ 0x42 };
+    std::array<hal::byte, hal::i2c::scatter_staging_size> staging{};
+    auto const out = make_scatter_bytes(register_address, big);
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      test.transaction(expected_address, out, scatter_span<hal::byte>{});
+    }));
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      test.transaction(
+        expected_address, out, scatter_span<hal::byte>{}, staging);
+    }));
+    expect(that % 0 == test.m_transactions);
+  };
+};
+}  // namespace hal
+
+namespace hal {
+namespace {
+/// Only acknowledges address 0x42, reporting other addresses by throwing
+class test_i2c_throwing : public hal::i2c
+{
+public:
+  usize m_transactions = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const> p_data_out,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    driver_transaction(p_address, p_data_out, p_data_in);
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const>,
+                          std::span<hal::byte>) override
+  {
+    m_transactions++;
+    if (p_address != 0x42) {
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+  }
+};
+
+/// Only acknowledges address 0x42, reporting other addresses without throwing
+class test_i2c_non_throwing : public hal::i2c
+{
+public:
+  usize m_transactions = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte,
+                          std::span<hal::byte const>,
+                          std::span<hal::byte>,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+  }
+
+  std::errc driver_try_transaction(hal::byte p_address,
+                                   std::span<hal::byte const>,
+                                   std::span<hal::byte>) override
+  {
+    m_transactions++;
+    if (p_address != 0x42) {
+      return std::errc::no_such_device;
+    }
+    return std::errc{};
+  }
+};
+}  // namespace
+
+boost::ut::suite<"i2c_try_test"> i2c_try_test = []() {
+  using namespace boost::ut;
+
+  "::try_transaction() reports thrown errors by default"_test = []() {
+    // Setup
+    test_i2c_throwing test;
+    std::array<hal::byte, 1> data_in{};
+
+    // Exercise
+    auto const missing = test.try_transaction(0x10, expected_data_out, data_in);
+    auto const found = test.try_transaction(0x42, expected_data_out, data_in);
+
+    // Verify
+    expect(std::errc::no_such_device == missing);
+    expect(std::errc{} == found);
+    expect(that % 2 == test.m_transactions);
+  };
+
+  "::try_transaction() probes a bus without throwing"_test = []() {
+    // Setup
+    test_i2c_non_throwing test;
+    std::vector<hal::byte> found{};
+
+    // Exercise
+    for (hal::byte address = 0x08; address < 0x78; address++) {
+      if (test.try_transaction(address, {}, {}) == std::errc{}) {
+        found.push_back(address);
+      }
+    }
+
+    // Verify
+    expect(std::vector<hal::byte>{ 0x42 } == found);
+    expect(that % 0x70 == test.m_transactions);
+  };
+};
 }  // namespace hal
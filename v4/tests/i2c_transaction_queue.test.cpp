@@ -0,0 +1,179 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <optional>
+#include <span>
+#include <system_error>
+
+#include <libhal/error.hpp>
+#include <libhal/i2c.hpp>
+#include <libhal/i2c_transaction_queue.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+constexpr hal::byte missing_address = 0x77;
+
+class test_i2c : public hal::i2c
+{
+public:
+  usize m_transactions = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const>,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    if (p_address == missing_address) {
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+    m_transactions++;
+    for (auto& byte : p_data_in) {
+      byte = p_address;
+    }
+  }
+};
+
+class test_async_queue : public hal::i2c_transaction_queue
+{
+public:
+  std::span<transaction const> m_batch{};
+  optional_completion_handler m_handler{};
+  bool m_busy = false;
+  batch_result m_result{};
+
+  void complete()
+  {
+    m_busy = false;
+    m_result = { .completed = m_batch.size() };
+    if (m_handler) {
+      (*m_handler)(on_complete_tag{}, m_result);
+    }
+  }
+
+private:
+  void driver_submit(std::span<transaction const> p_batch,
+                     optional_completion_handler p_on_complete) override
+  {
+    if (m_busy) {
+      hal::safe_throw(hal::device_or_resource_busy(this));
+    }
+    m_batch = p_batch;
+    m_handler = p_on_complete;
+    m_busy = true;
+  }
+
+  bool driver_busy() override
+  {
+    return m_busy;
+  }
+
+  batch_result driver_wait() override
+  {
+    return m_result;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"i2c_transaction_queue_test"> i2c_transaction_queue_test =
+  []() {
+    using namespace boost::ut;
+
+    "i2c_transaction_queue interface"_test = []() {
+      // Setup
+      test_async_queue queue;
+      std::array<hal::byte, 2> data_in{};
+      std::array<i2c_transaction_queue::transaction, 1> const batch{ {
+        { .address = 0x10, .data_in = data_in },
+      } };
+      std::optional<i2c_transaction_queue::batch_result> reported;
+
+      // Exercise
+      queue.submit(batch,
+                   [&](i2c_transaction_queue::on_complete_tag,
+                       i2c_transaction_queue::batch_result p_result) {
+                     reported = p_result;
+                   });
+      auto const busy_before = queue.busy();
+      expect(throws<hal::device_or_resource_busy>(
+        [&]() { queue.submit(batch); }));
+      queue.complete();
+
+      // Verify
+      expect(that % busy_before);
+      expect(that % not queue.busy());
+      expect(that % batch.data() == queue.m_batch.data());
+      expect(reported.has_value());
+      expect(that % 1 == reported->completed);
+      expect(i2c_transaction_queue::batch_result{ .completed = 1 } ==
+             queue.wait());
+    };
+
+    "blocking_i2c_transaction_queue runs every transaction"_test = []() {
+      // Setup
+      test_i2c i2c;
+      blocking_i2c_transaction_queue queue(i2c);
+      std::array<hal::byte, 2> first{};
+      std::array<hal::byte, 3> second{};
+      std::array<i2c_transaction_queue::transaction, 2> const batch{ {
+        { .address = 0x10, .data_in = first },
+        { .address = 0x20, .data_in = second },
+      } };
+      usize callback_count = 0;
+
+      // Exercise
+      queue.submit(batch,
+                   [&](i2c_transaction_queue::on_complete_tag,
+                       i2c_transaction_queue::batch_result) {
+                     callback_count++;
+                   });
+      auto const result = queue.wait();
+
+      // Verify
+      expect(that % not queue.busy());
+      expect(that % 2 == i2c.m_transactions);
+      expect(that % 1 == callback_count);
+      expect(i2c_transaction_queue::batch_result{ .completed = 2 } == result);
+      expect(that % 0x10 == first[1]);
+      expect(that % 0x20 == second[2]);
+    };
+
+    "blocking_i2c_transaction_queue stops at first error"_test = []() {
+      // Setup
+      test_i2c i2c;
+      blocking_i2c_transaction_queue queue(i2c);
+      std::array<i2c_transaction_queue::transaction, 3> const batch{ {
+        { .address = 0x10 },
+        { .address = missing_address },
+        { .address = 0x20 },
+      } };
+
+      // Exercise
+      queue.submit(batch);
+      auto const result = queue.wait();
+
+      // Verify
+      expect(that % 1 == i2c.m_transactions);
+      expect(that % 1 == result.completed);
+      expect(std::errc::no_such_device == result.error);
+    };
+  };
+}  // namespace hal
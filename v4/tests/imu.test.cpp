@@ -0,0 +1,87 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include <libhal/imu.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_imu : public hal::imu
+{
+public:
+  int m_reads = 0;
+
+private:
+  read_t driver_read() override
+  {
+    m_reads++;
+    return {
+      .acceleration = { .x = 0.0f, .y = 0.0f, .z = 1.0f },
+      .angular_velocity = { .x = 10.0f, .y = 20.0f, .z = 30.0f },
+      .magnetic_field = { .x = 0.25f, .y = 0.0f, .z = -0.25f },
+      .temperature = 25.0f,
+    };
+  }
+};
+}  // namespace
+
+boost::ut::suite<"imu_test"> imu_test = []() {
+  using namespace boost::ut;
+
+  "imu::read_batch() defaults to the latest sample"_test = []() {
+    // Setup
+    test_imu test;
+    std::array<g_force, 4> acceleration_z{};
+    std::array<rpm, 4> angular_velocity_y{};
+    std::array<celsius, 4> temperature{};
+
+    // Exercise
+    auto const count = test.read_batch({
+      .acceleration_z = acceleration_z,
+      .angular_velocity_y = angular_velocity_y,
+      .temperature = temperature,
+    });
+
+    // Verify
+    expect(that % 1 == count);
+    expect(that % 1 == test.m_reads);
+    expect(that % 1.0f == acceleration_z[0]);
+    expect(that % 20.0f == angular_velocity_y[0]);
+    expect(that % 25.0f == temperature[0]);
+  };
+
+  "imu::read_batch() validates the batch"_test = []() {
+    // Setup
+    test_imu test;
+    std::array<g_force, 4> acceleration_x{};
+    std::array<g_force, 3> acceleration_y{};
+
+    // Exercise
+    auto const empty = test.read_batch({});
+
+    // Verify
+    expect(that % 0 == empty);
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      (void)test.read_batch({ .acceleration_x = acceleration_x,
+                              .acceleration_y = acceleration_y });
+    }));
+    expect(that % 0 == test.m_reads);
+  };
+};
+}  // namespace hal
@@ -0,0 +1,234 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <string>
+
+#include <libhal/error.hpp>
+#include <libhal/instrumented.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+/// Steady clock that advances by a fixed step every time it is read
+class stepping_clock : public hal::steady_clock
+{
+public:
+  u64 m_step = 0;
+  u64 m_uptime = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    auto const now = m_uptime;
+    m_uptime += m_step;
+    return now;
+  }
+};
+
+/// i2c driver that throws for every address other than 0x42
+class fake_i2c : public hal::i2c
+{
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const>,
+                          std::span<hal::byte>,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    if (p_address != 0x42) {
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+  }
+};
+
+class fake_spi : public hal::spi_channel
+{
+public:
+  std::basic_string<bool> m_selects{};
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return 1'000'000;
+  }
+
+  void driver_chip_select(bool p_select) override
+  {
+    m_selects.push_back(p_select);
+  }
+
+  void driver_transfer(std::span<hal::byte const>,
+                       std::span<hal::byte> p_data_in,
+                       hal::byte p_filler) override
+  {
+    for (auto& data : p_data_in) {
+      data = p_filler;
+    }
+  }
+};
+
+/// Serial port that transmits at most 4 bytes per write and captures them
+class fake_serial : public hal::serial
+{
+public:
+  std::string m_written{};
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  write_t driver_write(std::span<hal::byte const> p_data) override
+  {
+    auto const sent = p_data.first(std::min<usize>(4, p_data.size()));
+    m_written.append(reinterpret_cast<char const*>(sent.data()), sent.size());
+    return { .data = sent };
+  }
+
+  read_t driver_read(std::span<hal::byte> p_data) override
+  {
+    return {
+      .data = p_data.first(0),
+      .available = 0,
+      .capacity = 0,
+    };
+  }
+
+  void driver_flush() override
+  {
+  }
+};
+}  // namespace
+
+boost::ut::suite<"instrumented_test"> instrumented_test = []() {
+  using namespace boost::ut;
+
+  "call_recorder buckets latencies by powers of two"_test = []() {
+    expect(that % 0 == call_recorder::bucket(0));
+    expect(that % 1 == call_recorder::bucket(1));
+    expect(that % 2 == call_recorder::bucket(2));
+    expect(that % 2 == call_recorder::bucket(3));
+    expect(that % 11 == call_recorder::bucket(1024));
+    expect(that % (latency_buckets - 1) == call_recorder::bucket(~u64{ 0 }));
+  };
+
+  "instrumented_i2c counts calls, bytes, errors and latency"_test = []() {
+    // Setup
+    stepping_clock clock;
+    clock.m_step = 5;
+    fake_i2c bus;
+    instrumented_i2c instrumented(bus, clock);
+    hal::i2c& erased = instrumented;
+    std::array<hal::byte, 2> const out{ 0x01, 0x02 };
+    std::array<hal::byte, 3> in{};
+    call_statistics expected{ .calls = 3, .bytes = 10, .errors = 1 };
+    expected.latency[call_recorder::bucket(5)] = 3;
+
+    // Exercise
+    erased.transaction(0x42, out, in);
+    expect(throws<hal::no_such_device>(
+      [&erased, &out]() { erased.transaction(0x10, out, {}); }));
+    auto const error = erased.try_transaction(0x42, out, in);
+
+    // Verify
+    expect(std::errc{} == error);
+    expect(expected == instrumented.statistics());
+  };
+
+  "instrumented_i2c try_transaction counts returned errors"_test = []() {
+    // Setup
+    stepping_clock clock;
+    fake_i2c bus;
+    instrumented_i2c instrumented(bus, clock);
+    hal::i2c& erased = instrumented;
+
+    // Exercise
+    auto const error = erased.try_transaction(0x10, {}, {});
+    auto const statistics = instrumented.statistics();
+    instrumented.reset_statistics();
+
+    // Verify
+    expect(std::errc::no_such_device == error);
+    expect(that % 1 == statistics.errors);
+    expect(that % 1 == statistics.latency[0]);
+    expect(call_statistics{} == instrumented.statistics());
+  };
+
+  "instrumented_spi_channel counts all transfer forms"_test = []() {
+    // Setup
+    stepping_clock clock;
+    clock.m_step = 100;
+    fake_spi bus;
+    instrumented_spi_channel instrumented(bus, clock);
+    hal::spi_channel& erased = instrumented;
+    std::array<hal::byte, 1> const command{ 0x9F };
+    std::array<hal::byte, 3> id{};
+    auto const out = hal::make_scatter_bytes(command);
+    auto const in = hal::make_writable_scatter_bytes(id);
+
+    // Exercise
+    erased.transfer(command, id);
+    erased.transfer(out, in);
+
+    // Verify
+    auto const statistics = instrumented.statistics();
+    expect(that % 2 == statistics.calls);
+    expect(that % 6 == statistics.bytes);
+    expect(that % 2 == statistics.latency[call_recorder::bucket(100)]);
+    expect(that % 1'000'000 == erased.clock_rate());
+    expect(std::basic_string<bool>{ true, false } == bus.m_selects);
+  };
+
+  "instrumented_serial and write_statistics"_test = []() {
+    // Setup
+    stepping_clock clock;
+    fake_serial port;
+    instrumented_serial instrumented(port, clock);
+    hal::serial& erased = instrumented;
+    std::array<hal::byte, 6> const data{ 'h', 'e', 'l', 'l', 'o', '\n' };
+    std::array<hal::byte, 4> buffer{};
+
+    // Exercise
+    erased.write(data);
+    auto const received = erased.read(buffer);
+    port.m_written.clear();
+    hal::write_statistics(port, "uart", instrumented.write_statistics());
+
+    // Verify
+    expect(that % 1 == instrumented.read_statistics().calls);
+    expect(that % 0 == instrumented.read_statistics().bytes);
+    expect(received.data.empty());
+    std::string expected = "uart,1,4,0,1";
+    for (usize i = 1; i < latency_buckets; i++) {
+      expected += ",0";
+    }
+    expected += "\n";
+    expect(expected == port.m_written);
+  };
+};
+}  // namespace hal
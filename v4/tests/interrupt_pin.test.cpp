@@ -63,5 +63,32 @@ boost::ut::suite<"interrupt_pin_test"> interrupt_pin_test = []() {
     expect(expected_settings.trigger == test.m_settings.trigger);
     expect(that % 1 == counter);
   };
+
+  "interrupt_pin::on_trigger() accepts larger callbacks"_test = []() {
+    // Setup
+    test_interrupt_pin test;
+    int rising = 0;
+    int falling = 0;
+    int total = 0;
+    auto three_words = [&rising, &falling, &total](bool p_state) {
+      (p_state ? rising : falling)++;
+      total++;
+    };
+    auto callback = hal::make_callback<interrupt_pin::handler, 3>(three_words);
+
+    // Exercise
+    test.on_trigger(callback);
+    test.m_callback(true);
+    test.m_callback(false);
+    test.m_callback(true);
+
+    // Verify
+    static_assert(3 == hal::callback_words_of<decltype(three_words)>);
+    static_assert(sizeof(hal::callback<interrupt_pin::handler>) ==
+                  interrupt_pin::callback_storage);
+    expect(that % 2 == rising);
+    expect(that % 1 == falling);
+    expect(that % 3 == total);
+  };
 };
 }  // namespace hal
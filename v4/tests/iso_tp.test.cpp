@@ -0,0 +1,404 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include <libhal/iso_tp.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+
+/// Records sent frames and forwards them to the receive buffer of a peer
+class test_transceiver : public hal::can_transceiver
+{
+public:
+  void inject(can_message const& p_message)
+  {
+    m_receive[m_cursor] = p_message;
+    m_cursor = (m_cursor + 1) % m_receive.size();
+  }
+
+  std::vector<can_message> m_sent;
+  std::vector<usize> m_batches;
+  test_transceiver* m_peer = nullptr;
+  usize m_accept_limit = 100;
+
+private:
+  u32 driver_baud_rate() override
+  {
+    return 500'000;
+  }
+
+  void driver_send(can_message const& p_message) override
+  {
+    m_sent.push_back(p_message);
+    if (m_peer) {
+      m_peer->inject(p_message);
+    }
+  }
+
+  usize driver_send_batch(std::span<can_message const> p_messages) override
+  {
+    auto const accepted = std::min(p_messages.size(), m_accept_limit);
+    m_batches.push_back(accepted);
+    for (auto const& message : p_messages.first(accepted)) {
+      driver_send(message);
+    }
+    return accepted;
+  }
+
+  std::span<can_message const> driver_receive_buffer() override
+  {
+    return m_receive;
+  }
+
+  usize driver_receive_cursor() override
+  {
+    return m_cursor;
+  }
+
+  std::array<can_message, 64> m_receive{};
+  usize m_cursor = 0;
+};
+
+constexpr iso_tp::settings node_a{ .transmit_id = 0x7E0, .receive_id = 0x7E8 };
+constexpr iso_tp::settings node_b{ .transmit_id = 0x7E8, .receive_id = 0x7E0 };
+
+can_message frame(u32 p_id, std::array<hal::byte, 8> p_payload)
+{
+  return { .id = p_id, .length = 8, .payload = p_payload };
+}
+
+std::vector<hal::byte> make_pattern(usize p_size)
+{
+  std::vector<hal::byte> result(p_size);
+  for (usize i = 0; i < p_size; i++) {
+    result[i] = static_cast<hal::byte>(i * 7 + 3);
+  }
+  return result;
+}
+}  // namespace
+
+boost::ut::suite<"iso_tp_test"> iso_tp_test = []() {
+  using namespace boost::ut;
+
+  "short messages are sent as a single frame"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_a);
+    std::array<hal::byte const, 3> const message{ 0x22, 0xF1, 0x90 };
+
+    // Exercise
+    test.send(message);
+
+    // Verify
+    expect(that % 1 == can.m_sent.size());
+    expect(that % 0x7E0 == can.m_sent[0].id);
+    expect(std::array<hal::byte, 8>{ 0x03, 0x22, 0xF1, 0x90, 0xCC, 0xCC, 0xCC,
+                                     0xCC } == can.m_sent[0].payload);
+    expect(iso_tp::status::complete == test.transmit_status());
+  };
+
+  "consecutive frames are sent in windows from every segment"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_a);
+    auto const data = make_pattern(100);
+    auto const segments = make_scatter_array<hal::byte const>(
+      std::span(data).first(10), std::span(data).subspan(10));
+
+    // Exercise
+    test.send(segments);
+    test.poll();
+    auto const before_flow_control = can.m_sent.size();
+    can.inject(frame(0x7E8, { 0x30, 0x00, 0x00 }));
+    test.poll();
+    test.poll();
+
+    // Verify
+    expect(that % 1 == before_flow_control);
+    expect(that % 0x10 == can.m_sent[0].payload[0]);
+    expect(that % 100 == can.m_sent[0].payload[1]);
+    expect(std::vector<usize>{ 8, 6 } == can.m_batches);
+    expect(that % 15 == can.m_sent.size());
+    std::vector<hal::byte> reassembled(can.m_sent[0].payload.begin() + 2,
+                                       can.m_sent[0].payload.end());
+    for (usize i = 1; i < can.m_sent.size(); i++) {
+      expect(that % (0x20 | (i & 0x0F)) == can.m_sent[i].payload[0]);
+      reassembled.insert(reassembled.end(),
+                         can.m_sent[i].payload.begin() + 1,
+                         can.m_sent[i].payload.end());
+    }
+    reassembled.resize(100);
+    expect(data == reassembled);
+    expect(iso_tp::status::complete == test.transmit_status());
+  };
+
+  "frames the driver did not accept are sent on the next poll"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    can.m_accept_limit = 3;
+    iso_tp test(can, clock, node_a);
+    auto const data = make_pattern(40);
+
+    // Exercise
+    test.send(std::span<hal::byte const>(data));
+    can.inject(frame(0x7E8, { 0x30, 0x00, 0x00 }));
+    while (test.transmit_status() == iso_tp::status::in_progress) {
+      test.poll();
+    }
+
+    // Verify
+    expect(std::vector<usize>{ 3, 2 } == can.m_batches);
+    expect(that % 6 == can.m_sent.size());
+    expect(that % 0x25 == can.m_sent.back().payload[0]);
+  };
+
+  "block size makes the sender wait for flow control"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_a);
+    auto const data = make_pattern(62);
+
+    // Exercise
+    test.send(std::span<hal::byte const>(data));
+    can.inject(frame(0x7E8, { 0x30, 0x03, 0x00 }));
+    test.poll();
+    test.poll();
+    auto const first_block = can.m_sent.size();
+    can.inject(frame(0x7E8, { 0x31, 0x00, 0x00 }));
+    test.poll();
+    auto const after_wait = can.m_sent.size();
+    can.inject(frame(0x7E8, { 0x30, 0x00, 0x00 }));
+    test.poll();
+
+    // Verify
+    expect(that % 4 == first_block);
+    expect(that % 4 == after_wait);
+    expect(that % 9 == can.m_sent.size());
+    expect(iso_tp::status::complete == test.transmit_status());
+  };
+
+  "separation time paces consecutive frames"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_a);
+    auto const data = make_pattern(20);
+
+    // Exercise
+    test.send(std::span<hal::byte const>(data));
+    can.inject(frame(0x7E8, { 0x30, 0x00, 0xF5 }));
+    test.poll();
+    clock.m_uptime += 499;
+    test.poll();
+    auto const too_early = can.m_sent.size();
+    clock.m_uptime += 1;
+    test.poll();
+
+    // Verify
+    expect(that % 2 == too_early);
+    expect(that % 3 == can.m_sent.size());
+    expect(std::vector<usize>{ 1, 1 } == can.m_batches);
+    expect(iso_tp::status::complete == test.transmit_status());
+  };
+
+  "transmission fails without flow control or with an overflow"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_a);
+    auto const data = make_pattern(30);
+
+    // Exercise
+    test.send(std::span<hal::byte const>(data));
+    clock.m_uptime = 999'999;
+    test.poll();
+    auto const before_timeout = test.transmit_status();
+    clock.m_uptime = 1'000'000;
+    test.poll();
+    auto const after_timeout = test.transmit_status();
+    test.send(std::span<hal::byte const>(data));
+    can.inject(frame(0x7E8, { 0x32, 0x00, 0x00 }));
+    test.poll();
+
+    // Verify
+    expect(iso_tp::status::in_progress == before_timeout);
+    expect(iso_tp::status::timed_out == after_timeout);
+    expect(iso_tp::status::overflow == test.transmit_status());
+  };
+
+  "invalid messages are rejected"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_a);
+    auto const data = make_pattern(4096);
+
+    // Exercise + Verify
+    expect(throws<hal::message_size>(
+      [&]() { test.send(std::span<hal::byte const>(data)); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.send(std::span<hal::byte const>()); }));
+    test.send(std::span<hal::byte const>(data).first(8));
+    expect(throws<hal::device_or_resource_busy>(
+      [&]() { test.send(std::span<hal::byte const>(data).first(8)); }));
+  };
+
+  "messages are reassembled with this node's flow control"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, { .transmit_id = 0x7E8,
+                              .receive_id = 0x7E0,
+                              .block_size = 2,
+                              .separation_time = 0x05 });
+    std::array<hal::byte, 64> buffer{};
+    test.receive(buffer);
+
+    // Exercise
+    can.inject(frame(0x7E0, { 0x10, 27, 0, 1, 2, 3, 4, 5 }));
+    test.poll();
+    can.inject(frame(0x7E0, { 0x21, 6, 7, 8, 9, 10, 11, 12 }));
+    can.inject(frame(0x7E0, { 0x22, 13, 14, 15, 16, 17, 18, 19 }));
+    test.poll();
+    auto const flow_controls = can.m_sent.size();
+    auto const partial = test.received().size();
+    can.inject(frame(0x7E0, { 0x23, 20, 21, 22, 23, 24, 25, 26 }));
+    test.poll();
+
+    // Verify
+    expect(that % 2 == flow_controls);
+    expect(that % 0x30 == can.m_sent[0].payload[0]);
+    expect(that % 2 == can.m_sent[0].payload[1]);
+    expect(that % 5 == can.m_sent[0].payload[2]);
+    expect(that % 0x7E8 == can.m_sent[1].id);
+    expect(that % 20 == partial);
+    expect(iso_tp::status::complete == test.receive_status());
+    expect(that % 27 == test.received().size());
+    for (usize i = 0; i < 27; i++) {
+      expect(that % i == test.received()[i]);
+    }
+  };
+
+  "reception fails on errors from the peer"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_b);
+    std::array<hal::byte, 16> buffer{};
+
+    // Exercise
+    test.receive(buffer);
+    can.inject(frame(0x7E0, { 0x10, 17 }));
+    test.poll();
+    auto const too_large = test.receive_status();
+    test.receive(buffer);
+    can.inject(frame(0x7E0, { 0x10, 16 }));
+    can.inject(frame(0x7E0, { 0x22 }));
+    test.poll();
+    auto const out_of_sequence = test.receive_status();
+    test.receive(buffer);
+    can.inject(frame(0x7E0, { 0x10, 16 }));
+    test.poll();
+    clock.m_uptime += 1'000'000;
+    test.poll();
+
+    // Verify
+    expect(iso_tp::status::overflow == too_large);
+    expect(that % 0x32 == can.m_sent[0].payload[0]);
+    expect(iso_tp::status::protocol_error == out_of_sequence);
+    expect(iso_tp::status::timed_out == test.receive_status());
+  };
+
+  "frames of other ids are ignored"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can;
+    iso_tp test(can, clock, node_b);
+    std::array<hal::byte, 16> buffer{};
+    test.receive(buffer);
+
+    // Exercise
+    can.inject(frame(0x123, { 0x02, 1, 2 }));
+    auto extended = frame(0x7E0, { 0x02, 1, 2 });
+    extended.extended = true;
+    can.inject(extended);
+    test.poll();
+
+    // Verify
+    expect(iso_tp::status::in_progress == test.receive_status());
+    expect(that % 0 == test.received().size());
+  };
+
+  "two nodes exchange the largest message"_test = []() {
+    // Setup
+    test_clock clock;
+    test_transceiver can_a;
+    test_transceiver can_b;
+    can_a.m_peer = &can_b;
+    can_b.m_peer = &can_a;
+    iso_tp sender(can_a, clock, node_a);
+    iso_tp receiver(can_b, clock, { .transmit_id = 0x7E8,
+                                    .receive_id = 0x7E0,
+                                    .block_size = 16,
+                                    .padding = std::nullopt });
+    auto const data = make_pattern(iso_tp::max_message_size);
+    std::vector<hal::byte> buffer(iso_tp::max_message_size);
+    receiver.receive(buffer);
+
+    // Exercise
+    sender.send(std::span<hal::byte const>(data));
+    for (int i = 0; i < 1000 && receiver.receive_status() ==
+                                  iso_tp::status::in_progress;
+         i++) {
+      sender.poll();
+      receiver.poll();
+    }
+
+    // Verify
+    expect(iso_tp::status::complete == sender.transmit_status());
+    expect(iso_tp::status::complete == receiver.receive_status());
+    expect(std::ranges::equal(data, receiver.received()));
+    expect(that % 3 == can_b.m_sent.front().length)
+      << "Unpadded flow control frames";
+  };
+};
+}  // namespace hal
@@ -0,0 +1,244 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory_resource>
+
+#include <libhal/isr_profiler.hpp>
+#include <libhal/simulation.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+using namespace std::chrono_literals;
+
+/// Interrupt pin triggered by hand
+class manual_interrupt_pin : public hal::interrupt_pin
+{
+public:
+  void trigger(bool p_state)
+  {
+    m_callback(p_state);
+  }
+
+  settings m_settings{};
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  void driver_on_trigger(hal::callback<handler> p_callback) override
+  {
+    m_callback = p_callback;
+  }
+
+  hal::callback<handler> m_callback = [](bool) {};
+};
+
+/// Timer expired by hand, to model a timer interrupt serviced late
+class manual_timer : public hal::timer
+{
+public:
+  void expire()
+  {
+    m_running = false;
+    m_callback();
+  }
+
+private:
+  bool driver_is_running() override
+  {
+    return m_running;
+  }
+
+  void driver_cancel() override
+  {
+    m_running = false;
+  }
+
+  void driver_schedule(hal::callback<void(void)> p_callback,
+                       hal::time_duration) override
+  {
+    m_callback = p_callback;
+    m_running = true;
+  }
+
+  hal::callback<void(void)> m_callback = []() {};
+  bool m_running = false;
+};
+}  // namespace
+
+boost::ut::suite<"isr_profiler_test"> isr_profiler_test = []() {
+  using namespace boost::ut;
+
+  "statistics hold the range and histogram of durations"_test = []() {
+    // Setup
+    isr_statistics test;
+
+    // Exercise
+    test.add(0);
+    test.add(1);
+    test.add(5);
+    test.add(7);
+    test.add(1ULL << 40);
+
+    // Verify
+    expect(that % 5 == test.count);
+    expect(that % 0 == test.min);
+    expect(that % (1ULL << 40) == test.max);
+    expect(that % (13 + (1ULL << 40)) == test.total);
+    expect(that % 1 == test.histogram[0]);
+    expect(that % 1 == test.histogram[1]);
+    expect(that % 2 == test.histogram[3]) << "5 and 7 are in [4, 8)";
+    expect(that % 1 == test.histogram[31]) << "The last bucket clamps";
+  };
+
+  "interrupt pin callbacks are forwarded and timed"_test = []() {
+    // Setup
+    sim::event_loop loop(std::pmr::new_delete_resource());
+    sim::steady_clock clock(loop);
+    manual_interrupt_pin pin;
+    isr_profile profile(clock, "button");
+    profiled_interrupt_pin test(pin, profile);
+    int calls = 0;
+    test.configure({ .trigger = interrupt_pin::trigger_edge::falling });
+    test.on_trigger([&loop, &calls](bool p_state) {
+      calls++;
+      // Simulate work taking longer while the pin is low
+      loop.run_for(p_state ? 2us : 10us);
+    });
+
+    // Exercise
+    pin.trigger(true);
+    pin.trigger(false);
+
+    // Verify
+    expect(interrupt_pin::trigger_edge::falling == pin.m_settings.trigger);
+    expect(that % 2 == calls);
+    expect(that % 2 == profile.statistics().count);
+    expect(that % 2'000 == profile.statistics().min);
+    expect(that % 10'000 == profile.statistics().max);
+    expect(10us == profile.to_duration(profile.statistics().max));
+    expect("button" == profile.name());
+  };
+
+  "can receive callbacks are timed"_test = []() {
+    // Setup
+    sim::event_loop loop(std::pmr::new_delete_resource());
+    sim::steady_clock clock(loop);
+    sim::can_bus bus(loop, std::pmr::new_delete_resource(), 1'000'000);
+    sim::can_node sender(bus, std::pmr::new_delete_resource(), 4);
+    sim::can_node receiver(bus, std::pmr::new_delete_resource(), 4);
+    isr_profile profile(clock, "can");
+    profiled_can_interrupt test(receiver, profile);
+    hal::u32 received_id = 0;
+    test.on_receive([&loop, &received_id](can_interrupt::on_receive_tag,
+                                          can_message const& p_message) {
+      received_id = p_message.id;
+      loop.run_for(3us);
+    });
+
+    // Exercise
+    sender.send(can_message{ .id = 0x42, .length = 1, .payload = {} });
+    loop.run_for(1ms);
+
+    // Verify
+    expect(that % 0x42 == received_id);
+    expect(that % 1 == profile.statistics().count);
+    expect(that % 3'000 == profile.statistics().max);
+  };
+
+  "timer callbacks are timed with their latency"_test = []() {
+    // Setup
+    sim::event_loop loop(std::pmr::new_delete_resource());
+    sim::steady_clock clock(loop);
+    manual_timer timer;
+    isr_profile profile(clock, "timer");
+    profiled_timer test(timer, profile);
+    int calls = 0;
+    test.schedule(
+      [&loop, &calls]() {
+        calls++;
+        loop.run_for(4us);
+      },
+      100us);
+    auto const running = test.is_running();
+
+    // Exercise
+    // Another interrupt blocks the timer interrupt past its expiry
+    loop.run_for(105us);
+    timer.expire();
+
+    // Verify
+    expect(running);
+    expect(that % 1 == calls);
+    expect(not test.is_running());
+    expect(that % 4'000 == profile.statistics().max);
+    expect(that % 1 == test.latency().count);
+    expect(that % 5'000 == test.latency().max);
+  };
+
+  "profiled callbacks time any registration"_test = []() {
+    // Setup
+    sim::event_loop loop(std::pmr::new_delete_resource());
+    sim::steady_clock clock(loop);
+    isr_profile profile(clock, "endpoint");
+    int calls = 0;
+    profiled_callback<int(int)> test(profile, [&loop, &calls](int p_value) {
+      calls++;
+      loop.run_for(1us);
+      return p_value * 2;
+    });
+    auto const registered = test.callback();
+
+    // Exercise
+    auto const result = registered(21);
+
+    // Verify
+    expect(that % 42 == result);
+    expect(that % 1 == calls);
+    expect(that % 1'000 == profile.statistics().max);
+  };
+
+  "worst_case finds the profile blocking the longest"_test = []() {
+    // Setup
+    sim::event_loop loop(std::pmr::new_delete_resource());
+    sim::steady_clock clock(loop);
+    isr_profile fast(clock, "fast");
+    isr_profile slow(clock, "slow");
+    isr_profile idle(clock, "idle");
+    std::array<isr_profile const*, 4> const profiles{
+      &fast, nullptr, &slow, &idle
+    };
+
+    // Exercise
+    auto const none = worst_case(profiles);
+    for (int i = 0; i < 10; i++) {
+      fast.measure([&loop]() { loop.run_for(2us); });
+    }
+    slow.measure([&loop]() { loop.run_for(7us); });
+    auto const worst = worst_case(profiles);
+
+    // Verify
+    expect(none == nullptr);
+    expect(worst == &slow);
+    expect(that % 20'000 == fast.statistics().total);
+    fast.reset();
+    expect(isr_statistics{} == fast.statistics());
+  };
+};
+}  // namespace hal
@@ -0,0 +1,165 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+
+#include <libhal/initializers.hpp>
+#include <libhal/lazy_registry.hpp>
+#include <libhal/output_pin.hpp>
+#include <libhal/pointers.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+int live_pins = 0;
+
+/// Output pin that counts how many instances are alive
+class counted_output_pin : public hal::output_pin
+{
+public:
+  explicit counted_output_pin(u64 p_pin)
+    : m_pin(p_pin)
+  {
+    live_pins++;
+  }
+
+  counted_output_pin(counted_output_pin const&) = delete;
+  counted_output_pin& operator=(counted_output_pin const&) = delete;
+  counted_output_pin(counted_output_pin&&) = delete;
+  counted_output_pin& operator=(counted_output_pin&&) = delete;
+
+  ~counted_output_pin() override
+  {
+    live_pins--;
+  }
+
+  u64 m_pin;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_level(bool p_high) override
+  {
+    m_high = p_high;
+  }
+
+  bool driver_level() override
+  {
+    return m_high;
+  }
+
+  bool m_high = false;
+};
+
+template<u64 pin_number>
+auto make_pin_entry(int& p_calls)
+{
+  return lazy<output_pin>(
+    hal::pin<pin_number>,
+    [&p_calls](std::pmr::polymorphic_allocator<> p_allocator) {
+      p_calls++;
+      return make_strong_ptr<counted_output_pin>(p_allocator, pin_number);
+    });
+}
+}  // namespace
+
+boost::ut::suite<"lazy_registry_test"> lazy_registry_test = []() {
+  using namespace boost::ut;
+
+  "drivers are constructed on first access only"_test = []() {
+    // Setup
+    int led_calls = 0;
+    int buzzer_calls = 0;
+    lazy_registry drivers(std::pmr::new_delete_resource(),
+                          make_pin_entry<3>(led_calls),
+                          make_pin_entry<4>(buzzer_calls));
+    expect(that % 0 == live_pins);
+    expect(that % 0 == drivers.constructed());
+    expect(not drivers.try_get(hal::pin<3>));
+
+    // Exercise
+    auto led = drivers.get(hal::pin<3>);
+    auto again = drivers.get(hal::pin<3>);
+    led->level(true);
+
+    // Verify
+    static_assert(std::is_same_v<strong_ptr<output_pin>, decltype(led)>);
+    expect(that % 1 == led_calls);
+    expect(that % 0 == buzzer_calls);
+    expect(that % 1 == live_pins);
+    expect(that % 1 == drivers.constructed());
+    expect(led == again);
+    expect(again->level());
+    expect(drivers.try_get(hal::pin<3>).has_value());
+    expect(not drivers.try_get(hal::pin<4>));
+  };
+
+  "release lets the driver be destroyed and constructed again"_test = []() {
+    // Setup
+    int calls = 0;
+    lazy_registry drivers(std::pmr::new_delete_resource(),
+                          make_pin_entry<7>(calls));
+    int held_by_user = 0;
+
+    // Exercise
+    {
+      auto const pin = drivers.get(hal::pin<7>);
+      drivers.release(hal::pin<7>);
+      held_by_user = live_pins;
+    }
+    auto const after_user_release = live_pins;
+    auto const rebuilt = drivers.get(hal::pin<7>);
+
+    // Verify
+    expect(that % 1 == held_by_user);
+    expect(that % 0 == after_user_release);
+    expect(that % 2 == calls);
+    expect(that % 1 == live_pins);
+    expect(that % 7 ==
+           static_cast<counted_output_pin const&>(*rebuilt).m_pin);
+  };
+
+  "a failed factory is retried on the next access"_test = []() {
+    // Setup
+    int calls = 0;
+    lazy_registry drivers(
+      std::pmr::new_delete_resource(),
+      lazy<output_pin>(hal::port<2>,
+                       [&calls](std::pmr::polymorphic_allocator<> p_allocator)
+                         -> strong_ptr<output_pin> {
+                         if (++calls == 1) {
+                           throw std::runtime_error("not powered");
+                         }
+                         return make_strong_ptr<counted_output_pin>(
+                           p_allocator, 2U);
+                       }));
+
+    // Exercise
+    expect(throws<std::runtime_error>(
+      [&drivers]() { (void)drivers.get(hal::port<2>); }));
+    auto const pin = drivers.get(hal::port<2>);
+
+    // Verify
+    expect(that % 2 == calls);
+    expect(that % 1 == drivers.constructed());
+  };
+
+  expect(that % 0 == live_pins);
+};
+}  // namespace hal
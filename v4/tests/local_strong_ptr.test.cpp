@@ -0,0 +1,115 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include <libhal/local_strong_ptr.hpp>
+#include <libhal/pool_resource.hpp>
+
+#include "helpers.hpp"
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class base_class
+{
+public:
+  virtual ~base_class() = default;
+  [[nodiscard]] virtual int value() const = 0;
+};
+
+class derived_class : public base_class
+{
+public:
+  explicit derived_class(int p_value)
+    : m_value(p_value)
+  {
+  }
+
+  [[nodiscard]] int value() const override
+  {
+    return m_value;
+  }
+
+private:
+  int m_value;
+};
+}  // namespace
+
+boost::ut::suite<"local_strong_ptr_test"> local_strong_ptr_test = []() {
+  using namespace boost::ut;
+
+  "make_local_strong_ptr() and destruction"_test = []() {
+    // Setup
+    pool_resource<64, 1> pool;
+
+    // Exercise
+    {
+      auto const ptr = make_local_strong_ptr<test_class>(&pool, 42);
+
+      // Verify
+      expect(that % 42 == ptr->value());
+      expect(that % 42 == (*ptr).value());
+      expect(that % 1 == ptr.use_count());
+      expect(that % 1 == test_class::s_instance_count);
+      expect(that % 1 == pool.statistics().in_use);
+    }
+    expect(that % 0 == test_class::s_instance_count);
+    expect(that % 0 == pool.statistics().in_use);
+  };
+
+  "local_strong_ptr copy, move and assignment"_test = []() {
+    // Setup
+    pool_resource<64, 2> pool;
+    auto first = make_local_strong_ptr<test_class>(&pool, 1);
+    auto second = make_local_strong_ptr<test_class>(&pool, 2);
+
+    // Exercise
+    {
+      auto copy = first;
+      auto moved = std::move(copy);
+      expect(that % 3 == first.use_count());
+      // NOLINTNEXTLINE(bugprone-use-after-move)
+      expect(that % 1 == copy->value());
+    }
+    second = first;
+    // NOLINTNEXTLINE(misc-redundant-expression)
+    second = second;
+
+    // Verify
+    expect(that % 2 == first.use_count());
+    expect(that % 1 == second->value());
+    expect(that % 1 == test_class::s_instance_count);
+    expect(that % 1 == pool.statistics().in_use);
+  };
+
+  "local_strong_ptr polymorphism and swap"_test = []() {
+    // Setup
+    pool_resource<64, 2> pool;
+    local_strong_ptr<base_class> base =
+      make_local_strong_ptr<derived_class>(&pool, 5);
+    local_strong_ptr<base_class> other =
+      make_local_strong_ptr<derived_class>(&pool, 7);
+
+    // Exercise
+    swap(base, other);
+
+    // Verify
+    expect(that % 7 == base->value());
+    expect(that % 5 == other->value());
+    expect(that % 1 == base.use_count());
+  };
+};
+}  // namespace hal
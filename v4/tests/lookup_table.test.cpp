@@ -0,0 +1,97 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+
+#include <libhal/lookup_table.hpp>
+#include <libhal/units.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+/// Steinhart-Hart equation of a 10k NTC thermistor, in a divider with a 10k
+/// resistor, as a function of the divider's output as a fraction of the
+/// reference
+template<typename Log>
+constexpr double ntc_celsius(double p_fraction, Log p_log)
+{
+  auto const resistance = 10'000.0 * p_fraction / (1.0 - p_fraction);
+  auto const ln_r = p_log(resistance);
+  auto const inverse_kelvin = 1.009249522e-3 + (2.378405444e-4 * ln_r) +
+                              (2.019202697e-7 * ln_r * ln_r * ln_r);
+  return (1.0 / inverse_kelvin) - 273.15;
+}
+
+constexpr auto ntc = make_lookup_table<129>(0.02f, 0.98f, [](double p_x) {
+  return ntc_celsius(p_x, constexpr_log);
+});
+
+constexpr auto linear = make_lookup_table<3>(
+  -1.0f, 1.0f, [](double p_x) { return (2.0 * p_x) + 1.0; });
+
+// Tables are computed and evaluated while compiling
+static_assert(linear(0.5f) == 2.0f);
+static_assert(linear.samples()[0] == -1.0f);
+static_assert(ntc(0.5f) > 24.0f && ntc(0.5f) < 25.5f);
+}  // namespace
+
+boost::ut::suite<"lookup_table_test"> lookup_table_test = []() {
+  using namespace boost::ut;
+
+  "constexpr_log and constexpr_exp match the C library"_test = []() {
+    for (double const value : { 1e-6, 0.1, 0.5, 1.0, 2.0, 3.3, 1e4, 1e12 }) {
+      expect(std::abs(constexpr_log(value) - std::log(value)) < 1e-12)
+        << value;
+    }
+    for (double const value : { -20.0, -1.0, 0.0, 0.3, 1.0, 10.0, 50.0 }) {
+      auto const expected = std::exp(value);
+      expect(std::abs(constexpr_exp(value) - expected) < expected * 1e-13)
+        << value;
+    }
+    expect(that % 0.0 == constexpr_log(0.0));
+  };
+
+  "linear interpolation reproduces straight lines"_test = []() {
+    expect(that % 1.0f == linear(0.0f));
+    expect(that % -0.5f == linear(-0.75f));
+    expect(that % 2.5f == linear(0.75f));
+  };
+
+  "inputs outside of the range are clamped"_test = []() {
+    expect(that % -1.0f == linear(-5.0f));
+    expect(that % 3.0f == linear(1.0f));
+    expect(that % 3.0f == linear(5.0f));
+    expect(that % -1.0f == linear(NAN));
+  };
+
+  "tabulated thermistor curve follows the equation"_test = []() {
+    // Setup
+    float worst = 0.0f;
+
+    // Exercise
+    for (float fraction = 0.1f; fraction < 0.9f; fraction += 0.001f) {
+      auto const exact = static_cast<float>(
+        ntc_celsius(fraction, [](double p_r) { return std::log(p_r); }));
+      worst = std::max(worst, std::abs(ntc(fraction) - exact));
+    }
+
+    // Verify
+    expect(worst < 0.1f) << "worst error " << worst << " C";
+    expect(ntc.first() == 0.02f);
+    expect(ntc.last() == 0.98f);
+  };
+};
+}  // namespace hal
@@ -0,0 +1,134 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <thread>
+
+#include <libhal/mpmc_queue.hpp>
+#include <libhal/units.hpp>
+
+#include "helpers.hpp"
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+std::pmr::monotonic_buffer_resource mpmc_buffer{ 4096 };
+std::pmr::polymorphic_allocator<byte> mpmc_allocator{ &mpmc_buffer };
+}  // namespace
+
+boost::ut::suite<"mpmc_queue_test"> mpmc_queue_test = []() {
+  using namespace boost::ut;
+
+  "construction"_test = [&] {
+    mpmc_queue<int> queue(mpmc_allocator, 5);
+
+    expect(that % 8 == queue.capacity()) << "Should round up to power of two";
+    expect(that % 0 == queue.size());
+    expect(queue.empty());
+
+    mpmc_queue<int> queue2(mpmc_allocator, 0);
+    expect(that % 2 == queue2.capacity())
+      << "Should enforce minimum capacity of 2";
+
+    expect(that % 0 == test_class::s_instance_count);
+    {
+      mpmc_queue<test_class> queue3(mpmc_allocator, 4);
+      expect(that % 0 == test_class::s_instance_count)
+        << "Construction should not construct any elements";
+    }
+  };
+
+  "try_push_and_try_pop"_test = [&] {
+    mpmc_queue<int> queue(mpmc_allocator, 2);
+
+    expect(queue.try_push(1));
+    expect(queue.try_push(2));
+    expect(not queue.try_push(3)) << "Full queue should reject elements";
+    expect(that % 2 == queue.size());
+
+    expect(that % 1 == queue.try_pop().value());
+    expect(queue.try_push(3));
+    expect(that % 2 == queue.try_pop().value());
+    expect(that % 3 == queue.try_pop().value());
+    expect(not queue.try_pop().has_value());
+    expect(queue.empty());
+  };
+
+  "move_only_and_lifetimes"_test = [&] {
+    mpmc_queue<std::string> queue(mpmc_allocator, 2);
+    std::string value = "Hello World, this string is not short";
+
+    expect(queue.try_push(std::move(value)));
+    auto result = queue.try_pop();
+    expect(result.has_value());
+    expect(that % std::string_view("Hello World, this string is not short") ==
+           *result);
+
+    expect(that % 0 == test_class::s_instance_count);
+    {
+      mpmc_queue<test_class> queue2(mpmc_allocator, 4);
+      queue2.try_emplace(1);
+      queue2.try_emplace(2);
+      queue2.try_emplace(3);
+      expect(that % 3 == test_class::s_instance_count);
+    }
+    expect(that % 0 == test_class::s_instance_count)
+      << "Unread elements should be destroyed with the queue";
+  };
+
+  "concurrent producers and consumers"_test = [&] {
+    // Setup
+    constexpr u32 per_producer = 50'000;
+    mpmc_queue<u32> queue(std::pmr::new_delete_resource(), 16);
+    std::atomic<u64> sum = 0;
+    std::atomic<u32> received = 0;
+    auto const produce = [&queue](u32 p_first) {
+      for (u32 i = 0; i < per_producer; i++) {
+        while (not queue.try_push(p_first + i)) {
+          std::this_thread::yield();
+        }
+      }
+    };
+    auto const consume = [&queue, &sum, &received]() {
+      while (received.load() < 2 * per_producer) {
+        if (auto const value = queue.try_pop()) {
+          sum += *value;
+          received++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    };
+
+    // Exercise
+    std::array threads{ std::thread(produce, 0),
+                        std::thread(produce, per_producer),
+                        std::thread(consume),
+                        std::thread(consume) };
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // Verify
+    constexpr u64 count = 2 * per_producer;
+    expect(that % count == received.load());
+    expect(that % (count * (count - 1) / 2) == sum.load());
+    expect(queue.empty());
+  };
+};
+}  // namespace hal
@@ -0,0 +1,122 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include <libhal/nanosecond_clock.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_steady_clock : public hal::steady_clock
+{
+public:
+  explicit test_steady_clock(hertz p_frequency)
+    : m_frequency(p_frequency)
+  {
+  }
+
+  hertz m_frequency;
+  u64 m_uptime = 0;
+  int m_frequency_reads = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    m_frequency_reads++;
+    return m_frequency;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"nanosecond_clock_test"> nanosecond_clock_test = []() {
+  using namespace boost::ut;
+
+  "nanosecond_clock converts exact frequencies exactly"_test = []() {
+    // Setup
+    test_steady_clock steady(1.0_MHz);
+    nanosecond_clock clock(steady);
+    nanosecond_clock<1'000'000> fixed_clock(steady);
+    steady.m_uptime = 0xFFFF'FFFF'FFFF;
+
+    // Exercise
+    auto const now = clock.now_ns();
+    auto const fixed_now = fixed_clock.now_ns();
+    auto const first_reads = steady.m_frequency_reads;
+    (void)clock.now_ns();
+
+    // Verify
+    expect(that % (0xFFFF'FFFF'FFFF * 1000) == now);
+    expect(that % now == fixed_now);
+    expect(that % first_reads == steady.m_frequency_reads);
+  };
+
+  "nanosecond_clock converts other frequencies within bounds"_test = []() {
+    // Setup
+    test_steady_clock steady(48.0_MHz);
+    nanosecond_clock<48'000'000> clock(steady);
+    constexpr auto ticks = std::to_array<u64>(
+      { 0,
+        1,
+        47,
+        48'000'000,
+        0xFFFF'FFFF,
+        0x1'2345'6789,
+        90'000'000'000,
+        0xFFFF'FFFF'FFFF'FFFF / 125 });
+
+    for (auto const tick : ticks) {
+      // Exercise
+      auto const actual = clock.to_ns(tick);
+
+      // Verify
+      // 1e9 / 48e6 reduces to 125 / 6, split so the reference cannot overflow
+      auto const expected = (tick / 6 * 125) + (tick % 6 * 125 / 6);
+      auto const bound = (expected >> 32U) + 1;
+      expect(actual + bound >= expected and actual <= expected + bound)
+        << "ticks = " << tick;
+    }
+  };
+
+  "nanosecond_clock::to_ns() converts spans in place"_test = []() {
+    // Setup
+    test_steady_clock steady(8.0_MHz);
+    nanosecond_clock clock(steady);
+    std::array<u64, 3> timestamps{ 8, 16, 8'000'000 };
+
+    // Exercise
+    clock.to_ns(timestamps);
+
+    // Verify
+    expect(that % 1'000 == timestamps[0]);
+    expect(that % 2'000 == timestamps[1]);
+    expect(that % 1'000'000'000 == timestamps[2]);
+  };
+
+  "nanosecond_clock rejects mismatched frequencies"_test = []() {
+    // Setup
+    test_steady_clock steady(8.0_MHz);
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { nanosecond_clock<1'000'000> clock(steady); }));
+  };
+};
+}  // namespace hal
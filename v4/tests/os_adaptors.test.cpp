@@ -0,0 +1,136 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <mutex>
+#include <semaphore>
+
+#include <libhal/os_adaptors.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class counting_semaphore
+{
+public:
+  void acquire()
+  {
+    m_count--;
+  }
+
+  void release()
+  {
+    m_count++;
+    m_releases++;
+  }
+
+  int m_count = 0;
+  int m_releases = 0;
+};
+
+class recording_mutex
+{
+public:
+  void lock()
+  {
+    m_locked = true;
+  }
+
+  void unlock()
+  {
+    m_locked = false;
+  }
+
+  bool try_lock()
+  {
+    return not m_locked;
+  }
+
+  bool try_lock_for(hal::time_duration p_duration)
+  {
+    m_duration = p_duration;
+    return not m_locked;
+  }
+
+  bool m_locked = false;
+  hal::time_duration m_duration{};
+};
+}  // namespace
+
+boost::ut::suite<"os_adaptors_test"> os_adaptors_test = []() {
+  using namespace boost::ut;
+  using namespace std::chrono_literals;
+
+  "semaphore_io_waiter keeps a resume that arrives before wait"_test = []() {
+    // Setup
+    std::binary_semaphore semaphore(0);
+    semaphore_io_waiter waiter(semaphore);
+    io_waiter& interface = waiter;
+
+    // Exercise & Verify
+    interface.resume();
+    interface.wait();
+    expect(not semaphore.try_acquire());
+  };
+
+  "semaphore_io_waiter releases once per wait"_test = []() {
+    // Setup
+    counting_semaphore semaphore;
+    semaphore_io_waiter waiter(semaphore);
+
+    // Exercise
+    waiter.resume();
+    waiter.resume();
+    waiter.wait();
+    waiter.resume();
+
+    // Verify
+    expect(that % 2 == semaphore.m_releases);
+    expect(that % 1 == semaphore.m_count);
+  };
+
+  "timed_lock_adaptor forwards to the native mutex"_test = []() {
+    // Setup
+    recording_mutex mutex;
+    timed_lock_adaptor adaptor(mutex);
+    timed_lock& lock = adaptor;
+
+    // Exercise & Verify
+    lock.lock();
+    expect(mutex.m_locked);
+    expect(not lock.try_lock());
+    expect(not lock.try_lock_for(5ms));
+    expect(5ms == mutex.m_duration);
+    lock.unlock();
+    expect(not mutex.m_locked);
+    expect(lock.try_lock());
+  };
+
+  "timed_lock_adaptor works with std::timed_mutex"_test = []() {
+    // Setup
+    std::timed_mutex mutex;
+    timed_lock_adaptor adaptor(mutex);
+
+    // Exercise & Verify
+    expect(adaptor.try_lock_for(1ms));
+    adaptor.unlock();
+    {
+      std::lock_guard guard(adaptor);
+    }
+    expect(mutex.try_lock());
+    mutex.unlock();
+  };
+};
+}  // namespace hal
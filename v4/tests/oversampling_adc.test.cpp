@@ -0,0 +1,245 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include <libhal/oversampling_adc.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+/// Returns a repeating sequence of samples
+class sequence_adc16 : public hal::adc16
+{
+public:
+  explicit sequence_adc16(std::vector<u16> p_samples)
+    : m_samples(std::move(p_samples))
+  {
+  }
+
+  std::vector<u16> m_samples;
+  usize m_reads = 0;
+
+private:
+  u16 driver_read() override
+  {
+    return m_samples[m_reads++ % m_samples.size()];
+  }
+};
+
+/// Fills every scan with samples from a function of the sample number
+class ramp_scan24 : public hal::adc24_scan
+{
+public:
+  u32 m_level = 1'000'000;
+  u32 m_step = 0;
+  usize m_scans = 0;
+  usize m_samples = 0;
+  u8 m_channel = 0;
+
+private:
+  void driver_scan(std::span<u8 const> p_channels,
+                   std::span<u32> p_samples,
+                   std::optional<hertz>) override
+  {
+    m_scans++;
+    m_channel = p_channels[0];
+    for (auto& sample : p_samples) {
+      sample = m_level + static_cast<u32>(m_samples++ % 4) * m_step;
+    }
+  }
+};
+}  // namespace
+
+boost::ut::suite<"oversampling_adc_test"> oversampling_adc_test = []() {
+  using namespace boost::ut;
+
+  "averages each batch of a single sample adc"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    sequence_adc16 source({ 100, 101, 102, 104 });
+    oversampling_adc16 test(&memory, source, { .ratio = 4 });
+    hal::adc16& as_interface = test;
+
+    // Exercise
+    auto const first = as_interface.read();
+    auto const second = as_interface.read();
+
+    // Verify
+    expect(that % 102 == first) << "407 / 4 rounds to 102";
+    expect(that % 102 == second);
+    expect(that % 8 == source.m_reads);
+  };
+
+  "scanning adc is read in a single scan per result"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    ramp_scan24 source;
+    source.m_step = 8;
+    oversampling_adc24 test(&memory, source, 5, { .ratio = 64 });
+
+    // Exercise
+    auto const result = test.read();
+
+    // Verify
+    expect(that % 1'000'012 == result);
+    expect(that % 1 == source.m_scans);
+    expect(that % 64 == source.m_samples);
+    expect(that % 5 == source.m_channel);
+  };
+
+  "higher order filters settle on the first read"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    ramp_scan24 source;
+    oversampling_adc24 test(&memory, source, 0, { .ratio = 16, .order = 3 });
+
+    // Exercise
+    auto const first = test.read();
+    auto const scans_to_settle = source.m_scans;
+    source.m_level = 2'000'000;
+    auto const step_1 = test.read();
+    auto const step_2 = test.read();
+    auto const step_3 = test.read();
+
+    // Verify
+    expect(that % 1'000'000 == first);
+    expect(that % 3 == scans_to_settle);
+    expect(step_1 > 1'000'000 && step_1 < 2'000'000);
+    expect(step_2 > step_1 && step_2 < 2'000'000);
+    expect(that % 2'000'000 == step_3) << "A step settles in `order` results";
+  };
+
+  "statistics follow a sliding window of results"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    sequence_adc16 source({ 10, 30, 20, 40, 50 });
+    oversampling_adc16 test(
+      &memory, source, { .ratio = 1, .statistics_window = 4 });
+
+    // Exercise
+    for (int i = 0; i < 4; i++) {
+      (void)test.read();
+    }
+    auto const filled = test.statistics();
+    (void)test.read();
+    (void)test.read();
+    auto const slid = test.statistics();
+
+    // Verify
+    expect(that % 4 == filled.count);
+    expect(that % 25.0f == filled.mean);
+    expect(that % 125.0f == filled.variance);
+    expect(that % 10 == filled.min);
+    expect(that % 40 == filled.max);
+
+    // Window now holds 20, 40, 50, 10
+    expect(that % 4 == slid.count);
+    expect(that % 30.0f == slid.mean);
+    expect(that % 250.0f == slid.variance);
+    expect(that % 10 == slid.min);
+    expect(that % 50 == slid.max);
+    expect(that % 10 == test.history()[test.history().write_index() + 3]);
+  };
+
+  "minimum and maximum leave the window with their result"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    sequence_adc16 source({ 5, 90, 50, 50, 50, 50 });
+    oversampling_adc16 test(
+      &memory, source, { .ratio = 1, .statistics_window = 3 });
+
+    // Exercise
+    for (int i = 0; i < 4; i++) {
+      (void)test.read();
+    }
+    auto const without_first = test.statistics();
+    (void)test.read();
+    auto const only_fifties = test.statistics();
+
+    // Verify
+    expect(that % 50 == without_first.min);
+    expect(that % 90 == without_first.max);
+    expect(that % 50 == only_fifties.min);
+    expect(that % 50 == only_fifties.max);
+    expect(that % 0.0f == only_fifties.variance);
+  };
+
+  "statistics of a large offset keep their precision"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    ramp_scan24 source;
+    source.m_level = 8'000'000;
+    source.m_step = 1;
+    oversampling_adc24 test(
+      &memory, source, 0, { .ratio = 1, .statistics_window = 8 });
+
+    // Exercise
+    for (int i = 0; i < 20; i++) {
+      (void)test.read();
+    }
+    auto const result = test.statistics();
+
+    // Verify
+    expect(that % 1.25f == result.variance);
+    expect(that % 8'000'001.5f == result.mean);
+  };
+
+  "resetting statistics starts a new window"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    sequence_adc16 source({ 7 });
+    oversampling_adc16 test(&memory, source, {});
+    (void)test.read();
+
+    // Exercise
+    test.reset_statistics();
+    auto const cleared = test.statistics();
+    source.m_samples = { 9 };
+    (void)test.read();
+    auto const after = test.statistics();
+
+    // Verify
+    expect(that % 0 == cleared.count);
+    expect(that % 1 == after.count);
+    expect(that % 9 == after.min);
+    expect(that % 9.0f == after.mean);
+  };
+
+  "settings that could overflow the filter are rejected"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource memory;
+    sequence_adc16 source({ 0 });
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      oversampling_adc16(&memory, source, { .ratio = 0 });
+    }));
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      oversampling_adc16(&memory, source, { .order = 5 });
+    }));
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      oversampling_adc16(&memory, source, { .ratio = 2048, .order = 3 });
+    }));
+    expect(nothrow([&]() {
+      oversampling_adc16(&memory, source, { .ratio = 256, .order = 4 });
+    }));
+  };
+};
+}  // namespace hal
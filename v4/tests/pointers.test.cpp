@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <atomic>
 #include <memory_resource>
+#include <optional>
+#include <thread>
 
 #include <libhal/pointers.hpp>
 
@@ -53,6 +57,42 @@ private:
 std::pmr::monotonic_buffer_resource test_buffer{ 4096 };
 std::pmr::polymorphic_allocator<> test_allocator{ &test_buffer };
 
+// A null control block is the empty state, so optional_ptr adds no flag
+static_assert(sizeof(optional_ptr<derived_class>) ==
+              sizeof(strong_ptr<derived_class>));
+static_assert(sizeof(optional_ptr<base_class>) == 2 * sizeof(void*));
+static_assert(sizeof(optional_ptr<int>) <
+              sizeof(std::optional<strong_ptr<int>>));
+
+// Counts allocations that have not been deallocated
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+  std::atomic<int> m_outstanding = 0;
+
+private:
+  void* do_allocate(std::size_t p_bytes, std::size_t p_alignment) override
+  {
+    m_outstanding++;
+    return std::pmr::new_delete_resource()->allocate(p_bytes, p_alignment);
+  }
+
+  void do_deallocate(void* p_address,
+                     std::size_t p_bytes,
+                     std::size_t p_alignment) override
+  {
+    m_outstanding--;
+    std::pmr::new_delete_resource()->deallocate(
+      p_address, p_bytes, p_alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(
+    std::pmr::memory_resource const& p_other) const noexcept override
+  {
+    return this == &p_other;
+  }
+};
+
 }  // namespace
 
 // Strong pointer test suite
@@ -353,6 +393,68 @@ boost::ut::suite<"weak_ptr_test"> weak_ptr_test = []() {
       expect(that % false == bool(locked))
         << "Locking expired weak_ptr should return null optional\n";
     };
+
+  "memory is freed by the last reference of either kind"_test = [&] {
+    // Setup
+    counting_resource memory;
+
+    // Exercise
+    {
+      weak_ptr<test_class> weak;
+      {
+        auto strong = make_strong_ptr<test_class>(&memory, 42);
+        weak = strong;
+      }
+      expect(that % 0 == test_class::s_instance_count)
+        << "Object should be destroyed with its last strong_ptr\n";
+      expect(that % 1 == memory.m_outstanding)
+        << "Control block should outlive the object for the weak_ptr\n";
+    }
+    {
+      auto strong = make_strong_ptr<test_class>(&memory, 7);
+      weak_ptr<test_class> weak = strong;
+      weak = weak_ptr<test_class>();
+    }
+
+    // Verify
+    expect(that % 0 == memory.m_outstanding)
+      << "Memory should be freed once every reference is gone\n";
+  };
+
+  "concurrent copies, locks and releases keep the counts exact"_test = [&] {
+    // Setup
+    constexpr int rounds = 2'000;
+    counting_resource memory;
+    std::atomic<int> failed_locks = 0;
+
+    // Exercise
+    {
+      auto shared = make_strong_ptr<test_class>(&memory, 42);
+      weak_ptr<test_class> const weak = shared;
+      auto const contend = [&]() {
+        for (int i = 0; i < rounds; i++) {
+          auto copy = shared;
+          auto locked = weak.lock();
+          if (not locked) {
+            failed_locks++;
+          }
+          if (i % 64 == 0) {
+            std::this_thread::yield();
+          }
+        }
+      };
+      std::array threads{ std::thread(contend), std::thread(contend) };
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      expect(that % 1 == shared.use_count());
+    }
+
+    // Verify
+    expect(that % 0 == failed_locks.load());
+    expect(that % 0 == test_class::s_instance_count);
+    expect(that % 0 == memory.m_outstanding);
+  };
 };
 
 // Optional pointer test suite
@@ -920,4 +1022,70 @@ boost::ut::suite<"bad_weak_ptr_test"> bad_weak_ptr_test = []() {
   };
 };
 
+namespace {
+class static_driver : public enable_strong_from_this<static_driver>
+{
+public:
+  explicit static_driver(int p_value)
+    : m_value(p_value)
+  {
+  }
+
+  ~static_driver()
+  {
+    s_destroyed = true;
+  }
+
+  static inline bool s_destroyed = false;
+  int m_value;
+};
+}  // namespace
+
+boost::ut::suite<"make_static_strong_ptr_test"> make_static_strong_ptr_test =
+  []() {
+    using namespace boost::ut;
+
+    "make_static_strong_ptr() points to the object"_test = []() {
+      // Setup
+      static derived_class driver(5);
+
+      // Exercise
+      strong_ptr<base_class> ptr = make_static_strong_ptr(driver);
+      auto copy = ptr;
+
+      // Verify
+      expect(that % 5 == copy->value());
+      expect(that % &driver == &(*copy));
+    };
+
+    "make_static_strong_ptr() never destroys the object"_test = []() {
+      // Setup
+      static static_driver driver(7);
+
+      // Exercise
+      {
+        auto ptr = make_static_strong_ptr(driver);
+        weak_ptr<static_driver> weak = ptr;
+        expect(not weak.expired());
+      }
+
+      // Verify
+      expect(not static_driver::s_destroyed);
+      expect(that % 7 == driver.m_value);
+    };
+
+    "make_static_strong_ptr() enables strong_from_this()"_test = []() {
+      // Setup
+      static static_driver driver(3);
+
+      // Exercise
+      auto const ptr = make_static_strong_ptr(driver);
+      auto const self = driver.strong_from_this();
+
+      // Verify
+      expect(that % &driver == &(*self));
+      expect(that % 3 == self->m_value);
+      expect(not driver.weak_from_this().expired());
+    };
+  };
 }  // namespace hal
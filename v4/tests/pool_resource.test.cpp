@@ -0,0 +1,134 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstdint>
+#include <new>
+
+#include <libhal/pool_resource.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+struct sensor
+{
+  explicit sensor(u32 p_id)
+    : id(p_id)
+  {
+  }
+  u32 id;
+  std::array<u32, 3> data{};
+};
+}  // namespace
+
+boost::ut::suite<"pool_resource_test"> pool_resource_test = []() {
+  using namespace boost::ut;
+
+  "pool_resource::block_size rounds up to the block alignment"_test = []() {
+    // Exercise & Verify
+    expect(that % alignof(std::max_align_t) == pool_resource<1, 1>::block_size);
+    expect(that % 0 == pool_resource<33, 1>::block_size %
+                         alignof(std::max_align_t));
+    expect(sizeof(v5::detail::rc<sensor>) <=
+           strong_ptr_pool<sensor, 1>::block_size);
+  };
+
+  "pool_resource aligns blocks to its alignment"_test = []() {
+    // Setup
+    pool_resource<40, 3, 64> pool;
+
+    // Exercise
+    auto* first = pool.allocate(40, 64);
+    auto* second = pool.allocate(40, 64);
+
+    // Verify
+    expect(that % 64 == pool_resource<40, 3, 64>::block_size);
+    expect(that % 0 == reinterpret_cast<std::uintptr_t>(first) % 64);
+    expect(that % 0 == reinterpret_cast<std::uintptr_t>(second) % 64);
+    expect(throws<std::bad_alloc>([&pool]() { (void)pool.allocate(8, 128); }));
+    pool.deallocate(first, 40, 64);
+    pool.deallocate(second, 40, 64);
+  };
+
+  "pool_resource reuses freed blocks"_test = []() {
+    // Setup
+    pool_resource<16, 2> pool;
+
+    // Exercise
+    auto* first = pool.allocate(16);
+    auto* second = pool.allocate(8);
+    pool.deallocate(first, 16);
+    auto* third = pool.allocate(16);
+
+    // Verify
+    expect(that % first == third);
+    expect(that % first != second);
+    expect(pool_statistics{ .in_use = 2, .high_water = 2 } ==
+           pool.statistics());
+  };
+
+  "pool_resource throws when exhausted or oversized"_test = []() {
+    // Setup
+    pool_resource<16, 1> pool;
+    auto* block = pool.allocate(16);
+
+    // Exercise & Verify
+    expect(throws<std::bad_alloc>([&]() { (void)pool.allocate(16); }));
+    pool.deallocate(block, 16);
+    expect(throws<std::bad_alloc>([&]() { (void)pool.allocate(64); }));
+    expect(that % 2 == pool.statistics().failures);
+    expect(that % 0 == pool.statistics().in_use);
+  };
+
+  "pool_resource::reset_high_water()"_test = []() {
+    // Setup
+    pool_resource<16, 4> pool;
+    auto* first = pool.allocate(16);
+    auto* second = pool.allocate(16);
+    pool.deallocate(second, 16);
+
+    // Exercise
+    auto const before = pool.statistics().high_water;
+    pool.reset_high_water();
+
+    // Verify
+    expect(that % 2 == before);
+    expect(that % 1 == pool.statistics().high_water);
+    pool.deallocate(first, 16);
+  };
+
+  "strong_ptr_pool backs make_strong_ptr"_test = []() {
+    // Setup
+    strong_ptr_pool<sensor, 2> pool;
+
+    // Exercise
+    {
+      auto const first = make_strong_ptr<sensor>(&pool, 1);
+      auto const second = make_strong_ptr<sensor>(&pool, 2);
+      expect(that % 2 == pool.statistics().in_use);
+      expect(throws<std::bad_alloc>(
+        [&]() { (void)make_strong_ptr<sensor>(&pool, 3); }));
+      expect(that % 1 == first->id);
+      expect(that % 2 == second->id);
+    }
+    auto const third = make_strong_ptr<sensor>(&pool, 3);
+
+    // Verify
+    expect(that % 1 == pool.statistics().in_use);
+    expect(that % 2 == pool.statistics().high_water);
+    expect(that % 3 == third->id);
+  };
+};
+}  // namespace hal
@@ -14,6 +14,8 @@
 
 #include <libhal/pwm.hpp>
 
+#include <array>
+
 #include <libhal/error.hpp>
 
 #include <boost/ut.hpp>
@@ -86,6 +88,51 @@ boost::ut::suite<"pwm_group_manager_test"> pwm_group_manager_test = []() {
     expect(that % test_pwm_group_manager::expected_frequency ==
            test.m_frequency);
   };
+
+  "::duty_cycles() is optional"_test = []() {
+    // Setup
+    test_pwm_group_manager test;
+    std::array<u16, 3> const duty_cycles{ 0, 1U << 15U, 0xFFFF };
+
+    // Exercise & Verify
+    expect(throws<hal::operation_not_supported>(
+      [&]() { test.duty_cycles(duty_cycles); }));
+  };
+
+  "::duty_cycles() commits all channels"_test = []() {
+    // Setup
+    class shadowed_group : public hal::pwm_group_manager
+    {
+    public:
+      std::array<u16, 6> m_committed{};
+      int m_commits = 0;
+
+    private:
+      void driver_frequency(u32) override
+      {
+      }
+
+      void driver_duty_cycles(std::span<u16 const> p_duty_cycles) override
+      {
+        if (p_duty_cycles.size() > m_committed.size()) {
+          hal::safe_throw(hal::argument_out_of_domain(this));
+        }
+        std::ranges::copy(p_duty_cycles, m_committed.begin());
+        m_commits++;
+      }
+    } test;
+    std::array<u16, 6> const phases{ 1, 2, 3, 4, 5, 6 };
+    std::array<u16, 7> const too_many{};
+
+    // Exercise
+    test.duty_cycles(phases);
+
+    // Verify
+    expect(phases == test.m_committed);
+    expect(that % 1 == test.m_commits);
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.duty_cycles(too_many); }));
+  };
 };
 }  // namespace hal
 
@@ -0,0 +1,144 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <libhal/pwm_stream.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_pwm_stream : public hal::pwm_stream
+{
+public:
+  hal::hertz m_frequency = 0.0f;
+  std::span<u16> m_buffer{};
+  std::optional<hal::callback<refill_handler>> m_refill{};
+  std::vector<u16> m_output{};
+  usize m_block = 0;
+
+  /// Simulate the DMA finishing the block currently being played
+  void finish_block()
+  {
+    auto const half = m_buffer.size() / 2;
+    auto const block = m_buffer.subspan(m_block * half, half);
+    m_output.insert(m_output.end(), block.begin(), block.end());
+    m_block ^= 1;
+    (*m_refill)(on_refill_tag{}, block);
+  }
+
+private:
+  void driver_write(sequence const& p_sequence) override
+  {
+    if (m_refill) {
+      hal::safe_throw(hal::device_or_resource_busy(this));
+    }
+    m_frequency = p_sequence.frequency;
+    m_output.insert(m_output.end(),
+                    p_sequence.duty_cycles.begin(),
+                    p_sequence.duty_cycles.end());
+  }
+
+  void driver_start(hal::hertz p_frequency,
+                    std::span<u16> p_buffer,
+                    hal::callback<refill_handler> p_refill) override
+  {
+    if (p_buffer.empty() || p_buffer.size() % 2 != 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_frequency = p_frequency;
+    m_buffer = p_buffer;
+    m_refill = p_refill;
+    m_block = 0;
+  }
+
+  void driver_stop() override
+  {
+    m_refill.reset();
+  }
+
+  bool driver_playing() override
+  {
+    return m_refill.has_value();
+  }
+};
+}  // namespace
+
+boost::ut::suite<"pwm_stream_test"> pwm_stream_test = []() {
+  using namespace boost::ut;
+
+  "pwm_stream::write() outputs one duty cycle per period"_test = []() {
+    // Setup
+    test_pwm_stream test;
+    std::array<u16, 4> const bits{ 0x5555, 0xAAAA, 0x5555, 0xAAAA };
+
+    // Exercise
+    test.write({ .frequency = 800.0_kHz, .duty_cycles = bits });
+
+    // Verify
+    expect(that % 800.0_kHz == test.m_frequency);
+    expect(std::vector<u16>(bits.begin(), bits.end()) == test.m_output);
+    expect(not test.playing());
+  };
+
+  "pwm_stream plays refilled blocks continuously"_test = []() {
+    // Setup
+    test_pwm_stream test;
+    std::array<u16, 4> buffer{ 0, 1, 2, 3 };
+    std::array<u16, 1> const bits{};
+    u16 next_duty_cycle = 4;
+    usize refills = 0;
+
+    // Exercise
+    test.start(20.0_kHz, buffer, [&](auto, std::span<u16> p_block) {
+      refills++;
+      for (auto& duty_cycle : p_block) {
+        duty_cycle = next_duty_cycle++;
+      }
+    });
+    auto const playing = test.playing();
+    test.finish_block();
+    test.finish_block();
+    test.finish_block();
+    auto const busy = throws<hal::device_or_resource_busy>(
+      [&]() { test.write({ .frequency = 20.0_kHz, .duty_cycles = bits }); });
+    test.stop();
+
+    // Verify
+    expect(playing);
+    expect(busy);
+    expect(not test.playing());
+    expect(that % 20.0_kHz == test.m_frequency);
+    expect(that % 3 == refills);
+    expect(std::vector<u16>{ 0, 1, 2, 3, 4, 5 } == test.m_output);
+  };
+
+  "pwm_stream::start() rejects odd buffers"_test = []() {
+    // Setup
+    test_pwm_stream test;
+    std::array<u16, 3> buffer{};
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      test.start(20.0_kHz, buffer, [](auto, std::span<u16>) {});
+    }));
+    expect(not test.playing());
+  };
+};
+}  // namespace hal
@@ -0,0 +1,96 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+
+#include <libhal/initializers.hpp>
+#include <libhal/resource_map.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+enum class owner : u8
+{
+  console,
+  sensors,
+  motor,
+};
+
+constexpr auto console_tx = pin_resource(port<0>, pin<2>);
+constexpr auto console_rx = pin_resource(port<0>, pin<3>);
+constexpr auto sensor_dma = dma_resource(bus<1>, channel<4>);
+constexpr auto motor_pwm = timer_resource(bus<2>, channel<1>);
+
+constexpr auto board =
+  make_resource_map<owner>(claim(owner::motor, motor_pwm),
+                           claim(owner::console, console_rx),
+                           claim(owner::sensors, sensor_dma),
+                           claim(owner::console, console_tx),
+                           claim(owner::sensors, peripheral_resource(bus<1>)));
+
+// Lookups are constant expressions
+static_assert(board.size() == 5);
+static_assert(board.owner(console_tx) == owner::console);
+static_assert(board.owner(sensor_dma) == owner::sensors);
+static_assert(not board.owner(pin_resource(port<0>, pin<4>)).has_value());
+static_assert(board.index(console_tx) + 1 == board.index(console_rx));
+static_assert(board.index(pin_resource(port<1>, pin<2>)) == board.size());
+
+constexpr std::array conflicting{
+  claim(owner::console, console_tx),
+  claim(owner::motor, pin_resource(port<0>, pin<2>)),
+};
+static_assert(
+  has_conflicts(std::span<resource_claim<owner> const>(conflicting)));
+}  // namespace
+
+boost::ut::suite<"resource_map_test"> resource_map_test = []() {
+  using namespace boost::ut;
+
+  "claims are sorted into dense indices"_test = []() {
+    // Setup
+    std::array<bool, board.size()> used{};
+
+    // Exercise
+    for (auto const& entry : board.claims()) {
+      used[board.index(entry.value)] = true;
+    }
+
+    // Verify
+    for (auto const entry : used) {
+      expect(entry);
+    }
+    expect(board.claims()[0].value == console_tx);
+    expect(board.claims()[1].value == console_rx);
+    expect(board.contains(motor_pwm));
+    expect(not board.contains(timer_resource(bus<2>, channel<2>)));
+  };
+
+  "resources of different kinds do not conflict"_test = []() {
+    // Setup
+    std::array const claims{
+      claim(owner::console, pin_resource(port<1>, pin<1>)),
+      claim(owner::sensors, dma_resource(bus<1>, channel<1>)),
+      claim(owner::motor, timer_resource(bus<1>, channel<1>)),
+      claim(owner::motor, peripheral_resource(port<1>)),
+    };
+
+    // Exercise & Verify
+    expect(not has_conflicts(std::span<resource_claim<owner> const>(claims)));
+    expect(has_conflicts(std::span<resource_claim<owner> const>(conflicting)));
+  };
+};
+}  // namespace hal
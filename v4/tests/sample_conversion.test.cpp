@@ -0,0 +1,145 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal/sample_conversion.hpp>
+
+#include <array>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+boost::ut::suite<"sample_conversion_test"> sample_conversion_test = []() {
+  using namespace boost::ut;
+
+  "adc16_to_q15() & adc16_to_q31()"_test = []() {
+    // Setup
+    std::array<u16 const, 3> const samples{ 0x0000, 0x8000, 0xFFFF };
+    std::array<i16, 4> q15{};
+    std::array<i32, 3> q31{};
+
+    // Exercise
+    auto const q15_result = hal::adc16_to_q15(samples, q15);
+    auto const q31_result = hal::adc16_to_q31(samples, q31);
+
+    // Verify
+    expect(that % 3 == q15_result.size());
+    expect(that % 0 == q15[0]);
+    expect(that % 0x4000 == q15[1]);
+    expect(that % 0x7FFF == q15[2]);
+    expect(that % 0 == q31[0]);
+    expect(that % 0x4000'4000 == q31[1]);
+    expect(that % 0x7FFF'FFFF == q31[2]);
+    expect(that % 3 == q31_result.size());
+  };
+
+  "adc24_to_q31()"_test = []() {
+    // Setup
+    std::array<u32 const, 3> const samples{ 0x00'0000, 0x80'0000, 0xFF'FFFF };
+    std::array<i32, 3> q31{};
+
+    // Exercise
+    hal::adc24_to_q31(samples, q31);
+
+    // Verify
+    expect(that % 0 == q31[0]);
+    expect(that % 0x4000'0040 == q31[1]);
+    expect(that % 0x7FFF'FFFF == q31[2]);
+  };
+
+  "float conversions match the float interfaces"_test = []() {
+    // Setup
+    std::array<u16 const, 3> const samples16{ 0x0000, 0x7FFF, 0xFFFF };
+    std::array<u32 const, 2> const samples24{ 0x00'0000, 0xFF'FFFF };
+    std::array<float, 3> floats16{};
+    std::array<float, 2> floats24{};
+
+    // Exercise
+    hal::adc16_to_float(samples16, floats16);
+    hal::adc24_to_float(samples24, floats24);
+
+    // Verify
+    expect(that % 0.0f == floats16[0]);
+    expect(floats16[1] > 0.4999f);
+    expect(floats16[1] < 0.5f);
+    expect(that % 1.0f == floats16[2]);
+    expect(that % 0.0f == floats24[0]);
+    expect(that % 1.0f == floats24[1]);
+  };
+
+  "q15_to_dac16() & q31_to_dac16()"_test = []() {
+    // Setup
+    std::array<i16 const, 4> const q15{ -0x4000, 0, 0x4000, 0x7FFF };
+    std::array<i32 const, 4> const q31{ -1, 0, 0x4000'0000, 0x7FFF'FFFF };
+    std::array<u16, 4> from_q15{};
+    std::array<u16, 4> from_q31{};
+
+    // Exercise
+    hal::q15_to_dac16(q15, from_q15);
+    hal::q31_to_dac16(q31, from_q31);
+
+    // Verify
+    expect(that % 0 == from_q15[0]);
+    expect(that % 0 == from_q15[1]);
+    expect(that % 0x8001 == from_q15[2]);
+    expect(that % 0xFFFF == from_q15[3]);
+    expect(that % 0 == from_q31[0]);
+    expect(that % 0 == from_q31[1]);
+    expect(that % 0x8000 == from_q31[2]);
+    expect(that % 0xFFFF == from_q31[3]);
+  };
+
+  "float_to_dac16() clamps & rounds"_test = []() {
+    // Setup
+    std::array<float const, 4> const values{ -0.5f, 0.25f, 1.0f, 2.0f };
+    std::array<u16, 4> output{};
+
+    // Exercise
+    hal::float_to_dac16(values, output);
+
+    // Verify
+    expect(that % 0 == output[0]);
+    expect(that % 16384 == output[1]);
+    expect(that % 0xFFFF == output[2]);
+    expect(that % 0xFFFF == output[3]);
+  };
+
+  "round trip from adc16 to dac16 through q15 is lossless to 15 bits"_test =
+    []() {
+      // Setup
+      std::array<u16 const, 3> const samples{ 0x1234, 0xABCD, 0xFFFF };
+      std::array<i16, 3> q15{};
+      std::array<u16, 3> output{};
+
+      // Exercise
+      hal::q15_to_dac16(hal::adc16_to_q15(samples, q15), output);
+
+      // Verify
+      for (usize i = 0; i < samples.size(); i++) {
+        expect(that % (samples[i] >> 1) == (output[i] >> 1));
+      }
+    };
+
+  "throws when the output is too small"_test = []() {
+    // Setup
+    std::array<u16 const, 3> const samples{};
+    std::array<i16, 2> q15{};
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { hal::adc16_to_q15(samples, q15); }));
+  };
+};
+}  // namespace hal
@@ -188,5 +188,106 @@ boost::ut::suite<"scatter_api_test"> scatter_api_test = []() {
 
     expect(that % (se == sg));
   };
+
+  "scatter_span operator== skips empty segments"_test = []() {
+    // Setup
+    std::array<byte, 3> const a{ 1, 2, 3 };
+    std::array<byte, 2> const b{ 4, 5 };
+    std::array<byte, 5> const joined{ 1, 2, 3, 4, 5 };
+    std::span<byte const> const none{};
+    auto const split = make_scatter_bytes(none, a, none, none, b, none);
+    auto const whole = make_scatter_bytes(joined);
+    auto const only_empty = make_scatter_bytes(none, none);
+    auto const nothing = make_scatter_bytes();
+
+    // Verify
+    expect(scatter_span<byte const>(split) == scatter_span<byte const>(whole));
+    expect(scatter_span<byte const>(only_empty) ==
+           scatter_span<byte const>(nothing));
+    expect(scatter_span<byte const>(split) !=
+           scatter_span<byte const>(only_empty));
+  };
+
+  "scatter_span operator== in constant expressions"_test = []() {
+    constexpr auto equal = []() {
+      std::array<u16, 3> a{ 1, 2, 3 };
+      std::array<u16, 3> b{ 1, 2, 3 };
+      std::array<std::span<u16>, 2> const lhs{ std::span(a).first(1),
+                                               std::span(a).subspan(1) };
+      std::array<std::span<u16>, 1> const rhs{ std::span(b) };
+      return scatter_span<u16>(lhs) == scatter_span<u16>(rhs);
+    };
+    static_assert(equal());
+    expect(equal());
+  };
+
+  "scatter_size"_test = []() {
+    // Setup
+    std::array<byte, 3> const a{};
+    std::array<byte, 7> const b{};
+    auto const segments = make_scatter_bytes(a, std::span<byte const>{}, b);
+
+    // Verify
+    expect(that % 10 == scatter_size(scatter_span<byte const>(segments)));
+    expect(that % 0 == scatter_size(scatter_span<byte const>{}));
+  };
+
+  "scatter_copy between topologies"_test = []() {
+    // Setup
+    std::array<byte, 2> const a{ 1, 2 };
+    std::array<byte, 3> const b{ 3, 4, 5 };
+    auto const source = make_scatter_bytes(a, std::span<byte const>{}, b);
+    std::array<byte, 1> x{};
+    std::array<byte, 3> y{};
+    std::array<byte, 2> z{};
+    auto const destination = make_writable_scatter_bytes(x, y, z);
+
+    // Exercise
+    auto const copied = scatter_copy(scatter_span<byte const>(source),
+                                     scatter_span<byte>(destination));
+
+    // Verify
+    expect(that % 5 == copied);
+    expect(std::array<byte, 1>{ 1 } == x);
+    expect(std::array<byte, 3>{ 2, 3, 4 } == y);
+    expect(std::array<byte, 2>{ 5, 0 } == z);
+  };
+
+  "scatter_copy gathers into and scatters from contiguous buffers"_test =
+    []() {
+      // Setup
+      std::array<byte, 2> const a{ 1, 2 };
+      std::array<byte, 3> const b{ 3, 4, 5 };
+      auto const source = make_scatter_bytes(a, b);
+      std::array<byte, 4> bounce{};
+      std::array<byte, 1> x{};
+      std::array<byte, 2> y{};
+      auto const destination = make_writable_scatter_bytes(x, y);
+
+      // Exercise
+      auto const gathered =
+        scatter_copy(scatter_span<byte const>(source), std::span<byte>(bounce));
+      auto const scattered = scatter_copy(std::span<byte const>(bounce),
+                                          scatter_span<byte>(destination));
+
+      // Verify
+      expect(that % 4 == gathered);
+      expect(std::array<byte, 4>{ 1, 2, 3, 4 } == bounce);
+      expect(that % 3 == scattered);
+      expect(std::array<byte, 1>{ 1 } == x);
+      expect(std::array<byte, 2>{ 2, 3 } == y);
+    };
+
+  "scatter_copy in constant expressions"_test = []() {
+    constexpr auto copy = []() {
+      std::array<int, 3> const a{ 7, 8, 9 };
+      std::array<std::span<int const>, 1> const source{ std::span(a) };
+      std::array<int, 3> b{};
+      scatter_copy(scatter_span<int const>(source), std::span<int>(b));
+      return b[0] + b[1] + b[2];
+    };
+    static_assert(24 == copy());
+    expect(that % 24 == copy());
+  };
 };
 }  // namespace hal
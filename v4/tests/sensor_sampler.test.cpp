@@ -0,0 +1,134 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory_resource>
+
+#include <libhal/sensor_sampler.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_timer : public hal::timer
+{
+public:
+  std::optional<hal::callback<void(void)>> m_callback{};
+  hal::time_duration m_delay{};
+  int m_cancels = 0;
+
+  /// Simulate the timer expiring
+  void expire()
+  {
+    auto callback = *m_callback;
+    m_callback.reset();
+    callback();
+  }
+
+private:
+  bool driver_is_running() override
+  {
+    return m_callback.has_value();
+  }
+
+  void driver_cancel() override
+  {
+    m_callback.reset();
+    m_cancels++;
+  }
+
+  void driver_schedule(hal::callback<void(void)> p_callback,
+                       hal::time_duration p_delay) override
+  {
+    m_callback = p_callback;
+    m_delay = p_delay;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"sensor_sampler_test"> sensor_sampler_test = []() {
+  using namespace boost::ut;
+  using namespace std::chrono_literals;
+
+  "decimator averages groups of samples"_test = []() {
+    // Setup
+    decimator<float> test(3);
+
+    // Exercise
+    auto const first = test.push(1.0f);
+    auto const second = test.push(2.0f);
+    auto const third = test.push(6.0f);
+    auto const fourth = test.push(4.0f);
+
+    // Verify
+    expect(not first.has_value());
+    expect(not second.has_value());
+    expect(that % 3.0f == third.value());
+    expect(not fourth.has_value());
+    expect(throws<hal::argument_out_of_domain>([]() { decimator<float>(0); }));
+  };
+
+  "moving_average updates incrementally"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource resource{ 256 };
+    moving_average<float> test(&resource, 3);
+
+    // Exercise
+    auto const partial = test.push(3.0f);
+    test.push(6.0f);
+    auto const full = test.push(9.0f);
+    auto const slid = test.push(12.0f);
+    test.reset();
+
+    // Verify
+    expect(that % 3.0f == partial);
+    expect(that % 6.0f == full);
+    expect(that % 9.0f == slid);
+    expect(that % 0.0f == test.value());
+    expect(that % 3 == test.window());
+  };
+
+  "periodic_sampler decimates into the buffer"_test = []() {
+    // Setup
+    std::pmr::monotonic_buffer_resource resource{ 256 };
+    test_timer timer;
+    circular_buffer<float> history(&resource, 4);
+    float angle = 0.0f;
+    periodic_sampler<float> sampler(
+      &resource,
+      timer,
+      [&angle]() { return angle += 1.0f; },
+      history,
+      { .period = 100us, .decimation = 2, .average_window = 2 });
+
+    // Exercise
+    sampler.start();
+    for (int i = 0; i < 6; i++) {
+      timer.expire();
+    }
+    sampler.stop();
+
+    // Verify
+    expect(100us == timer.m_delay);
+    expect(that % 3 == sampler.count());
+    // Reads 1..6 become 1.5, 3.5, 5.5
+    expect(that % 1.5f == history[0]);
+    expect(that % 3.5f == history[1]);
+    expect(that % 5.5f == history[2]);
+    expect(that % 4.5f == sampler.average());
+    expect(not timer.m_callback.has_value());
+  };
+};
+}  // namespace hal
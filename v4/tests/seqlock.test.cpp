@@ -0,0 +1,108 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include <libhal/accelerometer.hpp>
+#include <libhal/imu.hpp>
+#include <libhal/seqlock.hpp>
+#include <libhal/servo.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+// Sensor readings and servo status are snapshotted with a seqlock
+[[maybe_unused]] seqlock<accelerometer::read_t> const acceleration_snapshot{};
+[[maybe_unused]] seqlock<imu::read_t> const imu_snapshot{};
+[[maybe_unused]] seqlock<velocity_servo::status_t> const servo_snapshot{};
+
+/// Value whose halves are always written together, so a torn copy is visible
+struct pair_t
+{
+  std::array<u32, 8> first;
+  std::array<u32, 8> second;
+};
+}  // namespace
+
+boost::ut::suite<"seqlock_test"> seqlock_test = []() {
+  using namespace boost::ut;
+
+  "seqlock holds its initial value until written"_test = []() {
+    // Setup
+    seqlock<u32> const initialized(7);
+    seqlock<u32> const defaulted;
+
+    // Exercise & Verify
+    expect(that % 7 == initialized.read());
+    expect(that % 0 == defaulted.read());
+  };
+
+  "seqlock returns the latest write"_test = []() {
+    // Setup
+    seqlock<accelerometer::read_t> latest;
+
+    // Exercise
+    latest.write({ .x = 1.0f, .y = 2.0f, .z = 3.0f });
+    auto const first = latest.read();
+    latest.write({ .x = 4.0f, .y = 5.0f, .z = 6.0f });
+    latest.write({ .x = 7.0f, .y = 8.0f, .z = 9.0f });
+    auto const third = latest.read();
+
+    // Verify
+    expect(that % 1.0f == first.x);
+    expect(that % 3.0f == first.z);
+    expect(that % 7.0f == third.x);
+    expect(that % 8.0f == third.y);
+    expect(that % 9.0f == third.z);
+  };
+
+  "seqlock reads are never torn by a concurrent writer"_test = []() {
+    // Setup
+    seqlock<pair_t> latest;
+    std::atomic<bool> done = false;
+    std::thread writer([&latest, &done]() {
+      for (u32 i = 1; i <= 200'000; i++) {
+        pair_t value{};
+        value.first.fill(i);
+        value.second.fill(i);
+        latest.write(value);
+      }
+      done = true;
+    });
+
+    // Exercise
+    bool torn = false;
+    u32 previous = 0;
+    bool backwards = false;
+    while (not done) {
+      auto const value = latest.read();
+      for (usize i = 0; i < value.first.size(); i++) {
+        torn = torn || value.first[i] != value.first[0] ||
+               value.second[i] != value.first[0];
+      }
+      backwards = backwards || value.first[0] < previous;
+      previous = value.first[0];
+    }
+    writer.join();
+
+    // Verify
+    expect(not torn);
+    expect(not backwards);
+    expect(that % 200'000 == latest.read().first[0]);
+  };
+};
+}  // namespace hal
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <array>
+#include <optional>
+
 #include <libhal/serial.hpp>
 
 #include <libhal/error.hpp>
@@ -58,6 +62,88 @@ private:
     m_flush_called = true;
   }
 };
+
+class test_v5_serial : public hal::v5::serial
+{
+public:
+  std::array<hal::byte, 8> m_transmitted{};
+  usize m_transmitted_length = 0;
+  int m_scatter_calls = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_write(std::span<hal::byte const> p_data) override
+  {
+    std::ranges::copy(p_data, m_transmitted.begin() + m_transmitted_length);
+    m_transmitted_length += p_data.size();
+  }
+
+  void driver_write_scatter(scatter_span<hal::byte const> p_data) override
+  {
+    m_scatter_calls++;
+    for (auto const& data : p_data) {
+      driver_write(data);
+    }
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return m_transmitted;
+  }
+
+  std::size_t driver_cursor() override
+  {
+    return 0;
+  }
+};
+
+class test_dma_serial : public test_v5_serial
+{
+public:
+  std::span<hal::byte const> m_dma_data{};
+  hal::callback<void()> m_on_complete = []() {};
+
+  // Simulate the DMA interrupt firing after the transfer completes
+  void complete_transfer()
+  {
+    m_dma_data = {};
+    m_on_complete();
+  }
+
+private:
+  void driver_write_async(std::span<hal::byte const> p_data,
+                          hal::callback<void()> p_on_complete) override
+  {
+    m_dma_data = p_data;
+    m_on_complete = p_on_complete;
+  }
+
+  usize driver_write_in_flight() override
+  {
+    return m_dma_data.size();
+  }
+};
+
+class test_receive_interrupt : public hal::serial_receive_interrupt
+{
+public:
+  settings m_settings{};
+  optional_receive_handler m_handler{};
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  void driver_on_receive(optional_receive_handler p_callback) override
+  {
+    m_handler = p_callback;
+  }
+};
 }  // namespace
 
 boost::ut::suite<"serial_test"> serial_test = []() {
@@ -82,4 +168,97 @@ boost::ut::suite<"serial_test"> serial_test = []() {
   expect(that % expected_buffer.data() == read_info.data.data());
   expect(true == test.m_flush_called);
 };
+
+boost::ut::suite<"v5::serial_test"> v5_serial_test = []() {
+  using namespace boost::ut;
+
+  "::write(scatter_span)"_test = []() {
+    // Setup
+    constexpr auto header = std::to_array<hal::byte const>({ 'a', 'b' });
+    constexpr auto payload = std::to_array<hal::byte const>({ 'c', 'd' });
+    constexpr auto crc = std::to_array<hal::byte const>({ 'e' });
+    constexpr auto expected =
+      std::to_array<hal::byte const>({ 'a', 'b', 'c', 'd', 'e' });
+    auto const scatter_list = make_scatter_bytes(header, payload, crc);
+    test_v5_serial test;
+
+    // Exercise
+    test.write(scatter_list);
+
+    // Verify
+    expect(that % 1 == test.m_scatter_calls)
+      << "Driver override should be called once for all blocks";
+    expect(that % expected.size() == test.m_transmitted_length);
+    expect(std::equal(expected.begin(), expected.end(),
+                      test.m_transmitted.begin()));
+  };
+
+  "::write_async()"_test = []() {
+    // Setup
+    constexpr auto payload = std::to_array<hal::byte const>({ 'a', 'b', 'c' });
+    test_dma_serial test;
+    int completions = 0;
+
+    // Exercise
+    test.write_async(payload, [&completions]() { completions++; });
+
+    // Verify
+    expect(that % 0 == completions) << "Should return before completion";
+    expect(that % payload.size() == test.write_in_flight());
+
+    // Exercise
+    test.complete_transfer();
+
+    // Verify
+    expect(that % 1 == completions);
+    expect(that % 0 == test.write_in_flight());
+  };
+};
+
+boost::ut::suite<"serial_receive_interrupt_test"> receive_interrupt_test =
+  []() {
+    using namespace boost::ut;
+    using receive_event = serial_receive_interrupt::receive_event;
+
+    "::configure()"_test = []() {
+      // Setup
+      constexpr serial_receive_interrupt::settings expected{
+        .watermark = 16,
+        .idle_line = false,
+      };
+      test_receive_interrupt test;
+
+      // Ensure
+      expect(expected != test.m_settings);
+
+      // Exercise
+      test.configure(expected);
+
+      // Verify
+      expect(expected == test.m_settings);
+    };
+
+    "::on_receive()"_test = []() {
+      // Setup
+      test_receive_interrupt test;
+      std::optional<receive_event> last_event;
+
+      // Exercise
+      test.on_receive([&last_event](serial_receive_interrupt::on_receive_tag,
+                                    receive_event p_event) {
+        last_event = p_event;
+      });
+      (*test.m_handler)({}, receive_event::idle);
+
+      // Verify
+      expect(last_event.has_value());
+      expect(receive_event::idle == *last_event);
+
+      // Exercise
+      test.on_receive(std::nullopt);
+
+      // Verify
+      expect(not test.m_handler.has_value());
+    };
+  };
 }  // namespace hal
@@ -0,0 +1,331 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+
+#include <libhal/error.hpp>
+#include <libhal/i2c.hpp>
+#include <libhal/lock.hpp>
+#include <libhal/shared_bus.hpp>
+#include <libhal/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_lock : public hal::timed_lock
+{
+public:
+  int m_locked = 0;
+  int m_lock_calls = 0;
+  bool m_available = true;
+  bool m_available_after_wait = true;
+
+private:
+  void os_lock() override
+  {
+    m_lock_calls++;
+    m_locked++;
+  }
+  void os_unlock() override
+  {
+    m_locked--;
+  }
+  bool os_try_lock() override
+  {
+    if (not m_available) {
+      return false;
+    }
+    m_locked++;
+    return true;
+  }
+  bool os_try_lock_for(hal::time_duration) override
+  {
+    if (not m_available_after_wait) {
+      return false;
+    }
+    m_locked++;
+    return true;
+  }
+};
+
+class test_basic_lock : public hal::basic_lock
+{
+public:
+  int m_locked = 0;
+
+private:
+  void os_lock() override
+  {
+    m_locked++;
+  }
+  void os_unlock() override
+  {
+    m_locked--;
+  }
+};
+
+class test_i2c : public hal::i2c
+{
+public:
+  int m_configure_calls = 0;
+  int m_transactions = 0;
+  settings m_settings{};
+  bool m_fail = false;
+  test_lock const* m_lock = nullptr;
+  bool m_locked_during_transaction = false;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_configure_calls++;
+    m_settings = p_settings;
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<hal::byte const>,
+                          std::span<hal::byte>,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    if (m_lock) {
+      m_locked_during_transaction = m_lock->m_locked == 1;
+    }
+    if (m_fail) {
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+    m_transactions++;
+  }
+};
+
+class test_spi_channel : public hal::spi_channel
+{
+public:
+  int m_configure_calls = 0;
+  int m_transfers = 0;
+  int m_unselected_transfers = 0;
+  bool m_selected = false;
+  settings m_settings{};
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_configure_calls++;
+    m_settings = p_settings;
+  }
+  u32 driver_clock_rate() override
+  {
+    return m_settings.clock_rate;
+  }
+  void driver_chip_select(bool p_select) override
+  {
+    m_selected = p_select;
+  }
+  void driver_transfer(std::span<byte const>, std::span<byte>, byte) override
+  {
+    m_transfers++;
+    if (not m_selected) {
+      m_unselected_transfers++;
+    }
+  }
+};
+
+constexpr std::array<hal::byte, 1> data_out{ 0x01 };
+}  // namespace
+
+boost::ut::suite<"shared_i2c_test"> shared_i2c_test = []() {
+  using namespace boost::ut;
+
+  "shared_i2c skips redundant configuration"_test = []() {
+    // Setup
+    test_i2c i2c;
+    test_basic_lock lock;
+    shared_i2c bus(i2c, lock);
+    shared_i2c::device first(bus);
+    shared_i2c::device second(bus);
+    first.configure({ .clock_rate = 400.0_kHz });
+    second.configure({ .clock_rate = 400.0_kHz });
+
+    // Exercise
+    first.transaction(0x10, data_out, {});
+    first.configure({ .clock_rate = 400.0_kHz });
+    first.transaction(0x10, data_out, {});
+    second.transaction(0x20, data_out, {});
+
+    // Verify
+    expect(that % 1 == i2c.m_configure_calls);
+    expect(that % 3 == i2c.m_transactions);
+    expect(that % 0 == lock.m_locked);
+    expect(shared_bus_statistics{ .acquisitions = 2, .reconfigurations = 1 } ==
+           first.statistics());
+    expect(shared_bus_statistics{ .acquisitions = 1 } == second.statistics());
+  };
+
+  "shared_i2c reconfigures between devices"_test = []() {
+    // Setup
+    test_i2c i2c;
+    test_basic_lock lock;
+    shared_i2c bus(i2c, lock);
+    shared_i2c::device fast(bus);
+    shared_i2c::device slow(bus);
+    fast.configure({ .clock_rate = 400.0_kHz });
+    slow.configure({ .clock_rate = 100.0_kHz });
+
+    // Exercise
+    fast.transaction(0x10, data_out, {});
+    slow.transaction(0x20, data_out, {});
+    fast.transaction(0x10, data_out, {});
+
+    // Verify
+    expect(that % 3 == i2c.m_configure_calls);
+    expect(that % 400.0_kHz == i2c.m_settings.clock_rate);
+    expect(that % 2 == fast.statistics().reconfigurations);
+    expect(that % 1 == slow.statistics().reconfigurations);
+  };
+
+  "shared_i2c holds lock and counts contention"_test = []() {
+    // Setup
+    test_i2c i2c;
+    test_lock lock;
+    i2c.m_lock = &lock;
+    shared_i2c bus(i2c, static_cast<hal::pollable_lock&>(lock));
+    shared_i2c::device device(bus);
+
+    // Exercise
+    device.transaction(0x10, data_out, {});
+    auto const held = i2c.m_locked_during_transaction;
+    lock.m_available = false;
+    device.transaction(0x10, data_out, {});
+
+    // Verify
+    expect(that % held);
+    expect(that % i2c.m_locked_during_transaction);
+    expect(that % 1 == lock.m_lock_calls);
+    expect(that % 0 == lock.m_locked);
+    expect(that % 2 == device.statistics().acquisitions);
+    expect(that % 1 == device.statistics().contentions);
+  };
+
+  "shared_i2c times out"_test = []() {
+    // Setup
+    test_i2c i2c;
+    test_lock lock;
+    shared_i2c bus(i2c, lock, std::chrono::milliseconds(5));
+    shared_i2c::device device(bus);
+    lock.m_available = false;
+    lock.m_available_after_wait = false;
+
+    // Exercise
+    expect(throws<hal::timed_out>(
+      [&]() { device.transaction(0x10, data_out, {}); }));
+
+    // Verify
+    expect(that % 0 == i2c.m_transactions);
+    expect(that % 0 == lock.m_locked);
+    expect(shared_bus_statistics{ .contentions = 1, .timeouts = 1 } ==
+           device.statistics());
+  };
+
+  "shared_i2c releases lock when transaction throws"_test = []() {
+    // Setup
+    test_i2c i2c;
+    test_basic_lock lock;
+    shared_i2c bus(i2c, lock);
+    shared_i2c::device device(bus);
+    i2c.m_fail = true;
+
+    // Exercise
+    expect(throws<hal::no_such_device>(
+      [&]() { device.transaction(0x10, data_out, {}); }));
+
+    // Verify
+    expect(that % 0 == lock.m_locked);
+  };
+};
+
+boost::ut::suite<"shared_spi_channel_test"> shared_spi_channel_test = []() {
+  using namespace boost::ut;
+
+  "shared_spi_channel holds lock while selected"_test = []() {
+    // Setup
+    test_spi_channel spi;
+    test_basic_lock lock;
+    shared_spi_channel channel(spi, lock);
+    shared_spi_channel::device device(channel);
+    device.configure({ .clock_rate = 1_MHz });
+
+    // Exercise
+    device.chip_select(true);
+    auto const locked_while_selected = lock.m_locked;
+    device.transfer(data_out);
+    device.transfer(data_out);
+    device.configure({ .clock_rate = 1_MHz });
+    device.chip_select(false);
+
+    // Verify
+    expect(that % 1 == locked_while_selected);
+    expect(that % 0 == lock.m_locked);
+    expect(that % not spi.m_selected);
+    expect(that % 2 == spi.m_transfers);
+    expect(that % 1 == spi.m_configure_calls);
+    expect(shared_bus_statistics{ .acquisitions = 1, .reconfigurations = 1 } ==
+           device.statistics());
+  };
+
+  "shared_spi_channel transfer without select"_test = []() {
+    // Setup
+    test_spi_channel spi;
+    test_basic_lock lock;
+    shared_spi_channel channel(spi, lock);
+    shared_spi_channel::device sensor(channel);
+    shared_spi_channel::device flash(channel);
+    sensor.configure({ .clock_rate = 1_MHz });
+    flash.configure({ .clock_rate = 10_MHz });
+
+    // Exercise
+    sensor.transfer(data_out);
+    sensor.transfer(data_out);
+    flash.transfer(data_out);
+    auto const flash_rate = flash.clock_rate();
+
+    // Verify
+    expect(that % 0 == lock.m_locked);
+    expect(that % 3 == spi.m_transfers);
+    expect(that % 2 == spi.m_configure_calls);
+    expect(that % 10_MHz == flash_rate);
+    expect(that % 2 == sensor.statistics().acquisitions);
+    expect(that % 1 == sensor.statistics().reconfigurations);
+  };
+
+  "shared_spi_channel scatter transfer holds chip select"_test = []() {
+    // Setup
+    test_spi_channel spi;
+    test_basic_lock lock;
+    shared_spi_channel channel(spi, lock);
+    shared_spi_channel::device device(channel);
+    std::array<hal::byte, 2> const payload{ 0x02, 0x03 };
+    auto const out = make_scatter_bytes(data_out, payload);
+
+    // Exercise
+    device.transfer(out, scatter_span<hal::byte>{});
+
+    // Verify
+    expect(that % 0 == lock.m_locked);
+    expect(that % not spi.m_selected);
+    expect(that % 2 == spi.m_transfers);
+    expect(that % 0 == spi.m_unselected_transfers);
+    expect(that % 1 == device.statistics().acquisitions);
+  };
+};
+}  // namespace hal
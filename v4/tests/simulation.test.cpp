@@ -0,0 +1,283 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+#include <libhal/error.hpp>
+#include <libhal/simulation.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::sim {
+namespace {
+using namespace std::chrono_literals;
+
+/// Register file device: the first written byte selects the register
+class register_device : public i2c_device
+{
+public:
+  std::array<hal::byte, 16> m_registers{};
+
+private:
+  void transaction(std::span<hal::byte const> p_data_out,
+                   std::span<hal::byte> p_data_in) override
+  {
+    if (p_data_out.empty()) {
+      return;
+    }
+    auto address = p_data_out[0];
+    for (auto const data : p_data_out.subspan(1)) {
+      m_registers[address++ % m_registers.size()] = data;
+    }
+    for (auto& data : p_data_in) {
+      data = m_registers[address++ % m_registers.size()];
+    }
+  }
+};
+
+/// Record of the messages received by a can_node's handler
+struct can_recorder
+{
+  std::vector<hal::u32> m_ids;
+  std::vector<time_duration> m_times;
+};
+}  // namespace
+
+boost::ut::suite<"simulation_test"> simulation_test = []() {
+  using namespace boost::ut;
+
+  "events run in time order then scheduling order"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    std::vector<int> order;
+
+    // Exercise
+    loop.schedule_at(30ns, [&order]() { order.push_back(3); });
+    loop.schedule_at(10ns, [&order]() { order.push_back(1); });
+    loop.schedule_at(10ns, [&order]() { order.push_back(2); });
+    auto const cancelled =
+      loop.schedule_at(20ns, [&order]() { order.push_back(0); });
+    expect(loop.cancel(cancelled));
+    expect(not loop.cancel(cancelled));
+    auto const count = loop.run_until(25ns);
+
+    // Verify
+    expect(std::vector<int>{ 1, 2 } == order);
+    expect(that % 2 == count);
+    expect(25ns == loop.now());
+    expect(that % 1 == loop.pending());
+    expect(loop.step());
+    expect(30ns == loop.now());
+    expect(not loop.step());
+  };
+
+  "events may schedule events and run the loop"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    std::vector<time_duration> times;
+    auto record = [&loop, &times]() { times.push_back(loop.now()); };
+
+    // Exercise
+    loop.schedule_at(10ns, [&]() {
+      loop.schedule_after(5ns, record);
+      // Blocks like a driver would, running the event scheduled above
+      loop.run_for(20ns);
+      record();
+    });
+    loop.run_until(12ns);
+
+    // Verify
+    expect(std::vector<time_duration>{ 15ns, 30ns } == times);
+    expect(30ns == loop.now());
+  };
+
+  "steady_clock and timer follow simulated time"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    steady_clock clock(loop);
+    timer test(loop);
+    int calls = 0;
+    std::optional<hal::u64> fired_at;
+
+    // Exercise
+    test.schedule([&calls]() { calls++; }, 1ms);
+    test.schedule([&clock, &fired_at]() { fired_at = clock.uptime(); }, 2ms);
+    expect(test.is_running());
+    loop.run_for(10ms);
+
+    // Verify
+    expect(that % 1'000'000'000.0f == clock.frequency());
+    expect(that % 0 == calls) << "Rescheduling must replace the callback";
+    expect(fired_at.has_value() && *fired_at == 2'000'000);
+    expect(not test.is_running());
+  };
+
+  "can messages reach every other node after their frame"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    can_bus bus(loop, std::pmr::new_delete_resource(), 500'000);
+    can_node sender(bus, std::pmr::new_delete_resource(), 4);
+    can_node receiver(bus, std::pmr::new_delete_resource(), 4);
+    can_recorder recorder;
+    receiver.on_receive(
+      [&](can_interrupt::on_receive_tag, can_message const& p_message) {
+        recorder.m_ids.push_back(p_message.id);
+        recorder.m_times.push_back(loop.now());
+      });
+    can_message const message{ .id = 0x111, .length = 8, .payload = {} };
+
+    // Exercise
+    sender.send(message);
+    sender.send(can_message{ .id = 0x222, .length = 0, .payload = {} });
+    loop.run_for(1ms);
+
+    // Verify
+    // 111 bits then 47 bits at 2us per bit, sent back to back
+    expect(std::vector<hal::u32>{ 0x111, 0x222 } == recorder.m_ids);
+    expect(std::vector<time_duration>{ 222us, 316us } == recorder.m_times);
+    expect(that % 2 == receiver.received());
+    expect(that % 0 == sender.received());
+    expect(that % 2 == receiver.receive_cursor());
+    expect(that % 0x222 == receiver.receive_buffer()[1].id);
+    expect(that % 2 == bus.frames());
+    expect(316us == bus.busy_time());
+  };
+
+  "serial bytes arrive at the peer after their frame time"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    serial_port left(loop, std::pmr::new_delete_resource(), 8);
+    serial_port right(loop, std::pmr::new_delete_resource(), 8);
+    left.connect(right);
+    left.configure({ .baud_rate = 100'000.0f });
+    std::array<hal::byte, 4> const data{ 1, 2, 3, 4 };
+    std::optional<time_duration> completed_at;
+
+    // Exercise
+    left.write_async(data, [&]() { completed_at = loop.now(); });
+    left.write(std::span(data).first(2));
+    auto const in_flight = left.write_in_flight();
+    loop.run_for(399us);
+    auto const early = right.receive_count();
+    loop.run_for(1ms);
+
+    // Verify
+    // 10 bits per byte at 100 kBd is 100us per byte
+    expect(that % 6 == in_flight);
+    expect(that % 0 == early.value());
+    expect(completed_at.has_value() && *completed_at == 400us);
+    expect(that % 6 == right.receive_count().value());
+    expect(that % 6 == right.receive_cursor());
+    expect(std::ranges::equal(
+      std::array<hal::byte, 6>{ 1, 2, 3, 4, 1, 2 },
+      right.receive_buffer().first(6)));
+    expect(that % 0 == left.receive_count().value());
+    expect(that % 0 == left.write_in_flight());
+  };
+
+  "destroying ports and buses mid transfer cancels their events"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    std::array<hal::byte, 4> const data{ 1, 2, 3, 4 };
+    bool completed = false;
+
+    // Exercise
+    {
+      serial_port left(loop, std::pmr::new_delete_resource(), 8);
+      serial_port right(loop, std::pmr::new_delete_resource(), 8);
+      left.connect(right);
+      left.write_async(data, [&completed]() { completed = true; });
+      can_bus bus(loop, std::pmr::new_delete_resource(), 500'000);
+      can_node sender(bus, std::pmr::new_delete_resource(), 4);
+      can_node receiver(bus, std::pmr::new_delete_resource(), 4);
+      sender.send(can_message{ .id = 0x111, .length = 0, .payload = {} });
+      loop.run_for(10us);
+    }
+    auto const pending = loop.pending();
+    loop.run_for(1s);
+
+    // Verify
+    expect(that % 0 == pending);
+    expect(not completed);
+  };
+
+  "serial ports connected to themselves loop back"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    serial_port test(loop, std::pmr::new_delete_resource(), 4);
+    test.connect(test);
+    std::array<hal::byte, 6> const data{ 1, 2, 3, 4, 5, 6 };
+
+    // Exercise
+    test.write(data);
+    loop.run_for(1s);
+
+    // Verify
+    expect(that % 6 == test.receive_count().value());
+    expect(that % 2 == test.receive_cursor());
+    expect(std::ranges::equal(std::array<hal::byte, 4>{ 5, 6, 3, 4 },
+                              test.receive_buffer()));
+  };
+
+  "i2c transactions reach device models and take bus time"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    i2c_bus bus(loop);
+    register_device device;
+    bus.attach(0x48, device);
+    bus.configure({ .clock_rate = 100'000.0f });
+    std::array<hal::byte const, 3> write_data{ 0x02, 0xAB, 0xCD };
+    std::array<hal::byte const, 1> select{ 0x02 };
+    std::array<hal::byte, 2> reading{};
+
+    // Exercise
+    bus.transaction(0x48, std::span(write_data), std::span<hal::byte>{});
+    auto const after_write = loop.now();
+    bus.transaction(0x48, std::span(select), std::span(reading));
+
+    // Verify
+    // Start, stop and 4 bytes of 9 clocks at 100 kHz
+    expect(380us == after_write);
+    // Plus start, stop and 5 bytes of 9 clocks
+    expect(380us + 470us == loop.now());
+    expect(std::array<hal::byte, 2>{ 0xAB, 0xCD } == reading);
+    expect(that % 2 == bus.transactions());
+  };
+
+  "i2c addresses without a device are not acknowledged"_test = []() {
+    // Setup
+    event_loop loop(std::pmr::new_delete_resource());
+    i2c_bus bus(loop);
+    register_device device;
+    bus.attach(0x48, device);
+    std::array<hal::byte const, 1> data{ 0 };
+    auto write = [&](hal::byte p_address) {
+      bus.transaction(p_address, std::span(data), std::span<hal::byte>{});
+    };
+
+    // Exercise + Verify
+    expect(throws<hal::no_such_device>(
+      [&]() { write(0x50); }));
+    expect(throws<hal::device_or_resource_busy>(
+      [&]() { bus.attach(0x48, device); }));
+    bus.detach(0x48);
+    expect(throws<hal::no_such_device>(
+      [&]() { write(0x48); }));
+    expect(throws<hal::operation_not_supported>(
+      [&]() { bus.configure({ .clock_rate = 0.0f }); }));
+  };
+};
+}  // namespace hal::sim
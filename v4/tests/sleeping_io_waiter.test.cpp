@@ -0,0 +1,93 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal/sleeping_io_waiter.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_steady_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"sleeping_io_waiter_test"> sleeping_io_waiter_test = []() {
+  using namespace boost::ut;
+
+  "sleeping_io_waiter sleeps until resumed"_test = []() {
+    // Setup
+    struct
+    {
+      test_steady_clock clock;
+      sleeping_io_waiter* waiter = nullptr;
+      int sleeps = 0;
+    } state;
+    // Simulates an interrupt that resumes the waiter 10 ticks into the sleep,
+    // with the core waking 3 ticks after that
+    sleeping_io_waiter waiter(
+      [&state]() {
+        state.sleeps++;
+        state.clock.m_uptime += 10;
+        state.waiter->resume();
+        state.clock.m_uptime += 3;
+      },
+      &state.clock);
+    state.waiter = &waiter;
+
+    // Exercise
+    waiter.wait();
+
+    // Verify
+    expect(that % 1 == state.sleeps);
+    expect(sleeping_io_waiter_statistics{ .waits = 1,
+                                          .resumes = 1,
+                                          .wait_ticks = 13,
+                                          .resume_latency_ticks = 3 } ==
+           waiter.statistics());
+  };
+
+  "sleeping_io_waiter does not sleep if resumed first"_test = []() {
+    // Setup
+    int sleeps = 0;
+    sleeping_io_waiter waiter([&sleeps]() { sleeps++; });
+
+    // Exercise
+    waiter.resume();
+    waiter.wait();
+    waiter.wait();
+
+    // Verify
+    expect(that % 1 == sleeps);
+    expect(sleeping_io_waiter_statistics{
+             .waits = 2, .early_resumes = 1, .resumes = 1 } ==
+           waiter.statistics());
+    waiter.reset_statistics();
+    expect(sleeping_io_waiter_statistics{} == waiter.statistics());
+  };
+};
+}  // namespace hal
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <vector>
+
 #include <libhal/spi.hpp>
 
 #include <libhal/error.hpp>
@@ -179,3 +182,190 @@ boost::ut::suite<"spi_channel_test"> spi_channel_test = []() {
   expect(test_spi_channel::expected_settings == test.m_settings);
 };
 }  // namespace hal
+
+namespace hal {
+namespace {
+class test_spi_channel_recorder : public hal::spi_channel
+{
+public:
+  struct piece
+  {
+    usize out_size;
+    usize in_size;
+    hal::byte filler;
+    bool selected;
+  };
+
+  bool m_chip_select = false;
+  std::vector<piece> m_pieces{};
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return 0;
+  }
+
+  void driver_chip_select(bool p_select) override
+  {
+    m_chip_select = p_select;
+  }
+
+  void driver_transfer(std::span<byte const> p_data_out,
+                       std::span<byte> p_data_in,
+                       byte p_filler) override
+  {
+    for (usize i = 0; i < p_data_in.size(); i++) {
+      p_data_in[i] = i < p_data_out.size() ? p_data_out[i] : p_filler;
+    }
+    m_pieces.push_back({ .out_size = p_data_out.size(),
+                         .in_size = p_data_in.size(),
+                         .filler = p_filler,
+                         .selected = m_chip_select });
+  }
+};
+}  // namespace
+
+boost::ut::suite<"spi_channel_scatter_test"> spi_channel_scatter_test = []() {
+  using namespace boost::ut;
+
+  "::transfer(scatter) splits on segment boundaries"_test = []() {
+    // Setup
+    test_spi_channel_recorder test;
+    std::array<hal::byte, 1> const command{ 0x0B };
+    std::array<hal::byte, 3> const address{ 0x01, 0x02, 0x03 };
+    std::array<hal::byte, 2> header{};
+    std::array<hal::byte, 4> payload{};
+    auto const out =
+      make_scatter_bytes(command, std::span<hal::byte const>{}, address);
+    auto const in = make_writable_scatter_bytes(header, payload);
+
+    // Exercise
+    test.chip_select(true);
+    test.transfer(out, in, 0xEE);
+    test.chip_select(false);
+
+    // Verify
+    expect(that % 4 == test.m_pieces.size());
+    expect(that % 1 == test.m_pieces[0].out_size);
+    expect(that % 1 == test.m_pieces[0].in_size);
+    expect(that % 1 == test.m_pieces[1].out_size);
+    expect(that % 1 == test.m_pieces[1].in_size);
+    expect(that % 2 == test.m_pieces[2].out_size);
+    expect(that % 2 == test.m_pieces[2].in_size);
+    expect(that % 0 == test.m_pieces[3].out_size);
+    expect(that % 2 == test.m_pieces[3].in_size);
+    for (auto const& piece : test.m_pieces) {
+      expect(that % 0xEE == piece.filler);
+      expect(piece.selected);
+    }
+    expect(std::array<hal::byte, 2>{ 0x0B, 0x01 } == header);
+    expect(std::array<hal::byte, 4>{ 0x02, 0x03, 0xEE, 0xEE } == payload);
+  };
+
+  "::transfer(scatter) writes past the end of the input"_test = []() {
+    // Setup
+    test_spi_channel_recorder test;
+    std::array<hal::byte, 2> const first{ 0x01, 0x02 };
+    std::array<hal::byte, 3> const second{ 0x03, 0x04, 0x05 };
+    std::array<hal::byte, 1> status{};
+    auto const out = make_scatter_bytes(first, second);
+    auto const in = make_writable_scatter_bytes(status);
+
+    // Exercise
+    test.transfer(out, in);
+
+    // Verify
+    expect(that % 3 == test.m_pieces.size());
+    expect(that % 1 == test.m_pieces[0].in_size);
+    expect(that % 0 == test.m_pieces[1].in_size);
+    expect(that % 1 == test.m_pieces[1].out_size);
+    expect(that % 3 == test.m_pieces[2].out_size);
+    expect(that % 0x01 == status[0]);
+  };
+
+  "::transfer(scatter) selects across segments when not selected"_test =
+    []() {
+      // Setup
+      test_spi_channel_recorder test;
+      std::array<hal::byte, 1> const command{ 0x03 };
+      std::array<hal::byte, 4> data{};
+      auto const out = make_scatter_bytes(command);
+      auto const in = make_writable_scatter_bytes(std::span<hal::byte>{}, data);
+
+      // Exercise
+      test.transfer(out, in);
+
+      // Verify
+      expect(that % 2 == test.m_pieces.size());
+      for (auto const& piece : test.m_pieces) {
+        expect(piece.selected);
+      }
+      expect(not test.m_chip_select);
+    };
+
+  "::transfer(scatter) ignores empty transfers"_test = []() {
+    // Setup
+    test_spi_channel_recorder test;
+
+    // Exercise
+    test.transfer(scatter_span<hal::byte const>{}, scatter_span<hal::byte>{});
+
+    // Verify
+    expect(that % 0 == test.m_pieces.size());
+  };
+};
+}  // namespace hal
+
+namespace hal {
+namespace {
+class test_spi_channel_busy : public hal::spi_channel
+{
+public:
+  bool m_busy = true;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return 0;
+  }
+
+  void driver_chip_select(bool) override
+  {
+  }
+
+  void driver_transfer(std::span<byte const>, std::span<byte>, byte) override
+  {
+    if (m_busy) {
+      hal::safe_throw(hal::device_or_resource_busy(this));
+    }
+  }
+};
+}  // namespace
+
+boost::ut::suite<"spi_channel_try_test"> spi_channel_try_test = []() {
+  using namespace boost::ut;
+
+  "::try_transfer() reports thrown errors by default"_test = []() {
+    // Setup
+    test_spi_channel_busy test;
+    std::array<hal::byte, 2> const out{ 0x9F, 0x00 };
+
+    // Exercise
+    auto const busy = test.try_transfer(out);
+    test.m_busy = false;
+    auto const done = test.try_transfer(out);
+
+    // Verify
+    expect(std::errc::device_or_resource_busy == busy);
+    expect(std::errc{} == done);
+  };
+};
+}  // namespace hal
@@ -0,0 +1,226 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+
+#include <libhal/error.hpp>
+#include <libhal/spi_batch.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_steady_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 0;
+  u64 m_step = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1'000'000.0f;
+  }
+
+  u64 driver_uptime() override
+  {
+    auto const uptime = m_uptime;
+    m_uptime += m_step;
+    return uptime;
+  }
+};
+
+class test_spi_channel : public hal::spi_channel
+{
+public:
+  int m_configure_calls = 0;
+  int m_select_calls = 0;
+  int m_transfers = 0;
+  bool m_selected = false;
+  bool m_fail = false;
+  settings m_settings{};
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_configure_calls++;
+    m_settings = p_settings;
+  }
+
+  u32 driver_clock_rate() override
+  {
+    return m_settings.clock_rate;
+  }
+
+  void driver_chip_select(bool p_select) override
+  {
+    if (p_select && not m_selected) {
+      m_select_calls++;
+    }
+    m_selected = p_select;
+  }
+
+  void driver_transfer(std::span<byte const>, std::span<byte>, byte) override
+  {
+    if (m_fail) {
+      hal::safe_throw(hal::io_error(this));
+    }
+    m_transfers++;
+  }
+};
+
+constexpr hal::spi_channel::settings imu_settings{ .clock_rate = 1_MHz };
+constexpr hal::spi_channel::settings display_settings{
+  .clock_rate = 8_MHz,
+  .bus_mode = hal::spi_channel::mode::m3,
+};
+constexpr std::array<hal::byte, 2> command{ 0x0F, 0x00 };
+constexpr std::array<hal::byte, 8> payload{};
+}  // namespace
+
+boost::ut::suite<"spi_batch_test"> spi_batch_test = []() {
+  using namespace boost::ut;
+
+  "spi_batch::run() configures devices once"_test = []() {
+    // Setup
+    test_steady_clock clock;
+    test_spi_channel imu;
+    test_spi_channel display;
+    spi_batch<2> batch(clock);
+    auto const imu_out = make_scatter_bytes(command);
+    auto const display_out = make_scatter_bytes(command, payload);
+    std::array<spi_transaction, 3> const transactions{ {
+      { .channel = &imu, .settings = imu_settings, .data_out = imu_out },
+      { .channel = &display,
+        .settings = display_settings,
+        .data_out = display_out },
+      { .channel = &imu, .settings = imu_settings, .data_out = imu_out },
+    } };
+
+    // Exercise
+    auto const first = batch.run(transactions);
+    auto const second = batch.run(transactions);
+
+    // Verify
+    expect(that % 1 == imu.m_configure_calls);
+    expect(that % 1 == display.m_configure_calls);
+    expect(that % 4 == imu.m_transfers);
+    expect(that % 4 == display.m_transfers);
+    expect(that % not imu.m_selected);
+    expect(that % not display.m_selected);
+    expect(that % 3 == first.transactions);
+    expect(that % 2 == first.reconfigurations);
+    expect(that % 3 == first.chip_selects);
+    expect(that % 14 == first.bytes);
+    expect(that % 0 == second.reconfigurations);
+  };
+
+  "spi_batch::run() holds chip select"_test = []() {
+    // Setup
+    test_steady_clock clock;
+    test_spi_channel imu;
+    spi_batch<1> batch(clock);
+    auto const imu_out = make_scatter_bytes(command);
+    std::array<spi_transaction, 3> const transactions{ {
+      { .channel = &imu,
+        .settings = imu_settings,
+        .data_out = imu_out,
+        .hold_chip_select = true },
+      { .channel = &imu,
+        .settings = imu_settings,
+        .data_out = imu_out,
+        .hold_chip_select = true },
+      { .channel = &imu,
+        .settings = display_settings,
+        .data_out = imu_out,
+        .hold_chip_select = true },
+    } };
+
+    // Exercise
+    auto const report = batch.run(transactions);
+
+    // Verify
+    expect(that % 2 == report.chip_selects);
+    expect(that % 2 == report.reconfigurations);
+    expect(that % 2 == imu.m_select_calls);
+    expect(that % 3 == imu.m_transfers);
+    expect(that % not imu.m_selected);
+  };
+
+  "spi_batch::run() evicts and invalidates cached settings"_test = []() {
+    // Setup
+    test_steady_clock clock;
+    test_spi_channel imu;
+    test_spi_channel display;
+    spi_batch<1> batch(clock);
+    auto const out = make_scatter_bytes(command);
+    std::array<spi_transaction, 2> const transactions{ {
+      { .channel = &imu, .settings = imu_settings, .data_out = out },
+      { .channel = &display, .settings = display_settings, .data_out = out },
+    } };
+
+    // Exercise
+    batch.run(transactions);
+    batch.run(std::span(transactions).last(1));
+    batch.invalidate();
+    batch.run(std::span(transactions).last(1));
+
+    // Verify
+    expect(that % 1 == imu.m_configure_calls);
+    expect(that % 2 == display.m_configure_calls);
+  };
+
+  "spi_batch::run() reports bus utilization"_test = []() {
+    // Setup
+    test_steady_clock clock;
+    clock.m_step = 1'000;
+    test_spi_channel imu;
+    spi_batch<1> batch(clock);
+    std::array<hal::byte, 125> data{};
+    auto const out = make_scatter_bytes(data);
+    std::array<spi_transaction, 1> const transactions{ {
+      { .channel = &imu, .settings = imu_settings, .data_out = out },
+    } };
+
+    // Exercise
+    auto const report = batch.run(transactions);
+
+    // Verify
+    expect(that % 1'000'000 == report.busy.count());
+    expect(that % 1'000'000 == report.elapsed.count());
+    expect(that % 1.0f == report.utilization());
+    expect(that % 0.0f == spi_batch_report{}.utilization());
+  };
+
+  "spi_batch::run() releases chip select on failure"_test = []() {
+    // Setup
+    test_steady_clock clock;
+    test_spi_channel imu;
+    imu.m_fail = true;
+    spi_batch<1> batch(clock);
+    auto const out = make_scatter_bytes(command);
+    std::array<spi_transaction, 1> const transactions{ {
+      { .channel = &imu,
+        .settings = imu_settings,
+        .data_out = out,
+        .hold_chip_select = true },
+    } };
+
+    // Exercise & Verify
+    expect(throws<hal::io_error>([&]() { batch.run(transactions); }));
+    expect(that % not imu.m_selected);
+  };
+};
+}  // namespace hal
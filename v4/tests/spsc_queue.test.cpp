@@ -0,0 +1,153 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory_resource>
+#include <string>
+
+#include <libhal/spsc_queue.hpp>
+#include <libhal/units.hpp>
+
+#include "helpers.hpp"
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+std::pmr::monotonic_buffer_resource test_buffer{ 4096 };
+std::pmr::polymorphic_allocator<byte> test_allocator{ &test_buffer };
+
+struct no_default
+{
+  explicit no_default(int p_value)
+    : value(p_value)
+  {
+  }
+  int value;
+};
+}  // namespace
+
+boost::ut::suite<"spsc_queue_test"> spsc_queue_test = []() {
+  using namespace boost::ut;
+
+  "construction"_test = [&] {
+    spsc_queue<int> queue(test_allocator, 5);
+
+    expect(that % 8 == queue.capacity()) << "Should round up to power of two";
+    expect(that % 0 == queue.size());
+    expect(queue.empty());
+    expect(not queue.full());
+
+    spsc_queue<int> queue2(test_allocator, 0);
+    expect(that % 1 == queue2.capacity())
+      << "Should enforce minimum capacity of 1";
+
+    expect(that % 0 == test_class::s_instance_count);
+    {
+      spsc_queue<test_class> queue3(test_allocator, 4);
+      expect(that % 0 == test_class::s_instance_count)
+        << "Construction should not construct any elements";
+    }
+  };
+
+  "try_push_and_try_pop"_test = [&] {
+    spsc_queue<int> queue(test_allocator, 4);
+
+    expect(queue.try_push(1));
+    expect(queue.try_push(2));
+    expect(queue.try_push(3));
+    expect(queue.try_push(4));
+    expect(queue.full());
+    expect(not queue.try_push(5)) << "Full queue should reject elements";
+    expect(that % 4 == queue.size());
+
+    expect(that % 1 == queue.try_pop().value());
+    expect(that % 2 == queue.try_pop().value());
+    expect(queue.try_push(5));
+    expect(that % 3 == queue.try_pop().value());
+    expect(that % 4 == queue.try_pop().value());
+    expect(that % 5 == queue.try_pop().value());
+    expect(not queue.try_pop().has_value());
+    expect(queue.empty());
+  };
+
+  "try_emplace_non_default_constructible"_test = [&] {
+    spsc_queue<no_default> queue(test_allocator, 2);
+
+    expect(queue.try_emplace(10));
+    expect(queue.try_emplace(20));
+    expect(not queue.try_emplace(30));
+
+    expect(that % 10 == queue.try_pop()->value);
+    expect(that % 20 == queue.try_pop()->value);
+  };
+
+  "move_only_and_lifetimes"_test = [&] {
+    spsc_queue<std::string> queue(test_allocator, 2);
+    std::string value = "Hello World, this string is not short";
+
+    expect(queue.try_push(std::move(value)));
+    auto result = queue.try_pop();
+    expect(result.has_value());
+    expect(that % std::string_view("Hello World, this string is not short") ==
+           *result);
+
+    expect(that % 0 == test_class::s_instance_count);
+    {
+      spsc_queue<test_class> queue2(test_allocator, 4);
+      queue2.try_emplace(1);
+      queue2.try_emplace(2);
+      queue2.try_emplace(3);
+      expect(that % 3 == test_class::s_instance_count);
+    }
+    expect(that % 0 == test_class::s_instance_count)
+      << "Unread elements should be destroyed with the queue";
+  };
+
+  "push_n_and_pop_n"_test = [&] {
+    spsc_queue<int> queue(test_allocator, 4);
+    auto const input = std::to_array({ 1, 2, 3, 4, 5, 6 });
+    std::array<int, 3> output{};
+
+    expect(that % 3 == queue.push_n(std::span(input).first(3)));
+    expect(that % 2 == queue.pop_n(std::span(output).first(2)));
+    expect(that % 1 == output[0]);
+    expect(that % 2 == output[1]);
+
+    // Wraps past the end of the storage and is limited by free space
+    expect(that % 3 == queue.push_n(std::span(input).subspan(3)));
+    expect(that % 0 == queue.push_n(input));
+    expect(that % 4 == queue.size());
+
+    expect(that % 3 == queue.pop_n(output));
+    expect(that % 3 == output[0]);
+    expect(that % 4 == output[1]);
+    expect(that % 5 == output[2]);
+
+    expect(that % 1 == queue.pop_n(output));
+    expect(that % 6 == output[0]);
+    expect(that % 0 == queue.pop_n(output));
+  };
+
+  "counter_wraparound"_test = [&] {
+    spsc_queue<int, alignof(usize)> queue(test_allocator, 2);
+
+    for (int i = 0; i < 1000; ++i) {
+      expect(queue.try_push(i));
+      expect(that % i == queue.try_pop().value());
+    }
+    expect(queue.empty());
+  };
+};
+}  // namespace hal
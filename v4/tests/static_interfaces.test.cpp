@@ -0,0 +1,245 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include <libhal/static_interfaces.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+/// Output pin driver that does not derive from hal::output_pin
+struct register_pin
+{
+  void configure(output_pin::settings const& p_settings)
+  {
+    m_settings = p_settings;
+  }
+
+  void level(bool p_high)
+  {
+    m_history.push_back(p_high);
+  }
+
+  [[nodiscard]] bool level() const
+  {
+    return not m_history.empty() && m_history.back();
+  }
+
+  output_pin::settings m_settings{};
+  std::vector<bool> m_history{};
+};
+
+struct register_adc
+{
+  u16 read()
+  {
+    return m_sample++;
+  }
+
+  u16 m_sample = 0x1234;
+};
+
+struct register_i2c
+{
+  void configure(i2c::settings const& p_settings)
+  {
+    m_settings = p_settings;
+  }
+
+  void transaction(hal::byte p_address,
+                   std::span<hal::byte const> p_data_out,
+                   std::span<hal::byte> p_data_in)
+  {
+    m_address = p_address;
+    m_written.assign(p_data_out.begin(), p_data_out.end());
+    for (auto& data : p_data_in) {
+      data = 0xA5;
+    }
+  }
+
+  i2c::settings m_settings{};
+  hal::byte m_address = 0;
+  std::vector<hal::byte> m_written{};
+};
+
+struct register_spi
+{
+  void configure(spi_channel::settings const& p_settings)
+  {
+    m_settings = p_settings;
+  }
+
+  u32 clock_rate()
+  {
+    return m_settings.clock_rate;
+  }
+
+  void chip_select(bool p_select)
+  {
+    m_selects.push_back(p_select);
+  }
+
+  void transfer(std::span<hal::byte const> p_data_out,
+                std::span<hal::byte> p_data_in,
+                hal::byte p_filler)
+  {
+    m_written.insert(m_written.end(), p_data_out.begin(), p_data_out.end());
+    for (auto& data : p_data_in) {
+      data = p_filler;
+    }
+  }
+
+  spi_channel::settings m_settings{};
+  std::vector<bool> m_selects{};
+  std::vector<hal::byte> m_written{};
+};
+
+template<static_output_pin Pin>
+void pulse(Pin& p_pin, int p_count)
+{
+  for (int i = 0; i < p_count; i++) {
+    p_pin.level(true);
+    p_pin.level(false);
+  }
+}
+
+static_assert(static_output_pin<hal::output_pin>);
+static_assert(static_input_pin<hal::input_pin>);
+static_assert(static_adc16<hal::adc16>);
+static_assert(static_i2c<hal::i2c>);
+static_assert(static_spi_channel<hal::spi_channel>);
+static_assert(static_output_pin<register_pin>);
+static_assert(not static_output_pin<register_adc>);
+static_assert(not static_input_pin<register_i2c>);
+}  // namespace
+
+boost::ut::suite<"static_interfaces_test"> static_interfaces_test = []() {
+  using namespace boost::ut;
+
+  "templated code calls a static driver directly"_test = []() {
+    // Setup
+    register_pin pin;
+
+    // Exercise
+    pulse(pin, 2);
+
+    // Verify
+    expect(std::vector<bool>{ true, false, true, false } == pin.m_history);
+  };
+
+  "static_output_pin_adaptor forwards to the driver"_test = []() {
+    // Setup
+    register_pin pin;
+    static_output_pin_adaptor adaptor(pin);
+    hal::output_pin& erased = adaptor;
+
+    // Exercise
+    erased.configure({ .open_drain = true });
+    pulse(erased, 1);
+    erased.level(true);
+
+    // Verify
+    expect(pin.m_settings.open_drain);
+    expect(erased.level());
+    expect(std::vector<bool>{ true, false, true } == pin.m_history);
+  };
+
+  "static_input_pin_adaptor forwards to the driver"_test = []() {
+    // Setup
+    struct register_input
+    {
+      void configure(input_pin::settings const& p_settings)
+      {
+        m_settings = p_settings;
+      }
+      bool level()
+      {
+        return true;
+      }
+      input_pin::settings m_settings{};
+    } pin;
+    static_input_pin_adaptor adaptor(pin);
+    hal::input_pin& erased = adaptor;
+
+    // Exercise
+    erased.configure({ .resistor = pin_resistor::pull_down });
+
+    // Verify
+    expect(pin_resistor::pull_down == pin.m_settings.resistor);
+    expect(erased.level());
+  };
+
+  "static_adc16_adaptor forwards to the driver"_test = []() {
+    // Setup
+    register_adc adc;
+    static_adc16_adaptor adaptor(adc);
+    hal::adc16& erased = adaptor;
+
+    // Exercise
+    auto const first = erased.read();
+    auto const second = erased.read();
+
+    // Verify
+    expect(that % 0x1234 == first);
+    expect(that % 0x1235 == second);
+  };
+
+  "static_i2c_adaptor forwards both transaction overloads"_test = []() {
+    // Setup
+    register_i2c bus;
+    static_i2c_adaptor adaptor(bus);
+    hal::i2c& erased = adaptor;
+    std::array<hal::byte, 2> const out{ 0x01, 0x02 };
+    std::array<hal::byte, 1> in{};
+
+    // Exercise
+    erased.configure({ .clock_rate = 400.0_kHz });
+    erased.transaction(0x42, out, in);
+    auto const first_read = in[0];
+    in[0] = 0;
+    erased.transaction(0x43, out, in, hal::never_timeout());
+
+    // Verify
+    expect(that % 400.0_kHz == bus.m_settings.clock_rate);
+    expect(that % 0xA5 == first_read);
+    expect(that % 0xA5 == in[0]);
+    expect(that % 0x43 == bus.m_address);
+    expect(std::vector<hal::byte>{ 0x01, 0x02 } == bus.m_written);
+  };
+
+  "static_spi_channel_adaptor forwards to the driver"_test = []() {
+    // Setup
+    register_spi bus;
+    static_spi_channel_adaptor adaptor(bus);
+    hal::spi_channel& erased = adaptor;
+    std::array<hal::byte, 2> const out{ 0x9F, 0x00 };
+    std::array<hal::byte, 2> in{};
+
+    // Exercise
+    erased.configure({ .clock_rate = 1'000'000 });
+    erased.chip_select(true);
+    erased.transfer(out, in, 0x55);
+    erased.chip_select(false);
+
+    // Verify
+    expect(that % 1'000'000 == erased.clock_rate());
+    expect(std::vector<bool>{ true, false } == bus.m_selects);
+    expect(std::vector<hal::byte>{ 0x9F, 0x00 } == bus.m_written);
+    expect(that % 0x55 == in[1]);
+  };
+};
+}  // namespace hal
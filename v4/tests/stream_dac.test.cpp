@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <optional>
+#include <vector>
+
 #include <libhal/stream_dac.hpp>
 
 #include <libhal/error.hpp>
@@ -51,3 +55,158 @@ boost::ut::suite<"stream_dac_test"> stream_dac_test = []() {
   expect(that % expected_out.size() == test.actual_samples.data.size());
 };
 }  // namespace hal
+
+namespace hal {
+namespace {
+class test_continuous_stream_dac : public hal::continuous_stream_dac_u16
+{
+public:
+  hal::hertz m_sample_rate = 0.0f;
+  std::span<u16> m_buffer{};
+  std::optional<hal::callback<refill_handler>> m_refill{};
+  std::vector<u16> m_played{};
+  usize m_block = 0;
+
+  /// Simulate the DMA finishing the block currently being played
+  void finish_block()
+  {
+    auto const half = m_buffer.size() / 2;
+    auto const block = m_buffer.subspan(m_block * half, half);
+    m_played.insert(m_played.end(), block.begin(), block.end());
+    m_block ^= 1;
+    (*m_refill)(on_refill_tag{}, block);
+  }
+
+private:
+  void driver_start(hal::hertz p_sample_rate,
+                    std::span<u16> p_buffer,
+                    hal::callback<refill_handler> p_refill) override
+  {
+    if (p_buffer.empty() || p_buffer.size() % 2 != 0) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+    m_sample_rate = p_sample_rate;
+    m_buffer = p_buffer;
+    m_refill = p_refill;
+    m_block = 0;
+  }
+
+  void driver_stop() override
+  {
+    m_refill.reset();
+  }
+
+  bool driver_playing() override
+  {
+    return m_refill.has_value();
+  }
+};
+}  // namespace
+
+boost::ut::suite<"continuous_stream_dac_test"> continuous_stream_dac_test =
+  []() {
+    using namespace boost::ut;
+
+    "continuous_stream_dac plays refilled blocks gaplessly"_test = []() {
+      // Setup
+      test_continuous_stream_dac test;
+      std::array<u16, 4> buffer{ 0, 1, 2, 3 };
+      u16 next_sample = 4;
+      usize refills = 0;
+
+      // Exercise
+      test.start(44.1_kHz, buffer, [&](auto, std::span<u16> p_block) {
+        refills++;
+        for (auto& sample : p_block) {
+          sample = next_sample++;
+        }
+      });
+      auto const playing = test.playing();
+      test.finish_block();
+      test.finish_block();
+      test.finish_block();
+      test.stop();
+
+      // Verify
+      expect(playing);
+      expect(not test.playing());
+      expect(that % 44.1_kHz == test.m_sample_rate);
+      expect(that % 3 == refills);
+      expect(std::vector<u16>{ 0, 1, 2, 3, 4, 5 } == test.m_played);
+    };
+
+    "continuous_stream_dac::start() rejects odd buffers"_test = []() {
+      // Setup
+      test_continuous_stream_dac test;
+      std::array<u16, 3> buffer{};
+
+      // Exercise & Verify
+      expect(throws<hal::argument_out_of_domain>([&]() {
+        test.start(44.1_kHz, buffer, [](auto, std::span<u16>) {});
+      }));
+      expect(not test.playing());
+    };
+  };
+}  // namespace hal
+
+namespace hal {
+namespace {
+class test_multichannel_stream_dac : public hal::multichannel_stream_dac_u16
+{
+public:
+  samples m_samples{};
+  usize m_writes = 0;
+
+private:
+  u8 driver_max_channels() override
+  {
+    return 4;
+  }
+
+  void driver_write(samples const& p_samples) override
+  {
+    m_samples = p_samples;
+    m_writes++;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"multichannel_stream_dac_test"> multichannel_stream_dac_test =
+  []() {
+    using namespace boost::ut;
+
+    "multichannel_stream_dac::write() passes interleaved frames"_test = []() {
+      // Setup
+      test_multichannel_stream_dac test;
+      std::array<u16, 6> const frames{ 0, 100, 1, 101, 2, 102 };
+
+      // Exercise
+      test.write({ .sample_rate = 48.0_kHz, .channels = 2, .data = frames });
+
+      // Verify
+      expect(that % 4 == test.max_channels());
+      expect(that % 1 == test.m_writes);
+      expect(that % 2 == test.m_samples.channels);
+      expect(that % 48.0_kHz == test.m_samples.sample_rate);
+      expect(that % frames.data() == test.m_samples.data.data());
+    };
+
+    "multichannel_stream_dac::write() rejects invalid layouts"_test = []() {
+      // Setup
+      test_multichannel_stream_dac test;
+      std::array<u16, 6> const frames{};
+
+      // Exercise & Verify
+      expect(throws<hal::argument_out_of_domain>([&]() {
+        test.write({ .sample_rate = 48.0_kHz, .channels = 0, .data = frames });
+      }));
+      expect(throws<hal::argument_out_of_domain>([&]() {
+        test.write({ .sample_rate = 48.0_kHz, .channels = 5, .data = frames });
+      }));
+      expect(throws<hal::argument_out_of_domain>([&]() {
+        test.write({ .sample_rate = 48.0_kHz, .channels = 4, .data = frames });
+      })) << "6 samples are not a whole number of 4 channel frames";
+      expect(that % 0 == test.m_writes);
+    };
+  };
+}  // namespace hal
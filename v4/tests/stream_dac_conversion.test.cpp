@@ -0,0 +1,224 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <span>
+
+#include <libhal/stream_dac_conversion.hpp>
+
+#include <libhal/error.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+boost::ut::suite<"stream_dac_conversion_test"> stream_dac_conversion_test =
+  []() {
+    using namespace boost::ut;
+
+    "interleave() builds stereo frames"_test = []() {
+      // Setup
+      std::array<u16 const, 3> const left{ 1, 2, 3 };
+      std::array<u16 const, 4> const right{ 10, 20, 30, 40 };
+      std::array<u16, 8> frames{};
+      auto const channels = make_scatter_array<u16 const>(left, right);
+
+      // Exercise
+      auto const written = interleave<u16>(channels, frames);
+
+      // Verify
+      expect(that % 3 == written) << "Limited by the shortest channel";
+      expect(std::array<u16, 8>{ 1, 10, 2, 20, 3, 30, 0, 0 } == frames);
+    };
+
+    "interleave() builds frames of any channel count"_test = []() {
+      // Setup
+      std::array<u8 const, 3> const front{ 1, 2, 3 };
+      std::array<u8 const, 3> const center{ 4, 5, 6 };
+      std::array<u8 const, 3> const rear{ 7, 8, 9 };
+      std::array<u8, 8> frames{};
+      auto const channels = make_scatter_array<u8 const>(front, center, rear);
+
+      // Exercise
+      auto const written = interleave<u8>(channels, frames);
+
+      // Verify
+      expect(that % 2 == written) << "Only two whole frames fit";
+      expect(std::array<u8, 8>{ 1, 4, 7, 2, 5, 8, 0, 0 } == frames);
+      expect(that % 0 == interleave<u8>({}, frames));
+    };
+
+    "right_justify() fits samples to the low bits"_test = []() {
+      // Setup
+      std::array<u16, 4> samples{ 0xFFFF, 0x8000, 0x0010, 0x000F };
+      std::array<u16 const, 3> const source{ 0xFFFF, 0x1230, 0x0001 };
+      std::array<u16, 2> destination{};
+
+      // Exercise
+      right_justify<u16>(samples, 4);
+      auto const converted = right_justify<u16>(source, destination, 4);
+
+      // Verify
+      expect(std::array<u16, 4>{ 0x0FFF, 0x0800, 0x0001, 0x0000 } == samples);
+      expect(that % 2 == converted);
+      expect(std::array<u16, 2>{ 0x0FFF, 0x0123 } == destination);
+    };
+
+    "left_justify() restores full scale"_test = []() {
+      // Setup
+      std::array<u8, 3> samples{ 0x7F, 0x40, 0x01 };
+      std::array<u8 const, 2> const source{ 0x7F, 0x01 };
+      std::array<u8, 4> destination{};
+
+      // Exercise
+      left_justify<u8>(samples, 1);
+      auto const converted = left_justify<u8>(source, destination, 1);
+
+      // Verify
+      expect(std::array<u8, 3>{ 0xFE, 0x80, 0x02 } == samples);
+      expect(that % 2 == converted);
+      expect(std::array<u8, 4>{ 0xFE, 0x02, 0, 0 } == destination);
+    };
+
+    "right_justify() sets the flag bits of every sample"_test = []() {
+      // Setup
+      std::array<u16, 5> samples{ 0xFFFF, 0x8000, 0x0000, 0x1234, 0xABCD };
+
+      // Exercise
+      right_justify<u16>(samples, 4, 0x3000);
+
+      // Verify
+      expect(std::array<u16, 5>{ 0x3FFF, 0x3800, 0x3000, 0x3123, 0x3ABC } ==
+             samples);
+      expect(throws<hal::argument_out_of_domain>(
+        [&]() { right_justify<u16>(samples, 4, 0x0800); }))
+        << "Flags must not overlap the data bits";
+    };
+
+    "word at a time kernels match a loop over each sample"_test = []() {
+      // Setup
+      // An odd length exercises both the word loop and the remaining samples
+      constexpr usize length = 37;
+      std::array<u8, length> bytes{};
+      std::array<u16, length> words{};
+      for (usize i = 0; i < length; i++) {
+        bytes[i] = static_cast<u8>(i * 37 + 11);
+        words[i] = static_cast<u16>(i * 4099 + 7);
+      }
+      auto right_bytes = bytes;
+      auto left_bytes = bytes;
+      auto right_words = words;
+      auto left_words = words;
+
+      // Exercise
+      right_justify<u8>(right_bytes, 3, 0xE0);
+      left_justify<u8>(left_bytes, 3);
+      right_justify<u16>(right_words, 5, 0xF800);
+      left_justify<u16>(left_words, 5);
+
+      // Verify
+      for (usize i = 0; i < length; i++) {
+        expect(that % static_cast<u8>((bytes[i] >> 3) | 0xE0) ==
+               right_bytes[i]);
+        expect(that % static_cast<u8>(bytes[i] << 3) == left_bytes[i]);
+        expect(that % static_cast<u16>((words[i] >> 5) | 0xF800) ==
+               right_words[i]);
+        expect(that % static_cast<u16>(words[i] << 5) == left_words[i]);
+      }
+    };
+
+    "expand() widens samples at full scale"_test = []() {
+      // Setup
+      constexpr usize length = 13;
+      std::array<u8, length> source{ 0x00, 0xFF, 0x80, 0x7F, 0x01 };
+      for (usize i = 5; i < length; i++) {
+        source[i] = static_cast<u8>(i * 19);
+      }
+      std::array<u16, length + 2> destination{};
+      std::array<u32, 2> wide{};
+
+      // Exercise
+      auto const converted = expand<u8, u16>(source, destination);
+      auto const converted_wide = expand<u8, u32>(source, wide);
+
+      // Verify
+      expect(that % length == converted);
+      for (usize i = 0; i < length; i++) {
+        expect(that % static_cast<u16>(source[i] * 0x0101) == destination[i]);
+      }
+      expect(that % 0 == destination[length]);
+      expect(that % 2 == converted_wide);
+      expect(std::array<u32, 2>{ 0x0000'0000, 0xFFFF'FFFF } == wide);
+    };
+
+    "stream_dac_feeder fills blocks and then idles"_test = []() {
+      // Setup
+      std::array<u8 const, 5> const clip{ 0xFF, 0x80, 0x00, 0x12, 0x01 };
+      stream_dac_feeder<u8, u16> feeder(
+        clip, { .unused_bits = 4, .flags = 0x7000, .idle = 0x7800 });
+      std::array<u16, 3> block{};
+
+      // Exercise
+      auto const first = feeder.fill(block);
+      auto const first_block = block;
+      auto const second = feeder.fill(block);
+      auto const second_block = block;
+      auto const done = feeder.done();
+      auto const third = feeder.fill(block);
+
+      // Verify
+      expect(that % 3 == first);
+      expect(std::array<u16, 3>{ 0x7FFF, 0x7808, 0x7000 } == first_block);
+      expect(that % 2 == second);
+      expect(std::array<u16, 3>{ 0x7121, 0x7010, 0x7800 } == second_block);
+      expect(done);
+      expect(that % 0 == third);
+      expect(std::array<u16, 3>{ 0x7800, 0x7800, 0x7800 } == block);
+    };
+
+    "stream_dac_feeder continues with a new source"_test = []() {
+      // Setup
+      std::array<u16 const, 2> const first{ 0xFFF0, 0x0010 };
+      std::array<u16 const, 1> const second{ 0x1230 };
+      stream_dac_feeder<u16> feeder(first, { .unused_bits = 4 });
+      std::array<u16, 2> block{};
+
+      // Exercise
+      feeder.fill(block);
+      auto const first_block = block;
+      feeder.restart(second);
+      auto const remaining = feeder.remaining();
+      feeder.fill(block);
+
+      // Verify
+      expect(std::array<u16, 2>{ 0x0FFF, 0x0001 } == first_block);
+      expect(that % 1 == remaining);
+      expect(std::array<u16, 2>{ 0x0123, 0x0000 } == block);
+      expect(throws<hal::argument_out_of_domain>([&]() {
+        stream_dac_feeder<u16> invalid(first, { .unused_bits = 4, .flags = 1 });
+      }));
+    };
+
+    "justification rejects shifts of the whole sample"_test = []() {
+      // Setup
+      std::array<u8, 2> samples{};
+
+      // Exercise & Verify
+      expect(throws<hal::argument_out_of_domain>(
+        [&]() { right_justify<u8>(samples, 8); }));
+      expect(throws<hal::argument_out_of_domain>(
+        [&]() { left_justify<u8>(samples, 9); }));
+      expect(nothrow([&]() { right_justify<u8>(samples, 7); }));
+    };
+  };
+}  // namespace hal
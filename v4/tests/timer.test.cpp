@@ -80,6 +80,30 @@ boost::ut::suite timer_test = []() {
       is_running = test.is_running();
       expect(that % false == is_running);
     };
+
+    "timer::schedule() accepts larger callbacks"_test = []() {
+      // Setup
+      test_timer test;
+      int first = 0;
+      int second = 0;
+      int third = 0;
+      hal::callback_n<void(void), 3> callback = [&first, &second, &third]() {
+        first++;
+        second += 2;
+        third += 3;
+      };
+
+      // Exercise
+      test.schedule(callback, std::chrono::milliseconds(5));
+      test.m_callback();
+
+      // Verify
+      expect(test.is_running());
+      expect(std::chrono::milliseconds(5) == test.m_delay);
+      expect(that % 1 == first);
+      expect(that % 2 == second);
+      expect(that % 3 == third);
+    };
   };
 };
 }  // namespace hal
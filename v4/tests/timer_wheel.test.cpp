@@ -0,0 +1,214 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <vector>
+
+#include <libhal/timer_wheel.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+using namespace std::chrono_literals;
+
+class test_timer : public hal::timer
+{
+public:
+  bool m_is_running = false;
+  hal::callback<void(void)> m_callback = []() {};
+  hal::time_duration m_delay{};
+  int m_schedules = 0;
+
+private:
+  bool driver_is_running() override
+  {
+    return m_is_running;
+  }
+
+  void driver_cancel() override
+  {
+    m_is_running = false;
+  }
+
+  void driver_schedule(hal::callback<void(void)> p_callback,
+                       hal::time_duration p_delay) override
+  {
+    m_is_running = true;
+    m_callback = p_callback;
+    m_delay = p_delay;
+    m_schedules++;
+  }
+};
+
+/// Steady clock counting microseconds
+class test_steady_clock : public hal::steady_clock
+{
+public:
+  void advance_to(hal::time_duration p_time)
+  {
+    m_uptime = static_cast<u64>(p_time.count() / 1'000);
+  }
+
+  u64 m_uptime = 0;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1.0_MHz;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+
+/// Advance the clock to a time and fire the timer
+template<usize Levels>
+usize fire_at(timer_wheel<Levels>& p_wheel,
+              test_timer& p_timer,
+              test_steady_clock& p_clock,
+              hal::time_duration p_time)
+{
+  p_clock.advance_to(p_time);
+  p_timer.m_is_running = false;
+  p_timer.m_callback();
+  return p_wheel.poll();
+}
+}  // namespace
+
+boost::ut::suite<"timer_wheel_test"> timer_wheel_test = []() {
+  using namespace boost::ut;
+
+  "timer_wheel programs only the nearest deadline"_test = []() {
+    // Setup
+    test_timer timer;
+    test_steady_clock clock;
+    timer_wheel wheel(timer, clock, 1ms);
+    wheel_timeout first([]() {});
+    wheel_timeout second([]() {});
+    wheel_timeout third([]() {});
+
+    // Exercise
+    wheel.schedule(first, 10ms);
+    wheel.schedule(second, 5ms);
+    wheel.schedule(third, 300ms);
+
+    // Verify
+    expect(that % 2 == timer.m_schedules);
+    expect(5ms == timer.m_delay);
+    expect(first.scheduled() and second.scheduled() and third.scheduled());
+  };
+
+  "timer_wheel expires deadlines in order across levels"_test = []() {
+    // Setup
+    test_timer timer;
+    test_steady_clock clock;
+    timer_wheel wheel(timer, clock, 1ms);
+    std::vector<int> order;
+    wheel_timeout first([&]() { order.push_back(1); });
+    wheel_timeout second([&]() { order.push_back(2); });
+    wheel_timeout third([&]() { order.push_back(3); });
+    wheel.schedule(first, 10ms);
+    wheel.schedule(second, 5ms);
+    wheel.schedule(third, 300ms);
+
+    // Exercise & Verify
+    expect(that % 0 == wheel.poll());
+    expect(that % 1 == fire_at(wheel, timer, clock, 5ms));
+    expect(5ms == timer.m_delay);
+    expect(that % 1 == fire_at(wheel, timer, clock, 10ms));
+    // The third deadline moves down a level at 256ms
+    expect(246ms == timer.m_delay);
+    expect(that % 0 == fire_at(wheel, timer, clock, 256ms));
+    expect(44ms == timer.m_delay);
+    expect(that % 1 == fire_at(wheel, timer, clock, 300ms));
+    expect(std::vector<int>{ 2, 1, 3 } == order);
+    expect(wheel.empty());
+    expect(not third.scheduled());
+  };
+
+  "timer_wheel runs every missed deadline in one poll"_test = []() {
+    // Setup
+    test_timer timer;
+    test_steady_clock clock;
+    timer_wheel wheel(timer, clock, 1ms);
+    std::vector<int> order;
+    wheel_timeout first([&]() { order.push_back(1); });
+    wheel_timeout second([&]() { order.push_back(2); });
+    wheel_timeout third([&]() { order.push_back(3); });
+    wheel.schedule(first, 70ms);
+    wheel.schedule(second, 5000ms);
+    wheel.schedule(third, 1ms);
+
+    // Exercise
+    auto const called = fire_at(wheel, timer, clock, 6s);
+
+    // Verify
+    expect(that % 3 == called);
+    expect(std::vector<int>{ 3, 1, 2 } == order);
+  };
+
+  "timer_wheel cancel and reschedule from handlers"_test = []() {
+    // Setup
+    test_timer timer;
+    test_steady_clock clock;
+    timer_wheel wheel(timer, clock, 1ms);
+    int periodic_count = 0;
+    int canceled_count = 0;
+    wheel_timeout canceled([&]() { canceled_count++; });
+    struct
+    {
+      timer_wheel<>* wheel;
+      wheel_timeout* canceled;
+      wheel_timeout* periodic;
+      int* count;
+    } state{ &wheel, &canceled, nullptr, &periodic_count };
+    wheel_timeout periodic([&state]() {
+      (*state.count)++;
+      state.wheel->cancel(*state.canceled);
+      state.wheel->schedule(*state.periodic, 10ms);
+    });
+    state.periodic = &periodic;
+    wheel.schedule(periodic, 10ms);
+    wheel.schedule(canceled, 10ms);
+
+    // Exercise
+    auto const called = fire_at(wheel, timer, clock, 10ms);
+    (void)fire_at(wheel, timer, clock, 20ms);
+    (void)fire_at(wheel, timer, clock, 30ms);
+
+    // Verify
+    expect(that % 1 == called);
+    expect(that % 3 == periodic_count);
+    expect(that % 0 == canceled_count);
+    expect(periodic.scheduled());
+    expect(10ms == timer.m_delay);
+  };
+
+  "timer_wheel throws for deadlines beyond its levels"_test = []() {
+    // Setup
+    test_timer timer;
+    test_steady_clock clock;
+    timer_wheel<1> wheel(timer, clock, 1ms);
+    wheel_timeout timeout([]() {});
+
+    // Exercise & Verify
+    wheel.schedule(timeout, 63ms);
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { wheel.schedule(timeout, 64ms); }));
+  };
+};
+}  // namespace hal
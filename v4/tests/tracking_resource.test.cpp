@@ -0,0 +1,136 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory_resource>
+#include <new>
+
+#include <libhal/allocated_buffer.hpp>
+#include <libhal/boot_arena.hpp>
+#include <libhal/circular_buffer.hpp>
+#include <libhal/error.hpp>
+#include <libhal/pointers.hpp>
+#include <libhal/tracking_resource.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+boost::ut::suite<"tracking_resource_test"> tracking_resource_test = []() {
+  using namespace boost::ut;
+
+  "allocations are counted by tag"_test = []() {
+    // Setup
+    tracking_resource<4> memory(*std::pmr::new_delete_resource());
+
+    // Exercise
+    {
+      allocated_buffer<u32> samples(&memory.tag("adc"), 16);
+      circular_buffer<u16> history(&memory.tag("uart"), 32);
+      auto const counter = make_strong_ptr<u32>(&memory.tag("adc"), 5U);
+      auto const during = memory.snapshot();
+
+      // Verify
+      expect(that % 2 == during.tag_count);
+      expect(during.used()[0].tag == "adc");
+      expect(that % 2 == during.used()[0].allocations);
+      expect(during.used()[0].bytes_in_use >= 16 * sizeof(u32));
+      expect(that % 1 == during.used()[1].allocations);
+      expect(that % (32 * sizeof(u16)) == during.used()[1].bytes_in_use);
+      expect(that % 3 == during.total.live());
+      expect(memory.leaked());
+    }
+
+    // Verify
+    auto const after = memory.snapshot();
+    expect(not memory.leaked());
+    expect(that % 0 == after.total.bytes_in_use);
+    expect(that % 3 == after.total.deallocations);
+    expect(that % after.total.peak_bytes ==
+           after.used()[0].peak_bytes + after.used()[1].peak_bytes);
+    auto const& uart = memory.tag("uart").statistics();
+    expect(that % (32 * sizeof(u16)) == uart.peak_bytes)
+      << "Peak should remain after deallocation";
+  };
+
+  "peak of the total is the peak of the combined use"_test = []() {
+    // Setup
+    tracking_resource<2> memory(*std::pmr::new_delete_resource());
+    auto& first = memory.tag("first");
+    auto& second = memory.tag("second");
+
+    // Exercise
+    {
+      allocated_buffer<hal::byte> buffer(&first, 100);
+    }
+    {
+      allocated_buffer<hal::byte> buffer(&second, 60);
+    }
+
+    // Verify
+    expect(that % 100 == memory.total().peak_bytes)
+      << "Allocations that never overlap should not add up";
+    expect(that % 100 == first.statistics().peak_bytes);
+    expect(that % 60 == second.statistics().peak_bytes);
+  };
+
+  "leaks are reported per tag"_test = []() {
+    // Setup
+    std::array<hal::byte, 256> region{};
+    boot_arena arena(region);
+    tracking_resource<2> memory(arena);
+
+    // Exercise
+    auto* const kept = memory.tag("kept").allocate(24, 8);
+    {
+      allocated_buffer<u32> released(&memory.tag("released"), 4);
+    }
+
+    // Verify
+    auto const snapshot = memory.snapshot();
+    expect(snapshot.used()[0].leaked());
+    expect(that % 1 == snapshot.used()[0].live());
+    expect(not snapshot.used()[1].leaked());
+    expect(memory.leaked());
+    memory.tag("kept").deallocate(kept, 24, 8);
+    expect(not memory.leaked());
+  };
+
+  "upstream failures are counted and propagated"_test = []() {
+    // Setup
+    std::array<hal::byte, 32> region{};
+    boot_arena arena(region);
+    tracking_resource<1> memory(arena);
+    auto& tag = memory.tag("large");
+
+    // Exercise
+    expect(throws<std::bad_alloc>([&]() { (void)tag.allocate(64, 4); }));
+
+    // Verify
+    expect(that % 1 == tag.statistics().failures);
+    expect(that % 0 == tag.statistics().allocations);
+    expect(that % 1 == memory.total().failures);
+    expect(not memory.leaked());
+  };
+
+  "tags beyond the capacity are rejected"_test = []() {
+    // Setup
+    tracking_resource<1> memory(*std::pmr::new_delete_resource());
+    auto& only = memory.tag("only");
+
+    // Exercise + Verify
+    expect(&only == &memory.tag("only"));
+    expect(throws<hal::out_of_range>([&]() { (void)memory.tag("another"); }));
+  };
+};
+}  // namespace hal
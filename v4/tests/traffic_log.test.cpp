@@ -0,0 +1,313 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+#include <libhal/error.hpp>
+#include <libhal/traffic_log.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+using namespace std::chrono_literals;
+
+/// Clock advanced by hand, at 1 MHz
+class manual_clock : public hal::steady_clock
+{
+public:
+  u64 m_uptime = 1000;
+
+private:
+  hertz driver_frequency() override
+  {
+    return 1'000'000.0f;
+  }
+
+  u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+
+/// i2c answering reads with an incrementing count, without a device at 0x10
+class counting_i2c : public hal::i2c
+{
+public:
+  hal::byte m_count = 0;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_transaction(
+    hal::byte p_address,
+    std::span<hal::byte const>,
+    std::span<hal::byte> p_data_in,
+    hal::function_ref<hal::timeout_function>) override
+  {
+    if (p_address == 0x10) {
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+    for (auto& data : p_data_in) {
+      data = m_count++;
+    }
+  }
+};
+
+class fixed_adc : public hal::adc16
+{
+public:
+  u16 m_sample = 0;
+
+private:
+  u16 driver_read() override
+  {
+    return m_sample;
+  }
+};
+
+struct log_sink
+{
+  std::vector<hal::byte> m_log;
+  usize m_calls = 0;
+
+  traffic_recorder::sink sink()
+  {
+    return [this](std::span<hal::byte const> p_data) {
+      m_log.insert(m_log.end(), p_data.begin(), p_data.end());
+      m_calls++;
+    };
+  }
+};
+}  // namespace
+
+boost::ut::suite<"traffic_log_test"> traffic_log_test = []() {
+  using namespace boost::ut;
+
+  "records decode to the traffic and times recorded"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    std::array<hal::byte const, 2> written{ 0xAA, 0xBB };
+    std::array<hal::byte const, 3> read{ 1, 2, 3 };
+    std::vector<hal::byte> const serial_data(200, 0x55);
+    can_message const message{ .id = 0x1ABCDE,
+                               .extended = true,
+                               .length = 3,
+                               .payload = { 9, 8, 7 } };
+
+    // Exercise
+    clock.m_uptime += 5;
+    recorder.record_i2c(0x48, written, read);
+    recorder.record_i2c(0x10, written, read, std::errc::no_such_device);
+    clock.m_uptime += 1'000'000;
+    recorder.record_can(message);
+    recorder.record_serial(2, serial_data);
+    clock.m_uptime += 300;
+    recorder.record_adc(7, 0xFFF);
+
+    traffic_reader reader(output.m_log);
+    std::vector<traffic_record> records;
+    while (auto record = reader.next()) {
+      records.push_back(*record);
+    }
+
+    // Verify
+    expect(that % 1'000'000 == reader.frequency());
+    expect(that % 5 == recorder.records());
+    expect(that % output.m_log.size() == recorder.bytes());
+    expect(that % 5 == records.size());
+
+    expect(traffic_kind::i2c == records[0].kind);
+    expect(5us == records[0].time);
+    expect(that % 0x48 == records[0].channel);
+    expect(std::ranges::equal(written, records[0].data_out));
+    expect(std::ranges::equal(read, records[0].data_in));
+
+    expect(std::errc::no_such_device == records[1].status);
+    expect(records[1].data_in.empty());
+
+    expect(traffic_kind::can == records[2].kind);
+    expect(1s + 5us == records[2].time);
+    expect(that % 0x1ABCDE == records[2].message.id);
+    expect(records[2].message.extended);
+    expect(that % 3 == records[2].message.length);
+    expect(message.payload == records[2].message.payload);
+
+    expect(traffic_kind::serial == records[3].kind);
+    expect(that % 2 == records[3].channel);
+    expect(std::ranges::equal(serial_data, records[3].data_out));
+
+    expect(traffic_kind::adc == records[4].kind);
+    expect(1s + 305us == records[4].time);
+    expect(that % 7 == records[4].channel);
+    expect(that % 0xFFF == records[4].sample);
+  };
+
+  "records are compact"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    auto const header = output.m_log.size();
+    std::array<hal::byte const, 1> reg{ 0x0F };
+    std::array<hal::byte const, 2> value{ 0x12, 0x34 };
+
+    // Exercise
+    clock.m_uptime += 100;
+    recorder.record_i2c(0x48, reg, value);
+    auto const i2c_size = output.m_log.size() - header;
+    recorder.record_adc(0, 1023);
+    auto const adc_size = output.m_log.size() - header - i2c_size;
+
+    // Verify
+    // kind, 1 tick byte, address, status, 2 lengths and 3 data bytes
+    expect(that % 9 == i2c_size);
+    // kind, 1 tick byte, channel and a 2 byte sample
+    expect(that % 5 == adc_size);
+    expect(that % 3 == output.m_calls) << "One sink call per record";
+  };
+
+  "recording drivers forward and record traffic"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    counting_i2c bus;
+    fixed_adc adc;
+    adc.m_sample = 321;
+    recording_i2c recording_bus(bus, recorder);
+    recording_adc16 recording_adc(adc, recorder, 4);
+    std::array<hal::byte const, 1> command{ 0x01 };
+    std::array<hal::byte, 2> response{};
+
+    // Exercise
+    recording_bus.transaction(0x48, command, response);
+    expect(throws<hal::no_such_device>([&]() {
+      recording_bus.transaction(0x10, command, std::span<hal::byte>{});
+    }));
+    auto const sample = recording_adc.read();
+
+    traffic_reader reader(output.m_log);
+    auto const first = reader.next();
+    auto const second = reader.next();
+    auto const third = reader.next();
+
+    // Verify
+    expect(std::array<hal::byte, 2>{ 0, 1 } == response);
+    expect(that % 321 == sample);
+    expect(std::ranges::equal(response, first->data_in));
+    expect(std::errc{} == first->status);
+    expect(std::errc::no_such_device == second->status);
+    expect(that % 0x10 == second->channel);
+    expect(that % 321 == third->sample);
+    expect(that % 4 == third->channel);
+    expect(not reader.next().has_value());
+  };
+
+  "replay_i2c serves recorded transactions in order"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    std::array<hal::byte const, 1> command{ 0x01 };
+    std::array<hal::byte const, 2> recorded{ 0xDE, 0xAD };
+    recorder.record_i2c(0x48, command, recorded);
+    recorder.record_adc(0, 0);
+    recorder.record_i2c(0x10, command, {}, std::errc::no_such_device);
+    replay_i2c test(output.m_log);
+    std::array<hal::byte, 2> response{};
+
+    // Exercise
+    test.transaction(0x48, command, response);
+
+    // Verify
+    expect(std::ranges::equal(recorded, response));
+    expect(throws<hal::no_such_device>([&]() {
+      test.transaction(0x10, command, std::span<hal::byte>{});
+    }));
+    expect(throws<hal::out_of_range>([&]() {
+      test.transaction(0x48, command, response);
+    }));
+    expect(that % 2 == test.transactions());
+  };
+
+  "replay_i2c rejects transactions that differ from the log"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    std::array<hal::byte const, 1> command{ 0x01 };
+    std::array<hal::byte, 2> response{};
+    recorder.record_i2c(0x48, command, response);
+    replay_i2c test(output.m_log);
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.transaction(0x49, command, response); }));
+  };
+
+  "corrupt logs are rejected"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    std::vector<hal::byte> const data(10, 0);
+    recorder.record_serial(0, data);
+    auto truncated = output.m_log;
+    truncated.pop_back();
+    std::array<hal::byte const, 5> not_a_log{ 'h', 'a', 'l', 'x', 1 };
+
+    // Exercise
+    traffic_reader reader(truncated);
+
+    // Verify
+    expect(throws<hal::argument_out_of_domain>([&]() { reader.next(); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { traffic_reader bad(not_a_log); }));
+  };
+
+  "traffic_player runs records at their recorded times"_test = []() {
+    // Setup
+    manual_clock clock;
+    log_sink output;
+    traffic_recorder recorder(clock, output.sink());
+    clock.m_uptime += 10;
+    recorder.record_can(can_message{ .id = 0x100, .length = 0 });
+    clock.m_uptime += 490;
+    recorder.record_adc(1, 42);
+    sim::event_loop loop(std::pmr::new_delete_resource());
+    loop.run_for(1ms);
+    traffic_player test(loop, output.m_log);
+    std::vector<time_duration> times;
+
+    // Exercise
+    test.play([&loop, &times](traffic_record const&) {
+      times.push_back(loop.now());
+    });
+    loop.run_for(10ms);
+
+    // Verify
+    expect(std::vector<time_duration>{ 1ms + 10us, 1ms + 500us } == times);
+    expect(that % 2 == test.played());
+    expect(test.finished());
+    expect(that % 0 == loop.pending());
+  };
+};
+}  // namespace hal
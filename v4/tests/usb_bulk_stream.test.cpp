@@ -0,0 +1,315 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <libhal/error.hpp>
+#include <libhal/usb_bulk_stream.hpp>
+#include <libhal/zero_copy_serial_reader.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::usb {
+namespace {
+class mock_bulk_in_endpoint : public bulk_in_endpoint
+{
+public:
+  std::vector<hal::byte> m_sent{};
+  int m_transfers_finished = 0;
+
+private:
+  [[nodiscard]] endpoint_info driver_info() const override
+  {
+    return { .size = 8, .number = 0x81, .stalled = false };
+  }
+
+  void driver_stall(bool) override
+  {
+  }
+
+  void driver_reset() override
+  {
+  }
+
+  void driver_write(scatter_span<byte const> p_data) override
+  {
+    if (p_data.empty()) {
+      m_transfers_finished++;
+    }
+    for (auto const segment : p_data) {
+      m_sent.insert(m_sent.end(), segment.begin(), segment.end());
+    }
+  }
+};
+
+class mock_bulk_out_endpoint : public bulk_out_endpoint
+{
+public:
+  std::vector<hal::byte> m_host_data{};
+  std::optional<callback<void(on_receive_tag)>> m_callback{};
+
+  void host_send(std::initializer_list<hal::byte> p_data)
+  {
+    m_host_data.insert(m_host_data.end(), p_data);
+    (*m_callback)(on_receive_tag{});
+  }
+
+private:
+  [[nodiscard]] endpoint_info driver_info() const override
+  {
+    return { .size = 4, .number = 0x01, .stalled = false };
+  }
+
+  void driver_stall(bool) override
+  {
+  }
+
+  void driver_reset() override
+  {
+  }
+
+  void driver_on_receive(
+    callback<void(on_receive_tag)> const& p_callback) override
+  {
+    m_callback = p_callback;
+  }
+
+  usize driver_read(scatter_span<byte> p_buffer) override
+  {
+    usize count = 0;
+    for (auto const segment : p_buffer) {
+      for (auto& byte : segment) {
+        if (count == m_host_data.size()) {
+          break;
+        }
+        byte = m_host_data[count++];
+      }
+    }
+    m_host_data.erase(m_host_data.begin(), m_host_data.begin() + count);
+    return count;
+  }
+};
+
+/// OUT endpoint that receives packets into a region, like a DMA driver
+class mock_queued_bulk_out_endpoint : public mock_bulk_out_endpoint
+{
+public:
+  static constexpr usize packet_size = 4;
+
+  /// Deliver one packet from the HOST, returns false if it was NAKed
+  bool host_packet(std::initializer_list<hal::byte> p_data)
+  {
+    auto remaining = usize{ 0 };
+    for (auto const segment : m_region) {
+      remaining += segment.size();
+    }
+    if (remaining - m_received < packet_size) {
+      return false;
+    }
+
+    usize offset = m_received;
+    for (auto const byte : p_data) {
+      auto position = offset++;
+      for (auto const segment : m_region) {
+        if (position < segment.size()) {
+          segment[position] = byte;
+          break;
+        }
+        position -= segment.size();
+      }
+    }
+    m_received = offset;
+    (*m_callback)(on_receive_tag{});
+    return true;
+  }
+
+  scatter_span<hal::byte> m_region{};
+  usize m_received = 0;
+  int m_regions = 0;
+
+private:
+  bool driver_receive_into(scatter_span<byte> p_region) override
+  {
+    m_region = p_region;
+    m_received = 0;
+    m_regions++;
+    return true;
+  }
+
+  usize driver_received() override
+  {
+    return m_received;
+  }
+};
+
+std::vector<hal::byte> flatten(scatter_span<hal::byte const> p_data)
+{
+  std::vector<hal::byte> result;
+  for (auto const segment : p_data) {
+    result.insert(result.end(), segment.begin(), segment.end());
+  }
+  return result;
+}
+}  // namespace
+
+boost::ut::suite<"usb_bulk_stream_test"> usb_bulk_stream_test = []() {
+  using namespace boost::ut;
+
+  "bulk_stream requires two packets of buffer"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_bulk_out_endpoint out;
+    std::array<hal::byte, 7> buffer{};
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { bulk_stream stream(in, out, buffer); }));
+  };
+
+  "bulk_stream::poll() and read() wrap around the ring"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_bulk_out_endpoint out;
+    std::array<hal::byte, 8> buffer{};
+    bulk_stream stream(in, out, buffer);
+
+    // Exercise
+    out.host_send({ 1, 2, 3, 4, 5, 6 });
+    auto const first_moved = stream.poll();
+    auto const first = flatten(stream.read());
+    out.host_send({ 7, 8, 9, 10 });
+    auto const second_moved = stream.poll();
+    auto const second = stream.read();
+
+    // Verify
+    expect(that % 6 == first_moved);
+    expect(std::vector<hal::byte>{ 1, 2, 3, 4, 5, 6 } == first);
+    expect(that % 4 == second_moved);
+    expect(that % 2 == second.size());
+    expect(std::vector<hal::byte>{ 7, 8, 9, 10 } == flatten(second));
+    expect(that % 2 == stream.receive_cursor());
+    expect(that % 10 == stream.receive_count().value());
+  };
+
+  "bulk_stream leaves data in the endpoint when full"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_bulk_out_endpoint out;
+    std::array<hal::byte, 8> buffer{};
+    bulk_stream stream(in, out, buffer);
+
+    // Exercise
+    out.host_send({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+    auto const first_moved = stream.poll();
+    auto const blocked_moved = stream.poll();
+    auto const first = flatten(stream.read());
+    auto const second_moved = stream.poll();
+    auto const second = flatten(stream.read());
+
+    // Verify
+    expect(that % 8 == first_moved);
+    expect(that % 0 == blocked_moved);
+    expect(std::vector<hal::byte>{ 1, 2, 3, 4, 5, 6, 7, 8 } == first);
+    expect(that % 2 == second_moved);
+    expect(std::vector<hal::byte>{ 9, 10 } == second);
+    expect(that % 0 == out.m_host_data.size());
+  };
+
+  "bulk_stream works with zero_copy_serial_reader"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_bulk_out_endpoint out;
+    std::array<hal::byte, 8> buffer{};
+    bulk_stream stream(in, out, buffer);
+    zero_copy_serial_reader reader(stream);
+
+    // Exercise
+    out.host_send({ 1, 2, 3 });
+    stream.poll();
+    auto const data = flatten(reader.read());
+
+    // Verify
+    expect(std::vector<hal::byte>{ 1, 2, 3 } == data);
+  };
+
+  "bulk_stream receives into the ring without polling"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_queued_bulk_out_endpoint out;
+    std::array<hal::byte, 12> buffer{};
+    bulk_stream stream(in, out, buffer);
+
+    // Exercise
+    auto const first_accepted = out.host_packet({ 1, 2, 3, 4 });
+    auto const second_accepted = out.host_packet({ 5, 6 });
+    auto const third_accepted = out.host_packet({ 7, 8, 9, 10 });
+    auto const full_nak = not out.host_packet({ 11 });
+    auto const first_moved = stream.poll();
+    auto const first = flatten(stream.read());
+    auto const released_moved = stream.poll();
+    auto const wrapped_accepted = out.host_packet({ 11, 12, 13, 14 });
+    auto const second_moved = stream.poll();
+    auto const second = flatten(stream.read());
+
+    // Verify
+    expect(first_accepted and second_accepted and third_accepted);
+    expect(full_nak);
+    expect(that % 10 == first_moved);
+    expect(std::vector<hal::byte>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } == first);
+    expect(that % 0 == released_moved);
+    expect(that % 3 == out.m_regions);
+    expect(wrapped_accepted);
+    expect(that % 4 == second_moved);
+    expect(std::vector<hal::byte>{ 11, 12, 13, 14 } == second);
+    expect(that % 2 == stream.receive_cursor());
+    expect(that % 14 == stream.receive_count().value());
+    expect(that % 0 == out.m_host_data.size());
+  };
+
+  "bulk_stream::write() finishes the transfer"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_bulk_out_endpoint out;
+    std::array<hal::byte, 8> buffer{};
+    bulk_stream stream(in, out, buffer);
+    std::array<hal::byte, 2> const header{ 0xA, 0xB };
+    std::array<hal::byte, 1> const body{ 0xC };
+
+    // Exercise
+    stream.write(make_scatter_bytes(header, body));
+
+    // Verify
+    expect(std::vector<hal::byte>{ 0xA, 0xB, 0xC } == in.m_sent);
+    expect(that % 1 == in.m_transfers_finished);
+  };
+
+  "bulk_stream::write() sends nothing without data"_test = []() {
+    // Setup
+    mock_bulk_in_endpoint in;
+    mock_bulk_out_endpoint out;
+    std::array<hal::byte, 8> buffer{};
+    bulk_stream stream(in, out, buffer);
+
+    // Exercise
+    stream.write({});
+    stream.write(make_scatter_bytes(std::span<hal::byte const>{}));
+
+    // Verify
+    expect(that % 0 == in.m_transfers_finished);
+    expect(in.m_sent.empty());
+  };
+};
+}  // namespace hal::usb
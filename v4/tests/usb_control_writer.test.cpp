@@ -0,0 +1,214 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include <libhal/error.hpp>
+#include <libhal/usb_control_writer.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::usb {
+namespace {
+/// Records the bytes and the origin of every write
+class recording_control_endpoint : public control_endpoint
+{
+public:
+  explicit recording_control_endpoint(u16 p_packet_size)
+    : m_packet_size(p_packet_size)
+  {
+  }
+
+  std::vector<hal::byte> m_bytes;
+  std::vector<usize> m_write_sizes;
+  std::vector<hal::byte const*> m_write_origins;
+
+private:
+  [[nodiscard]] endpoint_info driver_info() const override
+  {
+    return { .size = m_packet_size, .number = 0, .stalled = false };
+  }
+
+  void driver_stall(bool) override
+  {
+  }
+
+  void driver_reset() override
+  {
+  }
+
+  void driver_connect(bool) override
+  {
+  }
+
+  void driver_set_address(u8) override
+  {
+  }
+
+  void driver_write(scatter_span<hal::byte const> p_data) override
+  {
+    m_write_sizes.push_back(scatter_size(p_data));
+    m_write_origins.push_back(p_data.empty() ? nullptr : p_data[0].data());
+    for (auto const& segment : p_data) {
+      m_bytes.insert(m_bytes.end(), segment.begin(), segment.end());
+    }
+  }
+
+  usize driver_read(scatter_span<hal::byte>) override
+  {
+    return 0;
+  }
+
+  void driver_on_receive(callback<void(on_receive_tag)> const&) override
+  {
+  }
+
+  u16 m_packet_size;
+};
+
+std::vector<hal::byte> make_pattern(usize p_size)
+{
+  std::vector<hal::byte> result(p_size);
+  for (usize i = 0; i < p_size; i++) {
+    result[i] = static_cast<hal::byte>(i * 13 + 1);
+  }
+  return result;
+}
+}  // namespace
+
+boost::ut::suite<"usb_control_writer_test"> usb_control_writer_test = []() {
+  using namespace boost::ut;
+
+  "small writes are coalesced into packets"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(8);
+    control_writer test(endpoint, 255);
+    auto const data = make_pattern(20);
+    auto const writer = test.writer();
+
+    // Exercise
+    for (usize i = 0; i < data.size(); i += 2) {
+      writer(make_scatter_bytes(std::span(data).subspan(i, 2)));
+    }
+    test.finish();
+
+    // Verify
+    expect(std::vector<usize>{ 8, 8, 4, 0 } == endpoint.m_write_sizes);
+    expect(data == endpoint.m_bytes);
+    expect(that % 20 == test.size());
+    expect(not test.truncated());
+  };
+
+  "whole packets are written from the caller's memory"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(64);
+    control_writer test(endpoint, 1024);
+    std::array<hal::byte const, 4> header{ 0xA5, 0x01, 0x02, 0x03 };
+    static constexpr auto table = []() {
+      std::array<hal::byte, 700> result{};
+      for (usize i = 0; i < result.size(); i++) {
+        result[i] = static_cast<hal::byte>(i);
+      }
+      return result;
+    }();
+
+    // Exercise
+    test.write(make_scatter_bytes(header, table));
+    test.finish();
+
+    // Verify
+    // 60 bytes top up the header's packet, 640 bytes of the rest are whole
+    // packets passed straight through, leaving no tail
+    expect(std::vector<usize>{ 64, 640, 0 } == endpoint.m_write_sizes);
+    expect(table.data() + 60 == endpoint.m_write_origins[1])
+      << "Whole packets must not be copied";
+    expect(that % 704 == endpoint.m_bytes.size());
+  };
+
+  "responses on a packet boundary end with a zero length packet"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(16);
+    control_writer test(endpoint, 64);
+    auto const data = make_pattern(32);
+
+    // Exercise
+    test.write(make_scatter_bytes(data));
+    test.finish();
+    test.finish();
+
+    // Verify
+    expect(std::vector<usize>{ 32, 0 } == endpoint.m_write_sizes);
+    expect(that % 2 == test.endpoint_writes());
+  };
+
+  "responses of exactly wLength need no zero length packet"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(16);
+    control_writer test(endpoint, 32);
+    auto const data = make_pattern(32);
+
+    // Exercise
+    test.write(make_scatter_bytes(data));
+    test.finish();
+
+    // Verify
+    expect(std::vector<usize>{ 32 } == endpoint.m_write_sizes);
+  };
+
+  "responses are cut to wLength"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(64);
+    control_writer test(endpoint, 9);
+    auto const data = make_pattern(18);
+
+    // Exercise
+    test.write(make_scatter_bytes(data));
+    test.finish();
+
+    // Verify
+    expect(std::vector<usize>{ 9, 0 } == endpoint.m_write_sizes);
+    expect(std::ranges::equal(std::span(data).first(9), endpoint.m_bytes));
+    expect(test.truncated());
+    expect(that % 9 == test.size());
+  };
+
+  "requests without a data stage write nothing"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(64);
+    control_writer test(endpoint, 0);
+    auto const data = make_pattern(4);
+
+    // Exercise
+    test.write(make_scatter_bytes(data));
+    test.finish();
+
+    // Verify
+    expect(that % 0 == endpoint.m_write_sizes.size());
+    expect(test.truncated());
+  };
+
+  "packet sizes above the capacity are rejected"_test = []() {
+    // Setup
+    recording_control_endpoint endpoint(64);
+    recording_control_endpoint empty(0);
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { control_writer<32> test(endpoint, 64); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { control_writer test(empty, 64); }));
+  };
+};
+}  // namespace hal::usb
@@ -0,0 +1,134 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include <libhal/usb_descriptors.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::usb {
+namespace {
+constexpr auto vendor_descriptors = make_static_descriptors<[] {
+  descriptor_builder<64> builder;
+  builder.interface({ .interface_class = 0xFF, .name = u"AB" })
+    .endpoint({ .info = { .size = 64, .number = 0x81, .stalled = false } })
+    .endpoint({ .info = { .size = 64, .number = 0x01, .stalled = false } });
+  return builder;
+}>();
+
+constexpr auto configured_descriptors = make_static_descriptors<[] {
+  descriptor_builder<64> builder;
+  builder.configuration({ .max_power_ma = 500 })
+    .interface_association({ .interface_count = 2, .function_class = 0x02 })
+    .interface({ .interface_class = 0x02 })
+    .raw(std::to_array<hal::byte>({ 5, 0x24, 0x06 }))
+    .interface_number(0)
+    .interface_number(1)
+    .endpoint({ .info = { .size = 8, .number = 0x82, .stalled = false },
+                .type = transfer_type::interrupt,
+                .interval = 16 })
+    .interface({ .interface_class = 0x0A });
+  return builder;
+}>();
+
+// The descriptors are sized to fit and computed by the compiler
+static_assert(vendor_descriptors.data.size() == 9 + 7 + 7);
+static_assert(vendor_descriptors.string_data.size() == 6);
+static_assert(vendor_descriptors.data[4] == 2);  // bNumEndpoints
+static_assert(vendor_descriptors.data[8] == 1);  // iInterface
+static_assert(configured_descriptors.data[2] == 9 + 8 + 9 + 5 + 7 + 9);
+static_assert(configured_descriptors.data[4] == 2);  // bNumInterfaces
+static_assert(configured_descriptors.data[5] == 1);  // bConfigurationValue
+static_assert(configured_descriptors.data[6] == 0);  // iConfiguration
+static_assert(configured_descriptors.data[8] == 250);
+
+std::vector<hal::byte> collect(auto const& p_write)
+{
+  std::vector<hal::byte> result;
+  p_write([&result](scatter_span<hal::byte const> p_data) {
+    for (auto const segment : p_data) {
+      result.insert(result.end(), segment.begin(), segment.end());
+    }
+  });
+  return result;
+}
+}  // namespace
+
+boost::ut::suite<"usb_descriptors_test"> usb_descriptors_test = []() {
+  using namespace boost::ut;
+
+  "static_descriptors::write() streams the descriptors"_test = []() {
+    // Setup
+    auto const expected = std::to_array<hal::byte>({
+      // clang-format off
+      9, 0x04, 0, 0, 2, 0xFF, 0, 0, 1,
+      7, 0x05, 0x81, 0x02, 64, 0, 0,
+      7, 0x05, 0x01, 0x02, 64, 0, 0,
+      // clang-format on
+    });
+    interface::descriptor_count count{};
+
+    // Exercise
+    auto const actual = collect([&](auto const& p_writer) {
+      count = vendor_descriptors.write({}, p_writer);
+    });
+
+    // Verify
+    expect(that % std::vector(expected.begin(), expected.end()) == actual);
+    expect(that % 1 == count.interface);
+    expect(that % 1 == count.string);
+  };
+
+  "static_descriptors::write() offsets numbers and strings"_test = []() {
+    // Exercise
+    auto const vendor = collect([&](auto const& p_writer) {
+      (void)vendor_descriptors.write({ .interface = 3, .string = 5 }, p_writer);
+    });
+    auto const configured = collect([&](auto const& p_writer) {
+      (void)configured_descriptors.write({ .interface = 2, .string = 5 },
+                                         p_writer);
+    });
+
+    // Verify
+    expect(that % 3 == vendor[2]);
+    expect(that % 5 == vendor[8]);
+    // bFirstInterface of the interface association
+    expect(that % 2 == configured[9 + 2]);
+    // Interface numbers of the union descriptor
+    expect(that % 2 == configured[9 + 8 + 9 + 3]);
+    expect(that % 3 == configured[9 + 8 + 9 + 4]);
+    // Second interface
+    expect(that % 3 == configured[9 + 8 + 9 + 5 + 7 + 2]);
+  };
+
+  "static_descriptors::write_string() writes UTF-16LE strings"_test = []() {
+    // Setup
+    bool found = false;
+    bool missing = true;
+
+    // Exercise
+    auto const actual = collect([&](auto const& p_writer) {
+      found = vendor_descriptors.write_string(5, 5, p_writer);
+      missing = vendor_descriptors.write_string(6, 5, p_writer);
+    });
+
+    // Verify
+    expect(found);
+    expect(not missing);
+    expect(that % std::vector<hal::byte>{ 6, 0x03, 'A', 0, 'B', 0 } == actual);
+  };
+};
+}  // namespace hal::usb
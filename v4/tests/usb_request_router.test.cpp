@@ -0,0 +1,179 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include <libhal/usb_request_router.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::usb {
+namespace {
+class mock_member : public interface
+{
+public:
+  mock_member(u8 p_interfaces, u8 p_strings, bool p_handles = true)
+    : m_interfaces(p_interfaces)
+    , m_strings(p_strings)
+    , m_handles(p_handles)
+  {
+  }
+
+  descriptor_start m_start{};
+  setup_packet m_last_request{};
+  u8 m_last_string = 0;
+  int m_requests = 0;
+
+private:
+  descriptor_count driver_write_descriptors(descriptor_start p_start,
+                                            endpoint_writer const&) override
+  {
+    m_start = p_start;
+    return { .interface = m_interfaces, .string = m_strings };
+  }
+
+  bool driver_write_string_descriptor(u8 p_index,
+                                      endpoint_writer const&) override
+  {
+    m_last_string = p_index;
+    return true;
+  }
+
+  bool driver_handle_request(setup_packet const& p_setup,
+                             endpoint_writer const&) override
+  {
+    m_last_request = p_setup;
+    m_requests++;
+    return m_handles;
+  }
+
+  u8 m_interfaces;
+  u8 m_strings;
+  bool m_handles;
+};
+
+void ignore(scatter_span<hal::byte const>)
+{
+}
+
+setup_packet make_request(setup_packet::request_recipient p_recipient,
+                          u16 p_index)
+{
+  return setup_packet({ .device_to_host = true,
+                        .type = setup_packet::request_type::class_t,
+                        .recipient = p_recipient,
+                        .request = 0x01,
+                        .value = 0,
+                        .index = p_index,
+                        .length = 0 });
+}
+}  // namespace
+
+boost::ut::suite<"usb_request_router_test"> usb_request_router_test = []() {
+  using namespace boost::ut;
+
+  "request_router numbers interfaces and strings in order"_test = []() {
+    // Setup
+    mock_member first(2, 1);
+    mock_member second(1, 3);
+    std::array<interface*, 2> members{ &first, &second };
+    request_router router(members);
+
+    // Exercise
+    auto const count =
+      router.write_descriptors({ .interface = 1, .string = 4 }, ignore);
+
+    // Verify
+    expect(interface::descriptor_count{ .interface = 3, .string = 4 } ==
+           count);
+    expect(interface::descriptor_start{ .interface = 1, .string = 4 } ==
+           first.m_start);
+    expect(interface::descriptor_start{ .interface = 3, .string = 5 } ==
+           second.m_start);
+  };
+
+  "request_router dispatches by interface and endpoint"_test = []() {
+    // Setup
+    mock_member first(2, 1);
+    mock_member second(1, 2);
+    std::array<interface*, 2> members{ &first, &second };
+    request_router router(members);
+    (void)router.write_descriptors({ .interface = 0, .string = 1 }, ignore);
+    router.route_endpoint(0x81, first);
+    router.route_endpoint(0x01, second);
+    using recipient = setup_packet::request_recipient;
+
+    // Exercise
+    auto const to_second = make_request(recipient::interface, 2);
+    auto const to_first = make_request(recipient::interface, 1);
+    auto const in_endpoint = make_request(recipient::endpoint, 0x81);
+    auto const out_endpoint = make_request(recipient::endpoint, 0x01);
+    expect(router.handle_request(to_second, ignore));
+    expect(router.handle_request(to_first, ignore));
+    expect(router.handle_request(in_endpoint, ignore));
+    expect(router.handle_request(out_endpoint, ignore));
+    expect(router.write_string_descriptor(3, ignore));
+
+    // Verify
+    expect(that % 2 == first.m_requests);
+    expect(that % 2 == second.m_requests);
+    expect(in_endpoint == first.m_last_request);
+    expect(out_endpoint == second.m_last_request);
+    expect(that % 3 == second.m_last_string);
+    expect(request_router_statistics{ .routed = 4 } == router.statistics());
+  };
+
+  "request_router counts unrouted and unhandled requests"_test = []() {
+    // Setup
+    mock_member refuses(1, 0, false);
+    std::array<interface*, 1> members{ &refuses };
+    request_router<2, 2> router(members);
+    (void)router.write_descriptors({ .interface = 0, .string = 1 }, ignore);
+    using recipient = setup_packet::request_recipient;
+
+    // Exercise
+    auto const refused = router.handle_request(
+      make_request(recipient::interface, 0), ignore);
+    auto const missing = router.handle_request(
+      make_request(recipient::interface, 1), ignore);
+    auto const endpoint = router.handle_request(
+      make_request(recipient::endpoint, 0x82), ignore);
+    auto const device =
+      router.handle_request(make_request(recipient::device, 0), ignore);
+    auto const string = router.write_string_descriptor(1, ignore);
+
+    // Verify
+    expect(not refused);
+    expect(not missing);
+    expect(not endpoint);
+    expect(not device);
+    expect(not string);
+    expect(request_router_statistics{ .unrouted = 3, .unhandled = 1 } ==
+           router.statistics());
+    router.reset_statistics();
+    expect(request_router_statistics{} == router.statistics());
+  };
+
+  "request_router throws when the tables are exceeded"_test = []() {
+    // Setup
+    mock_member large(3, 0);
+    std::array<interface*, 1> members{ &large };
+    request_router<2, 2> router(members);
+
+    // Exercise & Verify
+    expect(throws<hal::out_of_range>(
+      [&]() { (void)router.write_descriptors({}, ignore); }));
+  };
+};
+}  // namespace hal::usb
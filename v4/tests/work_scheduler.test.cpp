@@ -0,0 +1,116 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include <libhal/work_scheduler.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class counting_waiter : public io_waiter
+{
+public:
+  hal::callback<void()> m_on_wait = []() {};
+  int m_waits = 0;
+  int m_resumes = 0;
+
+private:
+  void driver_wait() override
+  {
+    m_waits++;
+    m_on_wait();
+  }
+
+  void driver_resume() noexcept override
+  {
+    m_resumes++;
+  }
+};
+}  // namespace
+
+boost::ut::suite<"work_scheduler_test"> work_scheduler_test = []() {
+  using namespace boost::ut;
+
+  "work_scheduler round robins and retires workers"_test = []() {
+    // Setup
+    work_scheduler<4> scheduler;
+    std::vector<int> order;
+    int first_steps = 0;
+    int second_steps = 0;
+    scheduler.spawn([&order, &first_steps]() {
+      order.push_back(1);
+      return ++first_steps == 2 ? work_state::finished
+                                : work_state::in_progress;
+    });
+    scheduler.spawn([&order, &second_steps]() {
+      order.push_back(2);
+      return ++second_steps == 3 ? work_state::failed
+                                 : work_state::in_progress;
+    });
+
+    // Exercise
+    scheduler.run();
+
+    // Verify
+    expect(std::vector<int>{ 1, 2, 1, 2, 2 } == order);
+    expect(that % 0 == scheduler.size());
+    expect(work_scheduler_statistics{ .finished = 1, .failed = 1 } ==
+           scheduler.statistics());
+  };
+
+  "work_scheduler parks workers until resumed"_test = []() {
+    // Setup
+    counting_waiter idle;
+    work_scheduler<2> scheduler(idle);
+    int steps = 0;
+    io_waiter* waiter = nullptr;
+    waiter = &scheduler.spawn([&steps, &waiter]() {
+      steps++;
+      if (steps == 1) {
+        waiter->wait();
+        return work_state::in_progress;
+      }
+      return work_state::finished;
+    });
+    // The interrupt completing the I/O
+    idle.m_on_wait = [&waiter]() { waiter->resume(); };
+
+    // Exercise
+    auto const first = scheduler.run_once();
+    auto const parked = scheduler.run_once();
+    scheduler.run();
+
+    // Verify
+    expect(that % 1 == first);
+    expect(that % 0 == parked);
+    expect(that % 2 == steps);
+    expect(that % 1 == idle.m_waits);
+    expect(that % 1 == idle.m_resumes);
+  };
+
+  "work_scheduler throws when full"_test = []() {
+    // Setup
+    work_scheduler<1> scheduler;
+    scheduler.spawn([]() { return work_state::in_progress; });
+
+    // Exercise & Verify
+    expect(throws<hal::out_of_range>([&]() {
+      (void)scheduler.spawn([]() { return work_state::in_progress; });
+    }));
+    expect(that % 1 == scheduler.size());
+  };
+};
+}  // namespace hal
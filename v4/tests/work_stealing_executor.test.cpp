@@ -0,0 +1,115 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+
+#include <libhal/error.hpp>
+#include <libhal/work_stealing_executor.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+boost::ut::suite<"work_stealing_executor_test"> work_stealing_executor_test =
+  []() {
+    using namespace boost::ut;
+
+    "run_once calls workers until they are retired"_test = []() {
+      // Setup
+      work_stealing_executor<2> executor(std::pmr::new_delete_resource(), 4);
+      int steps = 0;
+      executor.spawn(0, [&steps]() {
+        return ++steps == 3 ? work_state::finished : work_state::in_progress;
+      });
+      executor.spawn(0, []() { return work_state::failed; });
+
+      // Exercise
+      while (executor.run_once(0)) {
+      }
+
+      // Verify
+      expect(that % 3 == steps);
+      expect(that % 0 == executor.pending());
+      expect(work_stealing_statistics{
+               .calls = 4, .stolen = 0, .finished = 1, .failed = 1 } ==
+             executor.statistics(0));
+      expect(not executor.run_once(1));
+    };
+
+    "idle cores steal workers from other cores"_test = []() {
+      // Setup
+      work_stealing_executor<3> executor(std::pmr::new_delete_resource(), 4);
+      executor.spawn(1, []() { return work_state::finished; });
+      executor.spawn(1, []() { return work_state::finished; });
+
+      // Exercise
+      auto const ran_on_0 = executor.run_once(0);
+      auto const ran_on_2 = executor.run_once(2);
+
+      // Verify
+      expect(ran_on_0);
+      expect(ran_on_2);
+      expect(that % 0 == executor.pending());
+      expect(that % 1 == executor.statistics(0).stolen);
+      expect(that % 1 == executor.statistics(2).stolen);
+      expect(that % 0 == executor.statistics(1).calls);
+    };
+
+    "spawn rejects bad cores and workers beyond the capacity"_test = []() {
+      // Setup
+      work_stealing_executor<2> executor(std::pmr::new_delete_resource(), 1);
+      executor.spawn(0, []() { return work_state::finished; });
+
+      // Exercise & Verify
+      expect(throws<hal::out_of_range>([&executor]() {
+        executor.spawn(1, []() { return work_state::finished; });
+      }));
+      expect(throws<hal::out_of_range>([&executor]() {
+        executor.spawn(2, []() { return work_state::finished; });
+      }));
+      expect(that % 1 == executor.pending());
+    };
+
+    "two cores run every worker to completion"_test = []() {
+      // Setup
+      constexpr int workers = 32;
+      constexpr int steps = 100;
+      work_stealing_executor<2> executor(std::pmr::new_delete_resource(),
+                                         workers);
+      std::array<std::atomic<int>, workers> progress{};
+      for (auto& count : progress) {
+        executor.spawn(0, [&count]() {
+          return ++count == steps ? work_state::finished
+                                  : work_state::in_progress;
+        });
+      }
+
+      // Exercise
+      std::thread second_core([&executor]() { executor.run(1); });
+      executor.run(0);
+      second_core.join();
+
+      // Verify
+      for (auto const& count : progress) {
+        expect(that % steps == count.load());
+      }
+      auto const first = executor.statistics(0);
+      auto const second = executor.statistics(1);
+      expect(that % workers == first.finished + second.finished);
+      expect(that % (workers * steps) == first.calls + second.calls);
+    };
+  };
+}  // namespace hal
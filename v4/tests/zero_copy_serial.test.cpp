@@ -36,6 +36,7 @@ public:
   std::span<hal::byte const> m_data_write{};
   std::array<hal::byte, 4> m_working_buffer{};
   std::size_t m_cursor{};
+  int m_write_calls = 0;
   ~test_serial() override = default;
 
   void append_data_to_receive_buffer(std::span<hal::byte const> p_data)
@@ -57,6 +58,7 @@ private:
   void driver_write(std::span<hal::byte const> p_data) override
   {
     m_data_write = p_data;
+    m_write_calls++;
   }
 
   std::span<hal::byte const> driver_receive_buffer() override
@@ -69,6 +71,41 @@ private:
     return m_cursor;
   }
 };
+
+/// Rewrites the baud rate divider without restarting reception, which resets
+/// the cursor in the full configure path
+class fast_path_serial : public test_serial
+{
+public:
+  int m_full_configures = 0;
+  int m_baud_writes = 0;
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+    m_cursor = 0;
+    m_full_configures++;
+  }
+
+  void driver_update_settings(settings const& p_settings) override
+  {
+    auto const changes = hal::settings_changes(m_settings, p_settings);
+    if (changes.frame_format()) {
+      driver_configure(p_settings);
+      return;
+    }
+    if (changes.baud_rate) {
+      m_settings.baud_rate = p_settings.baud_rate;
+      m_baud_writes++;
+    }
+  }
+};
+
+static_assert(not hal::settings_changes(expected_settings, expected_settings)
+                    .any());
+static_assert(hal::settings_changes({}, expected_settings) ==
+              hal::serial_settings_changes{ .stop = true });
 }  // namespace
 
 boost::ut::suite<"zero_copy_serial_test"> zero_copy_serial_test = []() {
@@ -88,6 +125,46 @@ boost::ut::suite<"zero_copy_serial_test"> zero_copy_serial_test = []() {
     expect(expected_settings == test.m_settings);
   };
 
+  "::update_settings() default"_test = []() {
+    // Setup
+    test_serial test;
+
+    // Exercise
+    test.update_settings(expected_settings);
+
+    // Verify
+    expect(expected_settings == test.m_settings)
+      << "Default implementation should apply the settings with configure";
+  };
+
+  "::update_settings() fast path"_test = []() {
+    // Setup
+    constexpr auto received = std::to_array<hal::byte const>({ 'o', 'k' });
+    auto faster = expected_settings;
+    faster.baud_rate = 921600.0f;
+    auto reframed = faster;
+    reframed.parity = hal::serial::settings::parity::even;
+    fast_path_serial test;
+    test.configure(expected_settings);
+    test.append_data_to_receive_buffer(received);
+
+    // Exercise
+    test.update_settings(faster);
+    auto const cursor_after_baud = test.receive_cursor();
+    test.update_settings(faster);
+    auto const baud_writes_after_repeat = test.m_baud_writes;
+    test.update_settings(reframed);
+
+    // Verify
+    expect(that % received.size() == cursor_after_baud)
+      << "Changing only the baud rate should keep the receive cursor";
+    expect(that % 1 == baud_writes_after_repeat)
+      << "Unchanged settings should not touch the hardware";
+    expect(that % 2 == test.m_full_configures);
+    expect(reframed == test.m_settings);
+    expect(that % 0 == test.receive_cursor());
+  };
+
   "::write"_test = []() {
     // Setup
     constexpr auto expected_payload =
@@ -106,6 +183,39 @@ boost::ut::suite<"zero_copy_serial_test"> zero_copy_serial_test = []() {
     expect(expected_payload.size() == test.m_data_write.size());
   };
 
+  "::write(scatter_span)"_test = []() {
+    // Setup
+    constexpr auto header = std::to_array<hal::byte const>({ 'a', 'b' });
+    constexpr auto payload = std::to_array<hal::byte const>({ 'c' });
+    auto const scatter_list = make_scatter_bytes(header, payload);
+    test_serial test;
+
+    // Exercise
+    test.write(scatter_list);
+
+    // Verify
+    expect(that % 2 == test.m_write_calls)
+      << "Default implementation should write each block";
+    expect(payload.data() == test.m_data_write.data());
+    expect(payload.size() == test.m_data_write.size());
+  };
+
+  "::write_async() default"_test = []() {
+    // Setup
+    constexpr auto payload = std::to_array<hal::byte const>({ 'a', 'b' });
+    test_serial test;
+    bool completed = false;
+
+    // Exercise
+    test.write_async(payload, [&completed]() { completed = true; });
+
+    // Verify
+    expect(completed) << "Default implementation completes before returning";
+    expect(that % 0 == test.write_in_flight());
+    expect(payload.data() == test.m_data_write.data());
+    expect(that % 1 == test.m_write_calls);
+  };
+
   "::receive_buffer() & ::receive_cursor()"_test = []() {
     // Setup
     constexpr auto expected_buffer = std::to_array<hal::byte>({ '1', '2' });
@@ -0,0 +1,236 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <optional>
+#include <span>
+
+#include <libhal/serial.hpp>
+#include <libhal/zero_copy_serial.hpp>
+#include <libhal/zero_copy_serial_reader.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal {
+namespace {
+class test_serial : public hal::v5::serial
+{
+public:
+  std::array<hal::byte, 8> m_buffer{};
+  usize m_cursor = 0;
+  usize m_count = 0;
+  bool m_supports_count = true;
+
+  void receive(std::span<hal::byte const> p_data)
+  {
+    for (auto const byte : p_data) {
+      m_buffer[m_cursor] = byte;
+      m_cursor = (m_cursor + 1) % m_buffer.size();
+      m_count++;
+    }
+  }
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  void driver_write(std::span<hal::byte const>) override
+  {
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return m_buffer;
+  }
+
+  std::size_t driver_cursor() override
+  {
+    return m_cursor;
+  }
+
+  std::optional<usize> driver_receive_count() override
+  {
+    if (m_supports_count) {
+      return m_count;
+    }
+    return std::nullopt;
+  }
+};
+
+class legacy_serial : public hal::zero_copy_serial
+{
+private:
+  void driver_configure(hal::serial::settings const&) override
+  {
+  }
+
+  void driver_write(std::span<hal::byte const>) override
+  {
+  }
+
+  std::span<hal::byte const> driver_receive_buffer() override
+  {
+    return m_buffer;
+  }
+
+  std::size_t driver_cursor() override
+  {
+    return 0;
+  }
+
+  std::array<hal::byte, 4> m_buffer{};
+};
+
+static_assert(zero_copy_receiver<hal::zero_copy_serial>);
+static_assert(zero_copy_receiver<hal::v5::serial>);
+}  // namespace
+
+boost::ut::suite<"zero_copy_serial_reader_test"> zero_copy_serial_reader_test =
+  []() {
+    using namespace boost::ut;
+
+    "no new data"_test = []() {
+      // Setup
+      test_serial serial;
+      serial.receive(std::to_array<hal::byte>({ 1, 2 }));
+      zero_copy_serial_reader reader(serial);
+
+      // Exercise
+      auto const data = reader.read();
+
+      // Verify
+      expect(that % 0 == data.size()) << "Data before construction is skipped";
+      expect(that % 0 == reader.dropped());
+    };
+
+    "contiguous data"_test = []() {
+      // Setup
+      test_serial serial;
+      zero_copy_serial_reader reader(serial);
+      auto const expected = std::to_array<hal::byte>({ 1, 2, 3 });
+      auto const expected_list = make_scatter_bytes(expected);
+
+      // Exercise
+      serial.receive(expected);
+      auto const data = reader.read();
+
+      // Verify
+      expect(that % 1 == data.size());
+      expect(data == scatter_span<hal::byte const>(expected_list));
+      expect(that % serial.m_buffer.data() == data[0].data())
+        << "Data must not be copied";
+      expect(that % 0 == reader.read().size());
+    };
+
+    "wrapped data"_test = []() {
+      // Setup
+      test_serial serial;
+      serial.receive(std::to_array<hal::byte>({ 0, 0, 0, 0, 0, 0 }));
+      zero_copy_serial_reader reader(serial);
+      auto const expected = std::to_array<hal::byte>({ 1, 2, 3, 4, 5 });
+      auto const expected_list = make_scatter_bytes(expected);
+
+      // Exercise
+      serial.receive(expected);
+      auto const data = reader.read();
+
+      // Verify
+      expect(that % 2 == data.size());
+      expect(that % 2 == data[0].size());
+      expect(that % 3 == data[1].size());
+      expect(data == scatter_span<hal::byte const>(expected_list));
+      expect(that % 0 == reader.dropped());
+    };
+
+    "overrun"_test = []() {
+      // Setup
+      test_serial serial;
+      zero_copy_serial_reader reader(serial);
+      auto const input =
+        std::to_array<hal::byte>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+      auto const expected = std::span(input).last(8);
+      auto const expected_list = make_scatter_bytes(expected);
+
+      // Exercise
+      serial.receive(input);
+      auto const data = reader.read();
+
+      // Verify
+      expect(that % 3 == reader.dropped());
+      expect(data == scatter_span<hal::byte const>(expected_list));
+      expect(that % 0 == reader.read().size());
+      expect(that % 0 == reader.dropped());
+    };
+
+    "exact lap"_test = []() {
+      // Setup
+      test_serial serial;
+      zero_copy_serial_reader reader(serial);
+      auto const input = std::to_array<hal::byte>({ 1, 2, 3, 4, 5, 6, 7, 8 });
+
+      // Exercise
+      serial.receive(input);
+      auto const data = reader.read();
+
+      // Verify
+      expect(that % 0 == reader.dropped());
+      expect(that % 1 == data.size());
+      expect(that % 8 == data[0].size())
+        << "A full buffer is only detectable with receive_count()";
+    };
+
+    "without receive_count"_test = []() {
+      // Setup
+      test_serial serial;
+      serial.m_supports_count = false;
+      zero_copy_serial_reader reader(serial);
+
+      // Exercise
+      serial.receive(std::to_array<hal::byte>({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+      auto const data = reader.read();
+
+      // Verify
+      expect(that % 0 == reader.dropped());
+      expect(that % 1 == data.size());
+      expect(that % 1 == data[0].size());
+      expect(that % 9 == data[0][0]);
+    };
+
+    "skip"_test = []() {
+      // Setup
+      test_serial serial;
+      zero_copy_serial_reader reader(serial);
+
+      // Exercise
+      serial.receive(std::to_array<hal::byte>({ 1, 2, 3 }));
+      reader.skip();
+
+      // Verify
+      expect(that % 0 == reader.read().size());
+    };
+
+    "legacy zero_copy_serial"_test = []() {
+      // Setup
+      legacy_serial serial;
+
+      // Exercise
+      zero_copy_serial_reader reader(serial);
+
+      // Verify
+      expect(not serial.receive_count().has_value());
+      expect(that % 0 == reader.read().size());
+    };
+  };
+}  // namespace hal
@@ -0,0 +1,155 @@
+# Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Build time benchmark of the module libraries
+#
+# Measures a cold build of a configured Ninja build directory, then an
+# incremental build after touching each module in TOUCH, and reports:
+#
+#   cold_build,<ms>                      wall time of the cold build
+#   compile/<output>,<ms>                compile time of each translation unit
+#   bmi/<file>,<bytes>                   size of each built module interface
+#   incremental/<module>,<ms>,<rebuilt>  wall time of the rebuild after touching
+#                                        modules/<module>.cppm and the number
+#                                        of translation units it recompiled
+#
+# Usage, from the v5 directory, after configuring a build directory with the
+# Ninja generator (for example with `conan build .`):
+#
+#   cmake -DBUILD_DIR=build/Release -P benchmarks/module_build.cmake
+#
+# Optional variables:
+#
+#   BUILD_TARGET - target to build, defaults to `all`
+#   TOUCH        - semicolon separated modules to touch, defaults to
+#                  `units;gpio`
+
+cmake_minimum_required(VERSION 4.0)
+
+if(NOT BUILD_DIR)
+    message(FATAL_ERROR "Set BUILD_DIR to a configured Ninja build directory")
+endif()
+get_filename_component(BUILD_DIR "${BUILD_DIR}" ABSOLUTE)
+if(NOT EXISTS "${BUILD_DIR}/build.ninja")
+    message(FATAL_ERROR "${BUILD_DIR} was not configured with Ninja")
+endif()
+if(NOT BUILD_TARGET)
+    set(BUILD_TARGET all)
+endif()
+if(NOT DEFINED TOUCH)
+    set(TOUCH units gpio)
+endif()
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(NINJA_LOG "${BUILD_DIR}/.ninja_log")
+
+# Milliseconds since the epoch
+function(now_ms OUT)
+    string(TIMESTAMP seconds "%s" UTC)
+    string(TIMESTAMP micros "%f" UTC)
+    # Leading zeros of the fraction are not part of the number
+    string(REGEX REPLACE "^0+([0-9])" "\\1" micros "${micros}")
+    math(EXPR result "${seconds} * 1000 + ${micros} / 1000")
+    set(${OUT} ${result} PARENT_SCOPE)
+endfunction()
+
+# Number of lines in the ninja log, so later reads only see newer entries
+function(log_length OUT)
+    set(length 0)
+    if(EXISTS "${NINJA_LOG}")
+        file(STRINGS "${NINJA_LOG}" lines)
+        list(LENGTH lines length)
+    endif()
+    set(${OUT} ${length} PARENT_SCOPE)
+endfunction()
+
+# Build BUILD_TARGET and set OUT to its wall time in milliseconds
+function(timed_build OUT)
+    now_ms(start)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} --build "${BUILD_DIR}" --target ${BUILD_TARGET}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET)
+    now_ms(end)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Build of ${BUILD_TARGET} failed")
+    endif()
+    math(EXPR elapsed "${end} - ${start}")
+    set(${OUT} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+# Set OUT to the ninja log entries of compiled objects after line FROM. Each
+# entry is `<ms>,<output>`.
+function(compiled_since FROM OUT)
+    file(STRINGS "${NINJA_LOG}" lines)
+    list(LENGTH lines length)
+    set(entries)
+    if(length GREATER FROM)
+        list(SUBLIST lines ${FROM} -1 lines)
+        foreach(line IN LISTS lines)
+            # <start>\t<end>\t<mtime>\t<output>\t<command hash>
+            string(REPLACE "\t" ";" fields "${line}")
+            list(LENGTH fields field_count)
+            if(NOT field_count EQUAL 5)
+                continue()
+            endif()
+            list(GET fields 0 start)
+            list(GET fields 1 end)
+            list(GET fields 3 output)
+            if(output MATCHES "\\.(o|obj)$")
+                math(EXPR elapsed "${end} - ${start}")
+                list(APPEND entries "${elapsed},${output}")
+            endif()
+        endforeach()
+    endif()
+    set(${OUT} ${entries} PARENT_SCOPE)
+endfunction()
+
+# Cold build
+execute_process(
+    COMMAND ${CMAKE_COMMAND} --build "${BUILD_DIR}" --target clean
+    OUTPUT_QUIET)
+log_length(start_line)
+timed_build(cold)
+message("cold_build,${cold}")
+
+compiled_since(${start_line} compiled)
+foreach(entry IN LISTS compiled)
+    string(REPLACE "," ";" fields "${entry}")
+    list(GET fields 0 elapsed)
+    list(GET fields 1 output)
+    message("compile/${output},${elapsed}")
+endforeach()
+
+# Interface units: .gcm for GCC, .pcm for Clang, .ifc for MSVC
+file(GLOB_RECURSE interfaces "${BUILD_DIR}/*.gcm" "${BUILD_DIR}/*.pcm"
+    "${BUILD_DIR}/*.ifc")
+foreach(interface IN LISTS interfaces)
+    file(SIZE "${interface}" size)
+    file(RELATIVE_PATH name "${BUILD_DIR}" "${interface}")
+    message("bmi/${name},${size}")
+endforeach()
+
+# Incremental builds
+foreach(module IN LISTS TOUCH)
+    set(source "${SOURCE_DIR}/modules/${module}.cppm")
+    if(NOT EXISTS "${source}")
+        message(FATAL_ERROR "No module source ${source}")
+    endif()
+    file(TOUCH_NOCREATE "${source}")
+    log_length(start_line)
+    timed_build(incremental)
+    compiled_since(${start_line} compiled)
+    list(LENGTH compiled rebuilt)
+    message("incremental/${module},${incremental},${rebuilt}")
+endforeach()
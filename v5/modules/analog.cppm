@@ -12,9 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-export module hal:analog;
+export module hal.analog;
 
-export import :units;
+export import hal.units;
 export import async_context;
 
 namespace hal::inline v5 {
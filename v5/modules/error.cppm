@@ -17,9 +17,9 @@ module;
 #include <system_error>
 #include <type_traits>
 
-export module hal:error;
+export module hal.error;
 
-export import :units;
+export import hal.units;
 
 /**
  * @defgroup Error Error
@@ -11,9 +11,9 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 
-export module hal:gpio;
+export module hal.gpio;
 
-export import :units;
+export import hal.units;
 
 namespace hal::inline v5 {
 /**
@@ -146,4 +146,113 @@ private:
   virtual void driver_level(bool p_high) = 0;
   virtual bool driver_level() = 0;
 };
+
+/**
+ * @brief Digital output port hardware abstraction.
+ *
+ * Use this to drive many pins at once, such as the data lines of a parallel
+ * bus or the rows of an LED matrix. Where `output_pin::level(bool)` changes one
+ * pin per call, this interface changes every pin selected by a mask in a
+ * single call, and drivers backed by a GPIO port do so with a single register
+ * write (for example, a set/reset register such as the STM32 BSRR).
+ *
+ * Bit `n` of the masks and values corresponds to pin `n` of the port, where
+ * the order of the pins is defined by the implementation.
+ *
+ */
+export class output_port
+{
+public:
+  /**
+   * @brief Configure every pin of the port to match the settings supplied
+   *
+   * @param p_settings - settings to apply to the pins of the port
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  void configure(output_pin::settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Set the state of the pins selected by a mask
+   *
+   * Pins whose bit is set in `p_mask` are set to the level of the matching bit
+   * of `p_value`, HIGH for 1 and LOW for 0. Pins whose bit is clear in
+   * `p_mask` are left unchanged. Bits beyond the pins of the port are ignored.
+   *
+   * @param p_mask - pins to update
+   * @param p_value - levels of the pins to update
+   */
+  void level(u32 p_mask, u32 p_value)
+  {
+    driver_level(p_mask, p_value);
+  }
+
+  /**
+   * @brief Read the state of every pin of the port
+   *
+   * Implementations must read the pin states from hardware and will not simply
+   * cache the results from the execution of `level(u32, u32)`.
+   *
+   * @return u32 - levels of the pins, HIGH for 1 and LOW for 0. Bits beyond the
+   * pins of the port are 0.
+   */
+  [[nodiscard]] u32 level()
+  {
+    return driver_level();
+  }
+
+  virtual ~output_port() = default;
+
+private:
+  virtual void driver_configure(output_pin::settings const& p_settings) = 0;
+  virtual void driver_level(u32 p_mask, u32 p_value) = 0;
+  virtual u32 driver_level() = 0;
+};
+
+/**
+ * @brief Digital input port hardware abstraction.
+ *
+ * Use this to sample many pins at once. Drivers backed by a GPIO port read
+ * every pin with a single register read, so all pins are sampled at the same
+ * instant.
+ *
+ * Bit `n` of the result corresponds to pin `n` of the port, where the order of
+ * the pins is defined by the implementation.
+ *
+ */
+export class input_port
+{
+public:
+  /**
+   * @brief Configure every pin of the port to match the settings supplied
+   *
+   * @param p_settings - settings to apply to the pins of the port
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  void configure(input_pin::settings const& p_settings)
+  {
+    driver_configure(p_settings);
+  }
+
+  /**
+   * @brief Read the state of every pin of the port
+   *
+   * @return u32 - levels of the pins, HIGH for 1 and LOW for 0. Bits beyond the
+   * pins of the port are 0.
+   */
+  [[nodiscard]] u32 level()
+  {
+    return driver_level();
+  }
+
+  virtual ~input_port() = default;
+
+private:
+  virtual void driver_configure(input_pin::settings const& p_settings) = 0;
+  virtual u32 driver_level() = 0;
+};
 }  // namespace hal::inline v5
@@ -12,16 +12,25 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// Umbrella module of the interfaces. Every interface module is also its own
+// library target, so code that only needs a few interfaces should import them
+// directly, for example `import hal.gpio;`, and skip building and reading the
+// interface units of the rest.
 export module hal;
 
-export import :analog;
-export import :units;
-export import :pwm;
-export import :gpio;
-export import :motion_sensors;
-export import :power_sensors;
-export import :error;
-export import :interrupts;
+export import hal.analog;
+export import hal.units;
+export import hal.pwm;
+export import hal.gpio;
+export import hal.motion_sensors;
+export import hal.power_sensors;
+export import hal.error;
+export import hal.interrupts;
+export import hal.serial;
+export import hal.i2c;
+export import hal.spi;
+export import hal.sensor_poller;
+export import hal.isr_profiler;
 
 export import strong_ptr;
 export import async_context;
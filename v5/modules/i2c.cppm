@@ -0,0 +1,134 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+
+
+module;
+
+#include <span>
+
+export module hal.i2c;
+
+export import hal.units;
+export import async_context;
+
+using namespace mp_units::si::unit_symbols;
+
+export namespace hal::inline v5 {
+/**
+ * @brief Inter-integrated Circuit (I2C) hardware abstract interface.
+ *
+ * Also known as Two Wire Interface (TWI) communication protocol. This is a very
+ * commonly used protocol for communication with sensors and peripheral devices
+ * because it only requires two connections SDA (data signal) and SCL (clock
+ * signal).
+ *
+ * Every operation returns an `async::future` and takes the `async::context`
+ * it runs on. A transaction that waits on the bus suspends rather than
+ * blocking, with its coroutine frame allocated on the stack of the context
+ * instead of the heap, so transactions of several contexts, for example one
+ * per sensor, interleave on a single core.
+ *
+ * The bus performs one transaction at a time. Implementations must suspend a
+ * transaction started while another transaction is in flight until the bus is
+ * free, letting multiple drivers share one bus without extra locking.
+ */
+class i2c
+{
+public:
+  /**
+   * @brief Generic settings for a standard I2C device
+   *
+   */
+  struct settings
+  {
+    /**
+     * @brief The serial clock rate in hertz.
+     *
+     */
+    hertz clock_rate = 100 * kHz;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator==(settings const&) const = default;
+  };
+
+  /**
+   * @brief Configure i2c to match the settings supplied
+   *
+   * @param p_context - async context for the operation
+   * @param p_settings - settings to apply to i2c driver
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  async::future<void> configure(async::context& p_context,
+                                settings const& p_settings)
+  {
+    return driver_configure(p_context, p_settings);
+  }
+
+  /**
+   * @brief perform an i2c transaction with another device on the bus
+   *
+   * The type of transaction depends on values of input parameters:
+   *
+   * - For write transactions, pass p_data_in as an empty span.
+   * - For read transactions, pass p_data_out as an empty span.
+   * - For write-then-read transactions, pass a buffer for both p_data_in and
+   *   p_data_out. The read follows the write with a repeated start.
+   * - If both p_data_in and p_data_out are empty, simply do nothing and
+   *   complete.
+   *
+   * In the event of arbitration loss, the transaction waits for the bus to
+   * become free and tries again.
+   *
+   * @param p_context - async context for the operation
+   * @param p_address - 7-bit address of the device you want to communicate
+   * with. To perform a transaction with a 10-bit address, this parameter must
+   * be the address upper byte of the 10-bit address OR'd with 0b1111'0000 (the
+   * 10-bit address indicator). The lower byte of the address must be contained
+   * in the first byte of the p_data_out span.
+   * @param p_data_out - data to be written to the addressed device. Must stay
+   * valid until the future completes.
+   * @param p_data_in - buffer to store read data from the addressed device.
+   * Must stay valid until the future completes.
+   * @throws hal::no_such_device - indicates that no devices on the bus
+   * acknowledge the address in this transaction, which could mean that the
+   * device is not connected to the bus, is not powered, not available to
+   * respond, broken or many other possible outcomes.
+   * @throws hal::io_error - indicates that the i2c lines were put into an
+   * invalid state during the transaction due to interference, misconfiguration,
+   * hardware fault, malfunctioning i2c peripheral or possibly something else.
+   * This tends to present a hardware issue and is usually not recoverable.
+   */
+  async::future<void> transaction(async::context& p_context,
+                                  byte p_address,
+                                  std::span<byte const> p_data_out,
+                                  std::span<byte> p_data_in)
+  {
+    return driver_transaction(p_context, p_address, p_data_out, p_data_in);
+  }
+
+  virtual ~i2c() = default;
+
+private:
+  virtual async::future<void> driver_configure(async::context& p_context,
+                                               settings const& p_settings) = 0;
+  virtual async::future<void> driver_transaction(
+    async::context& p_context,
+    byte p_address,
+    std::span<byte const> p_data_out,
+    std::span<byte> p_data_in) = 0;
+};
+}  // namespace hal::inline v5
@@ -12,10 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-export module hal:interrupts;
+export module hal.interrupts;
 
 export import strong_ptr;
-export import :units;
+export import hal.units;
+
+import hal.gpio;
 
 export namespace hal::inline v5 {
 
@@ -179,4 +181,175 @@ private:
     time_duration p_delay) = 0;
 };
 
+/**
+ * @brief Counters kept by a debounced_interrupt
+ *
+ */
+struct debounce_statistics
+{
+  /// Settled transitions forwarded to the callback
+  usize forwarded = 0;
+  /// Edges whose debounce window ended with the pin back at its previous level
+  usize suppressed = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(debounce_statistics const&) const = default;
+};
+
+/**
+ * @brief Debounce and edge rate limiting wrapper for edge_triggered_interrupt
+ *
+ * A noisy mechanical input can fire an interrupt for every bounce, thousands
+ * in a burst, starving other interrupts. This wrapper masks the wrapped
+ * interrupt for a fixed window after each edge using a timed_interrupt, so the
+ * wrapped interrupt fires at most once per window. When the window ends, the
+ * interrupt is unmasked and the pin is read: if its level differs from the last
+ * settled level, the transition is forwarded to the callback, otherwise the
+ * edge is counted as suppressed.
+ *
+ * The wrapped interrupt is always configured to trigger on both edges, and the
+ * trigger set through `configure()` selects which settled transitions are
+ * forwarded.
+ *
+ * While a callback is set, the wrapped interrupt or timer holds a reference to
+ * this object. Call `on_trigger(nullptr)` to release it.
+ *
+ * Example usage:
+ *
+ * ```
+ * auto button = mem::make_strong_ptr<hal::debounced_interrupt>(
+ *   allocator, interrupt, pin, timer, 5ms);
+ * button->configure({ .trigger = hal::edge_trigger::falling });
+ * button->on_trigger(handler);
+ * ```
+ */
+class debounced_interrupt
+  : public edge_triggered_interrupt
+  , public mem::enable_strong_from_this<debounced_interrupt>
+{
+public:
+  /**
+   * @brief Construct a debounced interrupt
+   *
+   * @param p_interrupt - interrupt to debounce
+   * @param p_pin - input pin reading the same pin as p_interrupt
+   * @param p_timer - timer used to end each debounce window
+   * @param p_window - time to mask the interrupt after each edge
+   */
+  debounced_interrupt(mem::strong_ptr<edge_triggered_interrupt> p_interrupt,
+                      mem::strong_ptr<input_pin> p_pin,
+                      mem::strong_ptr<timed_interrupt> p_timer,
+                      time_duration p_window)
+    : m_interrupt(p_interrupt)
+    , m_pin(p_pin)
+    , m_timer(p_timer)
+    , m_window(p_window)
+  {
+    m_edge_handler.m_self = this;
+    m_window_handler.m_self = this;
+  }
+
+  debounced_interrupt(debounced_interrupt const&) = delete;
+  debounced_interrupt& operator=(debounced_interrupt const&) = delete;
+  debounced_interrupt(debounced_interrupt&&) = delete;
+  debounced_interrupt& operator=(debounced_interrupt&&) = delete;
+  ~debounced_interrupt() override = default;
+
+  /**
+   * @brief Get the counters for forwarded and suppressed edges
+   *
+   * @return debounce_statistics - counters since construction
+   */
+  [[nodiscard]] debounce_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+private:
+  struct edge_handler : public edge_triggered_callback
+  {
+    void callback(bool) override
+    {
+      m_self->on_edge();
+    }
+    debounced_interrupt* m_self = nullptr;
+  };
+
+  struct window_handler : public timed_callback
+  {
+    void callback() override
+    {
+      m_self->on_settled();
+    }
+    debounced_interrupt* m_self = nullptr;
+  };
+
+  void driver_configure(settings const& p_settings) override
+  {
+    m_interrupt->configure({ .trigger = edge_trigger::both });
+    m_trigger = p_settings.trigger;
+    m_level = m_pin->level();
+  }
+
+  void driver_on_trigger(
+    mem::optional_ptr<edge_triggered_callback> p_callback) override
+  {
+    m_callback = p_callback;
+    if (not m_callback.has_value()) {
+      m_interrupt->on_trigger(nullptr);
+      m_timer->schedule(nullptr, time_duration{ 0 });
+      return;
+    }
+    arm();
+    m_level = m_pin->level();
+  }
+
+  void arm()
+  {
+    m_interrupt->on_trigger(mem::strong_ptr<edge_triggered_callback>(
+      strong_from_this(), &debounced_interrupt::m_edge_handler));
+  }
+
+  void on_edge()
+  {
+    m_interrupt->on_trigger(nullptr);
+    auto const handler = mem::strong_ptr<timed_callback>(
+      strong_from_this(), &debounced_interrupt::m_window_handler);
+    m_timer->schedule(handler, m_window);
+  }
+
+  void on_settled()
+  {
+    // Unmask before reading, so an edge after the read opens a new window
+    arm();
+    bool const level = m_pin->level();
+    if (level == m_level) {
+      m_statistics.suppressed++;
+      return;
+    }
+    m_level = level;
+
+    bool const selected = m_trigger == edge_trigger::both ||
+                          level == (m_trigger == edge_trigger::rising);
+    if (selected && m_callback.has_value()) {
+      m_statistics.forwarded++;
+      m_callback->callback(level);
+    }
+  }
+
+  mem::strong_ptr<edge_triggered_interrupt> m_interrupt;
+  mem::strong_ptr<input_pin> m_pin;
+  mem::strong_ptr<timed_interrupt> m_timer;
+  mem::optional_ptr<edge_triggered_callback> m_callback{};
+  time_duration m_window;
+  edge_handler m_edge_handler{};
+  window_handler m_window_handler{};
+  debounce_statistics m_statistics{};
+  edge_trigger m_trigger = edge_trigger::rising;
+  bool m_level = false;
+};
+
 }  // namespace hal::inline v5
@@ -0,0 +1,372 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <span>
+#include <string_view>
+
+export module hal.isr_profiler;
+
+export import strong_ptr;
+export import hal.units;
+export import hal.interrupts;
+export import hal.steady_clock;
+
+export namespace hal::inline v5 {
+/**
+ * @brief Distribution of a set of measured durations
+ *
+ * Durations are in ticks of the clock that measured them. Bucket `i` of the
+ * histogram counts durations of `[2^(i-1), 2^i)` ticks, bucket 0 counts
+ * durations of 0 ticks and the last bucket also counts all longer durations.
+ */
+struct isr_statistics
+{
+  /// Number of buckets in the histogram
+  static constexpr usize histogram_buckets = 32;
+
+  /// Number of durations measured
+  u64 count = 0;
+  /// Shortest duration, `std::numeric_limits<u64>::max()` until measured
+  u64 min = std::numeric_limits<u64>::max();
+  /// Longest duration
+  u64 max = 0;
+  /// Sum of the durations, for computing the average and the load
+  u64 total = 0;
+  /// Logarithmic histogram of the durations
+  std::array<u32, histogram_buckets> histogram{};
+
+  /**
+   * @brief Add a measured duration
+   *
+   * @param p_ticks - duration in ticks
+   */
+  constexpr void add(u64 p_ticks)
+  {
+    count++;
+    min = std::min(min, p_ticks);
+    max = std::max(max, p_ticks);
+    total += p_ticks;
+    auto const bucket =
+      std::min<usize>(std::bit_width(p_ticks), histogram_buckets - 1);
+    histogram[bucket]++;
+  }
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  constexpr bool operator==(isr_statistics const&) const = default;
+};
+
+/**
+ * @brief Profile of the callback of one registration
+ *
+ * Accumulates the time between the entry and exit of each call of the
+ * callback, timestamped with a steady clock. Use a clock with a cheap uptime
+ * and a fine tick, such as one backed by the cycle counter of the processor,
+ * so that short callbacks are resolved.
+ */
+class isr_profile
+{
+public:
+  /**
+   * @param p_clock - clock timestamping the calls
+   * @param p_name - name of the registration, for reports. Must outlive this
+   * object.
+   */
+  explicit isr_profile(mem::strong_ptr<steady_clock> p_clock,
+                       std::string_view p_name = "")
+    : m_clock(p_clock)
+    , m_name(p_name)
+  {
+  }
+
+  /**
+   * @brief Call a function, adding the duration of the call to the profile
+   *
+   * @param p_callable - function to call with no arguments
+   */
+  template<class Callable>
+  void measure(Callable&& p_callable)
+  {
+    auto const entry = m_clock->uptime();
+    p_callable();
+    m_statistics.add(m_clock->uptime() - entry);
+  }
+
+  /**
+   * @return isr_statistics const& - durations of the calls so far
+   */
+  [[nodiscard]] isr_statistics const& statistics() const
+  {
+    return m_statistics;
+  }
+
+  /**
+   * @brief Clear the statistics
+   *
+   */
+  void reset()
+  {
+    m_statistics = {};
+  }
+
+  /**
+   * @return std::string_view - name of the registration
+   */
+  [[nodiscard]] std::string_view name() const
+  {
+    return m_name;
+  }
+
+  /**
+   * @return steady_clock& - clock timestamping the calls
+   */
+  [[nodiscard]] steady_clock& clock() const
+  {
+    return *m_clock;
+  }
+
+private:
+  mem::strong_ptr<steady_clock> m_clock;
+  std::string_view m_name;
+  isr_statistics m_statistics{};
+};
+
+/**
+ * @brief Find the profile with the longest call
+ *
+ * The longest call of a callback is how long it can block the interrupts
+ * at or below its priority.
+ *
+ * @param p_profiles - profiles to search, null entries are skipped
+ * @return isr_profile const* - profile with the longest call, or nullptr if no
+ * profile has measured a call
+ */
+[[nodiscard]] inline isr_profile const* worst_case(
+  std::span<isr_profile const* const> p_profiles)
+{
+  isr_profile const* worst = nullptr;
+  for (auto const* profile : p_profiles) {
+    if (profile == nullptr || profile->statistics().count == 0) {
+      continue;
+    }
+    if (worst == nullptr ||
+        profile->statistics().max > worst->statistics().max) {
+      worst = profile;
+    }
+  }
+  return worst;
+}
+
+/**
+ * @brief edge_triggered_interrupt profiling the callback of another
+ *
+ * While a callback is set, the wrapped interrupt holds a reference to this
+ * object. Call `on_trigger(nullptr)` to release it.
+ *
+ * Example usage:
+ *
+ * ```
+ * auto button = mem::make_strong_ptr<hal::profiled_edge_triggered_interrupt>(
+ *   allocator, interrupt, cycle_counter, "button");
+ * button->on_trigger(handler);
+ * // Later, from a diagnostics task
+ * auto const worst = button->profile().statistics().max;
+ * ```
+ */
+class profiled_edge_triggered_interrupt
+  : public edge_triggered_interrupt
+  , public mem::enable_strong_from_this<profiled_edge_triggered_interrupt>
+{
+public:
+  /**
+   * @param p_interrupt - interrupt to forward to
+   * @param p_clock - clock timestamping the calls of the callback
+   * @param p_name - name of the profile. Must outlive this object.
+   */
+  profiled_edge_triggered_interrupt(
+    mem::strong_ptr<edge_triggered_interrupt> p_interrupt,
+    mem::strong_ptr<steady_clock> p_clock,
+    std::string_view p_name = "")
+    : m_interrupt(p_interrupt)
+    , m_profile(p_clock, p_name)
+  {
+    m_handler.m_self = this;
+  }
+
+  profiled_edge_triggered_interrupt(profiled_edge_triggered_interrupt const&) =
+    delete;
+  profiled_edge_triggered_interrupt& operator=(
+    profiled_edge_triggered_interrupt const&) = delete;
+  profiled_edge_triggered_interrupt(profiled_edge_triggered_interrupt&&) =
+    delete;
+  profiled_edge_triggered_interrupt& operator=(
+    profiled_edge_triggered_interrupt&&) = delete;
+  ~profiled_edge_triggered_interrupt() override = default;
+
+  /**
+   * @return isr_profile& - profile of the callback
+   */
+  [[nodiscard]] isr_profile& profile()
+  {
+    return m_profile;
+  }
+
+private:
+  struct edge_handler : public edge_triggered_callback
+  {
+    void callback(bool p_state) override
+    {
+      m_self->m_profile.measure(
+        [this, p_state]() { m_self->m_callback->callback(p_state); });
+    }
+    profiled_edge_triggered_interrupt* m_self = nullptr;
+  };
+
+  void driver_configure(settings const& p_settings) override
+  {
+    m_interrupt->configure(p_settings);
+  }
+
+  void driver_on_trigger(
+    mem::optional_ptr<edge_triggered_callback> p_callback) override
+  {
+    m_callback = p_callback;
+    if (not m_callback.has_value()) {
+      m_interrupt->on_trigger(nullptr);
+      return;
+    }
+    m_interrupt->on_trigger(mem::strong_ptr<edge_triggered_callback>(
+      strong_from_this(), &profiled_edge_triggered_interrupt::m_handler));
+  }
+
+  mem::strong_ptr<edge_triggered_interrupt> m_interrupt;
+  mem::optional_ptr<edge_triggered_callback> m_callback{};
+  isr_profile m_profile;
+  edge_handler m_handler{};
+};
+
+/**
+ * @brief timed_interrupt profiling the callbacks scheduled on another
+ *
+ * Besides the duration of each callback, measures its latency: the time from
+ * the scheduled expiry to the entry of the callback, which includes the time
+ * the timer interrupt was blocked by other interrupts.
+ *
+ * While a callback is scheduled, the wrapped timer holds a reference to this
+ * object.
+ */
+class profiled_timed_interrupt
+  : public timed_interrupt
+  , public mem::enable_strong_from_this<profiled_timed_interrupt>
+{
+public:
+  /**
+   * @param p_timer - timer to forward to
+   * @param p_clock - clock timestamping the calls of the callbacks
+   * @param p_name - name of the profile. Must outlive this object.
+   */
+  profiled_timed_interrupt(mem::strong_ptr<timed_interrupt> p_timer,
+                           mem::strong_ptr<steady_clock> p_clock,
+                           std::string_view p_name = "")
+    : m_timer(p_timer)
+    , m_profile(p_clock, p_name)
+  {
+    m_handler.m_self = this;
+  }
+
+  profiled_timed_interrupt(profiled_timed_interrupt const&) = delete;
+  profiled_timed_interrupt& operator=(profiled_timed_interrupt const&) =
+    delete;
+  profiled_timed_interrupt(profiled_timed_interrupt&&) = delete;
+  profiled_timed_interrupt& operator=(profiled_timed_interrupt&&) = delete;
+  ~profiled_timed_interrupt() override = default;
+
+  /**
+   * @return isr_profile& - profile of the callbacks
+   */
+  [[nodiscard]] isr_profile& profile()
+  {
+    return m_profile;
+  }
+
+  /**
+   * @return isr_statistics const& - latencies of the callbacks, in ticks of
+   * the profile's clock
+   */
+  [[nodiscard]] isr_statistics const& latency() const
+  {
+    return m_latency;
+  }
+
+private:
+  struct timer_handler : public timed_callback
+  {
+    void callback() override
+    {
+      m_self->on_expiry();
+    }
+    profiled_timed_interrupt* m_self = nullptr;
+  };
+
+  bool driver_scheduled() override
+  {
+    return m_timer->scheduled();
+  }
+
+  void driver_schedule(mem::optional_ptr<timed_callback> const& p_callback,
+                       time_duration p_delay) override
+  {
+    m_callback = p_callback;
+    if (not m_callback.has_value()) {
+      m_timer->schedule(nullptr, p_delay);
+      return;
+    }
+    auto& clock = m_profile.clock();
+    auto const delay_ticks = static_cast<u64>(
+      std::chrono::duration<double>(p_delay).count() *
+      clock.frequency().numerical_value_in(mp_units::si::hertz));
+    m_expiry = clock.uptime() + delay_ticks;
+    auto const handler = mem::strong_ptr<timed_callback>(
+      strong_from_this(), &profiled_timed_interrupt::m_handler);
+    m_timer->schedule(handler, p_delay);
+  }
+
+  void on_expiry()
+  {
+    auto const entry = m_profile.clock().uptime();
+    m_latency.add(entry > m_expiry ? entry - m_expiry : 0);
+    // The callback may schedule again, replacing m_callback
+    auto callback = m_callback;
+    if (callback.has_value()) {
+      m_profile.measure([&callback]() { callback->callback(); });
+    }
+  }
+
+  mem::strong_ptr<timed_interrupt> m_timer;
+  mem::optional_ptr<timed_callback> m_callback{};
+  isr_profile m_profile;
+  isr_statistics m_latency{};
+  timer_handler m_handler{};
+  u64 m_expiry = 0;
+};
+}  // namespace hal::inline v5
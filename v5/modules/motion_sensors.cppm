@@ -11,9 +11,9 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 
-export module hal:motion_sensors;
+export module hal.motion_sensors;
 
-export import :units;
+export import hal.units;
 
 namespace hal::inline v5 {
 
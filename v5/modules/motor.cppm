@@ -12,9 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-export module hal:motor;
+export module hal.motor;
 
-export import :units;
+export import hal.units;
 
 export namespace hal::inline v5 {
 /**
@@ -12,9 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-export module hal:power_sensors;
+export module hal.power_sensors;
 
-export import :units;
+export import hal.units;
 
 namespace hal::inline v5 {
 /**
@@ -0,0 +1,339 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+
+
+module;
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+
+export module hal.sensor_poller;
+
+export import strong_ptr;
+export import hal.units;
+
+import hal.error;
+
+export namespace hal::inline v5 {
+/**
+ * @brief A sensor read by `hal::sensor_poller`
+ *
+ * Adapts a sensor interface, such as `hal::volt_sensor` or
+ * `hal::temperature_sensor`, to a single scalar reading that the poller can
+ * compare against a change threshold.
+ */
+struct polled_sensor
+{
+  /**
+   * @brief Read the sensor
+   *
+   * @return float - the reading as a scalar, such as the numerical value of
+   * the reading in the sensor's unit, or the magnitude of a vector reading
+   */
+  virtual float sample() = 0;
+
+  /**
+   * @brief Receives each reading that changed by more than the threshold
+   *
+   * Called with the first reading, and afterwards with each reading that
+   * differs from the last reported reading by more than the threshold of the
+   * sensor's `poll_settings`.
+   *
+   * @param p_reading - the reading returned by `sample()`
+   */
+  virtual void report(float p_reading) = 0;
+
+  virtual ~polled_sensor() = default;
+};
+
+/**
+ * @brief Polling rate and change detection settings of one sensor
+ *
+ */
+struct poll_settings
+{
+  /// Period between reads while readings are changing
+  time_duration min_period{};
+  /// Longest period between reads once readings are stable. Bounds the delay
+  /// between a change and its report.
+  time_duration max_period{};
+  /// Change from the last reported reading that is reported and returns the
+  /// sensor to min_period
+  float threshold = 0.0f;
+  /// Identifier of the bus the sensor is read through. Reads of sensors on the
+  /// same bus are batched into one wake up.
+  u8 bus = 0;
+  /// Number of consecutive unchanged readings after which the period doubles
+  u8 stable_samples = 4;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  bool operator==(poll_settings const&) const = default;
+};
+
+/**
+ * @brief Counters of the work done by a sensor_poller
+ *
+ */
+struct poll_statistics
+{
+  /// Number of calls to `polled_sensor::sample()`
+  u64 reads = 0;
+  /// Number of calls to `polled_sensor::report()`
+  u64 reports = 0;
+  /// Number of calls to `poll()` that read at least one sensor
+  u64 wakeups = 0;
+  /// Number of reads made ahead of their deadline to share a wake up with
+  /// another sensor on the same bus
+  u64 batched = 0;
+
+  /**
+   * @brief Enables default comparison
+   *
+   */
+  bool operator==(poll_statistics const&) const = default;
+};
+
+/**
+ * @brief Power aware polling scheduler for sensors
+ *
+ * Sensors are registered with a fastest and slowest polling period and a
+ * change threshold. Each sensor starts at its fastest period. After
+ * `stable_samples` consecutive readings within the threshold of the last
+ * reported reading, its period doubles, up to its slowest period. A reading
+ * beyond the threshold is reported and returns the sensor to its fastest
+ * period. A sensor whose readings are static is therefore read at its slowest
+ * period, cutting bus traffic and wake ups, while a change is still reported
+ * within the slowest period.
+ *
+ * When a sensor is due, the other sensors on the same bus that are due within
+ * the batch window are read in the same wake up, so the bus, and any
+ * peripheral clock or power domain behind it, wakes once for all of them.
+ *
+ * The poller performs no timing of its own. Call `poll()` with the current
+ * time, then sleep until the returned time, for example with a
+ * `hal::timed_interrupt`:
+ *
+ * ```
+ * hal::sensor_poller<4> poller(2ms);
+ * poller.add(battery_voltage, { .min_period = 10ms,
+ *                               .max_period = 1s,
+ *                               .threshold = 0.05f,
+ *                               .bus = 0 }, now());
+ * // In the timer callback
+ * auto const next = poller.poll(now());
+ * timer->schedule(handler, next - now());
+ * ```
+ *
+ * @tparam Capacity - maximum number of sensors
+ */
+template<usize Capacity>
+class sensor_poller
+{
+public:
+  /// Returned by `deadline()` and `poll()` when no sensor is registered
+  static constexpr time_duration never = time_duration::max();
+
+  /**
+   * @brief Construct a sensor poller
+   *
+   * @param p_batch_window - how far ahead of its deadline a sensor may be read
+   * to share a wake up with another sensor on the same bus
+   */
+  explicit sensor_poller(time_duration p_batch_window)
+    : m_batch_window(p_batch_window)
+  {
+  }
+
+  sensor_poller(sensor_poller const&) = delete;
+  sensor_poller& operator=(sensor_poller const&) = delete;
+  sensor_poller(sensor_poller&&) = delete;
+  sensor_poller& operator=(sensor_poller&&) = delete;
+  ~sensor_poller() = default;
+
+  /**
+   * @brief Register a sensor
+   *
+   * The sensor is first read on the next call to `poll()`.
+   *
+   * @param p_sensor - sensor to poll
+   * @param p_settings - polling rates and change threshold of the sensor
+   * @param p_now - current time
+   * @return usize - index of the sensor, for `remove()` and `period()`
+   * @throws hal::argument_out_of_domain - if min_period is not positive,
+   * max_period is below min_period or stable_samples is 0
+   * @throws hal::out_of_range - if Capacity sensors are already registered
+   */
+  usize add(mem::strong_ptr<polled_sensor> p_sensor,
+            poll_settings const& p_settings,
+            time_duration p_now)
+  {
+    if (p_settings.min_period <= time_duration::zero() ||
+        p_settings.max_period < p_settings.min_period ||
+        p_settings.stable_samples == 0) {
+      throw hal::argument_out_of_domain(this);
+    }
+
+    auto const slot = std::ranges::find_if(
+      m_entries, [](entry const& p_entry) { return not p_entry.active(); });
+    if (slot == m_entries.end()) {
+      throw hal::out_of_range(this,
+                              { .m_index = Capacity, .m_capacity = Capacity });
+    }
+
+    *slot = entry{
+      .sensor = p_sensor,
+      .settings = p_settings,
+      .period = p_settings.min_period,
+      .next = p_now,
+    };
+    return static_cast<usize>(slot - m_entries.begin());
+  }
+
+  /**
+   * @brief Stop polling a sensor
+   *
+   * Has no effect if nothing is registered at p_index.
+   *
+   * @param p_index - index returned by `add()`
+   */
+  void remove(usize p_index)
+  {
+    if (p_index < Capacity) {
+      m_entries[p_index] = entry{};
+    }
+  }
+
+  /**
+   * @brief Read every sensor that is due
+   *
+   * @param p_now - current time
+   * @return time_duration - time of the next wake up, or `never` if no
+   * sensor is registered
+   */
+  time_duration poll(time_duration p_now)
+  {
+    std::bitset<256> active_buses;
+    bool woke = false;
+    for (auto& slot : m_entries) {
+      if (slot.active() && slot.next <= p_now) {
+        read(slot, p_now);
+        active_buses.set(slot.settings.bus);
+        woke = true;
+      }
+    }
+
+    if (woke) {
+      m_statistics.wakeups++;
+      auto const horizon = p_now + m_batch_window;
+      for (auto& slot : m_entries) {
+        if (slot.active() && slot.next > p_now && slot.next <= horizon &&
+            active_buses.test(slot.settings.bus) &&
+            slot.last_read != p_now) {
+          read(slot, p_now);
+          m_statistics.batched++;
+        }
+      }
+    }
+
+    return deadline();
+  }
+
+  /**
+   * @return time_duration - time at which the next sensor is due, or `never`
+   * if no sensor is registered
+   */
+  [[nodiscard]] time_duration deadline() const
+  {
+    auto result = never;
+    for (auto const& slot : m_entries) {
+      if (slot.active()) {
+        result = std::min(result, slot.next);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @param p_index - index returned by `add()`
+   * @return time_duration - current polling period of the sensor, or 0 if
+   * nothing is registered at p_index
+   */
+  [[nodiscard]] time_duration period(usize p_index) const
+  {
+    if (p_index >= Capacity || not m_entries[p_index].active()) {
+      return time_duration::zero();
+    }
+    return m_entries[p_index].period;
+  }
+
+  /**
+   * @return poll_statistics - counters since construction
+   */
+  [[nodiscard]] poll_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+private:
+  struct entry
+  {
+    mem::optional_ptr<polled_sensor> sensor{};
+    poll_settings settings{};
+    time_duration period{};
+    time_duration next{};
+    time_duration last_read = time_duration::min();
+    float reported = 0.0f;
+    u8 stable = 0;
+    bool has_reported = false;
+
+    [[nodiscard]] bool active() const
+    {
+      return sensor.has_value();
+    }
+  };
+
+  void read(entry& p_entry, time_duration p_now)
+  {
+    auto const reading = p_entry.sensor->sample();
+    m_statistics.reads++;
+    p_entry.last_read = p_now;
+
+    bool const changed =
+      not p_entry.has_reported ||
+      std::fabs(reading - p_entry.reported) > p_entry.settings.threshold;
+    if (changed) {
+      p_entry.reported = reading;
+      p_entry.has_reported = true;
+      p_entry.period = p_entry.settings.min_period;
+      p_entry.stable = 0;
+      m_statistics.reports++;
+      p_entry.sensor->report(reading);
+    } else if (++p_entry.stable >= p_entry.settings.stable_samples) {
+      p_entry.period =
+        std::min(p_entry.period * 2, p_entry.settings.max_period);
+      p_entry.stable = 0;
+    }
+    p_entry.next = p_now + p_entry.period;
+  }
+
+  std::array<entry, Capacity> m_entries{};
+  time_duration m_batch_window;
+  poll_statistics m_statistics{};
+};
+}  // namespace hal::inline v5
@@ -0,0 +1,152 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+
+
+module;
+
+#include <span>
+
+export module hal.serial;
+
+export import hal.units;
+export import async_context;
+
+export namespace hal::inline v5 {
+/**
+ * @brief Hardware abstraction for a serial port, such as a UART
+ *
+ * Every operation returns an `async::future` and takes the `async::context`
+ * it runs on. A driver that must wait on hardware, such as for a DMA transfer
+ * to finish or for data to arrive, suspends instead of blocking, and the
+ * coroutine frame of the operation is allocated on the stack of the context,
+ * never on the heap. Operations on different contexts interleave on a single
+ * core: while one context waits on this serial port, another can run.
+ *
+ * Drivers that can complete an operation immediately should return the result
+ * directly rather than with `co_return`, which completes the future without
+ * allocating a coroutine frame at all.
+ *
+ * Only one write and one read may be in flight at a time on a port. Calling
+ * `write()` while a previous write has not finished, or `read()` while a
+ * previous read has not finished, suspends the new operation until the
+ * previous one finishes.
+ */
+class serial
+{
+public:
+  /// Generic settings for a standard serial device.
+  struct settings
+  {
+    /// Set of available stop bits options
+    enum class stop_bits : u8
+    {
+      one = 0,
+      two,
+    };
+
+    /// Set of parity bit options
+    enum class parity : u8
+    {
+      /// Disable parity bit as part of the frame
+      none = 0,
+      /// Enable parity and set 1 (HIGH) when the number of bits is odd
+      odd,
+      /// Enable parity and set 1 (HIGH) when the number of bits is even
+      even,
+      /// Enable parity bit and always return 1 (HIGH) for ever frame
+      forced1,
+      /// Enable parity bit and always return 0 (LOW) for ever frame
+      forced0,
+    };
+
+    /// The operating speed of the baud rate (in units of bits per second)
+    u32 baud_rate = 115200;
+
+    /// Number of stop bits for each frame
+    stop_bits stop = stop_bits::one;
+
+    /// Parity bit type for each frame
+    parity parity = parity::none;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator==(settings const&) const = default;
+  };
+
+  /**
+   * @brief Configure serial to match the settings supplied
+   *
+   * Implementing drivers must verify if the settings can be applied to hardware
+   * before modifying the hardware. This will ensure that if this operation
+   * fails, the state of the serial device has not changed.
+   *
+   * @param p_context - async context for the operation
+   * @param p_settings - settings to apply to serial driver
+   * @throws hal::operation_not_supported - if the settings could not be
+   * achieved.
+   */
+  async::future<void> configure(async::context& p_context,
+                                settings const& p_settings)
+  {
+    return driver_configure(p_context, p_settings);
+  }
+
+  /**
+   * @brief Write data to the serial port
+   *
+   * The future completes once every byte of p_data has been handed to the
+   * hardware. p_data must stay valid until then.
+   *
+   * @param p_context - async context for the operation
+   * @param p_data - data to be transmitted over the serial port
+   */
+  async::future<void> write(async::context& p_context,
+                            std::span<byte const> p_data)
+  {
+    return driver_write(p_context, p_data);
+  }
+
+  /**
+   * @brief Read data received by the serial port
+   *
+   * The future completes once at least one byte has been received, with as
+   * many received bytes as fit in p_buffer. Completing on the first bytes,
+   * rather than once p_buffer is full, keeps a protocol with variable length
+   * messages from waiting on bytes that may never arrive. Returns an empty
+   * span immediately if p_buffer is empty.
+   *
+   * @param p_context - async context for the operation
+   * @param p_buffer - buffer to read received bytes into. Must stay valid until
+   * the future completes.
+   * @return async::future<std::span<byte>> - the filled front of p_buffer
+   */
+  async::future<std::span<byte>> read(async::context& p_context,
+                                      std::span<byte> p_buffer)
+  {
+    return driver_read(p_context, p_buffer);
+  }
+
+  virtual ~serial() = default;
+
+private:
+  virtual async::future<void> driver_configure(async::context& p_context,
+                                               settings const& p_settings) = 0;
+  virtual async::future<void> driver_write(async::context& p_context,
+                                           std::span<byte const> p_data) = 0;
+  virtual async::future<std::span<byte>> driver_read(
+    async::context& p_context,
+    std::span<byte> p_buffer) = 0;
+};
+}  // namespace hal::inline v5
@@ -11,9 +11,18 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 
-export module hal:servo;
+module;
 
-export import :units;
+#include <limits>
+#include <span>
+
+export module hal.servo;
+
+export import strong_ptr;
+export import hal.units;
+
+import hal.error;
+import hal.steady_clock;
 
 export namespace hal {
 /**
@@ -56,6 +65,19 @@ private:
 }  // namespace hal
 
 export namespace hal::inline v5 {
+/**
+ * @brief Feedback of a servo, as reported by a single status transaction
+ *
+ * Fields the servo cannot measure are 0.
+ */
+struct servo_feedback
+{
+  degrees position;     ///< Current position in degrees
+  rpm velocity;         ///< Current velocity in RPM
+  newton_meter torque;  ///< Current torque in newton meters
+  bool moving;          ///< true if the servo is in motion
+};
+
 /**
  * @brief Interface for the most basic of servos, devices that can be instructed
  * to move to a specific location and hold their position.
@@ -151,9 +173,37 @@ public:
     return driver_is_moving();
   }
 
+  /**
+   * @brief Read every feedback field of the servo at once
+   *
+   * Servos usually report their position, velocity, torque and motion in a
+   * single status packet. Drivers should override this to fetch every field
+   * with one bus transaction, where calling `position()`, `is_moving()` and
+   * `status()` costs one transaction each. Use `hal::cached_feedback` to share
+   * one read between several queries.
+   *
+   * The default implementation calls `position()` and `is_moving()` and
+   * reports a velocity and torque of 0.
+   *
+   * @return servo_feedback - current feedback of the servo
+   */
+  [[nodiscard]] servo_feedback feedback()
+  {
+    return driver_feedback();
+  }
+
 private:
   virtual degrees driver_get_position() = 0;
   virtual bool driver_is_moving() = 0;
+  virtual servo_feedback driver_feedback()
+  {
+    return {
+      .position = driver_get_position(),
+      .velocity = rpm::zero(),
+      .torque = newton_meter::zero(),
+      .moving = driver_is_moving(),
+    };
+  }
 };
 
 /**
@@ -397,4 +447,206 @@ private:
   virtual status_t driver_status() = 0;
   virtual range_t driver_range() = 0;
 };
+
+/**
+ * @brief Interface for a group of servos commanded and read together
+ *
+ * Commanding each servo of a multi-actuator system, such as a 12 servo robot,
+ * through its own interface costs a bus transaction per servo, and the servos
+ * receive their commands at different times. Drivers of this interface send
+ * the commands of every servo in the group in a single broadcast, such as a
+ * Dynamixel SYNC_WRITE or a single CAN frame addressed to the group, so every
+ * servo applies its command at the same time. The status of every servo is
+ * likewise read back with a single bulk read.
+ *
+ * Element `i` of each span corresponds to servo `i` of the group, in the order
+ * documented by the implementation.
+ */
+class servo_group
+{
+public:
+  /**
+   * @brief Command for one servo of the group
+   *
+   * Servos that cannot control velocity or torque ignore those fields and use
+   * their intrinsic or configured values.
+   */
+  struct command_t
+  {
+    degrees position;     ///< Target position in degrees
+    rpm velocity;         ///< Velocity to move to the target at, in RPM
+    newton_meter torque;  ///< Torque limit in newton meters
+  };
+
+  /// Status of one servo of the group
+  using status_t = servo_feedback;
+
+  virtual ~servo_group() = default;
+
+  /**
+   * @brief Get the number of servos in the group
+   *
+   * @return usize - number of servos, which is the size that spans passed to
+   * `command()` and `status()` must have
+   */
+  [[nodiscard]] usize size()
+  {
+    return driver_size();
+  }
+
+  /**
+   * @brief Send a command to every servo of the group in one broadcast
+   *
+   * @param p_commands - one command per servo of the group
+   * @throws hal::argument_out_of_domain - if the number of commands is not
+   * equal to `size()` or a command is outside of the range of its servo. When
+   * this error occurs, no servo receives a command.
+   */
+  void command(std::span<command_t const> p_commands)
+  {
+    return driver_command(p_commands);
+  }
+
+  /**
+   * @brief Read the status of every servo of the group in one bulk read
+   *
+   * @param p_status - receives the status of each servo of the group
+   * @throws hal::argument_out_of_domain - if the size of p_status is not equal
+   * to `size()`.
+   */
+  void status(std::span<status_t> p_status)
+  {
+    return driver_status(p_status);
+  }
+
+private:
+  virtual usize driver_size() = 0;
+  virtual void driver_command(std::span<command_t const> p_commands) = 0;
+  virtual void driver_status(std::span<status_t> p_status) = 0;
+};
+
+/**
+ * @brief Cache of a servo's feedback with a freshness window
+ *
+ * A control loop often queries the position, velocity and motion of a servo
+ * several times per tick. This class reads every field with a single
+ * `feedback_servo::feedback()` call and serves further queries from the
+ * snapshot until it is older than the freshness window, so repeated queries
+ * within a control tick cost no bus transactions.
+ *
+ * Example usage:
+ *
+ * ```
+ * hal::cached_feedback joint(servo, clock, 1ms);
+ * auto const error = target - joint.position();
+ * if (not joint.feedback().moving) {
+ *   // ...
+ * }
+ * ```
+ */
+class cached_feedback
+{
+public:
+  /**
+   * @brief Construct a cache over a servo
+   *
+   * @param p_servo - servo to read feedback from
+   * @param p_clock - clock used to measure the age of the snapshot
+   * @param p_freshness - maximum age of a snapshot before it is read again. A
+   * value of 0 reads the servo on every query.
+   * @throws hal::argument_out_of_domain - if p_freshness is negative
+   */
+  cached_feedback(mem::strong_ptr<feedback_servo> p_servo,
+                  mem::strong_ptr<steady_clock> p_clock,
+                  time_duration p_freshness)
+    : m_servo(p_servo)
+    , m_clock(p_clock)
+  {
+    if (p_freshness < time_duration::zero()) {
+      throw hal::argument_out_of_domain(this);
+    }
+    constexpr u64 nanoseconds_per_second = 1'000'000'000;
+    auto const frequency = static_cast<u64>(
+      m_clock->frequency().numerical_value_in(mp_units::si::hertz));
+    auto const nanoseconds = static_cast<u64>(p_freshness.count());
+    auto const seconds = nanoseconds / nanoseconds_per_second;
+    auto const remainder = nanoseconds % nanoseconds_per_second;
+    // Whole seconds and the remainder are converted separately, so the
+    // remainder product stays below 1e9 * 2^32. Windows too long to count in
+    // ticks saturate.
+    constexpr auto max_ticks = std::numeric_limits<u64>::max();
+    auto const fraction = remainder * frequency / nanoseconds_per_second;
+    if (frequency != 0 && seconds > (max_ticks - fraction) / frequency) {
+      m_freshness_ticks = max_ticks;
+    } else {
+      m_freshness_ticks = seconds * frequency + fraction;
+    }
+  }
+
+  /**
+   * @brief Get the feedback of the servo, reading it if the snapshot is stale
+   *
+   * @return servo_feedback - snapshot of the servo's feedback
+   */
+  [[nodiscard]] servo_feedback feedback()
+  {
+    auto const now = m_clock->uptime();
+    if (not m_valid || m_freshness_ticks == 0 ||
+        now - m_timestamp > m_freshness_ticks) {
+      m_snapshot = m_servo->feedback();
+      m_timestamp = now;
+      m_valid = true;
+    }
+    return m_snapshot;
+  }
+
+  /**
+   * @brief Get the position of the servo from the snapshot
+   *
+   * @return degrees - position of the servo
+   */
+  [[nodiscard]] degrees position()
+  {
+    return feedback().position;
+  }
+
+  /**
+   * @brief Get the velocity of the servo from the snapshot
+   *
+   * @return rpm - velocity of the servo
+   */
+  [[nodiscard]] rpm velocity()
+  {
+    return feedback().velocity;
+  }
+
+  /**
+   * @brief Determine if the servo is moving from the snapshot
+   *
+   * @return true if the servo is in motion, false if stationary
+   */
+  [[nodiscard]] bool is_moving()
+  {
+    return feedback().moving;
+  }
+
+  /**
+   * @brief Discard the snapshot, so the next query reads the servo
+   *
+   * Call this after commanding the servo, if the next query must reflect the
+   * command.
+   */
+  void invalidate()
+  {
+    m_valid = false;
+  }
+
+private:
+  mem::strong_ptr<feedback_servo> m_servo;
+  mem::strong_ptr<steady_clock> m_clock;
+  servo_feedback m_snapshot{};
+  u64 m_freshness_ticks = 0;
+  u64 m_timestamp = 0;
+  bool m_valid = false;
+};
 }  // namespace hal::inline v5
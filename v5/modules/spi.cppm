@@ -0,0 +1,159 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+
+
+module;
+
+#include <span>
+
+export module hal.spi;
+
+export import hal.units;
+export import async_context;
+
+using namespace mp_units::si::unit_symbols;
+
+export namespace hal::inline v5 {
+/**
+ * @brief Serial peripheral interface (SPI) communication protocol hardware
+ * abstraction interface
+ *
+ * A spi channel is a view of a spi bus along with the chip select of one of
+ * the devices on it. Transfers are 8-bit words, MSB first, as with v4's
+ * `hal::spi_channel`.
+ *
+ * Every operation returns an `async::future` and takes the `async::context`
+ * it runs on. A transfer that waits on the bus or on DMA suspends rather than
+ * blocking, with its coroutine frame allocated on the stack of the context
+ * instead of the heap, so transfers of several contexts interleave on a single
+ * core.
+ *
+ * ## Chip select as bus access control
+ *
+ * `chip_select(true)` gains exclusive access to the bus for this channel,
+ * configures the bus to this channel's settings, and asserts its chip select.
+ * When another channel of the same bus holds the bus, the future suspends
+ * until the bus is released with `chip_select(false)`, instead of blocking the
+ * core. A transfer made without holding the bus acquires and releases it
+ * around the transfer.
+ */
+class spi_channel
+{
+public:
+  /// Default filler data placed on the bus in place of actual write data when
+  /// the write buffer has been exhausted.
+  static constexpr byte default_filler = byte{ 0xFF };
+
+  /**
+   * @brief Mode settings which control when data is sampled and shifted out
+   *
+   */
+  enum class mode : u8
+  {
+    /// CPOL 0, CPHA 0: data sampled on rising SCLK
+    m0,
+    /// CPOL 0, CPHA 1: data sampled on falling SCLK
+    m1,
+    /// CPOL 1, CPHA 0: data sampled on falling SCLK
+    m2,
+    /// CPOL 1, CPHA 1: data sampled on rising SCLK
+    m3,
+  };
+
+  /**
+   * @brief Generic settings for a standard SPI device.
+   *
+   */
+  struct settings
+  {
+    /// Best-effort clock rate of the bus. The bus runs at the fastest rate it
+    /// can reach that does not exceed this value.
+    hertz clock_rate = 100 * kHz;
+
+    /// Selects how the spi data and clock are sampled
+    mode bus_mode = mode::m0;
+
+    /**
+     * @brief Enables default comparison
+     *
+     */
+    bool operator==(settings const&) const = default;
+  };
+
+  /**
+   * @brief Set the spi settings for this channel
+   *
+   * The settings are stored by the implementation and applied to the bus when
+   * this channel acquires it.
+   *
+   * @param p_context - async context for the operation
+   * @param p_settings - settings to configure the spi bus to when control is
+   * acquired by this channel.
+   * @throws hal::operation_not_supported - if the mode cannot be accommodated
+   * by the spi bus hardware or implementation of spi.
+   */
+  async::future<void> configure(async::context& p_context,
+                                settings const& p_settings)
+  {
+    return driver_configure(p_context, p_settings);
+  }
+
+  /**
+   * @brief Control both chip select & exclusive access to the spi bus
+   *
+   * @param p_context - async context for the operation
+   * @param p_select - if set to true, completes once this channel has exclusive
+   * access to the spi bus and its chip select is asserted. When set to false,
+   * de-asserts chip select and releases the bus, resuming the next channel
+   * waiting on it. Releasing a bus that this channel does not hold does
+   * nothing.
+   */
+  async::future<void> chip_select(async::context& p_context, bool p_select)
+  {
+    return driver_chip_select(p_context, p_select);
+  }
+
+  /**
+   * @brief Send and receive data between a selected device on the spi bus
+   *
+   * @param p_context - async context for the operation
+   * @param p_data_out - buffer to write data to the bus. If its length is less
+   * than p_data_in, then p_filler is written to the bus after it has been
+   * sent. Must stay valid until the future completes.
+   * @param p_data_in - buffer to read the data off of the bus. If its length is
+   * less than p_data_out, the rest of the received bytes are dropped. Must stay
+   * valid until the future completes.
+   * @param p_filler - filler data placed on the bus in place of actual write
+   * data when p_data_out has been exhausted.
+   */
+  async::future<void> transfer(async::context& p_context,
+                               std::span<byte const> p_data_out,
+                               std::span<byte> p_data_in = {},
+                               byte p_filler = default_filler)
+  {
+    return driver_transfer(p_context, p_data_out, p_data_in, p_filler);
+  }
+
+  virtual ~spi_channel() = default;
+
+private:
+  virtual async::future<void> driver_configure(async::context& p_context,
+                                               settings const& p_settings) = 0;
+  virtual async::future<void> driver_chip_select(async::context& p_context,
+                                                 bool p_select) = 0;
+  virtual async::future<void> driver_transfer(async::context& p_context,
+                                              std::span<byte const> p_data_out,
+                                              std::span<byte> p_data_in,
+                                              byte p_filler) = 0;
+};
+}  // namespace hal::inline v5
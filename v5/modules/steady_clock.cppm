@@ -11,9 +11,9 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 
-export module hal:steady_clock;
+export module hal.steady_clock;
 
-export import :units;
+export import hal.units;
 
 export namespace hal {
 /**
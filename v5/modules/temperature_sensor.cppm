@@ -11,7 +11,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 
-export module hal:temperature_sensor;
+export module hal.temperature_sensor;
 
 export import mp_units;
 
@@ -17,7 +17,7 @@ module;
 #include <chrono>
 #include <cstdint>
 
-export module hal:units;
+export module hal.units;
 
 export import mp_units;
 
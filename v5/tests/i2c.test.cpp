@@ -0,0 +1,90 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <span>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+import hal;
+import async_context;
+
+namespace {
+class test_i2c : public hal::i2c
+{
+public:
+  settings m_settings{};
+  hal::byte m_address = 0;
+  std::vector<hal::byte> m_written;
+  hal::byte m_register_value = 0;
+
+private:
+  async::future<void> driver_configure(async::context&,
+                                       settings const& p_settings) override
+  {
+    m_settings = p_settings;
+    return {};
+  }
+
+  async::future<void> driver_transaction(
+    async::context&,
+    hal::byte p_address,
+    std::span<hal::byte const> p_data_out,
+    std::span<hal::byte> p_data_in) override
+  {
+    m_address = p_address;
+    m_written.assign(p_data_out.begin(), p_data_out.end());
+    std::ranges::fill(p_data_in, m_register_value);
+    return {};
+  }
+};
+
+boost::ut::suite<"hal::i2c"> i2c_test = []() {
+  using namespace boost::ut;
+
+  "::configure()"_test = []() {
+    // Setup
+    using namespace mp_units::si::unit_symbols;
+    async::basic_context<1024> ctx;
+    test_i2c test;
+    hal::i2c::settings const expected{ .clock_rate = 400 * kHz };
+
+    // Exercise
+    test.configure(ctx, expected);
+
+    // Verify
+    expect(expected == test.m_settings);
+  };
+
+  "::transaction() write then read"_test = []() {
+    // Setup
+    async::basic_context<1024> ctx;
+    test_i2c test;
+    test.m_register_value = 0x42;
+    std::array<hal::byte, 1> const register_address{ 0x0F };
+    std::array<hal::byte, 2> data_in{};
+
+    // Exercise
+    test.transaction(ctx, 0x68, register_address, data_in);
+
+    // Verify
+    expect(that % 0x68 == test.m_address);
+    expect(std::ranges::equal(register_address, test.m_written));
+    expect(std::array<hal::byte, 2>{ 0x42, 0x42 } == data_in);
+  };
+};
+}  // namespace
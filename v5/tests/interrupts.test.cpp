@@ -137,4 +137,98 @@ boost::ut::suite<"hal::timed_interrupt"> timed_interrupt_test = []() {
   };
 };
 
+class test_edge_interrupt : public hal::edge_triggered_interrupt
+{
+public:
+  settings stored_settings{};
+  mem::optional_ptr<hal::edge_triggered_callback> stored_callback;
+
+  void edge(bool p_state)
+  {
+    stored_callback.value()->callback(p_state);
+  }
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    stored_settings = p_settings;
+  }
+
+  void driver_on_trigger(
+    mem::optional_ptr<hal::edge_triggered_callback> p_callback) override
+  {
+    stored_callback = p_callback;
+  }
+};
+
+class test_input_pin : public hal::input_pin
+{
+public:
+  bool pin_level = false;
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  bool driver_level() override
+  {
+    return pin_level;
+  }
+};
+
+class test_edge_callback : public hal::edge_triggered_callback
+{
+public:
+  int call_count = 0;
+  bool last_state = false;
+
+  void callback(bool p_state) override
+  {
+    call_count++;
+    last_state = p_state;
+  }
+};
+
+boost::ut::suite<"hal::debounced_interrupt"> debounced_interrupt_test = []() {
+  using namespace boost::ut;
+
+  "::on_trigger() - forwards only settled transitions"_test = []() {
+    // Setup
+    auto* resource = std::pmr::new_delete_resource();
+    auto interrupt = mem::make_strong_ptr<test_edge_interrupt>(resource);
+    auto pin = mem::make_strong_ptr<test_input_pin>(resource);
+    auto timer = mem::make_strong_ptr<test_timed_interrupt>(resource);
+    auto callback = mem::make_strong_ptr<test_edge_callback>(resource);
+    hal::time_duration const window{ 5'000'000 };
+    auto button = mem::make_strong_ptr<hal::debounced_interrupt>(
+      resource, interrupt, pin, timer, window);
+    button->configure({ .trigger = hal::edge_trigger::rising });
+    button->on_trigger(callback);
+
+    // Exercise
+    pin->pin_level = true;
+    interrupt->edge(true);
+    auto const masked = not interrupt->stored_callback.has_value();
+    timer->stored_callback.value()->callback();
+    interrupt->edge(false);
+    timer->stored_callback.value()->callback();
+    pin->pin_level = false;
+    interrupt->edge(false);
+    timer->stored_callback.value()->callback();
+    button->on_trigger(nullptr);
+
+    // Verify
+    expect(hal::edge_trigger::both == interrupt->stored_settings.trigger);
+    expect(masked);
+    expect(that % window == timer->stored_delay);
+    expect(that % 1 == callback->call_count);
+    expect(callback->last_state);
+    expect(that % 1 == button->statistics().forwarded);
+    expect(that % 1 == button->statistics().suppressed);
+    expect(!interrupt->stored_callback.has_value());
+    expect(!timer->is_scheduled);
+  };
+};
+
 }  // namespace
@@ -0,0 +1,218 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <array>
+#include <memory_resource>
+
+#include <boost/ut.hpp>
+
+import hal;
+
+namespace {
+/// Steady clock at 1 MHz advanced by hand
+class test_clock : public hal::steady_clock
+{
+public:
+  hal::u64 m_uptime = 0;
+
+private:
+  hal::hertz driver_frequency() override
+  {
+    using namespace mp_units::si::unit_symbols;
+    return 1 * MHz;
+  }
+
+  hal::u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+};
+
+class test_edge_interrupt : public hal::edge_triggered_interrupt
+{
+public:
+  settings m_settings{};
+  mem::optional_ptr<hal::edge_triggered_callback> m_callback{};
+
+private:
+  void driver_configure(settings const& p_settings) override
+  {
+    m_settings = p_settings;
+  }
+
+  void driver_on_trigger(
+    mem::optional_ptr<hal::edge_triggered_callback> p_callback) override
+  {
+    m_callback = p_callback;
+  }
+};
+
+class test_timed_interrupt : public hal::timed_interrupt
+{
+public:
+  mem::optional_ptr<hal::timed_callback> m_callback{};
+  hal::time_duration m_delay{ 0 };
+
+private:
+  bool driver_scheduled() override
+  {
+    return m_callback.has_value();
+  }
+
+  void driver_schedule(mem::optional_ptr<hal::timed_callback> const& p_callback,
+                       hal::time_duration p_delay) override
+  {
+    m_callback = p_callback;
+    m_delay = p_delay;
+  }
+};
+
+/// Callback advancing the clock by a fixed number of ticks when called
+class busy_edge_callback : public hal::edge_triggered_callback
+{
+public:
+  explicit busy_edge_callback(mem::strong_ptr<test_clock> p_clock)
+    : m_clock(p_clock)
+  {
+  }
+
+  void callback(bool p_state) override
+  {
+    calls++;
+    m_clock->m_uptime += p_state ? 3 : 8;
+  }
+
+  mem::strong_ptr<test_clock> m_clock;
+  int calls = 0;
+};
+
+class busy_timed_callback : public hal::timed_callback
+{
+public:
+  explicit busy_timed_callback(mem::strong_ptr<test_clock> p_clock)
+    : m_clock(p_clock)
+  {
+  }
+
+  void callback() override
+  {
+    calls++;
+    m_clock->m_uptime += 4;
+  }
+
+  mem::strong_ptr<test_clock> m_clock;
+  int calls = 0;
+};
+
+boost::ut::suite<"hal::isr_profiler"> isr_profiler_test = []() {
+  using namespace boost::ut;
+  using namespace std::chrono_literals;
+
+  "edge triggered callbacks are forwarded and timed"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource);
+    auto interrupt = mem::make_strong_ptr<test_edge_interrupt>(resource);
+    auto handler = mem::make_strong_ptr<busy_edge_callback>(resource, clock);
+    auto test = mem::make_strong_ptr<hal::profiled_edge_triggered_interrupt>(
+      resource, interrupt, clock, "button");
+    test->configure({ .trigger = hal::edge_trigger::both });
+
+    // Exercise
+    test->on_trigger(handler);
+    interrupt->m_callback->callback(true);
+    interrupt->m_callback->callback(false);
+
+    // Verify
+    auto const& statistics = test->profile().statistics();
+    expect(hal::edge_trigger::both == interrupt->m_settings.trigger);
+    expect(that % 2 == handler->calls);
+    expect(that % 2 == statistics.count);
+    expect(that % 3 == statistics.min);
+    expect(that % 8 == statistics.max);
+    expect(that % 11 == statistics.total);
+    expect(that % 1 == statistics.histogram[2]) << "3 is in [2, 4)";
+    expect(that % 1 == statistics.histogram[4]) << "8 is in [8, 16)";
+    expect("button" == test->profile().name());
+  };
+
+  "clearing the callback releases the wrapped interrupt"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource);
+    auto interrupt = mem::make_strong_ptr<test_edge_interrupt>(resource);
+    auto handler = mem::make_strong_ptr<busy_edge_callback>(resource, clock);
+    auto test = mem::make_strong_ptr<hal::profiled_edge_triggered_interrupt>(
+      resource, interrupt, clock);
+    test->on_trigger(handler);
+
+    // Exercise
+    test->on_trigger(nullptr);
+
+    // Verify
+    expect(not interrupt->m_callback.has_value());
+  };
+
+  "timed callbacks are timed with their latency"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource);
+    auto timer = mem::make_strong_ptr<test_timed_interrupt>(resource);
+    auto handler = mem::make_strong_ptr<busy_timed_callback>(resource, clock);
+    auto test = mem::make_strong_ptr<hal::profiled_timed_interrupt>(
+      resource, timer, clock, "tick");
+    clock->m_uptime = 1'000;
+
+    // Exercise
+    test->schedule(handler, 100us);
+    auto const scheduled = test->scheduled();
+    // Serviced 6us late, as if blocked by another interrupt
+    clock->m_uptime = 1'106;
+    timer->m_callback->callback();
+
+    // Verify
+    expect(scheduled);
+    expect(that % 100'000 == timer->m_delay.count());
+    expect(that % 1 == handler->calls);
+    expect(that % 4 == test->profile().statistics().max);
+    expect(that % 1 == test->latency().count);
+    expect(that % 6 == test->latency().max);
+  };
+
+  "worst_case finds the profile blocking the longest"_test = []() {
+    // Setup
+    auto clock =
+      mem::make_strong_ptr<test_clock>(std::pmr::new_delete_resource());
+    hal::isr_profile fast(clock, "fast");
+    hal::isr_profile slow(clock, "slow");
+    hal::isr_profile idle(clock, "idle");
+    std::array<hal::isr_profile const*, 4> const profiles{
+      &fast, nullptr, &slow, &idle
+    };
+
+    // Exercise
+    auto const none = hal::worst_case(profiles);
+    fast.measure([&clock]() { clock->m_uptime += 2; });
+    fast.measure([&clock]() { clock->m_uptime += 2; });
+    slow.measure([&clock]() { clock->m_uptime += 7; });
+    auto const worst = hal::worst_case(profiles);
+
+    // Verify
+    expect(none == nullptr);
+    expect(worst == &slow);
+    expect(that % 4 == fast.statistics().total);
+    fast.reset();
+    expect(hal::isr_statistics{} == fast.statistics());
+  };
+};
+}  // namespace
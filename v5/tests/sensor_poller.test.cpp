@@ -0,0 +1,160 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory_resource>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+import hal;
+
+namespace {
+using namespace std::chrono_literals;
+
+class test_sensor : public hal::polled_sensor
+{
+public:
+  float value = 0.0f;
+  int reads = 0;
+  std::vector<float> reports;
+
+  float sample() override
+  {
+    reads++;
+    return value;
+  }
+
+  void report(float p_reading) override
+  {
+    reports.push_back(p_reading);
+  }
+};
+
+/// Poll at every deadline before p_end, returning the first deadline after
+hal::time_duration run_until(hal::sensor_poller<4>& p_poller,
+                             hal::time_duration p_next,
+                             hal::time_duration p_end)
+{
+  while (p_next < p_end) {
+    p_next = p_poller.poll(p_next);
+  }
+  return p_next;
+}
+
+boost::ut::suite<"hal::sensor_poller"> sensor_poller_test = []() {
+  using namespace boost::ut;
+
+  "stable readings back off to the slowest period"_test = []() {
+    // Setup
+    auto* resource = std::pmr::new_delete_resource();
+    auto sensor = mem::make_strong_ptr<test_sensor>(resource);
+    hal::sensor_poller<4> poller(0ms);
+    auto const index = poller.add(sensor,
+                                  { .min_period = 10ms,
+                                    .max_period = 80ms,
+                                    .threshold = 0.5f,
+                                    .stable_samples = 2 },
+                                  0ms);
+
+    // Exercise
+    run_until(poller, 0ms, 1s);
+
+    // Verify
+    expect(80ms == poller.period(index));
+    expect(that % 1 == sensor->reports.size()) << "Only the first reading";
+    expect(that % sensor->reads < 20) << "Far fewer than 100 reads at 10ms";
+  };
+
+  "a change is reported within the slowest period"_test = []() {
+    // Setup
+    auto* resource = std::pmr::new_delete_resource();
+    auto sensor = mem::make_strong_ptr<test_sensor>(resource);
+    hal::sensor_poller<4> poller(0ms);
+    auto const index = poller.add(sensor,
+                                  { .min_period = 10ms,
+                                    .max_period = 80ms,
+                                    .threshold = 0.5f,
+                                    .stable_samples = 2 },
+                                  0ms);
+    auto const read_at = run_until(poller, 0ms, 1s);
+    auto const period_when_stable = poller.period(index);
+
+    // Exercise
+    sensor->value = 0.4f;
+    auto const next_read = poller.poll(read_at);
+    auto const small_changes = sensor->reports.size();
+    // Change just after a read, the longest possible wait for the next one
+    auto const changed_at = read_at + 1ms;
+    sensor->value = 2.0f;
+    poller.poll(next_read);
+
+    // Verify
+    expect(80ms == period_when_stable);
+    expect(that % 1 == small_changes) << "Changes within the threshold";
+    expect(that % 2 == sensor->reports.size());
+    expect(that % 2.0f == sensor->reports.back());
+    expect(next_read - changed_at < period_when_stable) << "Latency bound";
+    expect(10ms == poller.period(index));
+  };
+
+  "sensors on the same bus share a wake up"_test = []() {
+    // Setup
+    auto* resource = std::pmr::new_delete_resource();
+    auto first = mem::make_strong_ptr<test_sensor>(resource);
+    auto second = mem::make_strong_ptr<test_sensor>(resource);
+    auto other_bus = mem::make_strong_ptr<test_sensor>(resource);
+    hal::sensor_poller<4> poller(2ms);
+    hal::poll_settings const fixed{ .min_period = 10ms, .max_period = 10ms };
+    poller.add(first, fixed, 0ms);
+    poller.add(second, fixed, 1ms);
+    auto bus_1 = fixed;
+    bus_1.bus = 1;
+    poller.add(other_bus, bus_1, 1ms);
+
+    // Exercise
+    auto const next = poller.poll(0ms);
+
+    // Verify
+    expect(that % 1 == first->reads);
+    expect(that % 1 == second->reads) << "Read early with the first sensor";
+    expect(that % 0 == other_bus->reads) << "Other buses are not batched";
+    expect(1ms == next);
+    expect(hal::poll_statistics{
+             .reads = 2, .reports = 2, .wakeups = 1, .batched = 1 } ==
+           poller.statistics());
+  };
+
+  "invalid settings and a full poller are rejected"_test = []() {
+    // Setup
+    auto* resource = std::pmr::new_delete_resource();
+    auto sensor = mem::make_strong_ptr<test_sensor>(resource);
+    hal::sensor_poller<1> poller(0ms);
+    hal::poll_settings const valid{ .min_period = 1ms, .max_period = 1ms };
+
+    // Exercise & Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      poller.add(sensor, { .min_period = 2ms, .max_period = 1ms }, 0ms);
+    }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { poller.add(sensor, { .max_period = 1ms }, 0ms); }));
+    expect(that % 0 == poller.add(sensor, valid, 0ms));
+    expect(throws<hal::out_of_range>(
+      [&]() { poller.add(sensor, valid, 0ms); }));
+    poller.remove(0);
+    expect(hal::sensor_poller<1>::never == poller.deadline());
+    expect(nothrow([&]() { poller.add(sensor, valid, 0ms); }));
+  };
+};
+}  // namespace
@@ -0,0 +1,101 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <span>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+import hal;
+import async_context;
+
+namespace {
+class test_serial : public hal::serial
+{
+public:
+  settings m_settings{};
+  std::vector<hal::byte> m_written;
+  std::span<hal::byte const> m_received;
+
+private:
+  async::future<void> driver_configure(async::context&,
+                                       settings const& p_settings) override
+  {
+    m_settings = p_settings;
+    return {};
+  }
+
+  async::future<void> driver_write(async::context&,
+                                   std::span<hal::byte const> p_data) override
+  {
+    m_written.insert(m_written.end(), p_data.begin(), p_data.end());
+    return {};
+  }
+
+  async::future<std::span<hal::byte>> driver_read(
+    async::context&,
+    std::span<hal::byte> p_buffer) override
+  {
+    auto const count = std::min(p_buffer.size(), m_received.size());
+    std::copy_n(m_received.begin(), count, p_buffer.begin());
+    m_received = m_received.subspan(count);
+    return p_buffer.first(count);
+  }
+};
+
+boost::ut::suite<"hal::serial"> serial_test = []() {
+  using namespace boost::ut;
+
+  "::configure() & ::write()"_test = []() {
+    // Setup
+    async::basic_context<1024> ctx;
+    test_serial test;
+    hal::serial::settings const expected{
+      .baud_rate = 9600,
+      .stop = hal::serial::settings::stop_bits::two,
+      .parity = hal::serial::settings::parity::even,
+    };
+    std::array<hal::byte, 3> const data{ 0xA5, 0x00, 0x5A };
+
+    // Exercise
+    test.configure(ctx, expected);
+    test.write(ctx, data);
+
+    // Verify
+    expect(expected == test.m_settings);
+    expect(std::ranges::equal(data, test.m_written));
+  };
+
+  "::read() completes with the received bytes"_test = []() {
+    // Setup
+    async::basic_context<1024> ctx;
+    test_serial test;
+    std::array<hal::byte, 2> const received{ 0x10, 0x20 };
+    test.m_received = received;
+    std::array<hal::byte, 8> buffer{};
+
+    // Exercise
+    auto result = test.read(ctx, buffer);
+
+    // Verify
+    expect(that % result.has_value());
+    expect(that % 2 == result.value().size());
+    expect(that % buffer.data() == result.value().data());
+    expect(std::ranges::equal(received, result.value()));
+  };
+};
+}  // namespace
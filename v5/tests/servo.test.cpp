@@ -0,0 +1,339 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <span>
+#include <memory_resource>
+
+#include <boost/ut.hpp>
+
+import hal;
+import hal.servo;
+import hal.steady_clock;
+
+namespace {
+using namespace std::chrono_literals;
+using namespace mp_units::si::unit_symbols;
+
+/// Steady clock advanced by hand
+class test_clock : public hal::steady_clock
+{
+public:
+  explicit test_clock(hal::hertz p_frequency)
+    : m_frequency(p_frequency)
+  {
+  }
+
+  hal::u64 m_uptime = 0;
+
+private:
+  hal::hertz driver_frequency() override
+  {
+    return m_frequency;
+  }
+
+  hal::u64 driver_uptime() override
+  {
+    return m_uptime;
+  }
+
+  hal::hertz m_frequency;
+};
+
+/// Feedback servo without a feedback() override, counting its reads
+class test_feedback_servo : public hal::feedback_servo
+{
+public:
+  hal::degrees m_position = 0.0f * deg;
+  bool m_moving = false;
+  int m_position_reads = 0;
+  int m_moving_reads = 0;
+
+private:
+  void driver_enable(bool) override
+  {
+  }
+
+  void driver_position(hal::degrees p_position) override
+  {
+    m_position = p_position;
+  }
+
+  position_range_t driver_position_range() override
+  {
+    return { .min = -90.0f * deg, .max = 90.0f * deg };
+  }
+
+  hal::degrees driver_get_position() override
+  {
+    m_position_reads++;
+    return m_position;
+  }
+
+  bool driver_is_moving() override
+  {
+    m_moving_reads++;
+    return m_moving;
+  }
+};
+
+/// Group of three servos broadcasting commands as a single packet
+class test_servo_group : public hal::servo_group
+{
+public:
+  std::array<command_t, 3> m_servos{};
+  hal::degrees m_max = 90.0f * deg;
+  int m_broadcasts = 0;
+  int m_bulk_reads = 0;
+
+private:
+  hal::usize driver_size() override
+  {
+    return m_servos.size();
+  }
+
+  void driver_command(std::span<command_t const> p_commands) override
+  {
+    if (p_commands.size() != m_servos.size()) {
+      throw hal::argument_out_of_domain(this);
+    }
+    // Validate every command before any is sent, so a bad command leaves
+    // every servo of the group untouched
+    for (auto const& command : p_commands) {
+      if (command.position > m_max || command.position < -m_max) {
+        throw hal::argument_out_of_domain(this);
+      }
+    }
+    std::ranges::copy(p_commands, m_servos.begin());
+    m_broadcasts++;
+  }
+
+  void driver_status(std::span<status_t> p_status) override
+  {
+    if (p_status.size() != m_servos.size()) {
+      throw hal::argument_out_of_domain(this);
+    }
+    for (hal::usize i = 0; i < m_servos.size(); i++) {
+      p_status[i] = {
+        .position = m_servos[i].position,
+        .velocity = m_servos[i].velocity,
+        .torque = m_servos[i].torque,
+        .moving = false,
+      };
+    }
+    m_bulk_reads++;
+  }
+};
+
+boost::ut::suite<"hal::cached_feedback"> cached_feedback_test = []() {
+  using namespace boost::ut;
+
+  "default feedback() is built from position() and is_moving()"_test = []() {
+    // Setup
+    test_feedback_servo test;
+    test.m_position = 30.0f * deg;
+    test.m_moving = true;
+
+    // Exercise
+    auto const feedback = test.feedback();
+
+    // Verify
+    expect(30.0f * deg == feedback.position);
+    expect(feedback.moving);
+    expect(hal::rpm::zero() == feedback.velocity);
+    expect(hal::newton_meter::zero() == feedback.torque);
+    expect(that % 1 == test.m_position_reads);
+    expect(that % 1 == test.m_moving_reads);
+  };
+
+  "queries within the freshness window share one read"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource, 1 * MHz);
+    auto servo = mem::make_strong_ptr<test_feedback_servo>(resource);
+    hal::cached_feedback test(servo, clock, 1ms);
+    servo->m_position = 10.0f * deg;
+
+    // Exercise
+    auto const first = test.position();
+    servo->m_position = 20.0f * deg;
+    clock->m_uptime = 1'000;
+    auto const within = test.position();
+    auto const moving = test.is_moving();
+    clock->m_uptime = 1'001;
+    auto const stale = test.position();
+
+    // Verify
+    expect(10.0f * deg == first);
+    expect(10.0f * deg == within) << "1ms old is still fresh";
+    expect(not moving);
+    expect(20.0f * deg == stale);
+    expect(that % 2 == servo->m_position_reads);
+  };
+
+  "invalidate() makes the next query read the servo"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource, 1 * MHz);
+    auto servo = mem::make_strong_ptr<test_feedback_servo>(resource);
+    hal::cached_feedback test(servo, clock, 1s);
+    static_cast<void>(test.position());
+    servo->m_position = 45.0f * deg;
+
+    // Exercise
+    test.invalidate();
+    auto const position = test.position();
+
+    // Verify
+    expect(45.0f * deg == position);
+    expect(that % 2 == servo->m_position_reads);
+  };
+
+  "a freshness of 0 reads the servo on every query"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource, 1 * MHz);
+    auto servo = mem::make_strong_ptr<test_feedback_servo>(resource);
+    hal::cached_feedback test(servo, clock, 0ms);
+
+    // Exercise
+    // Every query is made within the same clock tick
+    static_cast<void>(test.position());
+    static_cast<void>(test.position());
+    static_cast<void>(test.position());
+
+    // Verify
+    expect(that % 3 == servo->m_position_reads);
+  };
+
+  "long windows on fast clocks do not overflow"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock =
+      mem::make_strong_ptr<test_clock>(resource, 4'000'000'000u * Hz);
+    auto servo = mem::make_strong_ptr<test_feedback_servo>(resource);
+    // 10s * 4 GHz overflows u64 when multiplied in nanoseconds
+    hal::cached_feedback test(servo, clock, 10s);
+
+    // Exercise
+    static_cast<void>(test.position());
+    clock->m_uptime = 40'000'000'000;
+    static_cast<void>(test.position());
+    clock->m_uptime = 40'000'000'001;
+    static_cast<void>(test.position());
+
+    // Verify
+    expect(that % 2 == servo->m_position_reads);
+  };
+
+  "negative freshness windows are rejected"_test = []() {
+    // Setup
+    auto* const resource = std::pmr::new_delete_resource();
+    auto clock = mem::make_strong_ptr<test_clock>(resource, 1 * MHz);
+    auto servo = mem::make_strong_ptr<test_feedback_servo>(resource);
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { hal::cached_feedback test(servo, clock, -1ms); }));
+  };
+};
+
+boost::ut::suite<"hal::servo_group"> servo_group_test = []() {
+  using namespace boost::ut;
+
+  "command() sends one command per servo in one broadcast"_test = []() {
+    // Setup
+    test_servo_group test;
+    std::array<hal::servo_group::command_t, 3> const commands{ {
+      { .position = 10.0f * deg,
+        .velocity = 5.0f * hal::rpm::reference,
+        .torque = 1.0f * N * m },
+      { .position = -20.0f * deg,
+        .velocity = 6.0f * hal::rpm::reference,
+        .torque = 2.0f * N * m },
+      { .position = 30.0f * deg,
+        .velocity = 7.0f * hal::rpm::reference,
+        .torque = 3.0f * N * m },
+    } };
+    std::array<hal::servo_group::status_t, 3> status{};
+
+    // Exercise
+    test.command(commands);
+    test.status(status);
+
+    // Verify
+    expect(that % 3 == test.size());
+    expect(that % 1 == test.m_broadcasts);
+    expect(that % 1 == test.m_bulk_reads);
+    for (hal::usize i = 0; i < commands.size(); i++) {
+      expect(commands[i].position == status[i].position);
+      expect(commands[i].velocity == status[i].velocity);
+      expect(commands[i].torque == status[i].torque);
+    }
+  };
+
+  "command() rejects spans not matching size()"_test = []() {
+    // Setup
+    test_servo_group test;
+    std::array<hal::servo_group::command_t, 4> commands{};
+    commands.fill({ .position = 45.0f * deg,
+                    .velocity = hal::rpm::zero(),
+                    .torque = hal::newton_meter::zero() });
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.command(std::span(commands).first(2)); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.command(commands); }));
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      test.command(std::span<hal::servo_group::command_t const>{});
+    }));
+    expect(that % 0 == test.m_broadcasts);
+    expect(hal::degrees::zero() == test.m_servos[0].position);
+  };
+
+  "out of range commands leave every servo untouched"_test = []() {
+    // Setup
+    test_servo_group test;
+    std::array<hal::servo_group::command_t, 3> commands{};
+    commands.fill({ .position = 45.0f * deg,
+                    .velocity = hal::rpm::zero(),
+                    .torque = hal::newton_meter::zero() });
+    commands[2].position = 120.0f * deg;
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.command(commands); }));
+    expect(that % 0 == test.m_broadcasts);
+    for (auto const& servo : test.m_servos) {
+      expect(hal::degrees::zero() == servo.position);
+    }
+  };
+
+  "status() rejects spans not matching size()"_test = []() {
+    // Setup
+    test_servo_group test;
+    std::array<hal::servo_group::status_t, 4> status{};
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.status(std::span(status).first(2)); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test.status(status); }));
+    test.status(std::span(status).first(3));
+    expect(that % 1 == test.m_bulk_reads);
+  };
+};
+}  // namespace
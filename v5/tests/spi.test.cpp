@@ -0,0 +1,103 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <span>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+import hal;
+import async_context;
+
+namespace {
+class test_spi_channel : public hal::spi_channel
+{
+public:
+  settings m_settings{};
+  bool m_selected = false;
+  std::vector<hal::byte> m_written;
+  hal::byte m_filler = 0;
+
+private:
+  async::future<void> driver_configure(async::context&,
+                                       settings const& p_settings) override
+  {
+    m_settings = p_settings;
+    return {};
+  }
+
+  async::future<void> driver_chip_select(async::context&,
+                                         bool p_select) override
+  {
+    m_selected = p_select;
+    return {};
+  }
+
+  async::future<void> driver_transfer(async::context&,
+                                      std::span<hal::byte const> p_data_out,
+                                      std::span<hal::byte> p_data_in,
+                                      hal::byte p_filler) override
+  {
+    m_written.insert(m_written.end(), p_data_out.begin(), p_data_out.end());
+    // Loop the written bytes back, as if MOSI were wired to MISO
+    for (hal::usize i = 0; i < p_data_in.size(); i++) {
+      p_data_in[i] = i < p_data_out.size() ? p_data_out[i] : p_filler;
+    }
+    m_filler = p_filler;
+    return {};
+  }
+};
+
+boost::ut::suite<"hal::spi_channel"> spi_channel_test = []() {
+  using namespace boost::ut;
+
+  "::configure() & ::chip_select()"_test = []() {
+    // Setup
+    using namespace mp_units::si::unit_symbols;
+    async::basic_context<1024> ctx;
+    test_spi_channel test;
+    hal::spi_channel::settings const expected{
+      .clock_rate = 8 * MHz,
+      .bus_mode = hal::spi_channel::mode::m3,
+    };
+
+    // Exercise
+    test.configure(ctx, expected);
+    test.chip_select(ctx, true);
+
+    // Verify
+    expect(expected == test.m_settings);
+    expect(that % test.m_selected);
+  };
+
+  "::transfer() pads with the filler"_test = []() {
+    // Setup
+    async::basic_context<1024> ctx;
+    test_spi_channel test;
+    std::array<hal::byte, 2> const data_out{ 0x9F, 0x01 };
+    std::array<hal::byte, 4> data_in{};
+
+    // Exercise
+    test.transfer(ctx, data_out, data_in);
+
+    // Verify
+    expect(that % hal::spi_channel::default_filler == test.m_filler);
+    expect(std::array<hal::byte, 4>{ 0x9F, 0x01, 0xFF, 0xFF } == data_in);
+    expect(std::ranges::equal(data_out, test.m_written));
+  };
+};
+}  // namespace